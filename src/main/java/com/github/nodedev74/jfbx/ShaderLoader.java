@@ -26,6 +26,24 @@ public class ShaderLoader {
         return tempFile.getAbsolutePath();
     }
 
+    /**
+     * Reads a shader file directly from the resources without creating a
+     * temporary file.
+     *
+     * @param shaderName The name of the shader file.
+     * @return The SPIR-V code of the shader.
+     * @throws IOException If the shader could not be read.
+     */
+    public static byte[] read(String shaderName) throws IOException {
+        try (InputStream inputStream = ShaderLoader.class.getClassLoader()
+                .getResourceAsStream("shaders/" + shaderName + ".spv")) {
+            if (inputStream == null) {
+                throw new IOException("Shader not found: " + shaderName);
+            }
+            return inputStream.readAllBytes();
+        }
+    }
+
     /**
      * Creates a temporary file based on the given URL path.
      *
@@ -0,0 +1,72 @@
+package com.github.nodedev74.jfbx.anim;
+
+import com.github.nodedev74.jfbx.scene.SceneGraph;
+
+/**
+ * Playback state of an {@link AnimationStack}. The sampler remembers the key
+ * every channel was at, so playing forward frame by frame avoids searching the
+ * keys again.
+ */
+public class AnimationSampler {
+
+    private long samplerPtr;
+    private AnimationStack stack;
+
+    /**
+     * Constructs a sampler for an animation stack.
+     *
+     * @param stack The stack to play.
+     */
+    public AnimationSampler(AnimationStack stack) {
+        this.stack = stack;
+        this.samplerPtr = create(stack);
+    }
+
+    private static native long create(AnimationStack stack);
+
+    /**
+     * Retrieves the sampled stack.
+     *
+     * @return The animation stack.
+     */
+    public AnimationStack getStack() {
+        return stack;
+    }
+
+    /**
+     * Samples all channels on the calling thread.
+     *
+     * @param time The time in seconds.
+     */
+    public void sample(float time) {
+        sample(time, false);
+    }
+
+    /**
+     * Samples all channels.
+     *
+     * @param time     The time in seconds.
+     * @param parallel True to split the channels across the native worker pool.
+     */
+    public native void sample(float time, boolean parallel);
+
+    /**
+     * Copies the values of the last sample.
+     *
+     * @param out The array receiving one value per channel.
+     */
+    public native void getValues(float[] out);
+
+    /**
+     * Writes the values of the last sample into the local transforms of a scene
+     * graph.
+     *
+     * @param graph The scene graph.
+     */
+    public native void apply(SceneGraph graph);
+
+    /**
+     * Releases the native sampler.
+     */
+    public native void destroy();
+}
@@ -0,0 +1,146 @@
+package com.github.nodedev74.jfbx.anim;
+
+/**
+ * Animation channels prepared for sampling. Every channel drives one transform
+ * component of a scene graph node.
+ */
+public class AnimationStack {
+
+    /**
+     * Transform component indices, as used by
+     * {@link #addChannel(int, int, float[], float[])}.
+     */
+    public static final int TRANSLATION_X = 0;
+    public static final int TRANSLATION_Y = 1;
+    public static final int TRANSLATION_Z = 2;
+    public static final int ROTATION_X = 3;
+    public static final int ROTATION_Y = 4;
+    public static final int ROTATION_Z = 5;
+    public static final int SCALING_X = 6;
+    public static final int SCALING_Y = 7;
+    public static final int SCALING_Z = 8;
+
+    private long stackPtr;
+
+    /**
+     * Constructs an empty animation stack.
+     *
+     * @param name      The stack name.
+     * @param startTime The start of the playback range in seconds.
+     * @param endTime   The end of the playback range in seconds.
+     */
+    public AnimationStack(String name, float startTime, float endTime) {
+        this(create(name, startTime, endTime));
+    }
+
+    /**
+     * Wraps a native animation stack.
+     *
+     * @param stackPtr The pointer to the native animation stack.
+     */
+    private AnimationStack(long stackPtr) {
+        this.stackPtr = stackPtr;
+    }
+
+    /**
+     * Loads an animation stack from a cache file written by {@link #save(String)}.
+     *
+     * @param path The cache file path.
+     * @return The animation stack.
+     */
+    public static AnimationStack open(String path) {
+        return new AnimationStack(load(path));
+    }
+
+    private static native long create(String name, float startTime, float endTime);
+
+    private static native long load(String path);
+
+    /**
+     * Writes the channels and keys to a cache file. Quantized stacks are stored
+     * quantized, so the cache loads without importing or reducing again.
+     *
+     * @param path The cache file path.
+     */
+    public native void save(String path);
+
+    /**
+     * Sets the key reduction tolerance of channels added afterwards. Keys which
+     * a linear or cubic segment reproduces within the tolerance are removed.
+     *
+     * @param tolerance The maximum deviation from the original curve, rotations
+     *                  in degrees. 0 keeps all keys.
+     */
+    public native void setTolerance(float tolerance);
+
+    /**
+     * Converts the keys to 16 bit times, values and tangents, scaled per
+     * channel. No channels can be added afterwards.
+     */
+    public native void quantize();
+
+    /**
+     * Checks if the keys are quantized.
+     *
+     * @return True if {@link #quantize()} was called.
+     */
+    public native boolean isQuantized();
+
+    /**
+     * Adds a linearly interpolated channel.
+     *
+     * @param node     The scene graph node.
+     * @param property The transform component, e.g. {@link #ROTATION_Y}.
+     * @param times    The key times in seconds, sorted ascending.
+     * @param values   The key values, rotations in degrees.
+     */
+    public native void addChannel(int node, int property, float[] times, float[] values);
+
+    /**
+     * Retrieves the stack name.
+     *
+     * @return The name.
+     */
+    public native String getName();
+
+    /**
+     * Retrieves the start of the playback range.
+     *
+     * @return The start time in seconds.
+     */
+    public native float getStartTime();
+
+    /**
+     * Retrieves the end of the playback range.
+     *
+     * @return The end time in seconds.
+     */
+    public native float getEndTime();
+
+    /**
+     * Retrieves the number of channels.
+     *
+     * @return The channel count.
+     */
+    public native int getChannelCount();
+
+    /**
+     * Retrieves the number of keys of all channels.
+     *
+     * @return The key count.
+     */
+    public native long getKeyCount();
+
+    /**
+     * Retrieves the native memory used by channels and keys.
+     *
+     * @return The size in bytes.
+     */
+    public native long getMemorySize();
+
+    /**
+     * Releases the native animation stack. Samplers of this stack must not be
+     * used afterwards.
+     */
+    public native void destroy();
+}
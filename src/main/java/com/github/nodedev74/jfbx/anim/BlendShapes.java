@@ -0,0 +1,117 @@
+package com.github.nodedev74.jfbx.anim;
+
+/**
+ * Morph targets of a mesh. Every shape stores only the vertices it moves, and
+ * evaluation skips shapes whose weight is zero.
+ */
+public class BlendShapes {
+
+    private long blendShapesPtr;
+
+    /**
+     * Constructs blend shapes without any shape.
+     *
+     * @param positions The base positions, x, y and z per vertex.
+     */
+    public BlendShapes(float[] positions) {
+        this(create(positions));
+    }
+
+    /**
+     * Wraps native blend shapes.
+     *
+     * @param blendShapesPtr The pointer to the native blend shapes.
+     */
+    private BlendShapes(long blendShapesPtr) {
+        this.blendShapesPtr = blendShapesPtr;
+    }
+
+    private static native long create(float[] positions);
+
+    /**
+     * Adds a shape from sparse deltas. Duplicate indices are summed up and zero
+     * deltas are dropped.
+     *
+     * @param name    The shape name.
+     * @param indices The vertex indices.
+     * @param deltas  x, y and z per index.
+     * @return The shape index.
+     */
+    public native int addShape(String name, int[] indices, float[] deltas);
+
+    /**
+     * Adds a shape from a delta for every vertex, keeping only the vertices it
+     * moves.
+     *
+     * @param name   The shape name.
+     * @param deltas x, y and z per vertex.
+     * @return The shape index.
+     */
+    public native int addDenseShape(String name, float[] deltas);
+
+    /**
+     * Retrieves the number of vertices.
+     *
+     * @return The vertex count.
+     */
+    public native int getVertexCount();
+
+    /**
+     * Retrieves the number of shapes.
+     *
+     * @return The shape count.
+     */
+    public native int getShapeCount();
+
+    /**
+     * Retrieves the name of a shape.
+     *
+     * @param shape The shape index.
+     * @return The name.
+     */
+    public native String getShapeName(int shape);
+
+    /**
+     * Retrieves the number of stored deltas of all shapes.
+     *
+     * @return The delta count.
+     */
+    public native long getDeltaCount();
+
+    /**
+     * Sets the weight of a shape, 1 applies its full deltas.
+     *
+     * @param shape  The shape index.
+     * @param weight The weight.
+     */
+    public native void setWeight(int shape, float weight);
+
+    /**
+     * Retrieves the weight of a shape.
+     *
+     * @param shape The shape index.
+     * @return The weight.
+     */
+    public native float getWeight(int shape);
+
+    /**
+     * Retrieves the native memory used by positions, indices and deltas.
+     *
+     * @return The size in bytes.
+     */
+    public native long getMemorySize();
+
+    /**
+     * Blends the shapes onto the base positions with their current weights.
+     *
+     * @param out      Receives x, y, z and 1 per vertex, it is left untouched if
+     *                 shorter than four floats per vertex.
+     * @param parallel True to split the vertices across the shared thread pool.
+     */
+    public native void evaluate(float[] out, boolean parallel);
+
+    /**
+     * Releases the native blend shapes.
+     */
+    public native void destroy();
+}
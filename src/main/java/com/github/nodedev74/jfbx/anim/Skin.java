@@ -0,0 +1,79 @@
+package com.github.nodedev74.jfbx.anim;
+
+import com.github.nodedev74.jfbx.scene.SceneGraph;
+
+/**
+ * Bind pose and bone influences of a skinned mesh. Joints refer to scene graph
+ * nodes, every vertex is influenced by up to four of them.
+ */
+public class Skin {
+
+    /**
+     * Maximum number of joints influencing a vertex.
+     */
+    public static final int MAX_INFLUENCES = 4;
+
+    private long skinPtr;
+
+    /**
+     * Constructs a skin from per vertex influences.
+     *
+     * @param positions           The bind positions, x, y and z per vertex.
+     * @param joints              {@link #MAX_INFLUENCES} joint indices per
+     *                            vertex.
+     * @param weights             {@link #MAX_INFLUENCES} weights per vertex,
+     *                            they are normalized.
+     * @param jointNodes          The scene graph node of every joint.
+     * @param inverseBindMatrices The column major inverse bind matrix of every
+     *                            joint.
+     */
+    public Skin(float[] positions, int[] joints, float[] weights, int[] jointNodes, float[] inverseBindMatrices) {
+        this(create(positions, joints, weights, jointNodes, inverseBindMatrices));
+    }
+
+    /**
+     * Wraps a native skin.
+     *
+     * @param skinPtr The pointer to the native skin.
+     */
+    private Skin(long skinPtr) {
+        this.skinPtr = skinPtr;
+    }
+
+    private static native long create(float[] positions, int[] joints, float[] weights, int[] jointNodes,
+            float[] inverseBindMatrices);
+
+    /**
+     * Retrieves the number of vertices.
+     *
+     * @return The vertex count.
+     */
+    public native int getVertexCount();
+
+    /**
+     * Retrieves the number of joints.
+     *
+     * @return The joint count.
+     */
+    public native int getJointCount();
+
+    /**
+     * Skins all vertices on the CPU. The GPU path is
+     * {@link com.github.nodedev74.jfbx.vulkan.VkHandler#addSkin(Skin)}; this one
+     * serves as reference and fallback.
+     *
+     * @param graph      The scene graph after its update.
+     * @param nodeOffset The offset added to every joint node.
+     * @param out        Receives x, y, z and 1 per vertex, it is left untouched
+     *                   if shorter than four floats per vertex.
+     * @param parallel   True to split the vertices across the shared thread
+     *                   pool.
+     */
+    public native void skin(SceneGraph graph, int nodeOffset, float[] out, boolean parallel);
+
+    /**
+     * Releases the native skin. It must not be used by a Vulkan handler
+     * afterwards.
+     */
+    public native void destroy();
+}
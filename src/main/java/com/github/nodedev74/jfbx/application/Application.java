@@ -6,6 +6,8 @@ import java.util.Iterator;
 import com.github.nodedev74.jfbx.NativeLoader;
 import com.github.nodedev74.jfbx.stage.Stage;
 import com.github.nodedev74.jfbx.stage.control.Control;
+import com.github.nodedev74.jfbx.trace.TraceScope;
+import com.github.nodedev74.jfbx.trace.Tracer;
 
 /**
  * 
@@ -20,22 +22,37 @@ public abstract class Application implements AppilcationInterface {
 
     public static Stage currentStage;
 
+    private static long frameZone;
+    private static long controlZone;
+
     /**
      * Launches the specified application class.
      * Loads the Vulkan library, creates a stage, and starts the application
-     * lifecycle.
+     * lifecycle. If the system property {@code jfbx.trace} names a file, the
+     * application is traced and the trace is written to that file on exit.
      * 
      * @param app the application class to launch
      */
     public static void launch(Class<? extends Application> app) {
         try {
             NativeLoader.load("libvulkan");
+
+            String tracePath = System.getProperty("jfbx.trace");
+            Tracer.setEnabled(tracePath != null);
+            Tracer.setThreadName("application");
+            frameZone = Tracer.register("Application.frame");
+            controlZone = Tracer.register("Control.lifecycle");
+
             currentStage = new Stage();
             Application application = app.getDeclaredConstructor().newInstance();
 
             application.start();
             Application.lifecycle();
             application.stop();
+
+            if (tracePath != null) {
+                Tracer.dump(tracePath);
+            }
         } catch (Exception e) {
             throw new RuntimeException(e);
         }
@@ -59,19 +76,23 @@ public abstract class Application implements AppilcationInterface {
         long startTime = System.currentTimeMillis();
 
         while (isRunning) {
-            ArrayList<? super Control> children = currentStage.getChildren();
-            if (!children.isEmpty()) {
-                Iterator<? super Control> iterator = children.iterator();
-                while (iterator.hasNext()) {
-                    Control element = (Control) iterator.next();
-                    if (element.isActive()) {
-                        element.lifecycle();
-                    } else {
-                        iterator.remove();
+            try (TraceScope frame = Tracer.scope(frameZone)) {
+                ArrayList<? super Control> children = currentStage.getChildren();
+                if (!children.isEmpty()) {
+                    Iterator<? super Control> iterator = children.iterator();
+                    while (iterator.hasNext()) {
+                        Control element = (Control) iterator.next();
+                        if (element.isActive()) {
+                            try (TraceScope control = Tracer.scope(controlZone)) {
+                                element.lifecycle();
+                            }
+                        } else {
+                            iterator.remove();
+                        }
                     }
+                } else {
+                    Application.exit();
                 }
-            } else {
-                Application.exit();
             }
 
             long elapsedTime = System.currentTimeMillis() - startTime;
@@ -0,0 +1,16 @@
+package com.github.nodedev74.jfbx.exception;
+
+/**
+ * Runtime error thrown when an FBX file cannot be read or imported.
+ */
+public class FbxRuntimeError extends RuntimeException {
+
+    /**
+     * Constructs an FBX runtime exception.
+     * 
+     * @param message The message to be thrown.
+     */
+    public FbxRuntimeError(String message) {
+        super(message);
+    }
+}
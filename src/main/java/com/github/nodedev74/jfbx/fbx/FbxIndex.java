@@ -0,0 +1,187 @@
+package com.github.nodedev74.jfbx.fbx;
+
+import com.github.nodedev74.jfbx.exception.FbxRuntimeError;
+
+/**
+ * Index over the objects of a binary FBX file that reads single objects on
+ * request.
+ *
+ * <p>
+ * Opening the index reads only the record headers and the id, name, class and
+ * type of every object; geometry arrays and all other nested records are
+ * skipped by their end offsets. An object is read and, for arrays, inflated the
+ * first time one of its values is requested and kept until it is released. The
+ * connections are read on the first query that needs them. Objects are
+ * addressed by their index in file order. An index must not be used by several
+ * threads at once.
+ */
+public class FbxIndex {
+
+    private long indexPtr;
+
+    /**
+     * Wraps a native index.
+     *
+     * @param indexPtr The pointer to the native index.
+     */
+    private FbxIndex(long indexPtr) {
+        this.indexPtr = indexPtr;
+    }
+
+    /**
+     * Opens a binary FBX file and indexes its objects. The file stays open until
+     * the index is destroyed.
+     *
+     * @param path The file path.
+     * @return The index.
+     * @throws FbxRuntimeError If the file cannot be read or is malformed.
+     */
+    public static FbxIndex open(String path) {
+        return new FbxIndex(build(path));
+    }
+
+    private static native long build(String path);
+
+    /**
+     * Retrieves the number of indexed objects.
+     *
+     * @return The object count.
+     */
+    public native int getObjectCount();
+
+    /**
+     * Retrieves the id of an object.
+     *
+     * @param index The object index.
+     * @return The object id.
+     * @throws FbxRuntimeError If the index is out of range.
+     */
+    public native long getObjectId(int index);
+
+    /**
+     * Retrieves the name of an object without its class suffix.
+     *
+     * @param index The object index.
+     * @return The object name.
+     * @throws FbxRuntimeError If the index is out of range.
+     */
+    public native String getObjectName(int index);
+
+    /**
+     * Retrieves the class of an object, the name of its record such as Model,
+     * Geometry, Material or AnimationStack.
+     *
+     * @param index The object index.
+     * @return The object class.
+     * @throws FbxRuntimeError If the index is out of range.
+     */
+    public native String getObjectClass(int index);
+
+    /**
+     * Retrieves the type of an object, such as Mesh for a Geometry.
+     *
+     * @param index The object index.
+     * @return The object type, or an empty string.
+     * @throws FbxRuntimeError If the index is out of range.
+     */
+    public native String getObjectType(int index);
+
+    /**
+     * Finds the object with an id.
+     *
+     * @param id The object id.
+     * @return The object index, or -1 if no object has the id.
+     */
+    public native int findObject(long id);
+
+    /**
+     * Finds the objects of a class with a name.
+     *
+     * @param objectClass The object class, or null for any class.
+     * @param name        The object name, or null for any name.
+     * @return The object indices in file order.
+     */
+    public native int[] findObjects(String objectClass, String name);
+
+    /**
+     * Retrieves the objects connected to an object as its children, such as the
+     * geometry and materials of a model.
+     *
+     * @param index The object index.
+     * @return The child object indices in connection order.
+     * @throws FbxRuntimeError If the index is out of range or the connections
+     *                         are malformed.
+     */
+    public native int[] getChildObjects(int index);
+
+    /**
+     * Retrieves the objects an object is connected to as a child, such as the
+     * models using a geometry.
+     *
+     * @param index The object index.
+     * @return The parent object indices in connection order.
+     * @throws FbxRuntimeError If the index is out of range or the connections
+     *                         are malformed.
+     */
+    public native int[] getParentObjects(int index);
+
+    /**
+     * Reads the values of a property of an object, e.g. DiffuseColor of a
+     * Material or LocalStop of an AnimationStack.
+     *
+     * @param index The object index.
+     * @param name  The property name.
+     * @return The values of the property, or null if the object does not set it.
+     * @throws FbxRuntimeError If the index is out of range or the object is
+     *                         malformed.
+     */
+    public native double[] getObjectProperty(int index, String name);
+
+    /**
+     * Retrieves the control points of a Geometry object of type Mesh.
+     *
+     * @param index The object index.
+     * @return x, y and z per control point.
+     * @throws FbxRuntimeError If the index is out of range or the object is no
+     *                         mesh or malformed.
+     */
+    public native float[] getMeshPositions(int index);
+
+    /**
+     * Retrieves the triangle indices of a Geometry object of type Mesh.
+     *
+     * @param index The object index.
+     * @return Three control point indices per triangle.
+     * @throws FbxRuntimeError If the index is out of range or the object is no
+     *                         mesh or malformed.
+     */
+    public native int[] getMeshIndices(int index);
+
+    /**
+     * Drops what has been read for an object. It is read again on the next
+     * request.
+     *
+     * @param index The object index.
+     */
+    public native void release(int index);
+
+    /**
+     * Retrieves the number of objects whose records or meshes are held.
+     *
+     * @return The materialized object count.
+     */
+    public native int getMaterializedCount();
+
+    /**
+     * Retrieves the bytes read from the file so far, for the index and for the
+     * requested objects.
+     *
+     * @return The size in bytes.
+     */
+    public native long getBytesRead();
+
+    /**
+     * Closes the file and releases the native index.
+     */
+    public native void destroy();
+}
@@ -0,0 +1,322 @@
+package com.github.nodedev74.jfbx.fbx;
+
+import com.github.nodedev74.jfbx.anim.AnimationStack;
+import com.github.nodedev74.jfbx.anim.BlendShapes;
+import com.github.nodedev74.jfbx.anim.Skin;
+import com.github.nodedev74.jfbx.exception.FbxRuntimeError;
+import com.github.nodedev74.jfbx.scene.SceneGraph;
+
+/**
+ * Scene imported from a binary FBX file.
+ */
+public class FbxScene {
+
+    private long scenePtr;
+
+    /**
+     * Wraps a native scene.
+     *
+     * @param scenePtr The pointer to the native scene.
+     */
+    private FbxScene(long scenePtr) {
+        this.scenePtr = scenePtr;
+    }
+
+    /**
+     * Loads and imports a binary FBX file. The records are parsed into chunks
+     * that are freed together with the scene; with
+     * {@code -Djfbx.parseArena=false} every record, property and array is
+     * allocated and freed separately instead.
+     *
+     * @param path The file path.
+     * @return The imported scene.
+     * @throws FbxRuntimeError If the file cannot be read or is malformed.
+     */
+    public static FbxScene open(String path) {
+        return new FbxScene(load(path, Boolean.parseBoolean(System.getProperty("jfbx.parseArena", "true"))));
+    }
+
+    private static native long load(String path, boolean arena);
+
+    /**
+     * Retrieves the number of imported models.
+     *
+     * @return The model count.
+     */
+    public native int getModelCount();
+
+    /**
+     * Retrieves the name of a model.
+     *
+     * @param index The model index.
+     * @return The model name.
+     */
+    public native String getModelName(int index);
+
+    /**
+     * Retrieves the parent of a model.
+     *
+     * @param index The model index.
+     * @return The parent model index, or -1 for root models.
+     */
+    public native int getModelParent(int index);
+
+    /**
+     * Builds a scene graph from the model hierarchy. Node i of the graph
+     * corresponds to model i. The graph is independent of the scene and has to
+     * be destroyed separately.
+     *
+     * @return The scene graph.
+     */
+    public native SceneGraph createSceneGraph();
+
+    /**
+     * Retrieves the number of animation stacks.
+     *
+     * @return The animation stack count.
+     */
+    public native int getAnimationStackCount();
+
+    /**
+     * Retrieves the name of an animation stack.
+     *
+     * @param index The animation stack index.
+     * @return The animation stack name.
+     */
+    public native String getAnimationStackName(int index);
+
+    /**
+     * Converts an animation stack for playback. Its channels drive the nodes of
+     * the graph returned by {@link #createSceneGraph()}. The stack is independent
+     * of the scene and has to be destroyed separately.
+     *
+     * @param index The animation stack index.
+     * @return The animation stack.
+     */
+    public AnimationStack createAnimationStack(int index) {
+        return createAnimationStack(index, 0.0f, false);
+    }
+
+    /**
+     * Converts an animation stack for playback with key reduction and optional
+     * quantization.
+     *
+     * @param index     The animation stack index.
+     * @param tolerance The key reduction tolerance, 0 keeps all keys.
+     * @param quantize  True to store the keys quantized.
+     * @return The animation stack.
+     */
+    public native AnimationStack createAnimationStack(int index, float tolerance, boolean quantize);
+
+    /**
+     * Retrieves the number of imported meshes.
+     *
+     * @return The mesh count.
+     */
+    public native int getMeshCount();
+
+    /**
+     * Retrieves the model a mesh is attached to.
+     *
+     * @param index The mesh index.
+     * @return The model index, or -1 if the mesh is not attached.
+     */
+    public native int getMeshModel(int index);
+
+    /**
+     * Retrieves all models a mesh is attached to. A geometry shared by several
+     * models is imported once.
+     *
+     * @param index The mesh index.
+     * @return The model indices in connection order.
+     */
+    public native int[] getMeshModels(int index);
+
+    /**
+     * Retrieves the control points of a mesh.
+     *
+     * @param index The mesh index.
+     * @return x, y and z per control point.
+     */
+    public native float[] getMeshPositions(int index);
+
+    /**
+     * Retrieves the triangle indices of a mesh.
+     *
+     * @param index The mesh index.
+     * @return Three control point indices per triangle.
+     */
+    public native int[] getMeshIndices(int index);
+
+    /**
+     * Retrieves the material of a model. Models with several materials report the
+     * first one.
+     *
+     * @param index The model index.
+     * @return The material index, or -1 if the model has no material.
+     */
+    public native int getModelMaterial(int index);
+
+    /**
+     * Retrieves the number of materials.
+     *
+     * @return The material count.
+     */
+    public native int getMaterialCount();
+
+    /**
+     * Retrieves the name of a material.
+     *
+     * @param index The material index.
+     * @return The material name.
+     */
+    public native String getMaterialName(int index);
+
+    /**
+     * Retrieves the texture of a material, the one mapped to its diffuse color
+     * where there are several.
+     *
+     * @param index The material index.
+     * @return The texture index, or -1 without texture.
+     */
+    public native int getMaterialTexture(int index);
+
+    /**
+     * Retrieves the number of textures.
+     *
+     * @return The texture count.
+     */
+    public native int getTextureCount();
+
+    /**
+     * Retrieves the file name a texture refers to.
+     *
+     * @param index The texture index.
+     * @return The relative file name.
+     */
+    public native String getTextureFileName(int index);
+
+    /**
+     * Retrieves the image file embedded for a texture, which
+     * {@link com.github.nodedev74.jfbx.vulkan.VkHandler#addEncodedTextures(byte[][], boolean)}
+     * can upload.
+     *
+     * @param index The texture index.
+     * @return The file content, or null if the file is not embedded.
+     */
+    public native byte[] getTextureContent(int index);
+
+    /**
+     * Retrieves the number of instance groups. A group holds the models drawing
+     * the same mesh with the same material, the groups are ordered by mesh.
+     *
+     * @return The instance group count.
+     */
+    public native int getInstanceGroupCount();
+
+    /**
+     * Retrieves the mesh of an instance group.
+     *
+     * @param index The instance group index.
+     * @return The mesh index.
+     */
+    public native int getInstanceGroupMesh(int index);
+
+    /**
+     * Retrieves the material of an instance group.
+     *
+     * @param index The instance group index.
+     * @return The material index, or -1 for models without material.
+     */
+    public native int getInstanceGroupMaterial(int index);
+
+    /**
+     * Retrieves the models of an instance group.
+     *
+     * @param index The instance group index.
+     * @return The model indices.
+     */
+    public native int[] getInstanceGroupModels(int index);
+
+    /**
+     * Retrieves the number of skin deformers.
+     *
+     * @return The skin count.
+     */
+    public native int getSkinCount();
+
+    /**
+     * Converts a skin deformer. Its vertices are the control points of the
+     * deformed mesh and its joints the nodes of the graph returned by
+     * {@link #createSceneGraph()}. The skin is independent of the scene and has
+     * to be destroyed separately.
+     *
+     * @param index The skin index.
+     * @return The skin.
+     */
+    public native Skin createSkin(int index);
+
+    /**
+     * Retrieves the number of blend shape deformers.
+     *
+     * @return The blend shape count.
+     */
+    public native int getBlendShapeCount();
+
+    /**
+     * Converts a blend shape deformer. Its vertices are the control points of
+     * the deformed mesh, every channel becomes a shape weighted by its deform
+     * percent. The result is independent of the scene and has to be destroyed
+     * separately.
+     *
+     * @param index The blend shape index.
+     * @return The blend shapes.
+     */
+    public native BlendShapes createBlendShapes(int index);
+
+    /**
+     * Retrieves the time spent assembling the scene from the parsed file:
+     * resolving connections and importing models, animations, materials,
+     * textures, meshes and deformers. Reading and inflating the file is not
+     * included.
+     *
+     * @return The assembly time in milliseconds.
+     */
+    public native double getAssemblyTime();
+
+    /**
+     * Retrieves the time spent parsing the file content into records, before
+     * the scene is assembled.
+     *
+     * @return The parse time in milliseconds.
+     */
+    public native double getParseTime();
+
+    /**
+     * Retrieves the bytes allocated for the parsed records, their properties,
+     * strings and inflated arrays.
+     *
+     * @return The size in bytes.
+     */
+    public native long getParseMemory();
+
+    /**
+     * Retrieves the number of allocations made for the parsed records.
+     *
+     * @return The allocation count.
+     */
+    public native long getParseAllocationCount();
+
+    /**
+     * Retrieves the heap memory the parsed records hold, including the unused
+     * rest of their chunks.
+     *
+     * @return The size in bytes.
+     */
+    public native long getParseReservedMemory();
+
+    /**
+     * Releases the native scene.
+     */
+    public native void destroy();
+}
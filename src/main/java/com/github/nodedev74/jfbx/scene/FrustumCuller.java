@@ -0,0 +1,70 @@
+package com.github.nodedev74.jfbx.scene;
+
+/**
+ * Culls objects attached to scene graph nodes against a view frustum. Bounds
+ * are kept in structure of arrays layout and tested several objects at a time.
+ */
+public class FrustumCuller {
+
+    private long cullerPtr;
+
+    /**
+     * Constructs a culler without any object.
+     */
+    public FrustumCuller() {
+        this(create());
+    }
+
+    /**
+     * Wraps a native culler.
+     *
+     * @param cullerPtr The pointer to the native culler.
+     */
+    private FrustumCuller(long cullerPtr) {
+        this.cullerPtr = cullerPtr;
+    }
+
+    private static native long create();
+
+    /**
+     * Adds an object whose bounds enclose the given local positions.
+     *
+     * @param node      The scene graph node the object is attached to.
+     * @param positions The local positions, x, y and z per point.
+     * @return The object index.
+     */
+    public native int add(int node, float[] positions);
+
+    /**
+     * Retrieves the number of objects.
+     *
+     * @return The object count.
+     */
+    public native int getObjectCount();
+
+    /**
+     * Transforms the bounds of all objects by the world matrices of their nodes.
+     *
+     * @param graph    The scene graph after its update.
+     * @param parallel True to split the objects across the shared thread pool.
+     */
+    public native void update(SceneGraph graph, boolean parallel);
+
+    /**
+     * Collects the objects intersecting a view frustum in ascending order.
+     *
+     * @param viewProjection The column major view projection matrix with a depth
+     *                       range of 0 to 1.
+     * @param visible        Receives the visible object indices, at least
+     *                       getObjectCount() long.
+     * @param parallel       True to split the objects across the shared thread
+     *                       pool.
+     * @return The number of visible objects, or -1 if an array is too short.
+     */
+    public native int cull(float[] viewProjection, int[] visible, boolean parallel);
+
+    /**
+     * Releases the native culler.
+     */
+    public native void destroy();
+}
@@ -0,0 +1,125 @@
+package com.github.nodedev74.jfbx.scene;
+
+import com.github.nodedev74.jfbx.exception.FbxRuntimeError;
+
+/**
+ * Flat scene graph whose world transforms are propagated natively.
+ * <p>
+ * Nodes are stored sorted by depth, so a parent is always updated before its
+ * children and all nodes of one depth level are updated in parallel. Only
+ * nodes with a changed local transform and their descendants are recomputed
+ * by {@link #update()}.
+ */
+public class SceneGraph {
+
+    private long graphPtr;
+
+    /**
+     * Constructs a scene graph from a parent list.
+     *
+     * @param parents The parent of every node, negative for roots.
+     * @throws FbxRuntimeError If a parent is out of range or the parents form a
+     *                         cycle.
+     */
+    public SceneGraph(int[] parents) {
+        this(create(parents));
+    }
+
+    /**
+     * Wraps a native scene graph.
+     *
+     * @param graphPtr The pointer to the native scene graph.
+     */
+    private SceneGraph(long graphPtr) {
+        this.graphPtr = graphPtr;
+    }
+
+    private static native long create(int[] parents);
+
+    /**
+     * Retrieves the number of nodes.
+     *
+     * @return The node count.
+     */
+    public native int getNodeCount();
+
+    /**
+     * Retrieves the number of depth levels.
+     *
+     * @return The level count.
+     */
+    public native int getLevelCount();
+
+    /**
+     * Retrieves the position of a node in the uploaded world matrix array.
+     *
+     * @param node The node.
+     * @return The slot of the node.
+     * @throws FbxRuntimeError If the node is out of range.
+     */
+    public native int getSlot(int node);
+
+    /**
+     * Sets the local translation of a node.
+     *
+     * @param node The node.
+     * @param x    The translation along x.
+     * @param y    The translation along y.
+     * @param z    The translation along z.
+     * @throws FbxRuntimeError If the node is out of range.
+     */
+    public native void setTranslation(int node, float x, float y, float z);
+
+    /**
+     * Sets the local Euler rotation of a node in degrees.
+     *
+     * @param node The node.
+     * @param x    The rotation around x.
+     * @param y    The rotation around y.
+     * @param z    The rotation around z.
+     * @throws FbxRuntimeError If the node is out of range.
+     */
+    public native void setRotation(int node, float x, float y, float z);
+
+    /**
+     * Sets the local scaling of a node.
+     *
+     * @param node The node.
+     * @param x    The scaling along x.
+     * @param y    The scaling along y.
+     * @param z    The scaling along z.
+     * @throws FbxRuntimeError If the node is out of range.
+     */
+    public native void setScaling(int node, float x, float y, float z);
+
+    /**
+     * Sets the Euler rotation order of a node, 0 to 5 for XYZ, XZY, YZX, YXZ,
+     * ZXY and ZYX as in FBX.
+     *
+     * @param node  The node.
+     * @param order The rotation order.
+     * @throws FbxRuntimeError If the node is out of range.
+     */
+    public native void setRotationOrder(int node, int order);
+
+    /**
+     * Recomputes all world matrices that are out of date.
+     *
+     * @return The number of recomputed nodes.
+     */
+    public native int update();
+
+    /**
+     * Copies the world matrix of a node as of the last update.
+     *
+     * @param node The node.
+     * @param out  The array receiving 16 column major elements.
+     * @throws FbxRuntimeError If the node is out of range.
+     */
+    public native void getWorldMatrix(int node, float[] out);
+
+    /**
+     * Releases the native scene graph.
+     */
+    public native void destroy();
+}
@@ -0,0 +1,28 @@
+package com.github.nodedev74.jfbx.trace;
+
+/**
+ * Closes the innermost zone of the calling thread, to be used with
+ * try-with-resources.
+ */
+public final class TraceScope implements AutoCloseable {
+
+    static final TraceScope ZONE = new TraceScope(true);
+    static final TraceScope NONE = new TraceScope(false);
+
+    private final boolean open;
+
+    private TraceScope(boolean open) {
+        this.open = open;
+    }
+
+    /**
+     * Closes the zone opened by {@link Tracer#scope(long)}, if tracing was
+     * enabled when it was opened.
+     */
+    @Override
+    public void close() {
+        if (open) {
+            Tracer.end();
+        }
+    }
+}
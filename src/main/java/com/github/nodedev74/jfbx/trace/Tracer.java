@@ -0,0 +1,114 @@
+package com.github.nodedev74.jfbx.trace;
+
+/**
+ * CPU tracer that records scoped zones from native code and Java and exports
+ * them as Chrome trace JSON, which can be opened in Perfetto or
+ * chrome://tracing.
+ */
+public final class Tracer {
+
+    private static volatile boolean enabled;
+
+    private Tracer() {
+    }
+
+    /**
+     * Opens a zone that is closed when the returned scope is closed. While
+     * tracing is disabled no native call is made.
+     *
+     * @param name The handle returned by {@link #register(String)}.
+     * @return The scope to close.
+     */
+    public static TraceScope scope(long name) {
+        if (!enabled) {
+            return TraceScope.NONE;
+        }
+        begin(name);
+        return TraceScope.ZONE;
+    }
+
+    /**
+     * Enables or disables recording.
+     *
+     * @param enabled True to record zones.
+     */
+    public static void setEnabled(boolean enabled) {
+        Tracer.enabled = enabled;
+        setNativeEnabled(enabled);
+    }
+
+    /**
+     * Checks if zones are recorded.
+     *
+     * @return True if tracing is enabled.
+     */
+    public static boolean isEnabled() {
+        return enabled;
+    }
+
+    /**
+     * Enables or disables recording of native zones.
+     *
+     * @param enabled True to record zones.
+     */
+    private static native void setNativeEnabled(boolean enabled);
+
+    /**
+     * Registers a zone name. Names should be registered once and the handle
+     * reused, so opening a zone does not have to convert a string.
+     *
+     * @param name The zone name.
+     * @return The handle of the zone name.
+     */
+    public static native long register(String name);
+
+    /**
+     * Opens a zone on the calling thread.
+     *
+     * @param name The handle returned by {@link #register(String)}.
+     */
+    public static native void begin(long name);
+
+    /**
+     * Closes the innermost zone of the calling thread.
+     */
+    public static native void end();
+
+    /**
+     * Names the calling thread in the exported trace.
+     *
+     * @param name The thread name.
+     */
+    public static native void setThreadName(String name);
+
+    /**
+     * Writes all recorded zones as Chrome trace JSON.
+     *
+     * @param path The output file.
+     * @return True if the file has been written.
+     */
+    public static native boolean dump(String path);
+
+    /**
+     * Discards all recorded zones.
+     */
+    public static native void clear();
+
+    /**
+     * Measures the cost of an enabled native zone.
+     *
+     * @param iterations The number of zones to record.
+     * @return The average cost per zone in nanoseconds.
+     */
+    public static native double measureZoneOverhead(int iterations);
+
+    /**
+     * Measures the cost of the two timestamps every zone takes. It is the part
+     * of the zone cost that depends on the host, for example on whether the
+     * time stamp counter is virtualized.
+     *
+     * @param iterations The number of timestamp pairs to take.
+     * @return The average cost per pair in nanoseconds.
+     */
+    public static native double measureClockOverhead(int iterations);
+}
@@ -0,0 +1,193 @@
+package com.github.nodedev74.jfbx.vulkan;
+
+import java.util.HashMap;
+import java.util.Iterator;
+import java.util.Map;
+
+/**
+ * Requests assets from the native loader of a handler and reports their
+ * progress to listeners on the render thread.
+ *
+ * <p>
+ * Assets are parsed and processed on native worker threads and uploaded at the
+ * start of the frames the handler renders, so requesting never blocks. Call
+ * {@link #update()} once per frame after rendering; it invokes the listeners of
+ * assets whose progress changed or that ended and then releases the ended
+ * assets, so their results have to be read inside the callbacks.
+ */
+public class VkAssetLoader {
+
+    public static final int QUEUED = 0;
+    public static final int PARSING = 1;
+    public static final int PARSED = 2;
+    public static final int PROCESSING = 3;
+    public static final int READY = 4;
+    public static final int UPLOADING = 5;
+    public static final int COMPLETE = 6;
+    public static final int CANCELLED = 7;
+    public static final int FAILED = 8;
+
+    /**
+     * Receives the progress of an asset. Every asset ends with exactly one call of
+     * {@link #completed(int)}, {@link #cancelled(int)} or
+     * {@link #failed(int, String)}.
+     */
+    public interface Listener {
+
+        /**
+         * Called when the asset is complete and its resources can be used.
+         *
+         * @param asset The asset handle.
+         */
+        void completed(int asset);
+
+        /**
+         * Called when the progress of the asset changed.
+         *
+         * @param asset    The asset handle.
+         * @param progress The progress from 0 to 1.
+         */
+        default void progress(int asset, float progress) {
+        }
+
+        /**
+         * Called when the asset was cancelled.
+         *
+         * @param asset The asset handle.
+         */
+        default void cancelled(int asset) {
+        }
+
+        /**
+         * Called when the asset could not be loaded.
+         *
+         * @param asset   The asset handle.
+         * @param message The reason.
+         */
+        default void failed(int asset, String message) {
+        }
+    }
+
+    private final VkHandler handler;
+    private final Map<Integer, Listener> listeners = new HashMap<>();
+    private final Map<Integer, Float> progress = new HashMap<>();
+
+    /**
+     * Constructs a loader for the assets of a handler.
+     *
+     * @param handler The Vulkan handler that uploads the assets.
+     */
+    public VkAssetLoader(VkHandler handler) {
+        this.handler = handler;
+    }
+
+    /**
+     * Requests a binary FBX file, see
+     * {@link VkHandler#loadScene(String, int, boolean)}.
+     *
+     * @param path             The file path.
+     * @param priority         Higher priorities are processed and uploaded first.
+     * @param blockCompression True to block compress the textures.
+     * @param listener         The listener of the asset.
+     * @return The asset handle.
+     */
+    public int loadScene(String path, int priority, boolean blockCompression, Listener listener) {
+        return track(handler.loadScene(path, priority, blockCompression), listener);
+    }
+
+    /**
+     * Requests an encoded PNG or TGA texture.
+     *
+     * @param file             The file content.
+     * @param priority         Higher priorities are processed and uploaded first.
+     * @param blockCompression True to block compress the texture.
+     * @param listener         The listener of the asset.
+     * @return The asset handle.
+     */
+    public int loadTexture(byte[] file, int priority, boolean blockCompression, Listener listener) {
+        return track(handler.loadTexture(file, priority, blockCompression), listener);
+    }
+
+    /**
+     * Requests a triangle mesh.
+     *
+     * @param positions Three floats per vertex.
+     * @param indices   Three vertex indices per triangle.
+     * @param priority  Higher priorities are processed and uploaded first.
+     * @param listener  The listener of the asset.
+     * @return The asset handle.
+     */
+    public int loadMesh(float[] positions, int[] indices, int priority, Listener listener) {
+        return track(handler.loadMesh(positions, indices, priority), listener);
+    }
+
+    /**
+     * Changes the priority of an asset, for example to load the assets in view
+     * first.
+     *
+     * @param asset    The asset handle.
+     * @param priority The new priority.
+     */
+    public void setPriority(int asset, int priority) {
+        handler.setAssetPriority(asset, priority);
+    }
+
+    /**
+     * Cancels an asset. Its listener is called at the next update once the asset
+     * stopped.
+     *
+     * @param asset The asset handle.
+     * @return False if the asset already ended.
+     */
+    public boolean cancel(int asset) {
+        return handler.cancelAsset(asset);
+    }
+
+    /**
+     * Retrieves the number of assets that have not been reported as ended.
+     *
+     * @return The pending asset count.
+     */
+    public int getPendingCount() {
+        return listeners.size();
+    }
+
+    /**
+     * Reports progress and ended assets to their listeners and releases the
+     * ended assets.
+     */
+    public void update() {
+        Iterator<Map.Entry<Integer, Listener>> iterator = listeners.entrySet().iterator();
+        while (iterator.hasNext()) {
+            Map.Entry<Integer, Listener> entry = iterator.next();
+            int asset = entry.getKey();
+            Listener listener = entry.getValue();
+            int state = handler.getAssetState(asset);
+            float current = handler.getAssetProgress(asset);
+            if (current != progress.get(asset)) {
+                progress.put(asset, current);
+                listener.progress(asset, current);
+            }
+            if (state < COMPLETE) {
+                continue;
+            }
+
+            if (state == COMPLETE) {
+                listener.completed(asset);
+            } else if (state == CANCELLED) {
+                listener.cancelled(asset);
+            } else {
+                listener.failed(asset, handler.getAssetError(asset));
+            }
+            handler.releaseAsset(asset);
+            progress.remove(asset);
+            iterator.remove();
+        }
+    }
+
+    private int track(int asset, Listener listener) {
+        listeners.put(asset, listener);
+        progress.put(asset, 0.0f);
+        return asset;
+    }
+}
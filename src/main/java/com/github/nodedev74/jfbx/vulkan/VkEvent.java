@@ -0,0 +1,121 @@
+package com.github.nodedev74.jfbx.vulkan;
+
+import java.nio.ByteBuffer;
+import java.nio.charset.StandardCharsets;
+
+/**
+ * View on a single SDL event record of the event ring. The view is reused for
+ * every record while draining, so it must not be stored.
+ *
+ * <p>
+ * The payload depends on the event type:
+ * <ul>
+ * <li>{@link #KEY_DOWN}, {@link #KEY_UP}: scancode, keycode, modifiers,
+ * repeat</li>
+ * <li>{@link #MOUSE_MOTION}: x, y, relative x, relative y, button state</li>
+ * <li>{@link #MOUSE_BUTTON_DOWN}, {@link #MOUSE_BUTTON_UP}: x, y, button,
+ * clicks, pressed state</li>
+ * <li>{@link #MOUSE_WHEEL}: x, y, direction</li>
+ * <li>{@link #WINDOW_EVENT}: window event id, data1, data2</li>
+ * <li>{@link #TEXT_INPUT}, {@link #TEXT_EDITING}: up to 20 bytes of UTF-8
+ * text</li>
+ * </ul>
+ */
+public class VkEvent {
+
+    public static final int QUIT = 0x100;
+    public static final int WINDOW_EVENT = 0x200;
+    public static final int KEY_DOWN = 0x300;
+    public static final int KEY_UP = 0x301;
+    public static final int TEXT_EDITING = 0x302;
+    public static final int TEXT_INPUT = 0x303;
+    public static final int MOUSE_MOTION = 0x400;
+    public static final int MOUSE_BUTTON_DOWN = 0x401;
+    public static final int MOUSE_BUTTON_UP = 0x402;
+    public static final int MOUSE_WHEEL = 0x403;
+
+    public static final int WINDOW_EVENT_RESIZED = 5;
+    public static final int WINDOW_EVENT_CLOSE = 14;
+
+    static final int DATA_COUNT = 5;
+    private static final int TYPE_OFFSET = 0;
+    private static final int TIMESTAMP_OFFSET = 4;
+    private static final int WINDOW_ID_OFFSET = 8;
+    private static final int DATA_OFFSET = 12;
+
+    private ByteBuffer buffer;
+    private int offset;
+
+    /**
+     * Constructs a view on the records of an event ring.
+     *
+     * @param buffer The event ring buffer.
+     */
+    VkEvent(ByteBuffer buffer) {
+        this.buffer = buffer;
+    }
+
+    /**
+     * Moves the view to another record.
+     *
+     * @param offset The byte offset of the record.
+     */
+    void moveTo(int offset) {
+        this.offset = offset;
+    }
+
+    /**
+     * Retrieves the SDL event type.
+     *
+     * @return The event type.
+     */
+    public int getType() {
+        return buffer.getInt(offset + TYPE_OFFSET);
+    }
+
+    /**
+     * Retrieves the SDL timestamp of the event.
+     *
+     * @return The timestamp in milliseconds since SDL initialization.
+     */
+    public int getTimestamp() {
+        return buffer.getInt(offset + TIMESTAMP_OFFSET);
+    }
+
+    /**
+     * Retrieves the id of the window the event belongs to.
+     *
+     * @return The window id, 0 if the event is not bound to a window.
+     */
+    public int getWindowId() {
+        return buffer.getInt(offset + WINDOW_ID_OFFSET);
+    }
+
+    /**
+     * Retrieves a payload value of the event.
+     *
+     * @param index The payload index from 0 to 4.
+     * @return The payload value.
+     */
+    public int getData(int index) {
+        return buffer.getInt(offset + DATA_OFFSET + index * Integer.BYTES);
+    }
+
+    /**
+     * Retrieves the text of a text input or text editing event.
+     *
+     * @return The text.
+     */
+    public String getText() {
+        byte[] bytes = new byte[DATA_COUNT * Integer.BYTES];
+        int length = 0;
+        while (length < bytes.length) {
+            byte value = buffer.get(offset + DATA_OFFSET + length);
+            if (value == 0) {
+                break;
+            }
+            bytes[length++] = value;
+        }
+        return new String(bytes, 0, length, StandardCharsets.UTF_8);
+    }
+}
@@ -0,0 +1,86 @@
+package com.github.nodedev74.jfbx.vulkan;
+
+import java.lang.invoke.MethodHandles;
+import java.lang.invoke.VarHandle;
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
+import java.util.function.Consumer;
+
+/**
+ * Consumer side of the single-producer/single-consumer event ring that the
+ * native window fills with SDL events. The ring lives in a direct ByteBuffer,
+ * so draining it needs no JNI call.
+ *
+ * <p>
+ * Layout: a 128 byte header with the producer index at offset 0, the capacity
+ * at offset 4, the deferral count at offset 8 and the consumer index at
+ * offset 64, followed by the 32 byte event records.
+ */
+public class VkEventQueue {
+
+    public static final int HEADER_SIZE = 128;
+    public static final int RECORD_SIZE = 32;
+    public static final int WRITE_INDEX_OFFSET = 0;
+    public static final int CAPACITY_OFFSET = 4;
+    public static final int DEFERRED_OFFSET = 8;
+    public static final int READ_INDEX_OFFSET = 64;
+
+    private static final VarHandle INT_HANDLE = MethodHandles.byteBufferViewVarHandle(int[].class,
+            ByteOrder.nativeOrder());
+
+    private ByteBuffer buffer;
+    private VkEvent event;
+    private int mask;
+
+    /**
+     * Constructs the consumer of an event ring.
+     *
+     * @param buffer The direct buffer of the event ring.
+     */
+    public VkEventQueue(ByteBuffer buffer) {
+        this.buffer = buffer.order(ByteOrder.nativeOrder());
+        this.event = new VkEvent(this.buffer);
+        this.mask = this.buffer.getInt(CAPACITY_OFFSET) - 1;
+    }
+
+    /**
+     * Passes all pending events to the consumer and releases their records in
+     * one step.
+     *
+     * @param consumer The consumer called for every event.
+     * @return The number of drained events.
+     */
+    public int drain(Consumer<VkEvent> consumer) {
+        int readIndex = (int) INT_HANDLE.get(buffer, READ_INDEX_OFFSET);
+        int writeIndex = (int) INT_HANDLE.getAcquire(buffer, WRITE_INDEX_OFFSET);
+
+        int count = writeIndex - readIndex;
+        for (int index = readIndex; index != writeIndex; index++) {
+            event.moveTo(HEADER_SIZE + (index & mask) * RECORD_SIZE);
+            consumer.accept(event);
+        }
+
+        INT_HANDLE.setRelease(buffer, READ_INDEX_OFFSET, writeIndex);
+        return count;
+    }
+
+    /**
+     * Retrieves the number of frames in which the ring filled up and the
+     * remaining events were left in the SDL queue for a later frame. No event
+     * is dropped.
+     *
+     * @return The deferral count.
+     */
+    public int getDeferredCount() {
+        return (int) INT_HANDLE.getOpaque(buffer, DEFERRED_OFFSET);
+    }
+
+    /**
+     * Retrieves the number of records the ring can hold.
+     *
+     * @return The ring capacity.
+     */
+    public int getCapacity() {
+        return mask + 1;
+    }
+}
@@ -0,0 +1,82 @@
+package com.github.nodedev74.jfbx.vulkan;
+
+/**
+ * GPU timings of a completed frame collected by the Vulkan profiler.
+ */
+public class VkGpuTimings {
+
+    private String[] scopeNames;
+    private double[] scopeTimes;
+    private long[] pipelineStatistics;
+    private double presentTime;
+
+    /**
+     * Constructs the GPU timings of a frame.
+     *
+     * @param scopeNames         The names of the timestamp scopes.
+     * @param scopeTimes         The durations of the scopes in milliseconds.
+     * @param pipelineStatistics The pipeline statistics, empty if not collected.
+     * @param presentTime        The CPU time of the last present call in
+     *                           milliseconds.
+     */
+    public VkGpuTimings(String[] scopeNames, double[] scopeTimes, long[] pipelineStatistics, double presentTime) {
+        this.scopeNames = scopeNames;
+        this.scopeTimes = scopeTimes;
+        this.pipelineStatistics = pipelineStatistics;
+        this.presentTime = presentTime;
+    }
+
+    /**
+     * Retrieves the names of the timestamp scopes.
+     *
+     * @return The scope names in recording order.
+     */
+    public String[] getScopeNames() {
+        return scopeNames;
+    }
+
+    /**
+     * Retrieves the duration of a named scope.
+     *
+     * @param name The name of the scope.
+     * @return The duration in milliseconds, or -1 if the scope was not measured.
+     */
+    public double getScopeTime(String name) {
+        for (int i = 0; i < scopeNames.length && i < scopeTimes.length; i++) {
+            if (scopeNames[i].equals(name)) {
+                return scopeTimes[i];
+            }
+        }
+        return -1;
+    }
+
+    /**
+     * Retrieves the pipeline statistics. The counters are input assembly
+     * vertices, vertex shader invocations, clipping primitives, fragment shader
+     * invocations and compute shader invocations.
+     *
+     * @return The pipeline statistics, empty if not collected.
+     */
+    public long[] getPipelineStatistics() {
+        return pipelineStatistics;
+    }
+
+    /**
+     * Retrieves the CPU time of the last present call.
+     *
+     * @return The present time in milliseconds.
+     */
+    public double getPresentTime() {
+        return presentTime;
+    }
+
+    @Override
+    public String toString() {
+        StringBuilder builder = new StringBuilder();
+        for (int i = 0; i < scopeNames.length && i < scopeTimes.length; i++) {
+            builder.append(String.format("%s: %.3f ms, ", scopeNames[i], scopeTimes[i]));
+        }
+        builder.append(String.format("present: %.3f ms", presentTime));
+        return builder.toString();
+    }
+}
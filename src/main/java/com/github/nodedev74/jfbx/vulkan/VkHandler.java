@@ -1,12 +1,51 @@
 package com.github.nodedev74.jfbx.vulkan;
 
+import java.nio.ByteBuffer;
+
+import com.github.nodedev74.jfbx.anim.Skin;
+import com.github.nodedev74.jfbx.fbx.FbxScene;
+import com.github.nodedev74.jfbx.scene.SceneGraph;
+import java.util.concurrent.ExecutorService;
+import java.util.concurrent.Executors;
+
 /**
  * Contains interaction layer with Vulkan.
  */
 public class VkHandler {
 
+    private static final int INIT_THREADS = Math.max(2, Math.min(4, Runtime.getRuntime().availableProcessors()));
+
     private long sdlWindowPtr;
 
+    private boolean headless;
+    private int width;
+    private int height;
+    private int framesInFlight;
+
+    private boolean pipelineStatistics = Boolean.getBoolean("jfbx.pipelineStatistics");
+    private boolean synchronization2 = Boolean.parseBoolean(System.getProperty("jfbx.synchronization2", "true"));
+    private boolean dynamicRendering = Boolean.parseBoolean(System.getProperty("jfbx.dynamicRendering", "true"));
+    private int matrixCapacity = Integer.getInteger("jfbx.matrixCapacity", 4096);
+    private int skinVertexCapacity = Integer.getInteger("jfbx.skinVertexCapacity", 1 << 16);
+    private int skinnedVertexCapacity = Integer.getInteger("jfbx.skinnedVertexCapacity", 1 << 20);
+    private int jointCapacity = Integer.getInteger("jfbx.jointCapacity", 1 << 14);
+    private int skinInstanceCapacity = Integer.getInteger("jfbx.skinInstanceCapacity", 1024);
+    private int meshVertexCapacity = Integer.getInteger("jfbx.meshVertexCapacity", 1 << 20);
+    private int meshIndexCapacity = Integer.getInteger("jfbx.meshIndexCapacity", 1 << 22);
+    private int objectCapacity = Integer.getInteger("jfbx.objectCapacity", 1 << 17);
+    private int textureCapacity = Integer.getInteger("jfbx.textureCapacity", 4096);
+    private int storageBufferCapacity = Integer.getInteger("jfbx.storageBufferCapacity", 64);
+    private int materialCapacity = Integer.getInteger("jfbx.materialCapacity", 4096);
+    private String textureCache = System.getProperty("jfbx.textureCache");
+    private long textureBudget = Long.getLong("jfbx.textureBudget", 256L << 20);
+    private long streamingBandwidth = Long.getLong("jfbx.streamingBandwidth", 16L << 20);
+    private int streamingTailSize = Integer.getInteger("jfbx.streamingTailSize", 64);
+    private int assetThreads = Integer.getInteger("jfbx.assetThreads", 0);
+    private long assetUploadBudget = Long.getLong("jfbx.assetUploadBudget", 32L << 20);
+    private long memoryBudget = Long.getLong("jfbx.memoryBudget", 0L);
+
+    private VkStartupReport startupReport;
+
     /**
      * Constructs a Vulkan handler and prepares it
      * 
@@ -18,26 +57,107 @@ public class VkHandler {
     }
 
     /**
-     * Prepares Vulkan to get ready for render
+     * Constructs a headless Vulkan handler that renders into offscreen images
+     * instead of a window surface. No SDL window, surface or swapchain is
+     * created, so it also runs on CPU Vulkan drivers without a display.
+     * 
+     * @param width          The width of the offscreen images.
+     * @param height         The height of the offscreen images.
+     * @param framesInFlight The number of offscreen frames that can be in flight
+     *                       before a readback has to wait.
+     */
+    public VkHandler(int width, int height, int framesInFlight) {
+        this.headless = true;
+        this.width = width;
+        this.height = height;
+        this.framesInFlight = Math.max(1, framesInFlight);
+        this.prepare();
+    }
+
+    /**
+     * Prepares Vulkan to get ready for render. The native steps form an
+     * initialization graph, so steps that only depend on the device (shader
+     * loading, buffers, descriptors) overlap with the swapchain creation. Set the
+     * system property {@code jfbx.parallelInit} to false to run them in
+     * sequence.
      */
     private void prepare() {
-        createInstance();
-        createDebugger();
-        createSureface();
-        createLogicalDevice();
-        createSwapchain();
-        createCommandPool();
-        allocateCommandBuffers();
-        createHostBuffers();
-        createDeviceBuffers();
-        createDescriptorPool();
-        allocateDescriptorSets();
-        createRenderpass();
-        createFramebuffers();
-        createPipeline();
-        uploadInputData();
-        recordCommandBuffers();
-        createSemaphores();
+        String target = headless ? "createOffscreenTargets" : "createSwapchain";
+
+        VkInitGraph graph = new VkInitGraph();
+        graph.add("createInstance", this::createInstance);
+        graph.add("createDebugger", this::createDebugger, "createInstance");
+        if (headless) {
+            graph.add("createLogicalDevice", this::createLogicalDevice, "createInstance");
+            graph.add("createOffscreenTargets", this::createOffscreenTargets, "createLogicalDevice");
+        } else {
+            graph.add("createSureface", this::createSureface, "createInstance");
+            graph.add("createLogicalDevice", this::createLogicalDevice, "createSureface");
+            graph.add("createSwapchain", this::createSwapchain, "createLogicalDevice");
+        }
+        graph.add("loadShaders", this::loadShaders, "createLogicalDevice");
+        graph.add("createCommandPool", this::createCommandPool, "createLogicalDevice");
+        graph.add("allocateCommandBuffers", this::allocateCommandBuffers, "createCommandPool", target);
+        graph.add("createProfiler", this::createProfiler, "allocateCommandBuffers");
+        graph.add("createHostBuffers", this::createHostBuffers, target);
+        graph.add("createDeviceBuffers", this::createDeviceBuffers, "createHostBuffers");
+        graph.add("createDescriptorPool", this::createDescriptorPool, "createLogicalDevice");
+        graph.add("allocateDescriptorSets", this::allocateDescriptorSets, "createDescriptorPool", "createDeviceBuffers");
+        graph.add("createRenderGraph", this::createRenderGraph, target);
+        graph.add("createRenderpass", this::createRenderpass, "createRenderGraph");
+        graph.add("createFramebuffers", this::createFramebuffers, "createRenderpass");
+        graph.add("createMeshArena", this::createMeshArena, "createLogicalDevice", target);
+        graph.add("createPipeline", this::createPipeline, "createRenderpass", "loadShaders", "createMeshArena",
+                "createDescriptorPool", "createBindless");
+        graph.add("createSkinning", this::createSkinning, "loadShaders", target);
+        graph.add("createOcclusion", this::createOcclusion, "loadShaders", "createRenderGraph", "createMeshArena");
+        graph.add("uploadInputData", this::uploadInputData, "allocateCommandBuffers", "createHostBuffers",
+                "createDeviceBuffers");
+        graph.add("createBindless", this::createBindless, "uploadInputData");
+        if (headless) {
+            graph.add("createReadbackBuffers", this::createReadbackBuffers, target);
+            graph.add("recordCommandBuffers", this::recordCommandBuffers, "uploadInputData", "createProfiler",
+                    "allocateDescriptorSets", "createFramebuffers", "createPipeline", "createSkinning",
+                    "createOcclusion", "createReadbackBuffers");
+        } else {
+            graph.add("createSemaphores", this::createSemaphores, target);
+            graph.add("recordCommandBuffers", this::recordCommandBuffers, "uploadInputData", "createProfiler",
+                    "allocateDescriptorSets", "createFramebuffers", "createPipeline", "createSkinning",
+                    "createOcclusion");
+        }
+
+        if (Boolean.parseBoolean(System.getProperty("jfbx.parallelInit", "true"))) {
+            ExecutorService executor = Executors.newFixedThreadPool(INIT_THREADS, runnable -> {
+                Thread thread = new Thread(runnable, "vk-init");
+                thread.setDaemon(true);
+                return thread;
+            });
+            try {
+                startupReport = graph.run(executor);
+            } finally {
+                executor.shutdown();
+            }
+        } else {
+            startupReport = graph.run(Runnable::run);
+        }
+    }
+
+    /**
+     * Retrieves the timed breakdown of the initialization steps.
+     *
+     * @return The startup report.
+     */
+    public VkStartupReport getStartupReport() {
+        return startupReport;
+    }
+
+    /**
+     * Checks if the handler renders into offscreen images.
+     *
+     * @return True if the handler was created without a window.
+     */
+    public boolean isHeadless() {
+        return headless;
     }
 
     /**
@@ -65,6 +185,22 @@ public class VkHandler {
      */
     private native void createSwapchain();
 
+    /**
+     * Creates the offscreen images that replace the swapchain in headless mode
+     */
+    private native void createOffscreenTargets();
+
+    /**
+     * Declares the passes of a frame and creates the transient depth attachment
+     * they share
+     */
+    private native void createRenderGraph();
+
+    /**
+     * Creates the pooled host visible readback buffers and their fences
+     */
+    private native void createReadbackBuffers();
+
     /**
      * Creates a Vulkan command pool
      */
@@ -75,6 +211,11 @@ public class VkHandler {
      */
     private native void allocateCommandBuffers();
 
+    /**
+     * Creates the GPU profiler
+     */
+    private native void createProfiler();
+
     /**
      * Creates host buffers
      */
@@ -105,11 +246,38 @@ public class VkHandler {
      */
     private native void createFramebuffers();
 
+    /**
+     * Reads the SPIR-V shaders and creates their shader modules
+     */
+    private native void loadShaders();
+
     /**
      * Creates a Vulkan graphics pipeline
      */
     private native void createPipeline();
 
+    /**
+     * Creates the shared vertex and index arenas and the per frame draw lists
+     */
+    private native void createMeshArena();
+
+    /**
+     * Creates the skinning buffers and compute pipeline.
+     */
+    private native void createSkinning();
+
+    /**
+     * Creates the depth pyramid, buffers and compute pipelines of the occlusion
+     * culling.
+     */
+    private native void createOcclusion();
+
+    /**
+     * Creates the material table, the default texture and the bindless descriptor
+     * set.
+     */
+    private native void createBindless();
+
     /**
      * Uploads the input data
      */
@@ -126,10 +294,644 @@ public class VkHandler {
     private native void createSemaphores();
 
     /**
-     * Renders the Vulkan scene.
+     * Renders the Vulkan scene. An out of date or suboptimal swapchain is
+     * recreated, a frame whose image could not be acquired is skipped. If the
+     * texture streaming fails, the frame is still presented with the previous
+     * mip levels before a VkRuntimeError is thrown.
      */
     public native void render();
 
+    /**
+     * Attaches a scene graph. Before every frame the graph is updated and its
+     * world matrices are written into the matrix ring region of that frame, in
+     * slot order and up to {@code jfbx.matrixCapacity} matrices.
+     *
+     * @param graph The scene graph, or null to detach the current one.
+     */
+    public native void setSceneGraph(SceneGraph graph);
+
+    /**
+     * Uploads the bind pose of a skin. Skinning runs in a compute pass before the
+     * render pass of every frame, with joint matrices taken from the attached
+     * scene graph.
+     *
+     * @param skin The skin, it must not be destroyed while the handler is in use.
+     * @return The skin id.
+     */
+    public native int addSkin(Skin skin);
+
+    /**
+     * Adds an instance of an uploaded skin. Instances can be added at any time
+     * and are skinned from the next submitted frame on.
+     *
+     * @param skin       The skin id returned by {@link #addSkin(Skin)}.
+     * @param nodeOffset The offset added to the joint nodes of the skin.
+     * @return The instance id.
+     */
+    public native int addSkinInstance(int skin, int nodeOffset);
+
+    /**
+     * Copies the skinned positions of an instance back to the host. Waits for
+     * the queue to become idle, so it is meant for tests and tools.
+     *
+     * @param instance  The instance id returned by
+     *                  {@link #addSkinInstance(int, int)}.
+     * @param positions Receives x, y, z and w per vertex.
+     */
+    public native void readSkinnedVertices(int instance, float[] positions);
+
+    /**
+     * Uploads a triangle mesh into the shared vertex and index arenas, sized by
+     * {@code jfbx.meshVertexCapacity} and {@code jfbx.meshIndexCapacity}. Once
+     * objects are added, the command buffer of a frame is recorded right before
+     * its submission and only contains the draws of objects inside the view
+     * frustum.
+     *
+     * @param positions x, y and z per vertex.
+     * @param indices   Three indices per triangle.
+     * @return The mesh id.
+     */
+    public native int addMesh(float[] positions, int[] indices);
+
+    /**
+     * Adds an object that draws an uploaded mesh with the world matrix of a scene
+     * graph node. At most {@code jfbx.objectCapacity} objects can be added.
+     *
+     * @param mesh The mesh id returned by {@link #addMesh(float[], int[])}.
+     * @param node The node of the attached scene graph.
+     * @return The object id.
+     */
+    public int addObject(int mesh, int node) {
+        return addObject(mesh, node, 0);
+    }
+
+    /**
+     * Adds an object that draws an uploaded mesh with the world matrix of a scene
+     * graph node and passes a material index to the shaders. At most
+     * {@code jfbx.objectCapacity} objects can be added.
+     *
+     * @param mesh     The mesh id returned by {@link #addMesh(float[], int[])}.
+     * @param node     The node of the attached scene graph.
+     * @param material The material index.
+     * @return The object id.
+     */
+    public native int addObject(int mesh, int node, int material);
+
+    /**
+     * Adds an object that draws the triangles of an uploaded mesh with the
+     * skinned vertices of a skin instance, which its joints already place in the
+     * world. Skinned objects are drawn every frame without culling and count
+     * towards {@code jfbx.objectCapacity}.
+     *
+     * @param mesh     The mesh id returned by {@link #addMesh(float[], int[])},
+     *                 with as many vertices as the skin.
+     * @param instance The instance id returned by
+     *                 {@link #addSkinInstance(int, int)}.
+     * @param material The material index.
+     * @return The skinned object id.
+     */
+    public native int addSkinnedObject(int mesh, int instance, int material);
+
+    /**
+     * Sets the camera used for drawing and frustum culling.
+     *
+     * @param matrix The column major view projection matrix with a depth range of
+     *               0 to 1.
+     */
+    public native void setViewProjection(float[] matrix);
+
+    /**
+     * Enables or disables frustum culling of the objects, it is enabled by
+     * default.
+     *
+     * @param enabled False to draw every object.
+     */
+    public native void setFrustumCulling(boolean enabled);
+
+    /**
+     * Enables or disables occlusion culling of the objects against the depth of
+     * the previous frame, it is enabled by default. It needs indirect draws with a
+     * first instance, devices without them always draw every object passing
+     * frustum culling.
+     *
+     * @param enabled False to draw every object passing frustum culling.
+     */
+    public native void setOcclusionCulling(boolean enabled);
+
+    /**
+     * Switches between drawing all objects with multi draw indirect and recording
+     * one draw call per object, multi draw indirect is used by default where the
+     * device supports it.
+     *
+     * @param enabled False to record one draw call per object.
+     */
+    public native void setMultiDrawIndirect(boolean enabled);
+
+    /**
+     * Switches between drawing the objects of a mesh with one instanced draw and
+     * drawing every object on its own, instancing is used by default. With
+     * occlusion culling the instanced draws only cover the objects that pass the
+     * occlusion test.
+     *
+     * @param enabled False to draw every object on its own.
+     */
+    public native void setInstancing(boolean enabled);
+
+    /**
+     * Retrieves the number of objects drawn by the last submitted frame.
+     *
+     * @return The draw count.
+     */
+    public native int getDrawCount();
+
+    /**
+     * Retrieves the number of indexed draws of the last submitted frame, counting
+     * every command of an indirect draw. With instancing it is the number of
+     * meshes with visible objects.
+     *
+     * @return The draw call count.
+     */
+    public native int getDrawCallCount();
+
+    /**
+     * Uploads an RGBA8 texture that materials can refer to. At most
+     * {@code jfbx.textureCapacity} textures can be added, texture 0 is white.
+     *
+     * @param width  The width in pixels.
+     * @param height The height in pixels.
+     * @param pixels Four bytes per pixel, row by row.
+     * @return The texture index.
+     */
+    public native int addTexture(int width, int height, byte[] pixels);
+
+    /**
+     * Adds a material whose color is the base color multiplied with its texture.
+     * At most {@code jfbx.materialCapacity} materials can be added, material 0 is
+     * white.
+     *
+     * @param baseColor The red, green, blue and alpha factor.
+     * @param texture   The texture index returned by
+     *                  {@link #addTexture(int, int, byte[])}, or 0.
+     * @return The material index.
+     */
+    public native int addMaterial(float[] baseColor, int texture);
+
+    /**
+     * Decodes PNG and TGA files in parallel, builds their mip chains and uploads
+     * them as textures. With block compression opaque textures are stored as BC1
+     * and translucent ones as BC3 where the device supports it. If
+     * {@code jfbx.textureCache} names an existing directory, imported textures are
+     * cached there and reused for files with the same content.
+     *
+     * @param files            The encoded image files.
+     * @param blockCompression True to block compress the textures.
+     * @return The texture index per file.
+     */
+    public native int[] addEncodedTextures(byte[][] files, boolean blockCompression);
+
+    /**
+     * Requests a binary FBX file in the background. The file is imported, its
+     * textures decoded and its meshes, materials and textures uploaded at the
+     * start of later frames. Workers start on the first request,
+     * {@code jfbx.assetThreads} of them or half the hardware threads, and each
+     * frame uploads at most {@code jfbx.assetUploadBudget} bytes of assets.
+     *
+     * @param path             The file path.
+     * @param priority         Higher priorities are processed and uploaded first.
+     * @param blockCompression True to block compress the textures.
+     * @return The asset handle.
+     * @see VkAssetLoader
+     */
+    public native int loadScene(String path, int priority, boolean blockCompression);
+
+    /**
+     * Requests an encoded PNG or TGA texture in the background.
+     *
+     * @param file             The file content.
+     * @param priority         Higher priorities are processed and uploaded first.
+     * @param blockCompression True to block compress the texture.
+     * @return The asset handle.
+     */
+    public native int loadTexture(byte[] file, int priority, boolean blockCompression);
+
+    /**
+     * Requests a triangle mesh in the background.
+     *
+     * @param positions Three floats per vertex.
+     * @param indices   Three vertex indices per triangle.
+     * @param priority  Higher priorities are processed and uploaded first.
+     * @return The asset handle.
+     */
+    public native int loadMesh(float[] positions, int[] indices, int priority);
+
+    /**
+     * Changes the priority of an asset, effective from its next stage on.
+     *
+     * @param asset    The asset handle.
+     * @param priority The new priority.
+     */
+    public native void setAssetPriority(int asset, int priority);
+
+    /**
+     * Cancels an asset. Resources it uploaded before stay valid.
+     *
+     * @param asset The asset handle.
+     * @return False if the asset is unknown or already ended.
+     */
+    public native boolean cancelAsset(int asset);
+
+    /**
+     * Retrieves the state of an asset.
+     *
+     * @param asset The asset handle.
+     * @return One of the state constants of {@link VkAssetLoader}, FAILED for
+     *         unknown handles.
+     */
+    public native int getAssetState(int asset);
+
+    /**
+     * Retrieves the progress of an asset. Parsing ends at 0.4, processing at 0.8
+     * and uploading at 1.
+     *
+     * @param asset The asset handle.
+     * @return The progress from 0 to 1.
+     */
+    public native float getAssetProgress(int asset);
+
+    /**
+     * Retrieves the reason an asset failed.
+     *
+     * @param asset The asset handle.
+     * @return The message, or null if the asset did not fail.
+     */
+    public native String getAssetError(int asset);
+
+    /**
+     * Retrieves the texture indices of a complete asset, one per texture that
+     * could be decoded.
+     *
+     * @param asset The asset handle.
+     * @return The texture indices.
+     */
+    public native int[] getAssetTextures(int asset);
+
+    /**
+     * Retrieves the material indices of a complete scene asset, one per scene
+     * material.
+     *
+     * @param asset The asset handle.
+     * @return The material indices.
+     */
+    public native int[] getAssetMaterials(int asset);
+
+    /**
+     * Retrieves the mesh ids of a complete scene or mesh asset, one per scene
+     * mesh and -1 for meshes without triangles.
+     *
+     * @param asset The asset handle.
+     * @return The mesh ids.
+     */
+    public native int[] getAssetMeshes(int asset);
+
+    /**
+     * Takes the imported scene of a complete scene asset. The caller has to
+     * destroy it.
+     *
+     * @param asset The asset handle.
+     * @return The scene, or null if the asset is no complete scene or the scene
+     *         was taken before.
+     */
+    public native FbxScene takeAssetScene(int asset);
+
+    /**
+     * Forgets an asset, cancelling it if it has not ended yet.
+     *
+     * @param asset The asset handle.
+     */
+    public native void releaseAsset(int asset);
+
+    /**
+     * Imports textures like {@link #addEncodedTextures(byte[][], boolean)}, but
+     * uploads only their mip tails, the levels up to
+     * {@code jfbx.streamingTailSize} texels. Finer levels are streamed in before
+     * each frame as the visible objects need them, at most
+     * {@code jfbx.streamingBandwidth} bytes per frame, and the least recently
+     * needed levels are evicted to keep the streamed textures within
+     * {@code jfbx.textureBudget} bytes.
+     *
+     * @param files            The encoded image files.
+     * @param blockCompression True to block compress the textures.
+     * @return The texture index per file.
+     */
+    public native int[] addStreamedTextures(byte[][] files, boolean blockCompression);
+
+    /**
+     * Retrieves the bytes of the resident mip levels of all streamed textures.
+     *
+     * @return The size in bytes.
+     */
+    public native long getStreamingResidentBytes();
+
+    /**
+     * Retrieves the bytes of mip levels streamed in since the first streamed
+     * textures were added.
+     *
+     * @return The size in bytes.
+     */
+    public native long getStreamedBytes();
+
+    /**
+     * Retrieves the number of mip levels evicted to stay within the texture
+     * budget.
+     *
+     * @return The level count.
+     */
+    public native long getEvictedLevelCount();
+
+    /**
+     * Retrieves the number of streamed textures the last submitted frame sampled
+     * at a coarser level than its objects need.
+     *
+     * @return The texture count.
+     */
+    public native int getReducedQualityTextureCount();
+
+    /**
+     * Checks whether the device supports block compressed textures.
+     *
+     * @return True if BC formats can be sampled.
+     */
+    public native boolean isTextureCompressionSupported();
+
+    /**
+     * Retrieves the device memory allocated for textures, including their mip
+     * levels.
+     *
+     * @return The size in bytes.
+     */
+    public native long getTextureMemory();
+
+    /**
+     * Switches between indexing all textures and materials through one bindless
+     * descriptor set and binding a descriptor set per material, bindless is used
+     * by default where the device supports descriptor indexing.
+     *
+     * @param enabled False to bind a descriptor set per material.
+     */
+    public native void setBindless(boolean enabled);
+
+    /**
+     * Checks whether the device supports the bindless descriptor set.
+     *
+     * @return True if descriptor indexing is available.
+     */
+    public native boolean isBindlessSupported();
+
+    /**
+     * Retrieves the number of descriptor set binds recorded for the objects of
+     * the last submitted frame.
+     *
+     * @return The bind count.
+     */
+    public native int getDescriptorBindCount();
+
+    /**
+     * Retrieves the number of texture, buffer and material descriptors written
+     * since the handler was created.
+     *
+     * @return The descriptor write count.
+     */
+    public native long getDescriptorWriteCount();
+
+    /**
+     * Retrieves the number of objects the occlusion test skipped in the frame
+     * rendered last into the slot of the last submitted frame.
+     *
+     * @return The occluded count.
+     */
+    public native int getOccludedCount();
+
+    /**
+     * Retrieves the CPU time spent culling the objects, writing their draw list
+     * and recording the command buffer of the last submitted frame.
+     *
+     * @return The record time in milliseconds.
+     */
+    public native double getRecordTime();
+
+    /**
+     * Retrieves the CPU time spent writing the world matrices of the last
+     * submitted frame into its region of the mapped matrix ring.
+     *
+     * @return The write time in milliseconds.
+     */
+    public native double getMatrixWriteTime();
+
+    /**
+     * Retrieves the number of memory and image barriers the render graph recorded
+     * for the last recorded frame. Barriers are recorded with synchronization2
+     * where the device supports it, set the system property
+     * {@code jfbx.synchronization2} to false to record the original barriers.
+     *
+     * @return The barrier count.
+     */
+    public native int getBarrierCount();
+
+    /**
+     * Retrieves the number of barrier commands the render graph recorded for the
+     * last recorded frame. The barriers in front of a pass share one command.
+     *
+     * @return The barrier command count.
+     */
+    public native int getBarrierBatchCount();
+
+    /**
+     * Retrieves the number of passes the render graph culled from the last
+     * recorded frame because nothing read their results, such as the skinning
+     * pass without skin instances.
+     *
+     * @return The culled pass count.
+     */
+    public native int getCulledPassCount();
+
+    /**
+     * Retrieves the size of the memory shared by the transient images of the
+     * render graph.
+     *
+     * @return The size in bytes.
+     */
+    public native long getTransientMemory();
+
+    /**
+     * Retrieves the memory the transient images of the render graph save compared
+     * to one image per frame slot without aliasing.
+     *
+     * @return The size in bytes.
+     */
+    public native long getTransientMemorySaved();
+
+    /**
+     * Recreates the swapchain, for example after presenting reported it out of
+     * date, together with the image views and framebuffers that reference its
+     * images, and records every frame slot again. The size, surface format and
+     * image count stay the same. In headless mode the offscreen images are kept
+     * and only their views and framebuffers are rebuilt.
+     */
+    public native void recreateSwapchain();
+
+    /**
+     * Retrieves the CPU time of the last {@link #recreateSwapchain()}.
+     *
+     * @return The recreation time in milliseconds.
+     */
+    public native double getSwapchainRecreateTime();
+
+    /**
+     * Checks whether frames render with {@code VK_KHR_dynamic_rendering}, which
+     * begins rendering directly on the image views instead of a render pass and
+     * one framebuffer per image. It is used where the device supports it unless
+     * the system property {@code jfbx.dynamicRendering} is false.
+     *
+     * @return True if dynamic rendering is used.
+     */
+    public native boolean isDynamicRenderingSupported();
+
+    /**
+     * Retrieves the number of graphics pipelines created by this handler.
+     *
+     * @return The pipeline count.
+     */
+    public native int getPipelineCreateCount();
+
+    /**
+     * Checks whether the memory budgets come from {@code VK_EXT_memory_budget}.
+     * The driver then reports the usage of the whole process and budgets that
+     * follow other applications on the device; without it the usage is what this
+     * handler allocated and the budget is 80% of each heap. The system property
+     * {@code jfbx.memoryBudget} caps the budget of the device local heaps
+     * further.
+     *
+     * @return True if the extension is used.
+     */
+    public native boolean isMemoryBudgetSupported();
+
+    /**
+     * Retrieves the device memory allocated for a category.
+     *
+     * @param category One of the {@link VkMemoryCategory} constants.
+     * @return The size in bytes.
+     */
+    public native long getCategoryMemory(int category);
+
+    /**
+     * Retrieves the budget of the device local heaps.
+     *
+     * @return The size in bytes.
+     */
+    public native long getMemoryBudget();
+
+    /**
+     * Retrieves the usage of the device local heaps the budget is checked
+     * against.
+     *
+     * @return The size in bytes.
+     */
+    public native long getMemoryUsage();
+
+    /**
+     * Retrieves the number of times resources were evicted to stay within the
+     * budget. Evictions run at the start of a frame. Streamed textures drop to
+     * their tail levels, least recently requested first.
+     *
+     * @return The eviction count.
+     */
+    public native long getEvictionCount();
+
+    /**
+     * Retrieves the device memory freed by evictions.
+     *
+     * @return The size in bytes.
+     */
+    public native long getEvictedMemory();
+
+    /**
+     * Retrieves the number of allocations refused because their heap was over
+     * budget. Assets whose upload was refused fail instead of the device running
+     * out of memory, and the missing memory is evicted at the start of the next
+     * frame.
+     *
+     * @return The refused allocation count.
+     */
+    public native long getRefusedAllocationCount();
+
+    /**
+     * Submits the next offscreen frame. The frame is rendered into the next slot
+     * of the readback ring; if that slot is still in flight this call waits for
+     * it first. Only available in headless mode. If the texture streaming fails,
+     * the frame is still submitted with the previous mip levels before a
+     * VkRuntimeError is thrown.
+     *
+     * @return The slot the frame has been submitted to.
+     */
+    public native int submitOffscreen();
+
+    /**
+     * Waits until the frame of the given slot has been copied to host memory and
+     * returns its pixels as tightly packed RGBA8 rows. The buffer is a view on
+     * mapped memory and is only valid until the slot is submitted again.
+     *
+     * @param slot The slot returned by {@link #submitOffscreen()}.
+     * @return The pixels of the rendered frame.
+     */
+    public native ByteBuffer readback(int slot);
+
+    /**
+     * Retrieves the GPU timings of the last completed frame. Timings are read
+     * without stalling, so they lag a few frames behind the current one.
+     * Pipeline statistics are only collected when the system property
+     * {@code jfbx.pipelineStatistics} is set and the device supports them.
+     *
+     * @return The GPU timings.
+     */
+    public VkGpuTimings getGpuTimings() {
+        return new VkGpuTimings(getGpuScopeNames(), getGpuScopeTimes(), getPipelineStatistics(), getPresentTime());
+    }
+
+    /**
+     * Checks if the queue family supports timestamp queries.
+     *
+     * @return True if GPU timings are available.
+     */
+    public native boolean isGpuProfilingSupported();
+
+    /**
+     * Retrieves the names of the GPU profiler scopes.
+     *
+     * @return The scope names in recording order.
+     */
+    private native String[] getGpuScopeNames();
+
+    /**
+     * Retrieves the GPU scope durations of the last completed frame.
+     *
+     * @return The durations in milliseconds.
+     */
+    private native double[] getGpuScopeTimes();
+
+    /**
+     * Retrieves the pipeline statistics of the last completed frame.
+     *
+     * @return The pipeline statistics, empty if they are not collected.
+     */
+    private native long[] getPipelineStatistics();
+
+    /**
+     * Retrieves the CPU time spent in the last present call.
+     *
+     * @return The present time in milliseconds.
+     */
+    private native double getPresentTime();
+
     /**
      * Destroys the Vulkan resources.
      */
@@ -0,0 +1,89 @@
+package com.github.nodedev74.jfbx.vulkan;
+
+import java.util.ArrayList;
+import java.util.LinkedHashMap;
+import java.util.List;
+import java.util.Map;
+import java.util.concurrent.CompletableFuture;
+import java.util.concurrent.CompletionException;
+import java.util.concurrent.Executor;
+
+/**
+ * Initialization graph whose steps run as soon as all of their dependencies
+ * have finished. Independent steps run concurrently on the given executor.
+ */
+public class VkInitGraph {
+
+    private Map<String, Step> steps = new LinkedHashMap<>();
+
+    /**
+     * A single step of the graph.
+     */
+    private static class Step {
+        private String name;
+        private Runnable action;
+        private String[] dependencies;
+        private CompletableFuture<Void> future;
+    }
+
+    /**
+     * Adds a step to the graph. Dependencies must have been added before.
+     *
+     * @param name         The unique name of the step.
+     * @param action       The action of the step.
+     * @param dependencies The names of the steps that have to finish first.
+     * @return This graph.
+     */
+    public VkInitGraph add(String name, Runnable action, String... dependencies) {
+        for (String dependency : dependencies) {
+            if (!steps.containsKey(dependency)) {
+                throw new IllegalArgumentException("Unknown dependency " + dependency + " of " + name);
+            }
+        }
+
+        Step step = new Step();
+        step.name = name;
+        step.action = action;
+        step.dependencies = dependencies;
+        steps.put(name, step);
+        return this;
+    }
+
+    /**
+     * Runs all steps and waits until they have finished. The first failing step
+     * cancels all steps that depend on it and its exception is rethrown.
+     *
+     * @param executor The executor the steps are run on.
+     * @return The timings of all steps.
+     */
+    public VkStartupReport run(Executor executor) {
+        VkStartupReport report = new VkStartupReport();
+        List<CompletableFuture<Void>> futures = new ArrayList<>();
+
+        for (Step step : steps.values()) {
+            CompletableFuture<?>[] dependencies = new CompletableFuture<?>[step.dependencies.length];
+            for (int i = 0; i < dependencies.length; i++) {
+                dependencies[i] = steps.get(step.dependencies[i]).future;
+            }
+
+            step.future = CompletableFuture.allOf(dependencies).thenRunAsync(() -> {
+                long startTime = System.nanoTime();
+                step.action.run();
+                report.add(step.name, Thread.currentThread().getName(), startTime, System.nanoTime());
+            }, executor);
+            futures.add(step.future);
+        }
+
+        try {
+            CompletableFuture.allOf(futures.toArray(new CompletableFuture<?>[0])).join();
+        } catch (CompletionException e) {
+            if (e.getCause() instanceof RuntimeException cause) {
+                throw cause;
+            }
+            throw e;
+        }
+
+        report.finish();
+        return report;
+    }
+}
@@ -0,0 +1,18 @@
+package com.github.nodedev74.jfbx.vulkan;
+
+/**
+ * The categories device memory is reported in by
+ * {@link VkHandler#getCategoryMemory(int)}.
+ */
+public final class VkMemoryCategory {
+
+    public static final int VERTEX = 0;
+    public static final int INDEX = 1;
+    public static final int TEXTURE = 2;
+    public static final int STAGING = 3;
+    public static final int UNIFORM = 4;
+    public static final int TARGET = 5;
+
+    private VkMemoryCategory() {
+    }
+}
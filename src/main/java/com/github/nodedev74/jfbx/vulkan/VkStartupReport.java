@@ -0,0 +1,132 @@
+package com.github.nodedev74.jfbx.vulkan;
+
+import java.util.ArrayList;
+import java.util.Comparator;
+import java.util.List;
+
+/**
+ * Timed breakdown of the Vulkan initialization steps.
+ */
+public class VkStartupReport {
+
+    private long creationTime = System.nanoTime();
+    private long totalTime;
+    private List<Entry> entries = new ArrayList<>();
+
+    /**
+     * Timing of a single initialization step.
+     */
+    public static class Entry {
+        private String name;
+        private String thread;
+        private long startTime;
+        private long duration;
+
+        /**
+         * Retrieves the name of the step.
+         *
+         * @return The step name.
+         */
+        public String getName() {
+            return name;
+        }
+
+        /**
+         * Retrieves the name of the thread that ran the step.
+         *
+         * @return The thread name.
+         */
+        public String getThread() {
+            return thread;
+        }
+
+        /**
+         * Retrieves the start of the step relative to the start of the
+         * initialization.
+         *
+         * @return The start time in nanoseconds.
+         */
+        public long getStartTime() {
+            return startTime;
+        }
+
+        /**
+         * Retrieves the duration of the step.
+         *
+         * @return The duration in nanoseconds.
+         */
+        public long getDuration() {
+            return duration;
+        }
+    }
+
+    /**
+     * Adds the timing of a finished step.
+     *
+     * @param name      The step name.
+     * @param thread    The name of the thread that ran the step.
+     * @param startTime The start time as returned by System.nanoTime().
+     * @param endTime   The end time as returned by System.nanoTime().
+     */
+    synchronized void add(String name, String thread, long startTime, long endTime) {
+        Entry entry = new Entry();
+        entry.name = name;
+        entry.thread = thread;
+        entry.startTime = startTime - creationTime;
+        entry.duration = endTime - startTime;
+        entries.add(entry);
+    }
+
+    /**
+     * Marks the initialization as finished.
+     */
+    synchronized void finish() {
+        totalTime = System.nanoTime() - creationTime;
+        entries.sort(Comparator.comparingLong(Entry::getStartTime));
+    }
+
+    /**
+     * Retrieves the timings of all steps ordered by their start time.
+     *
+     * @return The step timings.
+     */
+    public synchronized List<Entry> getEntries() {
+        return new ArrayList<>(entries);
+    }
+
+    /**
+     * Retrieves the wall clock time of the whole initialization.
+     *
+     * @return The total time in nanoseconds.
+     */
+    public long getTotalTime() {
+        return totalTime;
+    }
+
+    /**
+     * Retrieves the sum of all step durations. Compared with the total time this
+     * shows how much work overlapped.
+     *
+     * @return The summed step time in nanoseconds.
+     */
+    public synchronized long getSummedTime() {
+        long sum = 0;
+        for (Entry entry : entries) {
+            sum += entry.duration;
+        }
+        return sum;
+    }
+
+    @Override
+    public synchronized String toString() {
+        StringBuilder builder = new StringBuilder();
+        builder.append(String.format("%-24s %10s %10s  %s%n", "step", "start ms", "time ms", "thread"));
+        for (Entry entry : entries) {
+            builder.append(String.format("%-24s %10.3f %10.3f  %s%n", entry.name, entry.startTime / 1e6,
+                    entry.duration / 1e6, entry.thread));
+        }
+        builder.append(String.format("total %.3f ms, summed steps %.3f ms%n", totalTime / 1e6,
+                getSummedTime() / 1e6));
+        return builder.toString();
+    }
+}
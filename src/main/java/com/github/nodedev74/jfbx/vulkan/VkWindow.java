@@ -1,5 +1,8 @@
 package com.github.nodedev74.jfbx.vulkan;
 
+import java.nio.ByteBuffer;
+import java.util.function.Consumer;
+
 import com.github.nodedev74.jfbx.stage.control.Control;
 
 /**
@@ -14,6 +17,13 @@ public class VkWindow extends Control {
 
     private VkHandler handler;
 
+    private static final int EVENT_RING_CAPACITY = 4096;
+
+    private ByteBuffer eventBuffer;
+    private VkEventQueue events;
+    private Consumer<VkEvent> eventListener;
+    private boolean closeRequested;
+
     /**
      * Constructs a Vulkan window with its Vulkan handler
      * 
@@ -25,9 +35,40 @@ public class VkWindow extends Control {
         this.height = height;
 
         sdlWindowPtr = create(width, height);
+        eventBuffer = createEventRing(EVENT_RING_CAPACITY);
+        events = new VkEventQueue(eventBuffer);
         handler = new VkHandler(sdlWindowPtr);
     }
 
+    /**
+     * Sets the listener that receives every SDL event of the window once per
+     * frame. The event passed to the listener is a reused view and must not be
+     * stored.
+     *
+     * @param eventListener The event listener, or null to ignore events.
+     */
+    public void setEventListener(Consumer<VkEvent> eventListener) {
+        this.eventListener = eventListener;
+    }
+
+    /**
+     * Retrieves the event queue of the window.
+     *
+     * @return The event queue.
+     */
+    public VkEventQueue getEventQueue() {
+        return events;
+    }
+
+    /**
+     * Retrieves the Vulkan handler of the window.
+     *
+     * @return The Vulkan handler.
+     */
+    public VkHandler getHandler() {
+        return handler;
+    }
+
     /**
      * JNI function to create a Vulkan window.
      *
@@ -37,6 +78,14 @@ public class VkWindow extends Control {
      */
     public native long create(int width, int height);
 
+    /**
+     * JNI function to create the event ring shared with the native window.
+     *
+     * @param capacity The number of event records, rounded up to a power of two.
+     * @return The direct buffer of the event ring.
+     */
+    private native ByteBuffer createEventRing(int capacity);
+
     /**
      * JNI function to destroy a Vulkan window.
      */
@@ -53,11 +102,13 @@ public class VkWindow extends Control {
     public native void hide();
 
     /**
-     * JNI function run the lifecycle of the SDLWindow
+     * JNI function run the lifecycle of the SDLWindow. Pending SDL events are
+     * written into the event ring.
      * 
      * @param sdlWindowPtr The pointer to the SDLWindow as a jlong value.
+     * @param eventBuffer  The direct buffer of the event ring.
      */
-    private native void run(long sdlWindowPtr);
+    private native void run(long sdlWindowPtr, ByteBuffer eventBuffer);
 
     /**
      * Executes the lifecycle of the Vulkan window.
@@ -67,6 +118,28 @@ public class VkWindow extends Control {
     @Override
     public void lifecycle() {
         handler.render();
-        run(sdlWindowPtr);
+        run(sdlWindowPtr, eventBuffer);
+        events.drain(this::dispatch);
+
+        if (closeRequested) {
+            destroy();
+        }
+    }
+
+    /**
+     * Handles a single SDL event and forwards it to the event listener.
+     *
+     * @param event The event.
+     */
+    private void dispatch(VkEvent event) {
+        int type = event.getType();
+        if (type == VkEvent.QUIT
+                || (type == VkEvent.WINDOW_EVENT && event.getData(0) == VkEvent.WINDOW_EVENT_CLOSE)) {
+            closeRequested = true;
+        }
+
+        if (eventListener != null) {
+            eventListener.accept(event);
+        }
     }
 }
@@ -0,0 +1,73 @@
+/**
+ * @file AnimationSampler.hpp
+ * @author Lenard Büsing (nodedev74@gmail.com)
+ * @brief Playback state of an animation stack.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2023 Lenard Büsing
+ *
+ */
+
+#ifndef ANIMATION_SAMPLER_HPP
+#define ANIMATION_SAMPLER_HPP
+
+#include <cstdint>
+#include <vector>
+
+class AnimationStack;
+class SceneGraph;
+class ThreadPool;
+
+/**
+ * @brief Samples all channels of a stack and writes the values into a scene graph.
+ *
+ * Every sampler keeps one cursor per channel, so several samplers can play the same stack at
+ * different times.
+ */
+class AnimationSampler
+{
+public:
+    /**
+     * @brief Creates a sampler with all cursors at the first key.
+     *
+     * @param stack The stack to play, it has to outlive the sampler.
+     */
+    explicit AnimationSampler(const AnimationStack &stack);
+
+    /**
+     * @brief Samples all channels.
+     *
+     * @param time The time in seconds.
+     * @param pool The pool to split the channels across, or nullptr to sample on the calling thread.
+     */
+    void sample(float time, ThreadPool *pool);
+
+    /**
+     * @brief Retrieves the number of sampled channels.
+     *
+     * @return The channel count.
+     */
+    uint32_t getChannelCount() const;
+
+    /**
+     * @brief Retrieves the values of the last sample.
+     *
+     * @return Pointer to one value per channel.
+     */
+    const float *getValues() const;
+
+    /**
+     * @brief Writes the values of the last sample into the local transforms of a scene graph.
+     *
+     * @param graph The scene graph. Channels targeting nodes outside the graph are ignored.
+     */
+    void apply(SceneGraph &graph) const;
+
+private:
+    const AnimationStack &stack;
+    std::vector<uint32_t> cursors;
+    std::vector<float> values;
+};
+
+#endif // !ANIMATION_SAMPLER_HPP
@@ -0,0 +1,284 @@
+/**
+ * @file AnimationStack.hpp
+ * @author Lenard Büsing (nodedev74@gmail.com)
+ * @brief Animation curves converted into a per channel key layout for sampling.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2023 Lenard Büsing
+ *
+ */
+
+#ifndef ANIMATION_STACK_HPP
+#define ANIMATION_STACK_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class FbxScene;
+
+/**
+ * @brief Number of animatable transform components: translation, rotation and scaling x, y and z.
+ */
+constexpr uint8_t ANIMATION_PROPERTY_COUNT = 9;
+
+/**
+ * @brief Interpolation from a key to the next one.
+ */
+enum class AnimationInterpolation : uint8_t
+{
+    Constant,
+    Linear,
+    Cubic,
+};
+
+/**
+ * @brief A key as passed to AnimationStack::addChannel.
+ *
+ * Slopes are in value units per second and are only used for cubic interpolation. rightSlope
+ * leaves this key, nextLeftSlope arrives at the following key, as in FBX.
+ */
+struct AnimationKey
+{
+    float time = 0.0f;
+    float value = 0.0f;
+    AnimationInterpolation interpolation = AnimationInterpolation::Linear;
+    float rightSlope = 0.0f;
+    float nextLeftSlope = 0.0f;
+};
+
+/**
+ * @brief A set of animation channels, each driving one transform component of a scene graph node.
+ *
+ * The keys of a channel are stored contiguously, every key holding time, value and the two
+ * tangents of the segment it starts, so evaluating a segment touches two adjacent keys. Each
+ * channel ends with a constant sentinel key, so every key has a successor and sampling needs
+ * no special case for the end of a channel.
+ */
+class AnimationStack
+{
+public:
+    /**
+     * @brief A key with the tangents of the segment it starts, already scaled by the segment duration.
+     */
+    struct alignas(16) PackedKey
+    {
+        float time;
+        float value;
+        float outTangent;
+        float inTangent;
+    };
+
+    /**
+     * @brief A key quantized to 16 bits per component.
+     *
+     * The time is relative to the time range of the stack, the value relative to the value range
+     * of the channel and the tangents relative to the largest tangent of the channel.
+     */
+    struct QuantizedKey
+    {
+        uint16_t time;
+        uint16_t value;
+        int16_t outTangent;
+        int16_t inTangent;
+    };
+
+    /**
+     * @brief Creates an empty stack.
+     *
+     * @param name The stack name.
+     * @param startTime The start of the playback range in seconds.
+     * @param endTime The end of the playback range in seconds.
+     */
+    AnimationStack(const std::string &name, float startTime, float endTime);
+
+    /**
+     * @brief Converts an imported FBX animation stack.
+     *
+     * @param scene The imported scene, channels target the scene graph node of the same model index.
+     * @param stackIndex The index of the animation stack.
+     * @param tolerance The key reduction tolerance, 0 keeps all keys.
+     * @param quantize True to store the keys quantized.
+     * @return The new stack, owned by the caller.
+     */
+    static AnimationStack *fromScene(const FbxScene &scene, uint32_t stackIndex, float tolerance, bool quantize);
+
+    /**
+     * @brief Loads a stack from a cache file written by save.
+     *
+     * @param path The file path.
+     * @return The new stack, owned by the caller.
+     * @throws std::runtime_error If the file cannot be read or is not a stack cache.
+     */
+    static AnimationStack *load(const std::string &path);
+
+    /**
+     * @brief Removes keys that can be approximated within a tolerance.
+     *
+     * Spans of keys are replaced by a single linear or cubic Hermite segment whose tangents
+     * follow the original curve, as long as the segment stays within the tolerance at every
+     * removed key and at the middle of every original segment. Constant keys are kept.
+     *
+     * @param keys The keys, sorted by time.
+     * @param tolerance The maximum absolute error in value units.
+     * @return The reduced keys.
+     */
+    static std::vector<AnimationKey> reduceKeys(const std::vector<AnimationKey> &keys, float tolerance);
+
+    /**
+     * @brief Sets the tolerance applied by reduceKeys to channels added afterwards.
+     *
+     * @param tolerance The maximum absolute error in value units, 0 keeps all keys.
+     */
+    void setTolerance(float tolerance);
+
+    /**
+     * @brief Converts all keys to 16 bit quantized keys and releases the float keys.
+     *
+     * No channels can be added afterwards.
+     */
+    void quantize();
+
+    /**
+     * @brief Checks if the keys are quantized.
+     *
+     * @return True after quantize.
+     */
+    bool isQuantized() const;
+
+    /**
+     * @brief Writes the stack into a cache file.
+     *
+     * @param path The file path.
+     * @throws std::runtime_error If the file cannot be written.
+     */
+    void save(const std::string &path) const;
+
+    /**
+     * @brief Adds a channel.
+     *
+     * Keys must be sorted by time. Keys sharing a time are collapsed into the last one.
+     *
+     * @param node The scene graph node.
+     * @param property The transform component, 0 to 8.
+     * @param keys The keys.
+     * @param defaultValue The value of a channel without keys.
+     */
+    void addChannel(uint32_t node, uint8_t property, const std::vector<AnimationKey> &keys, float defaultValue);
+
+    /**
+     * @brief Retrieves the stack name.
+     *
+     * @return The name.
+     */
+    const std::string &getName() const;
+
+    /**
+     * @brief Retrieves the start of the playback range.
+     *
+     * @return The start time in seconds.
+     */
+    float getStartTime() const;
+
+    /**
+     * @brief Retrieves the end of the playback range.
+     *
+     * @return The end time in seconds.
+     */
+    float getEndTime() const;
+
+    /**
+     * @brief Retrieves the number of channels.
+     *
+     * @return The channel count.
+     */
+    uint32_t getChannelCount() const;
+
+    /**
+     * @brief Retrieves the number of keys of all channels, without sentinels.
+     *
+     * @return The key count.
+     */
+    size_t getKeyCount() const;
+
+    /**
+     * @brief Retrieves the memory used by channels and keys.
+     *
+     * @return The size in bytes.
+     */
+    size_t getMemorySize() const;
+
+    /**
+     * @brief Retrieves the node driven by a channel.
+     *
+     * @param channel The channel.
+     * @return The scene graph node.
+     */
+    uint32_t getNode(uint32_t channel) const;
+
+    /**
+     * @brief Retrieves the transform component driven by a channel.
+     *
+     * @param channel The channel.
+     * @return The transform component, 0 to 8.
+     */
+    uint8_t getProperty(uint32_t channel) const;
+
+    /**
+     * @brief Finds the key starting the segment that contains the time.
+     *
+     * Starts from the key found for the previous sample, so playback moving forward by a frame
+     * costs a comparison or two instead of a binary search.
+     *
+     * @param channel The channel.
+     * @param time The time in seconds.
+     * @param cursor The key found for the previous sample.
+     * @return The key index relative to the first key of the channel.
+     */
+    uint32_t seek(uint32_t channel, float time, uint32_t cursor) const;
+
+    /**
+     * @brief Samples a range of channels.
+     *
+     * Channels are processed four at a time with SSE2 when available.
+     *
+     * @param time The time in seconds.
+     * @param begin The first channel.
+     * @param end One past the last channel.
+     * @param cursors Per channel cursors, updated in place.
+     * @param out Per channel output values.
+     */
+    void sample(float time, uint32_t begin, uint32_t end, uint32_t *cursors, float *out) const;
+
+private:
+    template <typename Key>
+    uint32_t seekKeys(const Key *channelKeys, uint32_t count, float time, uint32_t cursor) const;
+    void sampleFloat(float time, uint32_t begin, uint32_t end, uint32_t *cursors, float *out) const;
+    void sampleQuantized(float time, uint32_t begin, uint32_t end, uint32_t *cursors, float *out) const;
+
+    std::string name;
+    float startTime;
+    float endTime;
+    float tolerance = 0.0f;
+    size_t keyCount = 0;
+
+    std::vector<uint32_t> channelNodes;
+    std::vector<uint8_t> channelProperties;
+    std::vector<uint32_t> channelFirstKeys;
+    std::vector<uint32_t> channelKeyCounts;
+
+    std::vector<PackedKey> keys;
+    std::vector<uint8_t> keySteps;
+
+    bool quantized = false;
+    float timeOffset = 0.0f;
+    float timeScale = 1.0f;
+    std::vector<float> channelValueOffsets;
+    std::vector<float> channelValueScales;
+    std::vector<float> channelTangentScales;
+    std::vector<QuantizedKey> quantizedKeys;
+};
+
+#endif // !ANIMATION_STACK_HPP
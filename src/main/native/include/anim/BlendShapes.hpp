@@ -0,0 +1,164 @@
+/**
+ * @file BlendShapes.hpp
+ * @author Lenard Büsing (nodedev74@gmail.com)
+ * @brief Morph targets of a mesh with sparse delta storage.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2023 Lenard Büsing
+ *
+ */
+
+#ifndef BLEND_SHAPES_HPP
+#define BLEND_SHAPES_HPP
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class FbxScene;
+class ThreadPool;
+
+/**
+ * @brief Deltas with no component above this magnitude are not stored.
+ */
+constexpr float BLEND_SHAPE_EPSILON = 1e-6f;
+
+/**
+ * @brief The base positions of a mesh and the shapes blended onto them.
+ *
+ * Every shape stores only the vertices it moves, as ascending vertex indices and deltas padded
+ * to four floats, so a delta is applied with one SIMD multiply-add. Shapes share one index and
+ * one delta array. Evaluation skips shapes whose weight is zero and, for a vertex range, finds
+ * the affected entries of a shape by binary search.
+ */
+class BlendShapes
+{
+public:
+    /**
+     * @brief Creates blend shapes without any shape.
+     *
+     * @param basePositions The base positions, x, y and z per vertex.
+     * @throws std::runtime_error If the positions are not a multiple of three.
+     */
+    explicit BlendShapes(const std::vector<float> &basePositions);
+
+    /**
+     * @brief Converts a blend shape deformer of an imported scene.
+     *
+     * Vertices are the control points of the deformed mesh. Every channel becomes a shape whose
+     * weight is its deform percent.
+     *
+     * @param scene The imported scene.
+     * @param blendShapeIndex The index of the blend shape deformer.
+     * @return The new blend shapes, owned by the caller.
+     */
+    static BlendShapes *fromScene(const FbxScene &scene, uint32_t blendShapeIndex);
+
+    /**
+     * @brief Adds a shape from sparse deltas. Duplicate indices are summed up and deltas below
+     * BLEND_SHAPE_EPSILON are dropped.
+     *
+     * @param name The shape name.
+     * @param indices The vertex indices.
+     * @param deltas x, y and z per index.
+     * @return The shape index.
+     * @throws std::runtime_error If the arrays do not match or an index is out of range.
+     */
+    uint32_t addShape(const std::string &name, const std::vector<uint32_t> &indices, const std::vector<float> &deltas);
+
+    /**
+     * @brief Adds a shape from a delta for every vertex, keeping only the vertices it moves.
+     *
+     * @param name The shape name.
+     * @param deltas x, y and z per vertex.
+     * @return The shape index.
+     * @throws std::runtime_error If the deltas do not match the vertex count.
+     */
+    uint32_t addDenseShape(const std::string &name, const std::vector<float> &deltas);
+
+    /**
+     * @brief Retrieves the number of vertices.
+     *
+     * @return The vertex count.
+     */
+    uint32_t getVertexCount() const;
+
+    /**
+     * @brief Retrieves the number of shapes.
+     *
+     * @return The shape count.
+     */
+    uint32_t getShapeCount() const;
+
+    /**
+     * @brief Retrieves the name of a shape.
+     *
+     * @param shape The shape index.
+     * @return The name.
+     */
+    const std::string &getShapeName(uint32_t shape) const;
+
+    /**
+     * @brief Retrieves the number of stored deltas of all shapes.
+     *
+     * @return The delta count.
+     */
+    size_t getDeltaCount() const;
+
+    /**
+     * @brief Sets the weight of a shape, 1 applies its full deltas.
+     *
+     * @param shape The shape index.
+     * @param weight The weight.
+     */
+    void setWeight(uint32_t shape, float weight);
+
+    /**
+     * @brief Retrieves the weight of a shape.
+     *
+     * @param shape The shape index.
+     * @return The weight.
+     */
+    float getWeight(uint32_t shape) const;
+
+    /**
+     * @brief Retrieves the memory used by positions, indices and deltas.
+     *
+     * @return The size in bytes.
+     */
+    size_t getMemorySize() const;
+
+    /**
+     * @brief Evaluates a range of vertices.
+     *
+     * @param begin The first vertex.
+     * @param end One past the last vertex.
+     * @param out x, y, z and 1 per vertex, indexed from vertex 0.
+     */
+    void evaluate(uint32_t begin, uint32_t end, float *out) const;
+
+    /**
+     * @brief Evaluates all vertices.
+     *
+     * @param pool The pool to split the vertices across, or nullptr to evaluate on the calling thread.
+     * @param out x, y, z and 1 per vertex.
+     */
+    void evaluate(ThreadPool *pool, float *out) const;
+
+private:
+    struct Shape
+    {
+        std::string name;
+        uint32_t begin;
+        uint32_t end;
+        float weight;
+    };
+
+    std::vector<float> positions;
+    std::vector<uint32_t> indices;
+    std::vector<float> deltas;
+    std::vector<Shape> shapes;
+};
+
+#endif // !BLEND_SHAPES_HPP
@@ -0,0 +1,139 @@
+/**
+ * @file Skin.hpp
+ * @author Lenard Büsing (nodedev74@gmail.com)
+ * @brief Bind pose and packed bone influences of a skinned mesh.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2023 Lenard Büsing
+ *
+ */
+
+#ifndef SKIN_HPP
+#define SKIN_HPP
+
+#include "scene/SceneGraph.hpp"
+
+#include <cstdint>
+#include <vector>
+
+class FbxScene;
+class ThreadPool;
+
+/**
+ * @brief Maximum number of joints influencing a vertex.
+ */
+constexpr uint32_t SKIN_MAX_INFLUENCES = 4;
+
+/**
+ * @brief The bone influences of a vertex, packed for the skinning compute shader.
+ *
+ * Joint indices are relative to the joints of the skin. Weights are normalized to 16 bit and
+ * sum up to exactly 65535.
+ */
+struct SkinInfluence
+{
+    uint16_t joints[SKIN_MAX_INFLUENCES];
+    uint16_t weights[SKIN_MAX_INFLUENCES];
+};
+
+/**
+ * @brief Bind pose data of a skinned mesh, shared by all of its instances.
+ *
+ * The bind positions and influences are stored as separate streams of 16 bytes per vertex.
+ * Joints refer to scene graph nodes; an instance adds a node offset, so characters built from
+ * the same skeleton layout share one skin.
+ */
+class Skin
+{
+public:
+    /**
+     * @brief Creates a skin from per vertex influences.
+     *
+     * @param positions The bind positions, x, y and z per vertex.
+     * @param joints SKIN_MAX_INFLUENCES joint indices per vertex.
+     * @param weights SKIN_MAX_INFLUENCES weights per vertex, renormalized on packing.
+     * @param jointNodes The scene graph node of every joint.
+     * @param inverseBindMatrices The inverse bind matrix of every joint.
+     * @throws std::runtime_error If the arrays do not match or a joint index is out of range.
+     */
+    Skin(const std::vector<float> &positions, const std::vector<uint32_t> &joints, const std::vector<float> &weights,
+         const std::vector<uint32_t> &jointNodes, const std::vector<Matrix4> &inverseBindMatrices);
+
+    /**
+     * @brief Converts a skin deformer of an imported scene.
+     *
+     * Vertices are the control points of the deformed mesh. Control points with more than
+     * SKIN_MAX_INFLUENCES clusters keep the largest weights.
+     *
+     * @param scene The imported scene, joints refer to the scene graph node of the same model index.
+     * @param skinIndex The index of the skin deformer.
+     * @return The new skin, owned by the caller.
+     */
+    static Skin *fromScene(const FbxScene &scene, uint32_t skinIndex);
+
+    /**
+     * @brief Retrieves the number of vertices.
+     *
+     * @return The vertex count.
+     */
+    uint32_t getVertexCount() const;
+
+    /**
+     * @brief Retrieves the number of joints.
+     *
+     * @return The joint count.
+     */
+    uint32_t getJointCount() const;
+
+    /**
+     * @brief Retrieves the bind positions.
+     *
+     * @return x, y, z and 1 per vertex.
+     */
+    const float *getPositions() const;
+
+    /**
+     * @brief Retrieves the packed influences.
+     *
+     * @return One influence per vertex.
+     */
+    const SkinInfluence *getInfluences() const;
+
+    /**
+     * @brief Computes the skinning matrices of all joints from the current world matrices.
+     *
+     * @param graph The scene graph after its update.
+     * @param nodeOffset The offset added to every joint node.
+     * @param out getJointCount() matrices.
+     */
+    void computeJointMatrices(const SceneGraph &graph, uint32_t nodeOffset, Matrix4 *out) const;
+
+    /**
+     * @brief Skins a range of vertices on the CPU, four floats per output vertex.
+     *
+     * @param jointMatrices The matrices from computeJointMatrices.
+     * @param begin The first vertex.
+     * @param end One past the last vertex.
+     * @param out x, y, z and 1 per vertex, indexed from vertex 0.
+     */
+    void skin(const Matrix4 *jointMatrices, uint32_t begin, uint32_t end, float *out) const;
+
+    /**
+     * @brief Skins all vertices on the CPU.
+     *
+     * @param graph The scene graph after its update.
+     * @param nodeOffset The offset added to every joint node.
+     * @param pool The pool to split the vertices across, or nullptr to skin on the calling thread.
+     * @param out x, y, z and 1 per vertex.
+     */
+    void skin(const SceneGraph &graph, uint32_t nodeOffset, ThreadPool *pool, float *out) const;
+
+private:
+    std::vector<float> positions;
+    std::vector<SkinInfluence> influences;
+    std::vector<uint32_t> jointNodes;
+    std::vector<Matrix4> inverseBindMatrices;
+};
+
+#endif // !SKIN_HPP
@@ -0,0 +1,231 @@
+/**
+ * @file AssetLoader.hpp
+ * @author Lenard Büsing (nodedev74@gmail.com)
+ * @brief Background loading of scenes, textures and meshes with priorities and cancellation.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2023 Lenard Büsing
+ *
+ */
+
+#ifndef ASSET_LOADER_HPP
+#define ASSET_LOADER_HPP
+
+#include "fbx/FbxScene.hpp"
+#include "scene/FrustumCuller.hpp"
+#include "texture/TextureCache.hpp"
+#include "texture/TextureCodec.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief The stages an asset passes through, in order. Cancelled and Failed end an asset early.
+ */
+enum class AssetState : uint32_t
+{
+    Queued = 0,
+    Parsing = 1,
+    Parsed = 2,
+    Processing = 3,
+    Ready = 4,
+    Uploading = 5,
+    Complete = 6,
+    Cancelled = 7,
+    Failed = 8,
+};
+
+/**
+ * @brief The kinds of assets the loader produces.
+ */
+enum class AssetKind : uint32_t
+{
+    Scene = 0,
+    Texture = 1,
+    Mesh = 2,
+};
+
+/**
+ * @brief A triangle mesh ready for upload, pointing into the asset that owns its data.
+ */
+struct AssetMesh
+{
+    const float *positions = nullptr;
+    uint32_t vertexCount = 0;
+    const uint32_t *indices = nullptr;
+    uint32_t indexCount = 0;
+    Bounds bounds;
+};
+
+/**
+ * @brief A requested asset. The CPU stages fill its data on a worker, the uploader reads it after
+ * the asset became Ready and records the device indices.
+ */
+struct Asset
+{
+    uint32_t handle = 0;
+    AssetKind kind = AssetKind::Mesh;
+    int32_t priority = 0;
+    AssetState state = AssetState::Queued;
+    std::atomic<bool> cancelled{false};
+    std::atomic<float> progress{0.0f};
+    std::string error;
+
+    std::string path;
+    std::vector<uint8_t> file;
+    bool blockCompression = false;
+    std::vector<float> positions;
+    std::vector<uint32_t> indices;
+
+    std::unique_ptr<FbxScene> scene;
+    TextureImage image;
+    std::vector<TextureData> textures;
+    std::vector<int32_t> materialTextures;
+    std::vector<AssetMesh> meshes;
+    uint64_t uploadBytes = 0;
+
+    std::vector<int32_t> textureIndices;
+    std::vector<int32_t> materialIndices;
+    std::vector<int32_t> meshIndices;
+    uint64_t uploadedBytes = 0;
+};
+
+/**
+ * @brief Runs the parse and process stages of assets on its own worker threads.
+ *
+ * Parsing reads and imports FBX files or decodes texture files, processing builds mip chains,
+ * decodes the textures of scenes and computes mesh bounds. Each stage is a task of its own, so
+ * a worker always continues with the waiting asset of the highest priority and a raised
+ * priority takes effect at the next stage. Uploading is left to the owner of the device, which
+ * takes Ready assets in priority order and may spread one asset over several frames. Cancelled
+ * assets stop at the next stage or item; resources uploaded before the cancellation stay valid.
+ */
+class AssetLoader
+{
+public:
+    /**
+     * @brief Starts the workers.
+     *
+     * @param threadCount The number of worker threads, 0 selects half the hardware concurrency.
+     * @param cacheDirectory The directory of the texture cache, empty to disable it.
+     */
+    AssetLoader(uint32_t threadCount, std::string cacheDirectory);
+
+    /**
+     * @brief Cancels all assets and joins the workers.
+     */
+    ~AssetLoader();
+
+    AssetLoader(const AssetLoader &) = delete;
+    AssetLoader &operator=(const AssetLoader &) = delete;
+
+    /**
+     * @brief Requests a binary FBX file with its meshes, materials and textures.
+     *
+     * @param path The file path. Textures that are not embedded are read relative to its directory.
+     * @param priority Higher priorities are processed and uploaded first.
+     * @param blockCompression True to compress the textures into BC1 or BC3.
+     * @return The asset handle.
+     */
+    uint32_t loadScene(std::string path, int32_t priority, bool blockCompression);
+
+    /**
+     * @brief Requests an encoded PNG or TGA texture.
+     *
+     * @param file The file content.
+     * @param priority Higher priorities are processed and uploaded first.
+     * @param blockCompression True to compress the texture into BC1 or BC3.
+     * @return The asset handle.
+     */
+    uint32_t loadTexture(std::vector<uint8_t> file, int32_t priority, bool blockCompression);
+
+    /**
+     * @brief Requests a triangle mesh.
+     *
+     * @param positions Three floats per vertex.
+     * @param indices Three vertex indices per triangle.
+     * @param priority Higher priorities are processed and uploaded first.
+     * @return The asset handle.
+     */
+    uint32_t loadMesh(std::vector<float> positions, std::vector<uint32_t> indices, int32_t priority);
+
+    /**
+     * @brief Changes the priority of an asset, effective from its next stage on.
+     *
+     * @param handle The asset handle.
+     * @param priority The new priority.
+     */
+    void setPriority(uint32_t handle, int32_t priority);
+
+    /**
+     * @brief Cancels an asset. Waiting assets are dropped at once, running ones at their next check.
+     *
+     * @param handle The asset handle.
+     * @return False if the asset is unknown or already ended.
+     */
+    bool cancel(uint32_t handle);
+
+    /**
+     * @brief Retrieves an asset.
+     *
+     * @param handle The asset handle.
+     * @return The asset, or nullptr if the handle is unknown or released.
+     */
+    std::shared_ptr<Asset> get(uint32_t handle) const;
+
+    /**
+     * @brief Retrieves the state of an asset.
+     *
+     * @param handle The asset handle.
+     * @return The state, Failed for unknown handles.
+     */
+    AssetState getState(uint32_t handle) const;
+
+    /**
+     * @brief Forgets an asset, cancelling it if it has not ended yet.
+     *
+     * @param handle The asset handle.
+     */
+    void release(uint32_t handle);
+
+    /**
+     * @brief Takes the Ready or Uploading asset of the highest priority for uploading.
+     *
+     * @return The asset in the Uploading state, or nullptr if none is waiting.
+     */
+    std::shared_ptr<Asset> beginUpload();
+
+    /**
+     * @brief Ends the upload of an asset.
+     *
+     * @param asset The asset from beginUpload().
+     * @param state Complete, Cancelled or Failed, Uploading to continue in a later frame.
+     */
+    void endUpload(const std::shared_ptr<Asset> &asset, AssetState state);
+
+private:
+    uint32_t enqueue(std::shared_ptr<Asset> asset);
+    void workerLoop();
+    void parse(Asset &asset);
+    void process(Asset &asset);
+
+    std::vector<std::thread> workers;
+    mutable std::mutex mutex;
+    std::condition_variable wake;
+    std::unordered_map<uint32_t, std::shared_ptr<Asset>> assets;
+    std::vector<std::shared_ptr<Asset>> waiting;
+    std::vector<std::shared_ptr<Asset>> uploads;
+    TextureCache cache;
+    uint32_t nextHandle = 1;
+    bool stopping = false;
+};
+
+#endif // !ASSET_LOADER_HPP
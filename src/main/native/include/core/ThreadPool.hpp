@@ -0,0 +1,96 @@
+/**
+ * @file ThreadPool.hpp
+ * @author Lenard Büsing (nodedev74@gmail.com)
+ * @brief Fixed worker pool for data parallel loops.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2023 Lenard Büsing
+ *
+ */
+
+#ifndef THREAD_POOL_HPP
+#define THREAD_POOL_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief A pool of worker threads that split index ranges between themselves and the caller.
+ */
+class ThreadPool
+{
+public:
+    /**
+     * @brief Callback invoked for the half open range [begin, end).
+     */
+    using RangeFunction = std::function<void(uint32_t begin, uint32_t end)>;
+
+    /**
+     * @brief Starts the workers.
+     *
+     * @param threadCount The number of worker threads, 0 selects one less than the hardware concurrency.
+     */
+    explicit ThreadPool(uint32_t threadCount = 0);
+
+    /**
+     * @brief Stops and joins the workers.
+     */
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    /**
+     * @brief Retrieves the number of threads participating in a loop, including the caller.
+     *
+     * @return The thread count.
+     */
+    uint32_t getThreadCount() const;
+
+    /**
+     * @brief Runs the function over [0, count) in chunks of grain indices and waits for completion.
+     *
+     * Small loops and loops started from inside a worker run inline on the calling thread. If the
+     * function throws, the remaining chunks are skipped and the first exception is rethrown on the
+     * calling thread once all workers have left the loop.
+     *
+     * @param count The number of indices.
+     * @param grain The chunk size.
+     * @param function The range callback.
+     */
+    void parallelFor(uint32_t count, uint32_t grain, const RangeFunction &function);
+
+    /**
+     * @brief Retrieves the process wide pool.
+     *
+     * @return The shared pool.
+     */
+    static ThreadPool &shared();
+
+private:
+    void workerLoop();
+    void runChunks();
+
+    std::vector<std::thread> workers;
+    std::mutex dispatchMutex;
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable done;
+    const RangeFunction *job = nullptr;
+    uint32_t jobCount = 0;
+    uint32_t jobGrain = 1;
+    std::atomic<uint32_t> nextIndex{0};
+    std::exception_ptr jobError;
+    uint32_t busyWorkers = 0;
+    uint64_t generation = 0;
+    bool stopping = false;
+};
+
+#endif // !THREAD_POOL_HPP
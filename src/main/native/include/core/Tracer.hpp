@@ -0,0 +1,191 @@
+/**
+ * @file Tracer.hpp
+ * @author Lenard Büsing (nodedev74@gmail.com)
+ * @brief Low overhead CPU tracer with Chrome trace export.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2023 Lenard Büsing
+ *
+ */
+
+#ifndef TRACER_HPP
+#define TRACER_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#elif defined(_M_X64) || defined(_M_IX86)
+#include <intrin.h>
+#endif
+
+/**
+ * @brief Records scoped zones into per thread buffers.
+ *
+ * Every thread writes into its own chunks through a thread local cursor without locking
+ * and publishes each event through the count of its current chunk, so dumps can run
+ * while other threads are still tracing. Only moving to a new chunk takes the registry
+ * lock. When tracing is disabled a zone costs a single relaxed load. A thread registers its
+ * buffer with its first zone, and the buffer is removed again once the thread has exited and
+ * its zones have been cleared.
+ *
+ * Zones store raw time stamp counter ticks, which are converted to nanoseconds when the
+ * trace is written.
+ */
+class Tracer
+{
+public:
+    /**
+     * @brief Enables or disables recording.
+     *
+     * @param enabled True to record zones.
+     */
+    static void setEnabled(bool enabled);
+
+    /**
+     * @brief Checks if zones are recorded.
+     *
+     * @return True if tracing is enabled.
+     */
+    static bool isEnabled()
+    {
+        return enabled.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Retrieves the current timestamp.
+     *
+     * @return The timestamp in ticks.
+     */
+    static uint64_t now()
+    {
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+        return __rdtsc();
+#else
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+    }
+
+    /**
+     * @brief Converts a tick count into nanoseconds.
+     *
+     * @param ticks The number of ticks.
+     * @return The duration in nanoseconds.
+     */
+    static double toNanoseconds(uint64_t ticks);
+
+    /**
+     * @brief Records a completed zone for the calling thread.
+     *
+     * @param name The zone name, must outlive the tracer.
+     * @param start The start timestamp in ticks.
+     * @param end The end timestamp in ticks.
+     */
+    static void record(const char *name, uint64_t start, uint64_t end);
+
+    /**
+     * @brief Stores a dynamic name for the lifetime of the process.
+     *
+     * @param name The name to store.
+     * @return A stable pointer to the stored name.
+     */
+    static const char *intern(const std::string &name);
+
+    /**
+     * @brief Opens a zone on the calling thread's zone stack. While tracing is disabled no timestamp
+     * is taken and no buffer is registered.
+     *
+     * @param name The zone name, must outlive the tracer.
+     */
+    static void begin(const char *name);
+
+    /**
+     * @brief Closes the innermost zone opened with begin.
+     */
+    static void end();
+
+    /**
+     * @brief Names the calling thread in the exported trace.
+     *
+     * @param name The thread name.
+     */
+    static void setThreadName(const std::string &name);
+
+    /**
+     * @brief Writes all recorded zones as Chrome trace JSON.
+     *
+     * @param path The output file.
+     * @return False if the file could not be written.
+     */
+    static bool dump(const std::string &path);
+
+    /**
+     * @brief Discards all recorded zones, frees the chunks that threads are no longer writing to and
+     * removes the buffers of exited threads.
+     */
+    static void clear();
+
+    /**
+     * @brief Measures the cost of an enabled zone.
+     *
+     * @param iterations The number of zones to record.
+     * @return The average cost per zone in nanoseconds.
+     */
+    static double measureOverhead(uint32_t iterations);
+
+    /**
+     * @brief Measures the cost of the two timestamps every zone takes, the part of a zone that
+     * depends on the host rather than on the tracer.
+     *
+     * @param iterations The number of timestamp pairs to take.
+     * @return The average cost per pair in nanoseconds.
+     */
+    static double measureClockOverhead(uint32_t iterations);
+
+private:
+    static std::atomic<bool> enabled;
+};
+
+/**
+ * @brief Records the enclosing scope as a zone.
+ */
+class TraceZone
+{
+public:
+    explicit TraceZone(const char *name) : name(Tracer::isEnabled() ? name : nullptr)
+    {
+        if (this->name != nullptr)
+        {
+            start = Tracer::now();
+        }
+    }
+
+    ~TraceZone()
+    {
+        if (name != nullptr)
+        {
+            Tracer::record(name, start, Tracer::now());
+        }
+    }
+
+    TraceZone(const TraceZone &) = delete;
+    TraceZone &operator=(const TraceZone &) = delete;
+
+private:
+    const char *name;
+    uint64_t start = 0;
+};
+
+#define TRACE_CONCAT_IMPL(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_IMPL(a, b)
+
+/**
+ * @brief Records the enclosing scope under the given string literal.
+ */
+#define TRACE_ZONE(name) TraceZone TRACE_CONCAT(traceZone, __LINE__)(name)
+
+#endif // !TRACER_HPP
@@ -0,0 +1,165 @@
+/**
+ * @file FbxArena.hpp
+ * @author Lenard Büsing (nodedev74@gmail.com)
+ * @brief Monotonic memory for parse trees and per thread scratch memory.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2023 Lenard Büsing
+ *
+ */
+
+#ifndef FBX_ARENA_HPP
+#define FBX_ARENA_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief A block of memory owned by an arena.
+ */
+struct FbxArenaBlock
+{
+    uint8_t *data;
+    size_t size;
+};
+
+/**
+ * @brief A position in an arena that it can be rewound to.
+ */
+struct FbxArenaMark
+{
+    size_t chunk = 0;
+    size_t offset = 0;
+    size_t largeCount = 0;
+};
+
+/**
+ * @brief Hands out memory by bumping an offset through chunks that are only freed as a whole.
+ *
+ * Chunks start at 64 KiB and double up to 4 MiB. Requests above half the smallest chunk, such as
+ * inflated geometry arrays, get a block of their own so they do not strand the rest of a chunk.
+ * Nothing is freed individually: objects placed in an arena must not need their destructor, and
+ * releasing the arena frees its chunks and large blocks without visiting the objects. An arena
+ * created with monotonic set to false allocates every request from the general purpose heap and
+ * frees the blocks one by one instead, for comparison.
+ */
+class FbxArena
+{
+public:
+    /**
+     * @brief Creates an empty arena.
+     *
+     * @param monotonic False to allocate every request from the heap.
+     */
+    explicit FbxArena(bool monotonic = true);
+
+    ~FbxArena();
+
+    FbxArena(FbxArena &&other) noexcept;
+    FbxArena &operator=(FbxArena &&other) noexcept;
+    FbxArena(const FbxArena &) = delete;
+    FbxArena &operator=(const FbxArena &) = delete;
+
+    /**
+     * @brief Allocates uninitialized memory that lives until the arena is rewound or released.
+     *
+     * @param size The size in bytes.
+     * @param alignment The alignment, a power of two of at most 16.
+     * @return The memory.
+     */
+    void *allocate(size_t size, size_t alignment);
+
+    /**
+     * @brief Retrieves the current position.
+     *
+     * @return The position.
+     */
+    FbxArenaMark getMark() const;
+
+    /**
+     * @brief Frees everything allocated since a position. Chunks after the one of the position are
+     * returned to the heap, so a rewound arena keeps at most the memory it had at that position.
+     *
+     * @param mark A position retrieved from this arena and not yet rewound past.
+     */
+    void rewind(const FbxArenaMark &mark);
+
+    /**
+     * @brief Frees all memory of the arena.
+     */
+    void release();
+
+    /**
+     * @brief Checks if the arena bumps through chunks or allocates every request from the heap.
+     *
+     * @return True for chunks.
+     */
+    bool isMonotonic() const;
+
+    /**
+     * @brief Retrieves the bytes handed out since the arena was created, including rewound ones.
+     *
+     * @return The size in bytes.
+     */
+    uint64_t getAllocatedBytes() const;
+
+    /**
+     * @brief Retrieves the number of allocations since the arena was created.
+     *
+     * @return The allocation count.
+     */
+    uint64_t getAllocationCount() const;
+
+    /**
+     * @brief Retrieves the bytes the arena currently holds from the heap.
+     *
+     * @return The size in bytes.
+     */
+    uint64_t getReservedBytes() const;
+
+    /**
+     * @brief Retrieves the scratch arena of the calling thread. Users take a position with an
+     * FbxArenaScope and leave the arena as they found it, so nested users share its chunks.
+     *
+     * @return The scratch arena.
+     */
+    static FbxArena &scratch();
+
+private:
+    void freeBlocks(std::vector<FbxArenaBlock> &blocks, size_t first);
+
+    bool monotonic;
+    std::vector<FbxArenaBlock> chunks;
+    std::vector<FbxArenaBlock> large;
+    size_t offset = 0;
+    uint64_t allocatedBytes = 0;
+    uint64_t allocationCount = 0;
+    uint64_t reservedBytes = 0;
+};
+
+/**
+ * @brief Rewinds an arena to the position it had when the scope was entered.
+ */
+class FbxArenaScope
+{
+public:
+    /**
+     * @brief Takes the current position of an arena.
+     *
+     * @param arena The arena, it must outlive the scope.
+     */
+    explicit FbxArenaScope(FbxArena &arena);
+
+    ~FbxArenaScope();
+
+    FbxArenaScope(const FbxArenaScope &) = delete;
+    FbxArenaScope &operator=(const FbxArenaScope &) = delete;
+
+private:
+    FbxArena &arena;
+    FbxArenaMark mark;
+};
+
+#endif // !FBX_ARENA_HPP
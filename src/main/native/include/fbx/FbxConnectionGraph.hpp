@@ -0,0 +1,174 @@
+/**
+ * @file FbxConnectionGraph.hpp
+ * @author Lenard Büsing (nodedev74@gmail.com)
+ * @brief Object id lookup and adjacency of the FBX Connections section.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2023 Lenard Büsing
+ *
+ */
+
+#ifndef FBX_CONNECTION_GRAPH_HPP
+#define FBX_CONNECTION_GRAPH_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief A connection between two objects, optionally to a property of the parent.
+ */
+struct FbxConnection
+{
+    int64_t child = 0;
+    int64_t parent = 0;
+    std::string property;
+};
+
+/**
+ * @brief Maps 64 bit object ids to indices with open addressing and linear probing.
+ *
+ * Keys and values live in two flat arrays whose size is a power of two, kept at most half full,
+ * so a lookup touches one or two cache lines instead of a node of a bucket list.
+ */
+class FbxIdMap
+{
+public:
+    /**
+     * @brief Removes all entries and makes room for a number of them.
+     *
+     * @param count The expected number of entries.
+     */
+    void reserve(size_t count);
+
+    /**
+     * @brief Sets the value of an id, replacing a previous one.
+     *
+     * @param id The object id.
+     * @param value The value, at least 0.
+     */
+    void insert(int64_t id, int32_t value);
+
+    /**
+     * @brief Finds the value of an id.
+     *
+     * @param id The object id.
+     * @return The value or -1.
+     */
+    int32_t find(int64_t id) const;
+
+    /**
+     * @brief Retrieves the number of entries.
+     *
+     * @return The entry count.
+     */
+    size_t size() const;
+
+private:
+    void rehash(size_t capacity);
+
+    std::vector<int64_t> keys;
+    std::vector<int32_t> values;
+    size_t count = 0;
+};
+
+/**
+ * @brief A connection seen from one of its objects.
+ */
+struct FbxEdge
+{
+    int32_t object;
+    int32_t connection;
+};
+
+/**
+ * @brief The edges of an object, in connection order.
+ */
+struct FbxEdgeRange
+{
+    const FbxEdge *first;
+    const FbxEdge *last;
+
+    /**
+     * @brief Retrieves the first edge.
+     *
+     * @return The first edge.
+     */
+    const FbxEdge *begin() const;
+
+    /**
+     * @brief Retrieves the end of the edges.
+     *
+     * @return The position after the last edge.
+     */
+    const FbxEdge *end() const;
+
+    /**
+     * @brief Retrieves the number of edges.
+     *
+     * @return The edge count.
+     */
+    size_t size() const;
+};
+
+/**
+ * @brief The objects of a file and their connections in compressed sparse row form.
+ *
+ * Objects are numbered in file order. The children and the parents of all objects are stored in
+ * one array each, sorted by object with a stable counting sort, so the edges of an object keep
+ * the order of the Connections section and building takes linear time. Connections to ids that
+ * are no object, such as the scene root 0, are left out.
+ */
+class FbxConnectionGraph
+{
+public:
+    /**
+     * @brief Builds the id lookup and the adjacency arrays.
+     *
+     * @param objectIds The id of every object, its position is the object index.
+     * @param connections The connections.
+     */
+    void build(const std::vector<int64_t> &objectIds, const std::vector<FbxConnection> &connections);
+
+    /**
+     * @brief Finds the object with the given id.
+     *
+     * @param id The object id.
+     * @return The object index or -1.
+     */
+    int32_t findObject(int64_t id) const;
+
+    /**
+     * @brief Retrieves the number of objects.
+     *
+     * @return The object count.
+     */
+    uint32_t getObjectCount() const;
+
+    /**
+     * @brief Retrieves the objects connected to an object as children.
+     *
+     * @param object The object index.
+     * @return The edges to the children.
+     */
+    FbxEdgeRange getChildren(uint32_t object) const;
+
+    /**
+     * @brief Retrieves the objects an object is connected to as a child.
+     *
+     * @param object The object index.
+     * @return The edges to the parents.
+     */
+    FbxEdgeRange getParents(uint32_t object) const;
+
+private:
+    FbxIdMap objectIndices;
+    std::vector<uint32_t> childOffsets;
+    std::vector<FbxEdge> childEdges;
+    std::vector<uint32_t> parentOffsets;
+    std::vector<FbxEdge> parentEdges;
+};
+
+#endif // !FBX_CONNECTION_GRAPH_HPP
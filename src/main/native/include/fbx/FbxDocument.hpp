@@ -0,0 +1,226 @@
+/**
+ * @file FbxDocument.hpp
+ * @author Lenard Büsing (nodedev74@gmail.com)
+ * @brief Reader for the binary FBX node record format.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2023 Lenard Büsing
+ *
+ */
+
+#ifndef FBX_DOCUMENT_HPP
+#define FBX_DOCUMENT_HPP
+
+#include "fbx/FbxArena.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @brief A fixed list of records or properties placed in an arena.
+ *
+ * The accessors are defined here so that the import loops over millions of records inline them.
+ *
+ * @tparam T The element type.
+ */
+template <typename T>
+struct FbxSpan
+{
+    T *items = nullptr;
+    uint32_t count = 0;
+
+    T *begin() const
+    {
+        return items;
+    }
+
+    T *end() const
+    {
+        return items + count;
+    }
+
+    size_t size() const
+    {
+        return count;
+    }
+
+    bool empty() const
+    {
+        return count == 0;
+    }
+
+    T &operator[](size_t index) const
+    {
+        return items[index];
+    }
+};
+
+/**
+ * @brief A single property of an FBX node record.
+ *
+ * Scalars are stored in integer or number, strings, raw blobs and decompressed arrays in data,
+ * which points into the arena of the document. Arrays are converted on access.
+ */
+struct FbxProperty
+{
+    const char *data = nullptr;
+    union
+    {
+        int64_t integer = 0;
+        double number;
+    };
+    size_t size = 0;
+    uint32_t count = 0;
+    char type = 0;
+
+    /**
+     * @brief Checks if the property is an array.
+     *
+     * @return True for the array types f, d, l, i and b.
+     */
+    bool isArray() const;
+
+    /**
+     * @brief Retrieves a scalar property as integer.
+     *
+     * @return The integer value.
+     */
+    int64_t asInteger() const;
+
+    /**
+     * @brief Retrieves a scalar property as floating point number.
+     *
+     * @return The number value.
+     */
+    double asNumber() const;
+
+    /**
+     * @brief Retrieves a string or raw property.
+     *
+     * @return The string value, valid as long as the document.
+     */
+    std::string_view asString() const;
+
+    /**
+     * @brief Converts an array property into a vector of the requested element type.
+     *
+     * @tparam T The element type.
+     * @return The converted elements.
+     */
+    template <typename T>
+    std::vector<T> asArray() const;
+};
+
+/**
+ * @brief A node record with its properties and nested records, placed in an arena.
+ */
+struct FbxNode
+{
+    std::string_view name;
+    FbxSpan<FbxProperty> properties;
+    FbxSpan<FbxNode> children;
+
+    /**
+     * @brief Finds the first nested record with the given name.
+     *
+     * @param childName The name of the record.
+     * @return The record or nullptr.
+     */
+    const FbxNode *find(const char *childName) const;
+};
+
+/**
+ * @brief A parsed binary FBX file.
+ *
+ * All records, properties, strings and arrays live in the arena of the document, which frees the
+ * whole tree at once when the document is destroyed.
+ */
+class FbxDocument
+{
+public:
+    /**
+     * @brief Reads and parses a binary FBX file.
+     *
+     * @param path The file path.
+     * @param monotonic False to allocate every record, property and array from the heap.
+     * @return The parsed document.
+     * @throws std::runtime_error If the file cannot be read or is malformed.
+     */
+    static FbxDocument load(const std::string &path, bool monotonic = true);
+
+    /**
+     * @brief Parses a binary FBX file from memory.
+     *
+     * @param data The file content.
+     * @param size The size of the file content.
+     * @param monotonic False to allocate every record, property and array from the heap.
+     * @return The parsed document.
+     * @throws std::runtime_error If the content is malformed.
+     */
+    static FbxDocument parse(const uint8_t *data, size_t size, bool monotonic = true);
+
+    /**
+     * @brief Parses a single node record with its nested records.
+     *
+     * @param data The bytes of the record, from its header to its end offset.
+     * @param size The size of the record.
+     * @param offset The offset of the record in the file, its end offsets are relative to the file.
+     * @param version The file version, it decides the width of the record headers.
+     * @param arena The arena receiving the nested records, properties and arrays.
+     * @return The record.
+     * @throws std::runtime_error If the record is malformed.
+     */
+    static FbxNode parseRecord(const uint8_t *data, size_t size, uint64_t offset, uint32_t version, FbxArena &arena);
+
+    /**
+     * @brief Parses the property list of a node record.
+     *
+     * @param data The bytes following the record name.
+     * @param size The length of the property list.
+     * @param count The number of properties.
+     * @param arena The arena receiving the properties.
+     * @return The properties.
+     * @throws std::runtime_error If the properties are malformed.
+     */
+    static FbxSpan<FbxProperty> parseProperties(const uint8_t *data, size_t size, uint32_t count, FbxArena &arena);
+
+    /**
+     * @brief Retrieves the FBX version, e.g. 7400.
+     *
+     * @return The file version.
+     */
+    uint32_t getVersion() const;
+
+    /**
+     * @brief Retrieves the top level records.
+     *
+     * @return The root node containing all top level records.
+     */
+    const FbxNode &getRoot() const;
+
+    /**
+     * @brief Retrieves the arena holding the records, for its allocation statistics.
+     *
+     * @return The arena.
+     */
+    const FbxArena &getArena() const;
+
+    /**
+     * @brief Retrieves the time spent parsing the file content into records.
+     *
+     * @return The parse time in milliseconds.
+     */
+    double getParseTime() const;
+
+private:
+    uint32_t version = 0;
+    double parseTime = 0.0;
+    FbxArena arena;
+    FbxNode root;
+};
+
+#endif // !FBX_DOCUMENT_HPP
@@ -0,0 +1,194 @@
+/**
+ * @file FbxIndex.hpp
+ * @author Lenard Büsing (nodedev74@gmail.com)
+ * @brief Index over the objects of a binary FBX file that reads them on request.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2023 Lenard Büsing
+ *
+ */
+
+#ifndef FBX_INDEX_HPP
+#define FBX_INDEX_HPP
+
+#include "fbx/FbxConnectionGraph.hpp"
+#include "fbx/FbxDocument.hpp"
+#include "fbx/FbxScene.hpp"
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief An object record read on request, with the arena holding its nested records and arrays.
+ */
+struct FbxRecord
+{
+    FbxArena arena;
+    FbxNode node;
+};
+
+/**
+ * @brief An object record found by the index, with the file range it occupies.
+ */
+struct FbxObjectEntry
+{
+    int64_t id = 0;
+    std::string name;
+    std::string objectClass;
+    std::string type;
+    uint64_t offset = 0;
+    uint64_t endOffset = 0;
+};
+
+/**
+ * @brief Lists the objects of a binary FBX file without parsing them.
+ *
+ * Building the index reads the record headers of the top level and of the Objects section and
+ * the property lists of the objects, which hold their id, name and type. Everything else is
+ * skipped through the end offsets of the records, so arrays are neither read nor inflated. An
+ * object is read from the file the first time it is requested and kept until it is released;
+ * the Connections section is read on the first query that needs it. An index is used by one
+ * thread at a time.
+ */
+class FbxIndex
+{
+public:
+    /**
+     * @brief Opens an FBX file and indexes its objects.
+     *
+     * @param path The file path.
+     * @throws std::runtime_error If the file cannot be read or is malformed.
+     */
+    explicit FbxIndex(const std::string &path);
+
+    /**
+     * @brief Retrieves the FBX version, e.g. 7400.
+     *
+     * @return The file version.
+     */
+    uint32_t getVersion() const;
+
+    /**
+     * @brief Retrieves the indexed objects in file order.
+     *
+     * @return The objects.
+     */
+    const std::vector<FbxObjectEntry> &getObjects() const;
+
+    /**
+     * @brief Retrieves an indexed object.
+     *
+     * @param object The object index.
+     * @return The object.
+     * @throws std::runtime_error If the index is out of range.
+     */
+    const FbxObjectEntry &getObject(uint32_t object) const;
+
+    /**
+     * @brief Finds the object with the given id.
+     *
+     * @param id The object id.
+     * @return The object index or -1.
+     */
+    int32_t findObject(int64_t id) const;
+
+    /**
+     * @brief Finds the objects of a class with a name.
+     *
+     * @param objectClass The record name, e.g. Geometry, or empty for any class.
+     * @param name The object name without class suffix, or empty for any name.
+     * @return The object indices in file order.
+     */
+    std::vector<int32_t> findObjects(const std::string &objectClass, const std::string &name) const;
+
+    /**
+     * @brief Retrieves the objects connected to an object as its children.
+     *
+     * @param object The object index.
+     * @return The indices of the child objects in connection order.
+     * @throws std::runtime_error If the index is out of range.
+     */
+    std::vector<int32_t> getChildren(uint32_t object);
+
+    /**
+     * @brief Retrieves the objects an object is connected to as a child.
+     *
+     * @param object The object index.
+     * @return The indices of the parent objects in connection order.
+     * @throws std::runtime_error If the index is out of range.
+     */
+    std::vector<int32_t> getParents(uint32_t object);
+
+    /**
+     * @brief Reads the record of an object with its nested records.
+     *
+     * @param object The object index.
+     * @return The record, valid until the object is released.
+     * @throws std::runtime_error If the index is out of range or the record is malformed.
+     */
+    const FbxNode &readObject(uint32_t object);
+
+    /**
+     * @brief Reads and triangulates a Geometry object of class Mesh. Models are left unassigned.
+     *
+     * @param object The object index.
+     * @return The mesh, valid until the object is released.
+     * @throws std::runtime_error If the index is out of range or the object is no mesh or malformed.
+     */
+    const FbxMesh &readMesh(uint32_t object);
+
+    /**
+     * @brief Drops the record and mesh read for an object.
+     *
+     * @param object The object index.
+     */
+    void release(uint32_t object);
+
+    /**
+     * @brief Retrieves the number of objects currently read.
+     *
+     * @return The count of records and meshes held.
+     */
+    size_t getMaterializedCount() const;
+
+    /**
+     * @brief Retrieves the bytes read from the file for the index and the requested objects.
+     *
+     * @return The size in bytes.
+     */
+    uint64_t getBytesRead() const;
+
+private:
+    struct RecordHeader
+    {
+        uint64_t endOffset;
+        uint64_t propertyCount;
+        uint64_t propertyLength;
+        uint64_t propertyOffset;
+        std::string name;
+    };
+
+    RecordHeader readHeader(uint64_t offset);
+    std::vector<uint8_t> readRange(uint64_t offset, uint64_t size);
+    void indexObjects(uint64_t offset, uint64_t endOffset);
+    void readConnections();
+
+    std::ifstream file;
+    uint64_t fileSize = 0;
+    uint32_t version = 0;
+    uint64_t bytesRead = 0;
+    std::vector<FbxObjectEntry> objects;
+    FbxIdMap objectIndices;
+    uint64_t connectionsOffset = 0;
+    uint64_t connectionsEndOffset = 0;
+    bool connectionsRead = false;
+    FbxConnectionGraph graph;
+    std::unordered_map<uint32_t, FbxRecord> records;
+    std::unordered_map<uint32_t, FbxMesh> meshes;
+};
+
+#endif // !FBX_INDEX_HPP
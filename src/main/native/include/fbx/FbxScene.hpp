@@ -0,0 +1,340 @@
+/**
+ * @file FbxScene.hpp
+ * @author Lenard Büsing (nodedev74@gmail.com)
+ * @brief Scene objects imported from an FBX document.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2023 Lenard Büsing
+ *
+ */
+
+#ifndef FBX_SCENE_HPP
+#define FBX_SCENE_HPP
+
+#include "fbx/FbxConnectionGraph.hpp"
+#include "fbx/FbxDocument.hpp"
+#include "scene/FrustumCuller.hpp"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief A Model object with its local transform properties.
+ *
+ * Angles are Euler angles in degrees, rotationOrder follows the FBX EFbxRotationOrder enumeration.
+ */
+struct FbxModel
+{
+    int64_t id = 0;
+    int32_t parent = -1;
+    std::string name;
+    std::string type;
+    double translation[3] = {0.0, 0.0, 0.0};
+    double rotation[3] = {0.0, 0.0, 0.0};
+    double scaling[3] = {1.0, 1.0, 1.0};
+    double preRotation[3] = {0.0, 0.0, 0.0};
+    double postRotation[3] = {0.0, 0.0, 0.0};
+    double rotationOffset[3] = {0.0, 0.0, 0.0};
+    double rotationPivot[3] = {0.0, 0.0, 0.0};
+    double scalingOffset[3] = {0.0, 0.0, 0.0};
+    double scalingPivot[3] = {0.0, 0.0, 0.0};
+    int32_t rotationOrder = 0;
+    int32_t material = -1;
+};
+
+/**
+ * @brief A Material object. Only its identity and texture are imported, they tell which models can share a draw.
+ */
+struct FbxMaterial
+{
+    int64_t id = 0;
+    std::string name;
+    int32_t texture = -1;
+};
+
+/**
+ * @brief A Texture object with the file of its Video object, content is empty unless the file is embedded.
+ */
+struct FbxTexture
+{
+    int64_t id = 0;
+    std::string name;
+    std::string fileName;
+    std::string content;
+};
+
+/**
+ * @brief The keys of an AnimationCurve object in file units.
+ *
+ * Times are in FBX ticks. The key attributes are stored shared as in the file, attributeRefCounts
+ * tells how many consecutive keys use each attribute.
+ */
+struct FbxAnimationCurve
+{
+    int64_t id = 0;
+    float defaultValue = 0.0f;
+    std::vector<int64_t> times;
+    std::vector<float> values;
+    std::vector<int32_t> attributeFlags;
+    std::vector<float> attributeData;
+    std::vector<int32_t> attributeRefCounts;
+};
+
+/**
+ * @brief A single animated component of a model transform.
+ *
+ * The property is 0 to 8 for translation, rotation and scaling x, y and z. Curve is -1 if the
+ * component is not animated and stays at defaultValue.
+ */
+struct FbxAnimationChannel
+{
+    int32_t model = -1;
+    uint8_t property = 0;
+    int32_t curve = -1;
+    float defaultValue = 0.0f;
+};
+
+/**
+ * @brief An AnimationStack object with the channels of all its layers.
+ */
+struct FbxAnimationStack
+{
+    int64_t id = 0;
+    std::string name;
+    int64_t localStart = 0;
+    int64_t localStop = 0;
+    std::vector<FbxAnimationChannel> channels;
+};
+
+/**
+ * @brief A Geometry object of class Mesh, triangulated.
+ *
+ * Positions hold x, y and z per control point. Polygons are split into triangle fans whose
+ * indices refer to the control points. The bounds enclose the control points. A geometry that is
+ * shared by several models is imported once, models lists all of them in connection order and
+ * model is the first one.
+ */
+struct FbxMesh
+{
+    int64_t id = 0;
+    int32_t model = -1;
+    std::vector<int32_t> models;
+    std::vector<float> positions;
+    std::vector<uint32_t> indices;
+    Bounds bounds;
+
+    /**
+     * @brief Triangulates a Geometry record of class Mesh. Models are left unassigned.
+     *
+     * @param geometry The Geometry record.
+     * @return The mesh.
+     * @throws std::runtime_error If a polygon index is out of range.
+     */
+    static FbxMesh fromGeometry(const FbxNode &geometry);
+};
+
+/**
+ * @brief The models that draw the same mesh with the same material, one instanced draw covers them.
+ */
+struct FbxInstanceGroup
+{
+    int32_t mesh = -1;
+    int32_t material = -1;
+    std::vector<int32_t> models;
+};
+
+/**
+ * @brief A Cluster deformer binding control points of a mesh to a bone.
+ *
+ * Transform is the mesh and transformLink the bone transform at bind time, both column major.
+ */
+struct FbxCluster
+{
+    int64_t id = 0;
+    int32_t model = -1;
+    std::vector<int32_t> indices;
+    std::vector<double> weights;
+    double transform[16] = {1.0, 0.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 0.0, 1.0};
+    double transformLink[16] = {1.0, 0.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 0.0, 1.0};
+};
+
+/**
+ * @brief A Skin deformer with the clusters it consists of.
+ */
+struct FbxSkin
+{
+    int64_t id = 0;
+    int32_t mesh = -1;
+    std::vector<FbxCluster> clusters;
+};
+
+/**
+ * @brief A BlendShapeChannel deformer with the Shape geometry it blends to.
+ *
+ * Deltas hold x, y and z per entry of indices, which refer to the control points of the mesh.
+ * In-between shapes are not supported, a channel uses its first shape.
+ */
+struct FbxBlendShapeChannel
+{
+    int64_t id = 0;
+    std::string name;
+    double deformPercent = 0.0;
+    std::vector<int32_t> indices;
+    std::vector<float> deltas;
+};
+
+/**
+ * @brief A BlendShape deformer with the channels it consists of.
+ */
+struct FbxBlendShape
+{
+    int64_t id = 0;
+    int32_t mesh = -1;
+    std::vector<FbxBlendShapeChannel> channels;
+};
+
+/**
+ * @brief Number of FBX time ticks per second.
+ */
+constexpr int64_t FBX_TICKS_PER_SECOND = 46186158000LL;
+
+/**
+ * @brief A parsed FBX file together with the objects imported from it.
+ */
+class FbxScene
+{
+public:
+    /**
+     * @brief Loads and imports an FBX file.
+     *
+     * @param path The file path.
+     * @param monotonic False to parse into records allocated one by one from the heap.
+     * @throws std::runtime_error If the file cannot be read or is malformed.
+     */
+    explicit FbxScene(const std::string &path, bool monotonic = true);
+
+    /**
+     * @brief Retrieves the underlying document.
+     *
+     * @return The document.
+     */
+    const FbxDocument &getDocument() const;
+
+    /**
+     * @brief Retrieves the imported models. Parents are referenced by index.
+     *
+     * @return The models.
+     */
+    const std::vector<FbxModel> &getModels() const;
+
+    /**
+     * @brief Finds the model with the given object id.
+     *
+     * @param id The object id.
+     * @return The model index or -1.
+     */
+    int32_t findModel(int64_t id) const;
+
+    /**
+     * @brief Retrieves all object connections.
+     *
+     * @return The connections.
+     */
+    const std::vector<FbxConnection> &getConnections() const;
+
+    /**
+     * @brief Retrieves the imported animation curves.
+     *
+     * @return The curves.
+     */
+    const std::vector<FbxAnimationCurve> &getAnimationCurves() const;
+
+    /**
+     * @brief Retrieves the imported animation stacks.
+     *
+     * @return The stacks.
+     */
+    const std::vector<FbxAnimationStack> &getAnimationStacks() const;
+
+    /**
+     * @brief Retrieves the imported materials. Models reference them by index.
+     *
+     * @return The materials.
+     */
+    const std::vector<FbxMaterial> &getMaterials() const;
+
+    /**
+     * @brief Retrieves the imported textures. Materials reference them by index.
+     *
+     * @return The textures.
+     */
+    const std::vector<FbxTexture> &getTextures() const;
+
+    /**
+     * @brief Retrieves the imported meshes.
+     *
+     * @return The meshes.
+     */
+    const std::vector<FbxMesh> &getMeshes() const;
+
+    /**
+     * @brief Retrieves the models grouped by mesh and material, ordered by mesh.
+     *
+     * @return The instance groups.
+     */
+    const std::vector<FbxInstanceGroup> &getInstanceGroups() const;
+
+    /**
+     * @brief Retrieves the imported skin deformers.
+     *
+     * @return The skins.
+     */
+    const std::vector<FbxSkin> &getSkins() const;
+
+    /**
+     * @brief Retrieves the imported blend shape deformers.
+     *
+     * @return The blend shapes.
+     */
+    const std::vector<FbxBlendShape> &getBlendShapes() const;
+
+    /**
+     * @brief Retrieves the time spent assembling the scene from the parsed document.
+     *
+     * @return The assembly time in milliseconds.
+     */
+    double getAssemblyTime() const;
+
+private:
+    void importConnections();
+    void importModels();
+    void importAnimations();
+    void importMaterials();
+    void importTextures();
+    void importMeshes();
+    void importInstanceGroups();
+    void importSkins();
+    void importBlendShapes();
+
+    FbxDocument document;
+    double assemblyTime = 0.0;
+    std::vector<const FbxNode *> objects;
+    FbxConnectionGraph graph;
+    std::vector<int32_t> objectModels;
+    std::vector<int32_t> objectMaterials;
+    std::vector<int32_t> objectMeshes;
+    std::vector<FbxModel> models;
+    std::vector<FbxConnection> connections;
+    std::vector<FbxAnimationCurve> animationCurves;
+    std::vector<FbxAnimationStack> animationStacks;
+    std::vector<FbxMaterial> materials;
+    std::vector<FbxTexture> textures;
+    std::vector<FbxMesh> meshes;
+    std::vector<FbxInstanceGroup> instanceGroups;
+    std::vector<FbxSkin> skins;
+    std::vector<FbxBlendShape> blendShapes;
+};
+
+#endif // !FBX_SCENE_HPP
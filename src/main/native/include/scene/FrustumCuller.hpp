@@ -0,0 +1,148 @@
+/**
+ * @file FrustumCuller.hpp
+ * @author Lenard Büsing (nodedev74@gmail.com)
+ * @brief Bounding volumes and SIMD view frustum culling.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2023 Lenard Büsing
+ *
+ */
+
+#ifndef FRUSTUM_CULLER_HPP
+#define FRUSTUM_CULLER_HPP
+
+#include "scene/SceneGraph.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class ThreadPool;
+
+/**
+ * @brief An axis aligned bounding box together with a bounding sphere.
+ */
+struct Bounds
+{
+    float min[3] = {0.0f, 0.0f, 0.0f};
+    float max[3] = {0.0f, 0.0f, 0.0f};
+    float center[3] = {0.0f, 0.0f, 0.0f};
+    float radius = 0.0f;
+
+    /**
+     * @brief Computes the bounds of a point set. The sphere is centered on the box.
+     *
+     * @param positions x, y and z per point.
+     * @param count The number of points.
+     * @return The bounds, all zero for an empty set.
+     */
+    static Bounds fromPositions(const float *positions, size_t count);
+};
+
+/**
+ * @brief The six planes of a view frustum, pointing inwards.
+ */
+struct Frustum
+{
+    float planes[6][4];
+
+    /**
+     * @brief Extracts the planes of a Vulkan view projection matrix with a depth range of 0 to 1.
+     *
+     * @param viewProjection The column major view projection matrix.
+     * @return The normalized frustum planes.
+     */
+    static Frustum fromViewProjection(const Matrix4 &viewProjection);
+};
+
+/**
+ * @brief Culls objects attached to scene graph nodes against a view frustum.
+ *
+ * Local bounds are transformed into world space boxes and spheres, which are stored as
+ * structure of arrays padded to eight objects. An object is visible if both its sphere and its
+ * box are not completely outside of a plane; both tests are conservative, so their combination
+ * is as tight as the better fitting volume. The kernels test eight objects per AVX or four per
+ * SSE step and fall back to scalar code.
+ */
+class FrustumCuller
+{
+public:
+    /**
+     * @brief Adds an object.
+     *
+     * @param node The scene graph node that places the object.
+     * @param bounds The bounds in the space of the node.
+     * @return The object index.
+     */
+    uint32_t add(uint32_t node, const Bounds &bounds);
+
+    /**
+     * @brief Removes all objects.
+     */
+    void clear();
+
+    /**
+     * @brief Retrieves the number of objects.
+     *
+     * @return The object count.
+     */
+    uint32_t getObjectCount() const;
+
+    /**
+     * @brief Retrieves the node of an object.
+     *
+     * @param object The object index.
+     * @return The scene graph node.
+     */
+    uint32_t getNode(uint32_t object) const;
+
+    /**
+     * @brief Retrieves the world space box of an object as of the last update.
+     *
+     * @param object The object index.
+     * @param center Receives the box center.
+     * @param extent Receives the half size of the box.
+     */
+    void getWorldBox(uint32_t object, float center[3], float extent[3]) const;
+
+    /**
+     * @brief Transforms the bounds of all objects into world space. Objects whose node is not part
+     * of the graph keep their local bounds.
+     *
+     * @param graph The scene graph after its update.
+     * @param pool The pool to split the objects across, or nullptr to update on the calling thread.
+     */
+    void update(const SceneGraph &graph, ThreadPool *pool);
+
+    /**
+     * @brief Collects the objects intersecting a frustum.
+     *
+     * @param frustum The frustum.
+     * @param pool The pool to split the objects across, or nullptr to cull on the calling thread.
+     * @param visible Receives the visible object indices in ascending order, getObjectCount() entries.
+     * @return The number of visible objects.
+     */
+    uint32_t cull(const Frustum &frustum, ThreadPool *pool, uint32_t *visible) const;
+
+private:
+    void update(const SceneGraph &graph, uint32_t begin, uint32_t end);
+    uint32_t cull(const Frustum &frustum, uint32_t begin, uint32_t end, uint32_t *visible) const;
+    void resize(uint32_t count);
+
+    std::vector<uint32_t> nodes;
+    std::vector<Bounds> localBounds;
+
+    std::vector<float> centerX;
+    std::vector<float> centerY;
+    std::vector<float> centerZ;
+    std::vector<float> extentX;
+    std::vector<float> extentY;
+    std::vector<float> extentZ;
+    std::vector<float> sphereX;
+    std::vector<float> sphereY;
+    std::vector<float> sphereZ;
+    std::vector<float> sphereRadius;
+};
+
+#endif // !FRUSTUM_CULLER_HPP
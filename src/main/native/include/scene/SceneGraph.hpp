@@ -0,0 +1,194 @@
+/**
+ * @file SceneGraph.hpp
+ * @author Lenard Büsing (nodedev74@gmail.com)
+ * @brief Flat, depth sorted scene graph with parallel world transform propagation.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2023 Lenard Büsing
+ *
+ */
+
+#ifndef SCENE_GRAPH_HPP
+#define SCENE_GRAPH_HPP
+
+#include <cstdint>
+#include <vector>
+
+class FbxScene;
+class ThreadPool;
+
+/**
+ * @brief Column major 4x4 matrix with the memory layout of glm::mat4.
+ */
+struct alignas(16) Matrix4
+{
+    float m[16];
+
+    /**
+     * @brief Creates an identity matrix.
+     *
+     * @return The identity matrix.
+     */
+    static Matrix4 identity();
+
+    /**
+     * @brief Computes out = a * b.
+     *
+     * @param a The left matrix.
+     * @param b The right matrix.
+     * @param out The product, may alias neither a nor b.
+     */
+    static void multiply(const Matrix4 &a, const Matrix4 &b, Matrix4 &out);
+};
+
+/**
+ * @brief Scene graph stored as structure of arrays.
+ *
+ * Nodes are sorted by depth so that every parent precedes its children and each depth level
+ * occupies a contiguous range. World matrices are then computed level by level, with all nodes
+ * of one level processed in parallel. Only nodes whose local transform changed, or whose
+ * parent's world transform changed, are recomputed.
+ *
+ * Nodes are addressed by the index they had when the graph was built. The world matrices are
+ * stored in depth sorted order, getSlot maps a node to its position in that array.
+ */
+class SceneGraph
+{
+public:
+    /**
+     * @brief Builds the graph from a parent list.
+     *
+     * @param parents The parent node of every node, negative for roots.
+     * @throws std::runtime_error If a parent is out of range or the parents form a cycle.
+     */
+    explicit SceneGraph(const std::vector<int32_t> &parents);
+
+    /**
+     * @brief Builds the graph from the model hierarchy of an imported FBX scene.
+     *
+     * Node i corresponds to model i. Pivots, offsets and pre and post rotations are baked into
+     * constant per node matrices.
+     *
+     * @param scene The imported scene.
+     * @return The new scene graph, owned by the caller.
+     */
+    static SceneGraph *fromScene(const FbxScene &scene);
+
+    /**
+     * @brief Retrieves the number of nodes.
+     *
+     * @return The node count.
+     */
+    uint32_t getNodeCount() const;
+
+    /**
+     * @brief Retrieves the number of depth levels.
+     *
+     * @return The level count.
+     */
+    uint32_t getLevelCount() const;
+
+    /**
+     * @brief Retrieves the position of a node in the world matrix array.
+     *
+     * @param node The node.
+     * @return The slot of the node.
+     */
+    uint32_t getSlot(uint32_t node) const;
+
+    /**
+     * @brief Sets the local translation of a node.
+     *
+     * @param node The node.
+     * @param x The translation along x.
+     * @param y The translation along y.
+     * @param z The translation along z.
+     */
+    void setTranslation(uint32_t node, float x, float y, float z);
+
+    /**
+     * @brief Sets the local Euler rotation of a node in degrees.
+     *
+     * @param node The node.
+     * @param x The rotation around x.
+     * @param y The rotation around y.
+     * @param z The rotation around z.
+     */
+    void setRotation(uint32_t node, float x, float y, float z);
+
+    /**
+     * @brief Sets the local scaling of a node.
+     *
+     * @param node The node.
+     * @param x The scaling along x.
+     * @param y The scaling along y.
+     * @param z The scaling along z.
+     */
+    void setScaling(uint32_t node, float x, float y, float z);
+
+    /**
+     * @brief Sets the Euler rotation order of a node, following the FBX EFbxRotationOrder enumeration.
+     *
+     * @param node The node.
+     * @param order The rotation order.
+     */
+    void setRotationOrder(uint32_t node, uint8_t order);
+
+    /**
+     * @brief Sets a single transform component of a node.
+     *
+     * @param node The node.
+     * @param property The component, 0 to 8 for translation, rotation and scaling x, y and z.
+     * @param value The new value.
+     */
+    void setProperty(uint32_t node, uint8_t property, float value);
+
+    /**
+     * @brief Recomputes all world matrices that are out of date.
+     *
+     * @param pool The pool to process the nodes of a level on.
+     * @return The number of recomputed nodes.
+     */
+    uint32_t update(ThreadPool &pool);
+
+    /**
+     * @brief Retrieves the world matrix of a node.
+     *
+     * @param node The node.
+     * @return The world matrix as of the last update.
+     */
+    const Matrix4 &getWorldMatrix(uint32_t node) const;
+
+    /**
+     * @brief Retrieves all world matrices in slot order.
+     *
+     * @return Pointer to getNodeCount() matrices.
+     */
+    const Matrix4 *getWorldMatrices() const;
+
+private:
+    void markDirty(uint32_t slot);
+    void computeLocal(uint32_t slot, Matrix4 &out) const;
+
+    std::vector<uint32_t> levelOffsets;
+    std::vector<uint32_t> slots;
+    std::vector<int32_t> parents;
+
+    std::vector<float> translationX, translationY, translationZ;
+    std::vector<float> rotationX, rotationY, rotationZ;
+    std::vector<float> scalingX, scalingY, scalingZ;
+    std::vector<uint8_t> rotationOrders;
+
+    std::vector<uint8_t> hasPivots;
+    std::vector<Matrix4> preRotationMatrices;
+    std::vector<Matrix4> postRotationMatrices;
+    std::vector<Matrix4> postScalingMatrices;
+
+    std::vector<uint8_t> localDirty;
+    std::vector<uint8_t> worldChanged;
+    std::vector<Matrix4> worldMatrices;
+    uint32_t dirtyCount = 0;
+};
+
+#endif // !SCENE_GRAPH_HPP
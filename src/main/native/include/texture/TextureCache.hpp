@@ -0,0 +1,70 @@
+/**
+ * @file TextureCache.hpp
+ * @author Lenard Büsing (nodedev74@gmail.com)
+ * @brief Disk cache of imported textures in the KTX2 container layout.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2023 Lenard Büsing
+ *
+ */
+
+#ifndef TEXTURE_CACHE_HPP
+#define TEXTURE_CACHE_HPP
+
+#include "texture/TextureCodec.hpp"
+
+#include <cstdint>
+#include <string>
+
+/**
+ * @brief Stores imported textures in a directory, one file per source file content.
+ *
+ * Files follow the KTX2 header, level index and level order, with the Vulkan format of the
+ * texture and an empty data format descriptor, so only this cache is expected to read them. A
+ * texture is keyed by the hash of its source file and its target format, so edited sources and
+ * switching block compression never hit a stale entry.
+ */
+class TextureCache
+{
+public:
+    /**
+     * @brief Uses the given directory.
+     *
+     * @param directory An existing cache directory, empty to disable the cache.
+     */
+    explicit TextureCache(std::string directory);
+
+    /**
+     * @brief Checks whether the cache has a directory.
+     *
+     * @return True if textures are loaded and stored.
+     */
+    bool isEnabled() const;
+
+    /**
+     * @brief Loads a cached texture.
+     *
+     * @param key The hash of the source file.
+     * @param blockCompression Whether the compressed or the RGBA8 variant is requested.
+     * @param texture Receives the texture.
+     * @return True if the entry exists and is intact.
+     */
+    bool load(uint64_t key, bool blockCompression, TextureData &texture) const;
+
+    /**
+     * @brief Stores a texture. Failures leave the cache without the entry.
+     *
+     * @param key The hash of the source file.
+     * @param blockCompression Whether the texture is the compressed variant.
+     * @param texture The texture.
+     */
+    void store(uint64_t key, bool blockCompression, const TextureData &texture) const;
+
+private:
+    std::string getPath(uint64_t key, bool blockCompression) const;
+
+    std::string directory;
+};
+
+#endif // !TEXTURE_CACHE_HPP
@@ -0,0 +1,119 @@
+/**
+ * @file TextureCodec.hpp
+ * @author Lenard Büsing (nodedev74@gmail.com)
+ * @brief Image decoding, mip generation and block compression of textures.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2023 Lenard Büsing
+ *
+ */
+
+#ifndef TEXTURE_CODEC_HPP
+#define TEXTURE_CODEC_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief The pixel formats a texture is stored and uploaded in.
+ */
+enum class TextureFormat : uint32_t
+{
+    Rgba8 = 0,
+    Bc1 = 1,
+    Bc3 = 2,
+};
+
+/**
+ * @brief A decoded image with four bytes per pixel, row by row.
+ */
+struct TextureImage
+{
+    uint32_t width = 0;
+    uint32_t height = 0;
+    std::vector<uint8_t> pixels;
+};
+
+/**
+ * @brief The position of a mip level inside the bytes of a texture.
+ */
+struct TextureLevel
+{
+    uint32_t width = 0;
+    uint32_t height = 0;
+    size_t offset = 0;
+    size_t size = 0;
+};
+
+/**
+ * @brief A texture ready for upload, with all mip levels packed one after another.
+ */
+struct TextureData
+{
+    TextureFormat format = TextureFormat::Rgba8;
+    uint32_t width = 0;
+    uint32_t height = 0;
+    std::vector<TextureLevel> levels;
+    std::vector<uint8_t> bytes;
+};
+
+/**
+ * @brief Turns encoded image files into uploadable textures.
+ *
+ * Decoding supports PNG without interlacing and uncompressed or run length encoded TGA. Mip
+ * levels are reduced with a 2x2 box filter down to 1x1. BC1 stores opaque textures in 8 bytes
+ * and BC3 textures with alpha in 16 bytes per 4x4 block, against 64 bytes for RGBA8.
+ */
+class TextureCodec
+{
+public:
+    /**
+     * @brief Decodes a PNG or TGA file, recognized by its content.
+     *
+     * @param data The file content.
+     * @param size The size of the file content.
+     * @return The image with four bytes per pixel.
+     * @throws std::runtime_error If the format is unsupported or the content is malformed.
+     */
+    static TextureImage decode(const uint8_t *data, size_t size);
+
+    /**
+     * @brief Builds the full mip chain of an image.
+     *
+     * @param image The base level.
+     * @return An RGBA8 texture holding the base level and all reduced levels.
+     */
+    static TextureData generateMips(const TextureImage &image);
+
+    /**
+     * @brief Compresses every level of an RGBA8 texture, BC3 if any pixel is translucent and BC1 otherwise.
+     *
+     * @param texture The RGBA8 texture.
+     * @return The block compressed texture.
+     */
+    static TextureData compress(const TextureData &texture);
+
+    /**
+     * @brief Decodes a file, builds its mip chain and optionally compresses it.
+     *
+     * @param data The file content.
+     * @param size The size of the file content.
+     * @param blockCompression True to compress into BC1 or BC3.
+     * @return The texture ready for upload.
+     * @throws std::runtime_error If the file cannot be decoded.
+     */
+    static TextureData import(const uint8_t *data, size_t size, bool blockCompression);
+
+    /**
+     * @brief Computes a 64 bit FNV-1a hash, used to key cached textures by file content.
+     *
+     * @param data The bytes.
+     * @param size The number of bytes.
+     * @return The hash.
+     */
+    static uint64_t hash(const uint8_t *data, size_t size);
+};
+
+#endif // !TEXTURE_CODEC_HPP
@@ -0,0 +1,296 @@
+/**
+ * @file VkBindless.hpp
+ * @author Lenard Büsing (nodedev74@gmail.com)
+ * @brief Material table and bindless descriptor arrays for textures and storage buffers.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2023 Lenard Büsing
+ *
+ */
+
+#ifndef VK_BINDLESS_HPP
+#define VK_BINDLESS_HPP
+
+#include "texture/TextureCodec.hpp"
+#include "vulkan/VkMemoryTracker.hpp"
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief A material table entry read by the mesh fragment shaders.
+ */
+struct MaterialData
+{
+    float baseColor[4];
+    uint32_t textureIndex;
+    uint32_t padding[3];
+};
+
+/**
+ * @brief Replaces a texture by one holding another range of the mip levels of its data.
+ */
+struct TextureUpdate
+{
+    uint32_t texture;
+    const TextureData *data;
+    uint32_t firstLevel;
+};
+
+/**
+ * @brief Owns the textures and the material table and exposes them to the shaders.
+ *
+ * With descriptor indexing all textures and storage buffers sit in two large update after bind
+ * arrays of a single descriptor set, which is bound once per frame while materials refer to
+ * resources by index. New resources are written to unused array elements, so they can be added
+ * while earlier frames are still pending. Without descriptor indexing every material gets a set
+ * of its own holding the material table and its texture, which is bound before its draws.
+ * Texture 0 is white and material 0 is white without a texture.
+ *
+ * Uploads are submitted with a fence per batch and not waited for. Frames submitted later are
+ * ordered after the copies by their barriers, while the staging buffers and the images that
+ * updates replaced are kept until the fence signals, which also covers every frame submitted
+ * before the batch.
+ */
+class VkBindless
+{
+public:
+    /**
+     * @brief Creates the material table, the default texture and the descriptor sets.
+     *
+     * @param device The logical device.
+     * @param memoryTracker The allocator of the device memory, it must outlive this object.
+     * @param queue The queue to upload the default texture with.
+     * @param commandPool The command pool of the queue.
+     * @param descriptorIndexing Whether the device enabled the descriptor indexing features.
+     * @param textureCapacity The number of elements of the texture array.
+     * @param bufferCapacity The number of elements of the storage buffer array.
+     * @param materialCapacity The number of entries of the material table.
+     * @return The result of the first failing Vulkan call, or VK_SUCCESS.
+     */
+    VkResult create(VkDevice device, VkMemoryTracker &memoryTracker, VkQueue queue, VkCommandPool commandPool, bool descriptorIndexing,
+                    uint32_t textureCapacity, uint32_t bufferCapacity, uint32_t materialCapacity);
+
+    /**
+     * @brief Destroys all Vulkan objects.
+     */
+    void destroy();
+
+    /**
+     * @brief Uploads an RGBA8 texture through a staging buffer.
+     *
+     * @param queue The queue to submit the copy to.
+     * @param commandPool The command pool of the queue.
+     * @param width The width in pixels.
+     * @param height The height in pixels.
+     * @param pixels Four bytes per pixel, row by row.
+     * @param index Receives the texture index.
+     * @return VK_ERROR_TOO_MANY_OBJECTS if the texture array is full, otherwise the result of the first failing Vulkan call or VK_SUCCESS.
+     */
+    VkResult addTexture(VkQueue queue, VkCommandPool commandPool, uint32_t width, uint32_t height, const uint8_t *pixels, uint32_t &index);
+
+    /**
+     * @brief Uploads textures with their mip levels through one staging buffer and a single submit.
+     *
+     * @param queue The queue to submit the copies to.
+     * @param commandPool The command pool of the queue.
+     * @param textureData The textures, block compressed ones need a device with BC support.
+     * @param count The number of textures.
+     * @param firstLevels The finest level to upload per texture, or nullptr for all levels.
+     * @param indices Receives the consecutive texture indices.
+     * @return VK_ERROR_TOO_MANY_OBJECTS if the texture array cannot hold all textures, otherwise the result of the first failing Vulkan call or VK_SUCCESS.
+     */
+    VkResult addTextures(VkQueue queue, VkCommandPool commandPool, const TextureData *textureData, size_t count, const uint32_t *firstLevels, uint32_t *indices);
+
+    /**
+     * @brief Recreates textures with another finest level and rewrites their descriptors.
+     *
+     * Levels both images hold are copied on the device, finer ones are uploaded from the data. The
+     * replaced images are destroyed once the frames submitted before have completed. Per material
+     * sets cannot be rewritten while pending frames use them, so with those the transfer is waited for.
+     *
+     * @param queue The queue to submit the copies to.
+     * @param commandPool The command pool of the queue.
+     * @param updates The textures and their new finest levels, each texture at most once.
+     * @param count The number of updates.
+     * @param uploadedBytes Receives the number of bytes uploaded from the host.
+     * @return The result of the first failing Vulkan call, or VK_SUCCESS.
+     */
+    VkResult updateTextures(VkQueue queue, VkCommandPool commandPool, const TextureUpdate *updates, size_t count, uint64_t &uploadedBytes);
+
+    /**
+     * @brief Frees the staging buffers and replaced images of transfers that have completed.
+     */
+    void releaseTransfers();
+
+    /**
+     * @brief Adds a storage buffer to the bindless buffer array. Buffer 0 is the material table.
+     *
+     * @param buffer The buffer, it must outlive this object.
+     * @param index Receives the buffer index.
+     * @return VK_ERROR_FEATURE_NOT_PRESENT without descriptor indexing, VK_ERROR_TOO_MANY_OBJECTS if the array is full, otherwise VK_SUCCESS.
+     */
+    VkResult addBuffer(VkBuffer buffer, uint32_t &index);
+
+    /**
+     * @brief Appends a material to the table. Its set is created if per material sets are in use.
+     *
+     * @param material The material, its texture index must refer to an added texture.
+     * @param index Receives the material index.
+     * @return VK_ERROR_TOO_MANY_OBJECTS if the table is full, otherwise the result of the first failing Vulkan call or VK_SUCCESS.
+     */
+    VkResult addMaterial(const MaterialData &material, uint32_t &index);
+
+    /**
+     * @brief Switches to per material sets and creates the sets of all materials that have none yet.
+     *
+     * @return The result of the first failing Vulkan call, or VK_SUCCESS.
+     */
+    VkResult prepareMaterialSets();
+
+    /**
+     * @brief Checks whether the bindless set can be used.
+     *
+     * @return True if the device enabled descriptor indexing.
+     */
+    bool isDescriptorIndexingSupported() const;
+
+    /**
+     * @brief Retrieves the number of materials.
+     *
+     * @return The material count.
+     */
+    uint32_t getMaterialCount() const;
+
+    /**
+     * @brief Retrieves the number of textures including the default one.
+     *
+     * @return The texture count.
+     */
+    uint32_t getTextureCount() const;
+
+    /**
+     * @brief Retrieves the number of descriptors written since creation.
+     *
+     * @return The descriptor write count.
+     */
+    uint64_t getDescriptorWriteCount() const;
+
+    /**
+     * @brief Retrieves the device memory allocated for textures.
+     *
+     * @return The size in bytes.
+     */
+    uint64_t getTextureMemory() const;
+
+    /**
+     * @brief Retrieves the texture a material samples.
+     *
+     * @param material The material index.
+     * @return The texture index.
+     */
+    uint32_t getMaterialTexture(uint32_t material) const;
+
+    /**
+     * @brief Retrieves the layout of the bindless set.
+     *
+     * @return A layout with the texture array at binding 0 and the storage buffer array at binding 1, or VK_NULL_HANDLE without descriptor indexing.
+     */
+    VkDescriptorSetLayout getSetLayout() const;
+
+    /**
+     * @brief Retrieves the bindless set.
+     *
+     * @return The descriptor set, or VK_NULL_HANDLE without descriptor indexing.
+     */
+    VkDescriptorSet getSet() const;
+
+    /**
+     * @brief Retrieves the layout of the per material sets.
+     *
+     * @return A layout with the material table at binding 0 and the texture at binding 1.
+     */
+    VkDescriptorSetLayout getMaterialSetLayout() const;
+
+    /**
+     * @brief Retrieves the set of a material.
+     *
+     * @param material The material index, prepareMaterialSets() must have been called since it was added.
+     * @return The descriptor set.
+     */
+    VkDescriptorSet getMaterialSet(uint32_t material) const;
+
+private:
+    struct Texture
+    {
+        VkImage image = VK_NULL_HANDLE;
+        VkImageView view = VK_NULL_HANDLE;
+        VkDeviceMemory memory = VK_NULL_HANDLE;
+        VkDeviceSize size = 0;
+        uint32_t firstLevel = 0;
+        uint32_t levelCount = 1;
+    };
+
+    struct LevelCopy
+    {
+        const TextureData *data;
+        uint32_t level;
+        VkImage image;
+        uint32_t imageLevel;
+    };
+
+    struct Transfer
+    {
+        VkFence fence = VK_NULL_HANDLE;
+        VkCommandPool commandPool = VK_NULL_HANDLE;
+        VkCommandBuffer commandBuffer = VK_NULL_HANDLE;
+        VkBuffer stagingBuffer = VK_NULL_HANDLE;
+        VkDeviceMemory stagingMemory = VK_NULL_HANDLE;
+        std::vector<Texture> replaced;
+    };
+
+    VkResult createBuffer(VkDeviceSize size, VkBufferUsageFlags usage, VkBuffer &buffer);
+    VkResult allocate(const VkMemoryRequirements &memoryRequirements, VkMemoryPropertyFlags preferred, VkMemoryPropertyFlags required, MemoryCategory category, VkDeviceMemory &memory);
+    VkResult createBindlessSet(uint32_t textureCapacity, uint32_t bufferCapacity);
+    VkResult createMaterialSet(uint32_t material);
+    VkResult createTexture(const TextureData &textureData, uint32_t firstLevel, Texture &texture);
+    VkImageMemoryBarrier createBarrier(VkImage image, uint32_t levelCount, VkImageLayout oldLayout, VkImageLayout newLayout);
+    VkResult transfer(VkQueue queue, VkCommandPool commandPool, const std::vector<LevelCopy> &uploads, const std::pair<VkImage, VkImage> *copyImages, size_t copyCount,
+                      std::vector<VkImageMemoryBarrier> &barriers, const VkImageCopy *copies = nullptr);
+    void writeTextureDescriptors(uint32_t first, uint32_t count);
+    void destroyTexture(Texture &texture);
+    void destroyTransfer(Transfer &transfer);
+
+    VkDevice device = VK_NULL_HANDLE;
+    VkMemoryTracker *memoryTracker = nullptr;
+    bool descriptorIndexing = false;
+    bool materialSetsEnabled = false;
+    uint64_t descriptorWriteCount = 0;
+
+    VkSampler sampler = VK_NULL_HANDLE;
+    std::vector<Texture> textures;
+    uint32_t textureCapacity = 0;
+    uint64_t textureMemory = 0;
+    std::vector<Transfer> transfers;
+
+    VkBuffer materialBuffer = VK_NULL_HANDLE;
+    VkDeviceMemory materialMemory = VK_NULL_HANDLE;
+    MaterialData *materialPointer = nullptr;
+    uint32_t materialCapacity = 0;
+    uint32_t materialCount = 0;
+
+    uint32_t bufferCapacity = 0;
+    uint32_t bufferCount = 0;
+
+    VkDescriptorPool bindlessPool = VK_NULL_HANDLE;
+    VkDescriptorSetLayout bindlessLayout = VK_NULL_HANDLE;
+    VkDescriptorSet bindlessSet = VK_NULL_HANDLE;
+
+    VkDescriptorPool materialPool = VK_NULL_HANDLE;
+    VkDescriptorSetLayout materialLayout = VK_NULL_HANDLE;
+    std::vector<VkDescriptorSet> materialSets;
+};
+
+#endif // !VK_BINDLESS_HPP
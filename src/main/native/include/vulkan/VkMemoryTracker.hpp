@@ -0,0 +1,222 @@
+/**
+ * @file VkMemoryTracker.hpp
+ * @author Lenard Büsing (nodedev74@gmail.com)
+ * @brief Device memory accounting per category and heap budget with eviction callbacks.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2023 Lenard Büsing
+ *
+ */
+
+#ifndef VK_MEMORY_TRACKER_HPP
+#define VK_MEMORY_TRACKER_HPP
+
+#include "vulkan/VkHelper.hpp"
+
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief What an allocation holds, the unit the usage is reported in.
+ */
+enum class MemoryCategory : uint32_t
+{
+    Vertex = 0,
+    Index = 1,
+    Texture = 2,
+    Staging = 3,
+    Uniform = 4,
+    Target = 5,
+};
+
+/**
+ * @brief Number of memory categories.
+ */
+constexpr uint32_t MEMORY_CATEGORY_COUNT = 6;
+
+/**
+ * @brief Allocates all device memory of the renderer and keeps every heap within its budget.
+ *
+ * Every allocation is recorded with its category and heap. The budget of a heap comes from
+ * VK_EXT_memory_budget where the device has it, otherwise it is 80% of the heap size, and an
+ * optional limit caps it further. With the extension the usage is the one the driver reported at
+ * the last update(), corrected by the bytes allocated and freed since, so memory of other
+ * objects in the process counts as well; without it only the recorded allocations count.
+ *
+ * An allocation that would exceed the budget fails with VK_ERROR_OUT_OF_DEVICE_MEMORY instead of
+ * letting the driver page or fail later, and marks the missing bytes of its heap for eviction.
+ * Allocations run on worker threads and in the middle of recording, so the eviction callbacks
+ * are only called by update() at the frame boundary: for the marked bytes, and ahead of time
+ * once a heap passes 90% of its budget, down to 80%. They are called for the categories held in
+ * the heap, in the order they were added, until enough bytes are freed. Allocations made by a
+ * callback while it evicts are only checked against the heap size, so caches may replace
+ * resources by smaller ones. All functions may be called from several threads, callbacks run on
+ * the thread calling update().
+ */
+class VkMemoryTracker
+{
+public:
+    /**
+     * @brief Reads the memory properties and the initial budgets.
+     *
+     * @param physicalDevice The physical device.
+     * @param device The logical device.
+     * @param memoryBudget Whether the device enabled VK_EXT_memory_budget.
+     * @param limit The maximum budget of a device local heap in bytes, 0 for no limit.
+     */
+    void create(VkPhysicalDevice physicalDevice, VkDevice device, bool memoryBudget, uint64_t limit);
+
+    /**
+     * @brief Forgets all allocations and callbacks. The memory has to be freed before.
+     */
+    void destroy();
+
+    /**
+     * @brief Allocates memory within the budget of its heap.
+     *
+     * @param memoryRequirements The requirements of the resources bound to the memory.
+     * @param preferred The property flags tried first.
+     * @param required The property flags used if no type has the preferred ones.
+     * @param category What the memory holds.
+     * @param memory Receives the memory.
+     * @return VK_ERROR_FEATURE_NOT_PRESENT if no memory type fits, VK_ERROR_OUT_OF_DEVICE_MEMORY if
+     * the heap would exceed its budget, otherwise the result of vkAllocateMemory().
+     */
+    VkResult allocate(const VkMemoryRequirements &memoryRequirements, VkMemoryPropertyFlags preferred, VkMemoryPropertyFlags required,
+                      MemoryCategory category, VkDeviceMemory &memory);
+
+    /**
+     * @brief Frees memory from allocate(). VK_NULL_HANDLE is ignored.
+     *
+     * @param memory The memory.
+     */
+    void free(VkDeviceMemory memory);
+
+    /**
+     * @brief Adds a callback that frees memory of a category when its heap runs out of budget.
+     *
+     * @param category The category the callback frees.
+     * @param callback Receives the number of bytes wanted and returns the number of bytes freed.
+     */
+    void addEvictionCallback(MemoryCategory category, std::function<uint64_t(uint64_t)> callback);
+
+    /**
+     * @brief Queries the budgets and evicts the bytes refused allocations marked and from heaps that
+     * are close to their budget. Called once per frame by the thread owning the evicted resources.
+     */
+    void update();
+
+    /**
+     * @brief Retrieves the memory properties of the physical device.
+     *
+     * @return The memory properties.
+     */
+    const VkPhysicalDeviceMemoryProperties &getMemoryProperties() const;
+
+    /**
+     * @brief Checks whether the budgets come from VK_EXT_memory_budget.
+     *
+     * @return True if the extension is in use.
+     */
+    bool isBudgetSupported() const;
+
+    /**
+     * @brief Retrieves the bytes allocated for a category in all heaps.
+     *
+     * @param category The category.
+     * @return The size in bytes.
+     */
+    uint64_t getCategoryBytes(MemoryCategory category) const;
+
+    /**
+     * @brief Retrieves the number of memory heaps.
+     *
+     * @return The heap count.
+     */
+    uint32_t getHeapCount() const;
+
+    /**
+     * @brief Retrieves the budget of a heap.
+     *
+     * @param heap The heap index.
+     * @return The size in bytes.
+     */
+    uint64_t getHeapBudget(uint32_t heap) const;
+
+    /**
+     * @brief Retrieves the usage of a heap the budget is checked against.
+     *
+     * @param heap The heap index.
+     * @return The size in bytes.
+     */
+    uint64_t getHeapUsage(uint32_t heap) const;
+
+    /**
+     * @brief Retrieves the number of times the eviction callbacks were called.
+     *
+     * @return The eviction count.
+     */
+    uint64_t getEvictionCount() const;
+
+    /**
+     * @brief Retrieves the bytes the eviction callbacks reported freed.
+     *
+     * @return The size in bytes.
+     */
+    uint64_t getEvictedBytes() const;
+
+    /**
+     * @brief Retrieves the number of allocations refused because their heap was over budget.
+     *
+     * @return The refused allocation count.
+     */
+    uint64_t getRefusedCount() const;
+
+private:
+    struct Allocation
+    {
+        VkDeviceSize size;
+        uint32_t heap;
+        MemoryCategory category;
+    };
+
+    struct Heap
+    {
+        uint64_t budget = 0;
+        uint64_t reportedUsage = 0;
+        uint64_t reportedBytes = 0;
+        uint64_t bytes = 0;
+        uint64_t categoryBytes[MEMORY_CATEGORY_COUNT] = {};
+        uint64_t evictionBytes = 0;
+    };
+
+    struct EvictionCallback
+    {
+        MemoryCategory category;
+        std::function<uint64_t(uint64_t)> callback;
+    };
+
+    uint64_t getUsage(uint32_t heap) const;
+    uint64_t evict(uint32_t heap, uint64_t bytes);
+
+    VkPhysicalDevice physicalDevice = VK_NULL_HANDLE;
+    VkDevice device = VK_NULL_HANDLE;
+    VkPhysicalDeviceMemoryProperties memoryProperties{};
+    bool memoryBudget = false;
+    uint64_t limit = 0;
+
+    mutable std::recursive_mutex mutex;
+    std::vector<Heap> heaps;
+    std::unordered_map<VkDeviceMemory, Allocation> allocations;
+    std::vector<EvictionCallback> evictionCallbacks;
+    bool evicting = false;
+    uint64_t evictionCount = 0;
+    uint64_t evictedBytes = 0;
+    uint64_t refusedCount = 0;
+};
+
+#endif // !VK_MEMORY_TRACKER_HPP
@@ -0,0 +1,205 @@
+/**
+ * @file VkMeshArena.hpp
+ * @author Lenard Büsing (nodedev74@gmail.com)
+ * @brief Shared vertex and index arenas and per frame draw lists for multi draw indirect.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2023 Lenard Büsing
+ *
+ */
+
+#ifndef VK_MESH_ARENA_HPP
+#define VK_MESH_ARENA_HPP
+
+#include "vulkan/VkMemoryTracker.hpp"
+
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief The place of a mesh inside the arenas.
+ */
+struct MeshRange
+{
+    uint32_t firstIndex;
+    uint32_t indexCount;
+    int32_t vertexOffset;
+};
+
+/**
+ * @brief The matrix slot of draws whose vertices are already in world space, like skinned ones.
+ */
+constexpr uint32_t WORLD_SPACE_MATRIX_SLOT = 0xFFFFFFFFu;
+
+/**
+ * @brief Per draw data read by the mesh vertex shader through the instance index.
+ */
+struct DrawData
+{
+    uint32_t matrixSlot;
+    uint32_t materialIndex;
+    uint32_t firstIndex;
+    uint32_t indexCount;
+};
+
+/**
+ * @brief Packs all meshes into one vertex and one index buffer, so a whole frame draws without
+ * rebinding them.
+ *
+ * Every frame slot owns a host visible draw data buffer and an indirect command buffer. Draw i
+ * uses first instance i, so the vertex shader finds its data at the instance index no matter
+ * whether it was recorded directly, from the command buffer or from a compacted GPU list.
+ * Meshes are appended and never freed, the arenas are sized up front. Uploads are not waited
+ * for, their staging buffers are kept until the fence of their submission signals.
+ */
+class VkMeshArena
+{
+public:
+    /**
+     * @brief Creates the arenas, the per frame buffers and their descriptor sets.
+     *
+     * @param device The logical device.
+     * @param memoryTracker The allocator of the device memory, it must outlive this object.
+     * @param frameCount The number of frame slots.
+     * @param vertexCapacity The maximum number of vertices of all meshes.
+     * @param indexCapacity The maximum number of indices of all meshes.
+     * @param drawCapacity The maximum number of draws per frame.
+     * @return The result of the first failing Vulkan call, or VK_SUCCESS.
+     */
+    VkResult create(VkDevice device, VkMemoryTracker &memoryTracker, uint32_t frameCount, uint32_t vertexCapacity,
+                    uint32_t indexCapacity, uint32_t drawCapacity);
+
+    /**
+     * @brief Destroys all Vulkan objects.
+     */
+    void destroy();
+
+    /**
+     * @brief Appends a mesh to the arenas through a staging buffer. Frames submitted later draw it
+     * after the copy completed.
+     *
+     * @param queue The queue to submit the copy to.
+     * @param commandPool The command pool of the queue.
+     * @param positions x, y and z per vertex.
+     * @param vertexCount The number of vertices.
+     * @param indices The triangle list indices, relative to the first vertex of the mesh.
+     * @param indexCount The number of indices.
+     * @param range Receives the place of the mesh.
+     * @return VK_ERROR_OUT_OF_DEVICE_MEMORY if an arena is full, otherwise the result of the first failing Vulkan call or VK_SUCCESS.
+     */
+    VkResult upload(VkQueue queue, VkCommandPool commandPool, const float *positions, uint32_t vertexCount, const uint32_t *indices, uint32_t indexCount,
+                    MeshRange &range);
+
+    /**
+     * @brief Frees the staging buffers of uploads that have completed.
+     */
+    void releaseUploads();
+
+    /**
+     * @brief Binds the vertex and index arena.
+     *
+     * @param commandBuffer The command buffer.
+     */
+    void bind(VkCommandBuffer commandBuffer) const;
+
+    /**
+     * @brief Retrieves the maximum number of draws per frame.
+     *
+     * @return The draw capacity.
+     */
+    uint32_t getDrawCapacity() const;
+
+    /**
+     * @brief Retrieves the draw data of a frame slot for writing.
+     *
+     * @param frame The frame slot, its previous submission must have completed.
+     * @return getDrawCapacity() entries.
+     */
+    DrawData *getDraws(uint32_t frame);
+
+    /**
+     * @brief Retrieves the indirect commands of a frame slot for writing.
+     *
+     * @param frame The frame slot, its previous submission must have completed.
+     * @return getDrawCapacity() commands.
+     */
+    VkDrawIndexedIndirectCommand *getCommands(uint32_t frame);
+
+    /**
+     * @brief Retrieves the draw data buffer of a frame slot.
+     *
+     * @param frame The frame slot.
+     * @return The buffer behind getDraws().
+     */
+    VkBuffer getDrawBuffer(uint32_t frame) const;
+
+    /**
+     * @brief Retrieves the indirect command buffer of a frame slot.
+     *
+     * @param frame The frame slot.
+     * @return The buffer behind getCommands().
+     */
+    VkBuffer getCommandBuffer(uint32_t frame) const;
+
+    /**
+     * @brief Retrieves the layout of the draw data descriptor set.
+     *
+     * @return A layout with the draw data storage buffer at binding 0.
+     */
+    VkDescriptorSetLayout getSetLayout() const;
+
+    /**
+     * @brief Retrieves the draw data descriptor set of a frame slot.
+     *
+     * @param frame The frame slot.
+     * @return The descriptor set.
+     */
+    VkDescriptorSet getSet(uint32_t frame) const;
+
+private:
+    struct Frame
+    {
+        VkBuffer drawBuffer = VK_NULL_HANDLE;
+        VkBuffer commandBuffer = VK_NULL_HANDLE;
+        VkDescriptorSet set = VK_NULL_HANDLE;
+        DrawData *drawPointer = nullptr;
+        VkDrawIndexedIndirectCommand *commandPointer = nullptr;
+    };
+
+    struct Upload
+    {
+        VkFence fence = VK_NULL_HANDLE;
+        VkCommandPool commandPool = VK_NULL_HANDLE;
+        VkCommandBuffer commandBuffer = VK_NULL_HANDLE;
+        VkBuffer stagingBuffer = VK_NULL_HANDLE;
+        VkDeviceMemory stagingMemory = VK_NULL_HANDLE;
+    };
+
+    VkResult createBuffer(VkDeviceSize size, VkBufferUsageFlags usage, VkBuffer &buffer);
+    VkResult allocate(const std::vector<VkBuffer> &buffers, VkMemoryPropertyFlags preferred, VkMemoryPropertyFlags required,
+                      MemoryCategory category, VkDeviceMemory &memory, std::vector<VkDeviceSize> &offsets);
+    void destroyUpload(Upload &upload);
+
+    VkDevice device = VK_NULL_HANDLE;
+    VkMemoryTracker *memoryTracker = nullptr;
+
+    VkBuffer vertexBuffer = VK_NULL_HANDLE;
+    VkBuffer indexBuffer = VK_NULL_HANDLE;
+    VkDeviceMemory vertexMemory = VK_NULL_HANDLE;
+    VkDeviceMemory indexMemory = VK_NULL_HANDLE;
+    uint32_t vertexCapacity = 0;
+    uint32_t indexCapacity = 0;
+    uint32_t vertexCount = 0;
+    uint32_t indexCount = 0;
+    std::vector<Upload> uploads;
+
+    std::vector<Frame> frames;
+    VkDeviceMemory frameMemory = VK_NULL_HANDLE;
+    uint32_t drawCapacity = 0;
+
+    VkDescriptorPool descriptorPool = VK_NULL_HANDLE;
+    VkDescriptorSetLayout setLayout = VK_NULL_HANDLE;
+};
+
+#endif // !VK_MESH_ARENA_HPP
@@ -0,0 +1,217 @@
+/**
+ * @file VkOcclusion.hpp
+ * @author Lenard Büsing (nodedev74@gmail.com)
+ * @brief Hierarchical depth occlusion culling of object bounds on the GPU.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2023 Lenard Büsing
+ *
+ */
+
+#ifndef VK_OCCLUSION_HPP
+#define VK_OCCLUSION_HPP
+
+#include "vulkan/VkMemoryTracker.hpp"
+#include "scene/SceneGraph.hpp"
+
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief A world space box tested for occlusion, the arena range it draws and its draw data, laid
+ * out for the occlusion compute shader.
+ */
+struct OcclusionCandidate
+{
+    float center[3];
+    uint32_t indexCount;
+    float extent[3];
+    uint32_t firstIndex;
+    int32_t vertexOffset;
+    uint32_t matrixSlot;
+    uint32_t materialIndex;
+    uint32_t group;
+};
+
+/**
+ * @brief What the occlusion test writes for the candidates.
+ */
+enum class OcclusionOutput : uint32_t
+{
+    Draws = 0,
+    CompactDraws = 1,
+    Instances = 2,
+};
+
+/**
+ * @brief Tests object bounds against a depth pyramid built from the previous frame.
+ *
+ * After the render pass of a frame, its depth attachment is reduced into a single R32 pyramid
+ * whose texels hold the farthest depth they cover. The next frame projects the box of every
+ * candidate and picks the level where the box spans at most two by two texels. Candidate i
+ * becomes an indexed indirect draw with first instance i, either at slot i with an instance
+ * count of zero if the box lies behind the pyramid, or compacted to the front of the buffer
+ * with the draw count in the counter buffer. For instanced drawing the candidates name their
+ * instance group instead, whose command the host writes with an instance count of zero. Every
+ * visible candidate increments the count and writes its draw data into the next draw of the
+ * group. The pyramid lags one frame behind the camera, so objects uncovered by a fast camera
+ * move may appear one frame late.
+ */
+class VkOcclusion
+{
+public:
+    /**
+     * @brief Creates the pyramid, buffers, descriptor sets and compute pipelines.
+     *
+     * @param device The logical device.
+     * @param memoryTracker The allocator of the device memory, it must outlive this object.
+     * @param pyramidShader The pyramid reduction compute shader module.
+     * @param cullShader The occlusion test compute shader module.
+     * @param depthViews The depth attachment view of every frame slot.
+     * @param extent The size of the depth attachments.
+     * @param candidateCapacity The maximum number of candidates per frame.
+     * @param instanceDrawBuffers The draw data buffer of every frame slot, receiving the visible instances.
+     * @param instanceGroupBuffers The indirect command buffer of every frame slot, holding the instance groups.
+     * @return The result of the first failing Vulkan call, or VK_SUCCESS.
+     */
+    VkResult create(VkDevice device, VkMemoryTracker &memoryTracker, VkShaderModule pyramidShader, VkShaderModule cullShader,
+                    const std::vector<VkImageView> &depthViews, VkExtent2D extent, uint32_t candidateCapacity,
+                    const std::vector<VkBuffer> &instanceDrawBuffers, const std::vector<VkBuffer> &instanceGroupBuffers);
+
+    /**
+     * @brief Destroys all Vulkan objects.
+     */
+    void destroy();
+
+    /**
+     * @brief Retrieves the maximum number of candidates per frame.
+     *
+     * @return The candidate capacity.
+     */
+    uint32_t getCapacity() const;
+
+    /**
+     * @brief Retrieves the candidates of a frame slot for writing.
+     *
+     * @param frame The frame slot, its previous submission must have completed.
+     * @return getCapacity() candidates.
+     */
+    OcclusionCandidate *getCandidates(uint32_t frame);
+
+    /**
+     * @brief Retrieves the number of candidates the last submission of a frame slot occluded.
+     *
+     * @param frame The frame slot, its previous submission must have completed.
+     * @return The occluded count.
+     */
+    uint32_t getOccludedCount(uint32_t frame) const;
+
+    /**
+     * @brief Records the occlusion test. Must be recorded outside of a render pass.
+     *
+     * Without a pyramid from an earlier frame every candidate is drawn. The caller orders the
+     * pyramid read, the draw, instance and counter writes against the other passes of the frame.
+     *
+     * @param commandBuffer The command buffer of the frame slot.
+     * @param frame The frame slot.
+     * @param viewProjection The view projection matrix of the frame.
+     * @param count The number of candidates written.
+     * @param output Draws for a draw per candidate, CompactDraws to write only the visible draws and
+     * count them for an indirect count draw, Instances to pack the visible candidates into their groups.
+     */
+    void recordCull(VkCommandBuffer commandBuffer, uint32_t frame, const Matrix4 &viewProjection, uint32_t count, OcclusionOutput output);
+
+    /**
+     * @brief Records the pyramid reduction of the depth attachment after the render pass.
+     *
+     * The caller transitions the depth attachment to VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL
+     * and the pyramid to VK_IMAGE_LAYOUT_GENERAL after the culling pass has read it.
+     *
+     * @param commandBuffer The command buffer of the frame slot.
+     * @param frame The frame slot.
+     */
+    void recordPyramid(VkCommandBuffer commandBuffer, uint32_t frame);
+
+    /**
+     * @brief Discards the pyramid, the next frame draws every candidate again.
+     */
+    void reset();
+
+    /**
+     * @brief Retrieves the pyramid image.
+     *
+     * @return The image, all levels are used in VK_IMAGE_LAYOUT_GENERAL.
+     */
+    VkImage getPyramid() const;
+
+    /**
+     * @brief Retrieves the number of pyramid levels.
+     *
+     * @return The level count.
+     */
+    uint32_t getLevelCount() const;
+
+    /**
+     * @brief Retrieves the indirect draw buffer of a frame slot.
+     *
+     * @param frame The frame slot.
+     * @return One VkDrawIndexedIndirectCommand per candidate.
+     */
+    VkBuffer getDrawBuffer(uint32_t frame) const;
+
+    /**
+     * @brief Retrieves the counter buffer of a frame slot.
+     *
+     * @param frame The frame slot.
+     * @return The occluded count at offset 0 and the compacted draw count at offset 4.
+     */
+    VkBuffer getCounterBuffer(uint32_t frame) const;
+
+private:
+    struct Frame
+    {
+        VkBuffer candidateBuffer = VK_NULL_HANDLE;
+        VkBuffer counterBuffer = VK_NULL_HANDLE;
+        VkBuffer drawBuffer = VK_NULL_HANDLE;
+        VkDescriptorSet cullSet = VK_NULL_HANDLE;
+        VkDescriptorSet depthSet = VK_NULL_HANDLE;
+        OcclusionCandidate *candidatePointer = nullptr;
+        uint32_t *counterPointer = nullptr;
+    };
+
+    VkResult createBuffer(VkDeviceSize size, VkBufferUsageFlags usage, VkBuffer &buffer);
+    VkResult allocate(const std::vector<VkBuffer> &buffers, VkMemoryPropertyFlags preferred, VkMemoryPropertyFlags required,
+                      MemoryCategory category, VkDeviceMemory &memory, std::vector<VkDeviceSize> &offsets);
+    VkResult createPipeline(VkShaderModule shader, VkDescriptorSetLayout setLayout, uint32_t pushConstantSize, VkPipelineLayout &layout, VkPipeline &pipeline);
+
+    VkDevice device = VK_NULL_HANDLE;
+    VkMemoryTracker *memoryTracker = nullptr;
+
+    VkExtent2D depthExtent{};
+    VkExtent2D pyramidExtent{};
+    uint32_t levelCount = 0;
+    VkImage pyramid = VK_NULL_HANDLE;
+    VkDeviceMemory pyramidMemory = VK_NULL_HANDLE;
+    VkImageView pyramidView = VK_NULL_HANDLE;
+    std::vector<VkImageView> levelViews;
+    std::vector<VkDescriptorSet> levelSets;
+    VkSampler sampler = VK_NULL_HANDLE;
+    bool pyramidValid = false;
+
+    std::vector<Frame> frames;
+    VkDeviceMemory frameMemory = VK_NULL_HANDLE;
+    VkDeviceMemory drawMemory = VK_NULL_HANDLE;
+
+    VkDescriptorPool descriptorPool = VK_NULL_HANDLE;
+    VkDescriptorSetLayout pyramidSetLayout = VK_NULL_HANDLE;
+    VkDescriptorSetLayout cullSetLayout = VK_NULL_HANDLE;
+    VkPipelineLayout pyramidPipelineLayout = VK_NULL_HANDLE;
+    VkPipelineLayout cullPipelineLayout = VK_NULL_HANDLE;
+    VkPipeline pyramidPipeline = VK_NULL_HANDLE;
+    VkPipeline cullPipeline = VK_NULL_HANDLE;
+
+    uint32_t candidateCapacity = 0;
+};
+
+#endif // !VK_OCCLUSION_HPP
@@ -0,0 +1,173 @@
+/**
+ * @file VkProfiler.hpp
+ * @author Lenard Büsing (nodedev74@gmail.com)
+ * @brief GPU profiler based on timestamp and pipeline statistics queries.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2023 Lenard Büsing
+ *
+ */
+
+#ifndef VK_PROFILER_HPP
+#define VK_PROFILER_HPP
+
+#include "vulkan/VkHelper.hpp"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Number of pipeline statistics collected per frame.
+ */
+constexpr uint32_t VK_PROFILER_STATISTICS_COUNT = 5;
+
+/**
+ * @brief Collects named GPU timestamp scopes and pipeline statistics per frame.
+ *
+ * Every frame slot owns its own query pools, so results of a slot are read back while
+ * other slots are still in flight. Results are read without waiting; a slot whose queries
+ * are not available yet keeps the timings of the last completed frame.
+ */
+class VkProfiler
+{
+public:
+    /**
+     * @brief Creates the query pools for all frame slots.
+     *
+     * @param device The logical device.
+     * @param physicalDevice The physical device the device was created from.
+     * @param queueFamilyIndex The queue family the command buffers are submitted to.
+     * @param frameCount The number of frame slots.
+     * @param maxScopes The maximum number of timestamp scopes per frame.
+     * @param pipelineStatistics Whether pipeline statistics queries should be collected.
+     * @return False if the queue family does not support timestamps.
+     */
+    bool create(VkDevice device, VkPhysicalDevice physicalDevice, uint32_t queueFamilyIndex, uint32_t frameCount, uint32_t maxScopes, bool pipelineStatistics);
+
+    /**
+     * @brief Destroys all query pools.
+     */
+    void destroy();
+
+    /**
+     * @brief Checks if timestamps can be written.
+     *
+     * @return True if timestamp queries are supported.
+     */
+    bool isSupported() const;
+
+    /**
+     * @brief Checks if pipeline statistics are collected.
+     *
+     * @return True if pipeline statistics queries are enabled.
+     */
+    bool hasStatistics() const;
+
+    /**
+     * @brief Resets the queries of a frame slot. Must be recorded outside of a render pass.
+     *
+     * @param commandBuffer The command buffer of the frame slot.
+     * @param frame The frame slot.
+     */
+    void beginFrame(VkCommandBuffer commandBuffer, uint32_t frame);
+
+    /**
+     * @brief Writes the start timestamp of a named scope.
+     *
+     * @param commandBuffer The command buffer of the frame slot.
+     * @param frame The frame slot.
+     * @param name The name of the scope.
+     * @return The index of the scope, or UINT32_MAX if no timestamp was written.
+     */
+    uint32_t beginScope(VkCommandBuffer commandBuffer, uint32_t frame, const char *name);
+
+    /**
+     * @brief Writes the end timestamp of a scope.
+     *
+     * @param commandBuffer The command buffer of the frame slot.
+     * @param frame The frame slot.
+     * @param scope The index returned by beginScope.
+     */
+    void endScope(VkCommandBuffer commandBuffer, uint32_t frame, uint32_t scope);
+
+    /**
+     * @brief Begins the pipeline statistics query of a frame slot.
+     *
+     * @param commandBuffer The command buffer of the frame slot.
+     * @param frame The frame slot.
+     */
+    void beginStatistics(VkCommandBuffer commandBuffer, uint32_t frame);
+
+    /**
+     * @brief Ends the pipeline statistics query of a frame slot.
+     *
+     * @param commandBuffer The command buffer of the frame slot.
+     * @param frame The frame slot.
+     */
+    void endStatistics(VkCommandBuffer commandBuffer, uint32_t frame);
+
+    /**
+     * @brief Marks a frame slot as submitted, its queries may be read afterwards.
+     *
+     * @param frame The frame slot.
+     */
+    void submitted(uint32_t frame);
+
+    /**
+     * @brief Reads the results of a frame slot without waiting.
+     *
+     * @param frame The frame slot.
+     * @return True if new results were available.
+     */
+    bool collect(uint32_t frame);
+
+    /**
+     * @brief Retrieves the scope names in recording order.
+     *
+     * @return The scope names.
+     */
+    const std::vector<std::string> &getScopeNames() const;
+
+    /**
+     * @brief Retrieves the scope durations of the last completed frame in milliseconds.
+     *
+     * @return The scope durations.
+     */
+    const std::vector<double> &getTimings() const;
+
+    /**
+     * @brief Retrieves the pipeline statistics of the last completed frame.
+     *
+     * The counters are input assembly vertices, vertex shader invocations, clipping primitives,
+     * fragment shader invocations and compute shader invocations.
+     *
+     * @return The pipeline statistics.
+     */
+    const std::vector<uint64_t> &getStatistics() const;
+
+private:
+    struct Frame
+    {
+        VkQueryPool timestampPool = VK_NULL_HANDLE;
+        VkQueryPool statisticsPool = VK_NULL_HANDLE;
+        std::vector<uint32_t> scopes;
+        bool submitted = false;
+    };
+
+    uint32_t registerScope(const char *name);
+
+    VkDevice device = VK_NULL_HANDLE;
+    std::vector<Frame> frames;
+    uint32_t maxScopes = 0;
+    uint64_t timestampMask = 0;
+    double timestampPeriod = 0.0;
+    bool statistics = false;
+
+    std::vector<std::string> scopeNames;
+    std::vector<double> timings;
+    std::vector<uint64_t> statisticsResults;
+};
+
+#endif // !VK_PROFILER_HPP
@@ -0,0 +1,312 @@
+/**
+ * @file VkRenderGraph.hpp
+ * @author Lenard Büsing (nodedev74@gmail.com)
+ * @brief Frame passes with barriers, layout transitions and transient images derived from their resource accesses.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2023 Lenard Büsing
+ *
+ */
+
+#ifndef VK_RENDER_GRAPH_HPP
+#define VK_RENDER_GRAPH_HPP
+
+#include "vulkan/VkMemoryTracker.hpp"
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+/**
+ * @brief The stages, accesses and image layout of a resource access. Stages and accesses use the
+ * synchronization2 flags; without synchronization2 only the flags that exist in both are allowed.
+ */
+struct RenderGraphState
+{
+    VkPipelineStageFlags2KHR stages = 0;
+    VkAccessFlags2KHR access = 0;
+    VkImageLayout layout = VK_IMAGE_LAYOUT_UNDEFINED;
+};
+
+/**
+ * @brief Records the passes of a frame with the barriers their resource accesses need.
+ *
+ * Passes are declared once, in execution order, with the resources they read and write. Every
+ * frame the graph culls the passes that are disabled or whose writes neither an output nor a
+ * kept later pass reads, and before each remaining pass records one barrier batch for the
+ * hazards against the last accesses: reads wait for the last write only if their stages or
+ * accesses have not seen it yet, writes also wait for the reads since, and images change their
+ * layout where an access needs another one. Buffers are ordered with global memory barriers.
+ * Outputs are brought into their final state at the end of the frame.
+ *
+ * Imported resources carry their state across frames and may hold one handle per frame slot.
+ * Transient images belong to the graph, are only valid between their first and last pass of a
+ * frame and share memory with the transients whose pass ranges do not overlap. All frame slots
+ * use the same transients, a transient waits at its first access for every earlier use of its
+ * memory. State is tracked at record time, so frames have to be submitted in the order they are
+ * recorded, or be recorded again from the same steady state.
+ */
+class VkRenderGraph
+{
+public:
+    /**
+     * @brief Prepares the graph for a device.
+     *
+     * @param device The logical device.
+     * @param memoryTracker The allocator of the device memory, it must outlive this object.
+     * @param synchronization2 True to record vkCmdPipelineBarrier2KHR, the device must have the feature enabled.
+     */
+    void create(VkDevice device, VkMemoryTracker &memoryTracker, bool synchronization2);
+
+    /**
+     * @brief Destroys the transient images and their memory and forgets all passes and resources.
+     */
+    void destroy();
+
+    /**
+     * @brief Declares a buffer owned outside of the graph. Buffers are ordered by global memory
+     * barriers, so no handle is needed.
+     *
+     * @param name The name of the resource.
+     * @param slotCount The number of frame slots with a buffer of their own, 1 for a shared buffer.
+     * @param state The state the previous frame leaves the buffer in.
+     * @return The resource index.
+     */
+    uint32_t importBuffer(const char *name, uint32_t slotCount, const RenderGraphState &state);
+
+    /**
+     * @brief Declares images owned outside of the graph, one per frame slot or one shared image.
+     *
+     * @param name The name of the resource.
+     * @param images The image of every frame slot, VK_NULL_HANDLE where not created yet.
+     * @param range The subresources accessed.
+     * @param state The state the previous frame leaves the images in.
+     * @return The resource index.
+     */
+    uint32_t importImage(const char *name, const std::vector<VkImage> &images, const VkImageSubresourceRange &range, const RenderGraphState &state);
+
+    /**
+     * @brief Replaces the image of a frame slot of an imported image resource.
+     *
+     * @param resource The resource index.
+     * @param slot The frame slot.
+     * @param image The image.
+     * @param range The subresources accessed.
+     */
+    void setImage(uint32_t resource, uint32_t slot, VkImage image, const VkImageSubresourceRange &range);
+
+    /**
+     * @brief Declares a transient image, created by allocate().
+     *
+     * @param name The name of the resource.
+     * @param createInfo The image description.
+     * @param aspect The aspect of the image view.
+     * @return The resource index.
+     */
+    uint32_t createImage(const char *name, const VkImageCreateInfo &createInfo, VkImageAspectFlags aspect);
+
+    /**
+     * @brief Appends a pass.
+     *
+     * @param name The name of the pass.
+     * @param record Records the commands of the pass for a frame slot.
+     * @return The pass index.
+     */
+    uint32_t addPass(const char *name, std::function<void(VkCommandBuffer, uint32_t)> record);
+
+    /**
+     * @brief Declares a read of a pass.
+     *
+     * @param pass The pass index.
+     * @param resource The resource index.
+     * @param state The stages, accesses and layout of the read.
+     */
+    void read(uint32_t pass, uint32_t resource, const RenderGraphState &state);
+
+    /**
+     * @brief Declares a write of a pass.
+     *
+     * @param pass The pass index.
+     * @param resource The resource index.
+     * @param state The stages, accesses and layout of the write.
+     * @param discard True if the pass overwrites the whole resource, so images start from an undefined layout.
+     */
+    void write(uint32_t pass, uint32_t resource, const RenderGraphState &state, bool discard);
+
+    /**
+     * @brief Marks a resource as read after the frame, which keeps the passes writing it.
+     *
+     * @param resource The resource index.
+     * @param output False to let the passes writing the resource be culled.
+     */
+    void setOutput(uint32_t resource, bool output);
+
+    /**
+     * @brief Sets the state an output is brought into at the end of the frames that access it.
+     *
+     * @param resource The resource index.
+     * @param finalState The final state, no stages to leave the resource as is.
+     */
+    void setFinalState(uint32_t resource, const RenderGraphState &finalState);
+
+    /**
+     * @brief Enables or disables a pass for the following frames.
+     *
+     * @param pass The pass index.
+     * @param enabled False to skip the pass.
+     */
+    void setEnabled(uint32_t pass, bool enabled);
+
+    /**
+     * @brief Enables or disables the access of a pass to a resource for the following frames.
+     *
+     * A disabled read neither keeps the passes writing the resource nor waits for them.
+     *
+     * @param pass The pass index.
+     * @param resource The resource index.
+     * @param enabled False to ignore the access.
+     */
+    void setAccessEnabled(uint32_t pass, uint32_t resource, bool enabled);
+
+    /**
+     * @brief Places the transient images in memory by the pass ranges of all declared passes and
+     * creates them with their views. Passes must not be added afterwards.
+     *
+     * @return The result of the first failing Vulkan call, or VK_SUCCESS.
+     */
+    VkResult allocate();
+
+    /**
+     * @brief Retrieves the view of a transient image.
+     *
+     * @param resource The resource index.
+     * @return The image view.
+     */
+    VkImageView getImageView(uint32_t resource) const;
+
+    /**
+     * @brief Records the kept passes of a frame with their barriers.
+     *
+     * @param commandBuffer The command buffer of the frame slot.
+     * @param frame The frame slot.
+     */
+    void execute(VkCommandBuffer commandBuffer, uint32_t frame);
+
+    /**
+     * @brief Checks whether barriers are recorded with synchronization2.
+     *
+     * @return True for vkCmdPipelineBarrier2KHR.
+     */
+    bool isSynchronization2Enabled() const;
+
+    /**
+     * @brief Retrieves the number of memory and image barriers the last executed frame recorded.
+     *
+     * @return The barrier count.
+     */
+    uint32_t getBarrierCount() const;
+
+    /**
+     * @brief Retrieves the number of barrier commands the last executed frame recorded.
+     *
+     * @return The barrier command count.
+     */
+    uint32_t getBarrierBatchCount() const;
+
+    /**
+     * @brief Retrieves the number of enabled passes the last executed frame culled.
+     *
+     * @return The culled pass count.
+     */
+    uint32_t getCulledPassCount() const;
+
+    /**
+     * @brief Retrieves the size the transient images would take without aliasing.
+     *
+     * @return The size in bytes.
+     */
+    VkDeviceSize getTransientBytes() const;
+
+    /**
+     * @brief Retrieves the size of the memory the transient images share.
+     *
+     * @return The size in bytes.
+     */
+    VkDeviceSize getTransientMemory() const;
+
+private:
+    struct SlotState
+    {
+        VkImage image = VK_NULL_HANDLE;
+        VkImageSubresourceRange range{};
+        VkPipelineStageFlags2KHR writeStages = 0;
+        VkAccessFlags2KHR writeAccess = 0;
+        VkPipelineStageFlags2KHR readStages = 0;
+        VkAccessFlags2KHR readAccess = 0;
+        VkImageLayout layout = VK_IMAGE_LAYOUT_UNDEFINED;
+        bool touched = false;
+    };
+
+    struct Resource
+    {
+        std::string name;
+        bool image = false;
+        bool transient = false;
+        std::vector<SlotState> slots;
+        bool output = false;
+        RenderGraphState finalState;
+
+        VkImageCreateInfo createInfo{};
+        VkImageAspectFlags aspect = 0;
+        VkImageView view = VK_NULL_HANDLE;
+        VkMemoryRequirements memoryRequirements{};
+        VkDeviceSize offset = 0;
+        uint32_t firstPass = 0;
+        uint32_t lastPass = 0;
+        VkPipelineStageFlags2KHR memoryStages = 0;
+        VkAccessFlags2KHR memoryAccess = 0;
+        VkPipelineStageFlags2KHR aliasStages = 0;
+        VkAccessFlags2KHR aliasAccess = 0;
+    };
+
+    struct Access
+    {
+        uint32_t resource;
+        RenderGraphState state;
+        bool write;
+        bool discard;
+        bool enabled = true;
+    };
+
+    struct Pass
+    {
+        std::string name;
+        std::function<void(VkCommandBuffer, uint32_t)> record;
+        std::vector<Access> accesses;
+        bool enabled = true;
+    };
+
+    void addAccess(uint32_t pass, uint32_t resource, const RenderGraphState &state, bool write, bool discard);
+    void transition(uint32_t resource, uint32_t slot, const RenderGraphState &state, bool write, bool discard);
+    void flush(VkCommandBuffer commandBuffer);
+
+    VkDevice device = VK_NULL_HANDLE;
+    VkMemoryTracker *memoryTracker = nullptr;
+    bool synchronization2 = false;
+
+    std::vector<Resource> resources;
+    std::vector<Pass> passes;
+    VkDeviceMemory transientMemory = VK_NULL_HANDLE;
+    VkDeviceSize transientMemorySize = 0;
+    VkDeviceSize transientBytes = 0;
+
+    VkMemoryBarrier2KHR memoryBarrier{};
+    std::vector<VkImageMemoryBarrier2KHR> imageBarriers;
+    uint32_t barrierCount = 0;
+    uint32_t barrierBatchCount = 0;
+    uint32_t culledPassCount = 0;
+};
+
+#endif // !VK_RENDER_GRAPH_HPP
@@ -0,0 +1,182 @@
+/**
+ * @file VkSkinning.hpp
+ * @author Lenard Büsing (nodedev74@gmail.com)
+ * @brief Compute shader skinning of skin instances into a shared vertex buffer.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2023 Lenard Büsing
+ *
+ */
+
+#ifndef VK_SKINNING_HPP
+#define VK_SKINNING_HPP
+
+#include "vulkan/VkMemoryTracker.hpp"
+
+#include <cstdint>
+#include <vector>
+
+class Skin;
+class SceneGraph;
+
+/**
+ * @brief Skins all instances in one indirect compute dispatch per frame.
+ *
+ * Bind positions and packed influences of every skin are uploaded once and shared by its
+ * instances. Each frame slot owns host visible joint matrix, instance and dispatch argument
+ * buffers, so the command buffers are recorded once and instances can be added afterwards.
+ * Workgroup y selects the instance, x the vertex range within it.
+ */
+class VkSkinning
+{
+public:
+    /**
+     * @brief Creates the buffers, descriptor sets and compute pipeline.
+     *
+     * @param device The logical device.
+     * @param memoryTracker The allocator of the device memory, it must outlive this object.
+     * @param shader The skinning compute shader module.
+     * @param frameCount The number of frame slots.
+     * @param vertexCapacity The maximum number of bind vertices of all skins.
+     * @param skinnedVertexCapacity The maximum number of skinned vertices of all instances.
+     * @param jointCapacity The maximum number of joint matrices of all instances.
+     * @param instanceCapacity The maximum number of instances.
+     * @return The result of the first failing Vulkan call, or VK_SUCCESS.
+     */
+    VkResult create(VkDevice device, VkMemoryTracker &memoryTracker, VkShaderModule shader, uint32_t frameCount,
+                    uint32_t vertexCapacity, uint32_t skinnedVertexCapacity, uint32_t jointCapacity, uint32_t instanceCapacity);
+
+    /**
+     * @brief Destroys all Vulkan objects.
+     */
+    void destroy();
+
+    /**
+     * @brief Uploads the bind pose of a skin.
+     *
+     * @param skin The skin. It is referenced for the joint matrices and has to outlive its instances.
+     * @return The skin id, or -1 if the vertex capacity is exhausted.
+     */
+    int32_t addSkin(const Skin &skin);
+
+    /**
+     * @brief Adds an instance of an uploaded skin.
+     *
+     * @param skin The skin id.
+     * @param nodeOffset The offset added to the joint nodes of the skin.
+     * @return The instance id, or -1 if a capacity is exhausted.
+     */
+    int32_t addInstance(uint32_t skin, uint32_t nodeOffset);
+
+    /**
+     * @brief Writes the joint matrices, instances and dispatch size of a frame slot.
+     *
+     * @param frame The frame slot, its previous submission must have completed.
+     * @param graph The updated scene graph, or nullptr to skip skinning in this frame.
+     */
+    void update(uint32_t frame, const SceneGraph *graph);
+
+    /**
+     * @brief Records the skinning dispatch. Must be recorded outside of a render pass.
+     *
+     * The caller orders the output writes against earlier and later reads of the vertices.
+     *
+     * @param commandBuffer The command buffer of the frame slot.
+     * @param frame The frame slot.
+     */
+    void record(VkCommandBuffer commandBuffer, uint32_t frame);
+
+    /**
+     * @brief Retrieves the buffer receiving the skinned positions, four floats per vertex.
+     *
+     * @return The output buffer.
+     */
+    VkBuffer getOutputBuffer() const;
+
+    /**
+     * @brief Retrieves the first output vertex of an instance.
+     *
+     * @param instance The instance id.
+     * @return The vertex offset into the output buffer.
+     */
+    uint32_t getOutputOffset(uint32_t instance) const;
+
+    /**
+     * @brief Retrieves the number of vertices of an instance.
+     *
+     * @param instance The instance id.
+     * @return The vertex count.
+     */
+    uint32_t getVertexCount(uint32_t instance) const;
+
+    /**
+     * @brief Retrieves the number of instances.
+     *
+     * @return The instance count.
+     */
+    uint32_t getInstanceCount() const;
+
+private:
+    struct SkinRange
+    {
+        const Skin *skin;
+        uint32_t baseVertex;
+    };
+
+    struct Instance
+    {
+        uint32_t skin;
+        uint32_t nodeOffset;
+        uint32_t baseJoint;
+        uint32_t baseOutput;
+    };
+
+    struct Frame
+    {
+        VkBuffer jointBuffer = VK_NULL_HANDLE;
+        VkBuffer instanceBuffer = VK_NULL_HANDLE;
+        VkBuffer dispatchBuffer = VK_NULL_HANDLE;
+        VkDescriptorSet descriptorSet = VK_NULL_HANDLE;
+        void *jointPointer = nullptr;
+        void *instancePointer = nullptr;
+        void *dispatchPointer = nullptr;
+    };
+
+    VkResult createBuffer(VkDeviceSize size, VkBufferUsageFlags usage, VkBuffer &buffer);
+    VkResult allocate(const std::vector<VkBuffer> &buffers, VkMemoryPropertyFlags preferred, VkMemoryPropertyFlags required,
+                      MemoryCategory category, VkDeviceMemory &memory, std::vector<VkDeviceSize> &offsets);
+
+    VkDevice device = VK_NULL_HANDLE;
+    VkMemoryTracker *memoryTracker = nullptr;
+
+    VkBuffer positionBuffer = VK_NULL_HANDLE;
+    VkBuffer influenceBuffer = VK_NULL_HANDLE;
+    VkDeviceMemory bindMemory = VK_NULL_HANDLE;
+    char *bindPointer = nullptr;
+    VkDeviceSize influenceOffset = 0;
+
+    VkBuffer outputBuffer = VK_NULL_HANDLE;
+    VkDeviceMemory outputMemory = VK_NULL_HANDLE;
+
+    std::vector<Frame> frames;
+    VkDeviceMemory frameMemory = VK_NULL_HANDLE;
+
+    VkDescriptorPool descriptorPool = VK_NULL_HANDLE;
+    VkDescriptorSetLayout descriptorSetLayout = VK_NULL_HANDLE;
+    VkPipelineLayout pipelineLayout = VK_NULL_HANDLE;
+    VkPipeline pipeline = VK_NULL_HANDLE;
+
+    uint32_t vertexCapacity = 0;
+    uint32_t skinnedVertexCapacity = 0;
+    uint32_t jointCapacity = 0;
+    uint32_t instanceCapacity = 0;
+
+    std::vector<SkinRange> skins;
+    std::vector<Instance> instances;
+    uint32_t vertexCount = 0;
+    uint32_t skinnedVertexCount = 0;
+    uint32_t jointCount = 0;
+};
+
+#endif // !VK_SKINNING_HPP
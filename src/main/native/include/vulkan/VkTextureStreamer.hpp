@@ -0,0 +1,173 @@
+/**
+ * @file VkTextureStreamer.hpp
+ * @author Lenard Büsing (nodedev74@gmail.com)
+ * @brief Mip level streaming of textures within a residency budget.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2023 Lenard Büsing
+ *
+ */
+
+#ifndef VK_TEXTURE_STREAMER_HPP
+#define VK_TEXTURE_STREAMER_HPP
+
+#include "vulkan/VkBindless.hpp"
+
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Keeps the mip levels of streamed textures resident that the visible objects need.
+ *
+ * A streamed texture is uploaded with its mip tail only, the levels whose larger side is at
+ * most the tail size, and keeps its full mip chain on the host. Every frame the renderer
+ * requests the level each visible object needs from its projected texel density. Textures
+ * coarser than requested are refined, the largest deficit first, until the bytes uploaded in
+ * the frame reach the bandwidth. When the resident levels would exceed the budget, the least
+ * recently requested textures first drop their unneeded levels, down to their tail. Mip tails
+ * are never evicted, so the budget cannot be met if the tails alone exceed it. Under memory
+ * pressure evict() drops levels that are still needed and lowers the budget to what remains.
+ * It is called by the memory tracker at the frame boundary, so it never replaces textures in
+ * the middle of an allocation or while a frame is recorded.
+ */
+class VkTextureStreamer
+{
+public:
+    /**
+     * @brief Sets the limits of the streamer.
+     *
+     * @param budget The maximum number of resident bytes of streamed textures.
+     * @param bandwidth The maximum number of bytes uploaded per frame, at least one level is always uploaded.
+     * @param tailSize The larger side of the finest level of the mip tail.
+     */
+    void setLimits(uint64_t budget, uint64_t bandwidth, uint32_t tailSize);
+
+    /**
+     * @brief Uploads the mip tails of textures and takes over their host copies.
+     *
+     * @param bindless The owner of the textures.
+     * @param queue The queue to submit the copies to.
+     * @param commandPool The command pool of the queue.
+     * @param textureData The textures with their full mip chains.
+     * @param indices Receives the consecutive texture indices.
+     * @return The result of VkBindless::addTextures().
+     */
+    VkResult addTextures(VkBindless &bindless, VkQueue queue, VkCommandPool commandPool, std::vector<TextureData> &&textureData, uint32_t *indices);
+
+    /**
+     * @brief Releases the host copies, the textures stay with their owner.
+     */
+    void destroy();
+
+    /**
+     * @brief Checks whether a texture is streamed.
+     *
+     * @param texture The texture index.
+     * @return True if the texture was added through this streamer.
+     */
+    bool isStreamed(uint32_t texture) const;
+
+    /**
+     * @brief Retrieves the number of streamed textures.
+     *
+     * @return The texture count.
+     */
+    uint32_t getTextureCount() const;
+
+    /**
+     * @brief Starts collecting the requests of a new frame.
+     */
+    void beginFrame();
+
+    /**
+     * @brief Requests the level of a streamed texture that an object needs.
+     *
+     * @param texture The texture index, must be streamed.
+     * @param pixelsPerRepeat The number of screen pixels one repetition of the texture covers.
+     */
+    void request(uint32_t texture, float pixelsPerRepeat);
+
+    /**
+     * @brief Refines and evicts levels for the requests of the frame.
+     *
+     * Changed textures are replaced without waiting for the queue, see VkBindless::updateTextures().
+     * If the memory budget refuses the new images, the resident levels stay until the memory
+     * tracker has evicted the missing bytes at the next frame boundary.
+     *
+     * @param bindless The owner of the textures.
+     * @param queue The queue to submit the copies to.
+     * @param commandPool The command pool of the queue.
+     * @return The result of VkBindless::updateTextures() unless the memory budget refused it, or VK_SUCCESS.
+     */
+    VkResult update(VkBindless &bindless, VkQueue queue, VkCommandPool commandPool);
+
+    /**
+     * @brief Drops resident levels down to the mip tail, least recently requested textures first,
+     * and lowers the budget to the remaining resident bytes so they are not refined again.
+     *
+     * Must be called on the thread that records the frames, between frames.
+     *
+     * @param bindless The owner of the textures.
+     * @param queue The queue to submit the copies to.
+     * @param commandPool The command pool of the queue.
+     * @param bytes The number of bytes to free.
+     * @return The number of bytes of the dropped levels, 0 if the textures could not be replaced.
+     */
+    uint64_t evict(VkBindless &bindless, VkQueue queue, VkCommandPool commandPool, uint64_t bytes);
+
+    /**
+     * @brief Retrieves the bytes of the resident levels of all streamed textures.
+     *
+     * @return The size in bytes.
+     */
+    uint64_t getResidentBytes() const;
+
+    /**
+     * @brief Retrieves the bytes uploaded from the host since the textures were added, tails excluded.
+     *
+     * @return The size in bytes.
+     */
+    uint64_t getStreamedBytes() const;
+
+    /**
+     * @brief Retrieves the number of levels evicted since the textures were added.
+     *
+     * @return The level count.
+     */
+    uint64_t getEvictedLevelCount() const;
+
+    /**
+     * @brief Retrieves the number of textures requested in the last frame whose resident level is
+     * coarser than requested.
+     *
+     * @return The texture count.
+     */
+    uint32_t getReducedQualityCount() const;
+
+private:
+    struct StreamedTexture
+    {
+        TextureData data;
+        uint32_t texture;
+        uint32_t tailLevel;
+        uint32_t residentLevel;
+        uint32_t requestedLevel;
+        uint64_t lastRequestFrame;
+    };
+
+    uint64_t getLevelBytes(const StreamedTexture &streamed, uint32_t firstLevel, uint32_t endLevel) const;
+
+    std::vector<StreamedTexture> streamedTextures;
+    std::vector<int32_t> streamedIndices;
+    uint64_t budget = 256ull << 20;
+    uint64_t bandwidth = 16ull << 20;
+    uint32_t tailSize = 64;
+    uint64_t frame = 0;
+    uint64_t residentBytes = 0;
+    uint64_t streamedBytes = 0;
+    uint64_t evictedLevelCount = 0;
+    uint32_t reducedQualityCount = 0;
+};
+
+#endif // !VK_TEXTURE_STREAMER_HPP
@@ -0,0 +1,146 @@
+/**
+ * @file AnimationSampler.cpp
+ * @author Lenard Büsing (nodedev74@gmail.com)
+ * @brief Implementation of the animation playback state.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2023 Lenard Büsing
+ *
+ */
+
+#include "com_github_nodedev74_jfbx_anim_AnimationSampler.h"
+#include <jni.h>
+
+#include "anim/AnimationSampler.hpp"
+#include "anim/AnimationStack.hpp"
+#include "scene/SceneGraph.hpp"
+#include "core/ThreadPool.hpp"
+#include "core/Tracer.hpp"
+
+#include <algorithm>
+
+namespace
+{
+    constexpr uint32_t SAMPLE_GRAIN = 1024;
+
+    template <typename T>
+    T *getNativePointer(JNIEnv *env, jobject obj, const char *field)
+    {
+        jclass cls = env->GetObjectClass(obj);
+        jfieldID fieldID = env->GetFieldID(cls, field, "J");
+        return reinterpret_cast<T *>(env->GetLongField(obj, fieldID));
+    }
+}
+
+AnimationSampler::AnimationSampler(const AnimationStack &stack)
+    : stack(stack), cursors(stack.getChannelCount(), 0), values(stack.getChannelCount(), 0.0f)
+{
+}
+
+void AnimationSampler::sample(float time, ThreadPool *pool)
+{
+    TRACE_ZONE("AnimationSampler.sample");
+
+    uint32_t channelCount = stack.getChannelCount();
+    if (pool == nullptr)
+    {
+        stack.sample(time, 0, channelCount, cursors.data(), values.data());
+        return;
+    }
+
+    pool->parallelFor(channelCount, SAMPLE_GRAIN, [&](uint32_t begin, uint32_t end)
+                      { stack.sample(time, begin, end, cursors.data(), values.data()); });
+}
+
+uint32_t AnimationSampler::getChannelCount() const
+{
+    return static_cast<uint32_t>(values.size());
+}
+
+const float *AnimationSampler::getValues() const
+{
+    return values.data();
+}
+
+void AnimationSampler::apply(SceneGraph &graph) const
+{
+    TRACE_ZONE("AnimationSampler.apply");
+
+    uint32_t nodeCount = graph.getNodeCount();
+    for (uint32_t channel = 0; channel < values.size(); channel++)
+    {
+        uint32_t node = stack.getNode(channel);
+        if (node < nodeCount)
+        {
+            graph.setProperty(node, stack.getProperty(channel), values[channel]);
+        }
+    }
+}
+
+/**
+ * @brief JNI function to create a sampler for an animation stack.
+ *
+ * @param env The JNI environment.
+ * @param cls The Java class.
+ * @param stack The Java animation stack.
+ * @return The native sampler pointer.
+ */
+JNIEXPORT jlong JNICALL Java_com_github_nodedev74_jfbx_anim_AnimationSampler_create(JNIEnv *env, jclass cls, jobject stack)
+{
+    return reinterpret_cast<jlong>(new AnimationSampler(*getNativePointer<AnimationStack>(env, stack, "stackPtr")));
+}
+
+/**
+ * @brief JNI function to sample all channels.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ * @param time The time in seconds.
+ * @param parallel True to split the channels across the shared thread pool.
+ */
+JNIEXPORT void JNICALL Java_com_github_nodedev74_jfbx_anim_AnimationSampler_sample(JNIEnv *env, jobject obj, jfloat time, jboolean parallel)
+{
+    getNativePointer<AnimationSampler>(env, obj, "samplerPtr")->sample(time, parallel ? &ThreadPool::shared() : nullptr);
+}
+
+/**
+ * @brief JNI function to copy the values of the last sample.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ * @param out The array receiving one value per channel.
+ */
+JNIEXPORT void JNICALL Java_com_github_nodedev74_jfbx_anim_AnimationSampler_getValues(JNIEnv *env, jobject obj, jfloatArray out)
+{
+    AnimationSampler *sampler = getNativePointer<AnimationSampler>(env, obj, "samplerPtr");
+    jsize count = std::min<jsize>(env->GetArrayLength(out), static_cast<jsize>(sampler->getChannelCount()));
+    env->SetFloatArrayRegion(out, 0, count, sampler->getValues());
+}
+
+/**
+ * @brief JNI function to write the values of the last sample into a scene graph.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ * @param graph The Java scene graph.
+ */
+JNIEXPORT void JNICALL Java_com_github_nodedev74_jfbx_anim_AnimationSampler_apply(JNIEnv *env, jobject obj, jobject graph)
+{
+    getNativePointer<AnimationSampler>(env, obj, "samplerPtr")->apply(*getNativePointer<SceneGraph>(env, graph, "graphPtr"));
+}
+
+/**
+ * @brief JNI function to release the native sampler.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ */
+JNIEXPORT void JNICALL Java_com_github_nodedev74_jfbx_anim_AnimationSampler_destroy(JNIEnv *env, jobject obj)
+{
+    delete getNativePointer<AnimationSampler>(env, obj, "samplerPtr");
+
+    jclass cls = env->GetObjectClass(obj);
+    jfieldID fieldID = env->GetFieldID(cls, "samplerPtr", "J");
+    env->SetLongField(obj, fieldID, 0);
+}
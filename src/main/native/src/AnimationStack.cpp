@@ -0,0 +1,1085 @@
+/**
+ * @file AnimationStack.cpp
+ * @author Lenard Büsing (nodedev74@gmail.com)
+ * @brief Implementation of the animation key layout and the SIMD sampler.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2023 Lenard Büsing
+ *
+ */
+
+#include "com_github_nodedev74_jfbx_anim_AnimationStack.h"
+#include <jni.h>
+
+#include "anim/AnimationStack.hpp"
+#include "fbx/FbxScene.hpp"
+#include "core/Tracer.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define ANIMATION_STACK_SSE 1
+#endif
+
+namespace
+{
+    constexpr uint32_t LINEAR_SEEK_STEPS = 4;
+    constexpr int32_t FBX_INTERPOLATION_CONSTANT = 0x00000002;
+    constexpr int32_t FBX_INTERPOLATION_CUBIC = 0x00000008;
+    constexpr char CACHE_MAGIC[8] = {'J', 'F', 'B', 'X', 'A', 'N', 'I', 'M'};
+    constexpr uint32_t CACHE_VERSION = 1;
+
+    /**
+     * @brief Evaluates a cubic Hermite segment, tangents are scaled by the segment duration.
+     */
+    inline float hermite(float u, float v0, float v1, float m0, float m1)
+    {
+        float u2 = u * u;
+        float u3 = u2 * u;
+        float h00 = 2.0f * u3 - 3.0f * u2 + 1.0f;
+        float h10 = u3 - 2.0f * u2 + u;
+        float h11 = u3 - u2;
+        return v0 * h00 + m0 * h10 + v1 * (1.0f - h00) + m1 * h11;
+    }
+
+    inline float keyTime(const AnimationStack::PackedKey &key)
+    {
+        return key.time;
+    }
+
+    inline float keyTime(const AnimationStack::QuantizedKey &key)
+    {
+        return static_cast<float>(key.time);
+    }
+
+    /**
+     * @brief Evaluates the original keys inside segment i at the normalized position u.
+     */
+    float evaluateSegment(const std::vector<AnimationKey> &keys, size_t i, float u)
+    {
+        const AnimationKey &key = keys[i];
+        const AnimationKey &next = keys[i + 1];
+        switch (key.interpolation)
+        {
+        case AnimationInterpolation::Constant:
+            return key.value;
+        case AnimationInterpolation::Linear:
+            return key.value + (next.value - key.value) * u;
+        default:
+        {
+            float duration = next.time - key.time;
+            return hermite(u, key.value, next.value, key.rightSlope * duration, key.nextLeftSlope * duration);
+        }
+        }
+    }
+
+    /**
+     * @brief Estimates the slope of the original curve at key i, from the right or from the left.
+     */
+    float curveSlope(const std::vector<AnimationKey> &keys, size_t i, bool right)
+    {
+        size_t segment = right ? i : i - 1;
+        if (keys[segment].interpolation == AnimationInterpolation::Cubic)
+        {
+            return right ? keys[segment].rightSlope : keys[segment].nextLeftSlope;
+        }
+
+        // Baked curves store one linear key per frame, their central difference follows the sampled motion
+        size_t previous = i > 0 ? i - 1 : i;
+        size_t next = i + 1 < keys.size() ? i + 1 : i;
+        return (keys[next].value - keys[previous].value) / (keys[next].time - keys[previous].time);
+    }
+
+    /**
+     * @brief Checks if a single segment from key a to key b approximates the original keys in between.
+     */
+    bool fitsSegment(const std::vector<AnimationKey> &keys, size_t a, size_t b, bool cubic, float slopeA, float slopeB, float tolerance)
+    {
+        const AnimationKey &first = keys[a];
+        const AnimationKey &last = keys[b];
+        float duration = last.time - first.time;
+
+        for (size_t i = a; i < b; i++)
+        {
+            if (keys[i].interpolation == AnimationInterpolation::Constant)
+            {
+                return false;
+            }
+
+            for (int half = i == a ? 1 : 0; half < 2; half++)
+            {
+                float u = half == 0 ? 0.0f : 0.5f;
+                float time = keys[i].time + (keys[i + 1].time - keys[i].time) * u;
+                float original = evaluateSegment(keys, i, u);
+                float s = (time - first.time) / duration;
+                float approximation = cubic ? hermite(s, first.value, last.value, slopeA * duration, slopeB * duration)
+                                            : first.value + (last.value - first.value) * s;
+                if (std::fabs(approximation - original) > tolerance)
+                {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief Tries a linear and then a cubic segment from key a to key b.
+     *
+     * @return True if one of them fits, key receives the interpolation and slopes of the segment.
+     */
+    bool fitSpan(const std::vector<AnimationKey> &keys, size_t a, size_t b, float tolerance, AnimationKey &key)
+    {
+        if (fitsSegment(keys, a, b, false, 0.0f, 0.0f, tolerance))
+        {
+            key.interpolation = AnimationInterpolation::Linear;
+            return true;
+        }
+
+        float slopeA = curveSlope(keys, a, true);
+        float slopeB = curveSlope(keys, b, false);
+        if (fitsSegment(keys, a, b, true, slopeA, slopeB, tolerance))
+        {
+            key.interpolation = AnimationInterpolation::Cubic;
+            key.rightSlope = slopeA;
+            key.nextLeftSlope = slopeB;
+            return true;
+        }
+        return false;
+    }
+
+    template <typename T>
+    void writeValue(std::ofstream &file, const T &value)
+    {
+        file.write(reinterpret_cast<const char *>(&value), sizeof(T));
+    }
+
+    template <typename T>
+    void writeVector(std::ofstream &file, const std::vector<T> &values)
+    {
+        file.write(reinterpret_cast<const char *>(values.data()), values.size() * sizeof(T));
+    }
+
+    template <typename T>
+    void readValue(std::ifstream &file, T &value)
+    {
+        if (!file.read(reinterpret_cast<char *>(&value), sizeof(T)))
+        {
+            throw std::runtime_error("Unexpected end of animation cache");
+        }
+    }
+
+    template <typename T>
+    void readVector(std::ifstream &file, std::vector<T> &values, size_t count)
+    {
+        values.resize(count);
+        if (count > 0 && !file.read(reinterpret_cast<char *>(values.data()), count * sizeof(T)))
+        {
+            throw std::runtime_error("Unexpected end of animation cache");
+        }
+    }
+
+    /**
+     * @brief Converts the keys of an FBX curve, expanding the shared key attributes.
+     */
+    std::vector<AnimationKey> convertCurve(const FbxAnimationCurve &curve)
+    {
+        std::vector<AnimationKey> keys(curve.times.size());
+
+        size_t attribute = 0;
+        int32_t remaining = curve.attributeRefCounts.empty() ? 0 : curve.attributeRefCounts[0];
+        for (size_t i = 0; i < keys.size(); i++)
+        {
+            while (remaining <= 0 && attribute + 1 < curve.attributeRefCounts.size())
+            {
+                remaining = curve.attributeRefCounts[++attribute];
+            }
+            remaining--;
+
+            AnimationKey &key = keys[i];
+            key.time = static_cast<float>(static_cast<double>(curve.times[i]) / FBX_TICKS_PER_SECOND);
+            key.value = curve.values[i];
+
+            int32_t flags = attribute < curve.attributeFlags.size() ? curve.attributeFlags[attribute] : 0;
+            if (flags & FBX_INTERPOLATION_CONSTANT)
+            {
+                key.interpolation = AnimationInterpolation::Constant;
+            }
+            else if ((flags & FBX_INTERPOLATION_CUBIC) && attribute * 4 + 1 < curve.attributeData.size())
+            {
+                key.interpolation = AnimationInterpolation::Cubic;
+                key.rightSlope = curve.attributeData[attribute * 4];
+                key.nextLeftSlope = curve.attributeData[attribute * 4 + 1];
+            }
+        }
+        return keys;
+    }
+
+    void throwFbxError(JNIEnv *env, const char *what)
+    {
+        jclass exceptionClass = env->FindClass("com/github/nodedev74/jfbx/exception/FbxRuntimeError");
+        jmethodID constructorID = env->GetMethodID(exceptionClass, "<init>", "(Ljava/lang/String;)V");
+        jstring message = env->NewStringUTF(what);
+        jobject exceptionObject = env->NewObject(exceptionClass, constructorID, message);
+        env->Throw(static_cast<jthrowable>(exceptionObject));
+    }
+
+    std::string toString(JNIEnv *env, jstring string)
+    {
+        const char *chars = env->GetStringUTFChars(string, nullptr);
+        std::string result(chars);
+        env->ReleaseStringUTFChars(string, chars);
+        return result;
+    }
+
+    AnimationStack *getStack(JNIEnv *env, jobject obj)
+    {
+        jclass cls = env->GetObjectClass(obj);
+        jfieldID fieldID = env->GetFieldID(cls, "stackPtr", "J");
+        return reinterpret_cast<AnimationStack *>(env->GetLongField(obj, fieldID));
+    }
+}
+
+AnimationStack::AnimationStack(const std::string &name, float startTime, float endTime)
+    : name(name), startTime(startTime), endTime(endTime)
+{
+}
+
+AnimationStack *AnimationStack::fromScene(const FbxScene &scene, uint32_t stackIndex, float tolerance, bool quantize)
+{
+    const FbxAnimationStack &source = scene.getAnimationStacks()[stackIndex];
+    const std::vector<FbxAnimationCurve> &curves = scene.getAnimationCurves();
+
+    float startTime = static_cast<float>(static_cast<double>(source.localStart) / FBX_TICKS_PER_SECOND);
+    float endTime = static_cast<float>(static_cast<double>(source.localStop) / FBX_TICKS_PER_SECOND);
+    AnimationStack *stack = new AnimationStack(source.name, startTime, endTime);
+    stack->setTolerance(tolerance);
+
+    float firstKey = 0.0f, lastKey = 0.0f;
+    bool hasKeys = false;
+    for (const FbxAnimationChannel &channel : source.channels)
+    {
+        std::vector<AnimationKey> keys;
+        if (channel.curve >= 0)
+        {
+            keys = convertCurve(curves[channel.curve]);
+        }
+        if (!keys.empty())
+        {
+            firstKey = hasKeys ? std::min(firstKey, keys.front().time) : keys.front().time;
+            lastKey = hasKeys ? std::max(lastKey, keys.back().time) : keys.back().time;
+            hasKeys = true;
+        }
+        stack->addChannel(static_cast<uint32_t>(channel.model), channel.property, keys, channel.defaultValue);
+    }
+
+    if (endTime <= startTime && hasKeys)
+    {
+        stack->startTime = firstKey;
+        stack->endTime = lastKey;
+    }
+    if (quantize)
+    {
+        stack->quantize();
+    }
+    return stack;
+}
+
+AnimationStack *AnimationStack::load(const std::string &path)
+{
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open())
+    {
+        throw std::runtime_error("Failed to open animation cache: " + path);
+    }
+
+    char magic[sizeof(CACHE_MAGIC)];
+    uint32_t version = 0;
+    file.read(magic, sizeof(magic));
+    readValue(file, version);
+    if (std::memcmp(magic, CACHE_MAGIC, sizeof(CACHE_MAGIC)) != 0 || version != CACHE_VERSION)
+    {
+        throw std::runtime_error("Not an animation cache: " + path);
+    }
+
+    uint32_t nameLength = 0;
+    readValue(file, nameLength);
+    std::vector<char> name;
+    readVector(file, name, nameLength);
+
+    float startTime = 0.0f, endTime = 0.0f;
+    readValue(file, startTime);
+    readValue(file, endTime);
+    AnimationStack *stack = new AnimationStack(std::string(name.begin(), name.end()), startTime, endTime);
+
+    try
+    {
+        uint64_t keyCount = 0;
+        uint32_t channelCount = 0, storedKeyCount = 0;
+        uint8_t quantized = 0;
+        readValue(file, quantized);
+        readValue(file, keyCount);
+        readValue(file, channelCount);
+        readValue(file, storedKeyCount);
+        stack->keyCount = keyCount;
+        stack->quantized = quantized != 0;
+
+        readVector(file, stack->channelNodes, channelCount);
+        readVector(file, stack->channelProperties, channelCount);
+        readVector(file, stack->channelFirstKeys, channelCount);
+        readVector(file, stack->channelKeyCounts, channelCount);
+        readVector(file, stack->keySteps, storedKeyCount);
+        for (uint32_t channel = 0; channel < channelCount; channel++)
+        {
+            if (stack->channelKeyCounts[channel] == 0 ||
+                static_cast<uint64_t>(stack->channelFirstKeys[channel]) + stack->channelKeyCounts[channel] >= storedKeyCount)
+            {
+                throw std::runtime_error("Corrupt animation cache: " + path);
+            }
+        }
+
+        if (stack->quantized)
+        {
+            readValue(file, stack->timeOffset);
+            readValue(file, stack->timeScale);
+            readVector(file, stack->channelValueOffsets, channelCount);
+            readVector(file, stack->channelValueScales, channelCount);
+            readVector(file, stack->channelTangentScales, channelCount);
+            readVector(file, stack->quantizedKeys, storedKeyCount);
+        }
+        else
+        {
+            readVector(file, stack->keys, storedKeyCount);
+        }
+    }
+    catch (...)
+    {
+        delete stack;
+        throw;
+    }
+    return stack;
+}
+
+std::vector<AnimationKey> AnimationStack::reduceKeys(const std::vector<AnimationKey> &keys, float tolerance)
+{
+    if (tolerance <= 0.0f || keys.size() <= 2)
+    {
+        return keys;
+    }
+
+    std::vector<AnimationKey> reduced;
+    size_t last = keys.size() - 1;
+    size_t a = 0;
+    while (a < last)
+    {
+        AnimationKey key = keys[a];
+        size_t b = a + 1;
+
+        if (key.interpolation != AnimationInterpolation::Constant)
+        {
+            // Grow the span exponentially while it fits, then bisect between the last fit and the first miss
+            AnimationKey candidate = key;
+            size_t good = a + 1;
+            size_t bad = last + 1;
+            for (size_t span = 2; a + span <= last; span *= 2)
+            {
+                if (!fitSpan(keys, a, a + span, tolerance, candidate))
+                {
+                    bad = a + span;
+                    break;
+                }
+                good = a + span;
+                key = candidate;
+            }
+            if (bad > last && good < last && fitSpan(keys, a, last, tolerance, candidate))
+            {
+                good = last;
+                key = candidate;
+            }
+            else
+            {
+                bad = std::min(bad, last);
+            }
+
+            while (bad - good > 1 && good < last)
+            {
+                size_t middle = good + (bad - good) / 2;
+                if (fitSpan(keys, a, middle, tolerance, candidate))
+                {
+                    good = middle;
+                    key = candidate;
+                }
+                else
+                {
+                    bad = middle;
+                }
+            }
+            b = good;
+        }
+
+        reduced.push_back(key);
+        a = b;
+    }
+    reduced.push_back(keys[last]);
+    return reduced;
+}
+
+void AnimationStack::setTolerance(float value)
+{
+    tolerance = value;
+}
+
+void AnimationStack::quantize()
+{
+    if (quantized)
+    {
+        return;
+    }
+
+    float firstTime = 0.0f, lastTime = 0.0f;
+    for (size_t i = 0; i < keys.size(); i++)
+    {
+        firstTime = i == 0 ? keys[i].time : std::min(firstTime, keys[i].time);
+        lastTime = i == 0 ? keys[i].time : std::max(lastTime, keys[i].time);
+    }
+    timeOffset = firstTime;
+    timeScale = lastTime > firstTime ? (lastTime - firstTime) / 65535.0f : 1.0f;
+
+    uint32_t channelCount = getChannelCount();
+    channelValueOffsets.resize(channelCount);
+    channelValueScales.resize(channelCount);
+    channelTangentScales.resize(channelCount);
+    quantizedKeys.resize(keys.size());
+
+    for (uint32_t channel = 0; channel < channelCount; channel++)
+    {
+        uint32_t first = channelFirstKeys[channel];
+        uint32_t end = first + channelKeyCounts[channel] + 1;
+
+        float minValue = keys[first].value, maxValue = keys[first].value, maxTangent = 0.0f;
+        for (uint32_t i = first; i < end; i++)
+        {
+            minValue = std::min(minValue, keys[i].value);
+            maxValue = std::max(maxValue, keys[i].value);
+            maxTangent = std::max(maxTangent, std::max(std::fabs(keys[i].outTangent), std::fabs(keys[i].inTangent)));
+        }
+        float valueScale = (maxValue - minValue) / 65535.0f;
+        float tangentScale = maxTangent / 32767.0f;
+        channelValueOffsets[channel] = minValue;
+        channelValueScales[channel] = valueScale;
+        channelTangentScales[channel] = tangentScale;
+
+        // Times stay strictly increasing, so no segment collapses to zero length. Keys pushed past the
+        // end of the range by earlier ones are moved back from the last key, which only fails for
+        // channels with more keys than quantized times.
+        std::vector<int32_t> times(end - first);
+        int32_t previousTime = -1;
+        for (uint32_t i = first; i < end; i++)
+        {
+            int32_t time = static_cast<int32_t>(std::lround((keys[i].time - timeOffset) / timeScale));
+            previousTime = std::max(time, previousTime + 1);
+            times[i - first] = previousTime;
+        }
+        int32_t nextTime = 65536;
+        for (size_t i = times.size(); i-- > 0;)
+        {
+            nextTime = std::max(std::min(times[i], nextTime - 1), 0);
+            times[i] = nextTime;
+        }
+
+        for (uint32_t i = first; i < end; i++)
+        {
+            const PackedKey &key = keys[i];
+            QuantizedKey &quantizedKey = quantizedKeys[i];
+
+            quantizedKey.time = static_cast<uint16_t>(times[i - first]);
+            quantizedKey.value = valueScale > 0.0f ? static_cast<uint16_t>(std::lround((key.value - minValue) / valueScale)) : 0;
+            quantizedKey.outTangent = tangentScale > 0.0f ? static_cast<int16_t>(std::lround(key.outTangent / tangentScale)) : 0;
+            quantizedKey.inTangent = tangentScale > 0.0f ? static_cast<int16_t>(std::lround(key.inTangent / tangentScale)) : 0;
+        }
+    }
+
+    keys.clear();
+    keys.shrink_to_fit();
+    quantized = true;
+}
+
+bool AnimationStack::isQuantized() const
+{
+    return quantized;
+}
+
+void AnimationStack::save(const std::string &path) const
+{
+    std::ofstream file(path, std::ios::binary);
+    if (!file.is_open())
+    {
+        throw std::runtime_error("Failed to create animation cache: " + path);
+    }
+
+    file.write(CACHE_MAGIC, sizeof(CACHE_MAGIC));
+    writeValue(file, CACHE_VERSION);
+    writeValue(file, static_cast<uint32_t>(name.size()));
+    file.write(name.data(), name.size());
+    writeValue(file, startTime);
+    writeValue(file, endTime);
+
+    writeValue(file, static_cast<uint8_t>(quantized ? 1 : 0));
+    writeValue(file, static_cast<uint64_t>(keyCount));
+    writeValue(file, getChannelCount());
+    writeValue(file, static_cast<uint32_t>(keySteps.size()));
+    writeVector(file, channelNodes);
+    writeVector(file, channelProperties);
+    writeVector(file, channelFirstKeys);
+    writeVector(file, channelKeyCounts);
+    writeVector(file, keySteps);
+
+    if (quantized)
+    {
+        writeValue(file, timeOffset);
+        writeValue(file, timeScale);
+        writeVector(file, channelValueOffsets);
+        writeVector(file, channelValueScales);
+        writeVector(file, channelTangentScales);
+        writeVector(file, quantizedKeys);
+    }
+    else
+    {
+        writeVector(file, keys);
+    }
+
+    if (!file)
+    {
+        throw std::runtime_error("Failed to write animation cache: " + path);
+    }
+}
+
+void AnimationStack::addChannel(uint32_t node, uint8_t property, const std::vector<AnimationKey> &channelKeys, float defaultValue)
+{
+    if (quantized)
+    {
+        throw std::runtime_error("Channels cannot be added to a quantized animation stack");
+    }
+
+    std::vector<AnimationKey> unique;
+    unique.reserve(channelKeys.size());
+    for (const AnimationKey &key : channelKeys)
+    {
+        if (!unique.empty() && key.time <= unique.back().time)
+        {
+            unique.back() = key;
+            continue;
+        }
+        unique.push_back(key);
+    }
+    if (unique.empty())
+    {
+        AnimationKey key;
+        key.time = startTime;
+        key.value = defaultValue;
+        unique.push_back(key);
+    }
+    unique = reduceKeys(unique, tolerance);
+
+    channelNodes.push_back(node);
+    channelProperties.push_back(property);
+    channelFirstKeys.push_back(static_cast<uint32_t>(keys.size()));
+    channelKeyCounts.push_back(static_cast<uint32_t>(unique.size()));
+    keyCount += unique.size();
+
+    for (size_t i = 0; i < unique.size(); i++)
+    {
+        const AnimationKey &key = unique[i];
+        PackedKey packed = {key.time, key.value, 0.0f, 0.0f};
+        bool step = true;
+
+        if (i + 1 < unique.size() && key.interpolation != AnimationInterpolation::Constant)
+        {
+            const AnimationKey &next = unique[i + 1];
+            float duration = next.time - key.time;
+            if (key.interpolation == AnimationInterpolation::Cubic)
+            {
+                packed.outTangent = key.rightSlope * duration;
+                packed.inTangent = key.nextLeftSlope * duration;
+            }
+            else
+            {
+                packed.outTangent = packed.inTangent = next.value - key.value;
+            }
+            step = false;
+        }
+        keys.push_back(packed);
+        keySteps.push_back(step ? 1 : 0);
+    }
+
+    const AnimationKey &last = unique.back();
+    keys.push_back({last.time + 1.0f, last.value, 0.0f, 0.0f});
+    keySteps.push_back(1);
+}
+
+const std::string &AnimationStack::getName() const
+{
+    return name;
+}
+
+float AnimationStack::getStartTime() const
+{
+    return startTime;
+}
+
+float AnimationStack::getEndTime() const
+{
+    return endTime;
+}
+
+uint32_t AnimationStack::getChannelCount() const
+{
+    return static_cast<uint32_t>(channelNodes.size());
+}
+
+size_t AnimationStack::getKeyCount() const
+{
+    return keyCount;
+}
+
+size_t AnimationStack::getMemorySize() const
+{
+    size_t channelSize = 3 * sizeof(uint32_t) + sizeof(uint8_t) + (quantized ? 3 * sizeof(float) : 0);
+    return keys.size() * sizeof(PackedKey) + quantizedKeys.size() * sizeof(QuantizedKey) +
+           keySteps.size() * sizeof(uint8_t) + channelNodes.size() * channelSize;
+}
+
+uint32_t AnimationStack::getNode(uint32_t channel) const
+{
+    return channelNodes[channel];
+}
+
+uint8_t AnimationStack::getProperty(uint32_t channel) const
+{
+    return channelProperties[channel];
+}
+
+uint32_t AnimationStack::seek(uint32_t channel, float time, uint32_t cursor) const
+{
+    if (quantized)
+    {
+        return seekKeys(quantizedKeys.data() + channelFirstKeys[channel], channelKeyCounts[channel], (time - timeOffset) / timeScale, cursor);
+    }
+    return seekKeys(keys.data() + channelFirstKeys[channel], channelKeyCounts[channel], time, cursor);
+}
+
+template <typename Key>
+uint32_t AnimationStack::seekKeys(const Key *channelKeys, uint32_t count, float time, uint32_t cursor) const
+{
+    auto before = [](float t, const Key &key)
+    { return t < keyTime(key); };
+
+    if (cursor >= count)
+    {
+        cursor = 0;
+    }
+    if (time < keyTime(channelKeys[cursor]))
+    {
+        if (cursor == 0)
+        {
+            return 0;
+        }
+        uint32_t next = static_cast<uint32_t>(std::upper_bound(channelKeys, channelKeys + cursor, time, before) - channelKeys);
+        return next > 0 ? next - 1 : 0;
+    }
+
+    for (uint32_t step = 0; step < LINEAR_SEEK_STEPS; step++)
+    {
+        if (cursor + 1 >= count || time < keyTime(channelKeys[cursor + 1]))
+        {
+            return cursor;
+        }
+        cursor++;
+    }
+    return static_cast<uint32_t>(std::upper_bound(channelKeys + cursor, channelKeys + count, time, before) - channelKeys) - 1;
+}
+
+void AnimationStack::sample(float time, uint32_t begin, uint32_t end, uint32_t *cursors, float *out) const
+{
+    if (quantized)
+    {
+        sampleQuantized(time, begin, end, cursors, out);
+    }
+    else
+    {
+        sampleFloat(time, begin, end, cursors, out);
+    }
+}
+
+void AnimationStack::sampleFloat(float time, uint32_t begin, uint32_t end, uint32_t *cursors, float *out) const
+{
+    uint32_t channel = begin;
+
+#ifdef ANIMATION_STACK_SSE
+    const __m128 timeVector = _mm_set1_ps(time);
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 two = _mm_set1_ps(2.0f);
+    const __m128 three = _mm_set1_ps(3.0f);
+
+    for (; channel + 4 <= end; channel += 4)
+    {
+        uint32_t index[4];
+        float stepScale[4];
+        for (uint32_t lane = 0; lane < 4; lane++)
+        {
+            uint32_t cursor = seekKeys(keys.data() + channelFirstKeys[channel + lane], channelKeyCounts[channel + lane], time, cursors[channel + lane]);
+            cursors[channel + lane] = cursor;
+            index[lane] = channelFirstKeys[channel + lane] + cursor;
+            stepScale[lane] = keySteps[index[lane]] ? 0.0f : 1.0f;
+        }
+
+        __m128 t0 = _mm_load_ps(&keys[index[0]].time);
+        __m128 v0 = _mm_load_ps(&keys[index[1]].time);
+        __m128 m0 = _mm_load_ps(&keys[index[2]].time);
+        __m128 m1 = _mm_load_ps(&keys[index[3]].time);
+        _MM_TRANSPOSE4_PS(t0, v0, m0, m1);
+
+        __m128 t1 = _mm_load_ps(&keys[index[0] + 1].time);
+        __m128 v1 = _mm_load_ps(&keys[index[1] + 1].time);
+        __m128 unused0 = _mm_load_ps(&keys[index[2] + 1].time);
+        __m128 unused1 = _mm_load_ps(&keys[index[3] + 1].time);
+        _MM_TRANSPOSE4_PS(t1, v1, unused0, unused1);
+
+        __m128 u = _mm_div_ps(_mm_sub_ps(timeVector, t0), _mm_sub_ps(t1, t0));
+        u = _mm_mul_ps(_mm_min_ps(_mm_max_ps(u, zero), one), _mm_loadu_ps(stepScale));
+
+        __m128 u2 = _mm_mul_ps(u, u);
+        __m128 u3 = _mm_mul_ps(u2, u);
+        __m128 h00 = _mm_add_ps(_mm_sub_ps(_mm_mul_ps(two, u3), _mm_mul_ps(three, u2)), one);
+        __m128 h10 = _mm_add_ps(_mm_sub_ps(u3, _mm_mul_ps(two, u2)), u);
+        __m128 h11 = _mm_sub_ps(u3, u2);
+
+        __m128 result = _mm_mul_ps(v0, h00);
+        result = _mm_add_ps(result, _mm_mul_ps(m0, h10));
+        result = _mm_add_ps(result, _mm_mul_ps(v1, _mm_sub_ps(one, h00)));
+        result = _mm_add_ps(result, _mm_mul_ps(m1, h11));
+        _mm_storeu_ps(out + channel, result);
+    }
+#endif
+
+    for (; channel < end; channel++)
+    {
+        uint32_t cursor = seekKeys(keys.data() + channelFirstKeys[channel], channelKeyCounts[channel], time, cursors[channel]);
+        cursors[channel] = cursor;
+
+        uint32_t index = channelFirstKeys[channel] + cursor;
+        const PackedKey &key = keys[index];
+        const PackedKey &next = keys[index + 1];
+        // A zero length segment holds the left key
+        float length = next.time - key.time;
+        float u = keySteps[index] || length <= 0.0f ? 0.0f : std::min(std::max((time - key.time) / length, 0.0f), 1.0f);
+        out[channel] = hermite(u, key.value, next.value, key.outTangent, key.inTangent);
+    }
+}
+
+void AnimationStack::sampleQuantized(float time, uint32_t begin, uint32_t end, uint32_t *cursors, float *out) const
+{
+    float quantizedTime = (time - timeOffset) / timeScale;
+    uint32_t channel = begin;
+
+#ifdef ANIMATION_STACK_SSE
+    const __m128 timeVector = _mm_set1_ps(quantizedTime);
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 two = _mm_set1_ps(2.0f);
+    const __m128 three = _mm_set1_ps(3.0f);
+    const __m128i zeroInteger = _mm_setzero_si128();
+
+    for (; channel + 4 <= end; channel += 4)
+    {
+        __m128 rows[4];
+        __m128 nextRows[4];
+        float stepScale[4];
+        for (uint32_t lane = 0; lane < 4; lane++)
+        {
+            uint32_t cursor = seekKeys(quantizedKeys.data() + channelFirstKeys[channel + lane], channelKeyCounts[channel + lane], quantizedTime, cursors[channel + lane]);
+            cursors[channel + lane] = cursor;
+            uint32_t index = channelFirstKeys[channel + lane] + cursor;
+            stepScale[lane] = keySteps[index] ? 0.0f : 1.0f;
+
+            // Both keys of the segment in one load: time and value unsigned, tangents signed
+            __m128i pair = _mm_loadu_si128(reinterpret_cast<const __m128i *>(&quantizedKeys[index]));
+            __m128 unsignedKey = _mm_cvtepi32_ps(_mm_unpacklo_epi16(pair, zeroInteger));
+            __m128 signedKey = _mm_cvtepi32_ps(_mm_srai_epi32(_mm_unpacklo_epi16(zeroInteger, pair), 16));
+            rows[lane] = _mm_shuffle_ps(unsignedKey, signedKey, _MM_SHUFFLE(3, 2, 1, 0));
+            nextRows[lane] = _mm_cvtepi32_ps(_mm_unpackhi_epi16(pair, zeroInteger));
+        }
+        _MM_TRANSPOSE4_PS(rows[0], rows[1], rows[2], rows[3]);
+        _MM_TRANSPOSE4_PS(nextRows[0], nextRows[1], nextRows[2], nextRows[3]);
+
+        __m128 valueOffset = _mm_loadu_ps(&channelValueOffsets[channel]);
+        __m128 valueScale = _mm_loadu_ps(&channelValueScales[channel]);
+        __m128 tangentScale = _mm_loadu_ps(&channelTangentScales[channel]);
+
+        __m128 t0 = rows[0];
+        __m128 t1 = nextRows[0];
+        __m128 v0 = _mm_add_ps(valueOffset, _mm_mul_ps(rows[1], valueScale));
+        __m128 v1 = _mm_add_ps(valueOffset, _mm_mul_ps(nextRows[1], valueScale));
+        __m128 m0 = _mm_mul_ps(rows[2], tangentScale);
+        __m128 m1 = _mm_mul_ps(rows[3], tangentScale);
+
+        __m128 u = _mm_div_ps(_mm_sub_ps(timeVector, t0), _mm_sub_ps(t1, t0));
+        u = _mm_mul_ps(_mm_min_ps(_mm_max_ps(u, zero), one), _mm_loadu_ps(stepScale));
+
+        __m128 u2 = _mm_mul_ps(u, u);
+        __m128 u3 = _mm_mul_ps(u2, u);
+        __m128 h00 = _mm_add_ps(_mm_sub_ps(_mm_mul_ps(two, u3), _mm_mul_ps(three, u2)), one);
+        __m128 h10 = _mm_add_ps(_mm_sub_ps(u3, _mm_mul_ps(two, u2)), u);
+        __m128 h11 = _mm_sub_ps(u3, u2);
+
+        __m128 result = _mm_mul_ps(v0, h00);
+        result = _mm_add_ps(result, _mm_mul_ps(m0, h10));
+        result = _mm_add_ps(result, _mm_mul_ps(v1, _mm_sub_ps(one, h00)));
+        result = _mm_add_ps(result, _mm_mul_ps(m1, h11));
+        _mm_storeu_ps(out + channel, result);
+    }
+#endif
+
+    for (; channel < end; channel++)
+    {
+        uint32_t cursor = seekKeys(quantizedKeys.data() + channelFirstKeys[channel], channelKeyCounts[channel], quantizedTime, cursors[channel]);
+        cursors[channel] = cursor;
+
+        uint32_t index = channelFirstKeys[channel] + cursor;
+        const QuantizedKey &key = quantizedKeys[index];
+        const QuantizedKey &next = quantizedKeys[index + 1];
+        // A zero length segment holds the left key
+        int32_t length = static_cast<int32_t>(next.time) - key.time;
+        float u = keySteps[index] || length <= 0 ? 0.0f : std::min(std::max((quantizedTime - key.time) / static_cast<float>(length), 0.0f), 1.0f);
+
+        float valueOffset = channelValueOffsets[channel];
+        float valueScale = channelValueScales[channel];
+        float tangentScale = channelTangentScales[channel];
+        out[channel] = hermite(u, valueOffset + key.value * valueScale, valueOffset + next.value * valueScale,
+                               key.outTangent * tangentScale, key.inTangent * tangentScale);
+    }
+}
+
+/**
+ * @brief JNI function to create an empty animation stack.
+ *
+ * @param env The JNI environment.
+ * @param cls The Java class.
+ * @param name The stack name.
+ * @param startTime The start of the playback range in seconds.
+ * @param endTime The end of the playback range in seconds.
+ * @return The native animation stack pointer.
+ */
+JNIEXPORT jlong JNICALL Java_com_github_nodedev74_jfbx_anim_AnimationStack_create(JNIEnv *env, jclass cls, jstring name, jfloat startTime, jfloat endTime)
+{
+    const char *chars = env->GetStringUTFChars(name, nullptr);
+    AnimationStack *stack = new AnimationStack(chars, startTime, endTime);
+    env->ReleaseStringUTFChars(name, chars);
+    return reinterpret_cast<jlong>(stack);
+}
+
+/**
+ * @brief JNI function to add a linearly interpolated channel.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ * @param node The scene graph node.
+ * @param property The transform component, 0 to 8.
+ * @param times The key times in seconds.
+ * @param values The key values.
+ */
+JNIEXPORT void JNICALL Java_com_github_nodedev74_jfbx_anim_AnimationStack_addChannel(JNIEnv *env, jobject obj, jint node, jint property, jfloatArray times, jfloatArray values)
+{
+    jsize count = env->GetArrayLength(times);
+    std::vector<float> keyTimes(count), keyValues(count);
+    env->GetFloatArrayRegion(times, 0, count, keyTimes.data());
+    env->GetFloatArrayRegion(values, 0, count, keyValues.data());
+
+    std::vector<AnimationKey> keys(count);
+    for (jsize i = 0; i < count; i++)
+    {
+        keys[i].time = keyTimes[i];
+        keys[i].value = keyValues[i];
+    }
+    try
+    {
+        getStack(env, obj)->addChannel(static_cast<uint32_t>(node), static_cast<uint8_t>(property), keys, 0.0f);
+    }
+    catch (const std::exception &e)
+    {
+        throwFbxError(env, e.what());
+    }
+}
+
+/**
+ * @brief JNI function to load an animation stack from a cache file.
+ *
+ * @param env The JNI environment.
+ * @param cls The Java class.
+ * @param path The cache file path.
+ * @return The native animation stack pointer.
+ */
+JNIEXPORT jlong JNICALL Java_com_github_nodedev74_jfbx_anim_AnimationStack_load(JNIEnv *env, jclass cls, jstring path)
+{
+    TRACE_ZONE("AnimationStack.load");
+
+    try
+    {
+        return reinterpret_cast<jlong>(AnimationStack::load(toString(env, path)));
+    }
+    catch (const std::exception &e)
+    {
+        throwFbxError(env, e.what());
+        return 0;
+    }
+}
+
+/**
+ * @brief JNI function to write the stack to a cache file.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ * @param path The cache file path.
+ */
+JNIEXPORT void JNICALL Java_com_github_nodedev74_jfbx_anim_AnimationStack_save(JNIEnv *env, jobject obj, jstring path)
+{
+    TRACE_ZONE("AnimationStack.save");
+
+    try
+    {
+        getStack(env, obj)->save(toString(env, path));
+    }
+    catch (const std::exception &e)
+    {
+        throwFbxError(env, e.what());
+    }
+}
+
+/**
+ * @brief JNI function to set the key reduction tolerance of channels added afterwards.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ * @param tolerance The maximum deviation from the original curve, 0 keeps all keys.
+ */
+JNIEXPORT void JNICALL Java_com_github_nodedev74_jfbx_anim_AnimationStack_setTolerance(JNIEnv *env, jobject obj, jfloat tolerance)
+{
+    getStack(env, obj)->setTolerance(tolerance);
+}
+
+/**
+ * @brief JNI function to convert the keys to the quantized representation.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ */
+JNIEXPORT void JNICALL Java_com_github_nodedev74_jfbx_anim_AnimationStack_quantize(JNIEnv *env, jobject obj)
+{
+    getStack(env, obj)->quantize();
+}
+
+/**
+ * @brief JNI function to check if the keys are quantized.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ * @return True if the keys are quantized.
+ */
+JNIEXPORT jboolean JNICALL Java_com_github_nodedev74_jfbx_anim_AnimationStack_isQuantized(JNIEnv *env, jobject obj)
+{
+    return getStack(env, obj)->isQuantized() ? JNI_TRUE : JNI_FALSE;
+}
+
+/**
+ * @brief JNI function to retrieve the stack name.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ * @return The name.
+ */
+JNIEXPORT jstring JNICALL Java_com_github_nodedev74_jfbx_anim_AnimationStack_getName(JNIEnv *env, jobject obj)
+{
+    return env->NewStringUTF(getStack(env, obj)->getName().c_str());
+}
+
+/**
+ * @brief JNI function to retrieve the start of the playback range.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ * @return The start time in seconds.
+ */
+JNIEXPORT jfloat JNICALL Java_com_github_nodedev74_jfbx_anim_AnimationStack_getStartTime(JNIEnv *env, jobject obj)
+{
+    return getStack(env, obj)->getStartTime();
+}
+
+/**
+ * @brief JNI function to retrieve the end of the playback range.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ * @return The end time in seconds.
+ */
+JNIEXPORT jfloat JNICALL Java_com_github_nodedev74_jfbx_anim_AnimationStack_getEndTime(JNIEnv *env, jobject obj)
+{
+    return getStack(env, obj)->getEndTime();
+}
+
+/**
+ * @brief JNI function to retrieve the number of channels.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ * @return The channel count.
+ */
+JNIEXPORT jint JNICALL Java_com_github_nodedev74_jfbx_anim_AnimationStack_getChannelCount(JNIEnv *env, jobject obj)
+{
+    return static_cast<jint>(getStack(env, obj)->getChannelCount());
+}
+
+/**
+ * @brief JNI function to retrieve the number of keys.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ * @return The key count.
+ */
+JNIEXPORT jlong JNICALL Java_com_github_nodedev74_jfbx_anim_AnimationStack_getKeyCount(JNIEnv *env, jobject obj)
+{
+    return static_cast<jlong>(getStack(env, obj)->getKeyCount());
+}
+
+/**
+ * @brief JNI function to retrieve the memory used by channels and keys.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ * @return The size in bytes.
+ */
+JNIEXPORT jlong JNICALL Java_com_github_nodedev74_jfbx_anim_AnimationStack_getMemorySize(JNIEnv *env, jobject obj)
+{
+    return static_cast<jlong>(getStack(env, obj)->getMemorySize());
+}
+
+/**
+ * @brief JNI function to release the native animation stack.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ */
+JNIEXPORT void JNICALL Java_com_github_nodedev74_jfbx_anim_AnimationStack_destroy(JNIEnv *env, jobject obj)
+{
+    delete getStack(env, obj);
+
+    jclass cls = env->GetObjectClass(obj);
+    jfieldID fieldID = env->GetFieldID(cls, "stackPtr", "J");
+    env->SetLongField(obj, fieldID, 0);
+}
@@ -0,0 +1,399 @@
+/**
+ * @file AssetLoader.cpp
+ * @author Lenard Büsing (nodedev74@gmail.com)
+ * @brief Background loading of scenes, textures and meshes with priorities and cancellation.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2023 Lenard Büsing
+ *
+ */
+
+#include "core/AssetLoader.hpp"
+#include "core/Tracer.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+
+namespace
+{
+    bool isEnded(AssetState state)
+    {
+        return state == AssetState::Complete || state == AssetState::Cancelled || state == AssetState::Failed;
+    }
+
+    bool readFile(const std::string &path, std::vector<uint8_t> &content)
+    {
+        std::ifstream file(path, std::ios::binary);
+        if (!file)
+        {
+            return false;
+        }
+        content.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        return true;
+    }
+
+    // Waiting assets are picked by priority, then in request order
+    bool isPickedLater(const std::shared_ptr<Asset> &a, const std::shared_ptr<Asset> &b)
+    {
+        return a->priority < b->priority || (a->priority == b->priority && a->handle > b->handle);
+    }
+
+    void releaseData(Asset &asset)
+    {
+        asset.file = std::vector<uint8_t>();
+        asset.positions = std::vector<float>();
+        asset.indices = std::vector<uint32_t>();
+        asset.image = TextureImage();
+        asset.textures = std::vector<TextureData>();
+        asset.meshes = std::vector<AssetMesh>();
+    }
+}
+
+AssetLoader::AssetLoader(uint32_t threadCount, std::string cacheDirectory) : cache(std::move(cacheDirectory))
+{
+    if (threadCount == 0)
+    {
+        threadCount = std::max(std::thread::hardware_concurrency() / 2, 1u);
+    }
+
+    workers.reserve(threadCount);
+    for (uint32_t i = 0; i < threadCount; i++)
+    {
+        workers.emplace_back(&AssetLoader::workerLoop, this);
+    }
+}
+
+AssetLoader::~AssetLoader()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+        for (auto &entry : assets)
+        {
+            entry.second->cancelled = true;
+        }
+    }
+    wake.notify_all();
+    for (std::thread &worker : workers)
+    {
+        worker.join();
+    }
+}
+
+uint32_t AssetLoader::loadScene(std::string path, int32_t priority, bool blockCompression)
+{
+    std::shared_ptr<Asset> asset = std::make_shared<Asset>();
+    asset->kind = AssetKind::Scene;
+    asset->priority = priority;
+    asset->path = std::move(path);
+    asset->blockCompression = blockCompression;
+    return enqueue(std::move(asset));
+}
+
+uint32_t AssetLoader::loadTexture(std::vector<uint8_t> file, int32_t priority, bool blockCompression)
+{
+    std::shared_ptr<Asset> asset = std::make_shared<Asset>();
+    asset->kind = AssetKind::Texture;
+    asset->priority = priority;
+    asset->file = std::move(file);
+    asset->blockCompression = blockCompression;
+    return enqueue(std::move(asset));
+}
+
+uint32_t AssetLoader::loadMesh(std::vector<float> positions, std::vector<uint32_t> indices, int32_t priority)
+{
+    std::shared_ptr<Asset> asset = std::make_shared<Asset>();
+    asset->kind = AssetKind::Mesh;
+    asset->priority = priority;
+    asset->positions = std::move(positions);
+    asset->indices = std::move(indices);
+    return enqueue(std::move(asset));
+}
+
+void AssetLoader::setPriority(uint32_t handle, int32_t priority)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = assets.find(handle);
+    if (it != assets.end())
+    {
+        it->second->priority = priority;
+    }
+}
+
+bool AssetLoader::cancel(uint32_t handle)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = assets.find(handle);
+    if (it == assets.end() || isEnded(it->second->state))
+    {
+        return false;
+    }
+
+    std::shared_ptr<Asset> asset = it->second;
+    asset->cancelled = true;
+    if (asset->state == AssetState::Queued || asset->state == AssetState::Parsed)
+    {
+        waiting.erase(std::find(waiting.begin(), waiting.end(), asset));
+        asset->state = AssetState::Cancelled;
+        asset->scene.reset();
+        releaseData(*asset);
+    }
+    else if (asset->state == AssetState::Ready)
+    {
+        uploads.erase(std::find(uploads.begin(), uploads.end(), asset));
+        asset->state = AssetState::Cancelled;
+        asset->scene.reset();
+        releaseData(*asset);
+    }
+    return true;
+}
+
+std::shared_ptr<Asset> AssetLoader::get(uint32_t handle) const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = assets.find(handle);
+    return it != assets.end() ? it->second : nullptr;
+}
+
+AssetState AssetLoader::getState(uint32_t handle) const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = assets.find(handle);
+    return it != assets.end() ? it->second->state : AssetState::Failed;
+}
+
+void AssetLoader::release(uint32_t handle)
+{
+    cancel(handle);
+    std::lock_guard<std::mutex> lock(mutex);
+    assets.erase(handle);
+}
+
+std::shared_ptr<Asset> AssetLoader::beginUpload()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    if (uploads.empty())
+    {
+        return nullptr;
+    }
+    std::shared_ptr<Asset> asset = *std::max_element(uploads.begin(), uploads.end(), isPickedLater);
+    asset->state = AssetState::Uploading;
+    return asset;
+}
+
+void AssetLoader::endUpload(const std::shared_ptr<Asset> &asset, AssetState state)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    asset->state = state;
+    if (state == AssetState::Uploading)
+    {
+        return;
+    }
+    uploads.erase(std::find(uploads.begin(), uploads.end(), asset));
+    if (state != AssetState::Complete)
+    {
+        asset->scene.reset();
+    }
+    releaseData(*asset);
+}
+
+uint32_t AssetLoader::enqueue(std::shared_ptr<Asset> asset)
+{
+    uint32_t handle;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        handle = nextHandle++;
+        asset->handle = handle;
+        assets[handle] = asset;
+        waiting.push_back(std::move(asset));
+    }
+    wake.notify_one();
+    return handle;
+}
+
+void AssetLoader::workerLoop()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true)
+    {
+        wake.wait(lock, [this]
+                  { return stopping || !waiting.empty(); });
+        if (stopping)
+        {
+            return;
+        }
+
+        auto picked = std::max_element(waiting.begin(), waiting.end(), isPickedLater);
+        std::shared_ptr<Asset> asset = std::move(*picked);
+        waiting.erase(picked);
+        bool parsing = asset->state == AssetState::Queued;
+        asset->state = parsing ? AssetState::Parsing : AssetState::Processing;
+        lock.unlock();
+
+        AssetState state = parsing ? AssetState::Parsed : AssetState::Ready;
+        std::string error;
+        try
+        {
+            if (parsing)
+                parse(*asset);
+            else
+                process(*asset);
+        }
+        catch (const std::exception &e)
+        {
+            error = e.what();
+            state = AssetState::Failed;
+        }
+        if (asset->cancelled || state == AssetState::Failed)
+        {
+            asset->scene.reset();
+            releaseData(*asset);
+        }
+
+        lock.lock();
+        asset->error = error;
+        asset->state = asset->cancelled ? AssetState::Cancelled : state;
+        if (asset->state == AssetState::Parsed)
+        {
+            waiting.push_back(asset);
+        }
+        else if (asset->state == AssetState::Ready)
+        {
+            asset->progress = 0.8f;
+            uploads.push_back(asset);
+        }
+    }
+}
+
+void AssetLoader::parse(Asset &asset)
+{
+    TRACE_ZONE("AssetLoader.parse");
+
+    switch (asset.kind)
+    {
+    case AssetKind::Scene:
+        asset.scene = std::make_unique<FbxScene>(asset.path);
+        break;
+    case AssetKind::Texture:
+    {
+        asset.textures.resize(1);
+        uint64_t key = TextureCodec::hash(asset.file.data(), asset.file.size());
+        if (!cache.load(key, asset.blockCompression, asset.textures[0]))
+        {
+            asset.textures.clear();
+            asset.image = TextureCodec::decode(asset.file.data(), asset.file.size());
+        }
+        break;
+    }
+    case AssetKind::Mesh:
+    {
+        uint32_t vertexCount = static_cast<uint32_t>(asset.positions.size() / 3);
+        bool valid = vertexCount > 0 && asset.positions.size() % 3 == 0 && !asset.indices.empty() && asset.indices.size() % 3 == 0;
+        for (size_t i = 0; valid && i < asset.indices.size(); i++)
+        {
+            valid = asset.indices[i] < vertexCount;
+        }
+        if (!valid)
+        {
+            throw std::runtime_error("Mesh needs triangles whose indices refer to its vertices");
+        }
+        break;
+    }
+    }
+    asset.progress = 0.4f;
+}
+
+void AssetLoader::process(Asset &asset)
+{
+    TRACE_ZONE("AssetLoader.process");
+
+    if (asset.kind == AssetKind::Texture)
+    {
+        if (asset.textures.empty())
+        {
+            TextureData texture = TextureCodec::generateMips(asset.image);
+            asset.image = TextureImage();
+            if (asset.blockCompression)
+            {
+                texture = TextureCodec::compress(texture);
+            }
+            cache.store(TextureCodec::hash(asset.file.data(), asset.file.size()), asset.blockCompression, texture);
+            asset.textures.push_back(std::move(texture));
+        }
+        asset.uploadBytes = asset.textures[0].bytes.size();
+        return;
+    }
+    if (asset.kind == AssetKind::Mesh)
+    {
+        AssetMesh mesh;
+        mesh.positions = asset.positions.data();
+        mesh.vertexCount = static_cast<uint32_t>(asset.positions.size() / 3);
+        mesh.indices = asset.indices.data();
+        mesh.indexCount = static_cast<uint32_t>(asset.indices.size());
+        mesh.bounds = Bounds::fromPositions(mesh.positions, mesh.vertexCount);
+        asset.meshes.push_back(mesh);
+        asset.uploadBytes = (asset.positions.size() + asset.indices.size()) * 4;
+        return;
+    }
+
+    // Textures that are neither embedded nor found next to the file leave their materials untextured
+    const std::vector<FbxTexture> &textures = asset.scene->getTextures();
+    std::string directory = asset.path.substr(0, asset.path.find_last_of("/\\") + 1);
+    std::vector<int32_t> textureSlots(textures.size(), -1);
+    std::vector<uint8_t> content;
+    for (size_t i = 0; i < textures.size() && !asset.cancelled; i++)
+    {
+        const FbxTexture &texture = textures[i];
+        const uint8_t *data = reinterpret_cast<const uint8_t *>(texture.content.data());
+        size_t size = texture.content.size();
+        if (size == 0)
+        {
+            std::string baseName = texture.fileName.substr(texture.fileName.find_last_of("/\\") + 1);
+            if (!readFile(directory + texture.fileName, content) && !readFile(directory + baseName, content))
+            {
+                continue;
+            }
+            data = content.data();
+            size = content.size();
+        }
+
+        TextureData textureData;
+        uint64_t key = TextureCodec::hash(data, size);
+        if (!cache.load(key, asset.blockCompression, textureData))
+        {
+            try
+            {
+                textureData = TextureCodec::import(data, size, asset.blockCompression);
+                cache.store(key, asset.blockCompression, textureData);
+            }
+            catch (const std::runtime_error &)
+            {
+                continue;
+            }
+        }
+        textureSlots[i] = static_cast<int32_t>(asset.textures.size());
+        asset.uploadBytes += textureData.bytes.size();
+        asset.textures.push_back(std::move(textureData));
+        asset.progress = 0.4f + 0.4f * static_cast<float>(i + 1) / static_cast<float>(textures.size());
+    }
+
+    for (const FbxMaterial &material : asset.scene->getMaterials())
+    {
+        asset.materialTextures.push_back(material.texture >= 0 ? textureSlots[material.texture] : -1);
+    }
+    for (const FbxMesh &fbxMesh : asset.scene->getMeshes())
+    {
+        AssetMesh mesh;
+        mesh.positions = fbxMesh.positions.data();
+        mesh.vertexCount = static_cast<uint32_t>(fbxMesh.positions.size() / 3);
+        mesh.indices = fbxMesh.indices.data();
+        mesh.indexCount = static_cast<uint32_t>(fbxMesh.indices.size());
+        mesh.bounds = fbxMesh.bounds;
+        asset.meshes.push_back(mesh);
+        asset.uploadBytes += (fbxMesh.positions.size() + fbxMesh.indices.size()) * 4;
+    }
+}
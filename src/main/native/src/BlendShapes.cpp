@@ -0,0 +1,478 @@
+/**
+ * @file BlendShapes.cpp
+ * @author Lenard Büsing (nodedev74@gmail.com)
+ * @brief Implementation of the sparse blend shape storage and evaluation.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2023 Lenard Büsing
+ *
+ */
+
+#include "com_github_nodedev74_jfbx_anim_BlendShapes.h"
+#include <jni.h>
+
+#include "anim/BlendShapes.hpp"
+#include "fbx/FbxScene.hpp"
+#include "core/ThreadPool.hpp"
+#include "core/Tracer.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+#if defined(__SSE__) || defined(_M_X64)
+#include <xmmintrin.h>
+#define BLEND_SHAPES_SSE 1
+#endif
+
+namespace
+{
+    constexpr uint32_t BLEND_SHAPES_GRAIN = 4096;
+
+    BlendShapes *getBlendShapes(JNIEnv *env, jobject obj)
+    {
+        jclass cls = env->GetObjectClass(obj);
+        jfieldID fieldID = env->GetFieldID(cls, "blendShapesPtr", "J");
+        return reinterpret_cast<BlendShapes *>(env->GetLongField(obj, fieldID));
+    }
+
+    void throwFbxError(JNIEnv *env, const char *what)
+    {
+        jclass exceptionClass = env->FindClass("com/github/nodedev74/jfbx/exception/FbxRuntimeError");
+        jmethodID constructorID = env->GetMethodID(exceptionClass, "<init>", "(Ljava/lang/String;)V");
+        jstring message = env->NewStringUTF(what);
+        jobject exceptionObject = env->NewObject(exceptionClass, constructorID, message);
+        env->Throw(static_cast<jthrowable>(exceptionObject));
+    }
+}
+
+BlendShapes::BlendShapes(const std::vector<float> &basePositions)
+{
+    if (basePositions.size() % 3 != 0)
+    {
+        throw std::runtime_error("Blend shape positions are not a multiple of three");
+    }
+
+    size_t vertexCount = basePositions.size() / 3;
+    positions.resize(vertexCount * 4);
+    for (size_t vertex = 0; vertex < vertexCount; vertex++)
+    {
+        std::copy(&basePositions[vertex * 3], &basePositions[vertex * 3] + 3, &positions[vertex * 4]);
+        positions[vertex * 4 + 3] = 1.0f;
+    }
+}
+
+BlendShapes *BlendShapes::fromScene(const FbxScene &scene, uint32_t blendShapeIndex)
+{
+    TRACE_ZONE("BlendShapes.fromScene");
+
+    const FbxBlendShape &source = scene.getBlendShapes()[blendShapeIndex];
+    if (source.mesh < 0)
+    {
+        throw std::runtime_error("Blend shape deformer has no mesh");
+    }
+
+    BlendShapes *blendShapes = new BlendShapes(scene.getMeshes()[source.mesh].positions);
+    try
+    {
+        for (const FbxBlendShapeChannel &channel : source.channels)
+        {
+            std::vector<uint32_t> indices(channel.indices.size());
+            for (size_t i = 0; i < indices.size(); i++)
+            {
+                // Negative indices wrap around and fail the range check of addShape
+                indices[i] = static_cast<uint32_t>(channel.indices[i]);
+            }
+            uint32_t shape = blendShapes->addShape(channel.name, indices, channel.deltas);
+            blendShapes->setWeight(shape, static_cast<float>(channel.deformPercent / 100.0));
+        }
+    }
+    catch (...)
+    {
+        delete blendShapes;
+        throw;
+    }
+    return blendShapes;
+}
+
+uint32_t BlendShapes::addShape(const std::string &name, const std::vector<uint32_t> &shapeIndices, const std::vector<float> &shapeDeltas)
+{
+    if (shapeDeltas.size() != shapeIndices.size() * 3)
+    {
+        throw std::runtime_error("Blend shape indices and deltas differ in length");
+    }
+
+    uint32_t vertexCount = getVertexCount();
+    std::vector<uint32_t> order(shapeIndices.size());
+    for (uint32_t i = 0; i < order.size(); i++)
+    {
+        if (shapeIndices[i] >= vertexCount)
+        {
+            throw std::runtime_error("Blend shape index out of range");
+        }
+        order[i] = i;
+    }
+    std::stable_sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b)
+                     { return shapeIndices[a] < shapeIndices[b]; });
+
+    Shape shape = {name, static_cast<uint32_t>(indices.size()), 0, 0.0f};
+    for (size_t i = 0; i < order.size();)
+    {
+        uint32_t vertex = shapeIndices[order[i]];
+        float delta[3] = {0.0f, 0.0f, 0.0f};
+        for (; i < order.size() && shapeIndices[order[i]] == vertex; i++)
+        {
+            for (int k = 0; k < 3; k++)
+            {
+                delta[k] += shapeDeltas[order[i] * 3 + k];
+            }
+        }
+
+        if (std::fabs(delta[0]) > BLEND_SHAPE_EPSILON || std::fabs(delta[1]) > BLEND_SHAPE_EPSILON || std::fabs(delta[2]) > BLEND_SHAPE_EPSILON)
+        {
+            indices.push_back(vertex);
+            deltas.insert(deltas.end(), {delta[0], delta[1], delta[2], 0.0f});
+        }
+    }
+    shape.end = static_cast<uint32_t>(indices.size());
+
+    shapes.push_back(std::move(shape));
+    return static_cast<uint32_t>(shapes.size() - 1);
+}
+
+uint32_t BlendShapes::addDenseShape(const std::string &name, const std::vector<float> &shapeDeltas)
+{
+    if (shapeDeltas.size() != positions.size() / 4 * 3)
+    {
+        throw std::runtime_error("Blend shape deltas do not match the vertex count");
+    }
+
+    std::vector<uint32_t> shapeIndices(getVertexCount());
+    for (uint32_t i = 0; i < shapeIndices.size(); i++)
+    {
+        shapeIndices[i] = i;
+    }
+    return addShape(name, shapeIndices, shapeDeltas);
+}
+
+uint32_t BlendShapes::getVertexCount() const
+{
+    return static_cast<uint32_t>(positions.size() / 4);
+}
+
+uint32_t BlendShapes::getShapeCount() const
+{
+    return static_cast<uint32_t>(shapes.size());
+}
+
+const std::string &BlendShapes::getShapeName(uint32_t shape) const
+{
+    return shapes[shape].name;
+}
+
+size_t BlendShapes::getDeltaCount() const
+{
+    return indices.size();
+}
+
+void BlendShapes::setWeight(uint32_t shape, float weight)
+{
+    shapes[shape].weight = weight;
+}
+
+float BlendShapes::getWeight(uint32_t shape) const
+{
+    return shapes[shape].weight;
+}
+
+size_t BlendShapes::getMemorySize() const
+{
+    size_t size = positions.size() * sizeof(float) + indices.size() * sizeof(uint32_t) + deltas.size() * sizeof(float);
+    for (const Shape &shape : shapes)
+    {
+        size += sizeof(Shape) + shape.name.capacity();
+    }
+    return size;
+}
+
+void BlendShapes::evaluate(uint32_t begin, uint32_t end, float *out) const
+{
+    std::copy(positions.begin() + begin * 4, positions.begin() + end * 4, out + begin * 4);
+
+    for (const Shape &shape : shapes)
+    {
+        if (shape.weight == 0.0f || shape.begin == shape.end)
+        {
+            continue;
+        }
+
+        // Indices of a shape are ascending, so a vertex range maps to a contiguous entry range
+        const uint32_t *first = indices.data() + shape.begin;
+        const uint32_t *last = indices.data() + shape.end;
+        if (begin > *first)
+        {
+            first = std::lower_bound(first, last, begin);
+        }
+        if (end <= *(last - 1))
+        {
+            last = std::lower_bound(first, last, end);
+        }
+
+        const float *delta = deltas.data() + (first - indices.data()) * 4;
+#ifdef BLEND_SHAPES_SSE
+        __m128 weight = _mm_set1_ps(shape.weight);
+        for (const uint32_t *index = first; index < last; index++, delta += 4)
+        {
+            float *position = out + *index * 4;
+            _mm_storeu_ps(position, _mm_add_ps(_mm_loadu_ps(position), _mm_mul_ps(_mm_loadu_ps(delta), weight)));
+        }
+#else
+        for (const uint32_t *index = first; index < last; index++, delta += 4)
+        {
+            float *position = out + *index * 4;
+            position[0] += delta[0] * shape.weight;
+            position[1] += delta[1] * shape.weight;
+            position[2] += delta[2] * shape.weight;
+        }
+#endif
+    }
+}
+
+void BlendShapes::evaluate(ThreadPool *pool, float *out) const
+{
+    TRACE_ZONE("BlendShapes.evaluate");
+
+    uint32_t vertexCount = getVertexCount();
+    if (pool == nullptr)
+    {
+        evaluate(0, vertexCount, out);
+        return;
+    }
+
+    pool->parallelFor(vertexCount, BLEND_SHAPES_GRAIN, [&](uint32_t begin, uint32_t end)
+                      { evaluate(begin, end, out); });
+}
+
+/**
+ * @brief JNI function to create blend shapes without any shape.
+ *
+ * @param env The JNI environment.
+ * @param cls The Java class.
+ * @param positions The base positions, x, y and z per vertex.
+ * @return The native blend shapes pointer.
+ */
+JNIEXPORT jlong JNICALL Java_com_github_nodedev74_jfbx_anim_BlendShapes_create(JNIEnv *env, jclass cls, jfloatArray positions)
+{
+    std::vector<float> positionValues(env->GetArrayLength(positions));
+    env->GetFloatArrayRegion(positions, 0, static_cast<jsize>(positionValues.size()), positionValues.data());
+
+    try
+    {
+        return reinterpret_cast<jlong>(new BlendShapes(positionValues));
+    }
+    catch (const std::exception &e)
+    {
+        throwFbxError(env, e.what());
+        return 0;
+    }
+}
+
+/**
+ * @brief JNI function to add a shape from sparse deltas.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ * @param name The shape name.
+ * @param indices The vertex indices.
+ * @param deltas x, y and z per index.
+ * @return The shape index.
+ */
+JNIEXPORT jint JNICALL Java_com_github_nodedev74_jfbx_anim_BlendShapes_addShape(JNIEnv *env, jobject obj, jstring name, jintArray indices, jfloatArray deltas)
+{
+    std::vector<jint> indexValues(env->GetArrayLength(indices));
+    env->GetIntArrayRegion(indices, 0, static_cast<jsize>(indexValues.size()), indexValues.data());
+
+    std::vector<float> deltaValues(env->GetArrayLength(deltas));
+    env->GetFloatArrayRegion(deltas, 0, static_cast<jsize>(deltaValues.size()), deltaValues.data());
+
+    const char *nameChars = env->GetStringUTFChars(name, nullptr);
+    std::string shapeName(nameChars);
+    env->ReleaseStringUTFChars(name, nameChars);
+
+    try
+    {
+        return static_cast<jint>(getBlendShapes(env, obj)->addShape(shapeName, std::vector<uint32_t>(indexValues.begin(), indexValues.end()), deltaValues));
+    }
+    catch (const std::exception &e)
+    {
+        throwFbxError(env, e.what());
+        return -1;
+    }
+}
+
+/**
+ * @brief JNI function to add a shape from a delta for every vertex.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ * @param name The shape name.
+ * @param deltas x, y and z per vertex.
+ * @return The shape index.
+ */
+JNIEXPORT jint JNICALL Java_com_github_nodedev74_jfbx_anim_BlendShapes_addDenseShape(JNIEnv *env, jobject obj, jstring name, jfloatArray deltas)
+{
+    std::vector<float> deltaValues(env->GetArrayLength(deltas));
+    env->GetFloatArrayRegion(deltas, 0, static_cast<jsize>(deltaValues.size()), deltaValues.data());
+
+    const char *nameChars = env->GetStringUTFChars(name, nullptr);
+    std::string shapeName(nameChars);
+    env->ReleaseStringUTFChars(name, nameChars);
+
+    try
+    {
+        return static_cast<jint>(getBlendShapes(env, obj)->addDenseShape(shapeName, deltaValues));
+    }
+    catch (const std::exception &e)
+    {
+        throwFbxError(env, e.what());
+        return -1;
+    }
+}
+
+/**
+ * @brief JNI function to retrieve the number of vertices.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ * @return The vertex count.
+ */
+JNIEXPORT jint JNICALL Java_com_github_nodedev74_jfbx_anim_BlendShapes_getVertexCount(JNIEnv *env, jobject obj)
+{
+    return static_cast<jint>(getBlendShapes(env, obj)->getVertexCount());
+}
+
+/**
+ * @brief JNI function to retrieve the number of shapes.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ * @return The shape count.
+ */
+JNIEXPORT jint JNICALL Java_com_github_nodedev74_jfbx_anim_BlendShapes_getShapeCount(JNIEnv *env, jobject obj)
+{
+    return static_cast<jint>(getBlendShapes(env, obj)->getShapeCount());
+}
+
+/**
+ * @brief JNI function to retrieve the name of a shape.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ * @param shape The shape index.
+ * @return The name, or null if the index is out of range.
+ */
+JNIEXPORT jstring JNICALL Java_com_github_nodedev74_jfbx_anim_BlendShapes_getShapeName(JNIEnv *env, jobject obj, jint shape)
+{
+    BlendShapes *blendShapes = getBlendShapes(env, obj);
+    if (shape < 0 || static_cast<uint32_t>(shape) >= blendShapes->getShapeCount())
+    {
+        return nullptr;
+    }
+    return env->NewStringUTF(blendShapes->getShapeName(static_cast<uint32_t>(shape)).c_str());
+}
+
+/**
+ * @brief JNI function to retrieve the number of stored deltas.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ * @return The delta count.
+ */
+JNIEXPORT jlong JNICALL Java_com_github_nodedev74_jfbx_anim_BlendShapes_getDeltaCount(JNIEnv *env, jobject obj)
+{
+    return static_cast<jlong>(getBlendShapes(env, obj)->getDeltaCount());
+}
+
+/**
+ * @brief JNI function to set the weight of a shape.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ * @param shape The shape index, ignored if out of range.
+ * @param weight The weight.
+ */
+JNIEXPORT void JNICALL Java_com_github_nodedev74_jfbx_anim_BlendShapes_setWeight(JNIEnv *env, jobject obj, jint shape, jfloat weight)
+{
+    BlendShapes *blendShapes = getBlendShapes(env, obj);
+    if (shape >= 0 && static_cast<uint32_t>(shape) < blendShapes->getShapeCount())
+    {
+        blendShapes->setWeight(static_cast<uint32_t>(shape), weight);
+    }
+}
+
+/**
+ * @brief JNI function to retrieve the weight of a shape.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ * @param shape The shape index.
+ * @return The weight, or 0 if the index is out of range.
+ */
+JNIEXPORT jfloat JNICALL Java_com_github_nodedev74_jfbx_anim_BlendShapes_getWeight(JNIEnv *env, jobject obj, jint shape)
+{
+    BlendShapes *blendShapes = getBlendShapes(env, obj);
+    if (shape < 0 || static_cast<uint32_t>(shape) >= blendShapes->getShapeCount())
+    {
+        return 0.0f;
+    }
+    return blendShapes->getWeight(static_cast<uint32_t>(shape));
+}
+
+/**
+ * @brief JNI function to retrieve the memory used by positions, indices and deltas.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ * @return The size in bytes.
+ */
+JNIEXPORT jlong JNICALL Java_com_github_nodedev74_jfbx_anim_BlendShapes_getMemorySize(JNIEnv *env, jobject obj)
+{
+    return static_cast<jlong>(getBlendShapes(env, obj)->getMemorySize());
+}
+
+/**
+ * @brief JNI function to evaluate all vertices.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ * @param out Receives x, y, z and 1 per vertex.
+ * @param parallel True to evaluate on the shared thread pool.
+ */
+JNIEXPORT void JNICALL Java_com_github_nodedev74_jfbx_anim_BlendShapes_evaluate(JNIEnv *env, jobject obj, jfloatArray out, jboolean parallel)
+{
+    BlendShapes *blendShapes = getBlendShapes(env, obj);
+
+    jsize count = std::min<jsize>(env->GetArrayLength(out), static_cast<jsize>(blendShapes->getVertexCount()) * 4);
+    float *values = static_cast<float *>(env->GetPrimitiveArrayCritical(out, nullptr));
+    if (count == static_cast<jsize>(blendShapes->getVertexCount()) * 4)
+    {
+        blendShapes->evaluate(parallel ? &ThreadPool::shared() : nullptr, values);
+    }
+    env->ReleasePrimitiveArrayCritical(out, values, 0);
+}
+
+/**
+ * @brief JNI function to release the native blend shapes.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ */
+JNIEXPORT void JNICALL Java_com_github_nodedev74_jfbx_anim_BlendShapes_destroy(JNIEnv *env, jobject obj)
+{
+    delete getBlendShapes(env, obj);
+
+    jclass cls = env->GetObjectClass(obj);
+    jfieldID fieldID = env->GetFieldID(cls, "blendShapesPtr", "J");
+    env->SetLongField(obj, fieldID, 0);
+}
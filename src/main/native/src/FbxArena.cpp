@@ -0,0 +1,155 @@
+/**
+ * @file FbxArena.cpp
+ * @author Lenard Büsing (nodedev74@gmail.com)
+ * @brief Implementation of the monotonic and scratch arenas.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2023 Lenard Büsing
+ *
+ */
+
+#include "fbx/FbxArena.hpp"
+
+#include <algorithm>
+#include <new>
+#include <utility>
+
+namespace
+{
+    const size_t MIN_CHUNK_SIZE = 64 * 1024;
+    const size_t MAX_CHUNK_SIZE = 4 * 1024 * 1024;
+}
+
+FbxArena::FbxArena(bool monotonic) : monotonic(monotonic)
+{
+}
+
+FbxArena::~FbxArena()
+{
+    release();
+}
+
+FbxArena::FbxArena(FbxArena &&other) noexcept
+    : monotonic(other.monotonic), chunks(std::move(other.chunks)), large(std::move(other.large)), offset(other.offset),
+      allocatedBytes(other.allocatedBytes), allocationCount(other.allocationCount), reservedBytes(other.reservedBytes)
+{
+    other.chunks.clear();
+    other.large.clear();
+    other.offset = 0;
+    other.reservedBytes = 0;
+}
+
+FbxArena &FbxArena::operator=(FbxArena &&other) noexcept
+{
+    if (this != &other)
+    {
+        release();
+        monotonic = other.monotonic;
+        chunks = std::move(other.chunks);
+        large = std::move(other.large);
+        offset = other.offset;
+        allocatedBytes = other.allocatedBytes;
+        allocationCount = other.allocationCount;
+        reservedBytes = other.reservedBytes;
+        other.chunks.clear();
+        other.large.clear();
+        other.offset = 0;
+        other.reservedBytes = 0;
+    }
+    return *this;
+}
+
+void *FbxArena::allocate(size_t size, size_t alignment)
+{
+    allocatedBytes += size;
+    allocationCount++;
+
+    if (!monotonic || size > MIN_CHUNK_SIZE / 2)
+    {
+        uint8_t *data = static_cast<uint8_t *>(::operator new(std::max<size_t>(size, 1)));
+        large.push_back({data, size});
+        reservedBytes += size;
+        return data;
+    }
+
+    size_t aligned = (offset + alignment - 1) & ~(alignment - 1);
+    if (chunks.empty() || aligned + size > chunks.back().size)
+    {
+        size_t chunkSize = chunks.empty() ? MIN_CHUNK_SIZE : std::min(chunks.back().size * 2, MAX_CHUNK_SIZE);
+        chunks.push_back({static_cast<uint8_t *>(::operator new(chunkSize)), chunkSize});
+        reservedBytes += chunkSize;
+        aligned = 0;
+    }
+    offset = aligned + size;
+    return chunks.back().data + aligned;
+}
+
+FbxArenaMark FbxArena::getMark() const
+{
+    FbxArenaMark mark;
+    mark.chunk = chunks.size();
+    mark.offset = offset;
+    mark.largeCount = large.size();
+    return mark;
+}
+
+void FbxArena::rewind(const FbxArenaMark &mark)
+{
+    // The first chunk stays for the next user even when the mark was taken before it existed
+    freeBlocks(chunks, std::max<size_t>(mark.chunk, 1));
+    freeBlocks(large, mark.largeCount);
+    offset = mark.chunk > 0 ? mark.offset : 0;
+}
+
+void FbxArena::release()
+{
+    freeBlocks(chunks, 0);
+    freeBlocks(large, 0);
+    offset = 0;
+}
+
+bool FbxArena::isMonotonic() const
+{
+    return monotonic;
+}
+
+uint64_t FbxArena::getAllocatedBytes() const
+{
+    return allocatedBytes;
+}
+
+uint64_t FbxArena::getAllocationCount() const
+{
+    return allocationCount;
+}
+
+uint64_t FbxArena::getReservedBytes() const
+{
+    return reservedBytes;
+}
+
+FbxArena &FbxArena::scratch()
+{
+    static thread_local FbxArena arena;
+    return arena;
+}
+
+void FbxArena::freeBlocks(std::vector<FbxArenaBlock> &blocks, size_t first)
+{
+    for (size_t i = first; i < blocks.size(); i++)
+    {
+        ::operator delete(blocks[i].data);
+        reservedBytes -= blocks[i].size;
+    }
+    blocks.resize(std::min(first, blocks.size()));
+}
+
+FbxArenaScope::FbxArenaScope(FbxArena &arena) : arena(arena), mark(arena.getMark())
+{
+}
+
+FbxArenaScope::~FbxArenaScope()
+{
+    arena.rewind(mark);
+}
@@ -0,0 +1,179 @@
+/**
+ * @file FbxConnectionGraph.cpp
+ * @author Lenard Büsing (nodedev74@gmail.com)
+ * @brief Implementation of the object id lookup and the connection adjacency.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2023 Lenard Büsing
+ *
+ */
+
+#include "fbx/FbxConnectionGraph.hpp"
+
+namespace
+{
+    /**
+     * @brief Mixes the bits of an id, ids are often sequential or share their low bits.
+     */
+    uint64_t mixId(int64_t id)
+    {
+        uint64_t x = static_cast<uint64_t>(id);
+        x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        x = (x ^ (x >> 27)) * 0x94D049BB133111EBULL;
+        return x ^ (x >> 31);
+    }
+}
+
+void FbxIdMap::reserve(size_t count)
+{
+    size_t capacity = 16;
+    while (capacity < count * 2)
+    {
+        capacity *= 2;
+    }
+    keys.assign(capacity, 0);
+    values.assign(capacity, -1);
+    this->count = 0;
+}
+
+void FbxIdMap::insert(int64_t id, int32_t value)
+{
+    if ((count + 1) * 2 > values.size())
+    {
+        rehash(values.empty() ? 16 : values.size() * 2);
+    }
+
+    size_t mask = values.size() - 1;
+    for (size_t slot = mixId(id) & mask;; slot = (slot + 1) & mask)
+    {
+        if (values[slot] < 0)
+        {
+            keys[slot] = id;
+            values[slot] = value;
+            count++;
+            return;
+        }
+        if (keys[slot] == id)
+        {
+            values[slot] = value;
+            return;
+        }
+    }
+}
+
+int32_t FbxIdMap::find(int64_t id) const
+{
+    if (values.empty())
+    {
+        return -1;
+    }
+
+    size_t mask = values.size() - 1;
+    for (size_t slot = mixId(id) & mask;; slot = (slot + 1) & mask)
+    {
+        if (values[slot] < 0 || keys[slot] == id)
+        {
+            return values[slot];
+        }
+    }
+}
+
+size_t FbxIdMap::size() const
+{
+    return count;
+}
+
+void FbxIdMap::rehash(size_t capacity)
+{
+    std::vector<int64_t> oldKeys = std::move(keys);
+    std::vector<int32_t> oldValues = std::move(values);
+    keys.assign(capacity, 0);
+    values.assign(capacity, -1);
+    count = 0;
+    for (size_t i = 0; i < oldValues.size(); i++)
+    {
+        if (oldValues[i] >= 0)
+        {
+            insert(oldKeys[i], oldValues[i]);
+        }
+    }
+}
+
+const FbxEdge *FbxEdgeRange::begin() const
+{
+    return first;
+}
+
+const FbxEdge *FbxEdgeRange::end() const
+{
+    return last;
+}
+
+size_t FbxEdgeRange::size() const
+{
+    return static_cast<size_t>(last - first);
+}
+
+void FbxConnectionGraph::build(const std::vector<int64_t> &objectIds, const std::vector<FbxConnection> &connections)
+{
+    objectIndices.reserve(objectIds.size());
+    for (size_t i = 0; i < objectIds.size(); i++)
+    {
+        objectIndices.insert(objectIds[i], static_cast<int32_t>(i));
+    }
+
+    // Counting sort by object: count, prefix sum, then scatter in connection order
+    std::vector<int32_t> children(connections.size());
+    std::vector<int32_t> parents(connections.size());
+    childOffsets.assign(objectIds.size() + 1, 0);
+    parentOffsets.assign(objectIds.size() + 1, 0);
+    for (size_t i = 0; i < connections.size(); i++)
+    {
+        children[i] = objectIndices.find(connections[i].child);
+        parents[i] = objectIndices.find(connections[i].parent);
+        if (children[i] >= 0 && parents[i] >= 0)
+        {
+            childOffsets[parents[i] + 1]++;
+            parentOffsets[children[i] + 1]++;
+        }
+    }
+    for (size_t i = 0; i < objectIds.size(); i++)
+    {
+        childOffsets[i + 1] += childOffsets[i];
+        parentOffsets[i + 1] += parentOffsets[i];
+    }
+
+    childEdges.resize(childOffsets.back());
+    parentEdges.resize(parentOffsets.back());
+    std::vector<uint32_t> childCursors(childOffsets.begin(), childOffsets.end() - 1);
+    std::vector<uint32_t> parentCursors(parentOffsets.begin(), parentOffsets.end() - 1);
+    for (size_t i = 0; i < connections.size(); i++)
+    {
+        if (children[i] >= 0 && parents[i] >= 0)
+        {
+            childEdges[childCursors[parents[i]]++] = {children[i], static_cast<int32_t>(i)};
+            parentEdges[parentCursors[children[i]]++] = {parents[i], static_cast<int32_t>(i)};
+        }
+    }
+}
+
+int32_t FbxConnectionGraph::findObject(int64_t id) const
+{
+    return objectIndices.find(id);
+}
+
+uint32_t FbxConnectionGraph::getObjectCount() const
+{
+    return childOffsets.empty() ? 0 : static_cast<uint32_t>(childOffsets.size() - 1);
+}
+
+FbxEdgeRange FbxConnectionGraph::getChildren(uint32_t object) const
+{
+    return {childEdges.data() + childOffsets[object], childEdges.data() + childOffsets[object + 1]};
+}
+
+FbxEdgeRange FbxConnectionGraph::getParents(uint32_t object) const
+{
+    return {parentEdges.data() + parentOffsets[object], parentEdges.data() + parentOffsets[object + 1]};
+}
@@ -0,0 +1,494 @@
+/**
+ * @file FbxDocument.cpp
+ * @author Lenard Büsing (nodedev74@gmail.com)
+ * @brief Implementation of the binary FBX reader.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2023 Lenard Büsing
+ *
+ */
+
+#include "fbx/FbxDocument.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <new>
+#include <stdexcept>
+
+#include <zlib.h>
+
+namespace
+{
+    const char FBX_MAGIC[] = "Kaydara FBX Binary  ";
+
+    /**
+     * @brief Sequential reader over the file content with bounds checking.
+     */
+    struct FbxReader
+    {
+        const uint8_t *data;
+        size_t size;
+        size_t offset;
+        bool wideRecords;
+        uint64_t base;
+        FbxArena *arena;
+
+        void require(size_t count) const
+        {
+            if (count > size || offset > size - count)
+            {
+                throw std::runtime_error("Unexpected end of FBX data");
+            }
+        }
+
+        template <typename T>
+        T read()
+        {
+            require(sizeof(T));
+            T value;
+            std::memcpy(&value, data + offset, sizeof(T));
+            offset += sizeof(T);
+            return value;
+        }
+
+        uint64_t readRecordValue()
+        {
+            return wideRecords ? read<uint64_t>() : read<uint32_t>();
+        }
+
+        const char *readBytes(size_t count)
+        {
+            require(count);
+            char *out = static_cast<char *>(arena->allocate(count, 1));
+            std::memcpy(out, data + offset, count);
+            offset += count;
+            return out;
+        }
+
+        /**
+         * @brief Reads the end offset of the record at a position without moving, 0 for the null record.
+         */
+        uint64_t peekRecordEnd(size_t position) const
+        {
+            size_t headerSize = wideRecords ? 25 : 13;
+            if (headerSize > size || position > size - headerSize)
+            {
+                throw std::runtime_error("Unexpected end of FBX data");
+            }
+            uint64_t endOffset = 0;
+            std::memcpy(&endOffset, data + position, wideRecords ? sizeof(uint64_t) : sizeof(uint32_t));
+            return endOffset;
+        }
+    };
+
+    /**
+     * @brief Places default constructed elements in an arena, an empty list allocates nothing.
+     */
+    template <typename T>
+    FbxSpan<T> allocateSpan(FbxArena &arena, uint32_t count)
+    {
+        FbxSpan<T> span;
+        if (count > 0)
+        {
+            span.items = static_cast<T *>(arena.allocate(sizeof(T) * count, alignof(T)));
+            span.count = count;
+            for (uint32_t i = 0; i < count; i++)
+            {
+                new (&span.items[i]) T();
+            }
+        }
+        return span;
+    }
+
+    size_t arrayElementSize(char type)
+    {
+        switch (type)
+        {
+        case 'b':
+            return 1;
+        case 'i':
+        case 'f':
+            return 4;
+        case 'l':
+        case 'd':
+            return 8;
+        default:
+            throw std::runtime_error(std::string("Unknown FBX array type ") + type);
+        }
+    }
+
+    voidpf allocateScratch(voidpf opaque, uInt items, uInt size)
+    {
+        return static_cast<FbxArena *>(opaque)->allocate(static_cast<size_t>(items) * size, 16);
+    }
+
+    void freeScratch(voidpf, voidpf)
+    {
+    }
+
+    /**
+     * @brief Inflates an array, with the zlib state and window taken from the scratch arena of the
+     * thread instead of a heap allocation per array unless the document avoids arenas.
+     */
+    void inflateArray(const uint8_t *source, uint32_t sourceLength, char *out, size_t length, bool scratch)
+    {
+        if (!scratch)
+        {
+            uLongf destinationLength = static_cast<uLongf>(length);
+            int result = uncompress(reinterpret_cast<Bytef *>(out), &destinationLength, source, sourceLength);
+            if (result != Z_OK || destinationLength != length)
+            {
+                throw std::runtime_error("Failed to inflate FBX array");
+            }
+            return;
+        }
+
+        FbxArena &arena = FbxArena::scratch();
+        FbxArenaScope scope(arena);
+        z_stream stream{};
+        stream.zalloc = allocateScratch;
+        stream.zfree = freeScratch;
+        stream.opaque = &arena;
+        stream.next_in = const_cast<Bytef *>(source);
+        stream.avail_in = sourceLength;
+        if (inflateInit(&stream) != Z_OK)
+        {
+            throw std::runtime_error("Failed to inflate FBX array");
+        }
+
+        // An empty array still needs room to detect surplus output, as in uncompress
+        Bytef empty;
+        stream.next_out = length > 0 ? reinterpret_cast<Bytef *>(out) : &empty;
+        size_t left = length > 0 ? length : 1;
+        int result = Z_OK;
+        while (result == Z_OK)
+        {
+            if (stream.avail_out == 0)
+            {
+                stream.avail_out = static_cast<uInt>(std::min<size_t>(left, UINT32_MAX));
+                left -= stream.avail_out;
+            }
+            result = inflate(&stream, Z_NO_FLUSH);
+        }
+        uLong produced = stream.total_out;
+        inflateEnd(&stream);
+        if (result != Z_STREAM_END || produced != length)
+        {
+            throw std::runtime_error("Failed to inflate FBX array");
+        }
+    }
+
+    void readArray(FbxReader &reader, FbxProperty &property)
+    {
+        uint32_t count = reader.read<uint32_t>();
+        uint32_t encoding = reader.read<uint32_t>();
+        uint32_t compressedLength = reader.read<uint32_t>();
+        size_t length = static_cast<size_t>(count) * arrayElementSize(property.type);
+
+        property.count = count;
+        property.size = length;
+        if (encoding == 0)
+        {
+            if (compressedLength != length)
+            {
+                throw std::runtime_error("FBX array length mismatch");
+            }
+            property.data = reader.readBytes(length);
+            return;
+        }
+        if (encoding != 1)
+        {
+            throw std::runtime_error("Unknown FBX array encoding");
+        }
+
+        // Deflate expands at most about 1032 to 1, a larger length comes from a damaged header
+        reader.require(compressedLength);
+        if (length > static_cast<size_t>(compressedLength) * 1032 + 64)
+        {
+            throw std::runtime_error("FBX array length mismatch");
+        }
+        char *out = static_cast<char *>(reader.arena->allocate(length, 8));
+        inflateArray(reader.data + reader.offset, compressedLength, out, length, reader.arena->isMonotonic());
+        property.data = out;
+        reader.offset += compressedLength;
+    }
+
+    void readProperty(FbxReader &reader, FbxProperty &property)
+    {
+        property.type = static_cast<char>(reader.read<uint8_t>());
+        switch (property.type)
+        {
+        case 'Y':
+            property.integer = reader.read<int16_t>();
+            break;
+        case 'C':
+            property.integer = reader.read<uint8_t>();
+            break;
+        case 'I':
+            property.integer = reader.read<int32_t>();
+            break;
+        case 'L':
+            property.integer = reader.read<int64_t>();
+            break;
+        case 'F':
+            property.number = reader.read<float>();
+            break;
+        case 'D':
+            property.number = reader.read<double>();
+            break;
+        case 'S':
+        case 'R':
+            property.size = reader.read<uint32_t>();
+            property.data = reader.readBytes(property.size);
+            break;
+        case 'f':
+        case 'd':
+        case 'l':
+        case 'i':
+        case 'b':
+            readArray(reader, property);
+            break;
+        default:
+            throw std::runtime_error(std::string("Unknown FBX property type ") + property.type);
+        }
+    }
+
+    FbxSpan<FbxProperty> readProperties(FbxReader &reader, uint64_t count)
+    {
+        // Every property takes at least its type byte, a larger count cannot be satisfied
+        if (count > reader.size - std::min(reader.offset, reader.size))
+        {
+            throw std::runtime_error("Invalid FBX property count");
+        }
+        FbxSpan<FbxProperty> properties = allocateSpan<FbxProperty>(*reader.arena, static_cast<uint32_t>(count));
+        for (FbxProperty &property : properties)
+        {
+            readProperty(reader, property);
+        }
+        return properties;
+    }
+
+    bool readNode(FbxReader &reader, FbxNode &node);
+
+    /**
+     * @brief Reads the records up to an end offset or a null record into the children of a node.
+     *
+     * The records are counted through their end offsets first, so the list is allocated once at its
+     * final size instead of growing record by record.
+     */
+    void readChildren(FbxReader &reader, FbxNode &node, uint64_t endOffset)
+    {
+        uint32_t count = 0;
+        for (uint64_t position = reader.offset; position < endOffset; count++)
+        {
+            uint64_t childEnd = reader.peekRecordEnd(static_cast<size_t>(position));
+            if (childEnd == 0)
+            {
+                break;
+            }
+            childEnd = childEnd >= reader.base ? childEnd - reader.base : 0;
+            if (childEnd <= position || childEnd > reader.size)
+            {
+                throw std::runtime_error("Invalid FBX record end offset");
+            }
+            position = childEnd;
+        }
+
+        node.children = allocateSpan<FbxNode>(*reader.arena, count);
+        for (FbxNode &child : node.children)
+        {
+            readNode(reader, child);
+        }
+    }
+
+    /**
+     * @brief Reads a node record.
+     *
+     * @return False if the record was the null record terminating a list.
+     */
+    bool readNode(FbxReader &reader, FbxNode &node)
+    {
+        uint64_t endOffset = reader.readRecordValue();
+        uint64_t propertyCount = reader.readRecordValue();
+        reader.readRecordValue();
+        uint8_t nameLength = reader.read<uint8_t>();
+
+        if (endOffset == 0)
+        {
+            return false;
+        }
+        // End offsets are absolute in the file, the data may start at a record within it
+        endOffset = endOffset >= reader.base ? endOffset - reader.base : 0;
+        if (endOffset > reader.size || endOffset < reader.offset)
+        {
+            throw std::runtime_error("Invalid FBX record end offset");
+        }
+
+        node.name = std::string_view(reader.readBytes(nameLength), nameLength);
+        node.properties = readProperties(reader, propertyCount);
+        readChildren(reader, node, endOffset);
+        reader.offset = endOffset;
+        return true;
+    }
+
+    template <typename T, typename S>
+    void convertArray(const char *source, uint32_t count, std::vector<T> &out)
+    {
+        out.resize(count);
+        for (uint32_t i = 0; i < count; i++)
+        {
+            S value;
+            std::memcpy(&value, source + i * sizeof(S), sizeof(S));
+            out[i] = static_cast<T>(value);
+        }
+    }
+}
+
+bool FbxProperty::isArray() const
+{
+    return type == 'f' || type == 'd' || type == 'l' || type == 'i' || type == 'b';
+}
+
+int64_t FbxProperty::asInteger() const
+{
+    if (type == 'F' || type == 'D')
+    {
+        return static_cast<int64_t>(number);
+    }
+    return integer;
+}
+
+double FbxProperty::asNumber() const
+{
+    if (type == 'F' || type == 'D')
+    {
+        return number;
+    }
+    return static_cast<double>(integer);
+}
+
+std::string_view FbxProperty::asString() const
+{
+    return std::string_view(data, size);
+}
+
+template <typename T>
+std::vector<T> FbxProperty::asArray() const
+{
+    std::vector<T> out;
+    switch (type)
+    {
+    case 'f':
+        convertArray<T, float>(data, count, out);
+        break;
+    case 'd':
+        convertArray<T, double>(data, count, out);
+        break;
+    case 'l':
+        convertArray<T, int64_t>(data, count, out);
+        break;
+    case 'i':
+        convertArray<T, int32_t>(data, count, out);
+        break;
+    case 'b':
+        convertArray<T, uint8_t>(data, count, out);
+        break;
+    default:
+        break;
+    }
+    return out;
+}
+
+template std::vector<float> FbxProperty::asArray<float>() const;
+template std::vector<double> FbxProperty::asArray<double>() const;
+template std::vector<int32_t> FbxProperty::asArray<int32_t>() const;
+template std::vector<int64_t> FbxProperty::asArray<int64_t>() const;
+
+const FbxNode *FbxNode::find(const char *childName) const
+{
+    for (const FbxNode &child : children)
+    {
+        if (child.name == childName)
+        {
+            return &child;
+        }
+    }
+    return nullptr;
+}
+
+FbxDocument FbxDocument::load(const std::string &path, bool monotonic)
+{
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file.is_open())
+    {
+        throw std::runtime_error("Failed to open FBX file: " + path);
+    }
+
+    std::streamsize size = file.tellg();
+    file.seekg(0, std::ios::beg);
+
+    std::vector<uint8_t> content(static_cast<size_t>(size));
+    if (!file.read(reinterpret_cast<char *>(content.data()), size))
+    {
+        throw std::runtime_error("Failed to read FBX file: " + path);
+    }
+    return parse(content.data(), content.size(), monotonic);
+}
+
+FbxDocument FbxDocument::parse(const uint8_t *data, size_t size, bool monotonic)
+{
+    if (size < 27 || std::memcmp(data, FBX_MAGIC, sizeof(FBX_MAGIC) - 1) != 0)
+    {
+        throw std::runtime_error("Not a binary FBX file");
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    FbxDocument document;
+    document.arena = FbxArena(monotonic);
+    std::memcpy(&document.version, data + 23, sizeof(uint32_t));
+
+    FbxReader reader{data, size, 27, document.version >= 7500, 0, &document.arena};
+    readChildren(reader, document.root, size);
+    document.parseTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    return document;
+}
+
+FbxNode FbxDocument::parseRecord(const uint8_t *data, size_t size, uint64_t offset, uint32_t version, FbxArena &arena)
+{
+    FbxReader reader{data, size, 0, version >= 7500, offset, &arena};
+    FbxNode node;
+    if (!readNode(reader, node))
+    {
+        throw std::runtime_error("Unexpected null FBX record");
+    }
+    return node;
+}
+
+FbxSpan<FbxProperty> FbxDocument::parseProperties(const uint8_t *data, size_t size, uint32_t count, FbxArena &arena)
+{
+    FbxReader reader{data, size, 0, false, 0, &arena};
+    return readProperties(reader, count);
+}
+
+uint32_t FbxDocument::getVersion() const
+{
+    return version;
+}
+
+const FbxNode &FbxDocument::getRoot() const
+{
+    return root;
+}
+
+const FbxArena &FbxDocument::getArena() const
+{
+    return arena;
+}
+
+double FbxDocument::getParseTime() const
+{
+    return parseTime;
+}
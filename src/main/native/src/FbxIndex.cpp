@@ -0,0 +1,680 @@
+/**
+ * @file FbxIndex.cpp
+ * @author Lenard Büsing (nodedev74@gmail.com)
+ * @brief Implementation of the FBX object index and its on demand reads.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2023 Lenard Büsing
+ *
+ */
+
+#include "com_github_nodedev74_jfbx_fbx_FbxIndex.h"
+#include <jni.h>
+
+#include "fbx/FbxIndex.hpp"
+#include "core/Tracer.hpp"
+
+#include <cstring>
+#include <stdexcept>
+
+namespace
+{
+    const char FBX_MAGIC[] = "Kaydara FBX Binary  ";
+
+    /**
+     * @brief Strips the class suffix of an object name, "Cube\x00\x01Model" becomes "Cube".
+     */
+    std::string objectName(std::string_view name)
+    {
+        return std::string(name.substr(0, name.find(std::string_view("\x00\x01", 2))));
+    }
+
+    void throwFbxError(JNIEnv *env, const char *what)
+    {
+        jclass exceptionClass = env->FindClass("com/github/nodedev74/jfbx/exception/FbxRuntimeError");
+        jmethodID constructorID = env->GetMethodID(exceptionClass, "<init>", "(Ljava/lang/String;)V");
+        jstring message = env->NewStringUTF(what);
+        jobject exceptionObject = env->NewObject(exceptionClass, constructorID, message);
+        env->Throw(static_cast<jthrowable>(exceptionObject));
+    }
+
+    FbxIndex *getIndex(JNIEnv *env, jobject obj)
+    {
+        jclass cls = env->GetObjectClass(obj);
+        jfieldID fieldID = env->GetFieldID(cls, "indexPtr", "J");
+        return reinterpret_cast<FbxIndex *>(env->GetLongField(obj, fieldID));
+    }
+
+    const FbxObjectEntry *getEntry(JNIEnv *env, jobject obj, jint index)
+    {
+        try
+        {
+            return &getIndex(env, obj)->getObject(static_cast<uint32_t>(index));
+        }
+        catch (const std::exception &e)
+        {
+            throwFbxError(env, e.what());
+            return nullptr;
+        }
+    }
+
+    jintArray toIntArray(JNIEnv *env, const std::vector<int32_t> &values)
+    {
+        jintArray array = env->NewIntArray(static_cast<jsize>(values.size()));
+        env->SetIntArrayRegion(array, 0, static_cast<jsize>(values.size()), reinterpret_cast<const jint *>(values.data()));
+        return array;
+    }
+}
+
+FbxIndex::FbxIndex(const std::string &path) : file(path, std::ios::binary | std::ios::ate)
+{
+    if (!file.is_open())
+    {
+        throw std::runtime_error("Failed to open FBX file: " + path);
+    }
+    fileSize = static_cast<uint64_t>(file.tellg());
+
+    std::vector<uint8_t> header = readRange(0, 27);
+    if (std::memcmp(header.data(), FBX_MAGIC, sizeof(FBX_MAGIC) - 1) != 0)
+    {
+        throw std::runtime_error("Not a binary FBX file");
+    }
+    std::memcpy(&version, header.data() + 23, sizeof(uint32_t));
+    if (version < 7000)
+    {
+        throw std::runtime_error("Unsupported FBX version " + std::to_string(version));
+    }
+
+    // Only Objects is entered, the other top level records are skipped as a whole
+    uint64_t offset = 27;
+    uint64_t headerSize = version >= 7500 ? 25 : 13;
+    while (offset + headerSize <= fileSize)
+    {
+        RecordHeader record = readHeader(offset);
+        if (record.endOffset == 0)
+        {
+            break;
+        }
+        if (record.name == "Objects")
+        {
+            indexObjects(record.propertyOffset + record.propertyLength, record.endOffset);
+        }
+        else if (record.name == "Connections")
+        {
+            connectionsOffset = offset;
+            connectionsEndOffset = record.endOffset;
+        }
+        offset = record.endOffset;
+    }
+}
+
+uint32_t FbxIndex::getVersion() const
+{
+    return version;
+}
+
+const std::vector<FbxObjectEntry> &FbxIndex::getObjects() const
+{
+    return objects;
+}
+
+const FbxObjectEntry &FbxIndex::getObject(uint32_t object) const
+{
+    if (object >= objects.size())
+    {
+        throw std::runtime_error("FBX object index out of range");
+    }
+    return objects[object];
+}
+
+int32_t FbxIndex::findObject(int64_t id) const
+{
+    return objectIndices.find(id);
+}
+
+std::vector<int32_t> FbxIndex::findObjects(const std::string &objectClass, const std::string &name) const
+{
+    std::vector<int32_t> found;
+    for (size_t i = 0; i < objects.size(); i++)
+    {
+        if ((objectClass.empty() || objects[i].objectClass == objectClass) && (name.empty() || objects[i].name == name))
+        {
+            found.push_back(static_cast<int32_t>(i));
+        }
+    }
+    return found;
+}
+
+std::vector<int32_t> FbxIndex::getChildren(uint32_t object)
+{
+    getObject(object);
+    readConnections();
+    std::vector<int32_t> children;
+    for (const FbxEdge &edge : graph.getChildren(object))
+    {
+        children.push_back(edge.object);
+    }
+    return children;
+}
+
+std::vector<int32_t> FbxIndex::getParents(uint32_t object)
+{
+    getObject(object);
+    readConnections();
+    std::vector<int32_t> parents;
+    for (const FbxEdge &edge : graph.getParents(object))
+    {
+        parents.push_back(edge.object);
+    }
+    return parents;
+}
+
+const FbxNode &FbxIndex::readObject(uint32_t object)
+{
+    auto cached = records.find(object);
+    if (cached != records.end())
+    {
+        return cached->second.node;
+    }
+
+    TRACE_ZONE("FbxIndex.readObject");
+
+    const FbxObjectEntry &entry = getObject(object);
+    std::vector<uint8_t> data = readRange(entry.offset, entry.endOffset - entry.offset);
+    FbxRecord record;
+    record.node = FbxDocument::parseRecord(data.data(), data.size(), entry.offset, version, record.arena);
+    return records.emplace(object, std::move(record)).first->second.node;
+}
+
+const FbxMesh &FbxIndex::readMesh(uint32_t object)
+{
+    auto mesh = meshes.find(object);
+    if (mesh != meshes.end())
+    {
+        return mesh->second;
+    }
+    const FbxObjectEntry &entry = getObject(object);
+    if (entry.objectClass != "Geometry" || entry.type != "Mesh")
+    {
+        throw std::runtime_error("Object " + std::to_string(entry.id) + " is no mesh geometry");
+    }
+
+    TRACE_ZONE("FbxIndex.readMesh");
+
+    // The record is only needed while triangulating, the arrays would double the memory held
+    std::vector<uint8_t> data = readRange(entry.offset, entry.endOffset - entry.offset);
+    FbxArenaScope scope(FbxArena::scratch());
+    FbxNode geometry = FbxDocument::parseRecord(data.data(), data.size(), entry.offset, version, FbxArena::scratch());
+    return meshes.emplace(object, FbxMesh::fromGeometry(geometry)).first->second;
+}
+
+void FbxIndex::release(uint32_t object)
+{
+    records.erase(object);
+    meshes.erase(object);
+}
+
+size_t FbxIndex::getMaterializedCount() const
+{
+    return records.size() + meshes.size();
+}
+
+uint64_t FbxIndex::getBytesRead() const
+{
+    return bytesRead;
+}
+
+FbxIndex::RecordHeader FbxIndex::readHeader(uint64_t offset)
+{
+    bool wideRecords = version >= 7500;
+    std::vector<uint8_t> data = readRange(offset, wideRecords ? 25 : 13);
+
+    RecordHeader header;
+    if (wideRecords)
+    {
+        std::memcpy(&header.endOffset, data.data(), sizeof(uint64_t));
+        std::memcpy(&header.propertyCount, data.data() + 8, sizeof(uint64_t));
+        std::memcpy(&header.propertyLength, data.data() + 16, sizeof(uint64_t));
+    }
+    else
+    {
+        uint32_t values[3];
+        std::memcpy(values, data.data(), sizeof(values));
+        header.endOffset = values[0];
+        header.propertyCount = values[1];
+        header.propertyLength = values[2];
+    }
+    if (header.endOffset == 0)
+    {
+        return header;
+    }
+
+    uint8_t nameLength = data.back();
+    std::vector<uint8_t> name = readRange(offset + data.size(), nameLength);
+    header.name.assign(name.begin(), name.end());
+    header.propertyOffset = offset + data.size() + nameLength;
+    if (header.endOffset > fileSize || header.endOffset < header.propertyOffset + header.propertyLength)
+    {
+        throw std::runtime_error("Invalid FBX record end offset");
+    }
+    return header;
+}
+
+std::vector<uint8_t> FbxIndex::readRange(uint64_t offset, uint64_t size)
+{
+    if (size > fileSize || offset > fileSize - size)
+    {
+        throw std::runtime_error("Unexpected end of FBX data");
+    }
+
+    std::vector<uint8_t> data(static_cast<size_t>(size));
+    file.seekg(static_cast<std::streamoff>(offset), std::ios::beg);
+    if (!file.read(reinterpret_cast<char *>(data.data()), static_cast<std::streamsize>(size)))
+    {
+        throw std::runtime_error("Failed to read FBX file");
+    }
+    bytesRead += size;
+    return data;
+}
+
+void FbxIndex::indexObjects(uint64_t offset, uint64_t endOffset)
+{
+    TRACE_ZONE("FbxIndex.indexObjects");
+
+    uint64_t headerSize = version >= 7500 ? 25 : 13;
+    while (offset + headerSize <= endOffset)
+    {
+        RecordHeader record = readHeader(offset);
+        if (record.endOffset == 0)
+        {
+            break;
+        }
+
+        // Object records carry their id, name and type as the first properties, all scalars or short strings
+        std::vector<uint8_t> data = readRange(record.propertyOffset, record.propertyLength);
+        FbxArenaScope scope(FbxArena::scratch());
+        FbxSpan<FbxProperty> properties = FbxDocument::parseProperties(data.data(), data.size(), static_cast<uint32_t>(record.propertyCount), FbxArena::scratch());
+        if (!properties.empty() && !properties[0].isArray())
+        {
+            FbxObjectEntry entry;
+            entry.id = properties[0].asInteger();
+            entry.name = properties.size() > 1 ? objectName(properties[1].asString()) : std::string();
+            entry.objectClass = record.name;
+            entry.type = properties.size() > 2 ? properties[2].asString() : std::string_view();
+            entry.offset = offset;
+            entry.endOffset = record.endOffset;
+            objectIndices.insert(entry.id, static_cast<int32_t>(objects.size()));
+            objects.push_back(std::move(entry));
+        }
+        offset = record.endOffset;
+    }
+}
+
+void FbxIndex::readConnections()
+{
+    if (connectionsRead)
+    {
+        return;
+    }
+
+    TRACE_ZONE("FbxIndex.readConnections");
+
+    connectionsRead = true;
+    std::vector<FbxConnection> connections;
+    std::vector<int64_t> objectIds;
+    for (const FbxObjectEntry &entry : objects)
+    {
+        objectIds.push_back(entry.id);
+    }
+    if (connectionsEndOffset == 0)
+    {
+        graph.build(objectIds, connections);
+        return;
+    }
+
+    std::vector<uint8_t> data = readRange(connectionsOffset, connectionsEndOffset - connectionsOffset);
+    FbxArenaScope scope(FbxArena::scratch());
+    FbxNode connectionList = FbxDocument::parseRecord(data.data(), data.size(), connectionsOffset, version, FbxArena::scratch());
+    for (const FbxNode &connection : connectionList.children)
+    {
+        if (connection.name != "C" || connection.properties.size() < 3)
+        {
+            continue;
+        }
+
+        FbxConnection entry;
+        entry.child = connection.properties[1].asInteger();
+        entry.parent = connection.properties[2].asInteger();
+        if (connection.properties[0].asString() == "OP" && connection.properties.size() > 3)
+        {
+            entry.property = connection.properties[3].asString();
+        }
+        connections.push_back(std::move(entry));
+    }
+    graph.build(objectIds, connections);
+}
+
+/**
+ * @brief JNI function to open an FBX file and index its objects.
+ *
+ * @param env The JNI environment.
+ * @param cls The Java class.
+ * @param path The file path.
+ * @return The native index pointer.
+ */
+JNIEXPORT jlong JNICALL Java_com_github_nodedev74_jfbx_fbx_FbxIndex_build(JNIEnv *env, jclass cls, jstring path)
+{
+    TRACE_ZONE("FbxIndex.build");
+
+    const char *chars = env->GetStringUTFChars(path, nullptr);
+    std::string filePath(chars);
+    env->ReleaseStringUTFChars(path, chars);
+
+    try
+    {
+        return reinterpret_cast<jlong>(new FbxIndex(filePath));
+    }
+    catch (const std::exception &e)
+    {
+        throwFbxError(env, e.what());
+        return 0;
+    }
+}
+
+/**
+ * @brief JNI function to retrieve the number of indexed objects.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ * @return The object count.
+ */
+JNIEXPORT jint JNICALL Java_com_github_nodedev74_jfbx_fbx_FbxIndex_getObjectCount(JNIEnv *env, jobject obj)
+{
+    return static_cast<jint>(getIndex(env, obj)->getObjects().size());
+}
+
+/**
+ * @brief JNI function to retrieve the id of an object.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ * @param index The object index.
+ * @return The object id.
+ */
+JNIEXPORT jlong JNICALL Java_com_github_nodedev74_jfbx_fbx_FbxIndex_getObjectId(JNIEnv *env, jobject obj, jint index)
+{
+    const FbxObjectEntry *entry = getEntry(env, obj, index);
+    return entry != nullptr ? static_cast<jlong>(entry->id) : 0;
+}
+
+/**
+ * @brief JNI function to retrieve the name of an object.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ * @param index The object index.
+ * @return The object name.
+ */
+JNIEXPORT jstring JNICALL Java_com_github_nodedev74_jfbx_fbx_FbxIndex_getObjectName(JNIEnv *env, jobject obj, jint index)
+{
+    const FbxObjectEntry *entry = getEntry(env, obj, index);
+    return entry != nullptr ? env->NewStringUTF(entry->name.c_str()) : nullptr;
+}
+
+/**
+ * @brief JNI function to retrieve the class of an object.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ * @param index The object index.
+ * @return The record name, e.g. Geometry.
+ */
+JNIEXPORT jstring JNICALL Java_com_github_nodedev74_jfbx_fbx_FbxIndex_getObjectClass(JNIEnv *env, jobject obj, jint index)
+{
+    const FbxObjectEntry *entry = getEntry(env, obj, index);
+    return entry != nullptr ? env->NewStringUTF(entry->objectClass.c_str()) : nullptr;
+}
+
+/**
+ * @brief JNI function to retrieve the type of an object.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ * @param index The object index.
+ * @return The type, e.g. Mesh, or an empty string.
+ */
+JNIEXPORT jstring JNICALL Java_com_github_nodedev74_jfbx_fbx_FbxIndex_getObjectType(JNIEnv *env, jobject obj, jint index)
+{
+    const FbxObjectEntry *entry = getEntry(env, obj, index);
+    return entry != nullptr ? env->NewStringUTF(entry->type.c_str()) : nullptr;
+}
+
+/**
+ * @brief JNI function to find the object with an id.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ * @param id The object id.
+ * @return The object index or -1.
+ */
+JNIEXPORT jint JNICALL Java_com_github_nodedev74_jfbx_fbx_FbxIndex_findObject(JNIEnv *env, jobject obj, jlong id)
+{
+    return static_cast<jint>(getIndex(env, obj)->findObject(id));
+}
+
+/**
+ * @brief JNI function to find the objects of a class with a name.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ * @param objectClass The record name, or null for any class.
+ * @param name The object name, or null for any name.
+ * @return The object indices in file order.
+ */
+JNIEXPORT jintArray JNICALL Java_com_github_nodedev74_jfbx_fbx_FbxIndex_findObjects(JNIEnv *env, jobject obj, jstring objectClass, jstring name)
+{
+    std::string classFilter;
+    std::string nameFilter;
+    if (objectClass != nullptr)
+    {
+        const char *chars = env->GetStringUTFChars(objectClass, nullptr);
+        classFilter = chars;
+        env->ReleaseStringUTFChars(objectClass, chars);
+    }
+    if (name != nullptr)
+    {
+        const char *chars = env->GetStringUTFChars(name, nullptr);
+        nameFilter = chars;
+        env->ReleaseStringUTFChars(name, chars);
+    }
+    return toIntArray(env, getIndex(env, obj)->findObjects(classFilter, nameFilter));
+}
+
+/**
+ * @brief JNI function to retrieve the objects connected to an object as its children.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ * @param index The object index.
+ * @return The child object indices in connection order.
+ */
+JNIEXPORT jintArray JNICALL Java_com_github_nodedev74_jfbx_fbx_FbxIndex_getChildObjects(JNIEnv *env, jobject obj, jint index)
+{
+    try
+    {
+        return toIntArray(env, getIndex(env, obj)->getChildren(static_cast<uint32_t>(index)));
+    }
+    catch (const std::exception &e)
+    {
+        throwFbxError(env, e.what());
+        return nullptr;
+    }
+}
+
+/**
+ * @brief JNI function to retrieve the objects an object is connected to as a child.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ * @param index The object index.
+ * @return The parent object indices in connection order.
+ */
+JNIEXPORT jintArray JNICALL Java_com_github_nodedev74_jfbx_fbx_FbxIndex_getParentObjects(JNIEnv *env, jobject obj, jint index)
+{
+    try
+    {
+        return toIntArray(env, getIndex(env, obj)->getParents(static_cast<uint32_t>(index)));
+    }
+    catch (const std::exception &e)
+    {
+        throwFbxError(env, e.what());
+        return nullptr;
+    }
+}
+
+/**
+ * @brief JNI function to read the numbers of a property of an object.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ * @param index The object index.
+ * @param name The property name in Properties70.
+ * @return The values of the property, or null if the object has no such property.
+ */
+JNIEXPORT jdoubleArray JNICALL Java_com_github_nodedev74_jfbx_fbx_FbxIndex_getObjectProperty(JNIEnv *env, jobject obj, jint index, jstring name)
+{
+    const char *chars = env->GetStringUTFChars(name, nullptr);
+    std::string propertyName(chars);
+    env->ReleaseStringUTFChars(name, chars);
+
+    const FbxNode *properties = nullptr;
+    try
+    {
+        properties = getIndex(env, obj)->readObject(static_cast<uint32_t>(index)).find("Properties70");
+    }
+    catch (const std::exception &e)
+    {
+        throwFbxError(env, e.what());
+        return nullptr;
+    }
+
+    // P records hold name, type, label and flags before their values
+    for (size_t i = 0; properties != nullptr && i < properties->children.size(); i++)
+    {
+        const FbxNode &property = properties->children[i];
+        if (property.name != "P" || property.properties.size() < 4 || property.properties[0].asString() != propertyName)
+        {
+            continue;
+        }
+
+        std::vector<double> values;
+        for (size_t value = 4; value < property.properties.size(); value++)
+        {
+            values.push_back(property.properties[value].asNumber());
+        }
+        jdoubleArray array = env->NewDoubleArray(static_cast<jsize>(values.size()));
+        env->SetDoubleArrayRegion(array, 0, static_cast<jsize>(values.size()), values.data());
+        return array;
+    }
+    return nullptr;
+}
+
+/**
+ * @brief JNI function to retrieve the control points of a mesh geometry.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ * @param index The object index.
+ * @return x, y and z per control point.
+ */
+JNIEXPORT jfloatArray JNICALL Java_com_github_nodedev74_jfbx_fbx_FbxIndex_getMeshPositions(JNIEnv *env, jobject obj, jint index)
+{
+    try
+    {
+        const std::vector<float> &positions = getIndex(env, obj)->readMesh(static_cast<uint32_t>(index)).positions;
+        jfloatArray array = env->NewFloatArray(static_cast<jsize>(positions.size()));
+        env->SetFloatArrayRegion(array, 0, static_cast<jsize>(positions.size()), positions.data());
+        return array;
+    }
+    catch (const std::exception &e)
+    {
+        throwFbxError(env, e.what());
+        return nullptr;
+    }
+}
+
+/**
+ * @brief JNI function to retrieve the triangle indices of a mesh geometry.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ * @param index The object index.
+ * @return Three control point indices per triangle.
+ */
+JNIEXPORT jintArray JNICALL Java_com_github_nodedev74_jfbx_fbx_FbxIndex_getMeshIndices(JNIEnv *env, jobject obj, jint index)
+{
+    try
+    {
+        const std::vector<uint32_t> &indices = getIndex(env, obj)->readMesh(static_cast<uint32_t>(index)).indices;
+        jintArray array = env->NewIntArray(static_cast<jsize>(indices.size()));
+        env->SetIntArrayRegion(array, 0, static_cast<jsize>(indices.size()), reinterpret_cast<const jint *>(indices.data()));
+        return array;
+    }
+    catch (const std::exception &e)
+    {
+        throwFbxError(env, e.what());
+        return nullptr;
+    }
+}
+
+/**
+ * @brief JNI function to drop what was read for an object.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ * @param index The object index.
+ */
+JNIEXPORT void JNICALL Java_com_github_nodedev74_jfbx_fbx_FbxIndex_release(JNIEnv *env, jobject obj, jint index)
+{
+    getIndex(env, obj)->release(static_cast<uint32_t>(index));
+}
+
+/**
+ * @brief JNI function to retrieve the number of objects currently read.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ * @return The count of records and meshes held.
+ */
+JNIEXPORT jint JNICALL Java_com_github_nodedev74_jfbx_fbx_FbxIndex_getMaterializedCount(JNIEnv *env, jobject obj)
+{
+    return static_cast<jint>(getIndex(env, obj)->getMaterializedCount());
+}
+
+/**
+ * @brief JNI function to retrieve the bytes read from the file.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ * @return The size in bytes.
+ */
+JNIEXPORT jlong JNICALL Java_com_github_nodedev74_jfbx_fbx_FbxIndex_getBytesRead(JNIEnv *env, jobject obj)
+{
+    return static_cast<jlong>(getIndex(env, obj)->getBytesRead());
+}
+
+/**
+ * @brief JNI function to close the file and release the native index.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ */
+JNIEXPORT void JNICALL Java_com_github_nodedev74_jfbx_fbx_FbxIndex_destroy(JNIEnv *env, jobject obj)
+{
+    delete getIndex(env, obj);
+
+    jclass cls = env->GetObjectClass(obj);
+    jfieldID fieldID = env->GetFieldID(cls, "indexPtr", "J");
+    env->SetLongField(obj, fieldID, 0);
+}
@@ -0,0 +1,1373 @@
+/**
+ * @file FbxScene.cpp
+ * @author Lenard Büsing (nodedev74@gmail.com)
+ * @brief Import of FBX scene objects and their connections.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2023 Lenard Büsing
+ *
+ */
+
+#include "com_github_nodedev74_jfbx_fbx_FbxScene.h"
+#include <jni.h>
+
+#include "fbx/FbxScene.hpp"
+#include "scene/SceneGraph.hpp"
+#include "anim/AnimationStack.hpp"
+#include "anim/Skin.hpp"
+#include "anim/BlendShapes.hpp"
+#include "core/Tracer.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <stdexcept>
+
+namespace
+{
+    /**
+     * @brief Strips the class suffix of an object name, "Cube\x00\x01Model" becomes "Cube".
+     */
+    std::string objectName(std::string_view name)
+    {
+        return std::string(name.substr(0, name.find(std::string_view("\x00\x01", 2))));
+    }
+
+    void readVector(const FbxNode &property, double *out)
+    {
+        for (size_t i = 0; i < 3 && i + 4 < property.properties.size(); i++)
+        {
+            out[i] = property.properties[i + 4].asNumber();
+        }
+    }
+
+    void readModelProperties(const FbxNode &properties, FbxModel &model)
+    {
+        for (const FbxNode &property : properties.children)
+        {
+            if (property.name != "P" || property.properties.size() < 5)
+            {
+                continue;
+            }
+
+            std::string_view name = property.properties[0].asString();
+            if (name == "Lcl Translation")
+                readVector(property, model.translation);
+            else if (name == "Lcl Rotation")
+                readVector(property, model.rotation);
+            else if (name == "Lcl Scaling")
+                readVector(property, model.scaling);
+            else if (name == "PreRotation")
+                readVector(property, model.preRotation);
+            else if (name == "PostRotation")
+                readVector(property, model.postRotation);
+            else if (name == "RotationOffset")
+                readVector(property, model.rotationOffset);
+            else if (name == "RotationPivot")
+                readVector(property, model.rotationPivot);
+            else if (name == "ScalingOffset")
+                readVector(property, model.scalingOffset);
+            else if (name == "ScalingPivot")
+                readVector(property, model.scalingPivot);
+            else if (name == "RotationOrder")
+                model.rotationOrder = static_cast<int32_t>(property.properties[4].asInteger());
+        }
+    }
+
+    /**
+     * @brief Maps a transform property name to the index of its x component, or -1.
+     */
+    int32_t transformProperty(std::string_view name)
+    {
+        if (name == "Lcl Translation")
+            return 0;
+        if (name == "Lcl Rotation")
+            return 3;
+        if (name == "Lcl Scaling")
+            return 6;
+        return -1;
+    }
+
+    /**
+     * @brief Maps a curve node channel name to its component, or -1.
+     */
+    int32_t curveComponent(std::string_view name)
+    {
+        if (name == "d|X")
+            return 0;
+        if (name == "d|Y")
+            return 1;
+        if (name == "d|Z")
+            return 2;
+        return -1;
+    }
+
+    const FbxProperty *findArray(const FbxNode &node, const char *name)
+    {
+        const FbxNode *child = node.find(name);
+        return child != nullptr && !child->properties.empty() ? &child->properties[0] : nullptr;
+    }
+
+    /**
+     * @brief An AnimationCurveNode, collected while resolving connections.
+     */
+    struct CurveNode
+    {
+        double defaults[3] = {0.0, 0.0, 0.0};
+        int32_t layer = -1;
+        int32_t model = -1;
+        int32_t property = -1;
+        int32_t curves[3] = {-1, -1, -1};
+    };
+
+    void readMatrix(const FbxNode &object, const char *name, double *out)
+    {
+        const FbxProperty *matrix = findArray(object, name);
+        if (matrix == nullptr)
+        {
+            return;
+        }
+        std::vector<double> values = matrix->asArray<double>();
+        if (values.size() != 16)
+        {
+            throw std::runtime_error(std::string("Cluster ") + name + " is not a 4x4 matrix");
+        }
+        std::copy(values.begin(), values.end(), out);
+    }
+
+    void throwFbxError(JNIEnv *env, const char *what)
+    {
+        jclass exceptionClass = env->FindClass("com/github/nodedev74/jfbx/exception/FbxRuntimeError");
+        jmethodID constructorID = env->GetMethodID(exceptionClass, "<init>", "(Ljava/lang/String;)V");
+        jstring message = env->NewStringUTF(what);
+        jobject exceptionObject = env->NewObject(exceptionClass, constructorID, message);
+        env->Throw(static_cast<jthrowable>(exceptionObject));
+    }
+
+    FbxScene *getScene(JNIEnv *env, jobject obj)
+    {
+        jclass cls = env->GetObjectClass(obj);
+        jfieldID fieldID = env->GetFieldID(cls, "scenePtr", "J");
+        return reinterpret_cast<FbxScene *>(env->GetLongField(obj, fieldID));
+    }
+}
+
+FbxMesh FbxMesh::fromGeometry(const FbxNode &geometry)
+{
+    FbxMesh mesh;
+    mesh.id = !geometry.properties.empty() ? geometry.properties[0].asInteger() : 0;
+    if (const FbxProperty *vertices = findArray(geometry, "Vertices"))
+        mesh.positions = vertices->asArray<float>();
+
+    // The last index of every polygon is stored as its bitwise complement
+    uint32_t controlPoints = static_cast<uint32_t>(mesh.positions.size() / 3);
+    std::vector<uint32_t> polygon;
+    const FbxProperty *polygonIndices = findArray(geometry, "PolygonVertexIndex");
+    for (int32_t index : polygonIndices != nullptr ? polygonIndices->asArray<int32_t>() : std::vector<int32_t>())
+    {
+        uint32_t point = static_cast<uint32_t>(index < 0 ? ~index : index);
+        if (point >= controlPoints)
+        {
+            throw std::runtime_error("Mesh polygon index out of range");
+        }
+        polygon.push_back(point);
+        if (index < 0)
+        {
+            for (size_t corner = 2; corner < polygon.size(); corner++)
+            {
+                mesh.indices.insert(mesh.indices.end(), {polygon[0], polygon[corner - 1], polygon[corner]});
+            }
+            polygon.clear();
+        }
+    }
+
+    mesh.bounds = Bounds::fromPositions(mesh.positions.data(), controlPoints);
+    return mesh;
+}
+
+FbxScene::FbxScene(const std::string &path, bool monotonic) : document(FbxDocument::load(path, monotonic))
+{
+    if (document.getVersion() < 7000)
+    {
+        throw std::runtime_error("Unsupported FBX version " + std::to_string(document.getVersion()));
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    importConnections();
+    importModels();
+    importAnimations();
+    importMaterials();
+    importTextures();
+    importMeshes();
+    importInstanceGroups();
+    importSkins();
+    importBlendShapes();
+    assemblyTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+const FbxDocument &FbxScene::getDocument() const
+{
+    return document;
+}
+
+const std::vector<FbxModel> &FbxScene::getModels() const
+{
+    return models;
+}
+
+int32_t FbxScene::findModel(int64_t id) const
+{
+    int32_t object = graph.findObject(id);
+    return object < 0 ? -1 : objectModels[object];
+}
+
+const std::vector<FbxConnection> &FbxScene::getConnections() const
+{
+    return connections;
+}
+
+const std::vector<FbxAnimationCurve> &FbxScene::getAnimationCurves() const
+{
+    return animationCurves;
+}
+
+const std::vector<FbxAnimationStack> &FbxScene::getAnimationStacks() const
+{
+    return animationStacks;
+}
+
+const std::vector<FbxMaterial> &FbxScene::getMaterials() const
+{
+    return materials;
+}
+
+const std::vector<FbxTexture> &FbxScene::getTextures() const
+{
+    return textures;
+}
+
+const std::vector<FbxMesh> &FbxScene::getMeshes() const
+{
+    return meshes;
+}
+
+const std::vector<FbxInstanceGroup> &FbxScene::getInstanceGroups() const
+{
+    return instanceGroups;
+}
+
+const std::vector<FbxSkin> &FbxScene::getSkins() const
+{
+    return skins;
+}
+
+const std::vector<FbxBlendShape> &FbxScene::getBlendShapes() const
+{
+    return blendShapes;
+}
+
+double FbxScene::getAssemblyTime() const
+{
+    return assemblyTime;
+}
+
+void FbxScene::importConnections()
+{
+    TRACE_ZONE("FbxScene.importConnections");
+
+    // Every object is numbered in file order, the imports below resolve connections by that number
+    std::vector<int64_t> objectIds;
+    if (const FbxNode *objectList = document.getRoot().find("Objects"))
+    {
+        for (const FbxNode &object : objectList->children)
+        {
+            if (!object.properties.empty())
+            {
+                objects.push_back(&object);
+                objectIds.push_back(object.properties[0].asInteger());
+            }
+        }
+    }
+
+    const FbxNode *connectionList = document.getRoot().find("Connections");
+    for (size_t i = 0; connectionList != nullptr && i < connectionList->children.size(); i++)
+    {
+        const FbxNode &connection = connectionList->children[i];
+        if (connection.name != "C" || connection.properties.size() < 3)
+        {
+            continue;
+        }
+
+        FbxConnection entry;
+        entry.child = connection.properties[1].asInteger();
+        entry.parent = connection.properties[2].asInteger();
+        if (connection.properties[0].asString() == "OP" && connection.properties.size() > 3)
+        {
+            entry.property = connection.properties[3].asString();
+        }
+        connections.push_back(std::move(entry));
+    }
+
+    graph.build(objectIds, connections);
+    objectModels.assign(objects.size(), -1);
+    objectMaterials.assign(objects.size(), -1);
+    objectMeshes.assign(objects.size(), -1);
+}
+
+void FbxScene::importModels()
+{
+    TRACE_ZONE("FbxScene.importModels");
+
+    std::vector<uint32_t> modelObjects;
+    for (size_t i = 0; i < objects.size(); i++)
+    {
+        const FbxNode &object = *objects[i];
+        if (object.name != "Model" || object.properties.size() < 3)
+        {
+            continue;
+        }
+
+        FbxModel model;
+        model.id = object.properties[0].asInteger();
+        model.name = objectName(object.properties[1].asString());
+        model.type = object.properties[2].asString();
+
+        const FbxNode *properties = object.find("Properties70");
+        if (properties != nullptr)
+        {
+            readModelProperties(*properties, model);
+        }
+
+        objectModels[i] = static_cast<int32_t>(models.size());
+        modelObjects.push_back(static_cast<uint32_t>(i));
+        models.push_back(std::move(model));
+    }
+
+    // Only object to object connections parent a model, the last one wins
+    for (size_t i = 0; i < models.size(); i++)
+    {
+        for (const FbxEdge &edge : graph.getParents(modelObjects[i]))
+        {
+            int32_t parent = objectModels[edge.object];
+            if (parent >= 0 && parent != static_cast<int32_t>(i) && connections[edge.connection].property.empty())
+            {
+                models[i].parent = parent;
+            }
+        }
+    }
+
+    // Models that are parented to each other in a cycle would never reach a root, the model that
+    // closes the cycle becomes one
+    std::vector<uint8_t> states(models.size(), 0);
+    std::vector<uint32_t> path;
+    for (size_t i = 0; i < models.size(); i++)
+    {
+        uint32_t model = static_cast<uint32_t>(i);
+        while (states[model] == 0)
+        {
+            states[model] = 1;
+            path.push_back(model);
+            int32_t parent = models[model].parent;
+            if (parent < 0)
+            {
+                break;
+            }
+            if (states[parent] == 1)
+            {
+                models[model].parent = -1;
+                break;
+            }
+            model = static_cast<uint32_t>(parent);
+        }
+        for (uint32_t visited : path)
+        {
+            states[visited] = 2;
+        }
+        path.clear();
+    }
+}
+
+void FbxScene::importAnimations()
+{
+    TRACE_ZONE("FbxScene.importAnimations");
+
+    std::vector<int32_t> objectStacks(objects.size(), -1);
+    std::vector<int32_t> objectCurves(objects.size(), -1);
+    std::vector<uint32_t> layerObjects;
+    std::vector<uint32_t> curveNodeObjects;
+    std::vector<CurveNode> curveNodes;
+
+    for (size_t i = 0; i < objects.size(); i++)
+    {
+        const FbxNode &object = *objects[i];
+        int64_t id = object.properties[0].asInteger();
+        const FbxNode *properties = object.find("Properties70");
+
+        if (object.name == "AnimationStack")
+        {
+            FbxAnimationStack stack;
+            stack.id = id;
+            stack.name = object.properties.size() > 1 ? objectName(object.properties[1].asString()) : std::string();
+            for (size_t j = 0; properties != nullptr && j < properties->children.size(); j++)
+            {
+                const FbxNode &property = properties->children[j];
+                if (property.properties.size() < 5)
+                    continue;
+                if (property.properties[0].asString() == "LocalStart")
+                    stack.localStart = property.properties[4].asInteger();
+                else if (property.properties[0].asString() == "LocalStop")
+                    stack.localStop = property.properties[4].asInteger();
+            }
+            objectStacks[i] = static_cast<int32_t>(animationStacks.size());
+            animationStacks.push_back(std::move(stack));
+        }
+        else if (object.name == "AnimationLayer")
+        {
+            layerObjects.push_back(static_cast<uint32_t>(i));
+        }
+        else if (object.name == "AnimationCurveNode")
+        {
+            CurveNode curveNode;
+            for (size_t j = 0; properties != nullptr && j < properties->children.size(); j++)
+            {
+                const FbxNode &property = properties->children[j];
+                int32_t component = property.properties.size() >= 5 ? curveComponent(property.properties[0].asString()) : -1;
+                if (component >= 0)
+                {
+                    curveNode.defaults[component] = property.properties[4].asNumber();
+                }
+            }
+            curveNodeObjects.push_back(static_cast<uint32_t>(i));
+            curveNodes.push_back(curveNode);
+        }
+        else if (object.name == "AnimationCurve")
+        {
+            FbxAnimationCurve curve;
+            curve.id = id;
+
+            const FbxNode *defaultValue = object.find("Default");
+            if (defaultValue != nullptr && !defaultValue->properties.empty())
+            {
+                curve.defaultValue = static_cast<float>(defaultValue->properties[0].asNumber());
+            }
+            if (const FbxProperty *times = findArray(object, "KeyTime"))
+                curve.times = times->asArray<int64_t>();
+            if (const FbxProperty *values = findArray(object, "KeyValueFloat"))
+                curve.values = values->asArray<float>();
+            if (const FbxProperty *flags = findArray(object, "KeyAttrFlags"))
+                curve.attributeFlags = flags->asArray<int32_t>();
+            if (const FbxProperty *data = findArray(object, "KeyAttrDataFloat"))
+                curve.attributeData = data->asArray<float>();
+            if (const FbxProperty *refCounts = findArray(object, "KeyAttrRefCount"))
+                curve.attributeRefCounts = refCounts->asArray<int32_t>();
+
+            if (curve.times.size() != curve.values.size())
+            {
+                throw std::runtime_error("AnimationCurve key times and values differ in length");
+            }
+            objectCurves[i] = static_cast<int32_t>(animationCurves.size());
+            animationCurves.push_back(std::move(curve));
+        }
+    }
+
+    // A layer belongs to the last stack it is connected to, -2 marks a layer without one
+    std::vector<int32_t> layerStacks(objects.size(), -1);
+    for (uint32_t layer : layerObjects)
+    {
+        layerStacks[layer] = -2;
+        for (const FbxEdge &edge : graph.getParents(layer))
+        {
+            if (objectStacks[edge.object] >= 0)
+            {
+                layerStacks[layer] = objectStacks[edge.object];
+            }
+        }
+    }
+
+    for (size_t i = 0; i < curveNodes.size(); i++)
+    {
+        CurveNode &curveNode = curveNodes[i];
+        for (const FbxEdge &edge : graph.getParents(curveNodeObjects[i]))
+        {
+            const std::string &property = connections[edge.connection].property;
+            if (layerStacks[edge.object] != -1)
+            {
+                curveNode.layer = edge.object;
+            }
+            else if (objectModels[edge.object] >= 0 && transformProperty(property) >= 0)
+            {
+                curveNode.model = objectModels[edge.object];
+                curveNode.property = transformProperty(property);
+            }
+        }
+        for (const FbxEdge &edge : graph.getChildren(curveNodeObjects[i]))
+        {
+            int32_t component = curveComponent(connections[edge.connection].property);
+            if (objectCurves[edge.object] >= 0 && component >= 0)
+            {
+                curveNode.curves[component] = objectCurves[edge.object];
+            }
+        }
+
+        if (curveNode.model < 0 || curveNode.property < 0 || curveNode.layer < 0 || layerStacks[curveNode.layer] < 0)
+        {
+            continue;
+        }
+        for (int32_t component = 0; component < 3; component++)
+        {
+            FbxAnimationChannel channel;
+            channel.model = curveNode.model;
+            channel.property = static_cast<uint8_t>(curveNode.property + component);
+            channel.curve = curveNode.curves[component];
+            channel.defaultValue = static_cast<float>(curveNode.defaults[component]);
+            animationStacks[layerStacks[curveNode.layer]].channels.push_back(channel);
+        }
+    }
+
+    for (FbxAnimationStack &stack : animationStacks)
+    {
+        std::sort(stack.channels.begin(), stack.channels.end(), [](const FbxAnimationChannel &a, const FbxAnimationChannel &b)
+                  { return a.model != b.model ? a.model < b.model : a.property < b.property; });
+    }
+}
+
+void FbxScene::importMaterials()
+{
+    TRACE_ZONE("FbxScene.importMaterials");
+
+    for (size_t i = 0; i < objects.size(); i++)
+    {
+        const FbxNode &object = *objects[i];
+        if (object.name != "Material" || object.properties.size() < 2)
+        {
+            continue;
+        }
+
+        FbxMaterial material;
+        material.id = object.properties[0].asInteger();
+        material.name = objectName(object.properties[1].asString());
+        objectMaterials[i] = static_cast<int32_t>(materials.size());
+        materials.push_back(std::move(material));
+    }
+
+    // Models with several materials select them per polygon, they are grouped by the first one
+    for (size_t i = 0; i < objects.size(); i++)
+    {
+        if (objectModels[i] < 0)
+        {
+            continue;
+        }
+        for (const FbxEdge &edge : graph.getChildren(static_cast<uint32_t>(i)))
+        {
+            if (objectMaterials[edge.object] >= 0)
+            {
+                models[objectModels[i]].material = objectMaterials[edge.object];
+                break;
+            }
+        }
+    }
+}
+
+void FbxScene::importTextures()
+{
+    TRACE_ZONE("FbxScene.importTextures");
+
+    std::vector<int32_t> objectTextures(objects.size(), -1);
+    for (size_t i = 0; i < objects.size(); i++)
+    {
+        const FbxNode &object = *objects[i];
+        if (object.name != "Texture" || object.properties.size() < 2)
+        {
+            continue;
+        }
+
+        FbxTexture texture;
+        texture.id = object.properties[0].asInteger();
+        texture.name = objectName(object.properties[1].asString());
+        const FbxNode *fileName = object.find("RelativeFilename");
+        fileName = fileName != nullptr ? fileName : object.find("FileName");
+        if (fileName != nullptr && !fileName->properties.empty())
+        {
+            texture.fileName = fileName->properties[0].asString();
+        }
+
+        // Embedded files sit in the Content of the Video connected to a texture
+        for (const FbxEdge &edge : graph.getChildren(static_cast<uint32_t>(i)))
+        {
+            const FbxNode &video = *objects[edge.object];
+            const FbxNode *content = video.name == "Video" && video.properties.size() >= 2 ? video.find("Content") : nullptr;
+            if (content != nullptr && !content->properties.empty())
+            {
+                texture.content = content->properties[0].asString();
+            }
+        }
+
+        objectTextures[i] = static_cast<int32_t>(textures.size());
+        textures.push_back(std::move(texture));
+    }
+
+    for (size_t i = 0; i < objects.size(); i++)
+    {
+        if (objectMaterials[i] < 0)
+        {
+            continue;
+        }
+
+        // The diffuse color texture wins over any other property a material maps
+        FbxMaterial &material = materials[objectMaterials[i]];
+        for (const FbxEdge &edge : graph.getChildren(static_cast<uint32_t>(i)))
+        {
+            if (objectTextures[edge.object] >= 0 && (material.texture < 0 || connections[edge.connection].property == "DiffuseColor"))
+            {
+                material.texture = objectTextures[edge.object];
+            }
+        }
+    }
+}
+
+void FbxScene::importMeshes()
+{
+    TRACE_ZONE("FbxScene.importMeshes");
+
+    // Models sharing a geometry reference the single imported copy
+    std::vector<int32_t> modelMeshes(models.size(), -1);
+    for (size_t i = 0; i < objects.size(); i++)
+    {
+        const FbxNode &object = *objects[i];
+        if (object.name != "Geometry" || object.properties.size() < 3 || object.properties[2].asString() != "Mesh")
+        {
+            continue;
+        }
+
+        FbxMesh mesh = FbxMesh::fromGeometry(object);
+        int32_t index = static_cast<int32_t>(meshes.size());
+        for (const FbxEdge &edge : graph.getParents(static_cast<uint32_t>(i)))
+        {
+            int32_t model = objectModels[edge.object];
+            if (model >= 0 && modelMeshes[model] != index)
+            {
+                modelMeshes[model] = index;
+                mesh.models.push_back(model);
+            }
+        }
+        if (!mesh.models.empty())
+        {
+            mesh.model = mesh.models.front();
+        }
+
+        objectMeshes[i] = index;
+        meshes.push_back(std::move(mesh));
+    }
+}
+
+void FbxScene::importInstanceGroups()
+{
+    TRACE_ZONE("FbxScene.importInstanceGroups");
+
+    // The group of each material within the current mesh, shifted by one for models without a material
+    std::vector<int32_t> materialGroups(materials.size() + 1, -1);
+    for (size_t i = 0; i < meshes.size(); i++)
+    {
+        for (int32_t model : meshes[i].models)
+        {
+            int32_t material = models[model].material;
+            int32_t &group = materialGroups[material + 1];
+            if (group < 0)
+            {
+                group = static_cast<int32_t>(instanceGroups.size());
+                instanceGroups.push_back({static_cast<int32_t>(i), material, {}});
+            }
+            instanceGroups[group].models.push_back(model);
+        }
+        for (int32_t model : meshes[i].models)
+        {
+            materialGroups[models[model].material + 1] = -1;
+        }
+    }
+}
+
+void FbxScene::importSkins()
+{
+    TRACE_ZONE("FbxScene.importSkins");
+
+    std::vector<int32_t> objectClusters(objects.size(), -1);
+    std::vector<FbxCluster> clusters;
+    std::vector<uint32_t> skinObjects;
+    for (size_t i = 0; i < objects.size(); i++)
+    {
+        const FbxNode &object = *objects[i];
+        if (object.name != "Deformer" || object.properties.size() < 3)
+        {
+            continue;
+        }
+
+        int64_t id = object.properties[0].asInteger();
+        std::string_view type = object.properties[2].asString();
+        if (type == "Skin")
+        {
+            FbxSkin skin;
+            skin.id = id;
+            skinObjects.push_back(static_cast<uint32_t>(i));
+            skins.push_back(std::move(skin));
+        }
+        else if (type == "Cluster")
+        {
+            FbxCluster cluster;
+            cluster.id = id;
+            if (const FbxProperty *indices = findArray(object, "Indexes"))
+                cluster.indices = indices->asArray<int32_t>();
+            if (const FbxProperty *weights = findArray(object, "Weights"))
+                cluster.weights = weights->asArray<double>();
+            readMatrix(object, "Transform", cluster.transform);
+            readMatrix(object, "TransformLink", cluster.transformLink);
+
+            if (cluster.indices.size() != cluster.weights.size())
+            {
+                throw std::runtime_error("Cluster indices and weights differ in length");
+            }
+
+            // The bone of a cluster is the last model connected to it
+            for (const FbxEdge &edge : graph.getChildren(static_cast<uint32_t>(i)))
+            {
+                if (objectModels[edge.object] >= 0)
+                {
+                    cluster.model = objectModels[edge.object];
+                }
+            }
+            objectClusters[i] = static_cast<int32_t>(clusters.size());
+            clusters.push_back(std::move(cluster));
+        }
+    }
+
+    for (size_t i = 0; i < skins.size(); i++)
+    {
+        for (const FbxEdge &edge : graph.getParents(skinObjects[i]))
+        {
+            if (objectMeshes[edge.object] >= 0)
+            {
+                skins[i].mesh = objectMeshes[edge.object];
+            }
+        }
+        for (const FbxEdge &edge : graph.getChildren(skinObjects[i]))
+        {
+            int32_t cluster = objectClusters[edge.object];
+            if (cluster >= 0 && clusters[cluster].model >= 0)
+            {
+                skins[i].clusters.push_back(clusters[cluster]);
+            }
+        }
+    }
+}
+
+void FbxScene::importBlendShapes()
+{
+    TRACE_ZONE("FbxScene.importBlendShapes");
+
+    std::vector<int32_t> objectBlendShapes(objects.size(), -1);
+    std::vector<int32_t> objectChannels(objects.size(), -1);
+    std::vector<FbxBlendShapeChannel> channels;
+    std::vector<uint32_t> blendShapeObjects;
+    for (size_t i = 0; i < objects.size(); i++)
+    {
+        const FbxNode &object = *objects[i];
+        if (object.name != "Deformer" || object.properties.size() < 3)
+        {
+            continue;
+        }
+
+        int64_t id = object.properties[0].asInteger();
+        std::string_view type = object.properties[2].asString();
+        if (type == "BlendShape")
+        {
+            FbxBlendShape blendShape;
+            blendShape.id = id;
+            objectBlendShapes[i] = static_cast<int32_t>(blendShapes.size());
+            blendShapeObjects.push_back(static_cast<uint32_t>(i));
+            blendShapes.push_back(std::move(blendShape));
+        }
+        else if (type == "BlendShapeChannel")
+        {
+            FbxBlendShapeChannel channel;
+            channel.id = id;
+            channel.name = objectName(object.properties[1].asString());
+            if (const FbxProperty *deformPercent = findArray(object, "DeformPercent"))
+                channel.deformPercent = deformPercent->asNumber();
+
+            // The shape of a channel is the first Shape geometry connected to it
+            for (const FbxEdge &edge : graph.getChildren(static_cast<uint32_t>(i)))
+            {
+                const FbxNode &shape = *objects[edge.object];
+                if (!channel.indices.empty() || shape.name != "Geometry" || shape.properties.size() < 3 || shape.properties[2].asString() != "Shape")
+                {
+                    continue;
+                }
+                if (const FbxProperty *indices = findArray(shape, "Indexes"))
+                    channel.indices = indices->asArray<int32_t>();
+                if (const FbxProperty *deltas = findArray(shape, "Vertices"))
+                    channel.deltas = deltas->asArray<float>();
+
+                if (channel.deltas.size() != channel.indices.size() * 3)
+                {
+                    throw std::runtime_error("Shape indices and vertices differ in length");
+                }
+            }
+            objectChannels[i] = static_cast<int32_t>(channels.size());
+            channels.push_back(std::move(channel));
+        }
+    }
+
+    // A channel connected to several blend shapes is moved into the first one
+    std::vector<int32_t> channelOwners(channels.size(), -1);
+    for (size_t i = 0; i < objects.size(); i++)
+    {
+        if (objectChannels[i] < 0)
+        {
+            continue;
+        }
+        for (const FbxEdge &edge : graph.getParents(static_cast<uint32_t>(i)))
+        {
+            if (objectBlendShapes[edge.object] >= 0)
+            {
+                channelOwners[objectChannels[i]] = objectBlendShapes[edge.object];
+                break;
+            }
+        }
+    }
+
+    for (size_t i = 0; i < blendShapes.size(); i++)
+    {
+        for (const FbxEdge &edge : graph.getParents(blendShapeObjects[i]))
+        {
+            if (objectMeshes[edge.object] >= 0)
+            {
+                blendShapes[i].mesh = objectMeshes[edge.object];
+            }
+        }
+        for (const FbxEdge &edge : graph.getChildren(blendShapeObjects[i]))
+        {
+            int32_t channel = objectChannels[edge.object];
+            if (channel >= 0 && channelOwners[channel] == static_cast<int32_t>(i))
+            {
+                blendShapes[i].channels.push_back(std::move(channels[channel]));
+                channelOwners[channel] = -1;
+            }
+        }
+    }
+}
+
+/**
+ * @brief JNI function to load and import an FBX file.
+ *
+ * @param env The JNI environment.
+ * @param cls The Java class.
+ * @param path The file path.
+ * @param arena False to parse into records allocated one by one from the heap.
+ * @return The native scene pointer.
+ */
+JNIEXPORT jlong JNICALL Java_com_github_nodedev74_jfbx_fbx_FbxScene_load(JNIEnv *env, jclass cls, jstring path, jboolean arena)
+{
+    TRACE_ZONE("FbxScene.load");
+
+    const char *chars = env->GetStringUTFChars(path, nullptr);
+    std::string filePath(chars);
+    env->ReleaseStringUTFChars(path, chars);
+
+    try
+    {
+        return reinterpret_cast<jlong>(new FbxScene(filePath, arena == JNI_TRUE));
+    }
+    catch (const std::exception &e)
+    {
+        throwFbxError(env, e.what());
+        return 0;
+    }
+}
+
+/**
+ * @brief JNI function to retrieve the number of imported models.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ * @return The model count.
+ */
+JNIEXPORT jint JNICALL Java_com_github_nodedev74_jfbx_fbx_FbxScene_getModelCount(JNIEnv *env, jobject obj)
+{
+    return static_cast<jint>(getScene(env, obj)->getModels().size());
+}
+
+/**
+ * @brief JNI function to retrieve the name of a model.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ * @param index The model index.
+ * @return The model name.
+ */
+JNIEXPORT jstring JNICALL Java_com_github_nodedev74_jfbx_fbx_FbxScene_getModelName(JNIEnv *env, jobject obj, jint index)
+{
+    return env->NewStringUTF(getScene(env, obj)->getModels()[index].name.c_str());
+}
+
+/**
+ * @brief JNI function to retrieve the parent of a model.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ * @param index The model index.
+ * @return The parent model index or -1.
+ */
+JNIEXPORT jint JNICALL Java_com_github_nodedev74_jfbx_fbx_FbxScene_getModelParent(JNIEnv *env, jobject obj, jint index)
+{
+    return getScene(env, obj)->getModels()[index].parent;
+}
+
+/**
+ * @brief JNI function to build a scene graph from the model hierarchy.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ * @return The Java scene graph.
+ */
+JNIEXPORT jobject JNICALL Java_com_github_nodedev74_jfbx_fbx_FbxScene_createSceneGraph(JNIEnv *env, jobject obj)
+{
+    TRACE_ZONE("FbxScene.createSceneGraph");
+
+    SceneGraph *graph;
+    try
+    {
+        graph = SceneGraph::fromScene(*getScene(env, obj));
+    }
+    catch (const std::exception &e)
+    {
+        throwFbxError(env, e.what());
+        return nullptr;
+    }
+
+    jclass graphClass = env->FindClass("com/github/nodedev74/jfbx/scene/SceneGraph");
+    jmethodID constructorID = env->GetMethodID(graphClass, "<init>", "(J)V");
+    return env->NewObject(graphClass, constructorID, reinterpret_cast<jlong>(graph));
+}
+
+/**
+ * @brief JNI function to retrieve the number of animation stacks.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ * @return The animation stack count.
+ */
+JNIEXPORT jint JNICALL Java_com_github_nodedev74_jfbx_fbx_FbxScene_getAnimationStackCount(JNIEnv *env, jobject obj)
+{
+    return static_cast<jint>(getScene(env, obj)->getAnimationStacks().size());
+}
+
+/**
+ * @brief JNI function to retrieve the name of an animation stack.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ * @param index The animation stack index.
+ * @return The animation stack name.
+ */
+JNIEXPORT jstring JNICALL Java_com_github_nodedev74_jfbx_fbx_FbxScene_getAnimationStackName(JNIEnv *env, jobject obj, jint index)
+{
+    return env->NewStringUTF(getScene(env, obj)->getAnimationStacks()[index].name.c_str());
+}
+
+/**
+ * @brief JNI function to convert an animation stack for playback.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ * @param index The animation stack index.
+ * @param tolerance The key reduction tolerance, 0 keeps all keys.
+ * @param quantize True to store the keys quantized.
+ * @return The Java animation stack.
+ */
+JNIEXPORT jobject JNICALL Java_com_github_nodedev74_jfbx_fbx_FbxScene_createAnimationStack(JNIEnv *env, jobject obj, jint index, jfloat tolerance, jboolean quantize)
+{
+    TRACE_ZONE("FbxScene.createAnimationStack");
+
+    AnimationStack *stack = AnimationStack::fromScene(*getScene(env, obj), static_cast<uint32_t>(index), tolerance, quantize == JNI_TRUE);
+
+    jclass stackClass = env->FindClass("com/github/nodedev74/jfbx/anim/AnimationStack");
+    jmethodID constructorID = env->GetMethodID(stackClass, "<init>", "(J)V");
+    return env->NewObject(stackClass, constructorID, reinterpret_cast<jlong>(stack));
+}
+
+/**
+ * @brief JNI function to retrieve the number of imported meshes.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ * @return The mesh count.
+ */
+JNIEXPORT jint JNICALL Java_com_github_nodedev74_jfbx_fbx_FbxScene_getMeshCount(JNIEnv *env, jobject obj)
+{
+    return static_cast<jint>(getScene(env, obj)->getMeshes().size());
+}
+
+/**
+ * @brief JNI function to retrieve the model a mesh is attached to.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ * @param index The mesh index.
+ * @return The model index, or -1 if the mesh is not attached.
+ */
+JNIEXPORT jint JNICALL Java_com_github_nodedev74_jfbx_fbx_FbxScene_getMeshModel(JNIEnv *env, jobject obj, jint index)
+{
+    return static_cast<jint>(getScene(env, obj)->getMeshes()[index].model);
+}
+
+/**
+ * @brief JNI function to retrieve all models a mesh is attached to.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ * @param index The mesh index.
+ * @return The model indices in connection order.
+ */
+JNIEXPORT jintArray JNICALL Java_com_github_nodedev74_jfbx_fbx_FbxScene_getMeshModels(JNIEnv *env, jobject obj, jint index)
+{
+    const std::vector<int32_t> &models = getScene(env, obj)->getMeshes()[index].models;
+    jintArray array = env->NewIntArray(static_cast<jsize>(models.size()));
+    env->SetIntArrayRegion(array, 0, static_cast<jsize>(models.size()), reinterpret_cast<const jint *>(models.data()));
+    return array;
+}
+
+/**
+ * @brief JNI function to retrieve the control points of a mesh.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ * @param index The mesh index.
+ * @return x, y and z per control point.
+ */
+JNIEXPORT jfloatArray JNICALL Java_com_github_nodedev74_jfbx_fbx_FbxScene_getMeshPositions(JNIEnv *env, jobject obj, jint index)
+{
+    const std::vector<float> &positions = getScene(env, obj)->getMeshes()[index].positions;
+    jfloatArray array = env->NewFloatArray(static_cast<jsize>(positions.size()));
+    env->SetFloatArrayRegion(array, 0, static_cast<jsize>(positions.size()), positions.data());
+    return array;
+}
+
+/**
+ * @brief JNI function to retrieve the triangle indices of a mesh.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ * @param index The mesh index.
+ * @return Three control point indices per triangle.
+ */
+JNIEXPORT jintArray JNICALL Java_com_github_nodedev74_jfbx_fbx_FbxScene_getMeshIndices(JNIEnv *env, jobject obj, jint index)
+{
+    const std::vector<uint32_t> &indices = getScene(env, obj)->getMeshes()[index].indices;
+    jintArray array = env->NewIntArray(static_cast<jsize>(indices.size()));
+    env->SetIntArrayRegion(array, 0, static_cast<jsize>(indices.size()), reinterpret_cast<const jint *>(indices.data()));
+    return array;
+}
+
+/**
+ * @brief JNI function to retrieve the material of a model.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ * @param index The model index.
+ * @return The material index, or -1 if the model has no material.
+ */
+JNIEXPORT jint JNICALL Java_com_github_nodedev74_jfbx_fbx_FbxScene_getModelMaterial(JNIEnv *env, jobject obj, jint index)
+{
+    return static_cast<jint>(getScene(env, obj)->getModels()[index].material);
+}
+
+/**
+ * @brief JNI function to retrieve the number of imported materials.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ * @return The material count.
+ */
+JNIEXPORT jint JNICALL Java_com_github_nodedev74_jfbx_fbx_FbxScene_getMaterialCount(JNIEnv *env, jobject obj)
+{
+    return static_cast<jint>(getScene(env, obj)->getMaterials().size());
+}
+
+/**
+ * @brief JNI function to retrieve the name of a material.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ * @param index The material index.
+ * @return The material name.
+ */
+JNIEXPORT jstring JNICALL Java_com_github_nodedev74_jfbx_fbx_FbxScene_getMaterialName(JNIEnv *env, jobject obj, jint index)
+{
+    return env->NewStringUTF(getScene(env, obj)->getMaterials()[index].name.c_str());
+}
+
+/**
+ * @brief JNI function to retrieve the texture of a material.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ * @param index The material index.
+ * @return The texture index, or -1 without texture.
+ */
+JNIEXPORT jint JNICALL Java_com_github_nodedev74_jfbx_fbx_FbxScene_getMaterialTexture(JNIEnv *env, jobject obj, jint index)
+{
+    return static_cast<jint>(getScene(env, obj)->getMaterials()[index].texture);
+}
+
+/**
+ * @brief JNI function to retrieve the number of imported textures.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ * @return The texture count.
+ */
+JNIEXPORT jint JNICALL Java_com_github_nodedev74_jfbx_fbx_FbxScene_getTextureCount(JNIEnv *env, jobject obj)
+{
+    return static_cast<jint>(getScene(env, obj)->getTextures().size());
+}
+
+/**
+ * @brief JNI function to retrieve the file name a texture refers to.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ * @param index The texture index.
+ * @return The relative file name.
+ */
+JNIEXPORT jstring JNICALL Java_com_github_nodedev74_jfbx_fbx_FbxScene_getTextureFileName(JNIEnv *env, jobject obj, jint index)
+{
+    return env->NewStringUTF(getScene(env, obj)->getTextures()[index].fileName.c_str());
+}
+
+/**
+ * @brief JNI function to retrieve the embedded file of a texture.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ * @param index The texture index.
+ * @return The file content, or null if the file is not embedded.
+ */
+JNIEXPORT jbyteArray JNICALL Java_com_github_nodedev74_jfbx_fbx_FbxScene_getTextureContent(JNIEnv *env, jobject obj, jint index)
+{
+    const std::string &content = getScene(env, obj)->getTextures()[index].content;
+    if (content.empty())
+    {
+        return nullptr;
+    }
+    jbyteArray array = env->NewByteArray(static_cast<jsize>(content.size()));
+    env->SetByteArrayRegion(array, 0, static_cast<jsize>(content.size()), reinterpret_cast<const jbyte *>(content.data()));
+    return array;
+}
+
+/**
+ * @brief JNI function to retrieve the number of instance groups.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ * @return The instance group count.
+ */
+JNIEXPORT jint JNICALL Java_com_github_nodedev74_jfbx_fbx_FbxScene_getInstanceGroupCount(JNIEnv *env, jobject obj)
+{
+    return static_cast<jint>(getScene(env, obj)->getInstanceGroups().size());
+}
+
+/**
+ * @brief JNI function to retrieve the mesh of an instance group.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ * @param index The instance group index.
+ * @return The mesh index.
+ */
+JNIEXPORT jint JNICALL Java_com_github_nodedev74_jfbx_fbx_FbxScene_getInstanceGroupMesh(JNIEnv *env, jobject obj, jint index)
+{
+    return static_cast<jint>(getScene(env, obj)->getInstanceGroups()[index].mesh);
+}
+
+/**
+ * @brief JNI function to retrieve the material of an instance group.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ * @param index The instance group index.
+ * @return The material index, or -1 for models without material.
+ */
+JNIEXPORT jint JNICALL Java_com_github_nodedev74_jfbx_fbx_FbxScene_getInstanceGroupMaterial(JNIEnv *env, jobject obj, jint index)
+{
+    return static_cast<jint>(getScene(env, obj)->getInstanceGroups()[index].material);
+}
+
+/**
+ * @brief JNI function to retrieve the models of an instance group.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ * @param index The instance group index.
+ * @return The model indices.
+ */
+JNIEXPORT jintArray JNICALL Java_com_github_nodedev74_jfbx_fbx_FbxScene_getInstanceGroupModels(JNIEnv *env, jobject obj, jint index)
+{
+    const std::vector<int32_t> &models = getScene(env, obj)->getInstanceGroups()[index].models;
+    jintArray array = env->NewIntArray(static_cast<jsize>(models.size()));
+    env->SetIntArrayRegion(array, 0, static_cast<jsize>(models.size()), reinterpret_cast<const jint *>(models.data()));
+    return array;
+}
+
+/**
+ * @brief JNI function to retrieve the number of imported skin deformers.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ * @return The skin count.
+ */
+JNIEXPORT jint JNICALL Java_com_github_nodedev74_jfbx_fbx_FbxScene_getSkinCount(JNIEnv *env, jobject obj)
+{
+    return static_cast<jint>(getScene(env, obj)->getSkins().size());
+}
+
+/**
+ * @brief JNI function to convert a skin deformer into packed bind pose data.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ * @param index The skin index.
+ * @return The Java skin.
+ */
+JNIEXPORT jobject JNICALL Java_com_github_nodedev74_jfbx_fbx_FbxScene_createSkin(JNIEnv *env, jobject obj, jint index)
+{
+    TRACE_ZONE("FbxScene.createSkin");
+
+    Skin *skin = nullptr;
+    try
+    {
+        skin = Skin::fromScene(*getScene(env, obj), static_cast<uint32_t>(index));
+    }
+    catch (const std::exception &e)
+    {
+        throwFbxError(env, e.what());
+        return nullptr;
+    }
+
+    jclass skinClass = env->FindClass("com/github/nodedev74/jfbx/anim/Skin");
+    jmethodID constructorID = env->GetMethodID(skinClass, "<init>", "(J)V");
+    return env->NewObject(skinClass, constructorID, reinterpret_cast<jlong>(skin));
+}
+
+/**
+ * @brief JNI function to retrieve the number of blend shape deformers.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ * @return The blend shape count.
+ */
+JNIEXPORT jint JNICALL Java_com_github_nodedev74_jfbx_fbx_FbxScene_getBlendShapeCount(JNIEnv *env, jobject obj)
+{
+    return static_cast<jint>(getScene(env, obj)->getBlendShapes().size());
+}
+
+/**
+ * @brief JNI function to convert a blend shape deformer into sparse shapes.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ * @param index The blend shape index.
+ * @return The Java blend shapes.
+ */
+JNIEXPORT jobject JNICALL Java_com_github_nodedev74_jfbx_fbx_FbxScene_createBlendShapes(JNIEnv *env, jobject obj, jint index)
+{
+    TRACE_ZONE("FbxScene.createBlendShapes");
+
+    BlendShapes *blendShapes = nullptr;
+    try
+    {
+        blendShapes = BlendShapes::fromScene(*getScene(env, obj), static_cast<uint32_t>(index));
+    }
+    catch (const std::exception &e)
+    {
+        throwFbxError(env, e.what());
+        return nullptr;
+    }
+
+    jclass blendShapesClass = env->FindClass("com/github/nodedev74/jfbx/anim/BlendShapes");
+    jmethodID constructorID = env->GetMethodID(blendShapesClass, "<init>", "(J)V");
+    return env->NewObject(blendShapesClass, constructorID, reinterpret_cast<jlong>(blendShapes));
+}
+
+/**
+ * @brief JNI function to retrieve the time spent assembling the scene.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ * @return The assembly time in milliseconds.
+ */
+JNIEXPORT jdouble JNICALL Java_com_github_nodedev74_jfbx_fbx_FbxScene_getAssemblyTime(JNIEnv *env, jobject obj)
+{
+    return static_cast<jdouble>(getScene(env, obj)->getAssemblyTime());
+}
+
+/**
+ * @brief JNI function to retrieve the time spent parsing the file into records.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ * @return The parse time in milliseconds.
+ */
+JNIEXPORT jdouble JNICALL Java_com_github_nodedev74_jfbx_fbx_FbxScene_getParseTime(JNIEnv *env, jobject obj)
+{
+    return static_cast<jdouble>(getScene(env, obj)->getDocument().getParseTime());
+}
+
+/**
+ * @brief JNI function to retrieve the bytes allocated for the parsed records.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ * @return The size in bytes.
+ */
+JNIEXPORT jlong JNICALL Java_com_github_nodedev74_jfbx_fbx_FbxScene_getParseMemory(JNIEnv *env, jobject obj)
+{
+    return static_cast<jlong>(getScene(env, obj)->getDocument().getArena().getAllocatedBytes());
+}
+
+/**
+ * @brief JNI function to retrieve the number of allocations for the parsed records.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ * @return The allocation count.
+ */
+JNIEXPORT jlong JNICALL Java_com_github_nodedev74_jfbx_fbx_FbxScene_getParseAllocationCount(JNIEnv *env, jobject obj)
+{
+    return static_cast<jlong>(getScene(env, obj)->getDocument().getArena().getAllocationCount());
+}
+
+/**
+ * @brief JNI function to retrieve the heap memory held by the parsed records.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ * @return The size in bytes.
+ */
+JNIEXPORT jlong JNICALL Java_com_github_nodedev74_jfbx_fbx_FbxScene_getParseReservedMemory(JNIEnv *env, jobject obj)
+{
+    return static_cast<jlong>(getScene(env, obj)->getDocument().getArena().getReservedBytes());
+}
+
+/**
+ * @brief JNI function to release the native scene.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ */
+JNIEXPORT void JNICALL Java_com_github_nodedev74_jfbx_fbx_FbxScene_destroy(JNIEnv *env, jobject obj)
+{
+    delete getScene(env, obj);
+
+    jclass cls = env->GetObjectClass(obj);
+    jfieldID fieldID = env->GetFieldID(cls, "scenePtr", "J");
+    env->SetLongField(obj, fieldID, 0);
+}
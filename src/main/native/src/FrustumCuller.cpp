@@ -0,0 +1,464 @@
+/**
+ * @file FrustumCuller.cpp
+ * @author Lenard Büsing (nodedev74@gmail.com)
+ * @brief Implementation of the bounding volumes and the SIMD frustum culling kernels.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2023 Lenard Büsing
+ *
+ */
+
+#include "com_github_nodedev74_jfbx_scene_FrustumCuller.h"
+#include <jni.h>
+
+#include "scene/FrustumCuller.hpp"
+#include "core/ThreadPool.hpp"
+#include "core/Tracer.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#define CULL_AVX 1
+#define CULL_WIDTH 8
+#elif defined(__SSE__) || defined(_M_X64)
+#include <xmmintrin.h>
+#define CULL_SSE 1
+#define CULL_WIDTH 4
+#else
+#define CULL_WIDTH 1
+#endif
+
+namespace
+{
+    constexpr uint32_t CULL_GRAIN = 4096;
+    constexpr uint32_t CULL_PADDING = 8;
+
+    FrustumCuller *getCuller(JNIEnv *env, jobject obj)
+    {
+        jclass cls = env->GetObjectClass(obj);
+        jfieldID fieldID = env->GetFieldID(cls, "cullerPtr", "J");
+        return reinterpret_cast<FrustumCuller *>(env->GetLongField(obj, fieldID));
+    }
+}
+
+Bounds Bounds::fromPositions(const float *positions, size_t count)
+{
+    Bounds bounds;
+    if (count == 0)
+    {
+        return bounds;
+    }
+
+    for (int axis = 0; axis < 3; axis++)
+    {
+        bounds.min[axis] = bounds.max[axis] = positions[axis];
+    }
+    for (size_t i = 1; i < count; i++)
+    {
+        for (int axis = 0; axis < 3; axis++)
+        {
+            bounds.min[axis] = std::min(bounds.min[axis], positions[i * 3 + axis]);
+            bounds.max[axis] = std::max(bounds.max[axis], positions[i * 3 + axis]);
+        }
+    }
+    for (int axis = 0; axis < 3; axis++)
+    {
+        bounds.center[axis] = (bounds.min[axis] + bounds.max[axis]) * 0.5f;
+    }
+
+    // The farthest point from the box center, tighter than the half diagonal for round meshes
+    float radiusSquared = 0.0f;
+    for (size_t i = 0; i < count; i++)
+    {
+        float dx = positions[i * 3] - bounds.center[0];
+        float dy = positions[i * 3 + 1] - bounds.center[1];
+        float dz = positions[i * 3 + 2] - bounds.center[2];
+        radiusSquared = std::max(radiusSquared, dx * dx + dy * dy + dz * dz);
+    }
+    bounds.radius = std::sqrt(radiusSquared);
+    return bounds;
+}
+
+Frustum Frustum::fromViewProjection(const Matrix4 &viewProjection)
+{
+    const float *m = viewProjection.m;
+    float rows[4][4];
+    for (int row = 0; row < 4; row++)
+    {
+        for (int column = 0; column < 4; column++)
+        {
+            rows[row][column] = m[column * 4 + row];
+        }
+    }
+
+    Frustum frustum;
+    for (int i = 0; i < 4; i++)
+    {
+        frustum.planes[0][i] = rows[3][i] + rows[0][i];
+        frustum.planes[1][i] = rows[3][i] - rows[0][i];
+        frustum.planes[2][i] = rows[3][i] + rows[1][i];
+        frustum.planes[3][i] = rows[3][i] - rows[1][i];
+        frustum.planes[4][i] = rows[2][i];
+        frustum.planes[5][i] = rows[3][i] - rows[2][i];
+    }
+    for (auto &plane : frustum.planes)
+    {
+        float length = std::sqrt(plane[0] * plane[0] + plane[1] * plane[1] + plane[2] * plane[2]);
+        if (length > 0.0f)
+        {
+            for (float &value : plane)
+            {
+                value /= length;
+            }
+        }
+    }
+    return frustum;
+}
+
+uint32_t FrustumCuller::add(uint32_t node, const Bounds &bounds)
+{
+    uint32_t object = static_cast<uint32_t>(nodes.size());
+    nodes.push_back(node);
+    localBounds.push_back(bounds);
+    resize(object + 1);
+
+    centerX[object] = bounds.center[0];
+    centerY[object] = bounds.center[1];
+    centerZ[object] = bounds.center[2];
+    extentX[object] = (bounds.max[0] - bounds.min[0]) * 0.5f;
+    extentY[object] = (bounds.max[1] - bounds.min[1]) * 0.5f;
+    extentZ[object] = (bounds.max[2] - bounds.min[2]) * 0.5f;
+    sphereX[object] = bounds.center[0];
+    sphereY[object] = bounds.center[1];
+    sphereZ[object] = bounds.center[2];
+    sphereRadius[object] = bounds.radius;
+    return object;
+}
+
+void FrustumCuller::clear()
+{
+    nodes.clear();
+    localBounds.clear();
+    resize(0);
+}
+
+uint32_t FrustumCuller::getObjectCount() const
+{
+    return static_cast<uint32_t>(nodes.size());
+}
+
+uint32_t FrustumCuller::getNode(uint32_t object) const
+{
+    return nodes[object];
+}
+
+void FrustumCuller::getWorldBox(uint32_t object, float center[3], float extent[3]) const
+{
+    center[0] = centerX[object];
+    center[1] = centerY[object];
+    center[2] = centerZ[object];
+    extent[0] = extentX[object];
+    extent[1] = extentY[object];
+    extent[2] = extentZ[object];
+}
+
+void FrustumCuller::resize(uint32_t count)
+{
+    // Kernels load whole SIMD groups, so the arrays are padded and the padding is never visible
+    size_t padded = (count + CULL_PADDING - 1) / CULL_PADDING * CULL_PADDING;
+    for (std::vector<float> *values : {&centerX, &centerY, &centerZ, &extentX, &extentY, &extentZ, &sphereX, &sphereY, &sphereZ, &sphereRadius})
+    {
+        values->resize(padded, 0.0f);
+    }
+}
+
+void FrustumCuller::update(const SceneGraph &graph, uint32_t begin, uint32_t end)
+{
+    uint32_t nodeCount = graph.getNodeCount();
+    for (uint32_t object = begin; object < end; object++)
+    {
+        if (nodes[object] >= nodeCount)
+        {
+            continue;
+        }
+
+        const float *m = graph.getWorldMatrix(nodes[object]).m;
+        const Bounds &bounds = localBounds[object];
+        float extent[3];
+        for (int axis = 0; axis < 3; axis++)
+        {
+            extent[axis] = (bounds.max[axis] - bounds.min[axis]) * 0.5f;
+        }
+
+        // Box center and extent (Arvo), the extent is scaled by the absolute matrix
+        const float *c = bounds.center;
+        centerX[object] = m[0] * c[0] + m[4] * c[1] + m[8] * c[2] + m[12];
+        centerY[object] = m[1] * c[0] + m[5] * c[1] + m[9] * c[2] + m[13];
+        centerZ[object] = m[2] * c[0] + m[6] * c[1] + m[10] * c[2] + m[14];
+        extentX[object] = std::fabs(m[0]) * extent[0] + std::fabs(m[4]) * extent[1] + std::fabs(m[8]) * extent[2];
+        extentY[object] = std::fabs(m[1]) * extent[0] + std::fabs(m[5]) * extent[1] + std::fabs(m[9]) * extent[2];
+        extentZ[object] = std::fabs(m[2]) * extent[0] + std::fabs(m[6]) * extent[1] + std::fabs(m[10]) * extent[2];
+
+        // The sphere shares the center of the box, its radius grows with the largest axis scale
+        sphereX[object] = centerX[object];
+        sphereY[object] = centerY[object];
+        sphereZ[object] = centerZ[object];
+        float scale = 0.0f;
+        for (int column = 0; column < 3; column++)
+        {
+            scale = std::max(scale, m[column * 4] * m[column * 4] + m[column * 4 + 1] * m[column * 4 + 1] + m[column * 4 + 2] * m[column * 4 + 2]);
+        }
+        sphereRadius[object] = bounds.radius * std::sqrt(scale);
+    }
+}
+
+void FrustumCuller::update(const SceneGraph &graph, ThreadPool *pool)
+{
+    TRACE_ZONE("FrustumCuller.update");
+
+    uint32_t objectCount = getObjectCount();
+    if (pool == nullptr)
+    {
+        update(graph, 0, objectCount);
+        return;
+    }
+
+    pool->parallelFor(objectCount, CULL_GRAIN, [&](uint32_t begin, uint32_t end)
+                      { update(graph, begin, end); });
+}
+
+uint32_t FrustumCuller::cull(const Frustum &frustum, uint32_t begin, uint32_t end, uint32_t *visible) const
+{
+    uint32_t count = 0;
+    uint32_t object = begin;
+
+#if defined(CULL_AVX) || defined(CULL_SSE)
+    for (; object < end; object += CULL_WIDTH)
+    {
+#ifdef CULL_AVX
+        __m256 cx = _mm256_loadu_ps(&centerX[object]);
+        __m256 cy = _mm256_loadu_ps(&centerY[object]);
+        __m256 cz = _mm256_loadu_ps(&centerZ[object]);
+        __m256 ex = _mm256_loadu_ps(&extentX[object]);
+        __m256 ey = _mm256_loadu_ps(&extentY[object]);
+        __m256 ez = _mm256_loadu_ps(&extentZ[object]);
+        __m256 sx = _mm256_loadu_ps(&sphereX[object]);
+        __m256 sy = _mm256_loadu_ps(&sphereY[object]);
+        __m256 sz = _mm256_loadu_ps(&sphereZ[object]);
+        __m256 sr = _mm256_loadu_ps(&sphereRadius[object]);
+        __m256 inside = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+        for (const auto &plane : frustum.planes)
+        {
+            __m256 nx = _mm256_set1_ps(plane[0]);
+            __m256 ny = _mm256_set1_ps(plane[1]);
+            __m256 nz = _mm256_set1_ps(plane[2]);
+            __m256 w = _mm256_set1_ps(plane[3]);
+
+            __m256 box = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(nx, cx), _mm256_mul_ps(ny, cy)), _mm256_add_ps(_mm256_mul_ps(nz, cz), w));
+            box = _mm256_add_ps(box, _mm256_mul_ps(_mm256_set1_ps(std::fabs(plane[0])), ex));
+            box = _mm256_add_ps(box, _mm256_mul_ps(_mm256_set1_ps(std::fabs(plane[1])), ey));
+            box = _mm256_add_ps(box, _mm256_mul_ps(_mm256_set1_ps(std::fabs(plane[2])), ez));
+            __m256 sphere = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(nx, sx), _mm256_mul_ps(ny, sy)), _mm256_add_ps(_mm256_mul_ps(nz, sz), _mm256_add_ps(w, sr)));
+
+            __m256 zero = _mm256_setzero_ps();
+            inside = _mm256_and_ps(inside, _mm256_and_ps(_mm256_cmp_ps(box, zero, _CMP_GE_OQ), _mm256_cmp_ps(sphere, zero, _CMP_GE_OQ)));
+        }
+        uint32_t mask = static_cast<uint32_t>(_mm256_movemask_ps(inside));
+#else
+        __m128 cx = _mm_loadu_ps(&centerX[object]);
+        __m128 cy = _mm_loadu_ps(&centerY[object]);
+        __m128 cz = _mm_loadu_ps(&centerZ[object]);
+        __m128 ex = _mm_loadu_ps(&extentX[object]);
+        __m128 ey = _mm_loadu_ps(&extentY[object]);
+        __m128 ez = _mm_loadu_ps(&extentZ[object]);
+        __m128 sx = _mm_loadu_ps(&sphereX[object]);
+        __m128 sy = _mm_loadu_ps(&sphereY[object]);
+        __m128 sz = _mm_loadu_ps(&sphereZ[object]);
+        __m128 sr = _mm_loadu_ps(&sphereRadius[object]);
+        __m128 inside = _mm_cmpeq_ps(cx, cx);
+        for (const auto &plane : frustum.planes)
+        {
+            __m128 nx = _mm_set1_ps(plane[0]);
+            __m128 ny = _mm_set1_ps(plane[1]);
+            __m128 nz = _mm_set1_ps(plane[2]);
+            __m128 w = _mm_set1_ps(plane[3]);
+
+            __m128 box = _mm_add_ps(_mm_add_ps(_mm_mul_ps(nx, cx), _mm_mul_ps(ny, cy)), _mm_add_ps(_mm_mul_ps(nz, cz), w));
+            box = _mm_add_ps(box, _mm_mul_ps(_mm_set1_ps(std::fabs(plane[0])), ex));
+            box = _mm_add_ps(box, _mm_mul_ps(_mm_set1_ps(std::fabs(plane[1])), ey));
+            box = _mm_add_ps(box, _mm_mul_ps(_mm_set1_ps(std::fabs(plane[2])), ez));
+            __m128 sphere = _mm_add_ps(_mm_add_ps(_mm_mul_ps(nx, sx), _mm_mul_ps(ny, sy)), _mm_add_ps(_mm_mul_ps(nz, sz), _mm_add_ps(w, sr)));
+
+            __m128 zero = _mm_setzero_ps();
+            inside = _mm_and_ps(inside, _mm_and_ps(_mm_cmpge_ps(box, zero), _mm_cmpge_ps(sphere, zero)));
+        }
+        uint32_t mask = static_cast<uint32_t>(_mm_movemask_ps(inside));
+#endif
+        // Lanes past the end read padding or the next chunk and are dropped
+        if (end - object < CULL_WIDTH)
+        {
+            mask &= (1u << (end - object)) - 1;
+        }
+        while (mask != 0)
+        {
+            uint32_t lane = 0;
+            while ((mask & (1u << lane)) == 0)
+            {
+                lane++;
+            }
+            visible[count++] = object + lane;
+            mask &= mask - 1;
+        }
+    }
+#else
+    for (; object < end; object++)
+    {
+        bool inside = true;
+        for (const auto &plane : frustum.planes)
+        {
+            float distance = plane[0] * centerX[object] + plane[1] * centerY[object] + plane[2] * centerZ[object] + plane[3];
+            float box = distance + std::fabs(plane[0]) * extentX[object] + std::fabs(plane[1]) * extentY[object] + std::fabs(plane[2]) * extentZ[object];
+            float sphere = plane[0] * sphereX[object] + plane[1] * sphereY[object] + plane[2] * sphereZ[object] + plane[3] + sphereRadius[object];
+            inside = inside && box >= 0.0f && sphere >= 0.0f;
+        }
+        if (inside)
+        {
+            visible[count++] = object;
+        }
+    }
+#endif
+    return count;
+}
+
+uint32_t FrustumCuller::cull(const Frustum &frustum, ThreadPool *pool, uint32_t *visible) const
+{
+    TRACE_ZONE("FrustumCuller.cull");
+
+    uint32_t objectCount = getObjectCount();
+    if (pool == nullptr)
+    {
+        return cull(frustum, 0, objectCount, visible);
+    }
+
+    // Every chunk writes its visible objects at its own start, afterwards the chunks are compacted in order
+    uint32_t chunkCount = (objectCount + CULL_GRAIN - 1) / CULL_GRAIN;
+    std::vector<uint32_t> counts(chunkCount);
+    pool->parallelFor(objectCount, CULL_GRAIN, [&](uint32_t begin, uint32_t end)
+                      {
+                          for (uint32_t chunk = begin / CULL_GRAIN; chunk * CULL_GRAIN < end; chunk++)
+                          {
+                              uint32_t chunkBegin = chunk * CULL_GRAIN;
+                              counts[chunk] = cull(frustum, chunkBegin, std::min(chunkBegin + CULL_GRAIN, end), visible + chunkBegin);
+                          } });
+
+    uint32_t count = 0;
+    for (uint32_t chunk = 0; chunk < chunkCount; chunk++)
+    {
+        memmove(visible + count, visible + chunk * CULL_GRAIN, counts[chunk] * sizeof(uint32_t));
+        count += counts[chunk];
+    }
+    return count;
+}
+
+/**
+ * @brief JNI function to create an empty frustum culler.
+ *
+ * @param env The JNI environment.
+ * @param cls The Java class.
+ * @return The native culler pointer.
+ */
+JNIEXPORT jlong JNICALL Java_com_github_nodedev74_jfbx_scene_FrustumCuller_create(JNIEnv *env, jclass cls)
+{
+    return reinterpret_cast<jlong>(new FrustumCuller());
+}
+
+/**
+ * @brief JNI function to add an object.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ * @param node The scene graph node.
+ * @param positions The local positions the bounds are computed from, x, y and z per point.
+ * @return The object index.
+ */
+JNIEXPORT jint JNICALL Java_com_github_nodedev74_jfbx_scene_FrustumCuller_add(JNIEnv *env, jobject obj, jint node, jfloatArray positions)
+{
+    std::vector<float> values(env->GetArrayLength(positions));
+    env->GetFloatArrayRegion(positions, 0, static_cast<jsize>(values.size()), values.data());
+    return static_cast<jint>(getCuller(env, obj)->add(static_cast<uint32_t>(node), Bounds::fromPositions(values.data(), values.size() / 3)));
+}
+
+/**
+ * @brief JNI function to retrieve the number of objects.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ * @return The object count.
+ */
+JNIEXPORT jint JNICALL Java_com_github_nodedev74_jfbx_scene_FrustumCuller_getObjectCount(JNIEnv *env, jobject obj)
+{
+    return static_cast<jint>(getCuller(env, obj)->getObjectCount());
+}
+
+/**
+ * @brief JNI function to transform the bounds of all objects into world space.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ * @param graph The Java scene graph after its update.
+ * @param parallel True to update on the shared thread pool.
+ */
+JNIEXPORT void JNICALL Java_com_github_nodedev74_jfbx_scene_FrustumCuller_update(JNIEnv *env, jobject obj, jobject graph, jboolean parallel)
+{
+    jclass graphClass = env->GetObjectClass(graph);
+    jfieldID fieldID = env->GetFieldID(graphClass, "graphPtr", "J");
+    SceneGraph *sceneGraph = reinterpret_cast<SceneGraph *>(env->GetLongField(graph, fieldID));
+    getCuller(env, obj)->update(*sceneGraph, parallel ? &ThreadPool::shared() : nullptr);
+}
+
+/**
+ * @brief JNI function to collect the objects intersecting a view frustum.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ * @param viewProjection The column major view projection matrix.
+ * @param visible Receives the visible object indices.
+ * @param parallel True to cull on the shared thread pool.
+ * @return The number of visible objects, or -1 if the visible array is too short.
+ */
+JNIEXPORT jint JNICALL Java_com_github_nodedev74_jfbx_scene_FrustumCuller_cull(JNIEnv *env, jobject obj, jfloatArray viewProjection, jintArray visible, jboolean parallel)
+{
+    FrustumCuller *culler = getCuller(env, obj);
+    if (env->GetArrayLength(visible) < static_cast<jsize>(culler->getObjectCount()) || env->GetArrayLength(viewProjection) < 16)
+    {
+        return -1;
+    }
+
+    Matrix4 matrix;
+    env->GetFloatArrayRegion(viewProjection, 0, 16, matrix.m);
+    Frustum frustum = Frustum::fromViewProjection(matrix);
+
+    jint *indices = static_cast<jint *>(env->GetPrimitiveArrayCritical(visible, nullptr));
+    uint32_t count = culler->cull(frustum, parallel ? &ThreadPool::shared() : nullptr, reinterpret_cast<uint32_t *>(indices));
+    env->ReleasePrimitiveArrayCritical(visible, indices, 0);
+    return static_cast<jint>(count);
+}
+
+/**
+ * @brief JNI function to release the native culler.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ */
+JNIEXPORT void JNICALL Java_com_github_nodedev74_jfbx_scene_FrustumCuller_destroy(JNIEnv *env, jobject obj)
+{
+    delete getCuller(env, obj);
+
+    jclass cls = env->GetObjectClass(obj);
+    jfieldID fieldID = env->GetFieldID(cls, "cullerPtr", "J");
+    env->SetLongField(obj, fieldID, 0);
+}
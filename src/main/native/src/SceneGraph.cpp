@@ -0,0 +1,681 @@
+/**
+ * @file SceneGraph.cpp
+ * @author Lenard Büsing (nodedev74@gmail.com)
+ * @brief Implementation of the flat scene graph.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2023 Lenard Büsing
+ *
+ */
+
+#include "com_github_nodedev74_jfbx_scene_SceneGraph.h"
+#include <jni.h>
+
+#include "scene/SceneGraph.hpp"
+#include "fbx/FbxScene.hpp"
+#include "core/ThreadPool.hpp"
+#include "core/Tracer.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+
+#if defined(__SSE__) || defined(_M_X64)
+#include <xmmintrin.h>
+#define SCENE_GRAPH_SSE 1
+#endif
+
+namespace
+{
+    constexpr uint32_t UPDATE_GRAIN = 2048;
+    constexpr float DEGREES_TO_RADIANS = 3.14159265358979323846f / 180.0f;
+
+    /**
+     * @brief Computes out = a * b for column major matrices.
+     */
+    inline void multiply(const Matrix4 &a, const Matrix4 &b, Matrix4 &out)
+    {
+#ifdef SCENE_GRAPH_SSE
+        __m128 a0 = _mm_load_ps(a.m);
+        __m128 a1 = _mm_load_ps(a.m + 4);
+        __m128 a2 = _mm_load_ps(a.m + 8);
+        __m128 a3 = _mm_load_ps(a.m + 12);
+        for (int column = 0; column < 4; column++)
+        {
+            const float *b0 = b.m + column * 4;
+            __m128 result = _mm_mul_ps(a0, _mm_set1_ps(b0[0]));
+            result = _mm_add_ps(result, _mm_mul_ps(a1, _mm_set1_ps(b0[1])));
+            result = _mm_add_ps(result, _mm_mul_ps(a2, _mm_set1_ps(b0[2])));
+            result = _mm_add_ps(result, _mm_mul_ps(a3, _mm_set1_ps(b0[3])));
+            _mm_store_ps(out.m + column * 4, result);
+        }
+#else
+        Matrix4 result;
+        for (int column = 0; column < 4; column++)
+        {
+            for (int row = 0; row < 4; row++)
+            {
+                result.m[column * 4 + row] = a.m[row] * b.m[column * 4] + a.m[4 + row] * b.m[column * 4 + 1] +
+                                             a.m[8 + row] * b.m[column * 4 + 2] + a.m[12 + row] * b.m[column * 4 + 3];
+            }
+        }
+        out = result;
+#endif
+    }
+
+    /**
+     * @brief Computes out = a * b for column major 3x3 matrices.
+     */
+    inline void multiply3(const float *a, const float *b, float *out)
+    {
+        float result[9];
+        for (int column = 0; column < 3; column++)
+        {
+            for (int row = 0; row < 3; row++)
+            {
+                result[column * 3 + row] = a[row] * b[column * 3] + a[3 + row] * b[column * 3 + 1] + a[6 + row] * b[column * 3 + 2];
+            }
+        }
+        std::memcpy(out, result, sizeof(result));
+    }
+
+    /**
+     * @brief Computes the rotation matrix of Euler angles in degrees.
+     *
+     * For the order XYZ the rotation around x is applied first, i.e. R = Rz * Ry * Rx.
+     */
+    void eulerToMatrix(uint8_t order, float x, float y, float z, float *out)
+    {
+        float sx = std::sin(x * DEGREES_TO_RADIANS), cx = std::cos(x * DEGREES_TO_RADIANS);
+        float sy = std::sin(y * DEGREES_TO_RADIANS), cy = std::cos(y * DEGREES_TO_RADIANS);
+        float sz = std::sin(z * DEGREES_TO_RADIANS), cz = std::cos(z * DEGREES_TO_RADIANS);
+
+        const float rx[9] = {1, 0, 0, 0, cx, sx, 0, -sx, cx};
+        const float ry[9] = {cy, 0, -sy, 0, 1, 0, sy, 0, cy};
+        const float rz[9] = {cz, sz, 0, -sz, cz, 0, 0, 0, 1};
+
+        const float *first = rx, *second = ry, *third = rz;
+        switch (order)
+        {
+        case 1: // XZY
+            second = rz, third = ry;
+            break;
+        case 2: // YZX
+            first = ry, second = rz, third = rx;
+            break;
+        case 3: // YXZ
+            first = ry, second = rx, third = rz;
+            break;
+        case 4: // ZXY
+            first = rz, second = rx, third = ry;
+            break;
+        case 5: // ZYX
+            first = rz, second = ry, third = rx;
+            break;
+        default:
+            break;
+        }
+
+        float temp[9];
+        multiply3(second, first, temp);
+        multiply3(third, temp, out);
+    }
+
+    Matrix4 rotationMatrix(const float *r)
+    {
+        Matrix4 result = Matrix4::identity();
+        for (int column = 0; column < 3; column++)
+        {
+            for (int row = 0; row < 3; row++)
+            {
+                result.m[column * 4 + row] = r[column * 3 + row];
+            }
+        }
+        return result;
+    }
+
+    Matrix4 translationMatrix(double x, double y, double z)
+    {
+        Matrix4 result = Matrix4::identity();
+        result.m[12] = static_cast<float>(x);
+        result.m[13] = static_cast<float>(y);
+        result.m[14] = static_cast<float>(z);
+        return result;
+    }
+
+    Matrix4 operator*(const Matrix4 &a, const Matrix4 &b)
+    {
+        Matrix4 result;
+        multiply(a, b, result);
+        return result;
+    }
+
+    bool isZero(const double *v)
+    {
+        return v[0] == 0.0 && v[1] == 0.0 && v[2] == 0.0;
+    }
+
+    SceneGraph *getGraph(JNIEnv *env, jobject obj)
+    {
+        jclass cls = env->GetObjectClass(obj);
+        jfieldID fieldID = env->GetFieldID(cls, "graphPtr", "J");
+        return reinterpret_cast<SceneGraph *>(env->GetLongField(obj, fieldID));
+    }
+
+    void throwFbxError(JNIEnv *env, const char *what)
+    {
+        jclass exceptionClass = env->FindClass("com/github/nodedev74/jfbx/exception/FbxRuntimeError");
+        jmethodID constructorID = env->GetMethodID(exceptionClass, "<init>", "(Ljava/lang/String;)V");
+        jstring message = env->NewStringUTF(what);
+        jobject exceptionObject = env->NewObject(exceptionClass, constructorID, message);
+        env->Throw(static_cast<jthrowable>(exceptionObject));
+    }
+
+    SceneGraph *getGraph(JNIEnv *env, jobject obj, jint node)
+    {
+        SceneGraph *graph = getGraph(env, obj);
+        if (node < 0 || static_cast<uint32_t>(node) >= graph->getNodeCount())
+        {
+            throwFbxError(env, "Scene graph node index out of range");
+            return nullptr;
+        }
+        return graph;
+    }
+}
+
+Matrix4 Matrix4::identity()
+{
+    Matrix4 result = {};
+    result.m[0] = result.m[5] = result.m[10] = result.m[15] = 1.0f;
+    return result;
+}
+
+void Matrix4::multiply(const Matrix4 &a, const Matrix4 &b, Matrix4 &out)
+{
+    ::multiply(a, b, out);
+}
+
+SceneGraph::SceneGraph(const std::vector<int32_t> &parentList)
+{
+    uint32_t count = static_cast<uint32_t>(parentList.size());
+    for (int32_t parent : parentList)
+    {
+        if (parent >= static_cast<int64_t>(count))
+        {
+            throw std::runtime_error("Scene graph parent out of range");
+        }
+    }
+
+    // Nodes on the walked path are marked, so reaching a marked node again means the parents form a cycle
+    const int32_t onPath = -2;
+    std::vector<int32_t> depths(count, -1);
+    std::vector<uint32_t> path;
+    uint32_t levelCount = 0;
+    for (uint32_t i = 0; i < count; i++)
+    {
+        uint32_t node = i;
+        while (depths[node] < 0 && parentList[node] >= 0)
+        {
+            if (depths[node] == onPath)
+            {
+                throw std::runtime_error("Scene graph parents form a cycle");
+            }
+            depths[node] = onPath;
+            path.push_back(node);
+            node = static_cast<uint32_t>(parentList[node]);
+        }
+        if (depths[node] < 0)
+        {
+            depths[node] = 0;
+        }
+        for (auto it = path.rbegin(); it != path.rend(); ++it)
+        {
+            depths[*it] = depths[parentList[*it]] + 1;
+        }
+        path.clear();
+        levelCount = std::max(levelCount, static_cast<uint32_t>(depths[i]) + 1);
+    }
+
+    levelOffsets.assign(levelCount + 1, 0);
+    for (uint32_t i = 0; i < count; i++)
+    {
+        levelOffsets[depths[i] + 1]++;
+    }
+    for (uint32_t level = 0; level < levelCount; level++)
+    {
+        levelOffsets[level + 1] += levelOffsets[level];
+    }
+
+    std::vector<uint32_t> cursor(levelOffsets.begin(), levelOffsets.end() - 1);
+    slots.resize(count);
+    for (uint32_t i = 0; i < count; i++)
+    {
+        slots[i] = cursor[depths[i]]++;
+    }
+
+    parents.resize(count);
+    for (uint32_t i = 0; i < count; i++)
+    {
+        parents[slots[i]] = parentList[i] >= 0 ? static_cast<int32_t>(slots[parentList[i]]) : -1;
+    }
+
+    translationX.assign(count, 0.0f);
+    translationY.assign(count, 0.0f);
+    translationZ.assign(count, 0.0f);
+    rotationX.assign(count, 0.0f);
+    rotationY.assign(count, 0.0f);
+    rotationZ.assign(count, 0.0f);
+    scalingX.assign(count, 1.0f);
+    scalingY.assign(count, 1.0f);
+    scalingZ.assign(count, 1.0f);
+    rotationOrders.assign(count, 0);
+
+    hasPivots.assign(count, 0);
+    preRotationMatrices.assign(count, Matrix4::identity());
+    postRotationMatrices.assign(count, Matrix4::identity());
+    postScalingMatrices.assign(count, Matrix4::identity());
+
+    localDirty.assign(count, 1);
+    worldChanged.assign(count, 0);
+    worldMatrices.assign(count, Matrix4::identity());
+    dirtyCount = count;
+}
+
+SceneGraph *SceneGraph::fromScene(const FbxScene &scene)
+{
+    const std::vector<FbxModel> &models = scene.getModels();
+
+    std::vector<int32_t> parentList(models.size());
+    for (size_t i = 0; i < models.size(); i++)
+    {
+        parentList[i] = models[i].parent;
+    }
+
+    SceneGraph *graph = new SceneGraph(parentList);
+    for (uint32_t i = 0; i < models.size(); i++)
+    {
+        const FbxModel &model = models[i];
+        graph->setTranslation(i, model.translation[0], model.translation[1], model.translation[2]);
+        graph->setRotation(i, model.rotation[0], model.rotation[1], model.rotation[2]);
+        graph->setScaling(i, model.scaling[0], model.scaling[1], model.scaling[2]);
+        graph->setRotationOrder(i, static_cast<uint8_t>(model.rotationOrder));
+
+        if (isZero(model.preRotation) && isZero(model.postRotation) && isZero(model.rotationOffset) &&
+            isZero(model.rotationPivot) && isZero(model.scalingOffset) && isZero(model.scalingPivot))
+        {
+            continue;
+        }
+
+        // Local = T * Roff * Rp * Rpre * R * Rpost^-1 * Rp^-1 * Soff * Sp * S * Sp^-1
+        float preRotation[9], postRotation[9], postRotationInverse[9];
+        eulerToMatrix(0, model.preRotation[0], model.preRotation[1], model.preRotation[2], preRotation);
+        eulerToMatrix(0, model.postRotation[0], model.postRotation[1], model.postRotation[2], postRotation);
+        for (int column = 0; column < 3; column++)
+        {
+            for (int row = 0; row < 3; row++)
+            {
+                postRotationInverse[column * 3 + row] = postRotation[row * 3 + column];
+            }
+        }
+
+        const double *rp = model.rotationPivot;
+        const double *sp = model.scalingPivot;
+        const double *ro = model.rotationOffset;
+        const double *so = model.scalingOffset;
+
+        uint32_t slot = graph->slots[i];
+        graph->hasPivots[slot] = 1;
+        graph->preRotationMatrices[slot] = translationMatrix(ro[0] + rp[0], ro[1] + rp[1], ro[2] + rp[2]) * rotationMatrix(preRotation);
+        graph->postRotationMatrices[slot] = rotationMatrix(postRotationInverse) *
+                                            translationMatrix(so[0] + sp[0] - rp[0], so[1] + sp[1] - rp[1], so[2] + sp[2] - rp[2]);
+        graph->postScalingMatrices[slot] = translationMatrix(-sp[0], -sp[1], -sp[2]);
+    }
+    return graph;
+}
+
+uint32_t SceneGraph::getNodeCount() const
+{
+    return static_cast<uint32_t>(slots.size());
+}
+
+uint32_t SceneGraph::getLevelCount() const
+{
+    return static_cast<uint32_t>(levelOffsets.size()) - 1;
+}
+
+uint32_t SceneGraph::getSlot(uint32_t node) const
+{
+    return slots[node];
+}
+
+void SceneGraph::setTranslation(uint32_t node, float x, float y, float z)
+{
+    uint32_t slot = slots[node];
+    translationX[slot] = x;
+    translationY[slot] = y;
+    translationZ[slot] = z;
+    markDirty(slot);
+}
+
+void SceneGraph::setRotation(uint32_t node, float x, float y, float z)
+{
+    uint32_t slot = slots[node];
+    rotationX[slot] = x;
+    rotationY[slot] = y;
+    rotationZ[slot] = z;
+    markDirty(slot);
+}
+
+void SceneGraph::setScaling(uint32_t node, float x, float y, float z)
+{
+    uint32_t slot = slots[node];
+    scalingX[slot] = x;
+    scalingY[slot] = y;
+    scalingZ[slot] = z;
+    markDirty(slot);
+}
+
+void SceneGraph::setRotationOrder(uint32_t node, uint8_t order)
+{
+    uint32_t slot = slots[node];
+    rotationOrders[slot] = order;
+    markDirty(slot);
+}
+
+void SceneGraph::setProperty(uint32_t node, uint8_t property, float value)
+{
+    std::vector<float> *components[] = {&translationX, &translationY, &translationZ,
+                                        &rotationX, &rotationY, &rotationZ,
+                                        &scalingX, &scalingY, &scalingZ};
+    if (property >= sizeof(components) / sizeof(components[0]))
+    {
+        return;
+    }
+
+    uint32_t slot = slots[node];
+    if ((*components[property])[slot] != value)
+    {
+        (*components[property])[slot] = value;
+        markDirty(slot);
+    }
+}
+
+uint32_t SceneGraph::update(ThreadPool &pool)
+{
+    TRACE_ZONE("SceneGraph.update");
+
+    if (dirtyCount == 0)
+    {
+        return 0;
+    }
+
+    std::atomic<uint32_t> updated{0};
+    for (uint32_t level = 0; level + 1 < levelOffsets.size(); level++)
+    {
+        uint32_t levelBegin = levelOffsets[level];
+        uint32_t levelEnd = levelOffsets[level + 1];
+
+        pool.parallelFor(levelEnd - levelBegin, UPDATE_GRAIN, [&](uint32_t begin, uint32_t end)
+                         {
+            uint32_t count = 0;
+            for (uint32_t slot = levelBegin + begin; slot < levelBegin + end; slot++)
+            {
+                int32_t parent = parents[slot];
+                bool changed = localDirty[slot] || (parent >= 0 && worldChanged[parent]);
+                worldChanged[slot] = changed;
+                if (!changed)
+                {
+                    continue;
+                }
+
+                if (parent >= 0)
+                {
+                    Matrix4 local;
+                    computeLocal(slot, local);
+                    multiply(worldMatrices[parent], local, worldMatrices[slot]);
+                }
+                else
+                {
+                    computeLocal(slot, worldMatrices[slot]);
+                }
+                localDirty[slot] = 0;
+                count++;
+            }
+            updated.fetch_add(count, std::memory_order_relaxed); });
+    }
+
+    dirtyCount = 0;
+    return updated.load();
+}
+
+const Matrix4 &SceneGraph::getWorldMatrix(uint32_t node) const
+{
+    return worldMatrices[slots[node]];
+}
+
+const Matrix4 *SceneGraph::getWorldMatrices() const
+{
+    return worldMatrices.data();
+}
+
+void SceneGraph::markDirty(uint32_t slot)
+{
+    if (!localDirty[slot])
+    {
+        localDirty[slot] = 1;
+        dirtyCount++;
+    }
+}
+
+void SceneGraph::computeLocal(uint32_t slot, Matrix4 &out) const
+{
+    float r[9];
+    eulerToMatrix(rotationOrders[slot], rotationX[slot], rotationY[slot], rotationZ[slot], r);
+
+    float sx = scalingX[slot], sy = scalingY[slot], sz = scalingZ[slot];
+    if (!hasPivots[slot])
+    {
+        out.m[0] = r[0] * sx, out.m[1] = r[1] * sx, out.m[2] = r[2] * sx, out.m[3] = 0.0f;
+        out.m[4] = r[3] * sy, out.m[5] = r[4] * sy, out.m[6] = r[5] * sy, out.m[7] = 0.0f;
+        out.m[8] = r[6] * sz, out.m[9] = r[7] * sz, out.m[10] = r[8] * sz, out.m[11] = 0.0f;
+        out.m[12] = translationX[slot], out.m[13] = translationY[slot], out.m[14] = translationZ[slot], out.m[15] = 1.0f;
+        return;
+    }
+
+    Matrix4 rotated, scaled;
+    multiply(preRotationMatrices[slot], rotationMatrix(r), rotated);
+    multiply(rotated, postRotationMatrices[slot], scaled);
+    for (int row = 0; row < 4; row++)
+    {
+        scaled.m[row] *= sx;
+        scaled.m[4 + row] *= sy;
+        scaled.m[8 + row] *= sz;
+    }
+    multiply(scaled, postScalingMatrices[slot], out);
+    out.m[12] += translationX[slot];
+    out.m[13] += translationY[slot];
+    out.m[14] += translationZ[slot];
+}
+
+/**
+ * @brief JNI function to create a scene graph from a parent list.
+ *
+ * @param env The JNI environment.
+ * @param cls The Java class.
+ * @param parentArray The parent node of every node, negative for roots.
+ * @return The native scene graph pointer.
+ */
+JNIEXPORT jlong JNICALL Java_com_github_nodedev74_jfbx_scene_SceneGraph_create(JNIEnv *env, jclass cls, jintArray parentArray)
+{
+    std::vector<int32_t> parentList(env->GetArrayLength(parentArray));
+    env->GetIntArrayRegion(parentArray, 0, static_cast<jsize>(parentList.size()), parentList.data());
+
+    try
+    {
+        return reinterpret_cast<jlong>(new SceneGraph(parentList));
+    }
+    catch (const std::exception &e)
+    {
+        throwFbxError(env, e.what());
+        return 0;
+    }
+}
+
+/**
+ * @brief JNI function to retrieve the number of nodes.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ * @return The node count.
+ */
+JNIEXPORT jint JNICALL Java_com_github_nodedev74_jfbx_scene_SceneGraph_getNodeCount(JNIEnv *env, jobject obj)
+{
+    return static_cast<jint>(getGraph(env, obj)->getNodeCount());
+}
+
+/**
+ * @brief JNI function to retrieve the number of depth levels.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ * @return The level count.
+ */
+JNIEXPORT jint JNICALL Java_com_github_nodedev74_jfbx_scene_SceneGraph_getLevelCount(JNIEnv *env, jobject obj)
+{
+    return static_cast<jint>(getGraph(env, obj)->getLevelCount());
+}
+
+/**
+ * @brief JNI function to retrieve the world matrix slot of a node.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ * @param node The node.
+ * @return The slot of the node.
+ */
+JNIEXPORT jint JNICALL Java_com_github_nodedev74_jfbx_scene_SceneGraph_getSlot(JNIEnv *env, jobject obj, jint node)
+{
+    SceneGraph *graph = getGraph(env, obj, node);
+    return graph != nullptr ? static_cast<jint>(graph->getSlot(node)) : -1;
+}
+
+/**
+ * @brief JNI function to set the local translation of a node.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ * @param node The node.
+ * @param x The translation along x.
+ * @param y The translation along y.
+ * @param z The translation along z.
+ */
+JNIEXPORT void JNICALL Java_com_github_nodedev74_jfbx_scene_SceneGraph_setTranslation(JNIEnv *env, jobject obj, jint node, jfloat x, jfloat y, jfloat z)
+{
+    SceneGraph *graph = getGraph(env, obj, node);
+    if (graph != nullptr)
+    {
+        graph->setTranslation(node, x, y, z);
+    }
+}
+
+/**
+ * @brief JNI function to set the local Euler rotation of a node in degrees.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ * @param node The node.
+ * @param x The rotation around x.
+ * @param y The rotation around y.
+ * @param z The rotation around z.
+ */
+JNIEXPORT void JNICALL Java_com_github_nodedev74_jfbx_scene_SceneGraph_setRotation(JNIEnv *env, jobject obj, jint node, jfloat x, jfloat y, jfloat z)
+{
+    SceneGraph *graph = getGraph(env, obj, node);
+    if (graph != nullptr)
+    {
+        graph->setRotation(node, x, y, z);
+    }
+}
+
+/**
+ * @brief JNI function to set the local scaling of a node.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ * @param node The node.
+ * @param x The scaling along x.
+ * @param y The scaling along y.
+ * @param z The scaling along z.
+ */
+JNIEXPORT void JNICALL Java_com_github_nodedev74_jfbx_scene_SceneGraph_setScaling(JNIEnv *env, jobject obj, jint node, jfloat x, jfloat y, jfloat z)
+{
+    SceneGraph *graph = getGraph(env, obj, node);
+    if (graph != nullptr)
+    {
+        graph->setScaling(node, x, y, z);
+    }
+}
+
+/**
+ * @brief JNI function to set the Euler rotation order of a node.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ * @param node The node.
+ * @param order The FBX rotation order.
+ */
+JNIEXPORT void JNICALL Java_com_github_nodedev74_jfbx_scene_SceneGraph_setRotationOrder(JNIEnv *env, jobject obj, jint node, jint order)
+{
+    SceneGraph *graph = getGraph(env, obj, node);
+    if (graph != nullptr)
+    {
+        graph->setRotationOrder(node, static_cast<uint8_t>(order));
+    }
+}
+
+/**
+ * @brief JNI function to recompute all out of date world matrices on the shared thread pool.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ * @return The number of recomputed nodes.
+ */
+JNIEXPORT jint JNICALL Java_com_github_nodedev74_jfbx_scene_SceneGraph_update(JNIEnv *env, jobject obj)
+{
+    return static_cast<jint>(getGraph(env, obj)->update(ThreadPool::shared()));
+}
+
+/**
+ * @brief JNI function to copy the world matrix of a node.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ * @param node The node.
+ * @param out The array receiving the 16 column major matrix elements.
+ */
+JNIEXPORT void JNICALL Java_com_github_nodedev74_jfbx_scene_SceneGraph_getWorldMatrix(JNIEnv *env, jobject obj, jint node, jfloatArray out)
+{
+    SceneGraph *graph = getGraph(env, obj, node);
+    if (graph != nullptr)
+    {
+        env->SetFloatArrayRegion(out, 0, 16, graph->getWorldMatrix(node).m);
+    }
+}
+
+/**
+ * @brief JNI function to release the native scene graph.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ */
+JNIEXPORT void JNICALL Java_com_github_nodedev74_jfbx_scene_SceneGraph_destroy(JNIEnv *env, jobject obj)
+{
+    delete getGraph(env, obj);
+
+    jclass cls = env->GetObjectClass(obj);
+    jfieldID fieldID = env->GetFieldID(cls, "graphPtr", "J");
+    env->SetLongField(obj, fieldID, 0);
+}
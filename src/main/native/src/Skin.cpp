@@ -0,0 +1,428 @@
+/**
+ * @file Skin.cpp
+ * @author Lenard Büsing (nodedev74@gmail.com)
+ * @brief Implementation of the skin bind pose and the CPU reference skinning.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2023 Lenard Büsing
+ *
+ */
+
+#include "com_github_nodedev74_jfbx_anim_Skin.h"
+#include <jni.h>
+
+#include "anim/Skin.hpp"
+#include "fbx/FbxScene.hpp"
+#include "core/ThreadPool.hpp"
+#include "core/Tracer.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+#if defined(__SSE__) || defined(_M_X64)
+#include <xmmintrin.h>
+#define SKIN_SSE 1
+#endif
+
+namespace
+{
+    constexpr uint32_t SKIN_GRAIN = 4096;
+
+    /**
+     * @brief Inverts a column major 4x4 matrix by cofactor expansion.
+     */
+    bool invert(const double *m, double *out)
+    {
+        double inv[16];
+        inv[0] = m[5] * m[10] * m[15] - m[5] * m[11] * m[14] - m[9] * m[6] * m[15] + m[9] * m[7] * m[14] + m[13] * m[6] * m[11] - m[13] * m[7] * m[10];
+        inv[4] = -m[4] * m[10] * m[15] + m[4] * m[11] * m[14] + m[8] * m[6] * m[15] - m[8] * m[7] * m[14] - m[12] * m[6] * m[11] + m[12] * m[7] * m[10];
+        inv[8] = m[4] * m[9] * m[15] - m[4] * m[11] * m[13] - m[8] * m[5] * m[15] + m[8] * m[7] * m[13] + m[12] * m[5] * m[11] - m[12] * m[7] * m[9];
+        inv[12] = -m[4] * m[9] * m[14] + m[4] * m[10] * m[13] + m[8] * m[5] * m[14] - m[8] * m[6] * m[13] - m[12] * m[5] * m[10] + m[12] * m[6] * m[9];
+        inv[1] = -m[1] * m[10] * m[15] + m[1] * m[11] * m[14] + m[9] * m[2] * m[15] - m[9] * m[3] * m[14] - m[13] * m[2] * m[11] + m[13] * m[3] * m[10];
+        inv[5] = m[0] * m[10] * m[15] - m[0] * m[11] * m[14] - m[8] * m[2] * m[15] + m[8] * m[3] * m[14] + m[12] * m[2] * m[11] - m[12] * m[3] * m[10];
+        inv[9] = -m[0] * m[9] * m[15] + m[0] * m[11] * m[13] + m[8] * m[1] * m[15] - m[8] * m[3] * m[13] - m[12] * m[1] * m[11] + m[12] * m[3] * m[9];
+        inv[13] = m[0] * m[9] * m[14] - m[0] * m[10] * m[13] - m[8] * m[1] * m[14] + m[8] * m[2] * m[13] + m[12] * m[1] * m[10] - m[12] * m[2] * m[9];
+        inv[2] = m[1] * m[6] * m[15] - m[1] * m[7] * m[14] - m[5] * m[2] * m[15] + m[5] * m[3] * m[14] + m[13] * m[2] * m[7] - m[13] * m[3] * m[6];
+        inv[6] = -m[0] * m[6] * m[15] + m[0] * m[7] * m[14] + m[4] * m[2] * m[15] - m[4] * m[3] * m[14] - m[12] * m[2] * m[7] + m[12] * m[3] * m[6];
+        inv[10] = m[0] * m[5] * m[15] - m[0] * m[7] * m[13] - m[4] * m[1] * m[15] + m[4] * m[3] * m[13] + m[12] * m[1] * m[7] - m[12] * m[3] * m[5];
+        inv[14] = -m[0] * m[5] * m[14] + m[0] * m[6] * m[13] + m[4] * m[1] * m[14] - m[4] * m[2] * m[13] - m[12] * m[1] * m[6] + m[12] * m[2] * m[5];
+        inv[3] = -m[1] * m[6] * m[11] + m[1] * m[7] * m[10] + m[5] * m[2] * m[11] - m[5] * m[3] * m[10] - m[9] * m[2] * m[7] + m[9] * m[3] * m[6];
+        inv[7] = m[0] * m[6] * m[11] - m[0] * m[7] * m[10] - m[4] * m[2] * m[11] + m[4] * m[3] * m[10] + m[8] * m[2] * m[7] - m[8] * m[3] * m[6];
+        inv[11] = -m[0] * m[5] * m[11] + m[0] * m[7] * m[9] + m[4] * m[1] * m[11] - m[4] * m[3] * m[9] - m[8] * m[1] * m[7] + m[8] * m[3] * m[5];
+        inv[15] = m[0] * m[5] * m[10] - m[0] * m[6] * m[9] - m[4] * m[1] * m[10] + m[4] * m[2] * m[9] + m[8] * m[1] * m[6] - m[8] * m[2] * m[5];
+
+        double determinant = m[0] * inv[0] + m[1] * inv[4] + m[2] * inv[8] + m[3] * inv[12];
+        if (determinant == 0.0)
+        {
+            return false;
+        }
+        for (int i = 0; i < 16; i++)
+        {
+            out[i] = inv[i] / determinant;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Quantizes the weights of a vertex to 16 bit so that they sum up to exactly 65535.
+     */
+    void packWeights(const float *weights, SkinInfluence &influence)
+    {
+        float sum = 0.0f;
+        for (uint32_t i = 0; i < SKIN_MAX_INFLUENCES; i++)
+        {
+            sum += std::max(weights[i], 0.0f);
+        }
+
+        if (sum <= 0.0f)
+        {
+            // Unweighted vertices follow the first joint instead of collapsing to the origin
+            std::fill(influence.weights, influence.weights + SKIN_MAX_INFLUENCES, 0);
+            influence.weights[0] = 65535;
+            return;
+        }
+
+        int32_t total = 0;
+        uint32_t largest = 0;
+        for (uint32_t i = 0; i < SKIN_MAX_INFLUENCES; i++)
+        {
+            influence.weights[i] = static_cast<uint16_t>(std::lround(std::max(weights[i], 0.0f) / sum * 65535.0f));
+            total += influence.weights[i];
+            largest = influence.weights[i] > influence.weights[largest] ? i : largest;
+        }
+        influence.weights[largest] = static_cast<uint16_t>(influence.weights[largest] + 65535 - total);
+    }
+
+    Skin *getSkin(JNIEnv *env, jobject obj)
+    {
+        jclass cls = env->GetObjectClass(obj);
+        jfieldID fieldID = env->GetFieldID(cls, "skinPtr", "J");
+        return reinterpret_cast<Skin *>(env->GetLongField(obj, fieldID));
+    }
+}
+
+Skin::Skin(const std::vector<float> &bindPositions, const std::vector<uint32_t> &joints, const std::vector<float> &weights,
+           const std::vector<uint32_t> &jointNodeList, const std::vector<Matrix4> &inverseBindMatrixList)
+    : jointNodes(jointNodeList), inverseBindMatrices(inverseBindMatrixList)
+{
+    size_t vertexCount = bindPositions.size() / 3;
+    if (bindPositions.size() % 3 != 0 || joints.size() != vertexCount * SKIN_MAX_INFLUENCES || weights.size() != joints.size())
+    {
+        throw std::runtime_error("Skin positions, joints and weights differ in length");
+    }
+    if (jointNodes.empty() || jointNodes.size() != inverseBindMatrices.size() || jointNodes.size() > UINT16_MAX)
+    {
+        throw std::runtime_error("Skin needs between 1 and 65535 joints, each with an inverse bind matrix");
+    }
+
+    positions.resize(vertexCount * 4);
+    influences.resize(vertexCount);
+    for (size_t vertex = 0; vertex < vertexCount; vertex++)
+    {
+        std::copy(&bindPositions[vertex * 3], &bindPositions[vertex * 3] + 3, &positions[vertex * 4]);
+        positions[vertex * 4 + 3] = 1.0f;
+
+        for (uint32_t i = 0; i < SKIN_MAX_INFLUENCES; i++)
+        {
+            uint32_t joint = joints[vertex * SKIN_MAX_INFLUENCES + i];
+            if (joint >= jointNodes.size())
+            {
+                throw std::runtime_error("Skin joint index out of range");
+            }
+            influences[vertex].joints[i] = static_cast<uint16_t>(joint);
+        }
+        packWeights(&weights[vertex * SKIN_MAX_INFLUENCES], influences[vertex]);
+    }
+}
+
+Skin *Skin::fromScene(const FbxScene &scene, uint32_t skinIndex)
+{
+    TRACE_ZONE("Skin.fromScene");
+
+    const FbxSkin &source = scene.getSkins()[skinIndex];
+    if (source.mesh < 0 || source.clusters.empty())
+    {
+        throw std::runtime_error("Skin deformer has no mesh or no clusters");
+    }
+    const FbxMesh &mesh = scene.getMeshes()[source.mesh];
+    size_t vertexCount = mesh.positions.size() / 3;
+
+    std::vector<uint32_t> joints(vertexCount * SKIN_MAX_INFLUENCES, 0);
+    std::vector<float> weights(vertexCount * SKIN_MAX_INFLUENCES, 0.0f);
+    std::vector<uint32_t> jointNodes;
+    std::vector<Matrix4> inverseBindMatrices;
+
+    for (const FbxCluster &cluster : source.clusters)
+    {
+        // Skinning matrix = bone world * TransformLink^-1 * Transform, the last two are constant
+        double inverseLink[16];
+        if (!invert(cluster.transformLink, inverseLink))
+        {
+            throw std::runtime_error("Cluster TransformLink is not invertible");
+        }
+        Matrix4 inverseBind;
+        for (int column = 0; column < 4; column++)
+        {
+            for (int row = 0; row < 4; row++)
+            {
+                double value = 0.0;
+                for (int k = 0; k < 4; k++)
+                {
+                    value += inverseLink[k * 4 + row] * cluster.transform[column * 4 + k];
+                }
+                inverseBind.m[column * 4 + row] = static_cast<float>(value);
+            }
+        }
+
+        uint32_t joint = static_cast<uint32_t>(jointNodes.size());
+        jointNodes.push_back(static_cast<uint32_t>(cluster.model));
+        inverseBindMatrices.push_back(inverseBind);
+
+        // Keep the largest influences per control point, sorted descending
+        for (size_t i = 0; i < cluster.indices.size(); i++)
+        {
+            if (cluster.indices[i] < 0 || static_cast<size_t>(cluster.indices[i]) >= vertexCount)
+            {
+                continue;
+            }
+            uint32_t *vertexJoints = &joints[cluster.indices[i] * SKIN_MAX_INFLUENCES];
+            float *vertexWeights = &weights[cluster.indices[i] * SKIN_MAX_INFLUENCES];
+            float weight = static_cast<float>(cluster.weights[i]);
+
+            int32_t slot = SKIN_MAX_INFLUENCES;
+            while (slot > 0 && vertexWeights[slot - 1] < weight)
+            {
+                slot--;
+            }
+            if (slot < static_cast<int32_t>(SKIN_MAX_INFLUENCES))
+            {
+                for (int32_t k = SKIN_MAX_INFLUENCES - 1; k > slot; k--)
+                {
+                    vertexJoints[k] = vertexJoints[k - 1];
+                    vertexWeights[k] = vertexWeights[k - 1];
+                }
+                vertexJoints[slot] = joint;
+                vertexWeights[slot] = weight;
+            }
+        }
+    }
+
+    return new Skin(mesh.positions, joints, weights, jointNodes, inverseBindMatrices);
+}
+
+uint32_t Skin::getVertexCount() const
+{
+    return static_cast<uint32_t>(influences.size());
+}
+
+uint32_t Skin::getJointCount() const
+{
+    return static_cast<uint32_t>(jointNodes.size());
+}
+
+const float *Skin::getPositions() const
+{
+    return positions.data();
+}
+
+const SkinInfluence *Skin::getInfluences() const
+{
+    return influences.data();
+}
+
+void Skin::computeJointMatrices(const SceneGraph &graph, uint32_t nodeOffset, Matrix4 *out) const
+{
+    uint32_t nodeCount = graph.getNodeCount();
+    for (size_t joint = 0; joint < jointNodes.size(); joint++)
+    {
+        uint32_t node = jointNodes[joint] + nodeOffset;
+        if (node < nodeCount)
+        {
+            Matrix4::multiply(graph.getWorldMatrix(node), inverseBindMatrices[joint], out[joint]);
+        }
+        else
+        {
+            out[joint] = Matrix4::identity();
+        }
+    }
+}
+
+void Skin::skin(const Matrix4 *jointMatrices, uint32_t begin, uint32_t end, float *out) const
+{
+    const float weightScale = 1.0f / 65535.0f;
+
+    for (uint32_t vertex = begin; vertex < end; vertex++)
+    {
+        const SkinInfluence &influence = influences[vertex];
+        const float *position = &positions[vertex * 4];
+
+#ifdef SKIN_SSE
+        // Blend the columns of the joint matrices, then transform the bind position once
+        __m128 columns[4];
+        for (int column = 0; column < 4; column++)
+        {
+            columns[column] = _mm_setzero_ps();
+        }
+        for (uint32_t i = 0; i < SKIN_MAX_INFLUENCES; i++)
+        {
+            if (influence.weights[i] == 0)
+            {
+                continue;
+            }
+            const float *matrix = jointMatrices[influence.joints[i]].m;
+            __m128 weight = _mm_set1_ps(influence.weights[i] * weightScale);
+            for (int column = 0; column < 4; column++)
+            {
+                columns[column] = _mm_add_ps(columns[column], _mm_mul_ps(_mm_load_ps(matrix + column * 4), weight));
+            }
+        }
+        __m128 result = _mm_mul_ps(columns[0], _mm_set1_ps(position[0]));
+        result = _mm_add_ps(result, _mm_mul_ps(columns[1], _mm_set1_ps(position[1])));
+        result = _mm_add_ps(result, _mm_mul_ps(columns[2], _mm_set1_ps(position[2])));
+        result = _mm_add_ps(result, columns[3]);
+        _mm_storeu_ps(out + vertex * 4, result);
+#else
+        float result[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+        for (uint32_t i = 0; i < SKIN_MAX_INFLUENCES; i++)
+        {
+            const float *matrix = jointMatrices[influence.joints[i]].m;
+            float weight = influence.weights[i] * weightScale;
+            for (int row = 0; row < 4; row++)
+            {
+                result[row] += weight * (matrix[row] * position[0] + matrix[4 + row] * position[1] + matrix[8 + row] * position[2] + matrix[12 + row]);
+            }
+        }
+        std::copy(result, result + 4, out + vertex * 4);
+#endif
+    }
+}
+
+void Skin::skin(const SceneGraph &graph, uint32_t nodeOffset, ThreadPool *pool, float *out) const
+{
+    TRACE_ZONE("Skin.skin");
+
+    std::vector<Matrix4> jointMatrices(jointNodes.size());
+    computeJointMatrices(graph, nodeOffset, jointMatrices.data());
+
+    uint32_t vertexCount = getVertexCount();
+    if (pool == nullptr)
+    {
+        skin(jointMatrices.data(), 0, vertexCount, out);
+        return;
+    }
+
+    pool->parallelFor(vertexCount, SKIN_GRAIN, [&](uint32_t begin, uint32_t end)
+                      { skin(jointMatrices.data(), begin, end, out); });
+}
+
+/**
+ * @brief JNI function to create a skin from per vertex influences.
+ *
+ * @param env The JNI environment.
+ * @param cls The Java class.
+ * @param positions The bind positions, x, y and z per vertex.
+ * @param joints Four joint indices per vertex.
+ * @param weights Four weights per vertex.
+ * @param jointNodes The scene graph node of every joint.
+ * @param inverseBindMatrices Sixteen column major floats per joint.
+ * @return The native skin pointer.
+ */
+JNIEXPORT jlong JNICALL Java_com_github_nodedev74_jfbx_anim_Skin_create(JNIEnv *env, jclass cls, jfloatArray positions, jintArray joints, jfloatArray weights, jintArray jointNodes, jfloatArray inverseBindMatrices)
+{
+    std::vector<float> positionValues(env->GetArrayLength(positions));
+    env->GetFloatArrayRegion(positions, 0, static_cast<jsize>(positionValues.size()), positionValues.data());
+
+    std::vector<jint> jointValues(env->GetArrayLength(joints));
+    env->GetIntArrayRegion(joints, 0, static_cast<jsize>(jointValues.size()), jointValues.data());
+
+    std::vector<float> weightValues(env->GetArrayLength(weights));
+    env->GetFloatArrayRegion(weights, 0, static_cast<jsize>(weightValues.size()), weightValues.data());
+
+    std::vector<jint> nodeValues(env->GetArrayLength(jointNodes));
+    env->GetIntArrayRegion(jointNodes, 0, static_cast<jsize>(nodeValues.size()), nodeValues.data());
+
+    std::vector<Matrix4> matrices(env->GetArrayLength(inverseBindMatrices) / 16);
+    env->GetFloatArrayRegion(inverseBindMatrices, 0, static_cast<jsize>(matrices.size() * 16), matrices.empty() ? nullptr : matrices[0].m);
+
+    try
+    {
+        return reinterpret_cast<jlong>(new Skin(positionValues, std::vector<uint32_t>(jointValues.begin(), jointValues.end()), weightValues,
+                                                std::vector<uint32_t>(nodeValues.begin(), nodeValues.end()), matrices));
+    }
+    catch (const std::exception &e)
+    {
+        jclass exceptionClass = env->FindClass("com/github/nodedev74/jfbx/exception/FbxRuntimeError");
+        jmethodID constructorID = env->GetMethodID(exceptionClass, "<init>", "(Ljava/lang/String;)V");
+        jstring message = env->NewStringUTF(e.what());
+        jobject exceptionObject = env->NewObject(exceptionClass, constructorID, message);
+        env->Throw(static_cast<jthrowable>(exceptionObject));
+        return 0;
+    }
+}
+
+/**
+ * @brief JNI function to retrieve the number of vertices.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ * @return The vertex count.
+ */
+JNIEXPORT jint JNICALL Java_com_github_nodedev74_jfbx_anim_Skin_getVertexCount(JNIEnv *env, jobject obj)
+{
+    return static_cast<jint>(getSkin(env, obj)->getVertexCount());
+}
+
+/**
+ * @brief JNI function to retrieve the number of joints.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ * @return The joint count.
+ */
+JNIEXPORT jint JNICALL Java_com_github_nodedev74_jfbx_anim_Skin_getJointCount(JNIEnv *env, jobject obj)
+{
+    return static_cast<jint>(getSkin(env, obj)->getJointCount());
+}
+
+/**
+ * @brief JNI function to skin all vertices on the CPU.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ * @param graph The Java scene graph after its update.
+ * @param nodeOffset The offset added to every joint node.
+ * @param out Receives x, y, z and 1 per vertex.
+ * @param parallel True to skin on the shared thread pool.
+ */
+JNIEXPORT void JNICALL Java_com_github_nodedev74_jfbx_anim_Skin_skin(JNIEnv *env, jobject obj, jobject graph, jint nodeOffset, jfloatArray out, jboolean parallel)
+{
+    Skin *skin = getSkin(env, obj);
+    jclass graphClass = env->GetObjectClass(graph);
+    jfieldID fieldID = env->GetFieldID(graphClass, "graphPtr", "J");
+    SceneGraph *sceneGraph = reinterpret_cast<SceneGraph *>(env->GetLongField(graph, fieldID));
+
+    jsize count = std::min<jsize>(env->GetArrayLength(out), static_cast<jsize>(skin->getVertexCount()) * 4);
+    float *values = static_cast<float *>(env->GetPrimitiveArrayCritical(out, nullptr));
+    if (count == static_cast<jsize>(skin->getVertexCount()) * 4)
+    {
+        skin->skin(*sceneGraph, static_cast<uint32_t>(nodeOffset), parallel ? &ThreadPool::shared() : nullptr, values);
+    }
+    env->ReleasePrimitiveArrayCritical(out, values, 0);
+}
+
+/**
+ * @brief JNI function to release the native skin.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ */
+JNIEXPORT void JNICALL Java_com_github_nodedev74_jfbx_anim_Skin_destroy(JNIEnv *env, jobject obj)
+{
+    delete getSkin(env, obj);
+
+    jclass cls = env->GetObjectClass(obj);
+    jfieldID fieldID = env->GetFieldID(cls, "skinPtr", "J");
+    env->SetLongField(obj, fieldID, 0);
+}
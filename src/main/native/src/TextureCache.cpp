@@ -0,0 +1,216 @@
+/**
+ * @file TextureCache.cpp
+ * @author Lenard Büsing (nodedev74@gmail.com)
+ * @brief Disk cache of imported textures in the KTX2 container layout.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2023 Lenard Büsing
+ *
+ */
+
+#include "texture/TextureCache.hpp"
+#include "core/Tracer.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <thread>
+#include <utility>
+
+namespace
+{
+    const uint8_t KTX2_IDENTIFIER[12] = {0xAB, 'K', 'T', 'X', ' ', '2', '0', 0xBB, '\r', '\n', 0x1A, '\n'};
+    constexpr size_t HEADER_SIZE = 80;
+    constexpr size_t LEVEL_ENTRY_SIZE = 24;
+
+    // VkFormat values, the cache itself does not depend on Vulkan
+    constexpr uint32_t FORMAT_R8G8B8A8_UNORM = 37;
+    constexpr uint32_t FORMAT_BC1_RGBA_UNORM_BLOCK = 133;
+    constexpr uint32_t FORMAT_BC3_UNORM_BLOCK = 137;
+
+    uint32_t toVkFormat(TextureFormat format)
+    {
+        switch (format)
+        {
+        case TextureFormat::Bc1:
+            return FORMAT_BC1_RGBA_UNORM_BLOCK;
+        case TextureFormat::Bc3:
+            return FORMAT_BC3_UNORM_BLOCK;
+        default:
+            return FORMAT_R8G8B8A8_UNORM;
+        }
+    }
+
+    size_t getLevelSize(TextureFormat format, uint32_t width, uint32_t height)
+    {
+        size_t blocks = static_cast<size_t>((width + 3) / 4) * ((height + 3) / 4);
+        switch (format)
+        {
+        case TextureFormat::Bc1:
+            return blocks * 8;
+        case TextureFormat::Bc3:
+            return blocks * 16;
+        default:
+            return static_cast<size_t>(width) * height * 4;
+        }
+    }
+
+    void write32(std::vector<uint8_t> &out, size_t offset, uint32_t value)
+    {
+        memcpy(&out[offset], &value, sizeof(value));
+    }
+
+    void write64(std::vector<uint8_t> &out, size_t offset, uint64_t value)
+    {
+        memcpy(&out[offset], &value, sizeof(value));
+    }
+
+    uint32_t read32(const std::vector<uint8_t> &in, size_t offset)
+    {
+        uint32_t value;
+        memcpy(&value, &in[offset], sizeof(value));
+        return value;
+    }
+
+    uint64_t read64(const std::vector<uint8_t> &in, size_t offset)
+    {
+        uint64_t value;
+        memcpy(&value, &in[offset], sizeof(value));
+        return value;
+    }
+}
+
+TextureCache::TextureCache(std::string directory) : directory(std::move(directory))
+{
+}
+
+bool TextureCache::isEnabled() const
+{
+    return !directory.empty();
+}
+
+bool TextureCache::load(uint64_t key, bool blockCompression, TextureData &texture) const
+{
+    TRACE_ZONE("TextureCache.load");
+
+    if (!isEnabled())
+    {
+        return false;
+    }
+    std::ifstream file(getPath(key, blockCompression), std::ios::binary);
+    if (!file)
+    {
+        return false;
+    }
+    std::vector<uint8_t> content((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    if (content.size() < HEADER_SIZE || memcmp(content.data(), KTX2_IDENTIFIER, sizeof(KTX2_IDENTIFIER)) != 0)
+    {
+        return false;
+    }
+
+    uint32_t vkFormat = read32(content, 12);
+    uint32_t levelCount = read32(content, 40);
+    TextureData result;
+    if (vkFormat == FORMAT_BC1_RGBA_UNORM_BLOCK && blockCompression)
+        result.format = TextureFormat::Bc1;
+    else if (vkFormat == FORMAT_BC3_UNORM_BLOCK && blockCompression)
+        result.format = TextureFormat::Bc3;
+    else if (vkFormat != FORMAT_R8G8B8A8_UNORM || blockCompression)
+        return false;
+    result.width = read32(content, 20);
+    result.height = read32(content, 24);
+    if (result.width == 0 || result.height == 0 || levelCount == 0 || levelCount > 32 || content.size() < HEADER_SIZE + levelCount * LEVEL_ENTRY_SIZE)
+    {
+        return false;
+    }
+
+    // Levels are repacked largest first, the order TextureCodec produces
+    size_t size = 0;
+    for (uint32_t i = 0; i < levelCount; i++)
+    {
+        uint32_t width = std::max(result.width >> i, 1u);
+        uint32_t height = std::max(result.height >> i, 1u);
+        size_t levelSize = getLevelSize(result.format, width, height);
+        if (read64(content, HEADER_SIZE + i * LEVEL_ENTRY_SIZE + 8) != levelSize)
+        {
+            return false;
+        }
+        result.levels.push_back({width, height, size, levelSize});
+        size += levelSize;
+    }
+    result.bytes.resize(size);
+    for (uint32_t i = 0; i < levelCount; i++)
+    {
+        uint64_t offset = read64(content, HEADER_SIZE + i * LEVEL_ENTRY_SIZE);
+        const TextureLevel &level = result.levels[i];
+        if (offset > content.size() || level.size > content.size() - offset)
+        {
+            return false;
+        }
+        memcpy(result.bytes.data() + level.offset, content.data() + offset, level.size);
+    }
+    texture = std::move(result);
+    return true;
+}
+
+void TextureCache::store(uint64_t key, bool blockCompression, const TextureData &texture) const
+{
+    TRACE_ZONE("TextureCache.store");
+
+    if (!isEnabled())
+    {
+        return;
+    }
+
+    uint32_t levelCount = static_cast<uint32_t>(texture.levels.size());
+    size_t dataOffset = (HEADER_SIZE + levelCount * LEVEL_ENTRY_SIZE + 15) & ~static_cast<size_t>(15);
+    std::vector<uint8_t> content(dataOffset + texture.bytes.size());
+    memcpy(content.data(), KTX2_IDENTIFIER, sizeof(KTX2_IDENTIFIER));
+    write32(content, 12, toVkFormat(texture.format));
+    write32(content, 16, 1);
+    write32(content, 20, texture.width);
+    write32(content, 24, texture.height);
+    write32(content, 36, 1);
+    write32(content, 40, levelCount);
+
+    // KTX2 stores the smallest level first
+    size_t offset = dataOffset;
+    for (uint32_t i = levelCount; i-- > 0;)
+    {
+        const TextureLevel &level = texture.levels[i];
+        memcpy(content.data() + offset, texture.bytes.data() + level.offset, level.size);
+        write64(content, HEADER_SIZE + i * LEVEL_ENTRY_SIZE, offset);
+        write64(content, HEADER_SIZE + i * LEVEL_ENTRY_SIZE + 8, level.size);
+        write64(content, HEADER_SIZE + i * LEVEL_ENTRY_SIZE + 16, level.size);
+        offset += level.size;
+    }
+
+    // Workers may store the same file at once, each writes its own file and renames it into place
+    std::string path = getPath(key, blockCompression);
+    std::string temporaryPath = path + "." + std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id())) + ".tmp";
+    {
+        std::ofstream file(temporaryPath, std::ios::binary | std::ios::trunc);
+        file.write(reinterpret_cast<const char *>(content.data()), static_cast<std::streamsize>(content.size()));
+        if (!file)
+        {
+            file.close();
+            std::remove(temporaryPath.c_str());
+            return;
+        }
+    }
+    if (std::rename(temporaryPath.c_str(), path.c_str()) != 0)
+    {
+        std::remove(temporaryPath.c_str());
+    }
+}
+
+std::string TextureCache::getPath(uint64_t key, bool blockCompression) const
+{
+    char name[40];
+    snprintf(name, sizeof(name), "%016llx%s.ktx2", static_cast<unsigned long long>(key), blockCompression ? "-bc" : "-rgba8");
+    return directory + "/" + name;
+}
@@ -0,0 +1,614 @@
+/**
+ * @file TextureCodec.cpp
+ * @author Lenard Büsing (nodedev74@gmail.com)
+ * @brief Image decoding, mip generation and block compression of textures.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2023 Lenard Büsing
+ *
+ */
+
+#include "texture/TextureCodec.hpp"
+#include "core/Tracer.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+
+#include <zlib.h>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define MIP_SSE2 1
+#endif
+
+namespace
+{
+    constexpr uint64_t MAX_PIXELS = 1ull << 28;
+
+    uint32_t readBigEndian(const uint8_t *data)
+    {
+        return (static_cast<uint32_t>(data[0]) << 24) | (static_cast<uint32_t>(data[1]) << 16) | (static_cast<uint32_t>(data[2]) << 8) | data[3];
+    }
+
+    void checkSize(uint32_t width, uint32_t height)
+    {
+        if (width == 0 || height == 0 || static_cast<uint64_t>(width) * height > MAX_PIXELS)
+        {
+            throw std::runtime_error("Texture size is out of range");
+        }
+    }
+
+    uint8_t paeth(uint8_t a, uint8_t b, uint8_t c)
+    {
+        int p = a + b - c;
+        int pa = std::abs(p - a);
+        int pb = std::abs(p - b);
+        int pc = std::abs(p - c);
+        if (pa <= pb && pa <= pc)
+            return a;
+        return pb <= pc ? b : c;
+    }
+
+    /**
+     * @brief Reverses the per row filters of a PNG scanline buffer in place.
+     */
+    void unfilter(uint8_t *rows, size_t rowBytes, uint32_t height, size_t pixelBytes)
+    {
+        const uint8_t *previous = nullptr;
+        for (uint32_t y = 0; y < height; y++)
+        {
+            uint8_t filter = rows[y * (rowBytes + 1)];
+            uint8_t *row = rows + y * (rowBytes + 1) + 1;
+            for (size_t i = 0; i < rowBytes; i++)
+            {
+                uint8_t left = i >= pixelBytes ? row[i - pixelBytes] : 0;
+                uint8_t up = previous != nullptr ? previous[i] : 0;
+                uint8_t upLeft = previous != nullptr && i >= pixelBytes ? previous[i - pixelBytes] : 0;
+                switch (filter)
+                {
+                case 0:
+                    break;
+                case 1:
+                    row[i] += left;
+                    break;
+                case 2:
+                    row[i] += up;
+                    break;
+                case 3:
+                    row[i] += static_cast<uint8_t>((left + up) / 2);
+                    break;
+                case 4:
+                    row[i] += paeth(left, up, upLeft);
+                    break;
+                default:
+                    throw std::runtime_error("Malformed PNG filter");
+                }
+            }
+            previous = row;
+        }
+    }
+
+    TextureImage decodePng(const uint8_t *data, size_t size)
+    {
+        uint32_t width = 0;
+        uint32_t height = 0;
+        uint8_t bitDepth = 0;
+        uint8_t colorType = 0;
+        std::vector<uint8_t> palette;
+        std::vector<uint8_t> paletteAlpha;
+        std::vector<uint8_t> compressed;
+        for (size_t offset = 8; offset + 12 <= size;)
+        {
+            uint32_t length = readBigEndian(data + offset);
+            const uint8_t *type = data + offset + 4;
+            const uint8_t *chunk = data + offset + 8;
+            if (length > size - offset - 12)
+            {
+                throw std::runtime_error("Malformed PNG chunk");
+            }
+
+            if (memcmp(type, "IHDR", 4) == 0 && length >= 13)
+            {
+                width = readBigEndian(chunk);
+                height = readBigEndian(chunk + 4);
+                bitDepth = chunk[8];
+                colorType = chunk[9];
+                if (chunk[12] != 0)
+                {
+                    throw std::runtime_error("Interlaced PNG textures are not supported");
+                }
+            }
+            else if (memcmp(type, "PLTE", 4) == 0)
+                palette.assign(chunk, chunk + length);
+            else if (memcmp(type, "tRNS", 4) == 0)
+                paletteAlpha.assign(chunk, chunk + length);
+            else if (memcmp(type, "IDAT", 4) == 0)
+                compressed.insert(compressed.end(), chunk, chunk + length);
+            else if (memcmp(type, "IEND", 4) == 0)
+                break;
+            offset += 12 + static_cast<size_t>(length);
+        }
+        checkSize(width, height);
+
+        uint32_t channels;
+        switch (colorType)
+        {
+        case 0:
+        case 3:
+            channels = 1;
+            break;
+        case 2:
+            channels = 3;
+            break;
+        case 4:
+            channels = 2;
+            break;
+        case 6:
+            channels = 4;
+            break;
+        default:
+            throw std::runtime_error("Malformed PNG color type");
+        }
+        bool validDepth = bitDepth == 8 || bitDepth == 16 || ((colorType == 0 || colorType == 3) && (bitDepth == 1 || bitDepth == 2 || bitDepth == 4));
+        if (!validDepth || (colorType == 3 && bitDepth == 16))
+        {
+            throw std::runtime_error("Malformed PNG bit depth");
+        }
+
+        size_t bitsPerPixel = static_cast<size_t>(channels) * bitDepth;
+        size_t rowBytes = (static_cast<size_t>(width) * bitsPerPixel + 7) / 8;
+        std::vector<uint8_t> rows((rowBytes + 1) * height);
+        uLongf rowsLength = static_cast<uLongf>(rows.size());
+        if (uncompress(rows.data(), &rowsLength, compressed.data(), static_cast<uLong>(compressed.size())) != Z_OK || rowsLength != rows.size())
+        {
+            throw std::runtime_error("Malformed PNG image data");
+        }
+        unfilter(rows.data(), rowBytes, height, std::max<size_t>(bitsPerPixel / 8, 1));
+
+        TextureImage image;
+        image.width = width;
+        image.height = height;
+        image.pixels.resize(static_cast<size_t>(width) * height * 4);
+        // 16 bit samples keep their most significant byte, packed samples are scaled to 8 bits
+        size_t sampleBytes = bitDepth == 16 ? 2 : 1;
+        uint32_t sampleMask = (1u << std::min<uint32_t>(bitDepth, 8)) - 1;
+        for (uint32_t y = 0; y < height; y++)
+        {
+            const uint8_t *row = rows.data() + y * (rowBytes + 1) + 1;
+            uint8_t *out = image.pixels.data() + static_cast<size_t>(y) * width * 4;
+            for (uint32_t x = 0; x < width; x++, out += 4)
+            {
+                if (bitDepth < 8)
+                {
+                    size_t bit = static_cast<size_t>(x) * bitDepth;
+                    uint32_t sample = (row[bit / 8] >> (8 - bitDepth - bit % 8)) & sampleMask;
+                    if (colorType == 3)
+                    {
+                        if (sample * 3 + 2 >= palette.size())
+                            throw std::runtime_error("Malformed PNG palette index");
+                        memcpy(out, &palette[sample * 3], 3);
+                        out[3] = sample < paletteAlpha.size() ? paletteAlpha[sample] : 255;
+                    }
+                    else
+                    {
+                        uint8_t gray = static_cast<uint8_t>(sample * 255 / sampleMask);
+                        out[0] = out[1] = out[2] = gray;
+                        out[3] = 255;
+                    }
+                    continue;
+                }
+
+                const uint8_t *pixel = row + static_cast<size_t>(x) * channels * sampleBytes;
+                switch (colorType)
+                {
+                case 0:
+                    out[0] = out[1] = out[2] = pixel[0];
+                    out[3] = 255;
+                    break;
+                case 2:
+                    out[0] = pixel[0];
+                    out[1] = pixel[sampleBytes];
+                    out[2] = pixel[2 * sampleBytes];
+                    out[3] = 255;
+                    break;
+                case 3:
+                    if (pixel[0] * 3u + 2 >= palette.size())
+                        throw std::runtime_error("Malformed PNG palette index");
+                    memcpy(out, &palette[pixel[0] * 3u], 3);
+                    out[3] = pixel[0] < paletteAlpha.size() ? paletteAlpha[pixel[0]] : 255;
+                    break;
+                case 4:
+                    out[0] = out[1] = out[2] = pixel[0];
+                    out[3] = pixel[sampleBytes];
+                    break;
+                default:
+                    out[0] = pixel[0];
+                    out[1] = pixel[sampleBytes];
+                    out[2] = pixel[2 * sampleBytes];
+                    out[3] = pixel[3 * sampleBytes];
+                    break;
+                }
+            }
+        }
+        return image;
+    }
+
+    TextureImage decodeTga(const uint8_t *data, size_t size)
+    {
+        if (size < 18)
+        {
+            throw std::runtime_error("Unsupported texture format");
+        }
+        uint8_t idLength = data[0];
+        uint8_t colorMapType = data[1];
+        uint8_t imageType = data[2];
+        uint32_t colorMapLength = data[5] | (data[6] << 8);
+        uint32_t colorMapEntryBits = data[7];
+        uint32_t width = data[12] | (data[13] << 8);
+        uint32_t height = data[14] | (data[15] << 8);
+        uint32_t pixelBits = data[16];
+        bool topDown = (data[17] & 0x20) != 0;
+        bool gray = imageType == 3 || imageType == 11;
+        bool supported = colorMapType == 0 && (imageType == 2 || imageType == 3 || imageType == 10 || imageType == 11) &&
+                         (gray ? pixelBits == 8 : pixelBits == 24 || pixelBits == 32);
+        if (!supported)
+        {
+            throw std::runtime_error("Unsupported texture format");
+        }
+        checkSize(width, height);
+
+        size_t pixelBytes = pixelBits / 8;
+        size_t offset = 18 + static_cast<size_t>(idLength) + colorMapLength * ((colorMapEntryBits + 7) / 8);
+        size_t pixelCount = static_cast<size_t>(width) * height;
+        std::vector<uint8_t> source(pixelCount * pixelBytes);
+        if (imageType == 2 || imageType == 3)
+        {
+            if (offset + source.size() > size)
+            {
+                throw std::runtime_error("Malformed TGA image data");
+            }
+            memcpy(source.data(), data + offset, source.size());
+        }
+        else
+        {
+            // Each packet header repeats one pixel or copies raw ones, 1 to 128 times
+            for (size_t written = 0; written < pixelCount;)
+            {
+                if (offset >= size)
+                {
+                    throw std::runtime_error("Malformed TGA image data");
+                }
+                uint8_t header = data[offset++];
+                size_t count = std::min<size_t>((header & 0x7F) + 1, pixelCount - written);
+                size_t bytes = (header & 0x80) ? pixelBytes : count * pixelBytes;
+                if (offset + bytes > size)
+                {
+                    throw std::runtime_error("Malformed TGA image data");
+                }
+                for (size_t i = 0; i < count; i++)
+                {
+                    const uint8_t *pixel = data + offset + ((header & 0x80) ? 0 : i * pixelBytes);
+                    memcpy(&source[(written + i) * pixelBytes], pixel, pixelBytes);
+                }
+                offset += bytes;
+                written += count;
+            }
+        }
+
+        TextureImage image;
+        image.width = width;
+        image.height = height;
+        image.pixels.resize(pixelCount * 4);
+        for (uint32_t y = 0; y < height; y++)
+        {
+            const uint8_t *row = source.data() + static_cast<size_t>(topDown ? y : height - 1 - y) * width * pixelBytes;
+            uint8_t *out = image.pixels.data() + static_cast<size_t>(y) * width * 4;
+            for (uint32_t x = 0; x < width; x++, row += pixelBytes, out += 4)
+            {
+                if (gray)
+                {
+                    out[0] = out[1] = out[2] = row[0];
+                    out[3] = 255;
+                    continue;
+                }
+                out[0] = row[2];
+                out[1] = row[1];
+                out[2] = row[0];
+                out[3] = pixelBytes == 4 ? row[3] : 255;
+            }
+        }
+        return image;
+    }
+
+    /**
+     * @brief Averages 2x2 source pixels into every destination pixel. An odd last row or column is dropped.
+     */
+    void reduceLevel(const uint8_t *source, uint32_t sourceWidth, uint32_t sourceHeight, uint8_t *destination, uint32_t width, uint32_t height)
+    {
+        for (uint32_t y = 0; y < height; y++)
+        {
+            const uint8_t *row0 = source + static_cast<size_t>(std::min(2 * y, sourceHeight - 1)) * sourceWidth * 4;
+            const uint8_t *row1 = source + static_cast<size_t>(std::min(2 * y + 1, sourceHeight - 1)) * sourceWidth * 4;
+            uint8_t *out = destination + static_cast<size_t>(y) * width * 4;
+            uint32_t x = 0;
+#if MIP_SSE2
+            // Two destination pixels per step, summed in 16 bit lanes
+            if (sourceWidth >= 2)
+            {
+                const __m128i zero = _mm_setzero_si128();
+                const __m128i rounding = _mm_set1_epi16(2);
+                for (; x + 2 <= width; x += 2)
+                {
+                    __m128i top = _mm_loadu_si128(reinterpret_cast<const __m128i *>(row0 + x * 8));
+                    __m128i bottom = _mm_loadu_si128(reinterpret_cast<const __m128i *>(row1 + x * 8));
+                    __m128i low = _mm_add_epi16(_mm_unpacklo_epi8(top, zero), _mm_unpacklo_epi8(bottom, zero));
+                    __m128i high = _mm_add_epi16(_mm_unpackhi_epi8(top, zero), _mm_unpackhi_epi8(bottom, zero));
+                    low = _mm_add_epi16(low, _mm_srli_si128(low, 8));
+                    high = _mm_add_epi16(high, _mm_srli_si128(high, 8));
+                    __m128i sum = _mm_srli_epi16(_mm_add_epi16(_mm_unpacklo_epi64(low, high), rounding), 2);
+                    _mm_storel_epi64(reinterpret_cast<__m128i *>(out + x * 4), _mm_packus_epi16(sum, zero));
+                }
+            }
+#endif
+            for (; x < width; x++)
+            {
+                uint32_t x0 = std::min(2 * x, sourceWidth - 1) * 4;
+                uint32_t x1 = std::min(2 * x + 1, sourceWidth - 1) * 4;
+                for (uint32_t c = 0; c < 4; c++)
+                {
+                    out[x * 4 + c] = static_cast<uint8_t>((row0[x0 + c] + row0[x1 + c] + row1[x0 + c] + row1[x1 + c] + 2) >> 2);
+                }
+            }
+        }
+    }
+
+    uint16_t toRgb565(const int *color)
+    {
+        return static_cast<uint16_t>(((color[0] * 31 + 127) / 255) << 11 | ((color[1] * 63 + 127) / 255) << 5 | ((color[2] * 31 + 127) / 255));
+    }
+
+    void fromRgb565(uint16_t value, int *color)
+    {
+        int r = (value >> 11) & 31;
+        int g = (value >> 5) & 63;
+        int b = value & 31;
+        color[0] = (r << 3) | (r >> 2);
+        color[1] = (g << 2) | (g >> 4);
+        color[2] = (b << 3) | (b >> 2);
+    }
+
+    /**
+     * @brief Encodes the colors of a 4x4 block with endpoints on the diagonal of its bounding box.
+     */
+    void encodeColorBlock(const uint8_t (*pixels)[4], uint8_t *out)
+    {
+        int minimum[3] = {255, 255, 255};
+        int maximum[3] = {0, 0, 0};
+        for (int i = 0; i < 16; i++)
+        {
+            for (int c = 0; c < 3; c++)
+            {
+                minimum[c] = std::min<int>(minimum[c], pixels[i][c]);
+                maximum[c] = std::max<int>(maximum[c], pixels[i][c]);
+            }
+        }
+        // Insetting the box by 1/16 moves the endpoints towards the bulk of the pixels
+        for (int c = 0; c < 3; c++)
+        {
+            int inset = (maximum[c] - minimum[c]) >> 4;
+            minimum[c] += inset;
+            maximum[c] -= inset;
+        }
+
+        uint16_t color0 = toRgb565(maximum);
+        uint16_t color1 = toRgb565(minimum);
+        if (color0 < color1)
+        {
+            std::swap(color0, color1);
+        }
+        int palette[4][3];
+        fromRgb565(color0, palette[0]);
+        fromRgb565(color1, palette[1]);
+        for (int c = 0; c < 3; c++)
+        {
+            palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+            palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+        }
+
+        uint32_t indices = 0;
+        if (color0 != color1)
+        {
+            for (int i = 0; i < 16; i++)
+            {
+                int best = 0;
+                int bestDistance = 1 << 30;
+                for (int p = 0; p < 4; p++)
+                {
+                    int dr = pixels[i][0] - palette[p][0];
+                    int dg = pixels[i][1] - palette[p][1];
+                    int db = pixels[i][2] - palette[p][2];
+                    int distance = dr * dr + dg * dg + db * db;
+                    if (distance < bestDistance)
+                    {
+                        best = p;
+                        bestDistance = distance;
+                    }
+                }
+                indices |= static_cast<uint32_t>(best) << (2 * i);
+            }
+        }
+        out[0] = static_cast<uint8_t>(color0);
+        out[1] = static_cast<uint8_t>(color0 >> 8);
+        out[2] = static_cast<uint8_t>(color1);
+        out[3] = static_cast<uint8_t>(color1 >> 8);
+        for (int i = 0; i < 4; i++)
+        {
+            out[4 + i] = static_cast<uint8_t>(indices >> (8 * i));
+        }
+    }
+
+    /**
+     * @brief Encodes the alpha of a 4x4 block with eight interpolated values between its extremes.
+     */
+    void encodeAlphaBlock(const uint8_t (*pixels)[4], uint8_t *out)
+    {
+        int alpha0 = 0;
+        int alpha1 = 255;
+        for (int i = 0; i < 16; i++)
+        {
+            alpha0 = std::max<int>(alpha0, pixels[i][3]);
+            alpha1 = std::min<int>(alpha1, pixels[i][3]);
+        }
+
+        int palette[8] = {alpha0, alpha1};
+        for (int p = 1; p < 7; p++)
+        {
+            palette[p + 1] = ((7 - p) * alpha0 + p * alpha1) / 7;
+        }
+        uint64_t indices = 0;
+        if (alpha0 != alpha1)
+        {
+            for (int i = 0; i < 16; i++)
+            {
+                int best = 0;
+                for (int p = 1; p < 8; p++)
+                {
+                    if (std::abs(pixels[i][3] - palette[p]) < std::abs(pixels[i][3] - palette[best]))
+                        best = p;
+                }
+                indices |= static_cast<uint64_t>(best) << (3 * i);
+            }
+        }
+        out[0] = static_cast<uint8_t>(alpha0);
+        out[1] = static_cast<uint8_t>(alpha1);
+        for (int i = 0; i < 6; i++)
+        {
+            out[2 + i] = static_cast<uint8_t>(indices >> (8 * i));
+        }
+    }
+}
+
+TextureImage TextureCodec::decode(const uint8_t *data, size_t size)
+{
+    TRACE_ZONE("TextureCodec.decode");
+
+    static const uint8_t pngSignature[] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+    if (size >= 8 && memcmp(data, pngSignature, 8) == 0)
+    {
+        return decodePng(data, size);
+    }
+    if (size >= 3 && data[0] == 0xFF && data[1] == 0xD8 && data[2] == 0xFF)
+    {
+        throw std::runtime_error("JPEG textures are not supported");
+    }
+    // TGA files have no signature, their header is validated instead
+    return decodeTga(data, size);
+}
+
+TextureData TextureCodec::generateMips(const TextureImage &image)
+{
+    TRACE_ZONE("TextureCodec.generateMips");
+
+    TextureData texture;
+    texture.format = TextureFormat::Rgba8;
+    texture.width = image.width;
+    texture.height = image.height;
+    size_t size = 0;
+    for (uint32_t width = image.width, height = image.height;; width = std::max(width / 2, 1u), height = std::max(height / 2, 1u))
+    {
+        size_t levelSize = static_cast<size_t>(width) * height * 4;
+        texture.levels.push_back({width, height, size, levelSize});
+        size += levelSize;
+        if (width == 1 && height == 1)
+        {
+            break;
+        }
+    }
+
+    texture.bytes.resize(size);
+    memcpy(texture.bytes.data(), image.pixels.data(), texture.levels[0].size);
+    for (size_t i = 1; i < texture.levels.size(); i++)
+    {
+        const TextureLevel &source = texture.levels[i - 1];
+        const TextureLevel &level = texture.levels[i];
+        reduceLevel(texture.bytes.data() + source.offset, source.width, source.height, texture.bytes.data() + level.offset, level.width, level.height);
+    }
+    return texture;
+}
+
+TextureData TextureCodec::compress(const TextureData &texture)
+{
+    TRACE_ZONE("TextureCodec.compress");
+
+    bool alpha = false;
+    for (size_t i = 3; i < texture.levels[0].size && !alpha; i += 4)
+    {
+        alpha = texture.bytes[i] != 255;
+    }
+    size_t blockSize = alpha ? 16 : 8;
+
+    TextureData compressed;
+    compressed.format = alpha ? TextureFormat::Bc3 : TextureFormat::Bc1;
+    compressed.width = texture.width;
+    compressed.height = texture.height;
+    size_t size = 0;
+    for (const TextureLevel &level : texture.levels)
+    {
+        size_t levelSize = static_cast<size_t>((level.width + 3) / 4) * ((level.height + 3) / 4) * blockSize;
+        compressed.levels.push_back({level.width, level.height, size, levelSize});
+        size += levelSize;
+    }
+    compressed.bytes.resize(size);
+
+    for (size_t i = 0; i < texture.levels.size(); i++)
+    {
+        const TextureLevel &level = texture.levels[i];
+        const uint8_t *pixels = texture.bytes.data() + level.offset;
+        uint8_t *out = compressed.bytes.data() + compressed.levels[i].offset;
+        for (uint32_t blockY = 0; blockY < level.height; blockY += 4)
+        {
+            for (uint32_t blockX = 0; blockX < level.width; blockX += 4, out += blockSize)
+            {
+                // Blocks past the edge of small levels repeat the last row and column
+                uint8_t block[16][4];
+                for (uint32_t y = 0; y < 4; y++)
+                {
+                    for (uint32_t x = 0; x < 4; x++)
+                    {
+                        size_t source = (static_cast<size_t>(std::min(blockY + y, level.height - 1)) * level.width + std::min(blockX + x, level.width - 1)) * 4;
+                        memcpy(block[y * 4 + x], pixels + source, 4);
+                    }
+                }
+                if (alpha)
+                {
+                    encodeAlphaBlock(block, out);
+                    encodeColorBlock(block, out + 8);
+                }
+                else
+                {
+                    encodeColorBlock(block, out);
+                }
+            }
+        }
+    }
+    return compressed;
+}
+
+TextureData TextureCodec::import(const uint8_t *data, size_t size, bool blockCompression)
+{
+    TextureData texture = generateMips(decode(data, size));
+    return blockCompression ? compress(texture) : texture;
+}
+
+uint64_t TextureCodec::hash(const uint8_t *data, size_t size)
+{
+    uint64_t value = 14695981039346656037ull;
+    for (size_t i = 0; i < size; i++)
+    {
+        value = (value ^ data[i]) * 1099511628211ull;
+    }
+    return value;
+}
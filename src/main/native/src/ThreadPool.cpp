@@ -0,0 +1,151 @@
+/**
+ * @file ThreadPool.cpp
+ * @author Lenard Büsing (nodedev74@gmail.com)
+ * @brief Implementation of the worker pool.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2023 Lenard Büsing
+ *
+ */
+
+#include "core/ThreadPool.hpp"
+
+#include <algorithm>
+
+namespace
+{
+    thread_local bool insideWorker = false;
+}
+
+ThreadPool::ThreadPool(uint32_t threadCount)
+{
+    if (threadCount == 0)
+    {
+        uint32_t hardware = std::thread::hardware_concurrency();
+        threadCount = hardware > 1 ? hardware - 1 : 0;
+    }
+
+    workers.reserve(threadCount);
+    for (uint32_t i = 0; i < threadCount; i++)
+    {
+        workers.emplace_back(&ThreadPool::workerLoop, this);
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (std::thread &worker : workers)
+    {
+        worker.join();
+    }
+}
+
+uint32_t ThreadPool::getThreadCount() const
+{
+    return static_cast<uint32_t>(workers.size()) + 1;
+}
+
+void ThreadPool::parallelFor(uint32_t count, uint32_t grain, const RangeFunction &function)
+{
+    grain = std::max(grain, 1u);
+    if (count <= grain || workers.empty() || insideWorker)
+    {
+        if (count > 0)
+        {
+            function(0, count);
+        }
+        return;
+    }
+
+    std::lock_guard<std::mutex> dispatchLock(dispatchMutex);
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        job = &function;
+        jobCount = count;
+        jobGrain = grain;
+        nextIndex.store(0, std::memory_order_relaxed);
+        busyWorkers = static_cast<uint32_t>(workers.size());
+        generation++;
+    }
+    wake.notify_all();
+
+    insideWorker = true;
+    runChunks();
+    insideWorker = false;
+
+    std::unique_lock<std::mutex> lock(mutex);
+    done.wait(lock, [this]
+              { return busyWorkers == 0; });
+    job = nullptr;
+    std::exception_ptr error = jobError;
+    jobError = nullptr;
+    if (error != nullptr)
+    {
+        std::rethrow_exception(error);
+    }
+}
+
+ThreadPool &ThreadPool::shared()
+{
+    static ThreadPool pool;
+    return pool;
+}
+
+void ThreadPool::workerLoop()
+{
+    insideWorker = true;
+    uint64_t seenGeneration = 0;
+    while (true)
+    {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wake.wait(lock, [this, seenGeneration]
+                      { return stopping || generation != seenGeneration; });
+            if (stopping)
+            {
+                return;
+            }
+            seenGeneration = generation;
+        }
+
+        runChunks();
+
+        std::lock_guard<std::mutex> lock(mutex);
+        if (--busyWorkers == 0)
+        {
+            done.notify_one();
+        }
+    }
+}
+
+void ThreadPool::runChunks()
+{
+    while (true)
+    {
+        uint32_t begin = nextIndex.fetch_add(jobGrain, std::memory_order_relaxed);
+        if (begin >= jobCount)
+        {
+            return;
+        }
+        try
+        {
+            (*job)(begin, std::min(begin + jobGrain, jobCount));
+        }
+        catch (...)
+        {
+            // The first exception ends the loop, it is rethrown by parallelFor
+            std::lock_guard<std::mutex> lock(mutex);
+            if (jobError == nullptr)
+            {
+                jobError = std::current_exception();
+            }
+            nextIndex.store(jobCount, std::memory_order_relaxed);
+        }
+    }
+}
@@ -0,0 +1,628 @@
+/**
+ * @file Tracer.cpp
+ * @author Lenard Büsing (nodedev74@gmail.com)
+ * @brief Low overhead CPU tracer with Chrome trace export.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2023 Lenard Büsing
+ *
+ */
+
+#include "com_github_nodedev74_jfbx_trace_Tracer.h"
+#include <jni.h>
+
+#include "core/Tracer.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    constexpr uint32_t CHUNK_SIZE = 16384;
+    constexpr uint32_t MAX_CHUNKS = 256;
+    constexpr size_t MAX_FREE_CHUNKS = 32;
+
+    struct TraceEvent
+    {
+        const char *name;
+        uint64_t start;
+        uint64_t end;
+    };
+
+    /**
+     * @brief A block of events. Only the owning thread writes events and publishes them through count,
+     * first is only changed under the registry mutex.
+     */
+    struct TraceChunk
+    {
+        TraceEvent events[CHUNK_SIZE];
+        std::atomic<uint32_t> count{0};
+        uint32_t first = 0;
+    };
+
+    /**
+     * @brief The chunks of a thread. The chunk list is only changed under the registry mutex, the last
+     * chunk is the one the owning thread currently writes to.
+     */
+    struct ThreadBuffer
+    {
+        uint32_t threadId = 0;
+        std::string threadName;
+        std::vector<std::unique_ptr<TraceChunk>> chunks;
+        std::atomic<bool> full{false};
+        std::atomic<uint64_t> dropped{0};
+        bool exited = false;
+    };
+
+    /**
+     * @brief The write position of the calling thread, so recording a zone touches neither the
+     * registry nor any shared counter. It is trivially destructible, so accessing it needs no
+     * thread local initialization check.
+     */
+    struct TraceCursor
+    {
+        ThreadBuffer *buffer = nullptr;
+        TraceChunk *chunk = nullptr;
+        uint32_t next = CHUNK_SIZE;
+        bool exited = false;
+    };
+
+    std::mutex registryMutex;
+    std::vector<std::unique_ptr<ThreadBuffer>> registry;
+    std::vector<std::unique_ptr<TraceChunk>> freeChunks;
+    uint32_t nextThreadId = 1;
+
+    std::mutex namesMutex;
+    std::deque<std::string> names;
+
+    const std::chrono::steady_clock::time_point epochTime = std::chrono::steady_clock::now();
+    const uint64_t epochTicks = Tracer::now();
+
+    thread_local TraceCursor cursor;
+    thread_local std::vector<std::pair<const char *, uint64_t>> zoneStack;
+
+    /**
+     * @brief Keeps a chunk for reuse, so threads that trace again after a clear write to memory that
+     * is already mapped. The registry mutex must be held.
+     *
+     * @param chunk The chunk, no thread may write to it anymore.
+     */
+    void releaseChunk(std::unique_ptr<TraceChunk> chunk)
+    {
+        if (freeChunks.size() < MAX_FREE_CHUNKS)
+        {
+            chunk->count.store(0, std::memory_order_relaxed);
+            chunk->first = 0;
+            freeChunks.push_back(std::move(chunk));
+        }
+    }
+
+    /**
+     * @brief Checks if a buffer holds zones that have not been cleared. The registry mutex must be held.
+     *
+     * @param buffer The buffer.
+     * @return True if a dump would write zones of the buffer.
+     */
+    bool hasZones(const ThreadBuffer &buffer)
+    {
+        for (const auto &chunk : buffer.chunks)
+        {
+            if (chunk->count.load(std::memory_order_acquire) > chunk->first)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * @brief Removes a buffer from the registry and keeps its chunks for reuse. The registry mutex must
+     * be held and no thread may write to the buffer anymore.
+     *
+     * @param buffer The buffer.
+     */
+    void removeBuffer(ThreadBuffer *buffer)
+    {
+        for (auto it = registry.begin(); it != registry.end(); ++it)
+        {
+            if (it->get() == buffer)
+            {
+                for (auto &chunk : buffer->chunks)
+                {
+                    releaseChunk(std::move(chunk));
+                }
+                registry.erase(it);
+                return;
+            }
+        }
+    }
+
+    /**
+     * @brief Unregisters the buffer of a thread when the thread exits. A buffer whose zones have not
+     * been dumped yet stays until the next clear, an empty one is removed right away.
+     */
+    struct ThreadExit
+    {
+        ThreadBuffer *buffer = nullptr;
+
+        ~ThreadExit()
+        {
+            // Zones recorded by thread local destructors that run later are dropped
+            cursor = TraceCursor();
+            cursor.exited = true;
+
+            std::lock_guard<std::mutex> lock(registryMutex);
+            if (hasZones(*buffer))
+            {
+                buffer->exited = true;
+            }
+            else
+            {
+                removeBuffer(buffer);
+            }
+        }
+    };
+
+    /**
+     * @brief Registers a buffer for the calling thread. The registry mutex must be held.
+     *
+     * @return The thread buffer.
+     */
+    ThreadBuffer *registerBuffer()
+    {
+        registry.push_back(std::make_unique<ThreadBuffer>());
+        ThreadBuffer *buffer = registry.back().get();
+        buffer->threadId = nextThreadId++;
+        cursor.buffer = buffer;
+        // Constructed on registration only, so threads that never trace do not pay for its destructor
+        static thread_local ThreadExit threadExit;
+        threadExit.buffer = buffer;
+        return buffer;
+    }
+
+    /**
+     * @brief Retrieves the buffer of the calling thread, registering it on first use.
+     *
+     * @return The thread buffer.
+     */
+    ThreadBuffer *currentBuffer()
+    {
+        if (cursor.buffer == nullptr)
+        {
+            std::lock_guard<std::mutex> lock(registryMutex);
+            registerBuffer();
+        }
+        return cursor.buffer;
+    }
+
+    /**
+     * @brief Records a zone into a new chunk once the chunk of the calling thread is full. Kept out of
+     * line so the recording path stays a single thread local lookup and a few stores.
+     *
+     * @param name The zone name.
+     * @param start The start timestamp in ticks.
+     * @param end The end timestamp in ticks.
+     */
+#if defined(_MSC_VER)
+    __declspec(noinline)
+#else
+    __attribute__((noinline))
+#endif
+    void recordInNextChunk(const char *name, uint64_t start, uint64_t end)
+    {
+        if (cursor.exited)
+        {
+            return;
+        }
+        if (cursor.buffer != nullptr && cursor.buffer->full.load(std::memory_order_relaxed))
+        {
+            cursor.buffer->dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        std::lock_guard<std::mutex> lock(registryMutex);
+        ThreadBuffer *buffer = cursor.buffer != nullptr ? cursor.buffer : registerBuffer();
+        if (buffer->chunks.size() >= MAX_CHUNKS)
+        {
+            buffer->full.store(true, std::memory_order_relaxed);
+            buffer->dropped.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        if (freeChunks.empty())
+        {
+            buffer->chunks.push_back(std::make_unique<TraceChunk>());
+        }
+        else
+        {
+            buffer->chunks.push_back(std::move(freeChunks.back()));
+            freeChunks.pop_back();
+        }
+        cursor.chunk = buffer->chunks.back().get();
+        cursor.chunk->events[0] = {name, start, end};
+        cursor.next = 1;
+        cursor.chunk->count.store(1, std::memory_order_release);
+    }
+
+    /**
+     * @brief Discards the zones of a buffer. The registry mutex must be held. The chunk the owning
+     * thread writes to is kept and only its recorded zones are skipped, all other chunks are released.
+     *
+     * @param buffer The buffer to reset.
+     */
+    void resetBuffer(ThreadBuffer &buffer)
+    {
+        if (!buffer.chunks.empty())
+        {
+            std::unique_ptr<TraceChunk> current = std::move(buffer.chunks.back());
+            buffer.chunks.pop_back();
+            current->first = current->count.load(std::memory_order_acquire);
+            for (auto &chunk : buffer.chunks)
+            {
+                releaseChunk(std::move(chunk));
+            }
+            buffer.chunks.clear();
+            buffer.chunks.push_back(std::move(current));
+        }
+        buffer.full.store(false, std::memory_order_relaxed);
+        buffer.dropped.store(0, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Writes a string as escaped JSON string literal.
+     *
+     * @param file The output file.
+     * @param value The string to write.
+     */
+    void writeJsonString(FILE *file, const char *value)
+    {
+        fputc('"', file);
+        for (const char *c = value; *c != '\0'; c++)
+        {
+            switch (*c)
+            {
+            case '"':
+                fputs("\\\"", file);
+                break;
+            case '\\':
+                fputs("\\\\", file);
+                break;
+            default:
+                if (static_cast<unsigned char>(*c) < 0x20)
+                {
+                    fprintf(file, "\\u%04x", *c);
+                }
+                else
+                {
+                    fputc(*c, file);
+                }
+            }
+        }
+        fputc('"', file);
+    }
+}
+
+std::atomic<bool> Tracer::enabled{false};
+
+void Tracer::setEnabled(bool enabled)
+{
+    Tracer::enabled.store(enabled, std::memory_order_relaxed);
+}
+
+double Tracer::toNanoseconds(uint64_t ticks)
+{
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+    // The tick rate is calibrated once against the steady clock over at least 10 ms.
+    static const double nanosecondsPerTick = []()
+    {
+        auto elapsed = std::chrono::steady_clock::now() - epochTime;
+        if (elapsed < std::chrono::milliseconds(10))
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10) - elapsed);
+        }
+        uint64_t ticks = Tracer::now() - epochTicks;
+        double nanoseconds = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - epochTime).count();
+        return ticks > 0 ? nanoseconds / ticks : 1.0;
+    }();
+    return ticks * nanosecondsPerTick;
+#else
+    return static_cast<double>(ticks);
+#endif
+}
+
+void Tracer::record(const char *name, uint64_t start, uint64_t end)
+{
+    TraceCursor &current = cursor;
+    uint32_t next = current.next;
+    if (next == CHUNK_SIZE)
+    {
+        recordInNextChunk(name, start, end);
+        return;
+    }
+
+    TraceChunk *chunk = current.chunk;
+    chunk->events[next] = {name, start, end};
+    current.next = ++next;
+    chunk->count.store(next, std::memory_order_release);
+}
+
+const char *Tracer::intern(const std::string &name)
+{
+    std::lock_guard<std::mutex> lock(namesMutex);
+    for (const std::string &stored : names)
+    {
+        if (stored == name)
+        {
+            return stored.c_str();
+        }
+    }
+    names.push_back(name);
+    return names.back().c_str();
+}
+
+void Tracer::begin(const char *name)
+{
+    // Zones opened while disabled are kept with a zero start, so begin and end stay paired
+    // without taking a timestamp or registering a buffer
+    zoneStack.emplace_back(name, isEnabled() ? now() : 0);
+}
+
+void Tracer::end()
+{
+    if (zoneStack.empty())
+    {
+        return;
+    }
+
+    auto zone = zoneStack.back();
+    zoneStack.pop_back();
+    if (isEnabled() && zone.second != 0)
+    {
+        record(zone.first, zone.second, now());
+    }
+}
+
+void Tracer::setThreadName(const std::string &name)
+{
+    if (cursor.exited)
+    {
+        return;
+    }
+    ThreadBuffer *buffer = currentBuffer();
+    std::lock_guard<std::mutex> lock(registryMutex);
+    buffer->threadName = name;
+}
+
+bool Tracer::dump(const std::string &path)
+{
+    FILE *file = fopen(path.c_str(), "w");
+    if (file == nullptr)
+    {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(registryMutex);
+
+    fputs("{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n", file);
+    bool separator = false;
+    for (const auto &buffer : registry)
+    {
+        if (!buffer->threadName.empty())
+        {
+            fprintf(file, "%s{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":", separator ? ",\n" : "", buffer->threadId);
+            writeJsonString(file, buffer->threadName.c_str());
+            fputs("}}", file);
+            separator = true;
+        }
+
+        for (const auto &chunk : buffer->chunks)
+        {
+            uint32_t count = chunk->count.load(std::memory_order_acquire);
+            for (uint32_t i = chunk->first; i < count; i++)
+            {
+                const TraceEvent &event = chunk->events[i];
+                fprintf(file, "%s{\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f,\"name\":", separator ? ",\n" : "", buffer->threadId,
+                        toNanoseconds(event.start - epochTicks) / 1000.0, toNanoseconds(event.end - event.start) / 1000.0);
+                writeJsonString(file, event.name);
+                fputc('}', file);
+                separator = true;
+            }
+        }
+
+        uint64_t dropped = buffer->dropped.load(std::memory_order_relaxed);
+        if (dropped > 0)
+        {
+            fprintf(file, "%s{\"ph\":\"i\",\"s\":\"t\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"name\":\"dropped %llu zones\"}", separator ? ",\n" : "", buffer->threadId,
+                    toNanoseconds(now() - epochTicks) / 1000.0, static_cast<unsigned long long>(dropped));
+            separator = true;
+        }
+    }
+    fputs("\n]}\n", file);
+
+    return fclose(file) == 0;
+}
+
+void Tracer::clear()
+{
+    std::lock_guard<std::mutex> lock(registryMutex);
+    for (size_t i = registry.size(); i-- > 0;)
+    {
+        if (registry[i]->exited)
+        {
+            removeBuffer(registry[i].get());
+        }
+        else
+        {
+            resetBuffer(*registry[i]);
+        }
+    }
+}
+
+double Tracer::measureOverhead(uint32_t iterations)
+{
+    bool wasEnabled = isEnabled();
+    setEnabled(true);
+
+    double overhead = 0.0;
+    // The zones are recorded on a scratch thread, its buffer is removed when the thread exits.
+    std::thread worker([&overhead, iterations]()
+                       {
+        for (uint32_t i = 0; i < 1024; i++)
+        {
+            TRACE_ZONE("warmup");
+        }
+
+        uint64_t start = now();
+        for (uint32_t i = 0; i < iterations; i++)
+        {
+            TRACE_ZONE("overhead");
+        }
+        uint64_t end = now();
+
+        overhead = iterations > 0 ? toNanoseconds(end - start) / iterations : 0.0;
+
+        std::lock_guard<std::mutex> lock(registryMutex);
+        resetBuffer(*cursor.buffer); });
+    worker.join();
+
+    setEnabled(wasEnabled);
+    return overhead;
+}
+
+double Tracer::measureClockOverhead(uint32_t iterations)
+{
+    // The counter reads cannot be elided, so the pairs need no consumer.
+    uint64_t start = now();
+    for (uint32_t i = 0; i < iterations; i++)
+    {
+        now();
+        now();
+    }
+    uint64_t end = now();
+
+    return iterations > 0 ? toNanoseconds(end - start) / iterations : 0.0;
+}
+
+/**
+ * @brief JNI function to enable or disable tracing of native zones.
+ *
+ * @param env The JNI environment.
+ * @param cls The Java class.
+ * @param enabled True to record zones.
+ */
+JNIEXPORT void JNICALL Java_com_github_nodedev74_jfbx_trace_Tracer_setNativeEnabled(JNIEnv *env, jclass cls, jboolean enabled)
+{
+    Tracer::setEnabled(enabled == JNI_TRUE);
+}
+
+/**
+ * @brief JNI function to register a zone name.
+ *
+ * @param env The JNI environment.
+ * @param cls The Java class.
+ * @param name The zone name.
+ * @return The handle of the zone name.
+ */
+JNIEXPORT jlong JNICALL Java_com_github_nodedev74_jfbx_trace_Tracer_register(JNIEnv *env, jclass cls, jstring name)
+{
+    const char *nativeString = env->GetStringUTFChars(name, nullptr);
+    const char *interned = Tracer::intern(nativeString);
+    env->ReleaseStringUTFChars(name, nativeString);
+    return reinterpret_cast<jlong>(interned);
+}
+
+/**
+ * @brief JNI function to open a zone.
+ *
+ * @param env The JNI environment.
+ * @param cls The Java class.
+ * @param nameHandle The handle returned by register.
+ */
+JNIEXPORT void JNICALL Java_com_github_nodedev74_jfbx_trace_Tracer_begin(JNIEnv *env, jclass cls, jlong nameHandle)
+{
+    Tracer::begin(reinterpret_cast<const char *>(nameHandle));
+}
+
+/**
+ * @brief JNI function to close the innermost zone.
+ *
+ * @param env The JNI environment.
+ * @param cls The Java class.
+ */
+JNIEXPORT void JNICALL Java_com_github_nodedev74_jfbx_trace_Tracer_end(JNIEnv *env, jclass cls)
+{
+    Tracer::end();
+}
+
+/**
+ * @brief JNI function to name the calling thread.
+ *
+ * @param env The JNI environment.
+ * @param cls The Java class.
+ * @param name The thread name.
+ */
+JNIEXPORT void JNICALL Java_com_github_nodedev74_jfbx_trace_Tracer_setThreadName(JNIEnv *env, jclass cls, jstring name)
+{
+    const char *nativeString = env->GetStringUTFChars(name, nullptr);
+    Tracer::setThreadName(nativeString);
+    env->ReleaseStringUTFChars(name, nativeString);
+}
+
+/**
+ * @brief JNI function to write the recorded zones as Chrome trace JSON.
+ *
+ * @param env The JNI environment.
+ * @param cls The Java class.
+ * @param path The output file.
+ * @return True if the file has been written.
+ */
+JNIEXPORT jboolean JNICALL Java_com_github_nodedev74_jfbx_trace_Tracer_dump(JNIEnv *env, jclass cls, jstring path)
+{
+    const char *nativeString = env->GetStringUTFChars(path, nullptr);
+    bool written = Tracer::dump(nativeString);
+    env->ReleaseStringUTFChars(path, nativeString);
+    return written ? JNI_TRUE : JNI_FALSE;
+}
+
+/**
+ * @brief JNI function to discard all recorded zones.
+ *
+ * @param env The JNI environment.
+ * @param cls The Java class.
+ */
+JNIEXPORT void JNICALL Java_com_github_nodedev74_jfbx_trace_Tracer_clear(JNIEnv *env, jclass cls)
+{
+    Tracer::clear();
+}
+
+/**
+ * @brief JNI function to measure the cost of an enabled native zone.
+ *
+ * @param env The JNI environment.
+ * @param cls The Java class.
+ * @param iterations The number of zones to record.
+ * @return The average cost per zone in nanoseconds.
+ */
+JNIEXPORT jdouble JNICALL Java_com_github_nodedev74_jfbx_trace_Tracer_measureZoneOverhead(JNIEnv *env, jclass cls, jint iterations)
+{
+    return Tracer::measureOverhead(static_cast<uint32_t>(iterations));
+}
+
+/**
+ * @brief JNI function to measure the cost of the two timestamps of a zone.
+ *
+ * @param env The JNI environment.
+ * @param cls The Java class.
+ * @param iterations The number of timestamp pairs to take.
+ * @return The average cost per pair in nanoseconds.
+ */
+JNIEXPORT jdouble JNICALL Java_com_github_nodedev74_jfbx_trace_Tracer_measureClockOverhead(JNIEnv *env, jclass cls, jint iterations)
+{
+    return Tracer::measureClockOverhead(static_cast<uint32_t>(iterations));
+}
@@ -0,0 +1,691 @@
+/**
+ * @file VkBindless.cpp
+ * @author Lenard Büsing (nodedev74@gmail.com)
+ * @brief Material table and bindless descriptor arrays for textures and storage buffers.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2023 Lenard Büsing
+ *
+ */
+
+#include "vulkan/VkBindless.hpp"
+#include "core/Tracer.hpp"
+
+#include "volk.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace
+{
+    VkFormat toVkFormat(TextureFormat format)
+    {
+        switch (format)
+        {
+        case TextureFormat::Bc1:
+            return VK_FORMAT_BC1_RGBA_UNORM_BLOCK;
+        case TextureFormat::Bc3:
+            return VK_FORMAT_BC3_UNORM_BLOCK;
+        default:
+            return VK_FORMAT_R8G8B8A8_UNORM;
+        }
+    }
+}
+
+VkResult VkBindless::create(VkDevice device, VkMemoryTracker &memoryTracker, VkQueue queue, VkCommandPool commandPool, bool descriptorIndexing,
+                            uint32_t textureCapacity, uint32_t bufferCapacity, uint32_t materialCapacity)
+{
+    this->device = device;
+    this->memoryTracker = &memoryTracker;
+    this->descriptorIndexing = descriptorIndexing;
+    this->textureCapacity = std::max<uint32_t>(textureCapacity, 1);
+    this->bufferCapacity = std::max<uint32_t>(bufferCapacity, 1);
+    this->materialCapacity = std::max<uint32_t>(materialCapacity, 1);
+    materialSetsEnabled = !descriptorIndexing;
+
+    VkSamplerCreateInfo samplerCreateInfo{VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO};
+    samplerCreateInfo.magFilter = VK_FILTER_LINEAR;
+    samplerCreateInfo.minFilter = VK_FILTER_LINEAR;
+    samplerCreateInfo.mipmapMode = VK_SAMPLER_MIPMAP_MODE_LINEAR;
+    samplerCreateInfo.addressModeU = VK_SAMPLER_ADDRESS_MODE_REPEAT;
+    samplerCreateInfo.addressModeV = VK_SAMPLER_ADDRESS_MODE_REPEAT;
+    samplerCreateInfo.addressModeW = VK_SAMPLER_ADDRESS_MODE_REPEAT;
+    samplerCreateInfo.maxLod = VK_LOD_CLAMP_NONE;
+    VkResult result = vkCreateSampler(device, &samplerCreateInfo, nullptr, &sampler);
+
+    // Materials are appended by the host and never rewritten, so the table stays in host visible memory
+    if (result == VK_SUCCESS)
+        result = createBuffer(this->materialCapacity * sizeof(MaterialData), VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, materialBuffer);
+    VkMemoryRequirements memoryRequirements{};
+    if (result == VK_SUCCESS)
+    {
+        vkGetBufferMemoryRequirements(device, materialBuffer, &memoryRequirements);
+        result = allocate(memoryRequirements, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+                          VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, MemoryCategory::Uniform, materialMemory);
+    }
+    if (result == VK_SUCCESS)
+        result = vkBindBufferMemory(device, materialBuffer, materialMemory, 0);
+    if (result == VK_SUCCESS)
+        result = vkMapMemory(device, materialMemory, 0, VK_WHOLE_SIZE, 0, reinterpret_cast<void **>(&materialPointer));
+    if (result != VK_SUCCESS)
+    {
+        return result;
+    }
+
+    VkDescriptorSetLayoutBinding materialBindings[] = {
+        {0, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, VK_SHADER_STAGE_FRAGMENT_BIT, nullptr},
+        {1, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 1, VK_SHADER_STAGE_FRAGMENT_BIT, nullptr},
+    };
+    VkDescriptorSetLayoutCreateInfo layoutCreateInfo{VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO};
+    layoutCreateInfo.bindingCount = 2;
+    layoutCreateInfo.pBindings = materialBindings;
+    result = vkCreateDescriptorSetLayout(device, &layoutCreateInfo, nullptr, &materialLayout);
+    if (result != VK_SUCCESS)
+    {
+        return result;
+    }
+
+    VkDescriptorPoolSize materialPoolSizes[] = {
+        {VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, this->materialCapacity},
+        {VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, this->materialCapacity},
+    };
+    VkDescriptorPoolCreateInfo poolCreateInfo{VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO};
+    poolCreateInfo.maxSets = this->materialCapacity;
+    poolCreateInfo.poolSizeCount = 2;
+    poolCreateInfo.pPoolSizes = materialPoolSizes;
+    result = vkCreateDescriptorPool(device, &poolCreateInfo, nullptr, &materialPool);
+    if (result == VK_SUCCESS && descriptorIndexing)
+        result = createBindlessSet(this->textureCapacity, this->bufferCapacity);
+    if (result != VK_SUCCESS)
+    {
+        return result;
+    }
+
+    uint32_t index;
+    if (descriptorIndexing)
+    {
+        result = addBuffer(materialBuffer, index);
+    }
+    const uint8_t white[] = {255, 255, 255, 255};
+    if (result == VK_SUCCESS)
+        result = addTexture(queue, commandPool, 1, 1, white, index);
+    if (result == VK_SUCCESS)
+        result = addMaterial({{1.0f, 1.0f, 1.0f, 1.0f}, 0, {0, 0, 0}}, index);
+    return result;
+}
+
+void VkBindless::destroy()
+{
+    if (device == VK_NULL_HANDLE)
+    {
+        return;
+    }
+
+    for (Transfer &transfer : transfers)
+    {
+        vkWaitForFences(device, 1, &transfer.fence, VK_TRUE, UINT64_MAX);
+        destroyTransfer(transfer);
+    }
+    vkDestroyDescriptorPool(device, bindlessPool, nullptr);
+    vkDestroyDescriptorSetLayout(device, bindlessLayout, nullptr);
+    vkDestroyDescriptorPool(device, materialPool, nullptr);
+    vkDestroyDescriptorSetLayout(device, materialLayout, nullptr);
+    for (Texture &texture : textures)
+    {
+        destroyTexture(texture);
+    }
+    vkDestroyBuffer(device, materialBuffer, nullptr);
+    memoryTracker->free(materialMemory);
+    vkDestroySampler(device, sampler, nullptr);
+
+    *this = VkBindless();
+}
+
+VkResult VkBindless::addTexture(VkQueue queue, VkCommandPool commandPool, uint32_t width, uint32_t height, const uint8_t *pixels, uint32_t &index)
+{
+    TextureData textureData;
+    textureData.width = width;
+    textureData.height = height;
+    textureData.levels.push_back({width, height, 0, static_cast<size_t>(width) * height * 4});
+    textureData.bytes.assign(pixels, pixels + textureData.levels[0].size);
+    return addTextures(queue, commandPool, &textureData, 1, nullptr, &index);
+}
+
+VkResult VkBindless::addTextures(VkQueue queue, VkCommandPool commandPool, const TextureData *textureData, size_t count, const uint32_t *firstLevels, uint32_t *indices)
+{
+    TRACE_ZONE("VkBindless.addTextures");
+
+    if (count == 0)
+    {
+        return VK_SUCCESS;
+    }
+    if (count > textureCapacity - textures.size())
+    {
+        return VK_ERROR_TOO_MANY_OBJECTS;
+    }
+
+    std::vector<Texture> created(count);
+    std::vector<LevelCopy> uploads;
+    VkResult result = VK_SUCCESS;
+    for (size_t i = 0; i < count && result == VK_SUCCESS; i++)
+    {
+        uint32_t firstLevel = firstLevels != nullptr ? firstLevels[i] : 0;
+        result = createTexture(textureData[i], firstLevel, created[i]);
+        for (uint32_t level = firstLevel; level < textureData[i].levels.size(); level++)
+        {
+            uploads.push_back({&textureData[i], level, created[i].image, level - firstLevel});
+        }
+    }
+
+    std::vector<VkImageMemoryBarrier> barriers;
+    for (const Texture &texture : created)
+    {
+        barriers.push_back(createBarrier(texture.image, texture.levelCount, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL));
+    }
+    if (result == VK_SUCCESS)
+        result = transfer(queue, commandPool, uploads, nullptr, 0, barriers);
+    if (result != VK_SUCCESS)
+    {
+        for (Texture &texture : created)
+        {
+            destroyTexture(texture);
+        }
+        return result;
+    }
+
+    uint32_t first = static_cast<uint32_t>(textures.size());
+    for (size_t i = 0; i < count; i++)
+    {
+        indices[i] = first + static_cast<uint32_t>(i);
+        textureMemory += created[i].size;
+        textures.push_back(created[i]);
+    }
+    if (descriptorIndexing)
+    {
+        // The elements are unused by every pending frame, so they may be written while they execute
+        writeTextureDescriptors(first, static_cast<uint32_t>(count));
+    }
+    return VK_SUCCESS;
+}
+
+VkResult VkBindless::updateTextures(VkQueue queue, VkCommandPool commandPool, const TextureUpdate *updates, size_t count, uint64_t &uploadedBytes)
+{
+    TRACE_ZONE("VkBindless.updateTextures");
+
+    uploadedBytes = 0;
+    if (count == 0)
+    {
+        return VK_SUCCESS;
+    }
+
+    // Levels the old image holds are copied on the device, only finer ones come from the host
+    std::vector<Texture> created(count);
+    std::vector<LevelCopy> uploads;
+    std::vector<VkImageCopy> copies;
+    std::vector<std::pair<VkImage, VkImage>> copyImages;
+    std::vector<VkImageMemoryBarrier> barriers;
+    VkResult result = VK_SUCCESS;
+    for (size_t i = 0; i < count && result == VK_SUCCESS; i++)
+    {
+        const TextureUpdate &update = updates[i];
+        const Texture &old = textures[update.texture];
+        result = createTexture(*update.data, update.firstLevel, created[i]);
+        uint32_t levelCount = static_cast<uint32_t>(update.data->levels.size());
+        for (uint32_t level = update.firstLevel; level < levelCount; level++)
+        {
+            if (level < old.firstLevel)
+            {
+                uploads.push_back({update.data, level, created[i].image, level - update.firstLevel});
+                uploadedBytes += update.data->levels[level].size;
+                continue;
+            }
+            const TextureLevel &textureLevel = update.data->levels[level];
+            VkImageCopy copy{};
+            copy.srcSubresource = {VK_IMAGE_ASPECT_COLOR_BIT, level - old.firstLevel, 0, 1};
+            copy.dstSubresource = {VK_IMAGE_ASPECT_COLOR_BIT, level - update.firstLevel, 0, 1};
+            copy.extent = {textureLevel.width, textureLevel.height, 1};
+            copies.push_back(copy);
+            copyImages.push_back({old.image, created[i].image});
+        }
+        barriers.push_back(createBarrier(created[i].image, created[i].levelCount, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL));
+        barriers.push_back(createBarrier(old.image, old.levelCount, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL));
+    }
+    if (result == VK_SUCCESS)
+        result = transfer(queue, commandPool, uploads, copyImages.data(), copies.size(), barriers, copies.data());
+    if (result != VK_SUCCESS)
+    {
+        for (Texture &texture : created)
+        {
+            destroyTexture(texture);
+        }
+        return result;
+    }
+
+    // Pending frames may still sample the replaced images, they retire before the transfer fence signals
+    Transfer &batch = transfers.back();
+    if (!materialSets.empty())
+    {
+        vkWaitForFences(device, 1, &batch.fence, VK_TRUE, UINT64_MAX);
+    }
+    for (size_t i = 0; i < count; i++)
+    {
+        uint32_t index = updates[i].texture;
+        textureMemory = textureMemory - textures[index].size + created[i].size;
+        batch.replaced.push_back(textures[index]);
+        textures[index] = created[i];
+        if (descriptorIndexing)
+        {
+            writeTextureDescriptors(index, 1);
+        }
+        for (uint32_t material = 0; material < materialSets.size(); material++)
+        {
+            if (materialPointer[material].textureIndex == index)
+            {
+                VkDescriptorImageInfo imageInfo = {sampler, textures[index].view, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL};
+                VkWriteDescriptorSet write = {VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET, nullptr, materialSets[material], 1, 0, 1, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, &imageInfo, nullptr, nullptr};
+                vkUpdateDescriptorSets(device, 1, &write, 0, nullptr);
+                descriptorWriteCount++;
+            }
+        }
+    }
+    return VK_SUCCESS;
+}
+
+void VkBindless::releaseTransfers()
+{
+    size_t pending = 0;
+    for (size_t i = 0; i < transfers.size(); i++)
+    {
+        if (vkGetFenceStatus(device, transfers[i].fence) == VK_SUCCESS)
+        {
+            destroyTransfer(transfers[i]);
+        }
+        else if (pending++ != i)
+        {
+            transfers[pending - 1] = std::move(transfers[i]);
+        }
+    }
+    transfers.erase(transfers.begin() + pending, transfers.end());
+}
+
+VkResult VkBindless::addBuffer(VkBuffer buffer, uint32_t &index)
+{
+    if (!descriptorIndexing)
+    {
+        return VK_ERROR_FEATURE_NOT_PRESENT;
+    }
+    if (bufferCount >= bufferCapacity)
+    {
+        return VK_ERROR_TOO_MANY_OBJECTS;
+    }
+
+    index = bufferCount++;
+    VkDescriptorBufferInfo bufferInfo = {buffer, 0, VK_WHOLE_SIZE};
+    VkWriteDescriptorSet write = {VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET, nullptr, bindlessSet, 1, index, 1, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, nullptr, &bufferInfo, nullptr};
+    vkUpdateDescriptorSets(device, 1, &write, 0, nullptr);
+    descriptorWriteCount++;
+    return VK_SUCCESS;
+}
+
+VkResult VkBindless::addMaterial(const MaterialData &material, uint32_t &index)
+{
+    if (materialCount >= materialCapacity)
+    {
+        return VK_ERROR_TOO_MANY_OBJECTS;
+    }
+
+    // Entries past the count are not read by pending frames, so the table is written in place
+    index = materialCount;
+    materialPointer[index] = material;
+    materialPointer[index].textureIndex = material.textureIndex < textures.size() ? material.textureIndex : 0;
+    materialCount++;
+    return materialSetsEnabled ? createMaterialSet(index) : VK_SUCCESS;
+}
+
+VkResult VkBindless::prepareMaterialSets()
+{
+    TRACE_ZONE("VkBindless.prepareMaterialSets");
+
+    materialSetsEnabled = true;
+    VkResult result = VK_SUCCESS;
+    for (uint32_t i = static_cast<uint32_t>(materialSets.size()); result == VK_SUCCESS && i < materialCount; i++)
+    {
+        result = createMaterialSet(i);
+    }
+    return result;
+}
+
+bool VkBindless::isDescriptorIndexingSupported() const
+{
+    return descriptorIndexing;
+}
+
+uint32_t VkBindless::getMaterialCount() const
+{
+    return materialCount;
+}
+
+uint32_t VkBindless::getTextureCount() const
+{
+    return static_cast<uint32_t>(textures.size());
+}
+
+uint64_t VkBindless::getDescriptorWriteCount() const
+{
+    return descriptorWriteCount;
+}
+
+uint64_t VkBindless::getTextureMemory() const
+{
+    return textureMemory;
+}
+
+uint32_t VkBindless::getMaterialTexture(uint32_t material) const
+{
+    return materialPointer[material].textureIndex;
+}
+
+VkDescriptorSetLayout VkBindless::getSetLayout() const
+{
+    return bindlessLayout;
+}
+
+VkDescriptorSet VkBindless::getSet() const
+{
+    return bindlessSet;
+}
+
+VkDescriptorSetLayout VkBindless::getMaterialSetLayout() const
+{
+    return materialLayout;
+}
+
+VkDescriptorSet VkBindless::getMaterialSet(uint32_t material) const
+{
+    return materialSets[material];
+}
+
+VkResult VkBindless::createBuffer(VkDeviceSize size, VkBufferUsageFlags usage, VkBuffer &buffer)
+{
+    VkBufferCreateInfo bufferCreateInfo = {
+        VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO,
+        nullptr,
+        0,
+        size,
+        usage,
+        VK_SHARING_MODE_EXCLUSIVE,
+        0,
+        nullptr,
+    };
+    return vkCreateBuffer(device, &bufferCreateInfo, nullptr, &buffer);
+}
+
+VkResult VkBindless::allocate(const VkMemoryRequirements &memoryRequirements, VkMemoryPropertyFlags preferred, VkMemoryPropertyFlags required, MemoryCategory category, VkDeviceMemory &memory)
+{
+    return memoryTracker->allocate(memoryRequirements, preferred, required, category, memory);
+}
+
+VkResult VkBindless::createBindlessSet(uint32_t textureCapacity, uint32_t bufferCapacity)
+{
+    VkDescriptorSetLayoutBinding bindings[] = {
+        {0, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, textureCapacity, VK_SHADER_STAGE_FRAGMENT_BIT, nullptr},
+        {1, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, bufferCapacity, VK_SHADER_STAGE_FRAGMENT_BIT, nullptr},
+    };
+    // Elements past the added resources stay unwritten, and new ones are written while the set is bound
+    VkDescriptorBindingFlagsEXT bindingFlags[] = {
+        VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT_EXT | VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT_EXT | VK_DESCRIPTOR_BINDING_UPDATE_UNUSED_WHILE_PENDING_BIT_EXT,
+        VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT_EXT | VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT_EXT | VK_DESCRIPTOR_BINDING_UPDATE_UNUSED_WHILE_PENDING_BIT_EXT,
+    };
+    VkDescriptorSetLayoutBindingFlagsCreateInfoEXT bindingFlagsCreateInfo{VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO_EXT};
+    bindingFlagsCreateInfo.bindingCount = 2;
+    bindingFlagsCreateInfo.pBindingFlags = bindingFlags;
+
+    VkDescriptorSetLayoutCreateInfo layoutCreateInfo{VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO};
+    layoutCreateInfo.pNext = &bindingFlagsCreateInfo;
+    layoutCreateInfo.flags = VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT_EXT;
+    layoutCreateInfo.bindingCount = 2;
+    layoutCreateInfo.pBindings = bindings;
+    VkResult result = vkCreateDescriptorSetLayout(device, &layoutCreateInfo, nullptr, &bindlessLayout);
+    if (result != VK_SUCCESS)
+    {
+        return result;
+    }
+
+    VkDescriptorPoolSize poolSizes[] = {
+        {VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, textureCapacity},
+        {VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, bufferCapacity},
+    };
+    VkDescriptorPoolCreateInfo poolCreateInfo{VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO};
+    poolCreateInfo.flags = VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT_EXT;
+    poolCreateInfo.maxSets = 1;
+    poolCreateInfo.poolSizeCount = 2;
+    poolCreateInfo.pPoolSizes = poolSizes;
+    result = vkCreateDescriptorPool(device, &poolCreateInfo, nullptr, &bindlessPool);
+    if (result != VK_SUCCESS)
+    {
+        return result;
+    }
+
+    VkDescriptorSetAllocateInfo allocateInfo{VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO};
+    allocateInfo.descriptorPool = bindlessPool;
+    allocateInfo.descriptorSetCount = 1;
+    allocateInfo.pSetLayouts = &bindlessLayout;
+    return vkAllocateDescriptorSets(device, &allocateInfo, &bindlessSet);
+}
+
+VkResult VkBindless::createMaterialSet(uint32_t material)
+{
+    VkDescriptorSetAllocateInfo allocateInfo{VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO};
+    allocateInfo.descriptorPool = materialPool;
+    allocateInfo.descriptorSetCount = 1;
+    allocateInfo.pSetLayouts = &materialLayout;
+    VkDescriptorSet set;
+    VkResult result = vkAllocateDescriptorSets(device, &allocateInfo, &set);
+    if (result != VK_SUCCESS)
+    {
+        return result;
+    }
+
+    VkDescriptorBufferInfo bufferInfo = {materialBuffer, 0, VK_WHOLE_SIZE};
+    VkDescriptorImageInfo imageInfo = {sampler, textures[materialPointer[material].textureIndex].view, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL};
+    VkWriteDescriptorSet writes[] = {
+        {VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET, nullptr, set, 0, 0, 1, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, nullptr, &bufferInfo, nullptr},
+        {VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET, nullptr, set, 1, 0, 1, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, &imageInfo, nullptr, nullptr},
+    };
+    vkUpdateDescriptorSets(device, 2, writes, 0, nullptr);
+    descriptorWriteCount += 2;
+    materialSets.push_back(set);
+    return VK_SUCCESS;
+}
+
+VkResult VkBindless::createTexture(const TextureData &textureData, uint32_t firstLevel, Texture &texture)
+{
+    const TextureLevel &base = textureData.levels[firstLevel];
+    texture.firstLevel = firstLevel;
+    texture.levelCount = static_cast<uint32_t>(textureData.levels.size()) - firstLevel;
+
+    VkImageCreateInfo imageCreateInfo{VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO};
+    imageCreateInfo.imageType = VK_IMAGE_TYPE_2D;
+    imageCreateInfo.format = toVkFormat(textureData.format);
+    imageCreateInfo.extent = {base.width, base.height, 1};
+    imageCreateInfo.mipLevels = texture.levelCount;
+    imageCreateInfo.arrayLayers = 1;
+    imageCreateInfo.samples = VK_SAMPLE_COUNT_1_BIT;
+    imageCreateInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+    imageCreateInfo.usage = VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT;
+    imageCreateInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+    imageCreateInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+    VkResult result = vkCreateImage(device, &imageCreateInfo, nullptr, &texture.image);
+    VkMemoryRequirements memoryRequirements{};
+    if (result == VK_SUCCESS)
+    {
+        vkGetImageMemoryRequirements(device, texture.image, &memoryRequirements);
+        texture.size = memoryRequirements.size;
+        result = allocate(memoryRequirements, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, 0, MemoryCategory::Texture, texture.memory);
+    }
+    if (result == VK_SUCCESS)
+        result = vkBindImageMemory(device, texture.image, texture.memory, 0);
+    if (result == VK_SUCCESS)
+    {
+        VkImageViewCreateInfo viewCreateInfo{VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO};
+        viewCreateInfo.image = texture.image;
+        viewCreateInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
+        viewCreateInfo.format = imageCreateInfo.format;
+        viewCreateInfo.subresourceRange = {VK_IMAGE_ASPECT_COLOR_BIT, 0, texture.levelCount, 0, 1};
+        result = vkCreateImageView(device, &viewCreateInfo, nullptr, &texture.view);
+    }
+    return result;
+}
+
+VkImageMemoryBarrier VkBindless::createBarrier(VkImage image, uint32_t levelCount, VkImageLayout oldLayout, VkImageLayout newLayout)
+{
+    VkImageMemoryBarrier barrier{VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER};
+    barrier.srcAccessMask = oldLayout == VK_IMAGE_LAYOUT_UNDEFINED ? 0 : VK_ACCESS_SHADER_READ_BIT;
+    barrier.dstAccessMask = newLayout == VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL ? VK_ACCESS_TRANSFER_WRITE_BIT : VK_ACCESS_TRANSFER_READ_BIT;
+    barrier.oldLayout = oldLayout;
+    barrier.newLayout = newLayout;
+    barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.image = image;
+    barrier.subresourceRange = {VK_IMAGE_ASPECT_COLOR_BIT, 0, levelCount, 0, 1};
+    return barrier;
+}
+
+VkResult VkBindless::transfer(VkQueue queue, VkCommandPool commandPool, const std::vector<LevelCopy> &uploads, const std::pair<VkImage, VkImage> *copyImages,
+                              size_t copyCount, std::vector<VkImageMemoryBarrier> &barriers, const VkImageCopy *copies)
+{
+    releaseTransfers();
+
+    // Every level starts at a 16 byte offset, a multiple of all block sizes
+    VkDeviceSize stagingSize = 16;
+    std::vector<VkDeviceSize> stagingOffsets;
+    for (const LevelCopy &upload : uploads)
+    {
+        stagingOffsets.push_back(stagingSize);
+        stagingSize += (upload.data->levels[upload.level].size + 15) & ~static_cast<VkDeviceSize>(15);
+    }
+
+    VkBuffer stagingBuffer = VK_NULL_HANDLE;
+    VkDeviceMemory stagingMemory = VK_NULL_HANDLE;
+    VkMemoryRequirements memoryRequirements{};
+    VkResult result = createBuffer(stagingSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, stagingBuffer);
+    if (result == VK_SUCCESS)
+    {
+        vkGetBufferMemoryRequirements(device, stagingBuffer, &memoryRequirements);
+        result = allocate(memoryRequirements, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+                          VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, MemoryCategory::Staging, stagingMemory);
+    }
+    if (result == VK_SUCCESS)
+        result = vkBindBufferMemory(device, stagingBuffer, stagingMemory, 0);
+    uint8_t *data = nullptr;
+    if (result == VK_SUCCESS)
+        result = vkMapMemory(device, stagingMemory, 0, VK_WHOLE_SIZE, 0, reinterpret_cast<void **>(&data));
+    if (result != VK_SUCCESS)
+    {
+        vkDestroyBuffer(device, stagingBuffer, nullptr);
+        memoryTracker->free(stagingMemory);
+        return result;
+    }
+    for (size_t i = 0; i < uploads.size(); i++)
+    {
+        const TextureLevel &level = uploads[i].data->levels[uploads[i].level];
+        memcpy(data + stagingOffsets[i], uploads[i].data->bytes.data() + level.offset, level.size);
+    }
+    vkUnmapMemory(device, stagingMemory);
+
+    Transfer batch;
+    batch.commandPool = commandPool;
+    batch.stagingBuffer = stagingBuffer;
+    batch.stagingMemory = stagingMemory;
+    VkFenceCreateInfo fenceCreateInfo = {VK_STRUCTURE_TYPE_FENCE_CREATE_INFO, nullptr, 0};
+    result = vkCreateFence(device, &fenceCreateInfo, nullptr, &batch.fence);
+    VkCommandBufferAllocateInfo commandBufferAllocateInfo = {VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO, nullptr, commandPool, VK_COMMAND_BUFFER_LEVEL_PRIMARY, 1};
+    if (result == VK_SUCCESS)
+        result = vkAllocateCommandBuffers(device, &commandBufferAllocateInfo, &batch.commandBuffer);
+    if (result != VK_SUCCESS)
+    {
+        destroyTransfer(batch);
+        return result;
+    }
+    VkCommandBuffer commandBuffer = batch.commandBuffer;
+
+    VkCommandBufferBeginInfo commandBufferBeginInfo = {VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO, nullptr, VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT, nullptr};
+    vkBeginCommandBuffer(commandBuffer, &commandBufferBeginInfo);
+    vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0, nullptr,
+                         static_cast<uint32_t>(barriers.size()), barriers.data());
+    for (size_t i = 0; i < uploads.size(); i++)
+    {
+        const TextureLevel &level = uploads[i].data->levels[uploads[i].level];
+        VkBufferImageCopy copy{};
+        copy.bufferOffset = stagingOffsets[i];
+        copy.imageSubresource = {VK_IMAGE_ASPECT_COLOR_BIT, uploads[i].imageLevel, 0, 1};
+        copy.imageExtent = {level.width, level.height, 1};
+        vkCmdCopyBufferToImage(commandBuffer, stagingBuffer, uploads[i].image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &copy);
+    }
+    for (size_t i = 0; i < copyCount; i++)
+    {
+        vkCmdCopyImage(commandBuffer, copyImages[i].first, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, copyImages[i].second, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &copies[i]);
+    }
+    // Source images are only destroyed after the transfer, just the written ones are read again. The
+    // barrier also orders the sampling of frames submitted later after the copies
+    std::vector<VkImageMemoryBarrier> readBarriers;
+    for (VkImageMemoryBarrier barrier : barriers)
+    {
+        if (barrier.newLayout == VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL)
+        {
+            barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+            barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+            barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+            barrier.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+            readBarriers.push_back(barrier);
+        }
+    }
+    vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, 0, 0, nullptr, 0, nullptr,
+                         static_cast<uint32_t>(readBarriers.size()), readBarriers.data());
+    vkEndCommandBuffer(commandBuffer);
+
+    VkSubmitInfo submitInfo = {VK_STRUCTURE_TYPE_SUBMIT_INFO, nullptr, 0, nullptr, nullptr, 1, &commandBuffer, 0, nullptr};
+    result = vkQueueSubmit(queue, 1, &submitInfo, batch.fence);
+    if (result != VK_SUCCESS)
+    {
+        destroyTransfer(batch);
+        return result;
+    }
+    transfers.push_back(std::move(batch));
+    return VK_SUCCESS;
+}
+
+void VkBindless::writeTextureDescriptors(uint32_t first, uint32_t count)
+{
+    std::vector<VkDescriptorImageInfo> imageInfos;
+    for (uint32_t i = first; i < first + count; i++)
+    {
+        imageInfos.push_back({sampler, textures[i].view, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL});
+    }
+    VkWriteDescriptorSet write = {VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET, nullptr, bindlessSet, 0, first, count, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, imageInfos.data(), nullptr, nullptr};
+    vkUpdateDescriptorSets(device, 1, &write, 0, nullptr);
+    descriptorWriteCount += count;
+}
+
+void VkBindless::destroyTexture(Texture &texture)
+{
+    vkDestroyImageView(device, texture.view, nullptr);
+    vkDestroyImage(device, texture.image, nullptr);
+    memoryTracker->free(texture.memory);
+}
+
+void VkBindless::destroyTransfer(Transfer &transfer)
+{
+    for (Texture &texture : transfer.replaced)
+    {
+        destroyTexture(texture);
+    }
+    if (transfer.commandBuffer != VK_NULL_HANDLE)
+    {
+        vkFreeCommandBuffers(device, transfer.commandPool, 1, &transfer.commandBuffer);
+    }
+    vkDestroyFence(device, transfer.fence, nullptr);
+    vkDestroyBuffer(device, transfer.stagingBuffer, nullptr);
+    memoryTracker->free(transfer.stagingMemory);
+}
@@ -16,6 +16,22 @@
 #include <jni.h>
 
 #include "vulkan/VkHelper.hpp"
+#include "vulkan/VkProfiler.hpp"
+#include "vulkan/VkSkinning.hpp"
+#include "vulkan/VkOcclusion.hpp"
+#include "vulkan/VkRenderGraph.hpp"
+#include "vulkan/VkMemoryTracker.hpp"
+#include "vulkan/VkMeshArena.hpp"
+#include "vulkan/VkBindless.hpp"
+#include "vulkan/VkTextureStreamer.hpp"
+#include "texture/TextureCache.hpp"
+#include "texture/TextureCodec.hpp"
+#include "core/Tracer.hpp"
+#include "core/ThreadPool.hpp"
+#include "core/AssetLoader.hpp"
+#include "scene/SceneGraph.hpp"
+#include "scene/FrustumCuller.hpp"
+#include "anim/Skin.hpp"
 
 #include "SDL2/SDL.h"
 #include "SDL2/SDL_vulkan.h"
@@ -24,24 +40,34 @@
 
 #include "volk.h"
 
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <numeric>
+#include <cstring>
 #include <fstream>
 #include <chrono>
 #include <iostream>
+#include <memory>
 #include <vector>
 #include <string>
 
 using namespace VkHelper;
 
+static_assert(sizeof(Matrix4) == sizeof(glm::mat4), "SceneGraph matrices must match the glm::mat4 layout");
+
 VkExtent2D windowSize{};
+bool headless = false;
 
 VkInstance instance;
+uint32_t instanceApiVersion = VK_API_VERSION_1_0;
 VkDebugUtilsMessengerEXT messenger;
 
 VkSurfaceKHR surface;
 VkSurfaceFormatKHR surfaceFormat;
 
 VkPhysicalDevice physicalDevice;
-VkPhysicalDeviceMemoryProperties physicalDeviceMemoryProperties;
+VkMemoryTracker memoryTracker;
 uint32_t queueFamilyIndex;
 VkDevice device;
 VkQueue queue;
@@ -55,13 +81,17 @@ VkCommandPool commandPool;
 std::vector<VkCommandBuffer> commandBuffers;
 
 VkBuffer hostVertexBuffer;
-VkBuffer hostMatrixBuffer;
-VkMemoryRequirements hostMemoryRequirements[2];
+VkBuffer matrixRingBuffer;
+VkDeviceMemory matrixRingMemory;
+VkDeviceSize matrixRingStride = 0;
+VkDeviceSize minStorageBufferOffsetAlignment = 1;
+std::vector<glm::mat4 *> frameMatrixPointers;
+uint32_t matrixCapacity = 1;
+double matrixWriteTime = 0.0;
 VkDeviceMemory hostMemory;
 void *hostDataPointer;
 VkBuffer deviceVertexBuffer;
-VkBuffer deviceMatrixBuffer;
-VkMemoryRequirements deviceMemoryRequirements[2];
+VkMemoryRequirements deviceMemoryRequirements;
 VkDeviceMemory deviceMemory;
 
 VkDescriptorPool descriptorPool;
@@ -72,10 +102,131 @@ VkRenderPass renderPass;
 std::vector<VkFramebuffer> framebuffers;
 std::vector<VkImageView> swapchainImagesViews;
 
+VkFormat depthFormat = VK_FORMAT_UNDEFINED;
+VkRenderGraph renderGraph;
+uint32_t colorResource = 0;
+uint32_t depthResource = 0;
+uint32_t skinnedVertexResource = 0;
+uint32_t occlusionDrawResource = 0;
+uint32_t occlusionCounterResource = 0;
+uint32_t objectDrawResource = 0;
+uint32_t pyramidResource = 0;
+uint32_t readbackResource = 0;
+uint32_t occlusionPass = 0;
+uint32_t objectPass = 0;
+
+VkShaderModule vertShader;
+VkShaderModule fragShader;
+VkShaderModule skinShader;
+VkShaderModule meshVertShader;
+VkShaderModule hizShader;
+VkShaderModule occlusionShader;
+VkShaderModule bindlessShader;
+VkShaderModule materialShader;
 VkPipelineLayout pipelineLayout;
 VkPipeline pipeline;
+VkPipelineLayout meshPipelineLayout;
+VkPipeline meshPipeline;
+VkPipelineLayout materialPipelineLayout;
+VkPipeline materialPipeline;
+VkPipeline skinnedMeshPipeline;
+VkPipeline skinnedMaterialPipeline;
 
 std::vector<VkSemaphore> semaphores;
+std::vector<VkFence> frameFences;
+
+VkDeviceMemory offscreenMemory;
+std::vector<VkBuffer> readbackBuffers;
+std::vector<VkDeviceMemory> readbackMemories;
+std::vector<void *> readbackDataPointers;
+std::vector<VkFence> readbackFences;
+VkDeviceSize readbackSize;
+uint32_t nextOffscreenSlot = 0;
+
+bool pipelineStatisticsEnabled = false;
+VkProfiler profiler;
+double presentTime = 0.0;
+double recordTime = 0.0;
+double swapchainRecreateTime = 0.0;
+uint32_t pipelineCreateCount = 0;
+SceneGraph *sceneGraph = nullptr;
+VkSkinning skinning;
+VkOcclusion occlusion;
+VkMeshArena meshArena;
+VkBindless bindless;
+VkTextureStreamer textureStreamer;
+std::unique_ptr<AssetLoader> assetLoader;
+uint64_t assetUploadBudget = 0;
+
+/**
+ * @brief A mesh placed in the shared vertex and index arenas.
+ */
+struct Mesh
+{
+    MeshRange range;
+    Bounds bounds;
+    uint32_t vertexCount;
+};
+
+/**
+ * @brief An object drawing the triangles of a mesh with the vertices of a skin instance.
+ */
+struct SkinnedObject
+{
+    uint32_t mesh;
+    uint32_t instance;
+    uint32_t material;
+};
+
+/**
+ * @brief Consecutive draw commands sharing a material, drawn after binding its set.
+ */
+struct MaterialBatch
+{
+    uint32_t material;
+    uint32_t firstCommand;
+    uint32_t commandCount;
+};
+
+/**
+ * @brief Push constants of the mesh pipeline.
+ */
+struct MeshPushConstants
+{
+    Matrix4 viewProjection;
+};
+
+std::vector<Mesh> meshes;
+std::vector<uint32_t> objectMeshes;
+std::vector<uint32_t> objectMaterials;
+std::vector<SkinnedObject> skinnedObjects;
+FrustumCuller frustumCuller;
+Matrix4 viewProjection = Matrix4::identity();
+bool frustumCullingEnabled = true;
+bool occlusionCullingEnabled = true;
+bool multiDrawIndirectEnabled = true;
+bool instancingEnabled = true;
+bool bindlessEnabled = true;
+bool descriptorIndexingSupported = false;
+uint32_t maxBindlessTextures = 0;
+uint32_t maxBindlessBuffers = 0;
+bool textureCompressionSupported = false;
+bool drawIndirectFirstInstanceSupported = false;
+bool multiDrawIndirectSupported = false;
+bool drawIndirectCountSupported = false;
+bool synchronization2Supported = false;
+bool dynamicRenderingSupported = false;
+bool memoryBudgetSupported = false;
+uint32_t maxDrawIndirectCount = 1;
+std::vector<uint32_t> visibleObjects;
+std::vector<uint32_t> groupedObjects;
+std::vector<uint32_t> groupOffsets;
+std::vector<VkDrawIndexedIndirectCommand> instanceGroups;
+std::vector<MaterialBatch> materialBatches;
+uint32_t drawCount = 0;
+uint32_t drawCallCount = 0;
+uint32_t descriptorBindCount = 0;
+uint32_t occludedCount = 0;
 std::vector<glm::vec3> inputData = {{-0.2f, -0.2f, 0.5f}, {0.5f, 0.8f, 0.72f}, {0.2f, -0.2f, 0.5f}, {0.0f, 0.3f, 0.1f}, {0.0f, 0.2f, 0.5f}, {0.4f, 0.1f, 0.8f}};
 
 /**
@@ -86,11 +237,16 @@ std::vector<glm::vec3> inputData = {{-0.2f, -0.2f, 0.5f}, {0.5f, 0.8f, 0.72f}, {
  */
 JNIEXPORT void JNICALL Java_com_github_nodedev74_jfbx_vulkan_VkHandler_createInstance(JNIEnv *env, jobject obj)
 {
+    TRACE_ZONE("VkHandler.createInstance");
+
     jclass cls = env->GetObjectClass(obj);
     jfieldID fieldID = env->GetFieldID(cls, "sdlWindowPtr", "J");
     jlong sdlWindowPtr = env->GetLongField(obj, fieldID);
     SDL_Window *sdlWindow = reinterpret_cast<SDL_Window *>(sdlWindowPtr);
 
+    jfieldID headlessFieldID = env->GetFieldID(cls, "headless", "Z");
+    headless = env->GetBooleanField(obj, headlessFieldID) == JNI_TRUE;
+
     VkResult volkInitResult = volkInitialize();
     if (volkInitResult != VK_SUCCESS)
     {
@@ -104,7 +260,17 @@ JNIEXPORT void JNICALL Java_com_github_nodedev74_jfbx_vulkan_VkHandler_createIns
         return;
     }
 
+    // Vulkan 1.1 provides the feature chain that descriptor indexing is queried through
+    uint32_t loaderApiVersion = VK_API_VERSION_1_0;
+    if (vkEnumerateInstanceVersion != nullptr)
+    {
+        vkEnumerateInstanceVersion(&loaderApiVersion);
+    }
+    instanceApiVersion = loaderApiVersion >= VK_API_VERSION_1_1 ? VK_API_VERSION_1_1 : VK_API_VERSION_1_0;
+
     VkApplicationInfo appInfo = {};
+    appInfo.sType = VK_STRUCTURE_TYPE_APPLICATION_INFO;
+    appInfo.apiVersion = instanceApiVersion;
 
     const std::vector<const char *> validationLayers = {"VK_LAYER_KHRONOS_validation"};
 
@@ -113,14 +279,18 @@ JNIEXPORT void JNICALL Java_com_github_nodedev74_jfbx_vulkan_VkHandler_createIns
     std::vector<VkLayerProperties> availableLayers(layerCount);
     vkEnumerateInstanceLayerProperties(&layerCount, availableLayers.data());
 
-    uint32_t extensionCount;
-    SDL_Vulkan_GetInstanceExtensions(sdlWindow, &extensionCount, nullptr);
     std::vector<const char *> extensionNames;
-    SDL_Vulkan_GetInstanceExtensions(sdlWindow, &extensionCount, extensionNames.data());
+    if (!headless)
+    {
+        uint32_t extensionCount;
+        SDL_Vulkan_GetInstanceExtensions(sdlWindow, &extensionCount, nullptr);
+        extensionNames.resize(extensionCount);
+        SDL_Vulkan_GetInstanceExtensions(sdlWindow, &extensionCount, extensionNames.data());
 
-    extensionNames.push_back(VK_KHR_SURFACE_EXTENSION_NAME);
+        extensionNames.push_back(VK_KHR_SURFACE_EXTENSION_NAME);
+        extensionNames.push_back(VK_KHR_WIN32_SURFACE_EXTENSION_NAME);
+    }
     extensionNames.push_back(VK_EXT_DEBUG_UTILS_EXTENSION_NAME);
-    extensionNames.push_back(VK_KHR_WIN32_SURFACE_EXTENSION_NAME);
 
     VkInstanceCreateInfo instInfo = {};
     instInfo.sType = VK_STRUCTURE_TYPE_INSTANCE_CREATE_INFO;
@@ -156,6 +326,8 @@ JNIEXPORT void JNICALL Java_com_github_nodedev74_jfbx_vulkan_VkHandler_createIns
  */
 JNIEXPORT void JNICALL Java_com_github_nodedev74_jfbx_vulkan_VkHandler_createDebugger(JNIEnv *env, jobject obj)
 {
+    TRACE_ZONE("VkHandler.createDebugger");
+
     VkDebugUtilsMessengerCreateInfoEXT debugMessengerCreateInfo{};
     debugMessengerCreateInfo.sType = VK_STRUCTURE_TYPE_DEBUG_UTILS_MESSENGER_CREATE_INFO_EXT;
     debugMessengerCreateInfo.messageSeverity = VK_DEBUG_UTILS_MESSAGE_SEVERITY_WARNING_BIT_EXT | VK_DEBUG_UTILS_MESSAGE_SEVERITY_ERROR_BIT_EXT;
@@ -177,6 +349,8 @@ JNIEXPORT void JNICALL Java_com_github_nodedev74_jfbx_vulkan_VkHandler_createDeb
  */
 JNIEXPORT void JNICALL Java_com_github_nodedev74_jfbx_vulkan_VkHandler_createSureface(JNIEnv *env, jobject obj)
 {
+    TRACE_ZONE("VkHandler.createSureface");
+
     jclass cls = env->GetObjectClass(obj);
     jfieldID fieldID = env->GetFieldID(cls, "sdlWindowPtr", "J");
     jlong sdlWindowPtr = env->GetLongField(obj, fieldID);
@@ -200,6 +374,8 @@ JNIEXPORT void JNICALL Java_com_github_nodedev74_jfbx_vulkan_VkHandler_createSur
  */
 JNIEXPORT void JNICALL Java_com_github_nodedev74_jfbx_vulkan_VkHandler_createLogicalDevice(JNIEnv *env, jobject obj)
 {
+    TRACE_ZONE("VkHandler.createLogicalDevice");
+
     uint32_t devicesNumber;
     vkEnumeratePhysicalDevices(instance, &devicesNumber, nullptr);
     std::vector<VkPhysicalDevice> devices(devicesNumber);
@@ -216,7 +392,6 @@ JNIEXPORT void JNICALL Java_com_github_nodedev74_jfbx_vulkan_VkHandler_createLog
     size_t selectedDeviceNumber = 0;
 
     physicalDevice = devices[selectedDeviceNumber];
-    vkGetPhysicalDeviceMemoryProperties(physicalDevice, &physicalDeviceMemoryProperties);
 
     uint32_t familiesCount;
     vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, &familiesCount, nullptr);
@@ -224,11 +399,25 @@ JNIEXPORT void JNICALL Java_com_github_nodedev74_jfbx_vulkan_VkHandler_createLog
     vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, &familiesCount, queueFamiliesProperties.data());
 
     queueFamilyIndex = -1;
-    VkBool32 doesQueueFamilySupportSurface = VK_FALSE;
-    while (doesQueueFamilySupportSurface == VK_FALSE)
+    if (headless)
     {
-        queueFamilyIndex++;
-        vkGetPhysicalDeviceSurfaceSupportKHR(physicalDevice, queueFamilyIndex, surface, &doesQueueFamilySupportSurface);
+        for (uint32_t i = 0; i < familiesCount; i++)
+        {
+            if (queueFamiliesProperties[i].queueFlags & VK_QUEUE_GRAPHICS_BIT)
+            {
+                queueFamilyIndex = i;
+                break;
+            }
+        }
+    }
+    else
+    {
+        VkBool32 doesQueueFamilySupportSurface = VK_FALSE;
+        while (doesQueueFamilySupportSurface == VK_FALSE)
+        {
+            queueFamilyIndex++;
+            vkGetPhysicalDeviceSurfaceSupportKHR(physicalDevice, queueFamilyIndex, surface, &doesQueueFamilySupportSurface);
+        }
     }
 
     std::vector<float> queuePriorities = {1.0f};
@@ -241,12 +430,143 @@ JNIEXPORT void JNICALL Java_com_github_nodedev74_jfbx_vulkan_VkHandler_createLog
          static_cast<uint32_t>(queuePriorities.size()),
          queuePriorities.data()});
 
-    std::vector<const char *> desiredDeviceLevelExtensions = {"VK_KHR_swapchain"};
+    std::vector<const char *> desiredDeviceLevelExtensions;
+    if (!headless)
+    {
+        desiredDeviceLevelExtensions.push_back(VK_KHR_SWAPCHAIN_EXTENSION_NAME);
+    }
     VkPhysicalDeviceFeatures selectedDeviceFeatures = {0};
 
+    jclass cls = env->GetObjectClass(obj);
+    jfieldID pipelineStatisticsFieldID = env->GetFieldID(cls, "pipelineStatistics", "Z");
+    pipelineStatisticsEnabled = env->GetBooleanField(obj, pipelineStatisticsFieldID) == JNI_TRUE &&
+                                devicesFeatures[selectedDeviceNumber].pipelineStatisticsQuery == VK_TRUE;
+    selectedDeviceFeatures.pipelineStatisticsQuery = pipelineStatisticsEnabled ? VK_TRUE : VK_FALSE;
+
+    // Indirect draws carry their draw index as first instance, without it objects are only drawn directly
+    drawIndirectFirstInstanceSupported = devicesFeatures[selectedDeviceNumber].drawIndirectFirstInstance == VK_TRUE;
+    multiDrawIndirectSupported = devicesFeatures[selectedDeviceNumber].multiDrawIndirect == VK_TRUE;
+    selectedDeviceFeatures.drawIndirectFirstInstance = drawIndirectFirstInstanceSupported ? VK_TRUE : VK_FALSE;
+    selectedDeviceFeatures.multiDrawIndirect = multiDrawIndirectSupported ? VK_TRUE : VK_FALSE;
+    maxDrawIndirectCount = std::max<uint32_t>(devicesProperties[selectedDeviceNumber].limits.maxDrawIndirectCount, 1);
+    minStorageBufferOffsetAlignment = std::max<VkDeviceSize>(devicesProperties[selectedDeviceNumber].limits.minStorageBufferOffsetAlignment, 1);
+    textureCompressionSupported = devicesFeatures[selectedDeviceNumber].textureCompressionBC == VK_TRUE;
+    selectedDeviceFeatures.textureCompressionBC = textureCompressionSupported ? VK_TRUE : VK_FALSE;
+
+    uint32_t extensionCount;
+    vkEnumerateDeviceExtensionProperties(physicalDevice, nullptr, &extensionCount, nullptr);
+    std::vector<VkExtensionProperties> availableExtensions(extensionCount);
+    vkEnumerateDeviceExtensionProperties(physicalDevice, nullptr, &extensionCount, availableExtensions.data());
+    drawIndirectCountSupported = std::any_of(availableExtensions.begin(), availableExtensions.end(), [](const VkExtensionProperties &extension)
+                                             { return strcmp(extension.extensionName, VK_KHR_DRAW_INDIRECT_COUNT_EXTENSION_NAME) == 0; });
+    if (drawIndirectCountSupported)
+    {
+        desiredDeviceLevelExtensions.push_back(VK_KHR_DRAW_INDIRECT_COUNT_EXTENSION_NAME);
+    }
+
+    // Bindless materials index update after bind arrays with values that differ between draws
+    VkPhysicalDeviceDescriptorIndexingFeaturesEXT descriptorIndexingFeatures{VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_FEATURES_EXT};
+    bool descriptorIndexingExtension = std::any_of(availableExtensions.begin(), availableExtensions.end(), [](const VkExtensionProperties &extension)
+                                                   { return strcmp(extension.extensionName, VK_EXT_DESCRIPTOR_INDEXING_EXTENSION_NAME) == 0; });
+    descriptorIndexingSupported = false;
+    if (descriptorIndexingExtension && instanceApiVersion >= VK_API_VERSION_1_1 && devicesProperties[selectedDeviceNumber].apiVersion >= VK_API_VERSION_1_1)
+    {
+        VkPhysicalDeviceFeatures2 features{VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2};
+        features.pNext = &descriptorIndexingFeatures;
+        vkGetPhysicalDeviceFeatures2(physicalDevice, &features);
+        descriptorIndexingSupported = descriptorIndexingFeatures.runtimeDescriptorArray && descriptorIndexingFeatures.shaderSampledImageArrayNonUniformIndexing &&
+                                      descriptorIndexingFeatures.descriptorBindingPartiallyBound && descriptorIndexingFeatures.descriptorBindingSampledImageUpdateAfterBind &&
+                                      descriptorIndexingFeatures.descriptorBindingStorageBufferUpdateAfterBind && descriptorIndexingFeatures.descriptorBindingUpdateUnusedWhilePending;
+
+        VkPhysicalDeviceDescriptorIndexingPropertiesEXT descriptorIndexingProperties{VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_PROPERTIES_EXT};
+        VkPhysicalDeviceProperties2 properties{VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2};
+        properties.pNext = &descriptorIndexingProperties;
+        vkGetPhysicalDeviceProperties2(physicalDevice, &properties);
+        maxBindlessTextures = std::min(descriptorIndexingProperties.maxDescriptorSetUpdateAfterBindSampledImages,
+                                       descriptorIndexingProperties.maxPerStageDescriptorUpdateAfterBindSampledImages);
+        maxBindlessBuffers = std::min(descriptorIndexingProperties.maxDescriptorSetUpdateAfterBindStorageBuffers,
+                                      descriptorIndexingProperties.maxPerStageDescriptorUpdateAfterBindStorageBuffers);
+    }
+    VkPhysicalDeviceDescriptorIndexingFeaturesEXT enabledDescriptorIndexingFeatures{VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_FEATURES_EXT};
+    if (descriptorIndexingSupported)
+    {
+        enabledDescriptorIndexingFeatures.runtimeDescriptorArray = VK_TRUE;
+        enabledDescriptorIndexingFeatures.shaderSampledImageArrayNonUniformIndexing = VK_TRUE;
+        enabledDescriptorIndexingFeatures.descriptorBindingPartiallyBound = VK_TRUE;
+        enabledDescriptorIndexingFeatures.descriptorBindingSampledImageUpdateAfterBind = VK_TRUE;
+        enabledDescriptorIndexingFeatures.descriptorBindingStorageBufferUpdateAfterBind = VK_TRUE;
+        enabledDescriptorIndexingFeatures.descriptorBindingUpdateUnusedWhilePending = VK_TRUE;
+        desiredDeviceLevelExtensions.push_back(VK_EXT_DESCRIPTOR_INDEXING_EXTENSION_NAME);
+    }
+
+    // The render graph records its barriers with synchronization2 where the device has it
+    jfieldID synchronization2FieldID = env->GetFieldID(cls, "synchronization2", "Z");
+    bool synchronization2Extension = std::any_of(availableExtensions.begin(), availableExtensions.end(), [](const VkExtensionProperties &extension)
+                                                 { return strcmp(extension.extensionName, VK_KHR_SYNCHRONIZATION_2_EXTENSION_NAME) == 0; });
+    synchronization2Supported = false;
+    if (env->GetBooleanField(obj, synchronization2FieldID) == JNI_TRUE && synchronization2Extension &&
+        instanceApiVersion >= VK_API_VERSION_1_1 && devicesProperties[selectedDeviceNumber].apiVersion >= VK_API_VERSION_1_1)
+    {
+        VkPhysicalDeviceSynchronization2FeaturesKHR synchronization2Features{VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SYNCHRONIZATION_2_FEATURES_KHR};
+        VkPhysicalDeviceFeatures2 features{VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2};
+        features.pNext = &synchronization2Features;
+        vkGetPhysicalDeviceFeatures2(physicalDevice, &features);
+        synchronization2Supported = synchronization2Features.synchronization2 == VK_TRUE;
+    }
+    VkPhysicalDeviceSynchronization2FeaturesKHR enabledSynchronization2Features{VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SYNCHRONIZATION_2_FEATURES_KHR};
+    enabledSynchronization2Features.pNext = descriptorIndexingSupported ? &enabledDescriptorIndexingFeatures : nullptr;
+    if (synchronization2Supported)
+    {
+        enabledSynchronization2Features.synchronization2 = VK_TRUE;
+        desiredDeviceLevelExtensions.push_back(VK_KHR_SYNCHRONIZATION_2_EXTENSION_NAME);
+    }
+
+    // Dynamic rendering begins rendering on image views, so no render pass or framebuffer objects are created.
+    // Below Vulkan 1.2 it also needs the depth stencil resolve and create render pass 2 extensions
+    jfieldID dynamicRenderingFieldID = env->GetFieldID(cls, "dynamicRendering", "Z");
+    auto extensionAvailable = [&availableExtensions](const char *name)
+    {
+        return std::any_of(availableExtensions.begin(), availableExtensions.end(), [name](const VkExtensionProperties &extension)
+                           { return strcmp(extension.extensionName, name) == 0; });
+    };
+    bool dependenciesCore = devicesProperties[selectedDeviceNumber].apiVersion >= VK_API_VERSION_1_2;
+    bool dynamicRenderingExtensions = extensionAvailable(VK_KHR_DYNAMIC_RENDERING_EXTENSION_NAME) &&
+                                      (dependenciesCore || (extensionAvailable(VK_KHR_DEPTH_STENCIL_RESOLVE_EXTENSION_NAME) &&
+                                                            extensionAvailable(VK_KHR_CREATE_RENDERPASS_2_EXTENSION_NAME)));
+    dynamicRenderingSupported = false;
+    if (env->GetBooleanField(obj, dynamicRenderingFieldID) == JNI_TRUE && dynamicRenderingExtensions &&
+        instanceApiVersion >= VK_API_VERSION_1_1 && devicesProperties[selectedDeviceNumber].apiVersion >= VK_API_VERSION_1_1)
+    {
+        VkPhysicalDeviceDynamicRenderingFeaturesKHR dynamicRenderingFeatures{VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DYNAMIC_RENDERING_FEATURES_KHR};
+        VkPhysicalDeviceFeatures2 features{VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2};
+        features.pNext = &dynamicRenderingFeatures;
+        vkGetPhysicalDeviceFeatures2(physicalDevice, &features);
+        dynamicRenderingSupported = dynamicRenderingFeatures.dynamicRendering == VK_TRUE;
+    }
+    VkPhysicalDeviceDynamicRenderingFeaturesKHR enabledDynamicRenderingFeatures{VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DYNAMIC_RENDERING_FEATURES_KHR};
+    enabledDynamicRenderingFeatures.pNext = synchronization2Supported ? &enabledSynchronization2Features : enabledSynchronization2Features.pNext;
+    if (dynamicRenderingSupported)
+    {
+        enabledDynamicRenderingFeatures.dynamicRendering = VK_TRUE;
+        desiredDeviceLevelExtensions.push_back(VK_KHR_DYNAMIC_RENDERING_EXTENSION_NAME);
+        if (!dependenciesCore)
+        {
+            desiredDeviceLevelExtensions.push_back(VK_KHR_DEPTH_STENCIL_RESOLVE_EXTENSION_NAME);
+            desiredDeviceLevelExtensions.push_back(VK_KHR_CREATE_RENDERPASS_2_EXTENSION_NAME);
+        }
+    }
+
+    // The memory tracker reads the heap budgets through vkGetPhysicalDeviceMemoryProperties2
+    memoryBudgetSupported = extensionAvailable(VK_EXT_MEMORY_BUDGET_EXTENSION_NAME) &&
+                            instanceApiVersion >= VK_API_VERSION_1_1 && devicesProperties[selectedDeviceNumber].apiVersion >= VK_API_VERSION_1_1;
+    if (memoryBudgetSupported)
+    {
+        desiredDeviceLevelExtensions.push_back(VK_EXT_MEMORY_BUDGET_EXTENSION_NAME);
+    }
+
     VkDeviceCreateInfo deviceCreateInfo = {
         VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO,
-        nullptr,
+        dynamicRenderingSupported ? &enabledDynamicRenderingFeatures : enabledDynamicRenderingFeatures.pNext,
         0,
         static_cast<uint32_t>(queueCreateInfo.size()),
         queueCreateInfo.data(),
@@ -271,6 +591,9 @@ JNIEXPORT void JNICALL Java_com_github_nodedev74_jfbx_vulkan_VkHandler_createLog
 
     vkGetDeviceQueue(device, queueFamilyIndex, 0, &queue);
     volkLoadDevice(device);
+
+    jfieldID memoryBudgetFieldID = env->GetFieldID(cls, "memoryBudget", "J");
+    memoryTracker.create(physicalDevice, device, memoryBudgetSupported, static_cast<uint64_t>(std::max<jlong>(env->GetLongField(obj, memoryBudgetFieldID), 0)));
 }
 
 /**
@@ -281,6 +604,8 @@ JNIEXPORT void JNICALL Java_com_github_nodedev74_jfbx_vulkan_VkHandler_createLog
  */
 JNIEXPORT void JNICALL Java_com_github_nodedev74_jfbx_vulkan_VkHandler_createSwapchain(JNIEnv *env, jobject obj)
 {
+    TRACE_ZONE("VkHandler.createSwapchain");
+
     jclass cls = env->GetObjectClass(obj);
     jfieldID fieldID = env->GetFieldID(cls, "sdlWindowPtr", "J");
     jlong sdlWindowPtr = env->GetLongField(obj, fieldID);
@@ -349,6 +674,93 @@ JNIEXPORT void JNICALL Java_com_github_nodedev74_jfbx_vulkan_VkHandler_createSwa
     vkGetSwapchainImagesKHR(device, swapchain, &swapchainImagesCount, swapchainImages.data());
 }
 
+/**
+ * @brief Creates the offscreen images that replace the swapchain in headless mode.
+ *
+ * The images take the place of the swapchain images, so the render pass, framebuffers,
+ * pipeline and command buffers are built the same way as for a window.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ */
+JNIEXPORT void JNICALL Java_com_github_nodedev74_jfbx_vulkan_VkHandler_createOffscreenTargets(JNIEnv *env, jobject obj)
+{
+    TRACE_ZONE("VkHandler.createOffscreenTargets");
+
+    jclass cls = env->GetObjectClass(obj);
+    windowSize.width = static_cast<uint32_t>(env->GetIntField(obj, env->GetFieldID(cls, "width", "I")));
+    windowSize.height = static_cast<uint32_t>(env->GetIntField(obj, env->GetFieldID(cls, "height", "I")));
+    swapchainImagesCount = static_cast<uint32_t>(env->GetIntField(obj, env->GetFieldID(cls, "framesInFlight", "I")));
+
+    swapchainCreateInfo = {};
+    swapchainCreateInfo.imageFormat = VK_FORMAT_R8G8B8A8_UNORM;
+    swapchainCreateInfo.imageColorSpace = VK_COLOR_SPACE_SRGB_NONLINEAR_KHR;
+    swapchainCreateInfo.imageExtent = windowSize;
+    swapchainCreateInfo.imageArrayLayers = 1;
+    swapchainCreateInfo.imageUsage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT;
+
+    VkImageCreateInfo imageCreateInfo = {
+        VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO,
+        nullptr,
+        0,
+        VK_IMAGE_TYPE_2D,
+        swapchainCreateInfo.imageFormat,
+        {windowSize.width, windowSize.height, 1},
+        1,
+        1,
+        VK_SAMPLE_COUNT_1_BIT,
+        VK_IMAGE_TILING_OPTIMAL,
+        swapchainCreateInfo.imageUsage,
+        VK_SHARING_MODE_EXCLUSIVE,
+        0,
+        nullptr,
+        VK_IMAGE_LAYOUT_UNDEFINED,
+    };
+
+    swapchainImages.resize(swapchainImagesCount);
+    std::vector<VkDeviceSize> offsets(swapchainImagesCount);
+    VkMemoryRequirements imageMemoryRequirements{};
+    VkDeviceSize memorySize = 0;
+    for (uint32_t i = 0; i < swapchainImagesCount; i++)
+    {
+        VkResult result = vkCreateImage(device, &imageCreateInfo, nullptr, &swapchainImages[i]);
+        if (result != VK_SUCCESS)
+        {
+            jclass exceptionClass = env->FindClass("com/github/nodedev74/jfbx/exception/VkRuntimeError");
+            jmethodID constructorID = env->GetMethodID(exceptionClass, "<init>", "(Ljava/lang/String;)V");
+            jstring message = env->NewStringUTF("Failed to initialize offscreen VkImage");
+            jint jresult = static_cast<jint>(result);
+            jobject exceptionObject = env->NewObject(exceptionClass, constructorID, message, jresult);
+            env->Throw(static_cast<jthrowable>(exceptionObject));
+            return;
+        }
+
+        vkGetImageMemoryRequirements(device, swapchainImages[i], &imageMemoryRequirements);
+        memorySize = (memorySize + imageMemoryRequirements.alignment - 1) & ~(imageMemoryRequirements.alignment - 1);
+        offsets[i] = memorySize;
+        memorySize += imageMemoryRequirements.size;
+    }
+
+    imageMemoryRequirements.size = memorySize;
+    VkResult result = memoryTracker.allocate(imageMemoryRequirements, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, MemoryCategory::Target,
+                                             offscreenMemory);
+    if (result != VK_SUCCESS)
+    {
+        jclass exceptionClass = env->FindClass("com/github/nodedev74/jfbx/exception/VkRuntimeError");
+        jmethodID constructorID = env->GetMethodID(exceptionClass, "<init>", "(Ljava/lang/String;)V");
+        jstring message = env->NewStringUTF("Failed to allocate memory");
+        jint jresult = static_cast<jint>(result);
+        jobject exceptionObject = env->NewObject(exceptionClass, constructorID, message, jresult);
+        env->Throw(static_cast<jthrowable>(exceptionObject));
+        return;
+    }
+
+    for (uint32_t i = 0; i < swapchainImagesCount; i++)
+    {
+        vkBindImageMemory(device, swapchainImages[i], offscreenMemory, offsets[i]);
+    }
+}
+
 /**
  * @brief Creates a Vulkan command pool.
  *
@@ -357,10 +769,13 @@ JNIEXPORT void JNICALL Java_com_github_nodedev74_jfbx_vulkan_VkHandler_createSwa
  */
 JNIEXPORT void JNICALL Java_com_github_nodedev74_jfbx_vulkan_VkHandler_createCommandPool(JNIEnv *env, jobject obj)
 {
+    TRACE_ZONE("VkHandler.createCommandPool");
+
+    // Command buffers are recorded again whenever objects are drawn, so they have to be resettable
     VkCommandPoolCreateInfo commandPoolCreateInfo = {
         VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO,
         nullptr,
-        0,
+        VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT,
         queueFamilyIndex,
     };
 
@@ -384,6 +799,8 @@ JNIEXPORT void JNICALL Java_com_github_nodedev74_jfbx_vulkan_VkHandler_createCom
  */
 JNIEXPORT void JNICALL Java_com_github_nodedev74_jfbx_vulkan_VkHandler_allocateCommandBuffers(JNIEnv *env, jobject obj)
 {
+    TRACE_ZONE("VkHandler.allocateCommandBuffers");
+
     VkCommandBufferAllocateInfo commandBufferAllocateInfo = {
         VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO,
         nullptr,
@@ -406,6 +823,22 @@ JNIEXPORT void JNICALL Java_com_github_nodedev74_jfbx_vulkan_VkHandler_allocateC
     }
 }
 
+/**
+ * @brief Creates the GPU profiler with one query pool ring slot per command buffer.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ */
+JNIEXPORT void JNICALL Java_com_github_nodedev74_jfbx_vulkan_VkHandler_createProfiler(JNIEnv *env, jobject obj)
+{
+    TRACE_ZONE("VkHandler.createProfiler");
+
+    if (!profiler.create(device, physicalDevice, queueFamilyIndex, swapchainImagesCount, 16, pipelineStatisticsEnabled))
+    {
+        std::cout << "Timestamp queries are not supported by the queue family, GPU profiling is disabled" << std::endl;
+    }
+}
+
 /**
  * @brief Creates host buffers.
  *
@@ -414,6 +847,8 @@ JNIEXPORT void JNICALL Java_com_github_nodedev74_jfbx_vulkan_VkHandler_allocateC
  */
 JNIEXPORT void JNICALL Java_com_github_nodedev74_jfbx_vulkan_VkHandler_createHostBuffers(JNIEnv *env, jobject obj)
 {
+    TRACE_ZONE("VkHandler.createHostBuffers");
+
     VkBufferCreateInfo bufferCreateInfo = {
         VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO,
         nullptr,
@@ -427,20 +862,15 @@ JNIEXPORT void JNICALL Java_com_github_nodedev74_jfbx_vulkan_VkHandler_createHos
 
     vkCreateBuffer(device, &bufferCreateInfo, nullptr, &hostVertexBuffer);
 
-    bufferCreateInfo.size = sizeof(glm::mat4);
-    vkCreateBuffer(device, &bufferCreateInfo, nullptr, &hostMatrixBuffer);
-
-    vkGetBufferMemoryRequirements(device, hostVertexBuffer, &hostMemoryRequirements[0]);
-    vkGetBufferMemoryRequirements(device, hostMatrixBuffer, &hostMemoryRequirements[1]);
+    VkMemoryRequirements hostMemoryRequirements;
+    vkGetBufferMemoryRequirements(device, hostVertexBuffer, &hostMemoryRequirements);
 
-    VkMemoryAllocateInfo memoryAllocateInfo = {
-        VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO,
-        nullptr,
-        hostMemoryRequirements[0].size + hostMemoryRequirements[1].size,
-        VkHelper::selectMemoryIndex(physicalDeviceMemoryProperties, hostMemoryRequirements[0], VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT),
-    };
+    jclass cls = env->GetObjectClass(obj);
+    jfieldID fieldID = env->GetFieldID(cls, "matrixCapacity", "I");
+    matrixCapacity = std::max<jint>(env->GetIntField(obj, fieldID), 1);
 
-    VkResult result = vkAllocateMemory(device, &memoryAllocateInfo, nullptr, &hostMemory);
+    VkResult result = memoryTracker.allocate(hostMemoryRequirements, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+                                             VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, MemoryCategory::Staging, hostMemory);
     if (result != VK_SUCCESS)
     {
         jclass exceptionClass = env->FindClass("com/github/nodedev74/jfbx/exception/VkRuntimeError");
@@ -449,15 +879,49 @@ JNIEXPORT void JNICALL Java_com_github_nodedev74_jfbx_vulkan_VkHandler_createHos
         jint jresult = static_cast<jint>(result);
         jobject exceptionObject = env->NewObject(exceptionClass, constructorID, message, jresult);
         env->Throw(static_cast<jthrowable>(exceptionObject));
+        return;
     }
 
     vkBindBufferMemory(device, hostVertexBuffer, hostMemory, 0);
-    vkBindBufferMemory(device, hostMatrixBuffer, hostMemory, hostMemoryRequirements[0].size);
-
     vkMapMemory(device, hostMemory, 0, VK_WHOLE_SIZE, 0, &hostDataPointer);
     memcpy(hostDataPointer, inputData.data(), inputData.size() * sizeof(decltype(inputData[0])));
     VkMappedMemoryRange mapped_memory_range = {VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE, nullptr, hostMemory, 0, VK_WHOLE_SIZE};
     vkFlushMappedMemoryRanges(device, 1, &mapped_memory_range);
+
+    // One persistently mapped ring holds the matrices of every frame in flight, the shaders read the
+    // region of a frame through a dynamic offset, so frames need neither a copy nor a barrier
+    matrixRingStride = (matrixCapacity * sizeof(glm::mat4) + minStorageBufferOffsetAlignment - 1) / minStorageBufferOffsetAlignment * minStorageBufferOffsetAlignment;
+    bufferCreateInfo.size = matrixRingStride * swapchainImagesCount;
+    bufferCreateInfo.usage = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT;
+    vkCreateBuffer(device, &bufferCreateInfo, nullptr, &matrixRingBuffer);
+
+    VkMemoryRequirements matrixMemoryRequirements;
+    vkGetBufferMemoryRequirements(device, matrixRingBuffer, &matrixMemoryRequirements);
+
+    // Device local host visible memory, where available, keeps the vertex shader reads off the bus
+    result = memoryTracker.allocate(matrixMemoryRequirements, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT | VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+                                    VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, MemoryCategory::Uniform, matrixRingMemory);
+    if (result != VK_SUCCESS)
+    {
+        jclass exceptionClass = env->FindClass("com/github/nodedev74/jfbx/exception/VkRuntimeError");
+        jmethodID constructorID = env->GetMethodID(exceptionClass, "<init>", "(Ljava/lang/String;)V");
+        jstring message = env->NewStringUTF("Failed to allocate memory");
+        jint jresult = static_cast<jint>(result);
+        jobject exceptionObject = env->NewObject(exceptionClass, constructorID, message, jresult);
+        env->Throw(static_cast<jthrowable>(exceptionObject));
+        return;
+    }
+
+    vkBindBufferMemory(device, matrixRingBuffer, matrixRingMemory, 0);
+
+    void *matrixRingPointer;
+    vkMapMemory(device, matrixRingMemory, 0, VK_WHOLE_SIZE, 0, &matrixRingPointer);
+    frameMatrixPointers.resize(swapchainImagesCount);
+    for (uint32_t i = 0; i < swapchainImagesCount; i++)
+    {
+        frameMatrixPointers[i] = reinterpret_cast<glm::mat4 *>(static_cast<char *>(matrixRingPointer) + i * matrixRingStride);
+        std::fill(frameMatrixPointers[i], frameMatrixPointers[i] + matrixCapacity, glm::mat4(1.0f));
+    }
 }
 
 /**
@@ -468,6 +932,8 @@ JNIEXPORT void JNICALL Java_com_github_nodedev74_jfbx_vulkan_VkHandler_createHos
  */
 JNIEXPORT void JNICALL Java_com_github_nodedev74_jfbx_vulkan_VkHandler_createDeviceBuffers(JNIEnv *env, jobject obj)
 {
+    TRACE_ZONE("VkHandler.createDeviceBuffers");
+
     VkBufferCreateInfo bufferCreateInfo = {
         VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO,
         nullptr,
@@ -481,21 +947,10 @@ JNIEXPORT void JNICALL Java_com_github_nodedev74_jfbx_vulkan_VkHandler_createDev
 
     vkCreateBuffer(device, &bufferCreateInfo, nullptr, &deviceVertexBuffer);
 
-    bufferCreateInfo.size = sizeof(glm::mat4);
-    bufferCreateInfo.usage = VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT;
-    vkCreateBuffer(device, &bufferCreateInfo, nullptr, &deviceMatrixBuffer);
-
-    vkGetBufferMemoryRequirements(device, deviceMatrixBuffer, &deviceMemoryRequirements[0]);
-    vkGetBufferMemoryRequirements(device, deviceVertexBuffer, &deviceMemoryRequirements[1]);
+    vkGetBufferMemoryRequirements(device, deviceVertexBuffer, &deviceMemoryRequirements);
 
-    VkMemoryAllocateInfo memoryAllocateInfo = {
-        VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO,
-        nullptr,
-        deviceMemoryRequirements[0].size + deviceMemoryRequirements[1].size,
-        selectMemoryIndex(physicalDeviceMemoryProperties, deviceMemoryRequirements[0], VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT),
-    };
-
-    VkResult result = vkAllocateMemory(device, &memoryAllocateInfo, nullptr, &deviceMemory);
+    VkResult result = memoryTracker.allocate(deviceMemoryRequirements, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, MemoryCategory::Vertex,
+                                             deviceMemory);
     if (result != VK_SUCCESS)
     {
         jclass exceptionClass = env->FindClass("com/github/nodedev74/jfbx/exception/VkRuntimeError");
@@ -504,22 +959,24 @@ JNIEXPORT void JNICALL Java_com_github_nodedev74_jfbx_vulkan_VkHandler_createDev
         jint jresult = static_cast<jint>(result);
         jobject exceptionObject = env->NewObject(exceptionClass, constructorID, message, jresult);
         env->Throw(static_cast<jthrowable>(exceptionObject));
+        return;
     }
 
     vkBindBufferMemory(device, deviceVertexBuffer, deviceMemory, 0);
-    vkBindBufferMemory(device, deviceMatrixBuffer, deviceMemory, deviceMemoryRequirements[0].size);
 }
 
 /**
- * @brief Creates Descriptor pool
+ * @brief Creates Descriptor pool and the layout of the matrix set.
  *
  * @param env The JNI environment.
  * @param obj The Java object instance.
  */
 JNIEXPORT void JNICALL Java_com_github_nodedev74_jfbx_vulkan_VkHandler_createDescriptorPool(JNIEnv *env, jobject obj)
 {
+    TRACE_ZONE("VkHandler.createDescriptorPool");
+
     VkDescriptorPoolSize descriptorPoolSize = {
-        VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
+        VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC,
         1,
     };
 
@@ -533,19 +990,10 @@ JNIEXPORT void JNICALL Java_com_github_nodedev74_jfbx_vulkan_VkHandler_createDes
     };
 
     vkCreateDescriptorPool(device, &descriptorPoolCreateInfo, nullptr, &descriptorPool);
-}
 
-/**
- * @brief Allocates Descriptor Sets.
- *
- * @param env The JNI environment.
- * @param obj The Java object instance.
- */
-JNIEXPORT void JNICALL Java_com_github_nodedev74_jfbx_vulkan_VkHandler_allocateDescriptorSets(JNIEnv *env, jobject obj)
-{
     VkDescriptorSetLayoutBinding descriptorSetLayoutBinding = {
         0,
-        VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
+        VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC,
         1,
         VK_SHADER_STAGE_VERTEX_BIT,
         nullptr,
@@ -560,6 +1008,17 @@ JNIEXPORT void JNICALL Java_com_github_nodedev74_jfbx_vulkan_VkHandler_allocateD
     };
 
     vkCreateDescriptorSetLayout(device, &descriptorSetLayoutCreateInfo, nullptr, &descriptorSetLayout);
+}
+
+/**
+ * @brief Allocates Descriptor Sets.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ */
+JNIEXPORT void JNICALL Java_com_github_nodedev74_jfbx_vulkan_VkHandler_allocateDescriptorSets(JNIEnv *env, jobject obj)
+{
+    TRACE_ZONE("VkHandler.allocateDescriptorSets");
 
     VkDescriptorSetAllocateInfo descriptorSetAllocateInfo = {
         VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO,
@@ -571,10 +1030,11 @@ JNIEXPORT void JNICALL Java_com_github_nodedev74_jfbx_vulkan_VkHandler_allocateD
 
     vkAllocateDescriptorSets(device, &descriptorSetAllocateInfo, &descriptorSet);
 
+    // The range covers one frame, the dynamic offset of a bind selects the frame
     VkDescriptorBufferInfo descriptorBufferInfo = {
-        deviceMatrixBuffer,
+        matrixRingBuffer,
         0,
-        sizeof(glm::mat4),
+        matrixCapacity * sizeof(glm::mat4),
     };
 
     VkWriteDescriptorSet writeDescriptorSet = {
@@ -584,7 +1044,7 @@ JNIEXPORT void JNICALL Java_com_github_nodedev74_jfbx_vulkan_VkHandler_allocateD
         0,
         0,
         1,
-        VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
+        VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC,
         nullptr,
         &descriptorBufferInfo,
         nullptr,
@@ -594,13 +1054,21 @@ JNIEXPORT void JNICALL Java_com_github_nodedev74_jfbx_vulkan_VkHandler_allocateD
 }
 
 /**
- * @brief Creates a Vulkan Renderpass.
+ * @brief Creates a Vulkan Renderpass. With dynamic rendering no render pass object is needed.
  *
  * @param env The JNI environment.
  * @param obj The Java object instance.
  */
 JNIEXPORT void JNICALL Java_com_github_nodedev74_jfbx_vulkan_VkHandler_createRenderpass(JNIEnv *env, jobject obj)
 {
+    TRACE_ZONE("VkHandler.createRenderpass");
+
+    if (dynamicRenderingSupported)
+    {
+        renderPass = VK_NULL_HANDLE;
+        return;
+    }
+
     VkAttachmentDescription attachmentDescription = {
         0,
         swapchainCreateInfo.imageFormat,
@@ -609,15 +1077,34 @@ JNIEXPORT void JNICALL Java_com_github_nodedev74_jfbx_vulkan_VkHandler_createRen
         VK_ATTACHMENT_STORE_OP_STORE,
         VK_ATTACHMENT_LOAD_OP_DONT_CARE,
         VK_ATTACHMENT_STORE_OP_DONT_CARE,
-        VK_IMAGE_LAYOUT_PRESENT_SRC_KHR,
-        VK_IMAGE_LAYOUT_PRESENT_SRC_KHR,
+        VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
+        VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
+    };
+
+    // Depth is stored for the occlusion pyramid built after the render pass, the render graph transitions both attachments
+    VkAttachmentDescription depthAttachmentDescription = {
+        0,
+        depthFormat,
+        VK_SAMPLE_COUNT_1_BIT,
+        VK_ATTACHMENT_LOAD_OP_CLEAR,
+        VK_ATTACHMENT_STORE_OP_STORE,
+        VK_ATTACHMENT_LOAD_OP_DONT_CARE,
+        VK_ATTACHMENT_STORE_OP_DONT_CARE,
+        VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL,
+        VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL,
     };
+    VkAttachmentDescription attachmentDescriptions[] = {attachmentDescription, depthAttachmentDescription};
 
     VkAttachmentReference attachmentReference = {
         0,
         VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
     };
 
+    VkAttachmentReference depthAttachmentReference = {
+        1,
+        VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL,
+    };
+
     VkSubpassDescription subpassDescription = {
         0,
         VK_PIPELINE_BIND_POINT_GRAPHICS,
@@ -626,7 +1113,7 @@ JNIEXPORT void JNICALL Java_com_github_nodedev74_jfbx_vulkan_VkHandler_createRen
         1,
         &attachmentReference,
         nullptr,
-        nullptr,
+        &depthAttachmentReference,
         0,
         nullptr,
     };
@@ -635,8 +1122,8 @@ JNIEXPORT void JNICALL Java_com_github_nodedev74_jfbx_vulkan_VkHandler_createRen
         VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO,
         nullptr,
         0,
-        1,
-        &attachmentDescription,
+        2,
+        attachmentDescriptions,
         1,
         &subpassDescription,
         0,
@@ -647,17 +1134,14 @@ JNIEXPORT void JNICALL Java_com_github_nodedev74_jfbx_vulkan_VkHandler_createRen
 }
 
 /**
- * @brief Creates Vulkan Framebuffers.
- *
- * @param env The JNI environment.
- * @param obj The Java object instance.
+ * @brief Creates the views of the color images and, without dynamic rendering, one framebuffer per image.
  */
-JNIEXPORT void JNICALL Java_com_github_nodedev74_jfbx_vulkan_VkHandler_createFramebuffers(JNIEnv *env, jobject obj)
+void createAttachmentViews()
 {
-    framebuffers.resize(swapchainImagesCount);
+    framebuffers.assign(dynamicRenderingSupported ? 0 : swapchainImagesCount, VK_NULL_HANDLE);
     swapchainImagesViews.resize(swapchainImagesCount);
 
-    for (int i = 0; i < swapchainImagesCount; i++)
+    for (uint32_t i = 0; i < swapchainImagesCount; i++)
     {
         VkImageViewCreateInfo imageViewCreateInfo = {
             VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO,
@@ -671,14 +1155,19 @@ JNIEXPORT void JNICALL Java_com_github_nodedev74_jfbx_vulkan_VkHandler_createFra
         };
 
         vkCreateImageView(device, &imageViewCreateInfo, nullptr, &swapchainImagesViews[i]);
+        if (dynamicRenderingSupported)
+        {
+            continue;
+        }
 
+        VkImageView attachments[] = {swapchainImagesViews[i], renderGraph.getImageView(depthResource)};
         VkFramebufferCreateInfo framebufferCreateInfo = {
             VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO,
             nullptr,
             0,
             renderPass,
-            1,
-            &swapchainImagesViews[i],
+            2,
+            attachments,
             swapchainCreateInfo.imageExtent.width,
             swapchainCreateInfo.imageExtent.height,
             swapchainCreateInfo.imageArrayLayers,
@@ -689,42 +1178,59 @@ JNIEXPORT void JNICALL Java_com_github_nodedev74_jfbx_vulkan_VkHandler_createFra
 }
 
 /**
- * @brief Reads SPIRV files.
- *
- * @param filePath Path to the shader file (temporary file).
- * @return The files content.
+ * @brief Destroys the framebuffers and the views of the color images.
  */
-std::vector<uint32_t> readSPIRVFile(const std::string &filePath)
+void destroyAttachmentViews()
 {
-    std::ifstream file(filePath, std::ios::binary | std::ios::ate);
-
-    std::streamsize fileSize = file.tellg();
-    file.seekg(0, std::ios::beg);
+    for (VkFramebuffer framebuffer : framebuffers)
+    {
+        vkDestroyFramebuffer(device, framebuffer, nullptr);
+    }
+    for (VkImageView imageView : swapchainImagesViews)
+    {
+        vkDestroyImageView(device, imageView, nullptr);
+    }
+    framebuffers.clear();
+    swapchainImagesViews.clear();
+}
 
-    std::vector<uint32_t> spirvCode(fileSize / sizeof(uint32_t));
-    file.read(reinterpret_cast<char *>(spirvCode.data()), fileSize);
+/**
+ * @brief Creates Vulkan Framebuffers.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ */
+JNIEXPORT void JNICALL Java_com_github_nodedev74_jfbx_vulkan_VkHandler_createFramebuffers(JNIEnv *env, jobject obj)
+{
+    TRACE_ZONE("VkHandler.createFramebuffers");
 
-    return spirvCode;
+    createAttachmentViews();
 }
 
 /**
  * @brief Loads shader modules.
  *
- * @param path Internal path to the shader file.
+ * @param name Internal name of the shader file.
  * @param env The JNI environment.
  * @param obj The Java object instance.
  * @return VkShaderModule The shader module to be loaded from graphics pipeline.
  */
 VkShaderModule loadShaderModule(const char *name, JNIEnv *env, jobject obj)
 {
+    TRACE_ZONE("loadShaderModule");
+
     jclass cls = env->FindClass("com/github/nodedev74/jfbx/ShaderLoader");
-    jmethodID methodID = env->GetStaticMethodID(cls, "load", "(Ljava/lang/String;)Ljava/lang/String;");
+    jmethodID methodID = env->GetStaticMethodID(cls, "read", "(Ljava/lang/String;)[B");
     jstring shaderName = env->NewStringUTF(name);
-    jstring newPath = (jstring)env->CallStaticObjectMethod(cls, methodID, shaderName);
+    jbyteArray code = (jbyteArray)env->CallStaticObjectMethod(cls, methodID, shaderName);
+    if (code == nullptr || env->ExceptionCheck())
+    {
+        return VK_NULL_HANDLE;
+    }
 
-    const char *nativeString = env->GetStringUTFChars(newPath, nullptr);
-    const std::string spath(nativeString);
-    std::vector<uint32_t> spirv = readSPIRVFile(spath);
+    jsize codeSize = env->GetArrayLength(code);
+    std::vector<uint32_t> spirv(codeSize / sizeof(uint32_t));
+    env->GetByteArrayRegion(code, 0, static_cast<jsize>(spirv.size() * sizeof(uint32_t)), reinterpret_cast<jbyte *>(spirv.data()));
 
     VkShaderModuleCreateInfo moduleInfo{VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO};
     moduleInfo.codeSize = spirv.size() * sizeof(uint32_t);
@@ -736,6 +1242,41 @@ VkShaderModule loadShaderModule(const char *name, JNIEnv *env, jobject obj)
     return shaderModule;
 }
 
+/**
+ * @brief Reads the SPIR-V shaders and creates their shader modules.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ */
+JNIEXPORT void JNICALL Java_com_github_nodedev74_jfbx_vulkan_VkHandler_loadShaders(JNIEnv *env, jobject obj)
+{
+    TRACE_ZONE("VkHandler.loadShaders");
+
+    vertShader = loadShaderModule("vert", env, obj);
+    fragShader = loadShaderModule("frag", env, obj);
+    skinShader = loadShaderModule("skin", env, obj);
+    meshVertShader = loadShaderModule("mesh", env, obj);
+    hizShader = loadShaderModule("hiz", env, obj);
+    occlusionShader = loadShaderModule("occlusion", env, obj);
+    materialShader = loadShaderModule("material", env, obj);
+    // The bindless shader declares capabilities that only devices with descriptor indexing enable
+    bindlessShader = descriptorIndexingSupported ? loadShaderModule("bindless", env, obj) : VK_NULL_HANDLE;
+    if (vertShader == VK_NULL_HANDLE || fragShader == VK_NULL_HANDLE || skinShader == VK_NULL_HANDLE || meshVertShader == VK_NULL_HANDLE ||
+        hizShader == VK_NULL_HANDLE || occlusionShader == VK_NULL_HANDLE || materialShader == VK_NULL_HANDLE ||
+        (descriptorIndexingSupported && bindlessShader == VK_NULL_HANDLE))
+    {
+        if (env->ExceptionCheck())
+        {
+            return;
+        }
+        jclass exceptionClass = env->FindClass("com/github/nodedev74/jfbx/exception/VkRuntimeError");
+        jmethodID constructorID = env->GetMethodID(exceptionClass, "<init>", "(Ljava/lang/String;)V");
+        jstring message = env->NewStringUTF("Failed to initialize VkShaderModule");
+        jobject exceptionObject = env->NewObject(exceptionClass, constructorID, message);
+        env->Throw(static_cast<jthrowable>(exceptionObject));
+    }
+}
+
 /**
  * @brief Creates a Vulkan graphics pipeline.
  *
@@ -744,8 +1285,20 @@ VkShaderModule loadShaderModule(const char *name, JNIEnv *env, jobject obj)
  */
 JNIEXPORT void JNICALL Java_com_github_nodedev74_jfbx_vulkan_VkHandler_createPipeline(JNIEnv *env, jobject obj)
 {
-    VkShaderModule vertShader = loadShaderModule("vert", env, obj);
-    VkShaderModule fragShader = loadShaderModule("frag", env, obj);
+    TRACE_ZONE("VkHandler.createPipeline");
+
+    // The shader modules are only needed while the pipelines are created, so every exit path destroys them
+    struct ShaderModuleRelease
+    {
+        ~ShaderModuleRelease()
+        {
+            for (VkShaderModule *module : {&vertShader, &fragShader, &meshVertShader, &materialShader, &bindlessShader})
+            {
+                vkDestroyShaderModule(device, *module, nullptr);
+                *module = VK_NULL_HANDLE;
+            }
+        }
+    } shaderModuleRelease;
 
     VkPipelineShaderStageCreateInfo vertexShaderStageInfo{};
     vertexShaderStageInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
@@ -769,9 +1322,7 @@ JNIEXPORT void JNICALL Java_com_github_nodedev74_jfbx_vulkan_VkHandler_createPip
     inputAssembly.topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
     inputAssembly.primitiveRestartEnable = VK_FALSE;
 
-    VkSurfaceCapabilitiesKHR capabilities;
-    vkGetPhysicalDeviceSurfaceCapabilitiesKHR(physicalDevice, surface, &capabilities);
-    VkExtent2D swapchainExtent = capabilities.currentExtent;
+    VkExtent2D swapchainExtent = swapchainCreateInfo.imageExtent;
 
     VkViewport viewport{};
     viewport.x = 0.0f;
@@ -807,6 +1358,12 @@ JNIEXPORT void JNICALL Java_com_github_nodedev74_jfbx_vulkan_VkHandler_createPip
     multisampling.sampleShadingEnable = VK_FALSE;
     multisampling.rasterizationSamples = VK_SAMPLE_COUNT_1_BIT;
 
+    VkPipelineDepthStencilStateCreateInfo depthStencil{};
+    depthStencil.sType = VK_STRUCTURE_TYPE_PIPELINE_DEPTH_STENCIL_STATE_CREATE_INFO;
+    depthStencil.depthTestEnable = VK_TRUE;
+    depthStencil.depthWriteEnable = VK_TRUE;
+    depthStencil.depthCompareOp = VK_COMPARE_OP_LESS;
+
     VkPipelineColorBlendAttachmentState colorBlendAttachment{};
     colorBlendAttachment.colorWriteMask = VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT | VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT;
     colorBlendAttachment.blendEnable = VK_FALSE;
@@ -818,21 +1375,6 @@ JNIEXPORT void JNICALL Java_com_github_nodedev74_jfbx_vulkan_VkHandler_createPip
     colorBlending.attachmentCount = 1;
     colorBlending.pAttachments = &colorBlendAttachment;
 
-    VkDescriptorSetLayoutBinding uboLayoutBinding{};
-    uboLayoutBinding.binding = 0;
-    uboLayoutBinding.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
-    uboLayoutBinding.descriptorCount = 1;
-    uboLayoutBinding.stageFlags = VK_SHADER_STAGE_VERTEX_BIT;
-    uboLayoutBinding.pImmutableSamplers = nullptr;
-
-    VkDescriptorSetLayoutCreateInfo layoutCreateInfo{};
-    layoutCreateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
-    layoutCreateInfo.bindingCount = 1;
-    layoutCreateInfo.pBindings = &uboLayoutBinding;
-
-    VkDescriptorSetLayout descriptorSetLayout;
-    vkCreateDescriptorSetLayout(device, &layoutCreateInfo, nullptr, &descriptorSetLayout);
-
     VkPipelineLayoutCreateInfo pipelineLayoutInfo{};
     pipelineLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
     pipelineLayoutInfo.setLayoutCount = 1;
@@ -859,12 +1401,21 @@ JNIEXPORT void JNICALL Java_com_github_nodedev74_jfbx_vulkan_VkHandler_createPip
     pipelineInfo.pViewportState = &viewportState;
     pipelineInfo.pRasterizationState = &rasterizer;
     pipelineInfo.pMultisampleState = &multisampling;
+    pipelineInfo.pDepthStencilState = &depthStencil;
     pipelineInfo.pColorBlendState = &colorBlending;
     pipelineInfo.layout = pipelineLayout;
     pipelineInfo.renderPass = renderPass;
     pipelineInfo.subpass = 0;
 
+    // Without a render pass the pipelines declare the formats of the attachments they render to
+    VkPipelineRenderingCreateInfoKHR renderingInfo{VK_STRUCTURE_TYPE_PIPELINE_RENDERING_CREATE_INFO_KHR};
+    renderingInfo.colorAttachmentCount = 1;
+    renderingInfo.pColorAttachmentFormats = &swapchainCreateInfo.imageFormat;
+    renderingInfo.depthAttachmentFormat = depthFormat;
+    pipelineInfo.pNext = dynamicRenderingSupported ? &renderingInfo : nullptr;
+
     VkResult a_result = vkCreateGraphicsPipelines(device, VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &pipeline);
+    pipelineCreateCount++;
     if (a_result != VK_SUCCESS)
     {
         jclass exceptionClass = env->FindClass("com/github/nodedev74/jfbx/exception/VkRuntimeError");
@@ -876,18 +1427,246 @@ JNIEXPORT void JNICALL Java_com_github_nodedev74_jfbx_vulkan_VkHandler_createPip
         return;
     }
 
-    vkDestroyShaderModule(device, vertShader, nullptr);
-    vkDestroyShaderModule(device, fragShader, nullptr);
+    // Objects use a second pipeline that reads positions and places them with their world matrix
+    VkPipelineShaderStageCreateInfo meshShaderStages[] = {vertexShaderStageInfo, fragmentShaderStageInfo};
+    meshShaderStages[0].module = meshVertShader;
+    meshShaderStages[1].module = materialShader;
+
+    VkVertexInputBindingDescription vertexBinding = {0, 3 * sizeof(float), VK_VERTEX_INPUT_RATE_VERTEX};
+    VkVertexInputAttributeDescription positionAttribute = {0, 0, VK_FORMAT_R32G32B32_SFLOAT, 0};
+
+    VkPipelineVertexInputStateCreateInfo meshVertexInputInfo{};
+    meshVertexInputInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
+    meshVertexInputInfo.vertexBindingDescriptionCount = 1;
+    meshVertexInputInfo.pVertexBindingDescriptions = &vertexBinding;
+    meshVertexInputInfo.vertexAttributeDescriptionCount = 1;
+    meshVertexInputInfo.pVertexAttributeDescriptions = &positionAttribute;
+
+    VkPushConstantRange pushConstantRange = {VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(MeshPushConstants)};
+    VkDescriptorSetLayout meshSetLayouts[] = {descriptorSetLayout, meshArena.getSetLayout(), bindless.getMaterialSetLayout()};
+    pipelineLayoutInfo.setLayoutCount = 3;
+    pipelineLayoutInfo.pSetLayouts = meshSetLayouts;
+    pipelineLayoutInfo.pushConstantRangeCount = 1;
+    pipelineLayoutInfo.pPushConstantRanges = &pushConstantRange;
+
+    result = vkCreatePipelineLayout(device, &pipelineLayoutInfo, nullptr, &materialPipelineLayout);
+    if (result != VK_SUCCESS)
+    {
+        jclass exceptionClass = env->FindClass("com/github/nodedev74/jfbx/exception/VkRuntimeError");
+        jmethodID constructorID = env->GetMethodID(exceptionClass, "<init>", "(Ljava/lang/String;)V");
+        jstring message = env->NewStringUTF("Failed to initializate VkPipelineLayout");
+        jint jresult = static_cast<jint>(result);
+        jobject exceptionObject = env->NewObject(exceptionClass, constructorID, message, jresult);
+        env->Throw(static_cast<jthrowable>(exceptionObject));
+        return;
+    }
+
+    // FBX meshes mix windings, so both sides are drawn
+    rasterizer.cullMode = VK_CULL_MODE_NONE;
+    pipelineInfo.pStages = meshShaderStages;
+    pipelineInfo.pVertexInputState = &meshVertexInputInfo;
+    pipelineInfo.layout = materialPipelineLayout;
+
+    result = vkCreateGraphicsPipelines(device, VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &materialPipeline);
+    pipelineCreateCount++;
+    // Skinned objects read the four floats per vertex of the skinning output
+    if (result == VK_SUCCESS)
+    {
+        vertexBinding.stride = 4 * sizeof(float);
+        result = vkCreateGraphicsPipelines(device, VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &skinnedMaterialPipeline);
+        pipelineCreateCount++;
+        vertexBinding.stride = 3 * sizeof(float);
+    }
+    if (result != VK_SUCCESS)
+    {
+        jclass exceptionClass = env->FindClass("com/github/nodedev74/jfbx/exception/VkRuntimeError");
+        jmethodID constructorID = env->GetMethodID(exceptionClass, "<init>", "(Ljava/lang/String;)V");
+        jstring message = env->NewStringUTF("Failed to initializate VkPipeline");
+        jint jresult = static_cast<jint>(result);
+        jobject exceptionObject = env->NewObject(exceptionClass, constructorID, message, jresult);
+        env->Throw(static_cast<jthrowable>(exceptionObject));
+        return;
+    }
+
+    // With descriptor indexing the mesh pipeline reads every material through the bindless set
+    if (descriptorIndexingSupported)
+    {
+        meshShaderStages[1].module = bindlessShader;
+        meshSetLayouts[2] = bindless.getSetLayout();
+        result = vkCreatePipelineLayout(device, &pipelineLayoutInfo, nullptr, &meshPipelineLayout);
+        pipelineInfo.layout = meshPipelineLayout;
+        if (result == VK_SUCCESS)
+        {
+            result = vkCreateGraphicsPipelines(device, VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &meshPipeline);
+            pipelineCreateCount++;
+        }
+        if (result == VK_SUCCESS)
+        {
+            vertexBinding.stride = 4 * sizeof(float);
+            result = vkCreateGraphicsPipelines(device, VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &skinnedMeshPipeline);
+            pipelineCreateCount++;
+        }
+        if (result != VK_SUCCESS)
+        {
+            jclass exceptionClass = env->FindClass("com/github/nodedev74/jfbx/exception/VkRuntimeError");
+            jmethodID constructorID = env->GetMethodID(exceptionClass, "<init>", "(Ljava/lang/String;)V");
+            jstring message = env->NewStringUTF("Failed to initializate bindless VkPipeline");
+            jint jresult = static_cast<jint>(result);
+            jobject exceptionObject = env->NewObject(exceptionClass, constructorID, message, jresult);
+            env->Throw(static_cast<jthrowable>(exceptionObject));
+            return;
+        }
+    }
 }
 
 /**
- * @brief Uploads the input data.
+ * @brief Creates the skinning buffers and compute pipeline.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ */
+JNIEXPORT void JNICALL Java_com_github_nodedev74_jfbx_vulkan_VkHandler_createSkinning(JNIEnv *env, jobject obj)
+{
+    TRACE_ZONE("VkHandler.createSkinning");
+
+    jclass cls = env->GetObjectClass(obj);
+    jint vertexCapacity = env->GetIntField(obj, env->GetFieldID(cls, "skinVertexCapacity", "I"));
+    jint skinnedVertexCapacity = env->GetIntField(obj, env->GetFieldID(cls, "skinnedVertexCapacity", "I"));
+    jint jointCapacity = env->GetIntField(obj, env->GetFieldID(cls, "jointCapacity", "I"));
+    jint instanceCapacity = env->GetIntField(obj, env->GetFieldID(cls, "skinInstanceCapacity", "I"));
+
+    VkResult result = skinning.create(device, memoryTracker, skinShader, swapchainImagesCount, vertexCapacity,
+                                      skinnedVertexCapacity, jointCapacity, instanceCapacity);
+    vkDestroyShaderModule(device, skinShader, nullptr);
+    if (result != VK_SUCCESS)
+    {
+        jclass exceptionClass = env->FindClass("com/github/nodedev74/jfbx/exception/VkRuntimeError");
+        jmethodID constructorID = env->GetMethodID(exceptionClass, "<init>", "(Ljava/lang/String;)V");
+        jstring message = env->NewStringUTF("Failed to initialize skinning");
+        jint jresult = static_cast<jint>(result);
+        jobject exceptionObject = env->NewObject(exceptionClass, constructorID, message, jresult);
+        env->Throw(static_cast<jthrowable>(exceptionObject));
+    }
+}
+
+/**
+ * @brief Creates the shared vertex and index arenas and the per frame draw lists.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ */
+JNIEXPORT void JNICALL Java_com_github_nodedev74_jfbx_vulkan_VkHandler_createMeshArena(JNIEnv *env, jobject obj)
+{
+    TRACE_ZONE("VkHandler.createMeshArena");
+
+    jclass cls = env->GetObjectClass(obj);
+    jint vertexCapacity = env->GetIntField(obj, env->GetFieldID(cls, "meshVertexCapacity", "I"));
+    jint indexCapacity = env->GetIntField(obj, env->GetFieldID(cls, "meshIndexCapacity", "I"));
+    jint objectCapacity = env->GetIntField(obj, env->GetFieldID(cls, "objectCapacity", "I"));
+
+    VkResult result = meshArena.create(device, memoryTracker, swapchainImagesCount, static_cast<uint32_t>(std::max<jint>(vertexCapacity, 1)),
+                                       static_cast<uint32_t>(std::max<jint>(indexCapacity, 1)), static_cast<uint32_t>(std::max<jint>(objectCapacity, 1)));
+    if (result != VK_SUCCESS)
+    {
+        jclass exceptionClass = env->FindClass("com/github/nodedev74/jfbx/exception/VkRuntimeError");
+        jmethodID constructorID = env->GetMethodID(exceptionClass, "<init>", "(Ljava/lang/String;)V");
+        jstring message = env->NewStringUTF("Failed to initialize mesh arena");
+        jint jresult = static_cast<jint>(result);
+        jobject exceptionObject = env->NewObject(exceptionClass, constructorID, message, jresult);
+        env->Throw(static_cast<jthrowable>(exceptionObject));
+    }
+}
+
+/**
+ * @brief Creates the material table, the default texture and the bindless or per material descriptor sets.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ */
+JNIEXPORT void JNICALL Java_com_github_nodedev74_jfbx_vulkan_VkHandler_createBindless(JNIEnv *env, jobject obj)
+{
+    TRACE_ZONE("VkHandler.createBindless");
+
+    jclass cls = env->GetObjectClass(obj);
+    uint32_t textureCapacity = static_cast<uint32_t>(std::max<jint>(env->GetIntField(obj, env->GetFieldID(cls, "textureCapacity", "I")), 1));
+    uint32_t bufferCapacity = static_cast<uint32_t>(std::max<jint>(env->GetIntField(obj, env->GetFieldID(cls, "storageBufferCapacity", "I")), 1));
+    uint32_t materialCapacity = static_cast<uint32_t>(std::max<jint>(env->GetIntField(obj, env->GetFieldID(cls, "materialCapacity", "I")), 1));
+    if (descriptorIndexingSupported)
+    {
+        textureCapacity = std::min(textureCapacity, maxBindlessTextures);
+        bufferCapacity = std::min(bufferCapacity, maxBindlessBuffers);
+    }
+
+    VkResult result = bindless.create(device, memoryTracker, queue, commandPool, descriptorIndexingSupported, textureCapacity, bufferCapacity,
+                                      materialCapacity);
+    if (result != VK_SUCCESS)
+    {
+        jclass exceptionClass = env->FindClass("com/github/nodedev74/jfbx/exception/VkRuntimeError");
+        jmethodID constructorID = env->GetMethodID(exceptionClass, "<init>", "(Ljava/lang/String;)V");
+        jstring message = env->NewStringUTF("Failed to initialize bindless descriptors");
+        jint jresult = static_cast<jint>(result);
+        jobject exceptionObject = env->NewObject(exceptionClass, constructorID, message, jresult);
+        env->Throw(static_cast<jthrowable>(exceptionObject));
+        return;
+    }
+
+    // Streamed textures are the only resources that can shrink, meshes stay in their arena. The
+    // tracker calls back from update() in prepareFrame, before the frame is recorded
+    memoryTracker.addEvictionCallback(MemoryCategory::Texture, [](uint64_t bytes)
+                                      { return textureStreamer.evict(bindless, queue, commandPool, bytes); });
+}
+
+/**
+ * @brief Creates the occlusion pyramid, buffers and compute pipelines.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ */
+JNIEXPORT void JNICALL Java_com_github_nodedev74_jfbx_vulkan_VkHandler_createOcclusion(JNIEnv *env, jobject obj)
+{
+    TRACE_ZONE("VkHandler.createOcclusion");
+
+    jclass cls = env->GetObjectClass(obj);
+    jint candidateCapacity = env->GetIntField(obj, env->GetFieldID(cls, "objectCapacity", "I"));
+
+    // All frame slots reduce the same transient depth attachment
+    std::vector<VkImageView> depthViews(swapchainImagesCount, renderGraph.getImageView(depthResource));
+    std::vector<VkBuffer> instanceDrawBuffers;
+    std::vector<VkBuffer> instanceGroupBuffers;
+    for (uint32_t i = 0; i < swapchainImagesCount; i++)
+    {
+        instanceDrawBuffers.push_back(meshArena.getDrawBuffer(i));
+        instanceGroupBuffers.push_back(meshArena.getCommandBuffer(i));
+    }
+    VkResult result = occlusion.create(device, memoryTracker, hizShader, occlusionShader, depthViews, swapchainCreateInfo.imageExtent,
+                                       static_cast<uint32_t>(std::max<jint>(candidateCapacity, 1)), instanceDrawBuffers, instanceGroupBuffers);
+    vkDestroyShaderModule(device, hizShader, nullptr);
+    vkDestroyShaderModule(device, occlusionShader, nullptr);
+    if (result == VK_SUCCESS)
+    {
+        renderGraph.setImage(pyramidResource, 0, occlusion.getPyramid(), {VK_IMAGE_ASPECT_COLOR_BIT, 0, occlusion.getLevelCount(), 0, 1});
+    }
+    if (result != VK_SUCCESS)
+    {
+        jclass exceptionClass = env->FindClass("com/github/nodedev74/jfbx/exception/VkRuntimeError");
+        jmethodID constructorID = env->GetMethodID(exceptionClass, "<init>", "(Ljava/lang/String;)V");
+        jstring message = env->NewStringUTF("Failed to initialize occlusion culling");
+        jint jresult = static_cast<jint>(result);
+        jobject exceptionObject = env->NewObject(exceptionClass, constructorID, message, jresult);
+        env->Throw(static_cast<jthrowable>(exceptionObject));
+    }
+}
+
+/**
+ * @brief Uploads the input data.
  *
  * @param env The JNI environment.
  * @param obj The Java object instance.
  */
 JNIEXPORT void JNICALL Java_com_github_nodedev74_jfbx_vulkan_VkHandler_uploadInputData(JNIEnv *env, jobject obj)
 {
+    TRACE_ZONE("VkHandler.uploadInputData");
+
     VkCommandBufferBeginInfo commandBufferBeginInfo = {
         VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO,
         nullptr,
@@ -930,178 +1709,2700 @@ JNIEXPORT void JNICALL Java_com_github_nodedev74_jfbx_vulkan_VkHandler_uploadInp
 }
 
 /**
- * @brief Records the command buffers for Vulkan rendering.
+ * @brief Creates the pooled host visible readback buffers and their fences.
+ *
+ * Every offscreen slot owns a persistently mapped buffer and a fence, so several frames
+ * can be in flight while earlier ones are read back.
  *
  * @param env The JNI environment.
  * @param obj The Java object instance.
  */
-JNIEXPORT void JNICALL Java_com_github_nodedev74_jfbx_vulkan_VkHandler_recordCommandBuffers(JNIEnv *env, jobject obj)
+JNIEXPORT void JNICALL Java_com_github_nodedev74_jfbx_vulkan_VkHandler_createReadbackBuffers(JNIEnv *env, jobject obj)
 {
-    VkClearValue clearColor = {{0.0f, 0.0f, 0.0f, 1.0f}};
+    TRACE_ZONE("VkHandler.createReadbackBuffers");
 
-    for (int i = 0; i < swapchainImagesCount; i++)
-    {
-        VkCommandBufferBeginInfo commandBufferBeginInfo = {VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO, nullptr, VK_COMMAND_BUFFER_USAGE_SIMULTANEOUS_USE_BIT, nullptr};
-        vkBeginCommandBuffer(commandBuffers[i], &commandBufferBeginInfo);
+    readbackSize = static_cast<VkDeviceSize>(windowSize.width) * windowSize.height * 4;
 
-        VkBufferCopy bufferCopy = {0, 0, sizeof(glm::mat4)};
-        vkCmdCopyBuffer(commandBuffers[i], hostMatrixBuffer, deviceMatrixBuffer, 1, &bufferCopy);
+    readbackBuffers.resize(swapchainImagesCount);
+    readbackMemories.resize(swapchainImagesCount);
+    readbackDataPointers.resize(swapchainImagesCount);
+    readbackFences.resize(swapchainImagesCount);
 
-        VkMemoryBarrier memoryBarrier = {VK_STRUCTURE_TYPE_MEMORY_BARRIER, nullptr, VK_ACCESS_TRANSFER_WRITE_BIT, VK_ACCESS_UNIFORM_READ_BIT};
-        vkCmdPipelineBarrier(commandBuffers[i], VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_VERTEX_SHADER_BIT, 0, 1, &memoryBarrier, 0, nullptr, 0, nullptr);
+    VkBufferCreateInfo bufferCreateInfo = {
+        VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO,
+        nullptr,
+        0,
+        readbackSize,
+        VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+        VK_SHARING_MODE_EXCLUSIVE,
+        0,
+        nullptr,
+    };
 
-        VkImageMemoryBarrier imageMemoryBarrier = {
-            VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,
-            nullptr,
-            0,
-            VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT,
-            VK_IMAGE_LAYOUT_UNDEFINED,
-            VK_IMAGE_LAYOUT_PRESENT_SRC_KHR,
-            VK_QUEUE_FAMILY_IGNORED,
-            VK_QUEUE_FAMILY_IGNORED,
-            swapchainImages[i],
-            {VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1}};
-        vkCmdPipelineBarrier(commandBuffers[i], VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT, VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT, 0, 0, nullptr, 0, nullptr, 1, &imageMemoryBarrier);
+    VkFenceCreateInfo fenceCreateInfo = {
+        VK_STRUCTURE_TYPE_FENCE_CREATE_INFO,
+        nullptr,
+        VK_FENCE_CREATE_SIGNALED_BIT,
+    };
 
-        VkRenderPassBeginInfo renderPassBeginInfo = {
-            VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO,
-            nullptr,
-            renderPass,
-            framebuffers[i],
-            {{0, 0}, {swapchainCreateInfo.imageExtent}},
-            1,
-            &clearColor};
-        vkCmdBeginRenderPass(commandBuffers[i], &renderPassBeginInfo, VK_SUBPASS_CONTENTS_INLINE);
+    for (uint32_t i = 0; i < swapchainImagesCount; i++)
+    {
+        vkCreateBuffer(device, &bufferCreateInfo, nullptr, &readbackBuffers[i]);
+
+        VkMemoryRequirements memoryRequirements;
+        vkGetBufferMemoryRequirements(device, readbackBuffers[i], &memoryRequirements);
+
+        VkResult result = memoryTracker.allocate(memoryRequirements, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_CACHED_BIT,
+                                                 VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT, MemoryCategory::Staging, readbackMemories[i]);
+        if (result != VK_SUCCESS)
+        {
+            jclass exceptionClass = env->FindClass("com/github/nodedev74/jfbx/exception/VkRuntimeError");
+            jmethodID constructorID = env->GetMethodID(exceptionClass, "<init>", "(Ljava/lang/String;)V");
+            jstring message = env->NewStringUTF("Failed to allocate memory");
+            jint jresult = static_cast<jint>(result);
+            jobject exceptionObject = env->NewObject(exceptionClass, constructorID, message, jresult);
+            env->Throw(static_cast<jthrowable>(exceptionObject));
+            return;
+        }
+
+        vkBindBufferMemory(device, readbackBuffers[i], readbackMemories[i], 0);
+        vkMapMemory(device, readbackMemories[i], 0, VK_WHOLE_SIZE, 0, &readbackDataPointers[i]);
+        vkCreateFence(device, &fenceCreateInfo, nullptr, &readbackFences[i]);
+    }
+    nextOffscreenSlot = 0;
+}
 
-        vkCmdBindDescriptorSets(commandBuffers[i], VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayout, 0, 1, &descriptorSet, 0, nullptr);
+/**
+ * @brief Checks whether the objects of the next frames are tested for occlusion.
+ *
+ * @return True if occlusion culling is enabled and the device can draw its output.
+ */
+bool isOcclusionCullingActive()
+{
+    return occlusionCullingEnabled && drawIndirectFirstInstanceSupported;
+}
 
-        vkCmdBindPipeline(commandBuffers[i], VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline);
+/**
+ * @brief Checks whether the objects of the next frames are drawn with multi draw indirect.
+ *
+ * @return True if multi draw indirect is enabled and indirect draws can carry their draw index.
+ */
+bool isMultiDrawIndirectActive()
+{
+    return multiDrawIndirectEnabled && drawIndirectFirstInstanceSupported;
+}
 
-        VkDeviceSize offset = 0;
-        vkCmdBindVertexBuffers(commandBuffers[i], 0, 1, &deviceVertexBuffer, &offset);
+/**
+ * @brief Checks whether the visible objects of the next frames are drawn as one instanced draw per mesh.
+ *
+ * With occlusion culling the occlusion pass packs the instances that pass its test into the draws
+ * of their mesh, so the groups are drawn indirectly.
+ *
+ * @return True if instancing is enabled.
+ */
+bool isInstancingActive()
+{
+    return instancingEnabled;
+}
 
-        vkCmdDraw(commandBuffers[i], 3, 1, 0, 0);
+/**
+ * @brief Checks whether the materials of the next frames are read through the bindless set.
+ *
+ * @return True if bindless materials are enabled and the device supports descriptor indexing.
+ */
+bool isBindlessActive()
+{
+    return bindlessEnabled && descriptorIndexingSupported;
+}
 
-        vkCmdEndRenderPass(commandBuffers[i]);
+/**
+ * @brief Checks whether the occlusion pass compacts the visible draws for an indirect count draw.
+ *
+ * @return True if the list fits into a single indirect count draw, needs no material sets, whose
+ * batches rely on the draw order, and is not instanced, which packs instances instead.
+ */
+bool isDrawCompactionActive()
+{
+    return isMultiDrawIndirectActive() && isBindlessActive() && !isInstancingActive() && drawIndirectCountSupported && drawCount <= maxDrawIndirectCount;
+}
 
-        vkEndCommandBuffer(commandBuffers[i]);
+/**
+ * @brief Selects what the occlusion pass writes for the draw path of the next frames.
+ *
+ * @return Instances with instancing, otherwise compacted draws or a draw per object.
+ */
+OcclusionOutput getOcclusionOutput()
+{
+    if (isInstancingActive())
+    {
+        return OcclusionOutput::Instances;
     }
-    vkDestroyPipelineLayout(device, pipelineLayout, nullptr);
+    return isDrawCompactionActive() ? OcclusionOutput::CompactDraws : OcclusionOutput::Draws;
 }
 
 /**
- * @brief Creates semaphores for Vulkan synchronization.
+ * @brief Records indexed indirect draws of consecutive commands.
  *
- * @param env The JNI environment.
- * @param obj The Java object instance.
+ * @param commandBuffer The command buffer inside the render pass.
+ * @param buffer The buffer holding the commands.
+ * @param first The first command.
+ * @param count The number of commands.
+ * @param multiDraw False to record one draw per command.
  */
-JNIEXPORT void JNICALL Java_com_github_nodedev74_jfbx_vulkan_VkHandler_createSemaphores(JNIEnv *env, jobject obj)
+void recordIndirectDraws(VkCommandBuffer commandBuffer, VkBuffer buffer, uint32_t first, uint32_t count, bool multiDraw)
 {
-    VkSemaphoreCreateInfo semaphoreCreateInfo = {VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO, nullptr, 0};
-    semaphores.resize(2);
-    for (int i = 0; i < semaphores.size(); i++)
+    uint32_t stride = sizeof(VkDrawIndexedIndirectCommand);
+    uint32_t batchSize = multiDraw && multiDrawIndirectSupported ? maxDrawIndirectCount : 1;
+    for (uint32_t offset = 0; offset < count; offset += batchSize)
     {
-        vkCreateSemaphore(device, &semaphoreCreateInfo, nullptr, &semaphores[i]);
+        vkCmdDrawIndexedIndirect(commandBuffer, buffer, static_cast<VkDeviceSize>(first + offset) * stride, std::min(batchSize, count - offset), stride);
     }
 }
 
 /**
- * @brief Renders the Vulkan scene.
+ * @brief Records a range of the draw commands of a frame.
  *
- * @param env The JNI environment.
- * @param obj The Java object instance.
+ * With multi draw indirect the range is drawn by a single indirect draw, from the commands of the
+ * occlusion pass when occlusion culling is enabled and from the host written commands otherwise.
+ * Instanced groups tested for occlusion are drawn from the host written commands whose instance
+ * counts the occlusion pass filled in. The per draw path records one draw per object, or one
+ * instanced draw per mesh.
+ *
+ * @param commandBuffer The command buffer inside the render pass.
+ * @param frame The frame slot.
+ * @param first The first command.
+ * @param count The number of commands.
  */
-JNIEXPORT void JNICALL Java_com_github_nodedev74_jfbx_vulkan_VkHandler_render(JNIEnv *env, jobject obj)
+void recordDrawRange(VkCommandBuffer commandBuffer, uint32_t frame, uint32_t first, uint32_t count)
 {
-
-    jclass cls = env->GetObjectClass(obj);
-
-    uint32_t imageIndex = 0;
-    VkResult res = vkAcquireNextImageKHR(device, swapchain, UINT64_MAX, semaphores[0], VK_NULL_HANDLE, &imageIndex);
-    if (res != VK_SUCCESS)
+    bool multiDraw = isMultiDrawIndirectActive();
+    if (isOcclusionCullingActive())
     {
-        jclass exceptionClass = env->FindClass("com/github/nodedev74/jfbx/exception/VkRuntimeError");
-        jmethodID constructorID = env->GetMethodID(exceptionClass, "<init>", "(Ljava/lang/String;)V");
-        jstring message = env->NewStringUTF("unknown");
-        jint jresult = static_cast<jint>(res);
-        jobject exceptionObject = env->NewObject(exceptionClass, constructorID, message, jresult);
-        env->Throw(static_cast<jthrowable>(exceptionObject));
+        if (isInstancingActive())
+        {
+            recordIndirectDraws(commandBuffer, meshArena.getCommandBuffer(frame), first, count, multiDraw);
+        }
+        else if (isDrawCompactionActive())
+        {
+            vkCmdDrawIndexedIndirectCountKHR(commandBuffer, occlusion.getDrawBuffer(frame), 0, occlusion.getCounterBuffer(frame), sizeof(uint32_t), drawCount,
+                                             sizeof(VkDrawIndexedIndirectCommand));
+        }
+        else
+        {
+            recordIndirectDraws(commandBuffer, occlusion.getDrawBuffer(frame), first, count, multiDraw);
+        }
+    }
+    else if (multiDraw)
+    {
+        recordIndirectDraws(commandBuffer, meshArena.getCommandBuffer(frame), first, count, true);
+    }
+    else if (isInstancingActive())
+    {
+        for (uint32_t i = first; i < first + count; i++)
+        {
+            const VkDrawIndexedIndirectCommand &group = instanceGroups[i];
+            vkCmdDrawIndexed(commandBuffer, group.indexCount, group.instanceCount, group.firstIndex, group.vertexOffset, group.firstInstance);
+        }
+    }
+    else
+    {
+        for (uint32_t i = first; i < first + count; i++)
+        {
+            const MeshRange &range = meshes[objectMeshes[visibleObjects[i]]].range;
+            vkCmdDrawIndexed(commandBuffer, range.indexCount, 1, range.firstIndex, range.vertexOffset, i);
+        }
     }
+}
 
-    VkPipelineStageFlags pipelineStageFlags = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
-    VkSubmitInfo submitInfo = {
-        VK_STRUCTURE_TYPE_SUBMIT_INFO,
-        nullptr,
-        1,
-        &semaphores[0],
-        &pipelineStageFlags,
-        1,
-        &commandBuffers[imageIndex],
-        1,
-        &semaphores[1]};
-    vkQueueSubmit(queue, 1, &submitInfo, VK_NULL_HANDLE);
+/**
+ * @brief Records the skinned objects, one draw each after the draws of the visible objects.
+ *
+ * They take the arena indices of their mesh and the vertices of their skin instance from the
+ * skinning output, whose writes the render graph orders before the vertex input.
+ *
+ * @param commandBuffer The command buffer inside the render pass, with the object sets bound.
+ * @param layout The layout of the bound pipeline.
+ */
+void recordSkinnedDraws(VkCommandBuffer commandBuffer, VkPipelineLayout layout)
+{
+    bool bindlessActive = isBindlessActive();
+    vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, bindlessActive ? skinnedMeshPipeline : skinnedMaterialPipeline);
+    VkBuffer outputBuffer = skinning.getOutputBuffer();
+    VkDeviceSize offset = 0;
+    vkCmdBindVertexBuffers(commandBuffer, 0, 1, &outputBuffer, &offset);
 
-    VkPresentInfoKHR presentInfo = {
-        VK_STRUCTURE_TYPE_PRESENT_INFO_KHR,
-        nullptr,
-        1,
-        &semaphores[1],
-        1,
-        &swapchain,
-        &imageIndex};
+    for (uint32_t i = 0; i < skinnedObjects.size(); i++)
+    {
+        const SkinnedObject &object = skinnedObjects[i];
+        if (!bindlessActive)
+        {
+            VkDescriptorSet materialSet = bindless.getMaterialSet(object.material);
+            vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, layout, 2, 1, &materialSet, 0, nullptr);
+            descriptorBindCount++;
+        }
+        const MeshRange &range = meshes[object.mesh].range;
+        vkCmdDrawIndexed(commandBuffer, range.indexCount, 1, range.firstIndex, static_cast<int32_t>(skinning.getOutputOffset(object.instance)), drawCount + i);
+    }
+}
 
-    res = vkQueuePresentKHR(queue, &presentInfo);
-    if (res != VK_SUCCESS)
+/**
+ * @brief Records the visible objects from the shared arenas, followed by the skinned objects.
+ *
+ * The bindless set is bound once together with the matrix and draw data sets. Without it the draw
+ * list is ordered by material and every material batch binds its own set before its draws.
+ *
+ * @param commandBuffer The command buffer inside the render pass.
+ * @param frame The frame slot.
+ */
+void recordObjectDraws(VkCommandBuffer commandBuffer, uint32_t frame)
+{
+    TRACE_ZONE("recordObjectDraws");
+
+    bool bindlessActive = isBindlessActive();
+    VkPipelineLayout layout = bindlessActive ? meshPipelineLayout : materialPipelineLayout;
+    vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, bindlessActive ? meshPipeline : materialPipeline);
+    VkDescriptorSet sets[] = {descriptorSet, meshArena.getSet(frame), bindless.getSet()};
+    uint32_t matrixOffset = static_cast<uint32_t>(frame * matrixRingStride);
+    vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, layout, 0, bindlessActive ? 3 : 2, sets, 1, &matrixOffset);
+    descriptorBindCount = 1;
+    vkCmdPushConstants(commandBuffer, layout, VK_SHADER_STAGE_VERTEX_BIT, offsetof(MeshPushConstants, viewProjection), sizeof(Matrix4), viewProjection.m);
+    meshArena.bind(commandBuffer);
+
+    if (bindlessActive)
     {
-        jclass exceptionClass = env->FindClass("com/github/nodedev74/jfbx/exception/VkRuntimeError");
-        jmethodID constructorID = env->GetMethodID(exceptionClass, "<init>", "(Ljava/lang/String;)V");
-        jstring message = env->NewStringUTF("unknown");
-        jint jresult = static_cast<jint>(res);
-        jobject exceptionObject = env->NewObject(exceptionClass, constructorID, message, jresult);
-        env->Throw(static_cast<jthrowable>(exceptionObject));
+        recordDrawRange(commandBuffer, frame, 0, drawCallCount);
+    }
+    else
+    {
+        for (const MaterialBatch &batch : materialBatches)
+        {
+            VkDescriptorSet materialSet = bindless.getMaterialSet(batch.material);
+            vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, layout, 2, 1, &materialSet, 0, nullptr);
+            descriptorBindCount++;
+            recordDrawRange(commandBuffer, frame, batch.firstCommand, batch.commandCount);
+        }
+    }
+    if (!skinnedObjects.empty())
+    {
+        recordSkinnedDraws(commandBuffer, layout);
     }
 }
 
 /**
- * @brief Destroys the Vulkan resources.
+ * @brief Records the command buffer of a frame slot.
  *
- * @param env The JNI environment.
- * @param obj The Java object instance.
+ * The passes were declared once by the render graph, which culls the ones whose results are not
+ * needed in this frame and records the barriers between the rest.
+ *
+ * @param i The frame slot.
  */
-JNIEXPORT void JNICALL Java_com_github_nodedev74_jfbx_vulkan_VkHandler_destroy(JNIEnv *env, jobject obj)
+void recordFrame(uint32_t i)
 {
-    jclass cls = env->GetObjectClass(obj);
-    jfieldID fieldID = env->GetFieldID(cls, "sdlWindowPtr", "J");
-    jlong sdlWindowPtr = env->GetLongField(obj, fieldID);
-    SDL_Window *sdlWindow = reinterpret_cast<SDL_Window *>(sdlWindowPtr);
+    bool occlusionCulling = isOcclusionCullingActive() && !objectMeshes.empty();
+    renderGraph.setEnabled(occlusionPass, occlusionCulling);
+    renderGraph.setOutput(pyramidResource, occlusionCulling);
+    // Prerecorded frames are reused while skin instances are added, so they always skin
+    renderGraph.setOutput(skinnedVertexResource, objectMeshes.empty() || skinning.getInstanceCount() > 0);
+    renderGraph.setAccessEnabled(objectPass, skinnedVertexResource, !skinnedObjects.empty());
+    bool instancedOcclusion = occlusionCulling && isInstancingActive();
+    renderGraph.setAccessEnabled(occlusionPass, objectDrawResource, instancedOcclusion);
+    renderGraph.setAccessEnabled(objectPass, objectDrawResource, instancedOcclusion);
+
+    VkCommandBufferBeginInfo commandBufferBeginInfo = {VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO, nullptr, VK_COMMAND_BUFFER_USAGE_SIMULTANEOUS_USE_BIT, nullptr};
+    vkBeginCommandBuffer(commandBuffers[i], &commandBufferBeginInfo);
+    profiler.beginFrame(commandBuffers[i], i);
+    renderGraph.execute(commandBuffers[i], i);
+    vkEndCommandBuffer(commandBuffers[i]);
+}
 
-    vkDeviceWaitIdle(device);
-    vkDestroyPipeline(device, pipeline, nullptr);
-    for (int i = 0; i < framebuffers.size(); i++)
+/**
+ * @brief Records the render pass of a frame slot with the triangle or the visible objects.
+ *
+ * @param commandBuffer The command buffer of the frame slot.
+ * @param frame The frame slot.
+ */
+void recordRenderPass(VkCommandBuffer commandBuffer, uint32_t frame)
+{
+    VkClearValue clearValues[2];
+    clearValues[0].color = {{0.0f, 0.0f, 0.0f, 1.0f}};
+    clearValues[1].depthStencil = {1.0f, 0};
+
+    uint32_t renderPassScope = profiler.beginScope(commandBuffer, frame, "render pass");
+    profiler.beginStatistics(commandBuffer, frame);
+    if (dynamicRenderingSupported)
     {
-        vkDestroyFramebuffer(device, framebuffers[i], nullptr);
-        vkDestroyImageView(device, swapchainImagesViews[i], nullptr);
+        // The render graph has already moved both attachments into their attachment layouts
+        VkRenderingAttachmentInfoKHR colorAttachment{VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO_KHR};
+        colorAttachment.imageView = swapchainImagesViews[frame];
+        colorAttachment.imageLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+        colorAttachment.loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
+        colorAttachment.storeOp = VK_ATTACHMENT_STORE_OP_STORE;
+        colorAttachment.clearValue = clearValues[0];
+
+        VkRenderingAttachmentInfoKHR depthAttachment{VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO_KHR};
+        depthAttachment.imageView = renderGraph.getImageView(depthResource);
+        depthAttachment.imageLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+        depthAttachment.loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
+        depthAttachment.storeOp = VK_ATTACHMENT_STORE_OP_STORE;
+        depthAttachment.clearValue = clearValues[1];
+
+        VkRenderingInfoKHR renderingInfo{VK_STRUCTURE_TYPE_RENDERING_INFO_KHR};
+        renderingInfo.renderArea = {{0, 0}, swapchainCreateInfo.imageExtent};
+        renderingInfo.layerCount = 1;
+        renderingInfo.colorAttachmentCount = 1;
+        renderingInfo.pColorAttachments = &colorAttachment;
+        renderingInfo.pDepthAttachment = &depthAttachment;
+        vkCmdBeginRenderingKHR(commandBuffer, &renderingInfo);
     }
-    vkDestroyRenderPass(device, renderPass, nullptr);
-    vkDestroyDescriptorSetLayout(device, descriptorSetLayout, nullptr);
-    vkDestroyDescriptorPool(device, descriptorPool, nullptr);
-    for (int i = 0; i < semaphores.size(); i++)
+    else
     {
-        vkDestroySemaphore(device, semaphores[i], nullptr);
+        VkRenderPassBeginInfo renderPassBeginInfo = {
+            VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO,
+            nullptr,
+            renderPass,
+            framebuffers[frame],
+            {{0, 0}, {swapchainCreateInfo.imageExtent}},
+            2,
+            clearValues};
+        vkCmdBeginRenderPass(commandBuffer, &renderPassBeginInfo, VK_SUBPASS_CONTENTS_INLINE);
+    }
+
+    // The matrices of the frame were written through the mapping before the submit, which makes them visible
+    uint32_t matrixOffset = static_cast<uint32_t>(frame * matrixRingStride);
+    vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayout, 0, 1, &descriptorSet, 1, &matrixOffset);
+
+    vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline);
+
+    if (objectMeshes.empty() && skinnedObjects.empty())
+    {
+        VkDeviceSize offset = 0;
+        vkCmdBindVertexBuffers(commandBuffer, 0, 1, &deviceVertexBuffer, &offset);
+
+        vkCmdDraw(commandBuffer, 3, 1, 0, 0);
+    }
+    else
+    {
+        recordObjectDraws(commandBuffer, frame);
+    }
+
+    if (dynamicRenderingSupported)
+    {
+        vkCmdEndRenderingKHR(commandBuffer);
+    }
+    else
+    {
+        vkCmdEndRenderPass(commandBuffer);
+    }
+    profiler.endStatistics(commandBuffer, frame);
+    profiler.endScope(commandBuffer, frame, renderPassScope);
+}
+
+/**
+ * @brief Copies the color attachment of a frame slot into its readback buffer.
+ *
+ * @param commandBuffer The command buffer of the frame slot.
+ * @param frame The frame slot.
+ */
+void recordReadback(VkCommandBuffer commandBuffer, uint32_t frame)
+{
+    uint32_t readbackScope = profiler.beginScope(commandBuffer, frame, "readback");
+    VkBufferImageCopy bufferImageCopy = {
+        0,
+        0,
+        0,
+        {VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1},
+        {0, 0, 0},
+        {swapchainCreateInfo.imageExtent.width, swapchainCreateInfo.imageExtent.height, 1},
+    };
+    vkCmdCopyImageToBuffer(commandBuffer, swapchainImages[frame], VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, readbackBuffers[frame], 1, &bufferImageCopy);
+    profiler.endScope(commandBuffer, frame, readbackScope);
+}
+
+/**
+ * @brief Declares the passes of a frame and creates the depth attachment they share.
+ *
+ * Every pass states the resources it reads and writes, the render graph derives the barriers and
+ * layout transitions between them. The depth of a frame is reduced into the occlusion pyramid
+ * after its render pass, which is its last use, so all frame slots share one transient attachment.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ */
+JNIEXPORT void JNICALL Java_com_github_nodedev74_jfbx_vulkan_VkHandler_createRenderGraph(JNIEnv *env, jobject obj)
+{
+    TRACE_ZONE("VkHandler.createRenderGraph");
+
+    depthFormat = VK_FORMAT_UNDEFINED;
+    for (VkFormat format : {VK_FORMAT_D32_SFLOAT, VK_FORMAT_D16_UNORM})
+    {
+        VkFormatProperties formatProperties;
+        vkGetPhysicalDeviceFormatProperties(physicalDevice, format, &formatProperties);
+        VkFormatFeatureFlags features = VK_FORMAT_FEATURE_DEPTH_STENCIL_ATTACHMENT_BIT | VK_FORMAT_FEATURE_SAMPLED_IMAGE_BIT;
+        if ((formatProperties.optimalTilingFeatures & features) == features)
+        {
+            depthFormat = format;
+            break;
+        }
+    }
+
+    VkImageCreateInfo imageCreateInfo = {
+        VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO,
+        nullptr,
+        0,
+        VK_IMAGE_TYPE_2D,
+        depthFormat,
+        {swapchainCreateInfo.imageExtent.width, swapchainCreateInfo.imageExtent.height, 1},
+        1,
+        1,
+        VK_SAMPLE_COUNT_1_BIT,
+        VK_IMAGE_TILING_OPTIMAL,
+        VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT,
+        VK_SHARING_MODE_EXCLUSIVE,
+        0,
+        nullptr,
+        VK_IMAGE_LAYOUT_UNDEFINED,
+    };
+
+    // The states the previous frame leaves the imported resources in
+    RenderGraphState presented = {VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT_KHR, 0, VK_IMAGE_LAYOUT_PRESENT_SRC_KHR};
+    RenderGraphState copied = {VK_PIPELINE_STAGE_2_TRANSFER_BIT_KHR, VK_ACCESS_2_TRANSFER_READ_BIT_KHR, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL};
+    RenderGraphState hostRead = {VK_PIPELINE_STAGE_2_HOST_BIT_KHR, VK_ACCESS_2_HOST_READ_BIT_KHR};
+    RenderGraphState indirectRead = {VK_PIPELINE_STAGE_2_DRAW_INDIRECT_BIT_KHR, VK_ACCESS_2_INDIRECT_COMMAND_READ_BIT_KHR};
+    RenderGraphState objectDrawRead = {VK_PIPELINE_STAGE_2_DRAW_INDIRECT_BIT_KHR | VK_PIPELINE_STAGE_2_VERTEX_SHADER_BIT_KHR,
+                                       VK_ACCESS_2_INDIRECT_COMMAND_READ_BIT_KHR | VK_ACCESS_2_SHADER_READ_BIT_KHR};
+    RenderGraphState skinnedVertexRead = {
+        VK_PIPELINE_STAGE_2_VERTEX_INPUT_BIT_KHR | VK_PIPELINE_STAGE_2_VERTEX_SHADER_BIT_KHR | VK_PIPELINE_STAGE_2_TRANSFER_BIT_KHR,
+        VK_ACCESS_2_VERTEX_ATTRIBUTE_READ_BIT_KHR | VK_ACCESS_2_SHADER_READ_BIT_KHR | VK_ACCESS_2_TRANSFER_READ_BIT_KHR};
+    RenderGraphState pyramidRead = {VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT_KHR, VK_ACCESS_2_SHADER_READ_BIT_KHR, VK_IMAGE_LAYOUT_GENERAL};
+
+    renderGraph.create(device, memoryTracker, synchronization2Supported);
+    colorResource = renderGraph.importImage("color", swapchainImages, {VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1}, headless ? copied : presented);
+    skinnedVertexResource = renderGraph.importBuffer("skinned vertices", 1, skinnedVertexRead);
+    occlusionDrawResource = renderGraph.importBuffer("occlusion draws", swapchainImagesCount, indirectRead);
+    occlusionCounterResource = renderGraph.importBuffer("occlusion counters", swapchainImagesCount, hostRead);
+    objectDrawResource = renderGraph.importBuffer("object draws", swapchainImagesCount, objectDrawRead);
+    pyramidResource = renderGraph.importImage("depth pyramid", std::vector<VkImage>(1, VK_NULL_HANDLE), {VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1}, {});
+    readbackResource = renderGraph.importBuffer("readback", swapchainImagesCount, hostRead);
+    depthResource = renderGraph.createImage("depth", imageCreateInfo, VK_IMAGE_ASPECT_DEPTH_BIT);
+
+    uint32_t pass = renderGraph.addPass("skinning", [](VkCommandBuffer commandBuffer, uint32_t frame)
+                                        {
+        uint32_t skinningScope = profiler.beginScope(commandBuffer, frame, "skinning");
+        skinning.record(commandBuffer, frame);
+        profiler.endScope(commandBuffer, frame, skinningScope); });
+    renderGraph.write(pass, skinnedVertexResource, {VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT_KHR, VK_ACCESS_2_SHADER_WRITE_BIT_KHR}, true);
+    renderGraph.setFinalState(skinnedVertexResource, skinnedVertexRead);
+
+    occlusionPass = renderGraph.addPass("occlusion", [](VkCommandBuffer commandBuffer, uint32_t frame)
+                                        {
+        uint32_t occlusionScope = profiler.beginScope(commandBuffer, frame, "occlusion");
+        occlusion.recordCull(commandBuffer, frame, viewProjection, drawCount, getOcclusionOutput());
+        profiler.endScope(commandBuffer, frame, occlusionScope); });
+    renderGraph.read(occlusionPass, pyramidResource, pyramidRead);
+    renderGraph.write(occlusionPass, occlusionDrawResource, {VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT_KHR, VK_ACCESS_2_SHADER_WRITE_BIT_KHR}, true);
+    renderGraph.write(occlusionPass, occlusionCounterResource,
+                      {VK_PIPELINE_STAGE_2_TRANSFER_BIT_KHR | VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT_KHR,
+                       VK_ACCESS_2_TRANSFER_WRITE_BIT_KHR | VK_ACCESS_2_SHADER_READ_BIT_KHR | VK_ACCESS_2_SHADER_WRITE_BIT_KHR},
+                      true);
+    // The instance counts and draw data of the host written draw lists, only packed with instancing
+    renderGraph.write(occlusionPass, objectDrawResource, {VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT_KHR, VK_ACCESS_2_SHADER_READ_BIT_KHR | VK_ACCESS_2_SHADER_WRITE_BIT_KHR},
+                      false);
+    renderGraph.setOutput(occlusionCounterResource, true);
+    renderGraph.setFinalState(occlusionCounterResource, hostRead);
+
+    objectPass = renderGraph.addPass("render pass", recordRenderPass);
+    renderGraph.read(objectPass, occlusionDrawResource, indirectRead);
+    renderGraph.read(objectPass, occlusionCounterResource, indirectRead);
+    // Enabled by the frames that draw skinned objects, so skinning stays culled without them
+    renderGraph.read(objectPass, skinnedVertexResource, {VK_PIPELINE_STAGE_2_VERTEX_INPUT_BIT_KHR, VK_ACCESS_2_VERTEX_ATTRIBUTE_READ_BIT_KHR});
+    renderGraph.setAccessEnabled(objectPass, skinnedVertexResource, false);
+    renderGraph.read(objectPass, objectDrawResource, objectDrawRead);
+    renderGraph.write(objectPass, colorResource,
+                      {VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT_KHR, VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT_KHR, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL}, true);
+    renderGraph.write(objectPass, depthResource,
+                      {VK_PIPELINE_STAGE_2_EARLY_FRAGMENT_TESTS_BIT_KHR | VK_PIPELINE_STAGE_2_LATE_FRAGMENT_TESTS_BIT_KHR,
+                       VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_READ_BIT_KHR | VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT_KHR,
+                       VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL},
+                      true);
+
+    pass = renderGraph.addPass("depth pyramid", [](VkCommandBuffer commandBuffer, uint32_t frame)
+                               {
+        uint32_t pyramidScope = profiler.beginScope(commandBuffer, frame, "depth pyramid");
+        occlusion.recordPyramid(commandBuffer, frame);
+        profiler.endScope(commandBuffer, frame, pyramidScope); });
+    renderGraph.read(pass, depthResource, {VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT_KHR, VK_ACCESS_2_SHADER_READ_BIT_KHR, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL});
+    renderGraph.write(pass, pyramidResource,
+                      {VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT_KHR, VK_ACCESS_2_SHADER_READ_BIT_KHR | VK_ACCESS_2_SHADER_WRITE_BIT_KHR, VK_IMAGE_LAYOUT_GENERAL}, false);
+
+    if (headless)
+    {
+        pass = renderGraph.addPass("readback", recordReadback);
+        renderGraph.read(pass, colorResource, copied);
+        renderGraph.write(pass, readbackResource, {VK_PIPELINE_STAGE_2_TRANSFER_BIT_KHR, VK_ACCESS_2_TRANSFER_WRITE_BIT_KHR}, true);
+        renderGraph.setOutput(readbackResource, true);
+        renderGraph.setFinalState(readbackResource, hostRead);
+    }
+    else
+    {
+        renderGraph.setOutput(colorResource, true);
+        renderGraph.setFinalState(colorResource, presented);
+    }
+
+    VkResult result = depthFormat == VK_FORMAT_UNDEFINED ? VK_ERROR_FORMAT_NOT_SUPPORTED : renderGraph.allocate();
+    if (result != VK_SUCCESS)
+    {
+        jclass exceptionClass = env->FindClass("com/github/nodedev74/jfbx/exception/VkRuntimeError");
+        jmethodID constructorID = env->GetMethodID(exceptionClass, "<init>", "(Ljava/lang/String;)V");
+        jstring message = env->NewStringUTF("Failed to allocate the transient images of the render graph");
+        jint jresult = static_cast<jint>(result);
+        jobject exceptionObject = env->NewObject(exceptionClass, constructorID, message, jresult);
+        env->Throw(static_cast<jthrowable>(exceptionObject));
+    }
+}
+
+/**
+ * @brief Collects the objects that are drawn in the next frame.
+ *
+ * Runs after the scene graph update, so the world bounds follow the current matrices.
+ */
+void cullObjects()
+{
+    TRACE_ZONE("cullObjects");
+
+    uint32_t objectCount = static_cast<uint32_t>(objectMeshes.size());
+    visibleObjects.resize(objectCount);
+    if (sceneGraph != nullptr && (frustumCullingEnabled || isOcclusionCullingActive() || textureStreamer.getTextureCount() > 0))
+    {
+        frustumCuller.update(*sceneGraph, &ThreadPool::shared());
+    }
+
+    if (!frustumCullingEnabled)
+    {
+        std::iota(visibleObjects.begin(), visibleObjects.end(), 0);
+        drawCount = objectCount;
+        return;
+    }
+    drawCount = frustumCuller.cull(Frustum::fromViewProjection(viewProjection), &ThreadPool::shared(), visibleObjects.data());
+}
+
+/**
+ * @brief Uploads the next part of an asset the loader finished processing.
+ *
+ * Textures come first so the materials of a scene can refer to them, meshes last. The upload
+ * stops between items once the frame has used up the asset upload budget.
+ *
+ * @param asset The asset in the Uploading state.
+ * @param frameBytes The bytes uploaded in this frame, updated.
+ * @return Complete, Cancelled or Failed, or Uploading if the asset continues in a later frame.
+ */
+AssetState uploadAsset(Asset &asset, uint64_t &frameBytes)
+{
+    while (asset.textureIndices.size() < asset.textures.size())
+    {
+        if (asset.cancelled)
+            return AssetState::Cancelled;
+        if (frameBytes >= assetUploadBudget)
+            return AssetState::Uploading;
+
+        size_t first = asset.textureIndices.size();
+        size_t end = first + 1;
+        uint64_t bytes = asset.textures[first].bytes.size();
+        while (end < asset.textures.size() && frameBytes + bytes + asset.textures[end].bytes.size() <= assetUploadBudget)
+        {
+            bytes += asset.textures[end++].bytes.size();
+        }
+        std::vector<uint32_t> indices(end - first);
+        if (bindless.addTextures(queue, commandPool, &asset.textures[first], end - first, nullptr, indices.data()) != VK_SUCCESS)
+        {
+            asset.error = "Failed to upload textures";
+            return AssetState::Failed;
+        }
+        asset.textureIndices.insert(asset.textureIndices.end(), indices.begin(), indices.end());
+        frameBytes += bytes;
+        asset.uploadedBytes += bytes;
+        asset.progress = 0.8f + 0.2f * static_cast<float>(asset.uploadedBytes) / static_cast<float>(asset.uploadBytes);
+    }
+
+    while (asset.materialIndices.size() < asset.materialTextures.size())
+    {
+        int32_t texture = asset.materialTextures[asset.materialIndices.size()];
+        MaterialData material = {{1.0f, 1.0f, 1.0f, 1.0f}, texture >= 0 ? static_cast<uint32_t>(asset.textureIndices[texture]) : 0};
+        uint32_t index;
+        if (bindless.addMaterial(material, index) != VK_SUCCESS)
+        {
+            asset.error = "Failed to add material";
+            return AssetState::Failed;
+        }
+        asset.materialIndices.push_back(static_cast<int32_t>(index));
+    }
+
+    while (asset.meshIndices.size() < asset.meshes.size())
+    {
+        if (asset.cancelled)
+            return AssetState::Cancelled;
+        if (frameBytes >= assetUploadBudget)
+            return AssetState::Uploading;
+
+        const AssetMesh &assetMesh = asset.meshes[asset.meshIndices.size()];
+        if (assetMesh.indexCount == 0)
+        {
+            asset.meshIndices.push_back(-1);
+            continue;
+        }
+        Mesh mesh;
+        if (meshArena.upload(queue, commandPool, assetMesh.positions, assetMesh.vertexCount, assetMesh.indices, assetMesh.indexCount, mesh.range) != VK_SUCCESS)
+        {
+            asset.error = "Failed to upload mesh";
+            return AssetState::Failed;
+        }
+        mesh.bounds = assetMesh.bounds;
+        mesh.vertexCount = assetMesh.vertexCount;
+        meshes.push_back(mesh);
+        asset.meshIndices.push_back(static_cast<int32_t>(meshes.size() - 1));
+
+        uint64_t bytes = (assetMesh.vertexCount * 3ull + assetMesh.indexCount) * 4;
+        frameBytes += bytes;
+        asset.uploadedBytes += bytes;
+        asset.progress = 0.8f + 0.2f * static_cast<float>(asset.uploadedBytes) / static_cast<float>(asset.uploadBytes);
+    }
+    asset.progress = 1.0f;
+    return AssetState::Complete;
+}
+
+/**
+ * @brief Uploads the assets the loader finished processing, highest priority first, until the
+ * frame has used up the asset upload budget. Larger assets are spread over several frames, so
+ * loading never stalls a frame for longer than its budget takes.
+ */
+void uploadAssets()
+{
+    if (assetLoader == nullptr)
+    {
+        return;
+    }
+    TRACE_ZONE("uploadAssets");
+
+    uint64_t frameBytes = 0;
+    while (frameBytes < assetUploadBudget)
+    {
+        std::shared_ptr<Asset> asset = assetLoader->beginUpload();
+        if (asset == nullptr)
+        {
+            break;
+        }
+        assetLoader->endUpload(asset, uploadAsset(*asset, frameBytes));
+    }
+}
+
+/**
+ * @brief Requests the mip level of every streamed texture a visible object samples and streams
+ * the levels in before the frame is recorded.
+ *
+ * Meshes map one texture repetition to one unit of their local x and z axes. The pixels a
+ * repetition covers are estimated at the box point nearest to the camera along the view
+ * direction, from the world box and the scale of the object.
+ *
+ * @return The result of VkTextureStreamer::update(), the resident levels stay unchanged on failure.
+ */
+VkResult requestTextureLevels()
+{
+    TRACE_ZONE("requestTextureLevels");
+
+    if (textureStreamer.getTextureCount() == 0)
+    {
+        return VK_SUCCESS;
+    }
+
+    // Pixels per world unit along the screen axes at a clip w of one
+    const float *m = viewProjection.m;
+    VkExtent2D extent = swapchainCreateInfo.imageExtent;
+    float scaleX = std::sqrt(m[0] * m[0] + m[4] * m[4] + m[8] * m[8]) * 0.5f * static_cast<float>(extent.width);
+    float scaleY = std::sqrt(m[1] * m[1] + m[5] * m[5] + m[9] * m[9]) * 0.5f * static_cast<float>(extent.height);
+    float pixelsPerUnit = std::max(scaleX, scaleY);
+    float depthScale = std::sqrt(m[3] * m[3] + m[7] * m[7] + m[11] * m[11]);
+
+    textureStreamer.beginFrame();
+    for (uint32_t i = 0; i < drawCount; i++)
+    {
+        uint32_t object = visibleObjects[i];
+        uint32_t texture = bindless.getMaterialTexture(objectMaterials[object]);
+        if (!textureStreamer.isStreamed(texture))
+        {
+            continue;
+        }
+        float center[3];
+        float extentWorld[3];
+        frustumCuller.getWorldBox(object, center, extentWorld);
+        const Bounds &bounds = meshes[objectMeshes[object]].bounds;
+        float localSize = std::max({bounds.max[0] - bounds.min[0], bounds.max[1] - bounds.min[1], bounds.max[2] - bounds.min[2]});
+        float worldSize = 2.0f * std::max({extentWorld[0], extentWorld[1], extentWorld[2]});
+        float objectScale = localSize > 0.0f ? worldSize / localSize : 1.0f;
+
+        float w = m[3] * center[0] + m[7] * center[1] + m[11] * center[2] + m[15];
+        float radius = std::sqrt(extentWorld[0] * extentWorld[0] + extentWorld[1] * extentWorld[1] + extentWorld[2] * extentWorld[2]);
+        w = std::max(w - radius * depthScale, 1e-3f);
+        textureStreamer.request(texture, pixelsPerUnit * objectScale / w);
+    }
+
+    return textureStreamer.update(bindless, queue, commandPool);
+}
+
+/**
+ * @brief Orders the visible objects by a key with a stable counting sort, so the objects sharing
+ * a key become consecutive draws.
+ *
+ * @param keys The key per object.
+ * @param keyCount The number of distinct keys.
+ */
+void sortVisibleObjects(const std::vector<uint32_t> &keys, size_t keyCount)
+{
+    TRACE_ZONE("sortVisibleObjects");
+
+    groupOffsets.assign(keyCount + 1, 0);
+    for (uint32_t i = 0; i < drawCount; i++)
+    {
+        groupOffsets[keys[visibleObjects[i]] + 1]++;
+    }
+    for (size_t i = 1; i < groupOffsets.size(); i++)
+    {
+        groupOffsets[i] += groupOffsets[i - 1];
+    }
+    groupedObjects.resize(drawCount);
+    for (uint32_t i = 0; i < drawCount; i++)
+    {
+        uint32_t object = visibleObjects[i];
+        groupedObjects[groupOffsets[keys[object]]++] = object;
+    }
+    visibleObjects.swap(groupedObjects);
+}
+
+/**
+ * @brief Splits the draw commands of a frame into runs of the same material.
+ *
+ * @param instancing Whether the commands are the instance groups rather than single objects.
+ */
+void writeMaterialBatches(bool instancing)
+{
+    materialBatches.clear();
+    for (uint32_t i = 0; i < drawCallCount; i++)
+    {
+        uint32_t firstDraw = instancing ? instanceGroups[i].firstInstance : i;
+        uint32_t material = objectMaterials[visibleObjects[firstDraw]];
+        if (materialBatches.empty() || materialBatches.back().material != material)
+        {
+            materialBatches.push_back({material, i, 0});
+        }
+        materialBatches.back().commandCount++;
+    }
+}
+
+/**
+ * @brief Writes the draw list of the visible objects. Draw i gets the draw data read by the vertex
+ * shader and either an occlusion candidate or an indirect command. With instancing the draws of a
+ * mesh are consecutive and share a single command whose instances cover them, or are packed into
+ * it by the occlusion pass. Without bindless materials the draws are ordered by material first,
+ * so each material set is bound once. The draw data of the skinned objects follows the visible
+ * objects.
+ *
+ * @param frame The frame slot, its previous submission must have completed.
+ */
+void writeDraws(uint32_t frame)
+{
+    TRACE_ZONE("writeDraws");
+
+    bool occlusionCulling = isOcclusionCullingActive();
+    bool multiDraw = isMultiDrawIndirectActive();
+    bool instancing = isInstancingActive();
+    bool bindlessActive = isBindlessActive();
+    if (instancing)
+    {
+        sortVisibleObjects(objectMeshes, meshes.size());
+    }
+    if (!bindlessActive)
+    {
+        sortVisibleObjects(objectMaterials, bindless.getMaterialCount());
+    }
+    DrawData *draws = meshArena.getDraws(frame);
+    VkDrawIndexedIndirectCommand *commands = meshArena.getCommands(frame);
+    OcclusionCandidate *candidates = occlusion.getCandidates(frame);
+    uint32_t nodeCount = sceneGraph != nullptr ? sceneGraph->getNodeCount() : 0;
+    for (uint32_t i = 0; i < drawCount; i++)
+    {
+        uint32_t object = visibleObjects[i];
+        const MeshRange &range = meshes[objectMeshes[object]].range;
+
+        // Matrices are uploaded in slot order, objects outside the graph or the buffer use the first one
+        uint32_t node = frustumCuller.getNode(object);
+        uint32_t matrixSlot = node < nodeCount ? sceneGraph->getSlot(node) : 0;
+        matrixSlot = matrixSlot < matrixCapacity ? matrixSlot : 0;
+        draws[i] = {matrixSlot, objectMaterials[object], range.firstIndex, range.indexCount};
+
+        if (occlusionCulling)
+        {
+            OcclusionCandidate &candidate = candidates[i];
+            frustumCuller.getWorldBox(object, candidate.center, candidate.extent);
+            candidate.indexCount = range.indexCount;
+            candidate.firstIndex = range.firstIndex;
+            candidate.vertexOffset = range.vertexOffset;
+            candidate.matrixSlot = matrixSlot;
+            candidate.materialIndex = objectMaterials[object];
+        }
+        else if (multiDraw && !instancing)
+        {
+            commands[i] = {range.indexCount, 1, range.firstIndex, range.vertexOffset, i};
+        }
+    }
+    // Skinned vertices are placed by their joints, so no matrix slot is applied
+    for (uint32_t i = 0; i < skinnedObjects.size(); i++)
+    {
+        const SkinnedObject &object = skinnedObjects[i];
+        const MeshRange &range = meshes[object.mesh].range;
+        draws[drawCount + i] = {WORLD_SPACE_MATRIX_SLOT, object.material, range.firstIndex, range.indexCount};
+    }
+    drawCallCount = drawCount;
+    if (instancing)
+    {
+        // Material sets split the groups of a mesh, the bindless set lets them span materials
+        instanceGroups.clear();
+        for (uint32_t first = 0; first < drawCount;)
+        {
+            uint32_t mesh = objectMeshes[visibleObjects[first]];
+            uint32_t material = objectMaterials[visibleObjects[first]];
+            uint32_t end = first + 1;
+            while (end < drawCount && objectMeshes[visibleObjects[end]] == mesh && (bindlessActive || objectMaterials[visibleObjects[end]] == material))
+            {
+                end++;
+            }
+            const MeshRange &range = meshes[mesh].range;
+            instanceGroups.push_back({range.indexCount, end - first, range.firstIndex, range.vertexOffset, first});
+            first = end;
+        }
+        drawCallCount = static_cast<uint32_t>(instanceGroups.size());
+        if (occlusionCulling)
+        {
+            // The occlusion pass counts the instances that pass its test and packs their draw data
+            for (uint32_t group = 0; group < drawCallCount; group++)
+            {
+                const VkDrawIndexedIndirectCommand &command = instanceGroups[group];
+                commands[group] = {command.indexCount, 0, command.firstIndex, command.vertexOffset, command.firstInstance};
+                for (uint32_t i = command.firstInstance; i < command.firstInstance + command.instanceCount; i++)
+                {
+                    candidates[i].group = group;
+                }
+            }
+        }
+        else if (multiDraw)
+        {
+            std::copy(instanceGroups.begin(), instanceGroups.end(), commands);
+        }
+    }
+    if (!bindlessActive)
+    {
+        writeMaterialBatches(instancing);
+    }
+}
+
+/**
+ * @brief Prepares the command buffer of a frame slot before its submission. Without objects the
+ * command buffers recorded at startup are reused.
+ *
+ * Staging buffers and replaced textures of completed uploads are released first.
+ *
+ * @param frame The frame slot, its previous submission must have completed.
+ * @return The result of the texture streaming, the frame is recorded either way.
+ */
+VkResult prepareFrame(uint32_t frame)
+{
+    memoryTracker.update();
+    bindless.releaseTransfers();
+    meshArena.releaseUploads();
+    uploadAssets();
+    if (objectMeshes.empty() && skinnedObjects.empty())
+    {
+        return VK_SUCCESS;
+    }
+
+    auto recordStart = std::chrono::steady_clock::now();
+    // The counter holds the result of the previous submission of this slot
+    occludedCount = isOcclusionCullingActive() ? occlusion.getOccludedCount(frame) : 0;
+    cullObjects();
+    VkResult result = requestTextureLevels();
+    writeDraws(frame);
+    recordFrame(frame);
+    recordTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - recordStart).count();
+    return result;
+}
+
+/**
+ * @brief Records the command buffers for Vulkan rendering.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ */
+JNIEXPORT void JNICALL Java_com_github_nodedev74_jfbx_vulkan_VkHandler_recordCommandBuffers(JNIEnv *env, jobject obj)
+{
+    TRACE_ZONE("VkHandler.recordCommandBuffers");
+
+    for (uint32_t i = 0; i < swapchainImagesCount; i++)
+    {
+        recordFrame(i);
+    }
+}
+
+/**
+ * @brief Creates semaphores for Vulkan synchronization.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ */
+JNIEXPORT void JNICALL Java_com_github_nodedev74_jfbx_vulkan_VkHandler_createSemaphores(JNIEnv *env, jobject obj)
+{
+    TRACE_ZONE("VkHandler.createSemaphores");
+
+    VkSemaphoreCreateInfo semaphoreCreateInfo = {VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO, nullptr, 0};
+    semaphores.resize(2);
+    for (int i = 0; i < semaphores.size(); i++)
+    {
+        vkCreateSemaphore(device, &semaphoreCreateInfo, nullptr, &semaphores[i]);
+    }
+
+    // A swapchain image is only prepared again once its previous frame has completed
+    VkFenceCreateInfo fenceCreateInfo = {VK_STRUCTURE_TYPE_FENCE_CREATE_INFO, nullptr, VK_FENCE_CREATE_SIGNALED_BIT};
+    frameFences.resize(swapchainImagesCount);
+    for (uint32_t i = 0; i < swapchainImagesCount; i++)
+    {
+        vkCreateFence(device, &fenceCreateInfo, nullptr, &frameFences[i]);
+    }
+}
+
+/**
+ * @brief Updates the attached scene graph and writes its world matrices and the joint matrices of
+ * the skin instances into the buffers of a frame.
+ *
+ * @param frame The frame whose command buffer is submitted next.
+ */
+void uploadWorldMatrices(uint32_t frame)
+{
+    TRACE_ZONE("uploadWorldMatrices");
+
+    if (sceneGraph == nullptr)
+    {
+        skinning.update(frame, nullptr);
+        return;
+    }
+
+    sceneGraph->update(ThreadPool::shared());
+    auto writeStart = std::chrono::steady_clock::now();
+    uint32_t count = std::min(sceneGraph->getNodeCount(), matrixCapacity);
+    memcpy(frameMatrixPointers[frame], sceneGraph->getWorldMatrices(), count * sizeof(glm::mat4));
+    matrixWriteTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - writeStart).count();
+    skinning.update(frame, sceneGraph);
+}
+
+/**
+ * @brief Attaches the scene graph whose world matrices are uploaded every frame.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ * @param graph The Java scene graph, or null to detach.
+ */
+JNIEXPORT void JNICALL Java_com_github_nodedev74_jfbx_vulkan_VkHandler_setSceneGraph(JNIEnv *env, jobject obj, jobject graph)
+{
+    if (graph == nullptr)
+    {
+        sceneGraph = nullptr;
+        return;
+    }
+
+    jclass cls = env->GetObjectClass(graph);
+    jfieldID fieldID = env->GetFieldID(cls, "graphPtr", "J");
+    sceneGraph = reinterpret_cast<SceneGraph *>(env->GetLongField(graph, fieldID));
+}
+
+/**
+ * @brief Uploads the bind pose of a skin for compute skinning.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ * @param skin The Java skin, it has to outlive its instances.
+ * @return The skin id.
+ */
+JNIEXPORT jint JNICALL Java_com_github_nodedev74_jfbx_vulkan_VkHandler_addSkin(JNIEnv *env, jobject obj, jobject skin)
+{
+    jclass cls = env->GetObjectClass(skin);
+    jfieldID fieldID = env->GetFieldID(cls, "skinPtr", "J");
+    int32_t id = skinning.addSkin(*reinterpret_cast<Skin *>(env->GetLongField(skin, fieldID)));
+    if (id < 0)
+    {
+        jclass exceptionClass = env->FindClass("com/github/nodedev74/jfbx/exception/VkRuntimeError");
+        jmethodID constructorID = env->GetMethodID(exceptionClass, "<init>", "(Ljava/lang/String;)V");
+        jstring message = env->NewStringUTF("Skin vertex capacity exceeded, raise jfbx.skinVertexCapacity");
+        jobject exceptionObject = env->NewObject(exceptionClass, constructorID, message);
+        env->Throw(static_cast<jthrowable>(exceptionObject));
+    }
+    return id;
+}
+
+/**
+ * @brief Adds an instance of an uploaded skin, skinned every frame from the attached scene graph.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ * @param skin The skin id.
+ * @param nodeOffset The offset added to the joint nodes of the skin.
+ * @return The instance id.
+ */
+JNIEXPORT jint JNICALL Java_com_github_nodedev74_jfbx_vulkan_VkHandler_addSkinInstance(JNIEnv *env, jobject obj, jint skin, jint nodeOffset)
+{
+    int32_t id = skinning.addInstance(static_cast<uint32_t>(skin), static_cast<uint32_t>(nodeOffset));
+    if (id < 0)
+    {
+        jclass exceptionClass = env->FindClass("com/github/nodedev74/jfbx/exception/VkRuntimeError");
+        jmethodID constructorID = env->GetMethodID(exceptionClass, "<init>", "(Ljava/lang/String;)V");
+        jstring message = env->NewStringUTF("Invalid skin or skin instance capacity exceeded");
+        jobject exceptionObject = env->NewObject(exceptionClass, constructorID, message);
+        env->Throw(static_cast<jthrowable>(exceptionObject));
+    }
+    return id;
+}
+
+/**
+ * @brief Copies the skinned positions of an instance back to the host.
+ *
+ * Waits for the queue to become idle, so it is meant for tests and tools rather than per frame use.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ * @param instance The instance id.
+ * @param positions Receives x, y, z and w per vertex.
+ */
+JNIEXPORT void JNICALL Java_com_github_nodedev74_jfbx_vulkan_VkHandler_readSkinnedVertices(JNIEnv *env, jobject obj, jint instance, jfloatArray positions)
+{
+    TRACE_ZONE("VkHandler.readSkinnedVertices");
+
+    if (instance < 0 || static_cast<uint32_t>(instance) >= skinning.getInstanceCount())
+    {
+        jclass exceptionClass = env->FindClass("com/github/nodedev74/jfbx/exception/VkRuntimeError");
+        jmethodID constructorID = env->GetMethodID(exceptionClass, "<init>", "(Ljava/lang/String;)V");
+        jstring message = env->NewStringUTF("Invalid skin instance");
+        jobject exceptionObject = env->NewObject(exceptionClass, constructorID, message);
+        env->Throw(static_cast<jthrowable>(exceptionObject));
+        return;
+    }
+
+    VkDeviceSize size = static_cast<VkDeviceSize>(skinning.getVertexCount(instance)) * 4 * sizeof(float);
+    VkBufferCreateInfo bufferCreateInfo = {
+        VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO,
+        nullptr,
+        0,
+        size,
+        VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+        VK_SHARING_MODE_EXCLUSIVE,
+        0,
+        nullptr,
+    };
+    VkBuffer stagingBuffer;
+    vkCreateBuffer(device, &bufferCreateInfo, nullptr, &stagingBuffer);
+
+    VkMemoryRequirements memoryRequirements;
+    vkGetBufferMemoryRequirements(device, stagingBuffer, &memoryRequirements);
+    VkDeviceMemory stagingMemory;
+    VkResult result = memoryTracker.allocate(memoryRequirements, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+                                             VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, MemoryCategory::Staging, stagingMemory);
+    if (result != VK_SUCCESS)
+    {
+        vkDestroyBuffer(device, stagingBuffer, nullptr);
+        jclass exceptionClass = env->FindClass("com/github/nodedev74/jfbx/exception/VkRuntimeError");
+        jmethodID constructorID = env->GetMethodID(exceptionClass, "<init>", "(Ljava/lang/String;)V");
+        jstring message = env->NewStringUTF("Failed to allocate memory");
+        jint jresult = static_cast<jint>(result);
+        jobject exceptionObject = env->NewObject(exceptionClass, constructorID, message, jresult);
+        env->Throw(static_cast<jthrowable>(exceptionObject));
+        return;
+    }
+    vkBindBufferMemory(device, stagingBuffer, stagingMemory, 0);
+
+    // A separate command buffer, the pool also holds the prerecorded frame command buffers
+    VkCommandBufferAllocateInfo commandBufferAllocateInfo = {VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO, nullptr, commandPool, VK_COMMAND_BUFFER_LEVEL_PRIMARY, 1};
+    VkCommandBuffer commandBuffer;
+    vkAllocateCommandBuffers(device, &commandBufferAllocateInfo, &commandBuffer);
+
+    VkCommandBufferBeginInfo commandBufferBeginInfo = {VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO, nullptr, VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT, nullptr};
+    vkBeginCommandBuffer(commandBuffer, &commandBufferBeginInfo);
+    VkBufferCopy bufferCopy = {skinning.getOutputOffset(instance) * 4 * sizeof(float), 0, size};
+    vkCmdCopyBuffer(commandBuffer, skinning.getOutputBuffer(), stagingBuffer, 1, &bufferCopy);
+    VkMemoryBarrier memoryBarrier = {VK_STRUCTURE_TYPE_MEMORY_BARRIER, nullptr, VK_ACCESS_TRANSFER_WRITE_BIT, VK_ACCESS_HOST_READ_BIT};
+    vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_HOST_BIT, 0, 1, &memoryBarrier, 0, nullptr, 0, nullptr);
+    vkEndCommandBuffer(commandBuffer);
+
+    // The fence of the copy also covers the frames submitted before, which wrote the positions
+    VkFenceCreateInfo fenceCreateInfo = {VK_STRUCTURE_TYPE_FENCE_CREATE_INFO, nullptr, 0};
+    VkFence fence;
+    vkCreateFence(device, &fenceCreateInfo, nullptr, &fence);
+    VkSubmitInfo submitInfo = {VK_STRUCTURE_TYPE_SUBMIT_INFO, nullptr, 0, nullptr, nullptr, 1, &commandBuffer, 0, nullptr};
+    vkQueueSubmit(queue, 1, &submitInfo, fence);
+    vkWaitForFences(device, 1, &fence, VK_TRUE, UINT64_MAX);
+    vkDestroyFence(device, fence, nullptr);
+
+    void *data;
+    vkMapMemory(device, stagingMemory, 0, VK_WHOLE_SIZE, 0, &data);
+    jsize count = std::min<jsize>(env->GetArrayLength(positions), static_cast<jsize>(size / sizeof(float)));
+    env->SetFloatArrayRegion(positions, 0, count, static_cast<const float *>(data));
+    vkUnmapMemory(device, stagingMemory);
+
+    vkFreeCommandBuffers(device, commandPool, 1, &commandBuffer);
+    vkDestroyBuffer(device, stagingBuffer, nullptr);
+    memoryTracker.free(stagingMemory);
+}
+
+/**
+ * @brief Uploads a triangle mesh.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ * @param positions x, y and z per vertex.
+ * @param indices Three indices per triangle.
+ * @return The mesh id.
+ */
+JNIEXPORT jint JNICALL Java_com_github_nodedev74_jfbx_vulkan_VkHandler_addMesh(JNIEnv *env, jobject obj, jfloatArray positions, jintArray indices)
+{
+    TRACE_ZONE("VkHandler.addMesh");
+
+    std::vector<float> positionValues(env->GetArrayLength(positions));
+    env->GetFloatArrayRegion(positions, 0, static_cast<jsize>(positionValues.size()), positionValues.data());
+    std::vector<uint32_t> indexValues(env->GetArrayLength(indices));
+    env->GetIntArrayRegion(indices, 0, static_cast<jsize>(indexValues.size()), reinterpret_cast<jint *>(indexValues.data()));
+
+    uint32_t vertexCount = static_cast<uint32_t>(positionValues.size() / 3);
+    bool valid = vertexCount > 0 && positionValues.size() % 3 == 0 && !indexValues.empty() && indexValues.size() % 3 == 0;
+    for (size_t i = 0; valid && i < indexValues.size(); i++)
+    {
+        valid = indexValues[i] < vertexCount;
+    }
+    if (!valid)
+    {
+        jclass exceptionClass = env->FindClass("com/github/nodedev74/jfbx/exception/VkRuntimeError");
+        jmethodID constructorID = env->GetMethodID(exceptionClass, "<init>", "(Ljava/lang/String;)V");
+        jstring message = env->NewStringUTF("Mesh needs triangles whose indices refer to its vertices");
+        jobject exceptionObject = env->NewObject(exceptionClass, constructorID, message);
+        env->Throw(static_cast<jthrowable>(exceptionObject));
+        return -1;
+    }
+
+    Mesh mesh;
+    VkResult result = meshArena.upload(queue, commandPool, positionValues.data(), vertexCount, indexValues.data(), static_cast<uint32_t>(indexValues.size()), mesh.range);
+    if (result != VK_SUCCESS)
+    {
+        jclass exceptionClass = env->FindClass("com/github/nodedev74/jfbx/exception/VkRuntimeError");
+        jmethodID constructorID = env->GetMethodID(exceptionClass, "<init>", "(Ljava/lang/String;)V");
+        jstring message = env->NewStringUTF("Failed to upload mesh");
+        jint jresult = static_cast<jint>(result);
+        jobject exceptionObject = env->NewObject(exceptionClass, constructorID, message, jresult);
+        env->Throw(static_cast<jthrowable>(exceptionObject));
+        return -1;
+    }
+    mesh.bounds = Bounds::fromPositions(positionValues.data(), vertexCount);
+    mesh.vertexCount = vertexCount;
+
+    meshes.push_back(mesh);
+    return static_cast<jint>(meshes.size() - 1);
+}
+
+/**
+ * @brief Adds an object that draws a mesh placed by a scene graph node.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ * @param mesh The mesh id.
+ * @param node The scene graph node.
+ * @param material The material index passed to the shaders.
+ * @return The object id.
+ */
+JNIEXPORT jint JNICALL Java_com_github_nodedev74_jfbx_vulkan_VkHandler_addObject(JNIEnv *env, jobject obj, jint mesh, jint node, jint material)
+{
+    if (objectMeshes.size() + skinnedObjects.size() >= meshArena.getDrawCapacity())
+    {
+        jclass exceptionClass = env->FindClass("com/github/nodedev74/jfbx/exception/VkRuntimeError");
+        jmethodID constructorID = env->GetMethodID(exceptionClass, "<init>", "(Ljava/lang/String;)V");
+        jstring message = env->NewStringUTF("Object capacity exceeded");
+        jobject exceptionObject = env->NewObject(exceptionClass, constructorID, message);
+        env->Throw(static_cast<jthrowable>(exceptionObject));
+        return -1;
+    }
+    if (mesh < 0 || static_cast<size_t>(mesh) >= meshes.size() || node < 0 || material < 0 || static_cast<uint32_t>(material) >= bindless.getMaterialCount())
+    {
+        jclass exceptionClass = env->FindClass("com/github/nodedev74/jfbx/exception/VkRuntimeError");
+        jmethodID constructorID = env->GetMethodID(exceptionClass, "<init>", "(Ljava/lang/String;)V");
+        jstring message = env->NewStringUTF("Invalid mesh, node or material");
+        jobject exceptionObject = env->NewObject(exceptionClass, constructorID, message);
+        env->Throw(static_cast<jthrowable>(exceptionObject));
+        return -1;
+    }
+
+    objectMeshes.push_back(static_cast<uint32_t>(mesh));
+    objectMaterials.push_back(static_cast<uint32_t>(material));
+    return static_cast<jint>(frustumCuller.add(static_cast<uint32_t>(node), meshes[mesh].bounds));
+}
+
+/**
+ * @brief Adds an object that draws the triangles of a mesh with the skinned vertices of a skin
+ * instance. Skinned objects are drawn every frame without culling.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ * @param mesh The mesh id, with as many vertices as the skin of the instance.
+ * @param instance The skin instance id.
+ * @param material The material index passed to the shaders.
+ * @return The skinned object id.
+ */
+JNIEXPORT jint JNICALL Java_com_github_nodedev74_jfbx_vulkan_VkHandler_addSkinnedObject(JNIEnv *env, jobject obj, jint mesh, jint instance, jint material)
+{
+    if (objectMeshes.size() + skinnedObjects.size() >= meshArena.getDrawCapacity())
+    {
+        jclass exceptionClass = env->FindClass("com/github/nodedev74/jfbx/exception/VkRuntimeError");
+        jmethodID constructorID = env->GetMethodID(exceptionClass, "<init>", "(Ljava/lang/String;)V");
+        jstring message = env->NewStringUTF("Object capacity exceeded");
+        jobject exceptionObject = env->NewObject(exceptionClass, constructorID, message);
+        env->Throw(static_cast<jthrowable>(exceptionObject));
+        return -1;
+    }
+    if (mesh < 0 || static_cast<size_t>(mesh) >= meshes.size() || instance < 0 || static_cast<uint32_t>(instance) >= skinning.getInstanceCount() ||
+        material < 0 || static_cast<uint32_t>(material) >= bindless.getMaterialCount() ||
+        meshes[mesh].vertexCount != skinning.getVertexCount(static_cast<uint32_t>(instance)))
+    {
+        jclass exceptionClass = env->FindClass("com/github/nodedev74/jfbx/exception/VkRuntimeError");
+        jmethodID constructorID = env->GetMethodID(exceptionClass, "<init>", "(Ljava/lang/String;)V");
+        jstring message = env->NewStringUTF("Invalid mesh, skin instance or material, or the mesh and skin vertex counts differ");
+        jobject exceptionObject = env->NewObject(exceptionClass, constructorID, message);
+        env->Throw(static_cast<jthrowable>(exceptionObject));
+        return -1;
+    }
+
+    skinnedObjects.push_back({static_cast<uint32_t>(mesh), static_cast<uint32_t>(instance), static_cast<uint32_t>(material)});
+    return static_cast<jint>(skinnedObjects.size() - 1);
+}
+
+/**
+ * @brief Sets the camera used for drawing and frustum culling.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ * @param matrix The column major view projection matrix.
+ */
+JNIEXPORT void JNICALL Java_com_github_nodedev74_jfbx_vulkan_VkHandler_setViewProjection(JNIEnv *env, jobject obj, jfloatArray matrix)
+{
+    if (env->GetArrayLength(matrix) >= 16)
+    {
+        env->GetFloatArrayRegion(matrix, 0, 16, viewProjection.m);
+    }
+}
+
+/**
+ * @brief Enables or disables frustum culling of the objects.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ * @param enabled False to draw every object.
+ */
+JNIEXPORT void JNICALL Java_com_github_nodedev74_jfbx_vulkan_VkHandler_setFrustumCulling(JNIEnv *env, jobject obj, jboolean enabled)
+{
+    frustumCullingEnabled = enabled;
+}
+
+/**
+ * @brief Enables or disables occlusion culling of the objects against the depth of the previous frame.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ * @param enabled False to draw every object that passes frustum culling.
+ */
+JNIEXPORT void JNICALL Java_com_github_nodedev74_jfbx_vulkan_VkHandler_setOcclusionCulling(JNIEnv *env, jobject obj, jboolean enabled)
+{
+    if (!enabled)
+    {
+        // The pyramid is not updated while disabled, so it is rebuilt before it is used again
+        occlusion.reset();
+    }
+    occlusionCullingEnabled = enabled;
+}
+
+/**
+ * @brief Switches between one multi draw indirect call and one draw call per object.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ * @param enabled False to record a draw call per object.
+ */
+JNIEXPORT void JNICALL Java_com_github_nodedev74_jfbx_vulkan_VkHandler_setMultiDrawIndirect(JNIEnv *env, jobject obj, jboolean enabled)
+{
+    multiDrawIndirectEnabled = enabled;
+}
+
+/**
+ * @brief Switches between one instanced draw per mesh and one draw per object.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ * @param enabled False to draw every object on its own.
+ */
+JNIEXPORT void JNICALL Java_com_github_nodedev74_jfbx_vulkan_VkHandler_setInstancing(JNIEnv *env, jobject obj, jboolean enabled)
+{
+    instancingEnabled = enabled;
+}
+
+/**
+ * @brief Retrieves the number of objects recorded into the last prepared frame.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ * @return The draw count.
+ */
+JNIEXPORT jint JNICALL Java_com_github_nodedev74_jfbx_vulkan_VkHandler_getDrawCount(JNIEnv *env, jobject obj)
+{
+    return static_cast<jint>(drawCount);
+}
+
+/**
+ * @brief Retrieves the number of indexed draws, direct or indirect, recorded into the last prepared frame.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ * @return The draw call count.
+ */
+JNIEXPORT jint JNICALL Java_com_github_nodedev74_jfbx_vulkan_VkHandler_getDrawCallCount(JNIEnv *env, jobject obj)
+{
+    return static_cast<jint>(drawCallCount);
+}
+
+/**
+ * @brief Uploads an RGBA8 texture that materials can refer to.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ * @param width The width in pixels.
+ * @param height The height in pixels.
+ * @param pixels Four bytes per pixel, row by row.
+ * @return The texture index.
+ */
+JNIEXPORT jint JNICALL Java_com_github_nodedev74_jfbx_vulkan_VkHandler_addTexture(JNIEnv *env, jobject obj, jint width, jint height, jbyteArray pixels)
+{
+    TRACE_ZONE("VkHandler.addTexture");
+
+    if (width <= 0 || height <= 0 || env->GetArrayLength(pixels) != static_cast<jsize>(width) * height * 4)
+    {
+        jclass exceptionClass = env->FindClass("com/github/nodedev74/jfbx/exception/VkRuntimeError");
+        jmethodID constructorID = env->GetMethodID(exceptionClass, "<init>", "(Ljava/lang/String;)V");
+        jstring message = env->NewStringUTF("Texture needs four bytes per pixel");
+        jobject exceptionObject = env->NewObject(exceptionClass, constructorID, message);
+        env->Throw(static_cast<jthrowable>(exceptionObject));
+        return -1;
+    }
+
+    std::vector<uint8_t> pixelValues(env->GetArrayLength(pixels));
+    env->GetByteArrayRegion(pixels, 0, static_cast<jsize>(pixelValues.size()), reinterpret_cast<jbyte *>(pixelValues.data()));
+    uint32_t index;
+    VkResult result = bindless.addTexture(queue, commandPool, static_cast<uint32_t>(width), static_cast<uint32_t>(height), pixelValues.data(), index);
+    if (result != VK_SUCCESS)
+    {
+        jclass exceptionClass = env->FindClass("com/github/nodedev74/jfbx/exception/VkRuntimeError");
+        jmethodID constructorID = env->GetMethodID(exceptionClass, "<init>", "(Ljava/lang/String;)V");
+        jstring message = env->NewStringUTF("Failed to upload texture");
+        jint jresult = static_cast<jint>(result);
+        jobject exceptionObject = env->NewObject(exceptionClass, constructorID, message, jresult);
+        env->Throw(static_cast<jthrowable>(exceptionObject));
+        return -1;
+    }
+    return static_cast<jint>(index);
+}
+
+/**
+ * @brief Appends a material to the material table.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ * @param baseColor The red, green, blue and alpha factor.
+ * @param texture The texture index, 0 for the white default texture.
+ * @return The material index.
+ */
+JNIEXPORT jint JNICALL Java_com_github_nodedev74_jfbx_vulkan_VkHandler_addMaterial(JNIEnv *env, jobject obj, jfloatArray baseColor, jint texture)
+{
+    if (env->GetArrayLength(baseColor) < 4 || texture < 0 || static_cast<uint32_t>(texture) >= bindless.getTextureCount())
+    {
+        jclass exceptionClass = env->FindClass("com/github/nodedev74/jfbx/exception/VkRuntimeError");
+        jmethodID constructorID = env->GetMethodID(exceptionClass, "<init>", "(Ljava/lang/String;)V");
+        jstring message = env->NewStringUTF("Material needs four color factors and an added texture");
+        jobject exceptionObject = env->NewObject(exceptionClass, constructorID, message);
+        env->Throw(static_cast<jthrowable>(exceptionObject));
+        return -1;
+    }
+
+    MaterialData material{};
+    env->GetFloatArrayRegion(baseColor, 0, 4, material.baseColor);
+    material.textureIndex = static_cast<uint32_t>(texture);
+    uint32_t index;
+    VkResult result = bindless.addMaterial(material, index);
+    if (result != VK_SUCCESS)
+    {
+        jclass exceptionClass = env->FindClass("com/github/nodedev74/jfbx/exception/VkRuntimeError");
+        jmethodID constructorID = env->GetMethodID(exceptionClass, "<init>", "(Ljava/lang/String;)V");
+        jstring message = env->NewStringUTF("Failed to add material");
+        jint jresult = static_cast<jint>(result);
+        jobject exceptionObject = env->NewObject(exceptionClass, constructorID, message, jresult);
+        env->Throw(static_cast<jthrowable>(exceptionObject));
+        return -1;
+    }
+    return static_cast<jint>(index);
+}
+
+/**
+ * @brief Switches between the bindless set and per material sets.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ * @param enabled False to bind a set per material.
+ */
+JNIEXPORT void JNICALL Java_com_github_nodedev74_jfbx_vulkan_VkHandler_setBindless(JNIEnv *env, jobject obj, jboolean enabled)
+{
+    VkResult result = enabled ? VK_SUCCESS : bindless.prepareMaterialSets();
+    if (result != VK_SUCCESS)
+    {
+        jclass exceptionClass = env->FindClass("com/github/nodedev74/jfbx/exception/VkRuntimeError");
+        jmethodID constructorID = env->GetMethodID(exceptionClass, "<init>", "(Ljava/lang/String;)V");
+        jstring message = env->NewStringUTF("Failed to create material descriptor sets");
+        jint jresult = static_cast<jint>(result);
+        jobject exceptionObject = env->NewObject(exceptionClass, constructorID, message, jresult);
+        env->Throw(static_cast<jthrowable>(exceptionObject));
+        return;
+    }
+    bindlessEnabled = enabled;
+}
+
+/**
+ * @brief Checks whether the device supports the bindless set.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ * @return True if descriptor indexing is enabled.
+ */
+JNIEXPORT jboolean JNICALL Java_com_github_nodedev74_jfbx_vulkan_VkHandler_isBindlessSupported(JNIEnv *env, jobject obj)
+{
+    return descriptorIndexingSupported ? JNI_TRUE : JNI_FALSE;
+}
+
+/**
+ * @brief Retrieves the number of descriptor set binds recorded for the objects of the last prepared frame.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ * @return The bind count.
+ */
+JNIEXPORT jint JNICALL Java_com_github_nodedev74_jfbx_vulkan_VkHandler_getDescriptorBindCount(JNIEnv *env, jobject obj)
+{
+    return static_cast<jint>(descriptorBindCount);
+}
+
+/**
+ * @brief Retrieves the number of texture, buffer and material descriptors written since startup.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ * @return The descriptor write count.
+ */
+JNIEXPORT jlong JNICALL Java_com_github_nodedev74_jfbx_vulkan_VkHandler_getDescriptorWriteCount(JNIEnv *env, jobject obj)
+{
+    return static_cast<jlong>(bindless.getDescriptorWriteCount());
+}
+
+/**
+ * @brief Decodes PNG and TGA files on the worker pool, builds their mip chains and optionally
+ * compresses them.
+ *
+ * Imported textures are looked up in and stored to the cache directory in the textureCache field,
+ * keyed by file content.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ * @param files The encoded image files.
+ * @param blockCompression True to store the textures as BC1 or BC3 where the device supports it.
+ * @param textures Receives the texture per file.
+ * @return False if a file failed to decode, with an exception pending.
+ */
+bool importTextures(JNIEnv *env, jobject obj, jobjectArray files, jboolean blockCompression, std::vector<TextureData> &textures)
+{
+    jsize fileCount = env->GetArrayLength(files);
+    std::vector<std::vector<uint8_t>> contents(fileCount);
+    for (jsize i = 0; i < fileCount; i++)
+    {
+        jbyteArray file = static_cast<jbyteArray>(env->GetObjectArrayElement(files, i));
+        contents[i].resize(env->GetArrayLength(file));
+        env->GetByteArrayRegion(file, 0, static_cast<jsize>(contents[i].size()), reinterpret_cast<jbyte *>(contents[i].data()));
+        env->DeleteLocalRef(file);
+    }
+
+    jclass cls = env->GetObjectClass(obj);
+    jstring cacheDirectory = static_cast<jstring>(env->GetObjectField(obj, env->GetFieldID(cls, "textureCache", "Ljava/lang/String;")));
+    std::string directory;
+    if (cacheDirectory != nullptr)
+    {
+        const char *chars = env->GetStringUTFChars(cacheDirectory, nullptr);
+        directory = chars;
+        env->ReleaseStringUTFChars(cacheDirectory, chars);
+    }
+    TextureCache cache(directory);
+
+    // Decoding, filtering and compression dominate the import, so every file is a task of its own
+    bool compress = blockCompression == JNI_TRUE && textureCompressionSupported;
+    textures.assign(fileCount, TextureData());
+    std::vector<std::string> errors(fileCount);
+    ThreadPool::shared().parallelFor(static_cast<uint32_t>(fileCount), 1, [&](uint32_t begin, uint32_t end)
+                                     {
+        for (uint32_t i = begin; i < end; i++)
+        {
+            // Allocation and length errors of huge images fail their file like a decode error
+            try
+            {
+                uint64_t key = TextureCodec::hash(contents[i].data(), contents[i].size());
+                if (cache.load(key, compress, textures[i]))
+                {
+                    continue;
+                }
+                textures[i] = TextureCodec::import(contents[i].data(), contents[i].size(), compress);
+                cache.store(key, compress, textures[i]);
+            }
+            catch (const std::exception &error)
+            {
+                errors[i] = *error.what() != '\0' ? error.what() : "Unknown error";
+            }
+        } });
+
+    for (jsize i = 0; i < fileCount; i++)
+    {
+        if (!errors[i].empty())
+        {
+            jclass exceptionClass = env->FindClass("com/github/nodedev74/jfbx/exception/VkRuntimeError");
+            jmethodID constructorID = env->GetMethodID(exceptionClass, "<init>", "(Ljava/lang/String;)V");
+            jstring message = env->NewStringUTF(("Failed to decode texture " + std::to_string(i) + ": " + errors[i]).c_str());
+            jobject exceptionObject = env->NewObject(exceptionClass, constructorID, message);
+            env->Throw(static_cast<jthrowable>(exceptionObject));
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Decodes PNG and TGA files on the worker pool, builds their mip chains, optionally
+ * compresses them and uploads them as textures.
+ *
+ * Imported textures are looked up in and stored to the cache directory in the textureCache field,
+ * keyed by file content. Uploads are batched so each staging buffer holds up to 64 MiB.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ * @param files The encoded image files.
+ * @param blockCompression True to store the textures as BC1 or BC3 where the device supports it.
+ * @return The texture index per file.
+ */
+JNIEXPORT jintArray JNICALL Java_com_github_nodedev74_jfbx_vulkan_VkHandler_addEncodedTextures(JNIEnv *env, jobject obj, jobjectArray files, jboolean blockCompression)
+{
+    TRACE_ZONE("VkHandler.addEncodedTextures");
+
+    std::vector<TextureData> textures;
+    if (!importTextures(env, obj, files, blockCompression, textures))
+    {
+        return nullptr;
+    }
+
+    jsize fileCount = static_cast<jsize>(textures.size());
+    const size_t stagingBatchSize = 64ull << 20;
+    std::vector<jint> indices(fileCount);
+    std::vector<uint32_t> batchIndices;
+    for (size_t first = 0; first < textures.size();)
+    {
+        size_t end = first + 1;
+        size_t batchSize = textures[first].bytes.size();
+        while (end < textures.size() && batchSize + textures[end].bytes.size() <= stagingBatchSize)
+        {
+            batchSize += textures[end++].bytes.size();
+        }
+        batchIndices.resize(end - first);
+        VkResult result = bindless.addTextures(queue, commandPool, &textures[first], end - first, nullptr, batchIndices.data());
+        if (result != VK_SUCCESS)
+        {
+            jclass exceptionClass = env->FindClass("com/github/nodedev74/jfbx/exception/VkRuntimeError");
+            jmethodID constructorID = env->GetMethodID(exceptionClass, "<init>", "(Ljava/lang/String;)V");
+            jstring message = env->NewStringUTF("Failed to upload textures");
+            jint jresult = static_cast<jint>(result);
+            jobject exceptionObject = env->NewObject(exceptionClass, constructorID, message, jresult);
+            env->Throw(static_cast<jthrowable>(exceptionObject));
+            return nullptr;
+        }
+        std::copy(batchIndices.begin(), batchIndices.end(), indices.begin() + first);
+        first = end;
+    }
+
+    jintArray array = env->NewIntArray(fileCount);
+    env->SetIntArrayRegion(array, 0, fileCount, indices.data());
+    return array;
+}
+
+/**
+ * @brief Imports textures like addEncodedTextures, but uploads only their mip tails and streams
+ * the finer levels as visible objects need them.
+ *
+ * The residency budget and the upload bandwidth per frame come from the textureBudget and
+ * streamingBandwidth fields, the tail size from streamingTailSize.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ * @param files The encoded image files.
+ * @param blockCompression True to store the textures as BC1 or BC3 where the device supports it.
+ * @return The texture index per file.
+ */
+JNIEXPORT jintArray JNICALL Java_com_github_nodedev74_jfbx_vulkan_VkHandler_addStreamedTextures(JNIEnv *env, jobject obj, jobjectArray files, jboolean blockCompression)
+{
+    TRACE_ZONE("VkHandler.addStreamedTextures");
+
+    std::vector<TextureData> textures;
+    if (!importTextures(env, obj, files, blockCompression, textures))
+    {
+        return nullptr;
+    }
+
+    jclass cls = env->GetObjectClass(obj);
+    jlong budget = env->GetLongField(obj, env->GetFieldID(cls, "textureBudget", "J"));
+    jlong bandwidth = env->GetLongField(obj, env->GetFieldID(cls, "streamingBandwidth", "J"));
+    jint tailSize = env->GetIntField(obj, env->GetFieldID(cls, "streamingTailSize", "I"));
+    textureStreamer.setLimits(static_cast<uint64_t>(budget), static_cast<uint64_t>(bandwidth), static_cast<uint32_t>(tailSize));
+
+    jsize fileCount = static_cast<jsize>(textures.size());
+    std::vector<uint32_t> indices(fileCount);
+    VkResult result = textureStreamer.addTextures(bindless, queue, commandPool, std::move(textures), indices.data());
+    if (result != VK_SUCCESS)
+    {
+        jclass exceptionClass = env->FindClass("com/github/nodedev74/jfbx/exception/VkRuntimeError");
+        jmethodID constructorID = env->GetMethodID(exceptionClass, "<init>", "(Ljava/lang/String;)V");
+        jstring message = env->NewStringUTF("Failed to upload textures");
+        jint jresult = static_cast<jint>(result);
+        jobject exceptionObject = env->NewObject(exceptionClass, constructorID, message, jresult);
+        env->Throw(static_cast<jthrowable>(exceptionObject));
+        return nullptr;
+    }
+
+    jintArray array = env->NewIntArray(fileCount);
+    env->SetIntArrayRegion(array, 0, fileCount, reinterpret_cast<const jint *>(indices.data()));
+    return array;
+}
+
+/**
+ * @brief Checks whether textures can be block compressed.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ * @return True if the device supports BC formats.
+ */
+JNIEXPORT jboolean JNICALL Java_com_github_nodedev74_jfbx_vulkan_VkHandler_isTextureCompressionSupported(JNIEnv *env, jobject obj)
+{
+    return textureCompressionSupported ? JNI_TRUE : JNI_FALSE;
+}
+
+/**
+ * @brief Retrieves the device memory allocated for textures, including their mip levels.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ * @return The size in bytes.
+ */
+JNIEXPORT jlong JNICALL Java_com_github_nodedev74_jfbx_vulkan_VkHandler_getTextureMemory(JNIEnv *env, jobject obj)
+{
+    return static_cast<jlong>(bindless.getTextureMemory());
+}
+
+/**
+ * @brief Retrieves the asset loader, starting its workers on first use. Only the load functions
+ * create the loader, queries before the first load answer as for an unknown handle.
+ *
+ * The worker count comes from the assetThreads field, the upload budget per frame from
+ * assetUploadBudget and the texture cache directory from textureCache.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ * @return The asset loader.
+ */
+AssetLoader &getAssetLoader(JNIEnv *env, jobject obj)
+{
+    if (assetLoader == nullptr)
+    {
+        jclass cls = env->GetObjectClass(obj);
+        jint threadCount = env->GetIntField(obj, env->GetFieldID(cls, "assetThreads", "I"));
+        assetUploadBudget = static_cast<uint64_t>(env->GetLongField(obj, env->GetFieldID(cls, "assetUploadBudget", "J")));
+        jstring cacheDirectory = static_cast<jstring>(env->GetObjectField(obj, env->GetFieldID(cls, "textureCache", "Ljava/lang/String;")));
+        std::string directory;
+        if (cacheDirectory != nullptr)
+        {
+            const char *chars = env->GetStringUTFChars(cacheDirectory, nullptr);
+            directory = chars;
+            env->ReleaseStringUTFChars(cacheDirectory, chars);
+        }
+        assetLoader = std::make_unique<AssetLoader>(static_cast<uint32_t>(std::max(threadCount, 0)), directory);
+    }
+    return *assetLoader;
+}
+
+/**
+ * @brief Requests a binary FBX file with its meshes, materials and textures in the background.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ * @param path The file path.
+ * @param priority Higher priorities are processed and uploaded first.
+ * @param blockCompression True to store the textures as BC1 or BC3 where the device supports it.
+ * @return The asset handle.
+ */
+JNIEXPORT jint JNICALL Java_com_github_nodedev74_jfbx_vulkan_VkHandler_loadScene(JNIEnv *env, jobject obj, jstring path, jint priority, jboolean blockCompression)
+{
+    const char *chars = env->GetStringUTFChars(path, nullptr);
+    std::string filePath(chars);
+    env->ReleaseStringUTFChars(path, chars);
+    return static_cast<jint>(getAssetLoader(env, obj).loadScene(filePath, priority, blockCompression == JNI_TRUE && textureCompressionSupported));
+}
+
+/**
+ * @brief Requests an encoded PNG or TGA texture in the background.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ * @param file The file content.
+ * @param priority Higher priorities are processed and uploaded first.
+ * @param blockCompression True to store the texture as BC1 or BC3 where the device supports it.
+ * @return The asset handle.
+ */
+JNIEXPORT jint JNICALL Java_com_github_nodedev74_jfbx_vulkan_VkHandler_loadTexture(JNIEnv *env, jobject obj, jbyteArray file, jint priority, jboolean blockCompression)
+{
+    std::vector<uint8_t> content(env->GetArrayLength(file));
+    env->GetByteArrayRegion(file, 0, static_cast<jsize>(content.size()), reinterpret_cast<jbyte *>(content.data()));
+    return static_cast<jint>(getAssetLoader(env, obj).loadTexture(std::move(content), priority, blockCompression == JNI_TRUE && textureCompressionSupported));
+}
+
+/**
+ * @brief Requests a triangle mesh in the background.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ * @param positions Three floats per vertex.
+ * @param indices Three vertex indices per triangle.
+ * @param priority Higher priorities are processed and uploaded first.
+ * @return The asset handle.
+ */
+JNIEXPORT jint JNICALL Java_com_github_nodedev74_jfbx_vulkan_VkHandler_loadMesh(JNIEnv *env, jobject obj, jfloatArray positions, jintArray indices, jint priority)
+{
+    std::vector<float> positionValues(env->GetArrayLength(positions));
+    env->GetFloatArrayRegion(positions, 0, static_cast<jsize>(positionValues.size()), positionValues.data());
+    std::vector<uint32_t> indexValues(env->GetArrayLength(indices));
+    env->GetIntArrayRegion(indices, 0, static_cast<jsize>(indexValues.size()), reinterpret_cast<jint *>(indexValues.data()));
+    return static_cast<jint>(getAssetLoader(env, obj).loadMesh(std::move(positionValues), std::move(indexValues), priority));
+}
+
+/**
+ * @brief Changes the priority of an asset.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ * @param asset The asset handle.
+ * @param priority The new priority.
+ */
+JNIEXPORT void JNICALL Java_com_github_nodedev74_jfbx_vulkan_VkHandler_setAssetPriority(JNIEnv *env, jobject obj, jint asset, jint priority)
+{
+    if (assetLoader != nullptr)
+    {
+        assetLoader->setPriority(static_cast<uint32_t>(asset), priority);
+    }
+}
+
+/**
+ * @brief Cancels an asset.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ * @param asset The asset handle.
+ * @return False if the asset is unknown or already ended.
+ */
+JNIEXPORT jboolean JNICALL Java_com_github_nodedev74_jfbx_vulkan_VkHandler_cancelAsset(JNIEnv *env, jobject obj, jint asset)
+{
+    return assetLoader != nullptr && assetLoader->cancel(static_cast<uint32_t>(asset)) ? JNI_TRUE : JNI_FALSE;
+}
+
+/**
+ * @brief Retrieves the state of an asset.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ * @param asset The asset handle.
+ * @return The AssetState value.
+ */
+JNIEXPORT jint JNICALL Java_com_github_nodedev74_jfbx_vulkan_VkHandler_getAssetState(JNIEnv *env, jobject obj, jint asset)
+{
+    AssetState state = assetLoader != nullptr ? assetLoader->getState(static_cast<uint32_t>(asset)) : AssetState::Failed;
+    return static_cast<jint>(state);
+}
+
+/**
+ * @brief Retrieves the progress of an asset.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ * @param asset The asset handle.
+ * @return The progress from 0 to 1, parsing ends at 0.4 and processing at 0.8.
+ */
+JNIEXPORT jfloat JNICALL Java_com_github_nodedev74_jfbx_vulkan_VkHandler_getAssetProgress(JNIEnv *env, jobject obj, jint asset)
+{
+    std::shared_ptr<Asset> loaded = assetLoader != nullptr ? assetLoader->get(static_cast<uint32_t>(asset)) : nullptr;
+    return loaded != nullptr ? loaded->progress.load() : 0.0f;
+}
+
+/**
+ * @brief Retrieves the reason an asset failed.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ * @param asset The asset handle.
+ * @return The message, or null if the asset did not fail.
+ */
+JNIEXPORT jstring JNICALL Java_com_github_nodedev74_jfbx_vulkan_VkHandler_getAssetError(JNIEnv *env, jobject obj, jint asset)
+{
+    if (assetLoader == nullptr)
+    {
+        return nullptr;
+    }
+    std::shared_ptr<Asset> loaded = assetLoader->get(static_cast<uint32_t>(asset));
+    if (loaded == nullptr || assetLoader->getState(static_cast<uint32_t>(asset)) != AssetState::Failed)
+    {
+        return nullptr;
+    }
+    return env->NewStringUTF(loaded->error.c_str());
+}
+
+/**
+ * @brief Converts device indices recorded by the upload of an asset into a Java array.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ * @param asset The asset handle.
+ * @param member The recorded indices.
+ * @return The indices, empty unless the asset is complete.
+ */
+jintArray getAssetIndices(JNIEnv *env, jobject obj, jint asset, std::vector<int32_t> Asset::*member)
+{
+    if (assetLoader == nullptr)
+    {
+        return env->NewIntArray(0);
+    }
+    std::shared_ptr<Asset> loaded = assetLoader->get(static_cast<uint32_t>(asset));
+    if (loaded == nullptr || assetLoader->getState(static_cast<uint32_t>(asset)) != AssetState::Complete)
+    {
+        return env->NewIntArray(0);
+    }
+    const std::vector<int32_t> &indices = (*loaded).*member;
+    jintArray array = env->NewIntArray(static_cast<jsize>(indices.size()));
+    env->SetIntArrayRegion(array, 0, static_cast<jsize>(indices.size()), indices.data());
+    return array;
+}
+
+/**
+ * @brief Retrieves the texture indices of a complete asset.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ * @param asset The asset handle.
+ * @return The texture index per decoded texture.
+ */
+JNIEXPORT jintArray JNICALL Java_com_github_nodedev74_jfbx_vulkan_VkHandler_getAssetTextures(JNIEnv *env, jobject obj, jint asset)
+{
+    return getAssetIndices(env, obj, asset, &Asset::textureIndices);
+}
+
+/**
+ * @brief Retrieves the material indices of a complete scene asset.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ * @param asset The asset handle.
+ * @return The material index per scene material.
+ */
+JNIEXPORT jintArray JNICALL Java_com_github_nodedev74_jfbx_vulkan_VkHandler_getAssetMaterials(JNIEnv *env, jobject obj, jint asset)
+{
+    return getAssetIndices(env, obj, asset, &Asset::materialIndices);
+}
+
+/**
+ * @brief Retrieves the mesh ids of a complete scene or mesh asset.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ * @param asset The asset handle.
+ * @return The mesh id per scene mesh, -1 for meshes without triangles.
+ */
+JNIEXPORT jintArray JNICALL Java_com_github_nodedev74_jfbx_vulkan_VkHandler_getAssetMeshes(JNIEnv *env, jobject obj, jint asset)
+{
+    return getAssetIndices(env, obj, asset, &Asset::meshIndices);
+}
+
+/**
+ * @brief Takes the imported scene of a complete scene asset. The caller owns the scene.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ * @param asset The asset handle.
+ * @return The FbxScene, or null if the asset is no complete scene or was taken before.
+ */
+JNIEXPORT jobject JNICALL Java_com_github_nodedev74_jfbx_vulkan_VkHandler_takeAssetScene(JNIEnv *env, jobject obj, jint asset)
+{
+    if (assetLoader == nullptr)
+    {
+        return nullptr;
+    }
+    std::shared_ptr<Asset> loaded = assetLoader->get(static_cast<uint32_t>(asset));
+    if (loaded == nullptr || assetLoader->getState(static_cast<uint32_t>(asset)) != AssetState::Complete || loaded->scene == nullptr)
+    {
+        return nullptr;
+    }
+    jclass sceneClass = env->FindClass("com/github/nodedev74/jfbx/fbx/FbxScene");
+    jmethodID constructorID = env->GetMethodID(sceneClass, "<init>", "(J)V");
+    return env->NewObject(sceneClass, constructorID, reinterpret_cast<jlong>(loaded->scene.release()));
+}
+
+/**
+ * @brief Forgets an asset, cancelling it if it has not ended yet. Uploaded resources stay.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ * @param asset The asset handle.
+ */
+JNIEXPORT void JNICALL Java_com_github_nodedev74_jfbx_vulkan_VkHandler_releaseAsset(JNIEnv *env, jobject obj, jint asset)
+{
+    if (assetLoader != nullptr)
+    {
+        assetLoader->release(static_cast<uint32_t>(asset));
+    }
+}
+
+/**
+ * @brief Retrieves the bytes of the resident mip levels of all streamed textures.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ * @return The size in bytes.
+ */
+JNIEXPORT jlong JNICALL Java_com_github_nodedev74_jfbx_vulkan_VkHandler_getStreamingResidentBytes(JNIEnv *env, jobject obj)
+{
+    return static_cast<jlong>(textureStreamer.getResidentBytes());
+}
+
+/**
+ * @brief Retrieves the bytes of mip levels streamed in since the streamed textures were added.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ * @return The size in bytes.
+ */
+JNIEXPORT jlong JNICALL Java_com_github_nodedev74_jfbx_vulkan_VkHandler_getStreamedBytes(JNIEnv *env, jobject obj)
+{
+    return static_cast<jlong>(textureStreamer.getStreamedBytes());
+}
+
+/**
+ * @brief Retrieves the number of mip levels evicted to stay within the texture budget.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ * @return The level count.
+ */
+JNIEXPORT jlong JNICALL Java_com_github_nodedev74_jfbx_vulkan_VkHandler_getEvictedLevelCount(JNIEnv *env, jobject obj)
+{
+    return static_cast<jlong>(textureStreamer.getEvictedLevelCount());
+}
+
+/**
+ * @brief Retrieves the number of streamed textures the last prepared frame sampled at a coarser
+ * level than its objects need.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ * @return The texture count.
+ */
+JNIEXPORT jint JNICALL Java_com_github_nodedev74_jfbx_vulkan_VkHandler_getReducedQualityTextureCount(JNIEnv *env, jobject obj)
+{
+    return static_cast<jint>(textureStreamer.getReducedQualityCount());
+}
+
+/**
+ * @brief Retrieves the number of objects the occlusion test rejected in the last completed use of
+ * the frame slot prepared last.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ * @return The occluded count.
+ */
+JNIEXPORT jint JNICALL Java_com_github_nodedev74_jfbx_vulkan_VkHandler_getOccludedCount(JNIEnv *env, jobject obj)
+{
+    return static_cast<jint>(occludedCount);
+}
+
+/**
+ * @brief Renders the Vulkan scene.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ */
+JNIEXPORT void JNICALL Java_com_github_nodedev74_jfbx_vulkan_VkHandler_render(JNIEnv *env, jobject obj)
+{
+    TRACE_ZONE("VkHandler.render");
+
+    jclass cls = env->GetObjectClass(obj);
+
+    if (headless)
+    {
+        jclass exceptionClass = env->FindClass("com/github/nodedev74/jfbx/exception/VkRuntimeError");
+        jmethodID constructorID = env->GetMethodID(exceptionClass, "<init>", "(Ljava/lang/String;)V");
+        jstring message = env->NewStringUTF("render() requires a window, use submitOffscreen() in headless mode");
+        jobject exceptionObject = env->NewObject(exceptionClass, constructorID, message);
+        env->Throw(static_cast<jthrowable>(exceptionObject));
+        return;
+    }
+
+    uint32_t imageIndex = 0;
+    VkResult res = vkAcquireNextImageKHR(device, swapchain, UINT64_MAX, semaphores[0], VK_NULL_HANDLE, &imageIndex);
+    if (res == VK_ERROR_OUT_OF_DATE_KHR)
+    {
+        // Nothing was acquired, the frame is skipped and the next call renders to the new swapchain
+        Java_com_github_nodedev74_jfbx_vulkan_VkHandler_recreateSwapchain(env, obj);
+        return;
+    }
+    // A suboptimal image is still acquired and its semaphore signaled, so it is rendered and presented first
+    bool outdated = res == VK_SUBOPTIMAL_KHR;
+    if (res != VK_SUCCESS && !outdated)
+    {
+        jclass exceptionClass = env->FindClass("com/github/nodedev74/jfbx/exception/VkRuntimeError");
+        jmethodID constructorID = env->GetMethodID(exceptionClass, "<init>", "(Ljava/lang/String;)V");
+        jstring message = env->NewStringUTF("Failed to acquire the next swapchain image");
+        jint jresult = static_cast<jint>(res);
+        jobject exceptionObject = env->NewObject(exceptionClass, constructorID, message, jresult);
+        env->Throw(static_cast<jthrowable>(exceptionObject));
+        return;
+    }
+
+    vkWaitForFences(device, 1, &frameFences[imageIndex], VK_TRUE, UINT64_MAX);
+    vkResetFences(device, 1, &frameFences[imageIndex]);
+    profiler.collect(imageIndex);
+    uploadWorldMatrices(imageIndex);
+    VkResult streamingResult = prepareFrame(imageIndex);
+
+    VkPipelineStageFlags pipelineStageFlags = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
+    VkSubmitInfo submitInfo = {
+        VK_STRUCTURE_TYPE_SUBMIT_INFO,
+        nullptr,
+        1,
+        &semaphores[0],
+        &pipelineStageFlags,
+        1,
+        &commandBuffers[imageIndex],
+        1,
+        &semaphores[1]};
+    vkQueueSubmit(queue, 1, &submitInfo, frameFences[imageIndex]);
+    profiler.submitted(imageIndex);
+
+    VkPresentInfoKHR presentInfo = {
+        VK_STRUCTURE_TYPE_PRESENT_INFO_KHR,
+        nullptr,
+        1,
+        &semaphores[1],
+        1,
+        &swapchain,
+        &imageIndex};
+
+    auto presentStart = std::chrono::steady_clock::now();
+    res = vkQueuePresentKHR(queue, &presentInfo);
+    presentTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - presentStart).count();
+    if (res == VK_ERROR_OUT_OF_DATE_KHR || res == VK_SUBOPTIMAL_KHR || (res == VK_SUCCESS && outdated))
+    {
+        Java_com_github_nodedev74_jfbx_vulkan_VkHandler_recreateSwapchain(env, obj);
+    }
+    else if (res != VK_SUCCESS)
+    {
+        jclass exceptionClass = env->FindClass("com/github/nodedev74/jfbx/exception/VkRuntimeError");
+        jmethodID constructorID = env->GetMethodID(exceptionClass, "<init>", "(Ljava/lang/String;)V");
+        jstring message = env->NewStringUTF("Failed to present the swapchain image");
+        jint jresult = static_cast<jint>(res);
+        jobject exceptionObject = env->NewObject(exceptionClass, constructorID, message, jresult);
+        env->Throw(static_cast<jthrowable>(exceptionObject));
+        return;
+    }
+    // The frame was still rendered and presented with the previous resident levels
+    if (streamingResult != VK_SUCCESS && !env->ExceptionCheck())
+    {
+        jclass exceptionClass = env->FindClass("com/github/nodedev74/jfbx/exception/VkRuntimeError");
+        jmethodID constructorID = env->GetMethodID(exceptionClass, "<init>", "(Ljava/lang/String;)V");
+        jstring message = env->NewStringUTF("Failed to stream texture levels, the resident levels stay unchanged");
+        jint jresult = static_cast<jint>(streamingResult);
+        jobject exceptionObject = env->NewObject(exceptionClass, constructorID, message, jresult);
+        env->Throw(static_cast<jthrowable>(exceptionObject));
+    }
+}
+
+/**
+ * @brief Recreates the swapchain and the objects that reference its images, as after an out of date swapchain.
+ *
+ * The window keeps its size and surface format, so the depth attachment, the occlusion pyramid and
+ * the pipelines stay valid. The color image views are rebuilt, and without dynamic rendering one
+ * framebuffer per image. In headless mode the offscreen images are kept and only the views and
+ * framebuffers are rebuilt. Every frame slot is recorded again.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ */
+JNIEXPORT void JNICALL Java_com_github_nodedev74_jfbx_vulkan_VkHandler_recreateSwapchain(JNIEnv *env, jobject obj)
+{
+    TRACE_ZONE("VkHandler.recreateSwapchain");
+
+    vkDeviceWaitIdle(device);
+    auto recreateStart = std::chrono::steady_clock::now();
+    destroyAttachmentViews();
+
+    if (!headless)
+    {
+        swapchainCreateInfo.oldSwapchain = swapchain;
+        VkSwapchainKHR newSwapchain = VK_NULL_HANDLE;
+        VkResult result = vkCreateSwapchainKHR(device, &swapchainCreateInfo, nullptr, &newSwapchain);
+        vkDestroySwapchainKHR(device, swapchainCreateInfo.oldSwapchain, nullptr);
+        swapchainCreateInfo.oldSwapchain = VK_NULL_HANDLE;
+        swapchain = newSwapchain;
+
+        uint32_t imageCount = 0;
+        if (result == VK_SUCCESS)
+        {
+            vkGetSwapchainImagesKHR(device, swapchain, &imageCount, nullptr);
+        }
+        // The frame slots, their command buffers and ring regions follow the image count
+        if (result != VK_SUCCESS || imageCount != swapchainImagesCount)
+        {
+            jclass exceptionClass = env->FindClass("com/github/nodedev74/jfbx/exception/VkRuntimeError");
+            jmethodID constructorID = env->GetMethodID(exceptionClass, "<init>", "(Ljava/lang/String;)V");
+            jstring message = env->NewStringUTF("Failed to recreate VkSwapchainKHR with the same image count");
+            jint jresult = static_cast<jint>(result);
+            jobject exceptionObject = env->NewObject(exceptionClass, constructorID, message, jresult);
+            env->Throw(static_cast<jthrowable>(exceptionObject));
+            return;
+        }
+        vkGetSwapchainImagesKHR(device, swapchain, &swapchainImagesCount, swapchainImages.data());
+        for (uint32_t i = 0; i < swapchainImagesCount; i++)
+        {
+            renderGraph.setImage(colorResource, i, swapchainImages[i], {VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1});
+        }
+    }
+
+    createAttachmentViews();
+    for (uint32_t i = 0; i < swapchainImagesCount; i++)
+    {
+        recordFrame(i);
+    }
+    swapchainRecreateTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - recreateStart).count();
+}
+
+/**
+ * @brief Submits the next offscreen frame.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ * @return The slot the frame has been submitted to.
+ */
+JNIEXPORT jint JNICALL Java_com_github_nodedev74_jfbx_vulkan_VkHandler_submitOffscreen(JNIEnv *env, jobject obj)
+{
+    TRACE_ZONE("VkHandler.submitOffscreen");
+
+    if (!headless)
+    {
+        jclass exceptionClass = env->FindClass("com/github/nodedev74/jfbx/exception/VkRuntimeError");
+        jmethodID constructorID = env->GetMethodID(exceptionClass, "<init>", "(Ljava/lang/String;)V");
+        jstring message = env->NewStringUTF("submitOffscreen() requires headless mode, use render() with a window");
+        jobject exceptionObject = env->NewObject(exceptionClass, constructorID, message);
+        env->Throw(static_cast<jthrowable>(exceptionObject));
+        return -1;
+    }
+
+    uint32_t slot = nextOffscreenSlot;
+    nextOffscreenSlot = (nextOffscreenSlot + 1) % swapchainImagesCount;
+
+    vkWaitForFences(device, 1, &readbackFences[slot], VK_TRUE, UINT64_MAX);
+    vkResetFences(device, 1, &readbackFences[slot]);
+    profiler.collect(slot);
+    uploadWorldMatrices(slot);
+    VkResult streamingResult = prepareFrame(slot);
+
+    VkSubmitInfo submitInfo = {
+        VK_STRUCTURE_TYPE_SUBMIT_INFO,
+        nullptr,
+        0,
+        nullptr,
+        nullptr,
+        1,
+        &commandBuffers[slot],
+        0,
+        nullptr};
+
+    VkResult res = vkQueueSubmit(queue, 1, &submitInfo, readbackFences[slot]);
+    profiler.submitted(slot);
+    if (res != VK_SUCCESS)
+    {
+        jclass exceptionClass = env->FindClass("com/github/nodedev74/jfbx/exception/VkRuntimeError");
+        jmethodID constructorID = env->GetMethodID(exceptionClass, "<init>", "(Ljava/lang/String;)V");
+        jstring message = env->NewStringUTF("Failed to submit offscreen frame");
+        jint jresult = static_cast<jint>(res);
+        jobject exceptionObject = env->NewObject(exceptionClass, constructorID, message, jresult);
+        env->Throw(static_cast<jthrowable>(exceptionObject));
+    }
+    else if (streamingResult != VK_SUCCESS)
+    {
+        // The frame was still submitted with the previous resident levels
+        jclass exceptionClass = env->FindClass("com/github/nodedev74/jfbx/exception/VkRuntimeError");
+        jmethodID constructorID = env->GetMethodID(exceptionClass, "<init>", "(Ljava/lang/String;)V");
+        jstring message = env->NewStringUTF("Failed to stream texture levels, the resident levels stay unchanged");
+        jint jresult = static_cast<jint>(streamingResult);
+        jobject exceptionObject = env->NewObject(exceptionClass, constructorID, message, jresult);
+        env->Throw(static_cast<jthrowable>(exceptionObject));
+    }
+    return static_cast<jint>(slot);
+}
+
+/**
+ * @brief Waits for an offscreen frame and returns its pixels.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ * @param slot The slot returned by submitOffscreen.
+ * @return A direct ByteBuffer on the mapped readback memory of the slot.
+ */
+JNIEXPORT jobject JNICALL Java_com_github_nodedev74_jfbx_vulkan_VkHandler_readback(JNIEnv *env, jobject obj, jint slot)
+{
+    TRACE_ZONE("VkHandler.readback");
+
+    if (slot < 0 || static_cast<size_t>(slot) >= readbackFences.size())
+    {
+        jclass exceptionClass = env->FindClass("com/github/nodedev74/jfbx/exception/VkRuntimeError");
+        jmethodID constructorID = env->GetMethodID(exceptionClass, "<init>", "(Ljava/lang/String;)V");
+        jstring message = env->NewStringUTF("Invalid readback slot");
+        jobject exceptionObject = env->NewObject(exceptionClass, constructorID, message);
+        env->Throw(static_cast<jthrowable>(exceptionObject));
+        return nullptr;
+    }
+
+    vkWaitForFences(device, 1, &readbackFences[slot], VK_TRUE, UINT64_MAX);
+    // Transfers submitted before the frame have completed as well, textures replaced by an eviction are freed
+    bindless.releaseTransfers();
+    meshArena.releaseUploads();
+
+    VkMappedMemoryRange mappedMemoryRange = {VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE, nullptr, readbackMemories[slot], 0, VK_WHOLE_SIZE};
+    vkInvalidateMappedMemoryRanges(device, 1, &mappedMemoryRange);
+
+    return env->NewDirectByteBuffer(readbackDataPointers[slot], static_cast<jlong>(readbackSize));
+}
+
+/**
+ * @brief Checks if the GPU profiler can write timestamps.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ * @return True if timestamp queries are supported.
+ */
+JNIEXPORT jboolean JNICALL Java_com_github_nodedev74_jfbx_vulkan_VkHandler_isGpuProfilingSupported(JNIEnv *env, jobject obj)
+{
+    return profiler.isSupported() ? JNI_TRUE : JNI_FALSE;
+}
+
+/**
+ * @brief Retrieves the names of the GPU profiler scopes.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ * @return The scope names in recording order.
+ */
+JNIEXPORT jobjectArray JNICALL Java_com_github_nodedev74_jfbx_vulkan_VkHandler_getGpuScopeNames(JNIEnv *env, jobject obj)
+{
+    const std::vector<std::string> &names = profiler.getScopeNames();
+    jobjectArray array = env->NewObjectArray(static_cast<jsize>(names.size()), env->FindClass("java/lang/String"), nullptr);
+    for (size_t i = 0; i < names.size(); i++)
+    {
+        jstring name = env->NewStringUTF(names[i].c_str());
+        env->SetObjectArrayElement(array, static_cast<jsize>(i), name);
+        env->DeleteLocalRef(name);
+    }
+    return array;
+}
+
+/**
+ * @brief Retrieves the GPU scope durations of the last completed frame.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ * @return The durations in milliseconds, in the order of the scope names.
+ */
+JNIEXPORT jdoubleArray JNICALL Java_com_github_nodedev74_jfbx_vulkan_VkHandler_getGpuScopeTimes(JNIEnv *env, jobject obj)
+{
+    const std::vector<double> &timings = profiler.getTimings();
+    jdoubleArray array = env->NewDoubleArray(static_cast<jsize>(timings.size()));
+    env->SetDoubleArrayRegion(array, 0, static_cast<jsize>(timings.size()), timings.data());
+    return array;
+}
+
+/**
+ * @brief Retrieves the pipeline statistics of the last completed frame.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ * @return The pipeline statistics, empty if they are not collected.
+ */
+JNIEXPORT jlongArray JNICALL Java_com_github_nodedev74_jfbx_vulkan_VkHandler_getPipelineStatistics(JNIEnv *env, jobject obj)
+{
+    if (!profiler.hasStatistics())
+    {
+        return env->NewLongArray(0);
+    }
+
+    const std::vector<uint64_t> &statistics = profiler.getStatistics();
+    std::vector<jlong> values(statistics.begin(), statistics.end());
+    jlongArray array = env->NewLongArray(static_cast<jsize>(values.size()));
+    env->SetLongArrayRegion(array, 0, static_cast<jsize>(values.size()), values.data());
+    return array;
+}
+
+/**
+ * @brief Retrieves the CPU time spent in the last present call.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ * @return The present time in milliseconds.
+ */
+JNIEXPORT jdouble JNICALL Java_com_github_nodedev74_jfbx_vulkan_VkHandler_getPresentTime(JNIEnv *env, jobject obj)
+{
+    return presentTime;
+}
+
+/**
+ * @brief Retrieves the CPU time spent culling, writing the draw list and recording the last prepared frame.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ * @return The record time in milliseconds.
+ */
+JNIEXPORT jdouble JNICALL Java_com_github_nodedev74_jfbx_vulkan_VkHandler_getRecordTime(JNIEnv *env, jobject obj)
+{
+    return recordTime;
+}
+
+/**
+ * @brief Retrieves the CPU time spent writing the world matrices of the last frame into its ring region.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ * @return The write time in milliseconds.
+ */
+JNIEXPORT jdouble JNICALL Java_com_github_nodedev74_jfbx_vulkan_VkHandler_getMatrixWriteTime(JNIEnv *env, jobject obj)
+{
+    return matrixWriteTime;
+}
+
+/**
+ * @brief Retrieves the number of barriers the render graph recorded for the last recorded frame.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ * @return The barrier count.
+ */
+JNIEXPORT jint JNICALL Java_com_github_nodedev74_jfbx_vulkan_VkHandler_getBarrierCount(JNIEnv *env, jobject obj)
+{
+    return static_cast<jint>(renderGraph.getBarrierCount());
+}
+
+/**
+ * @brief Retrieves the number of barrier commands the render graph recorded for the last recorded frame.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ * @return The barrier command count.
+ */
+JNIEXPORT jint JNICALL Java_com_github_nodedev74_jfbx_vulkan_VkHandler_getBarrierBatchCount(JNIEnv *env, jobject obj)
+{
+    return static_cast<jint>(renderGraph.getBarrierBatchCount());
+}
+
+/**
+ * @brief Retrieves the number of passes the render graph culled from the last recorded frame.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ * @return The culled pass count.
+ */
+JNIEXPORT jint JNICALL Java_com_github_nodedev74_jfbx_vulkan_VkHandler_getCulledPassCount(JNIEnv *env, jobject obj)
+{
+    return static_cast<jint>(renderGraph.getCulledPassCount());
+}
+
+/**
+ * @brief Retrieves the size of the memory shared by the transient images of the render graph.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ * @return The size in bytes.
+ */
+JNIEXPORT jlong JNICALL Java_com_github_nodedev74_jfbx_vulkan_VkHandler_getTransientMemory(JNIEnv *env, jobject obj)
+{
+    return static_cast<jlong>(renderGraph.getTransientMemory());
+}
+
+/**
+ * @brief Retrieves the memory saved by sharing the transient images instead of one image per frame slot.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ * @return The size in bytes.
+ */
+JNIEXPORT jlong JNICALL Java_com_github_nodedev74_jfbx_vulkan_VkHandler_getTransientMemorySaved(JNIEnv *env, jobject obj)
+{
+    return static_cast<jlong>(renderGraph.getTransientBytes() * swapchainImagesCount - renderGraph.getTransientMemory());
+}
+
+/**
+ * @brief Checks whether frames render without render pass and framebuffer objects.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ * @return True if dynamic rendering is enabled and supported.
+ */
+JNIEXPORT jboolean JNICALL Java_com_github_nodedev74_jfbx_vulkan_VkHandler_isDynamicRenderingSupported(JNIEnv *env, jobject obj)
+{
+    return dynamicRenderingSupported ? JNI_TRUE : JNI_FALSE;
+}
+
+/**
+ * @brief Retrieves the CPU time of the last swapchain recreation.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ * @return The recreation time in milliseconds.
+ */
+JNIEXPORT jdouble JNICALL Java_com_github_nodedev74_jfbx_vulkan_VkHandler_getSwapchainRecreateTime(JNIEnv *env, jobject obj)
+{
+    return swapchainRecreateTime;
+}
+
+/**
+ * @brief Retrieves the number of graphics pipelines created so far.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ * @return The pipeline count.
+ */
+JNIEXPORT jint JNICALL Java_com_github_nodedev74_jfbx_vulkan_VkHandler_getPipelineCreateCount(JNIEnv *env, jobject obj)
+{
+    return static_cast<jint>(pipelineCreateCount);
+}
+
+/**
+ * @brief Checks whether the memory budgets come from VK_EXT_memory_budget.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ * @return True if the extension is enabled.
+ */
+JNIEXPORT jboolean JNICALL Java_com_github_nodedev74_jfbx_vulkan_VkHandler_isMemoryBudgetSupported(JNIEnv *env, jobject obj)
+{
+    return memoryTracker.isBudgetSupported() ? JNI_TRUE : JNI_FALSE;
+}
+
+/**
+ * @brief Retrieves the device memory allocated for a category.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ * @param category The category, one of the VkMemoryCategory constants.
+ * @return The size in bytes, 0 for an unknown category.
+ */
+JNIEXPORT jlong JNICALL Java_com_github_nodedev74_jfbx_vulkan_VkHandler_getCategoryMemory(JNIEnv *env, jobject obj, jint category)
+{
+    if (category < 0 || static_cast<uint32_t>(category) >= MEMORY_CATEGORY_COUNT)
+    {
+        return 0;
+    }
+    return static_cast<jlong>(memoryTracker.getCategoryBytes(static_cast<MemoryCategory>(category)));
+}
+
+/**
+ * @brief Retrieves the budget of the device local heaps.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ * @return The size in bytes.
+ */
+JNIEXPORT jlong JNICALL Java_com_github_nodedev74_jfbx_vulkan_VkHandler_getMemoryBudget(JNIEnv *env, jobject obj)
+{
+    uint64_t budget = 0;
+    for (uint32_t i = 0; i < memoryTracker.getHeapCount(); i++)
+    {
+        if (memoryTracker.getMemoryProperties().memoryHeaps[i].flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT)
+        {
+            budget += memoryTracker.getHeapBudget(i);
+        }
+    }
+    return static_cast<jlong>(budget);
+}
+
+/**
+ * @brief Retrieves the usage of the device local heaps the budget is checked against.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ * @return The size in bytes.
+ */
+JNIEXPORT jlong JNICALL Java_com_github_nodedev74_jfbx_vulkan_VkHandler_getMemoryUsage(JNIEnv *env, jobject obj)
+{
+    uint64_t usage = 0;
+    for (uint32_t i = 0; i < memoryTracker.getHeapCount(); i++)
+    {
+        if (memoryTracker.getMemoryProperties().memoryHeaps[i].flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT)
+        {
+            usage += memoryTracker.getHeapUsage(i);
+        }
+    }
+    return static_cast<jlong>(usage);
+}
+
+/**
+ * @brief Retrieves the number of times resources were evicted to stay within the budget.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ * @return The eviction count.
+ */
+JNIEXPORT jlong JNICALL Java_com_github_nodedev74_jfbx_vulkan_VkHandler_getEvictionCount(JNIEnv *env, jobject obj)
+{
+    return static_cast<jlong>(memoryTracker.getEvictionCount());
+}
+
+/**
+ * @brief Retrieves the device memory freed by evictions.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ * @return The size in bytes.
+ */
+JNIEXPORT jlong JNICALL Java_com_github_nodedev74_jfbx_vulkan_VkHandler_getEvictedMemory(JNIEnv *env, jobject obj)
+{
+    return static_cast<jlong>(memoryTracker.getEvictedBytes());
+}
+
+/**
+ * @brief Retrieves the number of allocations refused because their heap stayed over budget.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ * @return The refused allocation count.
+ */
+JNIEXPORT jlong JNICALL Java_com_github_nodedev74_jfbx_vulkan_VkHandler_getRefusedAllocationCount(JNIEnv *env, jobject obj)
+{
+    return static_cast<jlong>(memoryTracker.getRefusedCount());
+}
+
+/**
+ * @brief Destroys the Vulkan resources.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ */
+JNIEXPORT void JNICALL Java_com_github_nodedev74_jfbx_vulkan_VkHandler_destroy(JNIEnv *env, jobject obj)
+{
+    TRACE_ZONE("VkHandler.destroy");
+
+    jclass cls = env->GetObjectClass(obj);
+    jfieldID fieldID = env->GetFieldID(cls, "sdlWindowPtr", "J");
+    jlong sdlWindowPtr = env->GetLongField(obj, fieldID);
+    SDL_Window *sdlWindow = reinterpret_cast<SDL_Window *>(sdlWindowPtr);
+
+    assetLoader.reset();
+    vkDeviceWaitIdle(device);
+    profiler.destroy();
+    skinning.destroy();
+    occlusion.destroy();
+    vkDestroyPipeline(device, pipeline, nullptr);
+    vkDestroyPipelineLayout(device, pipelineLayout, nullptr);
+    vkDestroyPipeline(device, meshPipeline, nullptr);
+    vkDestroyPipeline(device, skinnedMeshPipeline, nullptr);
+    vkDestroyPipelineLayout(device, meshPipelineLayout, nullptr);
+    vkDestroyPipeline(device, materialPipeline, nullptr);
+    vkDestroyPipeline(device, skinnedMaterialPipeline, nullptr);
+    vkDestroyPipelineLayout(device, materialPipelineLayout, nullptr);
+    bindless.destroy();
+    textureStreamer.destroy();
+    meshArena.destroy();
+    meshes.clear();
+    objectMeshes.clear();
+    objectMaterials.clear();
+    skinnedObjects.clear();
+    frustumCuller.clear();
+    destroyAttachmentViews();
+    renderGraph.destroy();
+    pipelineCreateCount = 0;
+    vkDestroyRenderPass(device, renderPass, nullptr);
+    vkDestroyDescriptorSetLayout(device, descriptorSetLayout, nullptr);
+    vkDestroyDescriptorPool(device, descriptorPool, nullptr);
+    for (int i = 0; i < semaphores.size(); i++)
+    {
+        vkDestroySemaphore(device, semaphores[i], nullptr);
+    }
+    for (VkFence frameFence : frameFences)
+    {
+        vkDestroyFence(device, frameFence, nullptr);
+    }
+    frameFences.clear();
+    vkUnmapMemory(device, hostMemory);
+    vkDestroyBuffer(device, hostVertexBuffer, nullptr);
+    vkUnmapMemory(device, matrixRingMemory);
+    vkDestroyBuffer(device, matrixRingBuffer, nullptr);
+    memoryTracker.free(matrixRingMemory);
+    frameMatrixPointers.clear();
+    sceneGraph = nullptr;
+    memoryTracker.free(hostMemory);
+    vkDestroyBuffer(device, deviceVertexBuffer, nullptr);
+    memoryTracker.free(deviceMemory);
+    vkFreeCommandBuffers(device, commandPool, commandBuffers.size(), commandBuffers.data());
+    vkDestroyCommandPool(device, commandPool, nullptr);
+    if (headless)
+    {
+        for (int i = 0; i < readbackBuffers.size(); i++)
+        {
+            vkDestroyFence(device, readbackFences[i], nullptr);
+            vkUnmapMemory(device, readbackMemories[i]);
+            vkDestroyBuffer(device, readbackBuffers[i], nullptr);
+            memoryTracker.free(readbackMemories[i]);
+        }
+        readbackBuffers.clear();
+        readbackMemories.clear();
+        readbackDataPointers.clear();
+        readbackFences.clear();
+        for (int i = 0; i < swapchainImages.size(); i++)
+        {
+            vkDestroyImage(device, swapchainImages[i], nullptr);
+        }
+        memoryTracker.free(offscreenMemory);
+        memoryTracker.destroy();
+        vkDestroyDevice(device, nullptr);
+    }
+    else
+    {
+        vkDestroySwapchainKHR(device, swapchain, nullptr);
+        memoryTracker.destroy();
+        vkDestroyDevice(device, nullptr);
+        vkDestroySurfaceKHR(instance, surface, nullptr);
+        SDL_DestroyWindow(sdlWindow);
     }
-    vkUnmapMemory(device, hostMemory);
-    vkDestroyBuffer(device, hostVertexBuffer, nullptr);
-    vkDestroyBuffer(device, hostMatrixBuffer, nullptr);
-    vkFreeMemory(device, hostMemory, nullptr);
-    vkDestroyBuffer(device, deviceVertexBuffer, nullptr);
-    vkDestroyBuffer(device, deviceMatrixBuffer, nullptr);
-    vkFreeMemory(device, deviceMemory, nullptr);
-    vkFreeCommandBuffers(device, commandPool, commandBuffers.size(), commandBuffers.data());
-    vkDestroyCommandPool(device, commandPool, nullptr);
-    vkDestroySwapchainKHR(device, swapchain, nullptr);
-    vkDestroyDevice(device, nullptr);
-    vkDestroySurfaceKHR(instance, surface, nullptr);
-    SDL_DestroyWindow(sdlWindow);
     vkDestroyDebugUtilsMessengerEXT(instance, messenger, nullptr);
     vkDestroyInstance(instance, nullptr);
 }
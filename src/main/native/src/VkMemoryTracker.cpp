@@ -0,0 +1,267 @@
+/**
+ * @file VkMemoryTracker.cpp
+ * @author Lenard Büsing (nodedev74@gmail.com)
+ * @brief Device memory accounting per category and heap budget with eviction callbacks.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2023 Lenard Büsing
+ *
+ */
+
+#include "vulkan/VkMemoryTracker.hpp"
+#include "core/Tracer.hpp"
+
+#include "volk.h"
+
+#include <algorithm>
+
+void VkMemoryTracker::create(VkPhysicalDevice physicalDevice, VkDevice device, bool memoryBudget, uint64_t limit)
+{
+    std::lock_guard<std::recursive_mutex> lock(mutex);
+    this->physicalDevice = physicalDevice;
+    this->device = device;
+    this->memoryBudget = memoryBudget;
+    this->limit = limit;
+    vkGetPhysicalDeviceMemoryProperties(physicalDevice, &memoryProperties);
+    heaps.assign(memoryProperties.memoryHeapCount, Heap());
+    for (uint32_t i = 0; i < memoryProperties.memoryHeapCount; i++)
+    {
+        heaps[i].budget = memoryProperties.memoryHeaps[i].size / 10 * 8;
+        if (limit > 0 && (memoryProperties.memoryHeaps[i].flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT))
+        {
+            heaps[i].budget = std::min(heaps[i].budget, limit);
+        }
+    }
+    update();
+}
+
+void VkMemoryTracker::destroy()
+{
+    std::lock_guard<std::recursive_mutex> lock(mutex);
+    physicalDevice = VK_NULL_HANDLE;
+    device = VK_NULL_HANDLE;
+    memoryProperties = {};
+    memoryBudget = false;
+    limit = 0;
+    heaps.clear();
+    allocations.clear();
+    evictionCallbacks.clear();
+    evicting = false;
+    evictionCount = 0;
+    evictedBytes = 0;
+    refusedCount = 0;
+}
+
+VkResult VkMemoryTracker::allocate(const VkMemoryRequirements &memoryRequirements, VkMemoryPropertyFlags preferred, VkMemoryPropertyFlags required,
+                                   MemoryCategory category, VkDeviceMemory &memory)
+{
+    uint32_t memoryIndex = VkHelper::selectMemoryIndex(memoryProperties, memoryRequirements, static_cast<VkMemoryPropertyFlagBits>(preferred));
+    if (memoryIndex == VK_MAX_MEMORY_TYPES)
+    {
+        memoryIndex = VkHelper::selectMemoryIndex(memoryProperties, memoryRequirements, static_cast<VkMemoryPropertyFlagBits>(required));
+    }
+    if (memoryIndex == VK_MAX_MEMORY_TYPES)
+    {
+        return VK_ERROR_FEATURE_NOT_PRESENT;
+    }
+
+    std::lock_guard<std::recursive_mutex> lock(mutex);
+    uint32_t heap = memoryProperties.memoryTypes[memoryIndex].heapIndex;
+    VkDeviceSize size = memoryRequirements.size;
+    if (evicting)
+    {
+        // Replacements made while evicting only have to fit the heap
+        if (heaps[heap].bytes + size > memoryProperties.memoryHeaps[heap].size)
+        {
+            refusedCount++;
+            return VK_ERROR_OUT_OF_DEVICE_MEMORY;
+        }
+    }
+    else if (getUsage(heap) + size > heaps[heap].budget)
+    {
+        // The callbacks replace resources the calling thread may be using, update() evicts the bytes
+        heaps[heap].evictionBytes += getUsage(heap) + size - heaps[heap].budget;
+        refusedCount++;
+        return VK_ERROR_OUT_OF_DEVICE_MEMORY;
+    }
+
+    VkMemoryAllocateInfo memoryAllocateInfo = {
+        VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO,
+        nullptr,
+        size,
+        memoryIndex,
+    };
+    VkResult result = vkAllocateMemory(device, &memoryAllocateInfo, nullptr, &memory);
+    // The driver may run out before the budget does, where other processes share the heap
+    if (result == VK_ERROR_OUT_OF_DEVICE_MEMORY && !evicting)
+    {
+        heaps[heap].evictionBytes += size;
+    }
+    if (result != VK_SUCCESS)
+    {
+        return result;
+    }
+
+    allocations[memory] = {size, heap, category};
+    heaps[heap].bytes += size;
+    heaps[heap].categoryBytes[static_cast<uint32_t>(category)] += size;
+    return VK_SUCCESS;
+}
+
+void VkMemoryTracker::free(VkDeviceMemory memory)
+{
+    if (memory == VK_NULL_HANDLE)
+    {
+        return;
+    }
+
+    std::lock_guard<std::recursive_mutex> lock(mutex);
+    auto allocation = allocations.find(memory);
+    if (allocation != allocations.end())
+    {
+        Heap &heap = heaps[allocation->second.heap];
+        heap.bytes -= allocation->second.size;
+        heap.categoryBytes[static_cast<uint32_t>(allocation->second.category)] -= allocation->second.size;
+        allocations.erase(allocation);
+    }
+    vkFreeMemory(device, memory, nullptr);
+}
+
+void VkMemoryTracker::addEvictionCallback(MemoryCategory category, std::function<uint64_t(uint64_t)> callback)
+{
+    std::lock_guard<std::recursive_mutex> lock(mutex);
+    evictionCallbacks.push_back({category, std::move(callback)});
+}
+
+void VkMemoryTracker::update()
+{
+    TRACE_ZONE("VkMemoryTracker.update");
+
+    std::lock_guard<std::recursive_mutex> lock(mutex);
+    if (memoryBudget)
+    {
+        VkPhysicalDeviceMemoryBudgetPropertiesEXT budgetProperties{VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_BUDGET_PROPERTIES_EXT};
+        VkPhysicalDeviceMemoryProperties2 properties{VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_PROPERTIES_2};
+        properties.pNext = &budgetProperties;
+        vkGetPhysicalDeviceMemoryProperties2(physicalDevice, &properties);
+        for (uint32_t i = 0; i < heaps.size(); i++)
+        {
+            Heap &heap = heaps[i];
+            heap.budget = budgetProperties.heapBudget[i];
+            if (limit > 0 && (memoryProperties.memoryHeaps[i].flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT))
+            {
+                heap.budget = std::min(heap.budget, limit);
+            }
+            heap.reportedUsage = budgetProperties.heapUsage[i];
+            heap.reportedBytes = heap.bytes;
+        }
+    }
+
+    for (uint32_t i = 0; i < heaps.size(); i++)
+    {
+        uint64_t bytes = heaps[i].evictionBytes;
+        heaps[i].evictionBytes = 0;
+        uint64_t usage = getUsage(i);
+        if (usage > heaps[i].budget / 10 * 9)
+        {
+            bytes = std::max(bytes, usage - heaps[i].budget / 10 * 8);
+        }
+        if (bytes > 0)
+        {
+            evict(i, bytes);
+        }
+    }
+}
+
+const VkPhysicalDeviceMemoryProperties &VkMemoryTracker::getMemoryProperties() const
+{
+    return memoryProperties;
+}
+
+bool VkMemoryTracker::isBudgetSupported() const
+{
+    return memoryBudget;
+}
+
+uint64_t VkMemoryTracker::getCategoryBytes(MemoryCategory category) const
+{
+    std::lock_guard<std::recursive_mutex> lock(mutex);
+    uint64_t bytes = 0;
+    for (const Heap &heap : heaps)
+    {
+        bytes += heap.categoryBytes[static_cast<uint32_t>(category)];
+    }
+    return bytes;
+}
+
+uint32_t VkMemoryTracker::getHeapCount() const
+{
+    return memoryProperties.memoryHeapCount;
+}
+
+uint64_t VkMemoryTracker::getHeapBudget(uint32_t heap) const
+{
+    std::lock_guard<std::recursive_mutex> lock(mutex);
+    return heaps[heap].budget;
+}
+
+uint64_t VkMemoryTracker::getHeapUsage(uint32_t heap) const
+{
+    std::lock_guard<std::recursive_mutex> lock(mutex);
+    return getUsage(heap);
+}
+
+uint64_t VkMemoryTracker::getEvictionCount() const
+{
+    std::lock_guard<std::recursive_mutex> lock(mutex);
+    return evictionCount;
+}
+
+uint64_t VkMemoryTracker::getEvictedBytes() const
+{
+    std::lock_guard<std::recursive_mutex> lock(mutex);
+    return evictedBytes;
+}
+
+uint64_t VkMemoryTracker::getRefusedCount() const
+{
+    std::lock_guard<std::recursive_mutex> lock(mutex);
+    return refusedCount;
+}
+
+uint64_t VkMemoryTracker::getUsage(uint32_t heap) const
+{
+    const Heap &state = heaps[heap];
+    if (!memoryBudget)
+    {
+        return state.bytes;
+    }
+    // The reported usage plus what was allocated since, or minus what was freed
+    uint64_t usage = state.reportedUsage + state.bytes;
+    return usage > state.reportedBytes ? usage - state.reportedBytes : 0;
+}
+
+uint64_t VkMemoryTracker::evict(uint32_t heap, uint64_t bytes)
+{
+    TRACE_ZONE("VkMemoryTracker.evict");
+
+    evicting = true;
+    uint64_t freed = 0;
+    for (EvictionCallback &evictionCallback : evictionCallbacks)
+    {
+        if (freed >= bytes)
+        {
+            break;
+        }
+        if (heaps[heap].categoryBytes[static_cast<uint32_t>(evictionCallback.category)] == 0)
+        {
+            continue;
+        }
+        freed += evictionCallback.callback(bytes - freed);
+        evictionCount++;
+    }
+    evicting = false;
+    evictedBytes += freed;
+    return freed;
+}
@@ -0,0 +1,318 @@
+/**
+ * @file VkMeshArena.cpp
+ * @author Lenard Büsing (nodedev74@gmail.com)
+ * @brief Shared vertex and index arenas and per frame draw lists for multi draw indirect.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2023 Lenard Büsing
+ *
+ */
+
+#include "vulkan/VkMeshArena.hpp"
+#include "core/Tracer.hpp"
+
+#include "volk.h"
+
+#include <algorithm>
+#include <cstring>
+
+VkResult VkMeshArena::create(VkDevice device, VkMemoryTracker &memoryTracker, uint32_t frameCount, uint32_t vertexCapacity,
+                             uint32_t indexCapacity, uint32_t drawCapacity)
+{
+    this->device = device;
+    this->memoryTracker = &memoryTracker;
+    this->vertexCapacity = std::max<uint32_t>(vertexCapacity, 1);
+    this->indexCapacity = std::max<uint32_t>(indexCapacity, 1);
+    this->drawCapacity = std::max<uint32_t>(drawCapacity, 1);
+    vertexCount = 0;
+    indexCount = 0;
+
+    VkResult result = createBuffer(static_cast<VkDeviceSize>(this->vertexCapacity) * 3 * sizeof(float), VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT, vertexBuffer);
+    if (result == VK_SUCCESS)
+        result = createBuffer(static_cast<VkDeviceSize>(this->indexCapacity) * sizeof(uint32_t), VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT, indexBuffer);
+    std::vector<VkDeviceSize> offsets;
+    if (result == VK_SUCCESS)
+        result = allocate({vertexBuffer}, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, 0, MemoryCategory::Vertex, vertexMemory, offsets);
+    if (result == VK_SUCCESS)
+        result = allocate({indexBuffer}, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, 0, MemoryCategory::Index, indexMemory, offsets);
+    if (result != VK_SUCCESS)
+    {
+        return result;
+    }
+
+    // The lists are rewritten by the host for every frame, so they stay in host visible memory. With
+    // instancing the occlusion pass packs the visible instances into them on the device
+    frames.resize(frameCount);
+    std::vector<VkBuffer> frameBuffers;
+    for (Frame &frame : frames)
+    {
+        if (result == VK_SUCCESS)
+            result = createBuffer(this->drawCapacity * sizeof(DrawData), VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, frame.drawBuffer);
+        if (result == VK_SUCCESS)
+            result = createBuffer(this->drawCapacity * sizeof(VkDrawIndexedIndirectCommand), VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+                                  frame.commandBuffer);
+        frameBuffers.insert(frameBuffers.end(), {frame.drawBuffer, frame.commandBuffer});
+    }
+    if (result == VK_SUCCESS)
+        result = allocate(frameBuffers, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+                          VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, MemoryCategory::Uniform, frameMemory, offsets);
+    char *framePointer = nullptr;
+    if (result == VK_SUCCESS)
+        result = vkMapMemory(device, frameMemory, 0, VK_WHOLE_SIZE, 0, reinterpret_cast<void **>(&framePointer));
+    if (result != VK_SUCCESS)
+    {
+        return result;
+    }
+    for (size_t i = 0; i < frames.size(); i++)
+    {
+        frames[i].drawPointer = reinterpret_cast<DrawData *>(framePointer + offsets[i * 2]);
+        frames[i].commandPointer = reinterpret_cast<VkDrawIndexedIndirectCommand *>(framePointer + offsets[i * 2 + 1]);
+    }
+
+    VkDescriptorSetLayoutBinding binding = {0, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, VK_SHADER_STAGE_VERTEX_BIT, nullptr};
+    VkDescriptorSetLayoutCreateInfo layoutCreateInfo{VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO};
+    layoutCreateInfo.bindingCount = 1;
+    layoutCreateInfo.pBindings = &binding;
+    result = vkCreateDescriptorSetLayout(device, &layoutCreateInfo, nullptr, &setLayout);
+    if (result != VK_SUCCESS)
+    {
+        return result;
+    }
+
+    VkDescriptorPoolSize poolSize = {VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, frameCount};
+    VkDescriptorPoolCreateInfo poolCreateInfo{VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO};
+    poolCreateInfo.maxSets = frameCount;
+    poolCreateInfo.poolSizeCount = 1;
+    poolCreateInfo.pPoolSizes = &poolSize;
+    result = vkCreateDescriptorPool(device, &poolCreateInfo, nullptr, &descriptorPool);
+    if (result != VK_SUCCESS)
+    {
+        return result;
+    }
+
+    std::vector<VkDescriptorSetLayout> setLayouts(frameCount, setLayout);
+    std::vector<VkDescriptorSet> sets(frameCount);
+    VkDescriptorSetAllocateInfo allocateInfo{VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO};
+    allocateInfo.descriptorPool = descriptorPool;
+    allocateInfo.descriptorSetCount = frameCount;
+    allocateInfo.pSetLayouts = setLayouts.data();
+    result = vkAllocateDescriptorSets(device, &allocateInfo, sets.data());
+    if (result != VK_SUCCESS)
+    {
+        return result;
+    }
+
+    std::vector<VkDescriptorBufferInfo> bufferInfos(frameCount);
+    std::vector<VkWriteDescriptorSet> writes(frameCount);
+    for (uint32_t i = 0; i < frameCount; i++)
+    {
+        frames[i].set = sets[i];
+        bufferInfos[i] = {frames[i].drawBuffer, 0, VK_WHOLE_SIZE};
+        writes[i] = {VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET, nullptr, sets[i], 0, 0, 1, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, nullptr, &bufferInfos[i], nullptr};
+    }
+    vkUpdateDescriptorSets(device, frameCount, writes.data(), 0, nullptr);
+    return VK_SUCCESS;
+}
+
+void VkMeshArena::destroy()
+{
+    if (device == VK_NULL_HANDLE)
+    {
+        return;
+    }
+
+    for (Upload &upload : uploads)
+    {
+        vkWaitForFences(device, 1, &upload.fence, VK_TRUE, UINT64_MAX);
+        destroyUpload(upload);
+    }
+    vkDestroyDescriptorPool(device, descriptorPool, nullptr);
+    vkDestroyDescriptorSetLayout(device, setLayout, nullptr);
+    for (Frame &frame : frames)
+    {
+        vkDestroyBuffer(device, frame.drawBuffer, nullptr);
+        vkDestroyBuffer(device, frame.commandBuffer, nullptr);
+    }
+    memoryTracker->free(frameMemory);
+    vkDestroyBuffer(device, vertexBuffer, nullptr);
+    vkDestroyBuffer(device, indexBuffer, nullptr);
+    memoryTracker->free(vertexMemory);
+    memoryTracker->free(indexMemory);
+
+    *this = VkMeshArena();
+}
+
+VkResult VkMeshArena::upload(VkQueue queue, VkCommandPool commandPool, const float *positions, uint32_t vertexCount, const uint32_t *indices, uint32_t indexCount,
+                             MeshRange &range)
+{
+    TRACE_ZONE("VkMeshArena.upload");
+
+    releaseUploads();
+    if (vertexCount > vertexCapacity - this->vertexCount || indexCount > indexCapacity - this->indexCount)
+    {
+        return VK_ERROR_OUT_OF_DEVICE_MEMORY;
+    }
+
+    VkDeviceSize vertexSize = static_cast<VkDeviceSize>(vertexCount) * 3 * sizeof(float);
+    VkDeviceSize indexSize = static_cast<VkDeviceSize>(indexCount) * sizeof(uint32_t);
+    Upload batch;
+    batch.commandPool = commandPool;
+    std::vector<VkDeviceSize> offsets;
+    VkResult result = createBuffer(vertexSize + indexSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, batch.stagingBuffer);
+    if (result == VK_SUCCESS)
+        result = allocate({batch.stagingBuffer}, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+                          VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, MemoryCategory::Staging, batch.stagingMemory, offsets);
+    void *data = nullptr;
+    if (result == VK_SUCCESS)
+        result = vkMapMemory(device, batch.stagingMemory, 0, VK_WHOLE_SIZE, 0, &data);
+    VkFenceCreateInfo fenceCreateInfo = {VK_STRUCTURE_TYPE_FENCE_CREATE_INFO, nullptr, 0};
+    if (result == VK_SUCCESS)
+        result = vkCreateFence(device, &fenceCreateInfo, nullptr, &batch.fence);
+    VkCommandBufferAllocateInfo commandBufferAllocateInfo = {VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO, nullptr, commandPool, VK_COMMAND_BUFFER_LEVEL_PRIMARY, 1};
+    if (result == VK_SUCCESS)
+        result = vkAllocateCommandBuffers(device, &commandBufferAllocateInfo, &batch.commandBuffer);
+    if (result != VK_SUCCESS)
+    {
+        destroyUpload(batch);
+        return result;
+    }
+    memcpy(data, positions, vertexSize);
+    memcpy(static_cast<char *>(data) + vertexSize, indices, indexSize);
+    vkUnmapMemory(device, batch.stagingMemory);
+    VkCommandBuffer commandBuffer = batch.commandBuffer;
+
+    VkCommandBufferBeginInfo commandBufferBeginInfo = {VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO, nullptr, VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT, nullptr};
+    vkBeginCommandBuffer(commandBuffer, &commandBufferBeginInfo);
+    VkBufferCopy vertexCopy = {0, static_cast<VkDeviceSize>(this->vertexCount) * 3 * sizeof(float), vertexSize};
+    vkCmdCopyBuffer(commandBuffer, batch.stagingBuffer, vertexBuffer, 1, &vertexCopy);
+    VkBufferCopy indexCopy = {vertexSize, static_cast<VkDeviceSize>(this->indexCount) * sizeof(uint32_t), indexSize};
+    vkCmdCopyBuffer(commandBuffer, batch.stagingBuffer, indexBuffer, 1, &indexCopy);
+    // Pending frames only read earlier ranges, the barrier orders the draws of later frames after the copy
+    VkMemoryBarrier memoryBarrier = {VK_STRUCTURE_TYPE_MEMORY_BARRIER, nullptr, VK_ACCESS_TRANSFER_WRITE_BIT,
+                                     VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT | VK_ACCESS_INDEX_READ_BIT};
+    vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_VERTEX_INPUT_BIT, 0, 1, &memoryBarrier, 0, nullptr, 0, nullptr);
+    vkEndCommandBuffer(commandBuffer);
+
+    VkSubmitInfo submitInfo = {VK_STRUCTURE_TYPE_SUBMIT_INFO, nullptr, 0, nullptr, nullptr, 1, &commandBuffer, 0, nullptr};
+    result = vkQueueSubmit(queue, 1, &submitInfo, batch.fence);
+    if (result != VK_SUCCESS)
+    {
+        destroyUpload(batch);
+        return result;
+    }
+    uploads.push_back(batch);
+
+    range = {this->indexCount, indexCount, static_cast<int32_t>(this->vertexCount)};
+    this->vertexCount += vertexCount;
+    this->indexCount += indexCount;
+    return VK_SUCCESS;
+}
+
+void VkMeshArena::releaseUploads()
+{
+    size_t pending = 0;
+    for (size_t i = 0; i < uploads.size(); i++)
+    {
+        if (vkGetFenceStatus(device, uploads[i].fence) == VK_SUCCESS)
+        {
+            destroyUpload(uploads[i]);
+        }
+        else
+        {
+            uploads[pending++] = uploads[i];
+        }
+    }
+    uploads.resize(pending);
+}
+
+void VkMeshArena::bind(VkCommandBuffer commandBuffer) const
+{
+    VkDeviceSize offset = 0;
+    vkCmdBindVertexBuffers(commandBuffer, 0, 1, &vertexBuffer, &offset);
+    vkCmdBindIndexBuffer(commandBuffer, indexBuffer, 0, VK_INDEX_TYPE_UINT32);
+}
+
+uint32_t VkMeshArena::getDrawCapacity() const
+{
+    return drawCapacity;
+}
+
+DrawData *VkMeshArena::getDraws(uint32_t frame)
+{
+    return frames[frame].drawPointer;
+}
+
+VkDrawIndexedIndirectCommand *VkMeshArena::getCommands(uint32_t frame)
+{
+    return frames[frame].commandPointer;
+}
+
+VkBuffer VkMeshArena::getDrawBuffer(uint32_t frame) const
+{
+    return frames[frame].drawBuffer;
+}
+
+VkBuffer VkMeshArena::getCommandBuffer(uint32_t frame) const
+{
+    return frames[frame].commandBuffer;
+}
+
+VkDescriptorSetLayout VkMeshArena::getSetLayout() const
+{
+    return setLayout;
+}
+
+VkDescriptorSet VkMeshArena::getSet(uint32_t frame) const
+{
+    return frames[frame].set;
+}
+
+VkResult VkMeshArena::createBuffer(VkDeviceSize size, VkBufferUsageFlags usage, VkBuffer &buffer)
+{
+    VkBufferCreateInfo bufferCreateInfo = {
+        VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO,
+        nullptr,
+        0,
+        size,
+        usage,
+        VK_SHARING_MODE_EXCLUSIVE,
+        0,
+        nullptr,
+    };
+    return vkCreateBuffer(device, &bufferCreateInfo, nullptr, &buffer);
+}
+
+VkResult VkMeshArena::allocate(const std::vector<VkBuffer> &buffers, VkMemoryPropertyFlags preferred, VkMemoryPropertyFlags required,
+                               MemoryCategory category, VkDeviceMemory &memory, std::vector<VkDeviceSize> &offsets)
+{
+    VkMemoryRequirements memoryRequirements = {0, 0, ~0u};
+    offsets.resize(buffers.size());
+    for (size_t i = 0; i < buffers.size(); i++)
+    {
+        VkMemoryRequirements bufferRequirements;
+        vkGetBufferMemoryRequirements(device, buffers[i], &bufferRequirements);
+        offsets[i] = (memoryRequirements.size + bufferRequirements.alignment - 1) & ~(bufferRequirements.alignment - 1);
+        memoryRequirements.size = offsets[i] + bufferRequirements.size;
+        memoryRequirements.alignment = std::max(memoryRequirements.alignment, bufferRequirements.alignment);
+        memoryRequirements.memoryTypeBits &= bufferRequirements.memoryTypeBits;
+    }
+
+    VkResult result = memoryTracker->allocate(memoryRequirements, preferred, required, category, memory);
+    for (size_t i = 0; result == VK_SUCCESS && i < buffers.size(); i++)
+    {
+        result = vkBindBufferMemory(device, buffers[i], memory, offsets[i]);
+    }
+    return result;
+}
+
+void VkMeshArena::destroyUpload(Upload &upload)
+{
+    if (upload.commandBuffer != VK_NULL_HANDLE)
+    {
+        vkFreeCommandBuffers(device, upload.commandPool, 1, &upload.commandBuffer);
+    }
+    vkDestroyFence(device, upload.fence, nullptr);
+    vkDestroyBuffer(device, upload.stagingBuffer, nullptr);
+    memoryTracker->free(upload.stagingMemory);
+}
@@ -0,0 +1,465 @@
+/**
+ * @file VkOcclusion.cpp
+ * @author Lenard Büsing (nodedev74@gmail.com)
+ * @brief Hierarchical depth occlusion culling of object bounds on the GPU.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2023 Lenard Büsing
+ *
+ */
+
+#include "vulkan/VkOcclusion.hpp"
+#include "core/Tracer.hpp"
+
+#include "volk.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace
+{
+    constexpr uint32_t PYRAMID_GROUP_SIZE = 8;
+    constexpr uint32_t CULL_GROUP_SIZE = 64;
+    constexpr uint32_t CULL_BINDINGS = 6;
+    constexpr uint32_t PYRAMID_BINDING = 3;
+
+    struct PyramidPushConstants
+    {
+        uint32_t sourceSize[2];
+        uint32_t targetSize[2];
+    };
+
+    struct CullPushConstants
+    {
+        Matrix4 viewProjection;
+        uint32_t pyramidSize[2];
+        uint32_t levelCount;
+        uint32_t candidateCount;
+        uint32_t outputMode;
+    };
+
+    uint32_t previousPowerOfTwo(uint32_t value)
+    {
+        uint32_t result = 1;
+        while (result * 2 <= value)
+        {
+            result *= 2;
+        }
+        return result;
+    }
+}
+
+VkResult VkOcclusion::create(VkDevice device, VkMemoryTracker &memoryTracker, VkShaderModule pyramidShader, VkShaderModule cullShader,
+                             const std::vector<VkImageView> &depthViews, VkExtent2D extent, uint32_t candidateCapacity,
+                             const std::vector<VkBuffer> &instanceDrawBuffers, const std::vector<VkBuffer> &instanceGroupBuffers)
+{
+    this->device = device;
+    this->memoryTracker = &memoryTracker;
+    this->candidateCapacity = std::max<uint32_t>(candidateCapacity, 1);
+    uint32_t frameCount = static_cast<uint32_t>(depthViews.size());
+
+    // A power of two pyramid halves exactly on every level, only level 0 covers more than two by two depth texels
+    depthExtent = extent;
+    pyramidExtent = {previousPowerOfTwo(extent.width), previousPowerOfTwo(extent.height)};
+    levelCount = 1;
+    while ((std::max(pyramidExtent.width, pyramidExtent.height) >> levelCount) > 0)
+    {
+        levelCount++;
+    }
+
+    VkImageCreateInfo imageCreateInfo = {
+        VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO,
+        nullptr,
+        0,
+        VK_IMAGE_TYPE_2D,
+        VK_FORMAT_R32_SFLOAT,
+        {pyramidExtent.width, pyramidExtent.height, 1},
+        levelCount,
+        1,
+        VK_SAMPLE_COUNT_1_BIT,
+        VK_IMAGE_TILING_OPTIMAL,
+        VK_IMAGE_USAGE_STORAGE_BIT | VK_IMAGE_USAGE_SAMPLED_BIT,
+        VK_SHARING_MODE_EXCLUSIVE,
+        0,
+        nullptr,
+        VK_IMAGE_LAYOUT_UNDEFINED,
+    };
+    VkResult result = vkCreateImage(device, &imageCreateInfo, nullptr, &pyramid);
+    if (result != VK_SUCCESS)
+    {
+        return result;
+    }
+
+    VkMemoryRequirements imageRequirements;
+    vkGetImageMemoryRequirements(device, pyramid, &imageRequirements);
+    result = memoryTracker.allocate(imageRequirements, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, MemoryCategory::Target, pyramidMemory);
+    if (result == VK_SUCCESS)
+        result = vkBindImageMemory(device, pyramid, pyramidMemory, 0);
+    if (result != VK_SUCCESS)
+    {
+        return result;
+    }
+
+    VkImageViewCreateInfo viewCreateInfo = {
+        VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO,
+        nullptr,
+        0,
+        pyramid,
+        VK_IMAGE_VIEW_TYPE_2D,
+        VK_FORMAT_R32_SFLOAT,
+        {VK_COMPONENT_SWIZZLE_IDENTITY, VK_COMPONENT_SWIZZLE_IDENTITY, VK_COMPONENT_SWIZZLE_IDENTITY, VK_COMPONENT_SWIZZLE_IDENTITY},
+        {VK_IMAGE_ASPECT_COLOR_BIT, 0, levelCount, 0, 1},
+    };
+    result = vkCreateImageView(device, &viewCreateInfo, nullptr, &pyramidView);
+    levelViews.resize(levelCount);
+    for (uint32_t i = 0; result == VK_SUCCESS && i < levelCount; i++)
+    {
+        viewCreateInfo.subresourceRange = {VK_IMAGE_ASPECT_COLOR_BIT, i, 1, 0, 1};
+        result = vkCreateImageView(device, &viewCreateInfo, nullptr, &levelViews[i]);
+    }
+    if (result != VK_SUCCESS)
+    {
+        return result;
+    }
+
+    VkSamplerCreateInfo samplerCreateInfo{VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO};
+    samplerCreateInfo.magFilter = VK_FILTER_NEAREST;
+    samplerCreateInfo.minFilter = VK_FILTER_NEAREST;
+    samplerCreateInfo.mipmapMode = VK_SAMPLER_MIPMAP_MODE_NEAREST;
+    samplerCreateInfo.addressModeU = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+    samplerCreateInfo.addressModeV = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+    samplerCreateInfo.addressModeW = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+    samplerCreateInfo.maxLod = VK_LOD_CLAMP_NONE;
+    result = vkCreateSampler(device, &samplerCreateInfo, nullptr, &sampler);
+    if (result != VK_SUCCESS)
+    {
+        return result;
+    }
+
+    // Candidates and counters are written and read by the host every frame, the draws stay on the device
+    frames.resize(frameCount);
+    std::vector<VkBuffer> frameBuffers;
+    std::vector<VkBuffer> drawBuffers;
+    for (Frame &frame : frames)
+    {
+        if (result == VK_SUCCESS)
+            result = createBuffer(this->candidateCapacity * sizeof(OcclusionCandidate), VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, frame.candidateBuffer);
+        if (result == VK_SUCCESS)
+            result = createBuffer(2 * sizeof(uint32_t), VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT,
+                                  frame.counterBuffer);
+        if (result == VK_SUCCESS)
+            result = createBuffer(this->candidateCapacity * sizeof(VkDrawIndexedIndirectCommand), VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT, frame.drawBuffer);
+        frameBuffers.insert(frameBuffers.end(), {frame.candidateBuffer, frame.counterBuffer});
+        drawBuffers.push_back(frame.drawBuffer);
+    }
+    std::vector<VkDeviceSize> offsets;
+    if (result == VK_SUCCESS)
+        result = allocate(drawBuffers, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, 0, MemoryCategory::Uniform, drawMemory, offsets);
+    if (result == VK_SUCCESS)
+        result = allocate(frameBuffers, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+                          VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, MemoryCategory::Uniform, frameMemory, offsets);
+    char *framePointer = nullptr;
+    if (result == VK_SUCCESS)
+        result = vkMapMemory(device, frameMemory, 0, VK_WHOLE_SIZE, 0, reinterpret_cast<void **>(&framePointer));
+    if (result != VK_SUCCESS)
+    {
+        return result;
+    }
+    for (size_t i = 0; i < frames.size(); i++)
+    {
+        frames[i].candidatePointer = reinterpret_cast<OcclusionCandidate *>(framePointer + offsets[i * 2]);
+        frames[i].counterPointer = reinterpret_cast<uint32_t *>(framePointer + offsets[i * 2 + 1]);
+        frames[i].counterPointer[0] = 0;
+        frames[i].counterPointer[1] = 0;
+    }
+
+    VkDescriptorSetLayoutBinding pyramidBindings[2] = {
+        {0, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 1, VK_SHADER_STAGE_COMPUTE_BIT, nullptr},
+        {1, VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, 1, VK_SHADER_STAGE_COMPUTE_BIT, nullptr},
+    };
+    VkDescriptorSetLayoutCreateInfo layoutCreateInfo{VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO};
+    layoutCreateInfo.bindingCount = 2;
+    layoutCreateInfo.pBindings = pyramidBindings;
+    result = vkCreateDescriptorSetLayout(device, &layoutCreateInfo, nullptr, &pyramidSetLayout);
+    if (result != VK_SUCCESS)
+    {
+        return result;
+    }
+
+    VkDescriptorSetLayoutBinding cullBindings[CULL_BINDINGS];
+    for (uint32_t i = 0; i < CULL_BINDINGS; i++)
+    {
+        cullBindings[i] = {i, i == PYRAMID_BINDING ? VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER : VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, VK_SHADER_STAGE_COMPUTE_BIT, nullptr};
+    }
+    layoutCreateInfo.bindingCount = CULL_BINDINGS;
+    layoutCreateInfo.pBindings = cullBindings;
+    result = vkCreateDescriptorSetLayout(device, &layoutCreateInfo, nullptr, &cullSetLayout);
+    if (result != VK_SUCCESS)
+    {
+        return result;
+    }
+
+    // Level 0 reads the depth of its frame slot, so every slot owns a set for it next to its culling set
+    uint32_t pyramidSetCount = frameCount + levelCount - 1;
+    VkDescriptorPoolSize poolSizes[3] = {
+        {VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, (CULL_BINDINGS - 1) * frameCount},
+        {VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, frameCount + pyramidSetCount},
+        {VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, pyramidSetCount},
+    };
+    VkDescriptorPoolCreateInfo poolCreateInfo{VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO};
+    poolCreateInfo.maxSets = frameCount + pyramidSetCount;
+    poolCreateInfo.poolSizeCount = 3;
+    poolCreateInfo.pPoolSizes = poolSizes;
+    result = vkCreateDescriptorPool(device, &poolCreateInfo, nullptr, &descriptorPool);
+    if (result != VK_SUCCESS)
+    {
+        return result;
+    }
+
+    std::vector<VkDescriptorSetLayout> setLayouts(frameCount, cullSetLayout);
+    setLayouts.resize(frameCount + pyramidSetCount, pyramidSetLayout);
+    std::vector<VkDescriptorSet> sets(setLayouts.size());
+    VkDescriptorSetAllocateInfo allocateInfo{VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO};
+    allocateInfo.descriptorPool = descriptorPool;
+    allocateInfo.descriptorSetCount = static_cast<uint32_t>(setLayouts.size());
+    allocateInfo.pSetLayouts = setLayouts.data();
+    result = vkAllocateDescriptorSets(device, &allocateInfo, sets.data());
+    if (result != VK_SUCCESS)
+    {
+        return result;
+    }
+
+    std::vector<VkDescriptorBufferInfo> bufferInfos((CULL_BINDINGS - 1) * frameCount);
+    std::vector<VkDescriptorImageInfo> imageInfos(frameCount + 2 * pyramidSetCount);
+    std::vector<VkWriteDescriptorSet> writes;
+    VkDescriptorImageInfo *imageInfo = imageInfos.data();
+    for (uint32_t i = 0; i < frameCount; i++)
+    {
+        Frame &frame = frames[i];
+        frame.cullSet = sets[i];
+        frame.depthSet = sets[frameCount + i];
+
+        VkDescriptorBufferInfo *bufferInfo = &bufferInfos[i * (CULL_BINDINGS - 1)];
+        bufferInfo[0] = {frame.candidateBuffer, 0, VK_WHOLE_SIZE};
+        bufferInfo[1] = {frame.drawBuffer, 0, VK_WHOLE_SIZE};
+        bufferInfo[2] = {frame.counterBuffer, 0, VK_WHOLE_SIZE};
+        bufferInfo[3] = {instanceDrawBuffers[i], 0, VK_WHOLE_SIZE};
+        bufferInfo[4] = {instanceGroupBuffers[i], 0, VK_WHOLE_SIZE};
+        for (uint32_t binding = 0; binding < CULL_BINDINGS; binding++)
+        {
+            if (binding != PYRAMID_BINDING)
+            {
+                writes.push_back({VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET, nullptr, frame.cullSet, binding, 0, 1, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, nullptr,
+                                  &bufferInfo[binding < PYRAMID_BINDING ? binding : binding - 1], nullptr});
+            }
+        }
+        *imageInfo = {sampler, pyramidView, VK_IMAGE_LAYOUT_GENERAL};
+        writes.push_back({VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET, nullptr, frame.cullSet, PYRAMID_BINDING, 0, 1, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, imageInfo++, nullptr, nullptr});
+    }
+
+    levelSets.assign(sets.begin() + 2 * frameCount, sets.end());
+    for (uint32_t i = 0; i < pyramidSetCount; i++)
+    {
+        // Sets [0, frameCount) reduce the depth of a slot into level 0, the remaining ones reduce level n into n + 1
+        VkDescriptorSet set = sets[frameCount + i];
+        bool depth = i < frameCount;
+        uint32_t level = depth ? 0 : i - frameCount + 1;
+        *imageInfo = {sampler, depth ? depthViews[i] : levelViews[level - 1], depth ? VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL : VK_IMAGE_LAYOUT_GENERAL};
+        writes.push_back({VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET, nullptr, set, 0, 0, 1, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, imageInfo++, nullptr, nullptr});
+        *imageInfo = {VK_NULL_HANDLE, levelViews[level], VK_IMAGE_LAYOUT_GENERAL};
+        writes.push_back({VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET, nullptr, set, 1, 0, 1, VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, imageInfo++, nullptr, nullptr});
+    }
+    vkUpdateDescriptorSets(device, static_cast<uint32_t>(writes.size()), writes.data(), 0, nullptr);
+
+    result = createPipeline(pyramidShader, pyramidSetLayout, sizeof(PyramidPushConstants), pyramidPipelineLayout, pyramidPipeline);
+    if (result != VK_SUCCESS)
+    {
+        return result;
+    }
+    return createPipeline(cullShader, cullSetLayout, sizeof(CullPushConstants), cullPipelineLayout, cullPipeline);
+}
+
+void VkOcclusion::destroy()
+{
+    if (device == VK_NULL_HANDLE)
+    {
+        return;
+    }
+
+    vkDestroyPipeline(device, cullPipeline, nullptr);
+    vkDestroyPipeline(device, pyramidPipeline, nullptr);
+    vkDestroyPipelineLayout(device, cullPipelineLayout, nullptr);
+    vkDestroyPipelineLayout(device, pyramidPipelineLayout, nullptr);
+    vkDestroyDescriptorPool(device, descriptorPool, nullptr);
+    vkDestroyDescriptorSetLayout(device, cullSetLayout, nullptr);
+    vkDestroyDescriptorSetLayout(device, pyramidSetLayout, nullptr);
+    for (Frame &frame : frames)
+    {
+        vkDestroyBuffer(device, frame.candidateBuffer, nullptr);
+        vkDestroyBuffer(device, frame.counterBuffer, nullptr);
+        vkDestroyBuffer(device, frame.drawBuffer, nullptr);
+    }
+    memoryTracker->free(frameMemory);
+    memoryTracker->free(drawMemory);
+    vkDestroySampler(device, sampler, nullptr);
+    for (VkImageView levelView : levelViews)
+    {
+        vkDestroyImageView(device, levelView, nullptr);
+    }
+    vkDestroyImageView(device, pyramidView, nullptr);
+    vkDestroyImage(device, pyramid, nullptr);
+    memoryTracker->free(pyramidMemory);
+
+    *this = VkOcclusion();
+}
+
+uint32_t VkOcclusion::getCapacity() const
+{
+    return candidateCapacity;
+}
+
+OcclusionCandidate *VkOcclusion::getCandidates(uint32_t frame)
+{
+    return frames[frame].candidatePointer;
+}
+
+uint32_t VkOcclusion::getOccludedCount(uint32_t frame) const
+{
+    return *frames[frame].counterPointer;
+}
+
+void VkOcclusion::recordCull(VkCommandBuffer commandBuffer, uint32_t frame, const Matrix4 &viewProjection, uint32_t count, OcclusionOutput output)
+{
+    const Frame &target = frames[frame];
+    vkCmdFillBuffer(commandBuffer, target.counterBuffer, 0, 2 * sizeof(uint32_t), 0);
+
+    // The counter reset is internal to the pass, the accesses of other passes are ordered by the caller
+    VkMemoryBarrier memoryBarrier = {VK_STRUCTURE_TYPE_MEMORY_BARRIER, nullptr, VK_ACCESS_TRANSFER_WRITE_BIT, VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT};
+    vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 1, &memoryBarrier, 0, nullptr, 0, nullptr);
+
+    CullPushConstants pushConstants;
+    pushConstants.viewProjection = viewProjection;
+    pushConstants.pyramidSize[0] = pyramidExtent.width;
+    pushConstants.pyramidSize[1] = pyramidExtent.height;
+    pushConstants.levelCount = pyramidValid ? levelCount : 0;
+    pushConstants.candidateCount = std::min(count, candidateCapacity);
+    pushConstants.outputMode = static_cast<uint32_t>(output);
+
+    vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, cullPipeline);
+    vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, cullPipelineLayout, 0, 1, &target.cullSet, 0, nullptr);
+    vkCmdPushConstants(commandBuffer, cullPipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(pushConstants), &pushConstants);
+    vkCmdDispatch(commandBuffer, (pushConstants.candidateCount + CULL_GROUP_SIZE - 1) / CULL_GROUP_SIZE, 1, 1);
+}
+
+void VkOcclusion::recordPyramid(VkCommandBuffer commandBuffer, uint32_t frame)
+{
+    vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, pyramidPipeline);
+
+    VkMemoryBarrier memoryBarrier = {VK_STRUCTURE_TYPE_MEMORY_BARRIER, nullptr, VK_ACCESS_SHADER_WRITE_BIT, VK_ACCESS_SHADER_READ_BIT};
+    PyramidPushConstants pushConstants = {{depthExtent.width, depthExtent.height}, {pyramidExtent.width, pyramidExtent.height}};
+    for (uint32_t level = 0; level < levelCount; level++)
+    {
+        VkDescriptorSet set = level == 0 ? frames[frame].depthSet : levelSets[level - 1];
+        vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, pyramidPipelineLayout, 0, 1, &set, 0, nullptr);
+        vkCmdPushConstants(commandBuffer, pyramidPipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(pushConstants), &pushConstants);
+        vkCmdDispatch(commandBuffer, (pushConstants.targetSize[0] + PYRAMID_GROUP_SIZE - 1) / PYRAMID_GROUP_SIZE,
+                      (pushConstants.targetSize[1] + PYRAMID_GROUP_SIZE - 1) / PYRAMID_GROUP_SIZE, 1);
+        if (level + 1 < levelCount)
+        {
+            vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 1, &memoryBarrier, 0, nullptr, 0, nullptr);
+        }
+
+        pushConstants.sourceSize[0] = pushConstants.targetSize[0];
+        pushConstants.sourceSize[1] = pushConstants.targetSize[1];
+        pushConstants.targetSize[0] = std::max<uint32_t>(pushConstants.targetSize[0] / 2, 1);
+        pushConstants.targetSize[1] = std::max<uint32_t>(pushConstants.targetSize[1] / 2, 1);
+    }
+    pyramidValid = true;
+}
+
+void VkOcclusion::reset()
+{
+    pyramidValid = false;
+}
+
+VkImage VkOcclusion::getPyramid() const
+{
+    return pyramid;
+}
+
+uint32_t VkOcclusion::getLevelCount() const
+{
+    return levelCount;
+}
+
+VkBuffer VkOcclusion::getDrawBuffer(uint32_t frame) const
+{
+    return frames[frame].drawBuffer;
+}
+
+VkBuffer VkOcclusion::getCounterBuffer(uint32_t frame) const
+{
+    return frames[frame].counterBuffer;
+}
+
+VkResult VkOcclusion::createBuffer(VkDeviceSize size, VkBufferUsageFlags usage, VkBuffer &buffer)
+{
+    VkBufferCreateInfo bufferCreateInfo = {
+        VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO,
+        nullptr,
+        0,
+        size,
+        usage,
+        VK_SHARING_MODE_EXCLUSIVE,
+        0,
+        nullptr,
+    };
+    return vkCreateBuffer(device, &bufferCreateInfo, nullptr, &buffer);
+}
+
+VkResult VkOcclusion::allocate(const std::vector<VkBuffer> &buffers, VkMemoryPropertyFlags preferred, VkMemoryPropertyFlags required,
+                               MemoryCategory category, VkDeviceMemory &memory, std::vector<VkDeviceSize> &offsets)
+{
+    VkMemoryRequirements memoryRequirements = {0, 0, ~0u};
+    offsets.resize(buffers.size());
+    for (size_t i = 0; i < buffers.size(); i++)
+    {
+        VkMemoryRequirements bufferRequirements;
+        vkGetBufferMemoryRequirements(device, buffers[i], &bufferRequirements);
+        offsets[i] = (memoryRequirements.size + bufferRequirements.alignment - 1) & ~(bufferRequirements.alignment - 1);
+        memoryRequirements.size = offsets[i] + bufferRequirements.size;
+        memoryRequirements.alignment = std::max(memoryRequirements.alignment, bufferRequirements.alignment);
+        memoryRequirements.memoryTypeBits &= bufferRequirements.memoryTypeBits;
+    }
+
+    VkResult result = memoryTracker->allocate(memoryRequirements, preferred, required, category, memory);
+    for (size_t i = 0; result == VK_SUCCESS && i < buffers.size(); i++)
+    {
+        result = vkBindBufferMemory(device, buffers[i], memory, offsets[i]);
+    }
+    return result;
+}
+
+VkResult VkOcclusion::createPipeline(VkShaderModule shader, VkDescriptorSetLayout setLayout, uint32_t pushConstantSize, VkPipelineLayout &layout, VkPipeline &pipeline)
+{
+    VkPushConstantRange pushConstantRange = {VK_SHADER_STAGE_COMPUTE_BIT, 0, pushConstantSize};
+    VkPipelineLayoutCreateInfo pipelineLayoutInfo{VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO};
+    pipelineLayoutInfo.setLayoutCount = 1;
+    pipelineLayoutInfo.pSetLayouts = &setLayout;
+    pipelineLayoutInfo.pushConstantRangeCount = 1;
+    pipelineLayoutInfo.pPushConstantRanges = &pushConstantRange;
+    VkResult result = vkCreatePipelineLayout(device, &pipelineLayoutInfo, nullptr, &layout);
+    if (result != VK_SUCCESS)
+    {
+        return result;
+    }
+
+    VkComputePipelineCreateInfo pipelineInfo{VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO};
+    pipelineInfo.stage.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+    pipelineInfo.stage.stage = VK_SHADER_STAGE_COMPUTE_BIT;
+    pipelineInfo.stage.module = shader;
+    pipelineInfo.stage.pName = "main";
+    pipelineInfo.layout = layout;
+    return vkCreateComputePipelines(device, VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &pipeline);
+}
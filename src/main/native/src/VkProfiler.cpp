@@ -0,0 +1,254 @@
+/**
+ * @file VkProfiler.cpp
+ * @author Lenard Büsing (nodedev74@gmail.com)
+ * @brief GPU profiler based on timestamp and pipeline statistics queries.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2023 Lenard Büsing
+ *
+ */
+
+#include "vulkan/VkProfiler.hpp"
+
+#include "volk.h"
+
+bool VkProfiler::create(VkDevice device, VkPhysicalDevice physicalDevice, uint32_t queueFamilyIndex, uint32_t frameCount, uint32_t maxScopes, bool pipelineStatistics)
+{
+    this->device = device;
+    this->maxScopes = maxScopes;
+    this->statistics = pipelineStatistics;
+
+    VkPhysicalDeviceProperties properties;
+    vkGetPhysicalDeviceProperties(physicalDevice, &properties);
+    timestampPeriod = properties.limits.timestampPeriod;
+
+    uint32_t familiesCount;
+    vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, &familiesCount, nullptr);
+    std::vector<VkQueueFamilyProperties> queueFamiliesProperties(familiesCount);
+    vkGetPhysicalDeviceQueueFamilyProperties(physicalDevice, &familiesCount, queueFamiliesProperties.data());
+
+    uint32_t validBits = queueFamilyIndex < familiesCount ? queueFamiliesProperties[queueFamilyIndex].timestampValidBits : 0;
+    timestampMask = validBits >= 64 ? UINT64_MAX : ((uint64_t(1) << validBits) - 1);
+    if (validBits == 0 || timestampPeriod <= 0.0)
+    {
+        timestampMask = 0;
+        this->maxScopes = 0;
+    }
+
+    frames.resize(frameCount);
+    for (Frame &frame : frames)
+    {
+        if (this->maxScopes > 0)
+        {
+            VkQueryPoolCreateInfo timestampPoolCreateInfo = {
+                VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO,
+                nullptr,
+                0,
+                VK_QUERY_TYPE_TIMESTAMP,
+                this->maxScopes * 2,
+                0,
+            };
+            if (vkCreateQueryPool(device, &timestampPoolCreateInfo, nullptr, &frame.timestampPool) != VK_SUCCESS)
+            {
+                frame.timestampPool = VK_NULL_HANDLE;
+                this->maxScopes = 0;
+            }
+        }
+
+        if (statistics)
+        {
+            VkQueryPoolCreateInfo statisticsPoolCreateInfo = {
+                VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO,
+                nullptr,
+                0,
+                VK_QUERY_TYPE_PIPELINE_STATISTICS,
+                1,
+                VK_QUERY_PIPELINE_STATISTIC_INPUT_ASSEMBLY_VERTICES_BIT |
+                    VK_QUERY_PIPELINE_STATISTIC_VERTEX_SHADER_INVOCATIONS_BIT |
+                    VK_QUERY_PIPELINE_STATISTIC_CLIPPING_PRIMITIVES_BIT |
+                    VK_QUERY_PIPELINE_STATISTIC_FRAGMENT_SHADER_INVOCATIONS_BIT |
+                    VK_QUERY_PIPELINE_STATISTIC_COMPUTE_SHADER_INVOCATIONS_BIT,
+            };
+            if (vkCreateQueryPool(device, &statisticsPoolCreateInfo, nullptr, &frame.statisticsPool) != VK_SUCCESS)
+            {
+                frame.statisticsPool = VK_NULL_HANDLE;
+                statistics = false;
+            }
+        }
+    }
+
+    statisticsResults.assign(VK_PROFILER_STATISTICS_COUNT, 0);
+    return isSupported();
+}
+
+void VkProfiler::destroy()
+{
+    for (Frame &frame : frames)
+    {
+        if (frame.timestampPool != VK_NULL_HANDLE)
+        {
+            vkDestroyQueryPool(device, frame.timestampPool, nullptr);
+        }
+        if (frame.statisticsPool != VK_NULL_HANDLE)
+        {
+            vkDestroyQueryPool(device, frame.statisticsPool, nullptr);
+        }
+    }
+    frames.clear();
+    scopeNames.clear();
+    timings.clear();
+}
+
+bool VkProfiler::isSupported() const
+{
+    return maxScopes > 0;
+}
+
+bool VkProfiler::hasStatistics() const
+{
+    return statistics;
+}
+
+void VkProfiler::beginFrame(VkCommandBuffer commandBuffer, uint32_t frame)
+{
+    Frame &current = frames[frame];
+    current.scopes.clear();
+    if (current.timestampPool != VK_NULL_HANDLE)
+    {
+        vkCmdResetQueryPool(commandBuffer, current.timestampPool, 0, maxScopes * 2);
+    }
+    if (statistics && current.statisticsPool != VK_NULL_HANDLE)
+    {
+        vkCmdResetQueryPool(commandBuffer, current.statisticsPool, 0, 1);
+    }
+}
+
+uint32_t VkProfiler::beginScope(VkCommandBuffer commandBuffer, uint32_t frame, const char *name)
+{
+    Frame &current = frames[frame];
+    if (current.timestampPool == VK_NULL_HANDLE || current.scopes.size() >= maxScopes)
+    {
+        return UINT32_MAX;
+    }
+
+    uint32_t slot = static_cast<uint32_t>(current.scopes.size());
+    current.scopes.push_back(registerScope(name));
+    vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, current.timestampPool, slot * 2);
+    return slot;
+}
+
+void VkProfiler::endScope(VkCommandBuffer commandBuffer, uint32_t frame, uint32_t scope)
+{
+    if (scope == UINT32_MAX)
+    {
+        return;
+    }
+    vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, frames[frame].timestampPool, scope * 2 + 1);
+}
+
+void VkProfiler::beginStatistics(VkCommandBuffer commandBuffer, uint32_t frame)
+{
+    if (statistics)
+    {
+        vkCmdBeginQuery(commandBuffer, frames[frame].statisticsPool, 0, 0);
+    }
+}
+
+void VkProfiler::endStatistics(VkCommandBuffer commandBuffer, uint32_t frame)
+{
+    if (statistics)
+    {
+        vkCmdEndQuery(commandBuffer, frames[frame].statisticsPool, 0);
+    }
+}
+
+void VkProfiler::submitted(uint32_t frame)
+{
+    if (frame < frames.size())
+    {
+        frames[frame].submitted = true;
+    }
+}
+
+bool VkProfiler::collect(uint32_t frame)
+{
+    if (frame >= frames.size() || !frames[frame].submitted)
+    {
+        return false;
+    }
+
+    Frame &current = frames[frame];
+    bool collected = false;
+
+    uint32_t scopeCount = static_cast<uint32_t>(current.scopes.size());
+    if (current.timestampPool != VK_NULL_HANDLE && scopeCount > 0)
+    {
+        // Every query is followed by its availability value, so the read never blocks.
+        std::vector<uint64_t> results(scopeCount * 4);
+        VkResult result = vkGetQueryPoolResults(device, current.timestampPool, 0, scopeCount * 2,
+                                                results.size() * sizeof(uint64_t), results.data(), 2 * sizeof(uint64_t),
+                                                VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WITH_AVAILABILITY_BIT);
+
+        bool available = result == VK_SUCCESS;
+        for (uint32_t i = 0; available && i < scopeCount * 2; i++)
+        {
+            available = results[i * 2 + 1] != 0;
+        }
+
+        if (available)
+        {
+            timings.assign(scopeNames.size(), 0.0);
+            for (uint32_t i = 0; i < scopeCount; i++)
+            {
+                uint64_t begin = results[i * 4] & timestampMask;
+                uint64_t end = results[i * 4 + 2] & timestampMask;
+                uint64_t ticks = (end - begin) & timestampMask;
+                timings[current.scopes[i]] += static_cast<double>(ticks) * timestampPeriod / 1.0e6;
+            }
+            collected = true;
+        }
+    }
+
+    if (statistics && current.statisticsPool != VK_NULL_HANDLE)
+    {
+        uint64_t results[VK_PROFILER_STATISTICS_COUNT + 1] = {};
+        VkResult result = vkGetQueryPoolResults(device, current.statisticsPool, 0, 1, sizeof(results), results, sizeof(results),
+                                                VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WITH_AVAILABILITY_BIT);
+        if (result == VK_SUCCESS && results[VK_PROFILER_STATISTICS_COUNT] != 0)
+        {
+            statisticsResults.assign(results, results + VK_PROFILER_STATISTICS_COUNT);
+            collected = true;
+        }
+    }
+
+    return collected;
+}
+
+const std::vector<std::string> &VkProfiler::getScopeNames() const
+{
+    return scopeNames;
+}
+
+const std::vector<double> &VkProfiler::getTimings() const
+{
+    return timings;
+}
+
+const std::vector<uint64_t> &VkProfiler::getStatistics() const
+{
+    return statisticsResults;
+}
+
+uint32_t VkProfiler::registerScope(const char *name)
+{
+    for (uint32_t i = 0; i < scopeNames.size(); i++)
+    {
+        if (scopeNames[i] == name)
+        {
+            return i;
+        }
+    }
+    scopeNames.emplace_back(name);
+    return static_cast<uint32_t>(scopeNames.size() - 1);
+}
@@ -0,0 +1,502 @@
+/**
+ * @file VkRenderGraph.cpp
+ * @author Lenard Büsing (nodedev74@gmail.com)
+ * @brief Frame passes with barriers, layout transitions and transient images derived from their resource accesses.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2023 Lenard Büsing
+ *
+ */
+
+#include "vulkan/VkRenderGraph.hpp"
+#include "core/Tracer.hpp"
+
+#include "volk.h"
+
+#include <algorithm>
+
+namespace
+{
+    constexpr VkAccessFlags2KHR WRITE_ACCESS = VK_ACCESS_2_SHADER_WRITE_BIT_KHR | VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT_KHR |
+                                               VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT_KHR | VK_ACCESS_2_TRANSFER_WRITE_BIT_KHR |
+                                               VK_ACCESS_2_HOST_WRITE_BIT_KHR | VK_ACCESS_2_MEMORY_WRITE_BIT_KHR;
+}
+
+void VkRenderGraph::create(VkDevice device, VkMemoryTracker &memoryTracker, bool synchronization2)
+{
+    this->device = device;
+    this->memoryTracker = &memoryTracker;
+    this->synchronization2 = synchronization2;
+}
+
+void VkRenderGraph::destroy()
+{
+    for (Resource &resource : resources)
+    {
+        if (!resource.transient)
+        {
+            continue;
+        }
+        vkDestroyImageView(device, resource.view, nullptr);
+        vkDestroyImage(device, resource.slots[0].image, nullptr);
+    }
+    memoryTracker->free(transientMemory);
+    *this = VkRenderGraph();
+}
+
+uint32_t VkRenderGraph::importBuffer(const char *name, uint32_t slotCount, const RenderGraphState &state)
+{
+    Resource resource;
+    resource.name = name;
+    resource.slots.resize(std::max(slotCount, 1u));
+    for (SlotState &slot : resource.slots)
+    {
+        slot.readStages = state.stages;
+        slot.readAccess = state.access;
+    }
+    resources.push_back(std::move(resource));
+    return static_cast<uint32_t>(resources.size() - 1);
+}
+
+uint32_t VkRenderGraph::importImage(const char *name, const std::vector<VkImage> &images, const VkImageSubresourceRange &range, const RenderGraphState &state)
+{
+    uint32_t index = importBuffer(name, static_cast<uint32_t>(images.size()), state);
+    Resource &resource = resources[index];
+    resource.image = true;
+    for (size_t i = 0; i < images.size(); i++)
+    {
+        resource.slots[i].image = images[i];
+        resource.slots[i].range = range;
+        resource.slots[i].layout = state.layout;
+    }
+    return index;
+}
+
+void VkRenderGraph::setImage(uint32_t resource, uint32_t slot, VkImage image, const VkImageSubresourceRange &range)
+{
+    resources[resource].slots[slot].image = image;
+    resources[resource].slots[slot].range = range;
+}
+
+uint32_t VkRenderGraph::createImage(const char *name, const VkImageCreateInfo &createInfo, VkImageAspectFlags aspect)
+{
+    Resource resource;
+    resource.name = name;
+    resource.image = true;
+    resource.transient = true;
+    resource.slots.resize(1);
+    resource.slots[0].range = {aspect, 0, createInfo.mipLevels, 0, createInfo.arrayLayers};
+    resource.createInfo = createInfo;
+    resource.aspect = aspect;
+    resources.push_back(std::move(resource));
+    return static_cast<uint32_t>(resources.size() - 1);
+}
+
+uint32_t VkRenderGraph::addPass(const char *name, std::function<void(VkCommandBuffer, uint32_t)> record)
+{
+    Pass pass;
+    pass.name = name;
+    pass.record = std::move(record);
+    passes.push_back(std::move(pass));
+    return static_cast<uint32_t>(passes.size() - 1);
+}
+
+void VkRenderGraph::read(uint32_t pass, uint32_t resource, const RenderGraphState &state)
+{
+    addAccess(pass, resource, state, false, false);
+}
+
+void VkRenderGraph::write(uint32_t pass, uint32_t resource, const RenderGraphState &state, bool discard)
+{
+    addAccess(pass, resource, state, true, discard);
+}
+
+void VkRenderGraph::setOutput(uint32_t resource, bool output)
+{
+    resources[resource].output = output;
+}
+
+void VkRenderGraph::setFinalState(uint32_t resource, const RenderGraphState &finalState)
+{
+    resources[resource].finalState = finalState;
+}
+
+void VkRenderGraph::setEnabled(uint32_t pass, bool enabled)
+{
+    passes[pass].enabled = enabled;
+}
+
+void VkRenderGraph::setAccessEnabled(uint32_t pass, uint32_t resource, bool enabled)
+{
+    for (Access &access : passes[pass].accesses)
+    {
+        if (access.resource == resource)
+        {
+            access.enabled = enabled;
+        }
+    }
+}
+
+VkResult VkRenderGraph::allocate()
+{
+    TRACE_ZONE("VkRenderGraph.allocate");
+
+    std::vector<uint32_t> transients;
+    for (uint32_t i = 0; i < resources.size(); i++)
+    {
+        Resource &resource = resources[i];
+        if (!resource.transient)
+        {
+            continue;
+        }
+        resource.firstPass = static_cast<uint32_t>(passes.size());
+        resource.lastPass = 0;
+        for (uint32_t pass = 0; pass < passes.size(); pass++)
+        {
+            for (const Access &access : passes[pass].accesses)
+            {
+                if (access.resource == i)
+                {
+                    resource.firstPass = std::min(resource.firstPass, pass);
+                    resource.lastPass = std::max(resource.lastPass, pass);
+                    resource.memoryStages |= access.state.stages;
+                    resource.memoryAccess |= access.state.access;
+                }
+            }
+        }
+
+        VkResult result = vkCreateImage(device, &resource.createInfo, nullptr, &resource.slots[0].image);
+        if (result != VK_SUCCESS)
+        {
+            return result;
+        }
+        vkGetImageMemoryRequirements(device, resource.slots[0].image, &resource.memoryRequirements);
+        transients.push_back(i);
+    }
+    if (transients.empty())
+    {
+        return VK_SUCCESS;
+    }
+
+    // Largest first, each at the lowest offset free of the transients whose pass ranges overlap its own
+    std::sort(transients.begin(), transients.end(), [this](uint32_t a, uint32_t b)
+              { return resources[a].memoryRequirements.size > resources[b].memoryRequirements.size; });
+    VkMemoryRequirements memoryRequirements = {0, 1, ~0u};
+    for (size_t i = 0; i < transients.size(); i++)
+    {
+        Resource &resource = resources[transients[i]];
+        VkDeviceSize alignment = resource.memoryRequirements.alignment;
+        VkDeviceSize offset = 0;
+        bool moved = true;
+        while (moved)
+        {
+            moved = false;
+            for (size_t j = 0; j < i; j++)
+            {
+                const Resource &placed = resources[transients[j]];
+                bool timeOverlap = resource.firstPass <= placed.lastPass && placed.firstPass <= resource.lastPass;
+                bool memoryOverlap = offset < placed.offset + placed.memoryRequirements.size && placed.offset < offset + resource.memoryRequirements.size;
+                if (timeOverlap && memoryOverlap)
+                {
+                    offset = (placed.offset + placed.memoryRequirements.size + alignment - 1) / alignment * alignment;
+                    moved = true;
+                }
+            }
+        }
+        resource.offset = offset;
+        memoryRequirements.size = std::max(memoryRequirements.size, offset + resource.memoryRequirements.size);
+        memoryRequirements.alignment = std::max(memoryRequirements.alignment, alignment);
+        memoryRequirements.memoryTypeBits &= resource.memoryRequirements.memoryTypeBits;
+        transientBytes += resource.memoryRequirements.size;
+    }
+
+    // The first access of a transient in a frame waits for every access of the transients sharing its memory
+    for (uint32_t a : transients)
+    {
+        for (uint32_t b : transients)
+        {
+            const Resource &other = resources[b];
+            if (resources[a].offset < other.offset + other.memoryRequirements.size && other.offset < resources[a].offset + resources[a].memoryRequirements.size)
+            {
+                resources[a].aliasStages |= other.memoryStages;
+                resources[a].aliasAccess |= other.memoryAccess & WRITE_ACCESS;
+            }
+        }
+    }
+
+    VkResult result = memoryTracker->allocate(memoryRequirements, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, MemoryCategory::Target,
+                                              transientMemory);
+    if (result != VK_SUCCESS)
+    {
+        return result;
+    }
+    transientMemorySize = memoryRequirements.size;
+
+    for (uint32_t index : transients)
+    {
+        Resource &resource = resources[index];
+        result = vkBindImageMemory(device, resource.slots[0].image, transientMemory, resource.offset);
+        if (result != VK_SUCCESS)
+        {
+            return result;
+        }
+
+        VkImageViewCreateInfo imageViewCreateInfo = {
+            VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO,
+            nullptr,
+            0,
+            resource.slots[0].image,
+            VK_IMAGE_VIEW_TYPE_2D,
+            resource.createInfo.format,
+            {VK_COMPONENT_SWIZZLE_IDENTITY, VK_COMPONENT_SWIZZLE_IDENTITY, VK_COMPONENT_SWIZZLE_IDENTITY, VK_COMPONENT_SWIZZLE_IDENTITY},
+            resource.slots[0].range,
+        };
+        result = vkCreateImageView(device, &imageViewCreateInfo, nullptr, &resource.view);
+        if (result != VK_SUCCESS)
+        {
+            return result;
+        }
+    }
+    return VK_SUCCESS;
+}
+
+VkImageView VkRenderGraph::getImageView(uint32_t resource) const
+{
+    return resources[resource].view;
+}
+
+void VkRenderGraph::execute(VkCommandBuffer commandBuffer, uint32_t frame)
+{
+    TRACE_ZONE("VkRenderGraph.execute");
+
+    barrierCount = 0;
+    barrierBatchCount = 0;
+    culledPassCount = 0;
+
+    // Walk backwards from the outputs, a pass is kept if a kept later pass or an output needs one of its writes
+    std::vector<bool> needed(resources.size());
+    for (size_t i = 0; i < resources.size(); i++)
+    {
+        needed[i] = resources[i].output;
+    }
+    std::vector<bool> kept(passes.size());
+    for (size_t i = passes.size(); i-- > 0;)
+    {
+        const Pass &pass = passes[i];
+        if (!pass.enabled)
+        {
+            continue;
+        }
+        kept[i] = std::any_of(pass.accesses.begin(), pass.accesses.end(), [&needed](const Access &access)
+                              { return access.enabled && access.write && needed[access.resource]; });
+        if (!kept[i])
+        {
+            culledPassCount++;
+            continue;
+        }
+        for (const Access &access : pass.accesses)
+        {
+            if (access.enabled && !access.write)
+            {
+                needed[access.resource] = true;
+            }
+        }
+    }
+
+    for (Resource &resource : resources)
+    {
+        for (SlotState &slot : resource.slots)
+        {
+            slot.touched = false;
+        }
+    }
+
+    for (size_t i = 0; i < passes.size(); i++)
+    {
+        if (!kept[i])
+        {
+            continue;
+        }
+        const Pass &pass = passes[i];
+        for (const Access &access : pass.accesses)
+        {
+            if (!access.enabled)
+            {
+                continue;
+            }
+            uint32_t slot = resources[access.resource].slots.size() > 1 ? frame : 0;
+            transition(access.resource, slot, access.state, access.write, access.discard);
+        }
+        flush(commandBuffer);
+        pass.record(commandBuffer, frame);
+    }
+
+    for (uint32_t i = 0; i < resources.size(); i++)
+    {
+        const Resource &resource = resources[i];
+        if (!resource.output || resource.finalState.stages == 0)
+        {
+            continue;
+        }
+        for (uint32_t slot = 0; slot < resource.slots.size(); slot++)
+        {
+            if (resource.slots[slot].touched)
+            {
+                transition(i, slot, resource.finalState, false, false);
+            }
+        }
+    }
+    flush(commandBuffer);
+}
+
+bool VkRenderGraph::isSynchronization2Enabled() const
+{
+    return synchronization2;
+}
+
+uint32_t VkRenderGraph::getBarrierCount() const
+{
+    return barrierCount;
+}
+
+uint32_t VkRenderGraph::getBarrierBatchCount() const
+{
+    return barrierBatchCount;
+}
+
+uint32_t VkRenderGraph::getCulledPassCount() const
+{
+    return culledPassCount;
+}
+
+VkDeviceSize VkRenderGraph::getTransientBytes() const
+{
+    return transientBytes;
+}
+
+VkDeviceSize VkRenderGraph::getTransientMemory() const
+{
+    return transientMemorySize;
+}
+
+void VkRenderGraph::addAccess(uint32_t pass, uint32_t resource, const RenderGraphState &state, bool write, bool discard)
+{
+    // A pass accesses a resource once, a read and a write of the same pass are merged into a write
+    for (Access &access : passes[pass].accesses)
+    {
+        if (access.resource == resource)
+        {
+            access.state.stages |= state.stages;
+            access.state.access |= state.access;
+            access.write = access.write || write;
+            access.discard = access.discard && discard;
+            return;
+        }
+    }
+    passes[pass].accesses.push_back({resource, state, write, discard});
+}
+
+void VkRenderGraph::transition(uint32_t resource, uint32_t slot, const RenderGraphState &state, bool write, bool discard)
+{
+    Resource &target = resources[resource];
+    SlotState &current = target.slots[slot];
+    bool firstUse = target.transient && !current.touched;
+    current.touched = true;
+
+    bool layoutChange = target.image && (firstUse || state.layout != current.layout);
+    if (!write && !layoutChange)
+    {
+        // Reads only wait for the last write, and only in the stages that have not seen it yet
+        bool unseen = (state.stages & ~current.readStages) != 0 || (state.access & ~current.readAccess) != 0;
+        if (current.writeStages != 0 && unseen)
+        {
+            memoryBarrier.srcStageMask |= current.writeStages;
+            memoryBarrier.srcAccessMask |= current.writeAccess;
+            memoryBarrier.dstStageMask |= state.stages;
+            memoryBarrier.dstAccessMask |= state.access;
+        }
+        current.readStages |= state.stages;
+        current.readAccess |= state.access;
+        return;
+    }
+
+    VkPipelineStageFlags2KHR srcStages = firstUse ? target.aliasStages : current.writeStages | current.readStages;
+    VkAccessFlags2KHR srcAccess = firstUse ? target.aliasAccess : current.writeAccess;
+    if (layoutChange)
+    {
+        // A transient starts undefined in every frame and waits for the last use of its memory
+        VkImageLayout oldLayout = firstUse || discard ? VK_IMAGE_LAYOUT_UNDEFINED : current.layout;
+        imageBarriers.push_back({VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2_KHR, nullptr, srcStages, srcAccess, state.stages, state.access,
+                                 oldLayout, state.layout, VK_QUEUE_FAMILY_IGNORED, VK_QUEUE_FAMILY_IGNORED, current.image, current.range});
+        current.layout = state.layout;
+    }
+    else if (srcStages != 0)
+    {
+        memoryBarrier.srcStageMask |= srcStages;
+        memoryBarrier.srcAccessMask |= srcAccess;
+        memoryBarrier.dstStageMask |= state.stages;
+        memoryBarrier.dstAccessMask |= state.access;
+    }
+
+    if (write)
+    {
+        current.writeStages = state.stages;
+        current.writeAccess = state.access & WRITE_ACCESS;
+        current.readStages = 0;
+        current.readAccess = 0;
+    }
+    else
+    {
+        // The layout transition acts as a write the stages of this read have already seen
+        current.writeStages = state.stages;
+        current.writeAccess = 0;
+        current.readStages = state.stages;
+        current.readAccess = state.access;
+    }
+}
+
+void VkRenderGraph::flush(VkCommandBuffer commandBuffer)
+{
+    bool hasMemoryBarrier = memoryBarrier.srcStageMask != 0 || memoryBarrier.dstStageMask != 0;
+    if (!hasMemoryBarrier && imageBarriers.empty())
+    {
+        return;
+    }
+    barrierCount += static_cast<uint32_t>(imageBarriers.size()) + (hasMemoryBarrier ? 1 : 0);
+    barrierBatchCount++;
+
+    if (synchronization2)
+    {
+        memoryBarrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER_2_KHR;
+        VkDependencyInfoKHR dependencyInfo{VK_STRUCTURE_TYPE_DEPENDENCY_INFO_KHR};
+        dependencyInfo.memoryBarrierCount = hasMemoryBarrier ? 1 : 0;
+        dependencyInfo.pMemoryBarriers = &memoryBarrier;
+        dependencyInfo.imageMemoryBarrierCount = static_cast<uint32_t>(imageBarriers.size());
+        dependencyInfo.pImageMemoryBarriers = imageBarriers.data();
+        vkCmdPipelineBarrier2KHR(commandBuffer, &dependencyInfo);
+    }
+    else
+    {
+        // The flags used by the passes exist in both flag sets with the same values, one stage pair covers the batch
+        VkPipelineStageFlags srcStages = static_cast<VkPipelineStageFlags>(memoryBarrier.srcStageMask);
+        VkPipelineStageFlags dstStages = static_cast<VkPipelineStageFlags>(memoryBarrier.dstStageMask);
+        std::vector<VkImageMemoryBarrier> legacyImageBarriers;
+        for (const VkImageMemoryBarrier2KHR &barrier : imageBarriers)
+        {
+            srcStages |= static_cast<VkPipelineStageFlags>(barrier.srcStageMask);
+            dstStages |= static_cast<VkPipelineStageFlags>(barrier.dstStageMask);
+            legacyImageBarriers.push_back({VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER, nullptr, static_cast<VkAccessFlags>(barrier.srcAccessMask),
+                                           static_cast<VkAccessFlags>(barrier.dstAccessMask), barrier.oldLayout, barrier.newLayout,
+                                           VK_QUEUE_FAMILY_IGNORED, VK_QUEUE_FAMILY_IGNORED, barrier.image, barrier.subresourceRange});
+        }
+        VkMemoryBarrier legacyMemoryBarrier = {VK_STRUCTURE_TYPE_MEMORY_BARRIER, nullptr, static_cast<VkAccessFlags>(memoryBarrier.srcAccessMask),
+                                               static_cast<VkAccessFlags>(memoryBarrier.dstAccessMask)};
+        vkCmdPipelineBarrier(commandBuffer, srcStages != 0 ? srcStages : VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
+                             dstStages != 0 ? dstStages : VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, 0, hasMemoryBarrier ? 1 : 0, &legacyMemoryBarrier, 0, nullptr,
+                             static_cast<uint32_t>(legacyImageBarriers.size()), legacyImageBarriers.data());
+    }
+
+    memoryBarrier = VkMemoryBarrier2KHR{};
+    imageBarriers.clear();
+}
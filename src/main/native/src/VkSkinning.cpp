@@ -0,0 +1,325 @@
+/**
+ * @file VkSkinning.cpp
+ * @author Lenard Büsing (nodedev74@gmail.com)
+ * @brief Compute shader skinning of skin instances into a shared vertex buffer.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2023 Lenard Büsing
+ *
+ */
+
+#include "vulkan/VkSkinning.hpp"
+#include "anim/Skin.hpp"
+#include "scene/SceneGraph.hpp"
+#include "core/ThreadPool.hpp"
+#include "core/Tracer.hpp"
+
+#include "volk.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace
+{
+    constexpr uint32_t SKINNING_GROUP_SIZE = 64;
+    constexpr uint32_t SKINNING_BINDINGS = 5;
+    constexpr uint32_t JOINT_GRAIN = 64;
+
+    struct InstanceEntry
+    {
+        uint32_t baseVertex;
+        uint32_t vertexCount;
+        uint32_t baseJoint;
+        uint32_t baseOutput;
+    };
+}
+
+VkResult VkSkinning::create(VkDevice device, VkMemoryTracker &memoryTracker, VkShaderModule shader, uint32_t frameCount,
+                            uint32_t vertexCapacity, uint32_t skinnedVertexCapacity, uint32_t jointCapacity, uint32_t instanceCapacity)
+{
+    this->device = device;
+    this->memoryTracker = &memoryTracker;
+    this->vertexCapacity = std::max<uint32_t>(vertexCapacity, 1);
+    this->skinnedVertexCapacity = std::max<uint32_t>(skinnedVertexCapacity, 1);
+    this->jointCapacity = std::max<uint32_t>(jointCapacity, 1);
+    this->instanceCapacity = std::max<uint32_t>(instanceCapacity, 1);
+
+    // Bind data is written once per skin, so memory the host can write directly is preferred over a staging copy
+    VkResult result = createBuffer(this->vertexCapacity * 4 * sizeof(float), VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, positionBuffer);
+    if (result == VK_SUCCESS)
+        result = createBuffer(this->vertexCapacity * sizeof(SkinInfluence), VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, influenceBuffer);
+    std::vector<VkDeviceSize> offsets;
+    if (result == VK_SUCCESS)
+        result = allocate({positionBuffer, influenceBuffer}, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT | VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+                          VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, MemoryCategory::Vertex, bindMemory, offsets);
+    if (result == VK_SUCCESS)
+    {
+        influenceOffset = offsets[1];
+        result = vkMapMemory(device, bindMemory, 0, VK_WHOLE_SIZE, 0, reinterpret_cast<void **>(&bindPointer));
+    }
+
+    if (result == VK_SUCCESS)
+        result = createBuffer(this->skinnedVertexCapacity * 4 * sizeof(float), VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT, outputBuffer);
+    if (result == VK_SUCCESS)
+        result = allocate({outputBuffer}, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, 0, MemoryCategory::Vertex, outputMemory, offsets);
+
+    frames.resize(frameCount);
+    std::vector<VkBuffer> frameBuffers;
+    for (Frame &frame : frames)
+    {
+        if (result == VK_SUCCESS)
+            result = createBuffer(this->jointCapacity * sizeof(Matrix4), VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, frame.jointBuffer);
+        if (result == VK_SUCCESS)
+            result = createBuffer(this->instanceCapacity * sizeof(InstanceEntry), VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, frame.instanceBuffer);
+        if (result == VK_SUCCESS)
+            result = createBuffer(sizeof(VkDispatchIndirectCommand), VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT, frame.dispatchBuffer);
+        frameBuffers.insert(frameBuffers.end(), {frame.jointBuffer, frame.instanceBuffer, frame.dispatchBuffer});
+    }
+    if (result == VK_SUCCESS)
+        result = allocate(frameBuffers, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+                          VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, MemoryCategory::Uniform, frameMemory, offsets);
+    char *framePointer = nullptr;
+    if (result == VK_SUCCESS)
+        result = vkMapMemory(device, frameMemory, 0, VK_WHOLE_SIZE, 0, reinterpret_cast<void **>(&framePointer));
+    if (result != VK_SUCCESS)
+    {
+        return result;
+    }
+    for (size_t i = 0; i < frames.size(); i++)
+    {
+        frames[i].jointPointer = framePointer + offsets[i * 3];
+        frames[i].instancePointer = framePointer + offsets[i * 3 + 1];
+        frames[i].dispatchPointer = framePointer + offsets[i * 3 + 2];
+        VkDispatchIndirectCommand empty = {0, 0, 1};
+        memcpy(frames[i].dispatchPointer, &empty, sizeof(empty));
+    }
+
+    VkDescriptorSetLayoutBinding bindings[SKINNING_BINDINGS];
+    for (uint32_t i = 0; i < SKINNING_BINDINGS; i++)
+    {
+        bindings[i] = {i, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, VK_SHADER_STAGE_COMPUTE_BIT, nullptr};
+    }
+    VkDescriptorSetLayoutCreateInfo layoutCreateInfo{VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO};
+    layoutCreateInfo.bindingCount = SKINNING_BINDINGS;
+    layoutCreateInfo.pBindings = bindings;
+    result = vkCreateDescriptorSetLayout(device, &layoutCreateInfo, nullptr, &descriptorSetLayout);
+    if (result != VK_SUCCESS)
+    {
+        return result;
+    }
+
+    VkDescriptorPoolSize poolSize = {VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, SKINNING_BINDINGS * frameCount};
+    VkDescriptorPoolCreateInfo poolCreateInfo{VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO};
+    poolCreateInfo.maxSets = frameCount;
+    poolCreateInfo.poolSizeCount = 1;
+    poolCreateInfo.pPoolSizes = &poolSize;
+    result = vkCreateDescriptorPool(device, &poolCreateInfo, nullptr, &descriptorPool);
+    if (result != VK_SUCCESS)
+    {
+        return result;
+    }
+
+    for (Frame &frame : frames)
+    {
+        VkDescriptorSetAllocateInfo allocateInfo{VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO};
+        allocateInfo.descriptorPool = descriptorPool;
+        allocateInfo.descriptorSetCount = 1;
+        allocateInfo.pSetLayouts = &descriptorSetLayout;
+        result = vkAllocateDescriptorSets(device, &allocateInfo, &frame.descriptorSet);
+        if (result != VK_SUCCESS)
+        {
+            return result;
+        }
+
+        VkDescriptorBufferInfo bufferInfos[SKINNING_BINDINGS] = {
+            {positionBuffer, 0, VK_WHOLE_SIZE},
+            {influenceBuffer, 0, VK_WHOLE_SIZE},
+            {frame.jointBuffer, 0, VK_WHOLE_SIZE},
+            {frame.instanceBuffer, 0, VK_WHOLE_SIZE},
+            {outputBuffer, 0, VK_WHOLE_SIZE},
+        };
+        VkWriteDescriptorSet writes[SKINNING_BINDINGS];
+        for (uint32_t i = 0; i < SKINNING_BINDINGS; i++)
+        {
+            writes[i] = {VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET, nullptr, frame.descriptorSet, i, 0, 1, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, nullptr, &bufferInfos[i], nullptr};
+        }
+        vkUpdateDescriptorSets(device, SKINNING_BINDINGS, writes, 0, nullptr);
+    }
+
+    VkPipelineLayoutCreateInfo pipelineLayoutInfo{VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO};
+    pipelineLayoutInfo.setLayoutCount = 1;
+    pipelineLayoutInfo.pSetLayouts = &descriptorSetLayout;
+    result = vkCreatePipelineLayout(device, &pipelineLayoutInfo, nullptr, &pipelineLayout);
+    if (result != VK_SUCCESS)
+    {
+        return result;
+    }
+
+    VkComputePipelineCreateInfo pipelineInfo{VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO};
+    pipelineInfo.stage.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+    pipelineInfo.stage.stage = VK_SHADER_STAGE_COMPUTE_BIT;
+    pipelineInfo.stage.module = shader;
+    pipelineInfo.stage.pName = "main";
+    pipelineInfo.layout = pipelineLayout;
+    return vkCreateComputePipelines(device, VK_NULL_HANDLE, 1, &pipelineInfo, nullptr, &pipeline);
+}
+
+void VkSkinning::destroy()
+{
+    if (device == VK_NULL_HANDLE)
+    {
+        return;
+    }
+
+    vkDestroyPipeline(device, pipeline, nullptr);
+    vkDestroyPipelineLayout(device, pipelineLayout, nullptr);
+    vkDestroyDescriptorPool(device, descriptorPool, nullptr);
+    vkDestroyDescriptorSetLayout(device, descriptorSetLayout, nullptr);
+    for (Frame &frame : frames)
+    {
+        vkDestroyBuffer(device, frame.jointBuffer, nullptr);
+        vkDestroyBuffer(device, frame.instanceBuffer, nullptr);
+        vkDestroyBuffer(device, frame.dispatchBuffer, nullptr);
+    }
+    memoryTracker->free(frameMemory);
+    vkDestroyBuffer(device, outputBuffer, nullptr);
+    memoryTracker->free(outputMemory);
+    vkDestroyBuffer(device, positionBuffer, nullptr);
+    vkDestroyBuffer(device, influenceBuffer, nullptr);
+    memoryTracker->free(bindMemory);
+
+    *this = VkSkinning();
+}
+
+int32_t VkSkinning::addSkin(const Skin &skin)
+{
+    uint32_t count = skin.getVertexCount();
+    if (vertexCount + count > vertexCapacity)
+    {
+        return -1;
+    }
+
+    memcpy(bindPointer + vertexCount * 4 * sizeof(float), skin.getPositions(), count * 4 * sizeof(float));
+    memcpy(bindPointer + influenceOffset + vertexCount * sizeof(SkinInfluence), skin.getInfluences(), count * sizeof(SkinInfluence));
+    skins.push_back({&skin, vertexCount});
+    vertexCount += count;
+    return static_cast<int32_t>(skins.size() - 1);
+}
+
+int32_t VkSkinning::addInstance(uint32_t skin, uint32_t nodeOffset)
+{
+    if (skin >= skins.size())
+    {
+        return -1;
+    }
+
+    const Skin &source = *skins[skin].skin;
+    if (instances.size() >= instanceCapacity || jointCount + source.getJointCount() > jointCapacity ||
+        skinnedVertexCount + source.getVertexCount() > skinnedVertexCapacity)
+    {
+        return -1;
+    }
+
+    instances.push_back({skin, nodeOffset, jointCount, skinnedVertexCount});
+    jointCount += source.getJointCount();
+    skinnedVertexCount += source.getVertexCount();
+    return static_cast<int32_t>(instances.size() - 1);
+}
+
+void VkSkinning::update(uint32_t frame, const SceneGraph *graph)
+{
+    TRACE_ZONE("VkSkinning.update");
+
+    Frame &target = frames[frame];
+    VkDispatchIndirectCommand dispatch = {0, 0, 1};
+    if (graph != nullptr && !instances.empty())
+    {
+        Matrix4 *jointMatrices = static_cast<Matrix4 *>(target.jointPointer);
+        InstanceEntry *entries = static_cast<InstanceEntry *>(target.instancePointer);
+
+        ThreadPool::shared().parallelFor(static_cast<uint32_t>(instances.size()), JOINT_GRAIN, [&](uint32_t begin, uint32_t end)
+                                         {
+            for (uint32_t i = begin; i < end; i++)
+            {
+                const Instance &instance = instances[i];
+                const SkinRange &range = skins[instance.skin];
+                range.skin->computeJointMatrices(*graph, instance.nodeOffset, jointMatrices + instance.baseJoint);
+                entries[i] = {range.baseVertex, range.skin->getVertexCount(), instance.baseJoint, instance.baseOutput};
+            } });
+
+        uint32_t maxVertexCount = 0;
+        for (const Instance &instance : instances)
+        {
+            maxVertexCount = std::max(maxVertexCount, skins[instance.skin].skin->getVertexCount());
+        }
+        dispatch.x = (maxVertexCount + SKINNING_GROUP_SIZE - 1) / SKINNING_GROUP_SIZE;
+        dispatch.y = static_cast<uint32_t>(instances.size());
+    }
+    memcpy(target.dispatchPointer, &dispatch, sizeof(dispatch));
+}
+
+void VkSkinning::record(VkCommandBuffer commandBuffer, uint32_t frame)
+{
+    vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, pipeline);
+    vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, pipelineLayout, 0, 1, &frames[frame].descriptorSet, 0, nullptr);
+    vkCmdDispatchIndirect(commandBuffer, frames[frame].dispatchBuffer, 0);
+}
+
+VkBuffer VkSkinning::getOutputBuffer() const
+{
+    return outputBuffer;
+}
+
+uint32_t VkSkinning::getOutputOffset(uint32_t instance) const
+{
+    return instances[instance].baseOutput;
+}
+
+uint32_t VkSkinning::getVertexCount(uint32_t instance) const
+{
+    return skins[instances[instance].skin].skin->getVertexCount();
+}
+
+uint32_t VkSkinning::getInstanceCount() const
+{
+    return static_cast<uint32_t>(instances.size());
+}
+
+VkResult VkSkinning::createBuffer(VkDeviceSize size, VkBufferUsageFlags usage, VkBuffer &buffer)
+{
+    VkBufferCreateInfo bufferCreateInfo = {
+        VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO,
+        nullptr,
+        0,
+        size,
+        usage,
+        VK_SHARING_MODE_EXCLUSIVE,
+        0,
+        nullptr,
+    };
+    return vkCreateBuffer(device, &bufferCreateInfo, nullptr, &buffer);
+}
+
+VkResult VkSkinning::allocate(const std::vector<VkBuffer> &buffers, VkMemoryPropertyFlags preferred, VkMemoryPropertyFlags required,
+                              MemoryCategory category, VkDeviceMemory &memory, std::vector<VkDeviceSize> &offsets)
+{
+    VkMemoryRequirements memoryRequirements = {0, 0, ~0u};
+    offsets.resize(buffers.size());
+    for (size_t i = 0; i < buffers.size(); i++)
+    {
+        VkMemoryRequirements bufferRequirements;
+        vkGetBufferMemoryRequirements(device, buffers[i], &bufferRequirements);
+        offsets[i] = (memoryRequirements.size + bufferRequirements.alignment - 1) & ~(bufferRequirements.alignment - 1);
+        memoryRequirements.size = offsets[i] + bufferRequirements.size;
+        memoryRequirements.alignment = std::max(memoryRequirements.alignment, bufferRequirements.alignment);
+        memoryRequirements.memoryTypeBits &= bufferRequirements.memoryTypeBits;
+    }
+
+    VkResult result = memoryTracker->allocate(memoryRequirements, preferred, required, category, memory);
+    for (size_t i = 0; result == VK_SUCCESS && i < buffers.size(); i++)
+    {
+        result = vkBindBufferMemory(device, buffers[i], memory, offsets[i]);
+    }
+    return result;
+}
@@ -0,0 +1,271 @@
+/**
+ * @file VkTextureStreamer.cpp
+ * @author Lenard Büsing (nodedev74@gmail.com)
+ * @brief Mip level streaming of textures within a residency budget.
+ * @version 0.1
+ * @date 2026-10-19
+ *
+ * @copyright Copyright (c) 2023 Lenard Büsing
+ *
+ */
+
+#include "vulkan/VkTextureStreamer.hpp"
+#include "core/Tracer.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+void VkTextureStreamer::setLimits(uint64_t budget, uint64_t bandwidth, uint32_t tailSize)
+{
+    this->budget = budget;
+    this->bandwidth = bandwidth;
+    this->tailSize = std::max(tailSize, 1u);
+}
+
+VkResult VkTextureStreamer::addTextures(VkBindless &bindless, VkQueue queue, VkCommandPool commandPool, std::vector<TextureData> &&textureData, uint32_t *indices)
+{
+    TRACE_ZONE("VkTextureStreamer.addTextures");
+
+    std::vector<uint32_t> tailLevels(textureData.size());
+    for (size_t i = 0; i < textureData.size(); i++)
+    {
+        const std::vector<TextureLevel> &levels = textureData[i].levels;
+        uint32_t level = 0;
+        while (level + 1 < levels.size() && std::max(levels[level].width, levels[level].height) > tailSize)
+        {
+            level++;
+        }
+        tailLevels[i] = level;
+    }
+    VkResult result = bindless.addTextures(queue, commandPool, textureData.data(), textureData.size(), tailLevels.data(), indices);
+    if (result != VK_SUCCESS)
+    {
+        return result;
+    }
+
+    for (size_t i = 0; i < textureData.size(); i++)
+    {
+        if (indices[i] >= streamedIndices.size())
+        {
+            streamedIndices.resize(indices[i] + 1, -1);
+        }
+        streamedIndices[indices[i]] = static_cast<int32_t>(streamedTextures.size());
+        uint32_t levelCount = static_cast<uint32_t>(textureData[i].levels.size());
+        streamedTextures.push_back({std::move(textureData[i]), indices[i], tailLevels[i], tailLevels[i], tailLevels[i], 0});
+        residentBytes += getLevelBytes(streamedTextures.back(), tailLevels[i], levelCount);
+    }
+    return VK_SUCCESS;
+}
+
+void VkTextureStreamer::destroy()
+{
+    *this = VkTextureStreamer();
+}
+
+bool VkTextureStreamer::isStreamed(uint32_t texture) const
+{
+    return texture < streamedIndices.size() && streamedIndices[texture] >= 0;
+}
+
+uint32_t VkTextureStreamer::getTextureCount() const
+{
+    return static_cast<uint32_t>(streamedTextures.size());
+}
+
+void VkTextureStreamer::beginFrame()
+{
+    frame++;
+}
+
+void VkTextureStreamer::request(uint32_t texture, float pixelsPerRepeat)
+{
+    StreamedTexture &streamed = streamedTextures[streamedIndices[texture]];
+    uint32_t level = streamed.tailLevel;
+    if (pixelsPerRepeat > 0.0f)
+    {
+        // One texel per pixel, the level the sampler picks for a surface facing the camera
+        float size = static_cast<float>(std::max(streamed.data.width, streamed.data.height));
+        float lod = std::floor(std::log2(size / pixelsPerRepeat));
+        level = lod <= 0.0f ? 0 : std::min(static_cast<uint32_t>(lod), streamed.tailLevel);
+    }
+    if (streamed.lastRequestFrame != frame)
+    {
+        streamed.lastRequestFrame = frame;
+        streamed.requestedLevel = level;
+    }
+    else
+    {
+        streamed.requestedLevel = std::min(streamed.requestedLevel, level);
+    }
+}
+
+VkResult VkTextureStreamer::update(VkBindless &bindless, VkQueue queue, VkCommandPool commandPool)
+{
+    TRACE_ZONE("VkTextureStreamer.update");
+
+    // Textures refined or evicted this frame, a texture is never both
+    std::vector<uint32_t> refined;
+    std::vector<uint32_t> evictable;
+    for (uint32_t i = 0; i < streamedTextures.size(); i++)
+    {
+        const StreamedTexture &streamed = streamedTextures[i];
+        uint32_t neededLevel = streamed.lastRequestFrame == frame ? streamed.requestedLevel : streamed.tailLevel;
+        if (neededLevel < streamed.residentLevel)
+            refined.push_back(i);
+        else if (neededLevel > streamed.residentLevel)
+            evictable.push_back(i);
+    }
+    std::sort(refined.begin(), refined.end(), [this](uint32_t a, uint32_t b)
+              { return streamedTextures[a].residentLevel - streamedTextures[a].requestedLevel > streamedTextures[b].residentLevel - streamedTextures[b].requestedLevel; });
+    std::sort(evictable.begin(), evictable.end(), [this](uint32_t a, uint32_t b)
+              { return streamedTextures[a].lastRequestFrame < streamedTextures[b].lastRequestFrame; });
+
+    std::vector<uint32_t> levels(streamedTextures.size());
+    for (uint32_t i = 0; i < streamedTextures.size(); i++)
+    {
+        levels[i] = streamedTextures[i].residentLevel;
+    }
+    uint64_t projectedBytes = residentBytes;
+    uint64_t frameBytes = 0;
+    size_t evicted = 0;
+    for (uint32_t i : refined)
+    {
+        const StreamedTexture &streamed = streamedTextures[i];
+        while (levels[i] > streamed.requestedLevel)
+        {
+            uint64_t bytes = streamed.data.levels[levels[i] - 1].size;
+            if (frameBytes > 0 && frameBytes + bytes > bandwidth)
+            {
+                break;
+            }
+            while (projectedBytes + bytes > budget && evicted < evictable.size())
+            {
+                uint32_t victim = evictable[evicted++];
+                const StreamedTexture &evictedTexture = streamedTextures[victim];
+                uint32_t neededLevel = evictedTexture.lastRequestFrame == frame ? evictedTexture.requestedLevel : evictedTexture.tailLevel;
+                projectedBytes -= getLevelBytes(evictedTexture, levels[victim], neededLevel);
+                levels[victim] = neededLevel;
+            }
+            if (projectedBytes + bytes > budget)
+            {
+                break;
+            }
+            frameBytes += bytes;
+            projectedBytes += bytes;
+            levels[i]--;
+        }
+    }
+
+    std::vector<TextureUpdate> updates;
+    for (uint32_t i = 0; i < streamedTextures.size(); i++)
+    {
+        if (levels[i] != streamedTextures[i].residentLevel)
+        {
+            updates.push_back({streamedTextures[i].texture, &streamedTextures[i].data, levels[i]});
+        }
+    }
+    uint64_t uploadedBytes = 0;
+    VkResult result = bindless.updateTextures(queue, commandPool, updates.data(), updates.size(), uploadedBytes);
+    if (result == VK_SUCCESS)
+    {
+        for (uint32_t i = 0; i < streamedTextures.size(); i++)
+        {
+            StreamedTexture &streamed = streamedTextures[i];
+            if (levels[i] > streamed.residentLevel)
+            {
+                evictedLevelCount += levels[i] - streamed.residentLevel;
+            }
+            streamed.residentLevel = levels[i];
+        }
+        residentBytes = projectedBytes;
+        streamedBytes += uploadedBytes;
+    }
+
+    reducedQualityCount = 0;
+    for (const StreamedTexture &streamed : streamedTextures)
+    {
+        if (streamed.lastRequestFrame == frame && streamed.residentLevel > streamed.requestedLevel)
+        {
+            reducedQualityCount++;
+        }
+    }
+    // The refused allocation marked its bytes for eviction, the next frame streams within what is left
+    return result == VK_ERROR_OUT_OF_DEVICE_MEMORY ? VK_SUCCESS : result;
+}
+
+uint64_t VkTextureStreamer::evict(VkBindless &bindless, VkQueue queue, VkCommandPool commandPool, uint64_t bytes)
+{
+    TRACE_ZONE("VkTextureStreamer.evict");
+
+    std::vector<uint32_t> evictable;
+    for (uint32_t i = 0; i < streamedTextures.size(); i++)
+    {
+        if (streamedTextures[i].residentLevel < streamedTextures[i].tailLevel)
+        {
+            evictable.push_back(i);
+        }
+    }
+    std::sort(evictable.begin(), evictable.end(), [this](uint32_t a, uint32_t b)
+              { return streamedTextures[a].lastRequestFrame < streamedTextures[b].lastRequestFrame; });
+
+    std::vector<TextureUpdate> updates;
+    std::vector<uint32_t> evicted;
+    uint64_t freedBytes = 0;
+    for (uint32_t i : evictable)
+    {
+        if (freedBytes >= bytes)
+        {
+            break;
+        }
+        const StreamedTexture &streamed = streamedTextures[i];
+        freedBytes += getLevelBytes(streamed, streamed.residentLevel, streamed.tailLevel);
+        updates.push_back({streamed.texture, &streamed.data, streamed.tailLevel});
+        evicted.push_back(i);
+    }
+    uint64_t uploadedBytes = 0;
+    VkResult result = bindless.updateTextures(queue, commandPool, updates.data(), updates.size(), uploadedBytes);
+    if (result != VK_SUCCESS)
+    {
+        return 0;
+    }
+
+    for (uint32_t i : evicted)
+    {
+        StreamedTexture &streamed = streamedTextures[i];
+        evictedLevelCount += streamed.tailLevel - streamed.residentLevel;
+        streamed.residentLevel = streamed.tailLevel;
+    }
+    residentBytes -= freedBytes;
+    budget = std::min(budget, residentBytes);
+    return freedBytes;
+}
+
+uint64_t VkTextureStreamer::getResidentBytes() const
+{
+    return residentBytes;
+}
+
+uint64_t VkTextureStreamer::getStreamedBytes() const
+{
+    return streamedBytes;
+}
+
+uint64_t VkTextureStreamer::getEvictedLevelCount() const
+{
+    return evictedLevelCount;
+}
+
+uint32_t VkTextureStreamer::getReducedQualityCount() const
+{
+    return reducedQualityCount;
+}
+
+uint64_t VkTextureStreamer::getLevelBytes(const StreamedTexture &streamed, uint32_t firstLevel, uint32_t endLevel) const
+{
+    uint64_t bytes = 0;
+    for (uint32_t level = firstLevel; level < endLevel; level++)
+    {
+        bytes += streamed.data.levels[level].size;
+    }
+    return bytes;
+}
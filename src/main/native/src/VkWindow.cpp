@@ -15,6 +15,107 @@
 #include <SDL2/SDL.h>
 #include <SDL2/SDL_vulkan.h>
 
+#include "core/Tracer.hpp"
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
+namespace
+{
+    /**
+     * @brief Header of the event ring shared with Java.
+     *
+     * The producer index and the consumer index live on separate cache lines. Both only grow
+     * and are masked with the capacity, which has to be a power of two.
+     */
+    struct EventRingHeader
+    {
+        uint32_t writeIndex;
+        uint32_t capacity;
+        uint32_t deferred;
+        uint32_t reserved[13];
+        uint32_t readIndex;
+        uint32_t padding[15];
+    };
+
+    /**
+     * @brief Fixed size record of a single SDL event.
+     */
+    struct EventRecord
+    {
+        int32_t type;
+        uint32_t timestamp;
+        uint32_t windowID;
+        int32_t data[5];
+    };
+
+    static_assert(sizeof(EventRingHeader) == 128, "The event ring header layout is shared with Java");
+    static_assert(sizeof(EventRecord) == 32, "The event record layout is shared with Java");
+
+    /**
+     * @brief Translates an SDL event into its fixed size record.
+     *
+     * @param event The SDL event.
+     * @param record The record to fill.
+     */
+    void translateEvent(const SDL_Event &event, EventRecord &record)
+    {
+        memset(&record, 0, sizeof(EventRecord));
+        record.type = static_cast<int32_t>(event.type);
+        record.timestamp = event.common.timestamp;
+
+        switch (event.type)
+        {
+        case SDL_KEYDOWN:
+        case SDL_KEYUP:
+            record.windowID = event.key.windowID;
+            record.data[0] = event.key.keysym.scancode;
+            record.data[1] = event.key.keysym.sym;
+            record.data[2] = event.key.keysym.mod;
+            record.data[3] = event.key.repeat;
+            break;
+        case SDL_MOUSEMOTION:
+            record.windowID = event.motion.windowID;
+            record.data[0] = event.motion.x;
+            record.data[1] = event.motion.y;
+            record.data[2] = event.motion.xrel;
+            record.data[3] = event.motion.yrel;
+            record.data[4] = static_cast<int32_t>(event.motion.state);
+            break;
+        case SDL_MOUSEBUTTONDOWN:
+        case SDL_MOUSEBUTTONUP:
+            record.windowID = event.button.windowID;
+            record.data[0] = event.button.x;
+            record.data[1] = event.button.y;
+            record.data[2] = event.button.button;
+            record.data[3] = event.button.clicks;
+            record.data[4] = event.button.state;
+            break;
+        case SDL_MOUSEWHEEL:
+            record.windowID = event.wheel.windowID;
+            record.data[0] = event.wheel.x;
+            record.data[1] = event.wheel.y;
+            record.data[2] = static_cast<int32_t>(event.wheel.direction);
+            break;
+        case SDL_WINDOWEVENT:
+            record.windowID = event.window.windowID;
+            record.data[0] = event.window.event;
+            record.data[1] = event.window.data1;
+            record.data[2] = event.window.data2;
+            break;
+        case SDL_TEXTINPUT:
+            record.windowID = event.text.windowID;
+            strncpy(reinterpret_cast<char *>(record.data), event.text.text, sizeof(record.data));
+            break;
+        case SDL_TEXTEDITING:
+            record.windowID = event.edit.windowID;
+            strncpy(reinterpret_cast<char *>(record.data), event.edit.text, sizeof(record.data));
+            break;
+        }
+    }
+}
+
 /**
  * @brief JNI function to create a Vulkan window.
  *
@@ -35,6 +136,37 @@ JNIEXPORT jlong JNICALL Java_com_github_nodedev74_jfbx_vulkan_VkWindow_create(JN
     return sdlWindowPtr;
 }
 
+/**
+ * @brief JNI function to create the event ring shared with Java.
+ *
+ * @param env The JNI environment.
+ * @param obj The Java object instance.
+ * @param capacity The number of event records, rounded up to a power of two.
+ * @return A direct ByteBuffer containing the ring header followed by the records.
+ */
+JNIEXPORT jobject JNICALL Java_com_github_nodedev74_jfbx_vulkan_VkWindow_createEventRing(JNIEnv *env, jobject obj, jint capacity)
+{
+    uint32_t records = 1;
+    while (records < static_cast<uint32_t>(capacity))
+    {
+        records <<= 1;
+    }
+
+    size_t size = sizeof(EventRingHeader) + static_cast<size_t>(records) * sizeof(EventRecord);
+    void *memory = calloc(1, size);
+    if (memory == nullptr)
+    {
+        jclass exceptionClass = env->FindClass("java/lang/OutOfMemoryError");
+        env->ThrowNew(exceptionClass, "Failed to allocate the event ring");
+        return nullptr;
+    }
+
+    EventRingHeader *header = reinterpret_cast<EventRingHeader *>(memory);
+    header->capacity = records;
+
+    return env->NewDirectByteBuffer(memory, static_cast<jlong>(size));
+}
+
 /**
  * @brief JNI function to destroy a Vulkan window.
  *
@@ -59,6 +191,14 @@ JNIEXPORT void JNICALL Java_com_github_nodedev74_jfbx_vulkan_VkWindow_destroy(JN
     SDL_Vulkan_UnloadLibrary();
     SDL_Quit();
 
+    jfieldID eventBufferFieldID = env->GetFieldID(cls, "eventBuffer", "Ljava/nio/ByteBuffer;");
+    jobject eventBuffer = env->GetObjectField(obj, eventBufferFieldID);
+    if (eventBuffer != nullptr)
+    {
+        free(env->GetDirectBufferAddress(eventBuffer));
+        env->SetObjectField(obj, eventBufferFieldID, nullptr);
+    }
+
     jmethodID methodID = env->GetMethodID(cls, "delete", "()V");
     env->CallVoidMethod(obj, methodID);
 }
@@ -100,36 +240,53 @@ JNIEXPORT void JNICALL Java_com_github_nodedev74_jfbx_vulkan_VkWindow_hide(JNIEn
 /**
  * @brief JNI function run the lifecycle of the SDLWindow
  *
+ * Translates every pending SDL event into a record of the event ring. Java drains the ring
+ * once per frame, so no JNI call is made per event. When the ring is full, the remaining
+ * events are left in the SDL queue for the next frame and the deferral is counted.
+ *
  * @param env The JNI environment.
  * @param obj The Java object instance.
  * @param sdlWindowPtr The pointer to the SDLWindow as a jlong value.
+ * @param eventBuffer The event ring created by createEventRing.
  */
-JNIEXPORT void JNICALL Java_com_github_nodedev74_jfbx_vulkan_VkWindow_run(JNIEnv *env, jobject obj, jlong sdlWindowPtr)
+JNIEXPORT void JNICALL Java_com_github_nodedev74_jfbx_vulkan_VkWindow_run(JNIEnv *env, jobject obj, jlong sdlWindowPtr, jobject eventBuffer)
 {
-    SDL_Event event;
-    while (SDL_PollEvent(&event))
-    {
-        if (event.type == SDL_QUIT)
-        {
-            jclass cls = env->GetObjectClass(obj);
-            jmethodID methodID = env->GetMethodID(cls, "destroy", "()V");
+    TRACE_ZONE("VkWindow.run");
 
-            env->CallVoidMethod(obj, methodID);
-        }
+    uint8_t *memory = static_cast<uint8_t *>(env->GetDirectBufferAddress(eventBuffer));
+    EventRingHeader *header = reinterpret_cast<EventRingHeader *>(memory);
+    EventRecord *records = reinterpret_cast<EventRecord *>(memory + sizeof(EventRingHeader));
 
-        if (event.type == SDL_WINDOWEVENT)
+    uint32_t mask = header->capacity - 1;
+    uint32_t writeIndex = __atomic_load_n(&header->writeIndex, __ATOMIC_RELAXED);
+    uint32_t readIndex = __atomic_load_n(&header->readIndex, __ATOMIC_ACQUIRE);
+
+    SDL_Event event;
+    while (true)
+    {
+        // A full ring stops polling, so the remaining events, quit and close requests included, stay
+        // in the SDL queue for the next frame instead of being lost
+        if (writeIndex - readIndex >= header->capacity)
         {
-            switch (event.window.event)
+            readIndex = __atomic_load_n(&header->readIndex, __ATOMIC_ACQUIRE);
+            if (writeIndex - readIndex >= header->capacity)
             {
-            case SDL_WINDOWEVENT_CLOSE:
-            {
-                jclass cls = env->GetObjectClass(obj);
-                jmethodID methodID = env->GetMethodID(cls, "destroy", "()V");
-
-                env->CallVoidMethod(obj, methodID);
+                if (SDL_HasEvents(SDL_FIRSTEVENT, SDL_LASTEVENT))
+                {
+                    __atomic_fetch_add(&header->deferred, 1, __ATOMIC_RELAXED);
+                }
                 break;
             }
-            }
         }
+
+        if (!SDL_PollEvent(&event))
+        {
+            break;
+        }
+
+        translateEvent(event, records[writeIndex & mask]);
+        writeIndex++;
     }
-}
\ No newline at end of file
+
+    __atomic_store_n(&header->writeIndex, writeIndex, __ATOMIC_RELEASE);
+}
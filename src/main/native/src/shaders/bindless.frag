@@ -0,0 +1,26 @@
+#version 450
+#extension GL_EXT_nonuniform_qualifier : require
+
+layout(location = 0) in vec3 fragColor;
+layout(location = 1) in vec2 fragTexCoord;
+layout(location = 2) flat in uint fragMaterial;
+
+layout(location = 0) out vec4 outColor;
+
+struct Material {
+    vec4 baseColor;
+    uint textureIndex;
+};
+
+layout(set = 2, binding = 0) uniform sampler2D textures[];
+
+// Every storage buffer of the array is seen through this block, the material table is buffer 0
+layout(std430, set = 2, binding = 1) readonly buffer Materials {
+    Material materials[];
+} buffers[];
+
+void main() {
+    Material material = buffers[0].materials[fragMaterial];
+    vec4 texel = texture(textures[nonuniformEXT(material.textureIndex)], fragTexCoord);
+    outColor = vec4(fragColor, 1.0) * material.baseColor * texel;
+}
@@ -0,0 +1,24 @@
+#version 450
+
+layout(location = 0) in vec3 fragColor;
+layout(location = 1) in vec2 fragTexCoord;
+layout(location = 2) flat in uint fragMaterial;
+
+layout(location = 0) out vec4 outColor;
+
+struct Material {
+    vec4 baseColor;
+    uint textureIndex;
+};
+
+layout(std430, set = 2, binding = 0) readonly buffer Materials {
+    Material materials[];
+};
+
+// The set of a material holds its own texture, the draws of a set share the material
+layout(set = 2, binding = 1) uniform sampler2D materialTexture;
+
+void main() {
+    Material material = materials[fragMaterial];
+    outColor = vec4(fragColor, 1.0) * material.baseColor * texture(materialTexture, fragTexCoord);
+}
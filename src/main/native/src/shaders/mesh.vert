@@ -0,0 +1,44 @@
+#version 450
+
+layout(location = 0) in vec3 position;
+
+layout(location = 0) out vec3 fragColor;
+layout(location = 1) out vec2 fragTexCoord;
+layout(location = 2) flat out uint fragMaterial;
+
+layout(std430, set = 0, binding = 0) readonly buffer Matrices {
+    mat4 matrices[];
+};
+
+struct DrawData {
+    uint matrixSlot;
+    uint materialIndex;
+    uint firstIndex;
+    uint indexCount;
+};
+
+// Every draw is a single instance whose first instance is its index in the draw list
+layout(std430, set = 1, binding = 0) readonly buffer Draws {
+    DrawData draws[];
+};
+
+layout(push_constant) uniform Frame {
+    mat4 viewProjection;
+} frame;
+
+// Draws of skinned vertices, which the joints already placed in world space
+const uint WORLD_SPACE_MATRIX_SLOT = 0xFFFFFFFFu;
+
+void main() {
+    uint matrixSlot = draws[gl_InstanceIndex].matrixSlot;
+    bool worldSpace = matrixSlot == WORLD_SPACE_MATRIX_SLOT;
+    vec4 worldPosition = worldSpace ? vec4(position, 1.0) : matrices[matrixSlot] * vec4(position, 1.0);
+    gl_Position = frame.viewProjection * worldPosition;
+    fragMaterial = draws[gl_InstanceIndex].materialIndex;
+    // Meshes carry no texture coordinates yet, so textures are projected along the y axis
+    fragTexCoord = position.xz;
+
+    // A color per matrix slot keeps neighbouring objects apart, world space draws use their draw index
+    uint hash = ((worldSpace ? uint(gl_InstanceIndex) : matrixSlot) + 1u) * 2654435761u;
+    fragColor = vec3(hash & 255u, (hash >> 8) & 255u, (hash >> 16) & 255u) / 255.0;
+}
@@ -0,0 +1,215 @@
+package com.github.nodedev74.jfbx;
+
+import static org.junit.jupiter.api.Assertions.assertEquals;
+import static org.junit.jupiter.api.Assertions.assertTrue;
+import static org.junit.jupiter.api.Assumptions.assumeTrue;
+
+import java.io.File;
+import java.util.Random;
+
+import org.junit.jupiter.api.Test;
+
+import com.github.nodedev74.jfbx.anim.AnimationSampler;
+import com.github.nodedev74.jfbx.anim.AnimationStack;
+import com.github.nodedev74.jfbx.fbx.FbxScene;
+import com.github.nodedev74.jfbx.scene.SceneGraph;
+
+public class AnimationTest {
+
+    @Test
+    public void interpolationTest() throws Exception {
+        NativeLoader.load("libvulkan");
+
+        AnimationStack stack = new AnimationStack("test", 0.0f, 2.0f);
+        stack.addChannel(0, AnimationStack.TRANSLATION_X, new float[] { 0.0f, 1.0f, 2.0f },
+                new float[] { 0.0f, 10.0f, 0.0f });
+        stack.addChannel(0, AnimationStack.ROTATION_Z, new float[0], new float[0]);
+
+        AnimationSampler sampler = new AnimationSampler(stack);
+        float[] values = new float[stack.getChannelCount()];
+        float[] expected = { 0.0f, 0.0f, 2.5f, 10.0f, 5.0f, 0.0f, 0.0f, 5.0f };
+        float[] times = { -1.0f, 0.0f, 0.25f, 1.0f, 1.5f, 2.0f, 3.0f, 0.5f };
+        for (int i = 0; i < times.length; i++) {
+            sampler.sample(times[i]);
+            sampler.getValues(values);
+            assertEquals(expected[i], values[0], 1e-5f);
+            assertEquals(0.0f, values[1], 1e-5f);
+        }
+
+        SceneGraph graph = new SceneGraph(new int[] { -1 });
+        sampler.apply(graph);
+        graph.update();
+        float[] matrix = new float[16];
+        graph.getWorldMatrix(0, matrix);
+        assertEquals(5.0f, matrix[12], 1e-5f);
+
+        graph.destroy();
+        sampler.destroy();
+        stack.destroy();
+    }
+
+    @Test
+    public void throughputTest() throws Exception {
+        NativeLoader.load("libvulkan");
+
+        int channelCount = 30_000;
+        int keyCount = 900;
+        float frameRate = 30.0f;
+        Random random = new Random(1);
+
+        AnimationStack stack = new AnimationStack("benchmark", 0.0f, keyCount / frameRate);
+        float[] times = new float[keyCount];
+        float[] values = new float[keyCount];
+        for (int key = 0; key < keyCount; key++) {
+            times[key] = key / frameRate;
+        }
+        for (int channel = 0; channel < channelCount; channel++) {
+            for (int key = 0; key < keyCount; key++) {
+                values[key] = random.nextFloat();
+            }
+            stack.addChannel(channel / 9, channel % 9, times, values);
+        }
+
+        int frames = 600;
+        for (boolean parallel : new boolean[] { false, true }) {
+            AnimationSampler sampler = new AnimationSampler(stack);
+            long startTime = System.nanoTime();
+            for (int frame = 0; frame < frames; frame++) {
+                sampler.sample(frame / 60.0f, parallel);
+            }
+            double playbackTime = (System.nanoTime() - startTime) / 1e6;
+
+            startTime = System.nanoTime();
+            for (int frame = 0; frame < frames; frame++) {
+                sampler.sample(random.nextFloat() * stack.getEndTime(), parallel);
+            }
+            double randomTime = (System.nanoTime() - startTime) / 1e6;
+
+            System.out.printf("Animation %s: %d channels x %d keys, playback %.0f channels/ms, random seek %.0f channels/ms%n",
+                    parallel ? "multithreaded" : "single threaded", channelCount, keyCount,
+                    (double) channelCount * frames / playbackTime, (double) channelCount * frames / randomTime);
+            sampler.destroy();
+        }
+        stack.destroy();
+    }
+
+    @Test
+    public void compressionTest() throws Exception {
+        NativeLoader.load("libvulkan");
+
+        int channelCount = 30_000;
+        int keyCount = 300;
+        float frameRate = 30.0f;
+        float tolerance = 0.01f;
+        float endTime = keyCount / frameRate;
+
+        // Baked clips store one key per frame of smooth motion, most of which reduction removes
+        AnimationStack reference = new AnimationStack("reference", 0.0f, endTime);
+        AnimationStack compressed = new AnimationStack("compressed", 0.0f, endTime);
+        compressed.setTolerance(tolerance);
+        Random random = new Random(1);
+        float[] times = new float[keyCount];
+        float[] values = new float[keyCount];
+        for (int key = 0; key < keyCount; key++) {
+            times[key] = key / frameRate;
+        }
+        for (int channel = 0; channel < channelCount; channel++) {
+            float amplitude = random.nextFloat() * 90.0f;
+            float frequency = 0.2f + random.nextFloat();
+            float phase = random.nextFloat() * 6.0f;
+            for (int key = 0; key < keyCount; key++) {
+                switch (channel % 3) {
+                    case 0 -> values[key] = phase;
+                    case 1 -> values[key] = phase + times[key] * 2.0f;
+                    default -> values[key] = amplitude * (float) Math.sin(frequency * times[key] + phase);
+                }
+            }
+            reference.addChannel(channel / 9, channel % 9, times, values);
+            compressed.addChannel(channel / 9, channel % 9, times, values);
+        }
+        compressed.quantize();
+
+        AnimationSampler referenceSampler = new AnimationSampler(reference);
+        AnimationSampler compressedSampler = new AnimationSampler(compressed);
+        float[] referenceValues = new float[channelCount];
+        float[] compressedValues = new float[channelCount];
+        float maxError = 0.0f;
+        for (float time = 0.0f; time <= endTime; time += 0.0073f) {
+            referenceSampler.sample(time);
+            compressedSampler.sample(time);
+            referenceSampler.getValues(referenceValues);
+            compressedSampler.getValues(compressedValues);
+            for (int channel = 0; channel < channelCount; channel++) {
+                maxError = Math.max(maxError, Math.abs(referenceValues[channel] - compressedValues[channel]));
+            }
+        }
+
+        int frames = 600;
+        double[] throughput = new double[2];
+        AnimationSampler[] samplers = { referenceSampler, compressedSampler };
+        for (int i = 0; i < samplers.length; i++) {
+            long startTime = System.nanoTime();
+            for (int frame = 0; frame < frames; frame++) {
+                samplers[i].sample(frame / 60.0f);
+            }
+            throughput[i] = (double) channelCount * frames / ((System.nanoTime() - startTime) / 1e6);
+        }
+
+        System.out.printf("Animation compression: %d -> %d keys, %d -> %d bytes (%.1fx), max error %.4f, %.0f -> %.0f channels/ms%n",
+                reference.getKeyCount(), compressed.getKeyCount(), reference.getMemorySize(), compressed.getMemorySize(),
+                (double) reference.getMemorySize() / compressed.getMemorySize(), maxError, throughput[0], throughput[1]);
+        // Quantized times and values deviate by up to half a step on top of the reduction tolerance
+        assertTrue(maxError < tolerance * 3.0f);
+        assertTrue(compressed.getMemorySize() * 4 < reference.getMemorySize());
+
+        File cache = File.createTempFile("jfbx", ".anim");
+        compressed.save(cache.getPath());
+        AnimationStack loaded = AnimationStack.open(cache.getPath());
+        AnimationSampler loadedSampler = new AnimationSampler(loaded);
+        compressedSampler.sample(1.0f);
+        loadedSampler.sample(1.0f);
+        compressedSampler.getValues(compressedValues);
+        loadedSampler.getValues(referenceValues);
+        assertTrue(loaded.isQuantized());
+        assertEquals(compressed.getKeyCount(), loaded.getKeyCount());
+        assertEquals(compressedValues[channelCount - 1], referenceValues[channelCount - 1]);
+        cache.delete();
+
+        loadedSampler.destroy();
+        loaded.destroy();
+        compressedSampler.destroy();
+        referenceSampler.destroy();
+        compressed.destroy();
+        reference.destroy();
+    }
+
+    @Test
+    public void fbxAnimationTest() throws Exception {
+        String path = System.getProperty("jfbx.testFbx", "");
+        assumeTrue(new File(path).isFile(), "Set -Djfbx.testFbx to an FBX file to run this test");
+        NativeLoader.load("libvulkan");
+
+        FbxScene scene = FbxScene.open(path);
+        SceneGraph graph = scene.createSceneGraph();
+        for (int i = 0; i < scene.getAnimationStackCount(); i++) {
+            AnimationStack stack = scene.createAnimationStack(i);
+            AnimationSampler sampler = new AnimationSampler(stack);
+
+            int frames = 0;
+            long startTime = System.nanoTime();
+            for (float time = stack.getStartTime(); time <= stack.getEndTime(); time += 1.0f / 60.0f) {
+                sampler.sample(time);
+                sampler.apply(graph);
+                graph.update();
+                frames++;
+            }
+            System.out.printf("%s: %d channels, %d keys, %d frames in %.3f ms%n", scene.getAnimationStackName(i),
+                    stack.getChannelCount(), stack.getKeyCount(), frames, (System.nanoTime() - startTime) / 1e6);
+
+            sampler.destroy();
+            stack.destroy();
+        }
+        graph.destroy();
+        scene.destroy();
+    }
+}
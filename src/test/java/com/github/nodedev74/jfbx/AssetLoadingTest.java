@@ -0,0 +1,230 @@
+package com.github.nodedev74.jfbx;
+
+import static org.junit.jupiter.api.Assertions.assertEquals;
+import static org.junit.jupiter.api.Assertions.assertFalse;
+import static org.junit.jupiter.api.Assertions.assertNotNull;
+import static org.junit.jupiter.api.Assertions.assertNull;
+import static org.junit.jupiter.api.Assertions.assertTrue;
+
+import java.io.File;
+import java.io.FileOutputStream;
+import java.util.concurrent.atomic.AtomicInteger;
+
+import org.junit.jupiter.api.Test;
+
+import com.github.nodedev74.jfbx.fbx.FbxScene;
+import com.github.nodedev74.jfbx.scene.SceneGraph;
+import com.github.nodedev74.jfbx.vulkan.VkAssetLoader;
+import com.github.nodedev74.jfbx.vulkan.VkHandler;
+
+public class AssetLoadingTest {
+
+    private static final int GEOMETRY_COUNT = 256;
+    private static final int GRID = 48;
+    private static final int MODEL_COUNT = 4096;
+    private static final float SPACING = 3.0f;
+
+    @Test
+    public void assetStatesTest() throws Exception {
+        NativeLoader.load("libvulkan");
+
+        VkHandler handler = new VkHandler(64, 64, 2);
+        VkAssetLoader loader = new VkAssetLoader(handler);
+        int[] ended = new int[4];
+        VkAssetLoader.Listener listener = new VkAssetLoader.Listener() {
+            @Override
+            public void completed(int asset) {
+                ended[0]++;
+                assertEquals(1, handler.getAssetMeshes(asset).length);
+            }
+
+            @Override
+            public void cancelled(int asset) {
+                ended[1]++;
+            }
+
+            @Override
+            public void failed(int asset, String message) {
+                ended[2]++;
+                assertNotNull(message);
+            }
+
+            @Override
+            public void progress(int asset, float progress) {
+                assertTrue(progress >= 0.0f && progress <= 1.0f);
+            }
+        };
+
+        loader.loadMesh(TestScenes.CUBE_POSITIONS, TestScenes.CUBE_INDICES, 0, listener);
+        loader.loadMesh(TestScenes.CUBE_POSITIONS, new int[] { 0, 1, 99 }, 0, listener);
+        int cancelled = loader.loadMesh(TestScenes.CUBE_POSITIONS, TestScenes.CUBE_INDICES, -1, listener);
+        boolean stopped = loader.cancel(cancelled);
+        while (loader.getPendingCount() > 0) {
+            handler.readback(handler.submitOffscreen());
+            loader.update();
+        }
+
+        // The cancellation may come too late if a worker already finished the mesh
+        assertEquals(stopped ? 1 : 2, ended[0]);
+        assertEquals(stopped ? 1 : 0, ended[1]);
+        assertEquals(1, ended[2]);
+        handler.destroy();
+    }
+
+    @Test
+    public void queriesBeforeLoadTest() throws Exception {
+        NativeLoader.load("libvulkan");
+
+        // Queries must not start the loader workers, they answer as for an unknown handle
+        VkHandler handler = new VkHandler(64, 64, 2);
+        assertEquals(VkAssetLoader.FAILED, handler.getAssetState(7));
+        assertEquals(0.0f, handler.getAssetProgress(7));
+        assertFalse(handler.cancelAsset(7));
+        assertNull(handler.getAssetError(7));
+        assertEquals(0, handler.getAssetMeshes(7).length);
+        handler.releaseAsset(7);
+        handler.destroy();
+    }
+
+    @Test
+    public void timeToFirstFrameBenchmark() throws Exception {
+        NativeLoader.load("libvulkan");
+
+        File file = writeLargeScene();
+        System.setProperty("jfbx.matrixCapacity", Integer.toString(MODEL_COUNT));
+
+        // Synchronous: the first frame waits for the import and every upload
+        long start = System.nanoTime();
+        VkHandler handler = new VkHandler(256, 256, 2);
+        FbxScene scene = FbxScene.open(file.getPath());
+        int[] meshes = new int[scene.getMeshCount()];
+        for (int i = 0; i < meshes.length; i++) {
+            meshes[i] = handler.addMesh(scene.getMeshPositions(i), scene.getMeshIndices(i));
+        }
+        SceneGraph graph = addObjects(handler, scene, meshes);
+        handler.readback(handler.submitOffscreen());
+        double syncTime = (System.nanoTime() - start) / 1e6;
+        handler.destroy();
+        graph.destroy();
+        scene.destroy();
+
+        // Asynchronous: frames are rendered while the scene loads and uploads
+        start = System.nanoTime();
+        VkHandler asyncHandler = new VkHandler(256, 256, 2);
+        VkAssetLoader loader = new VkAssetLoader(asyncHandler);
+        SceneGraph[] asyncGraph = new SceneGraph[1];
+        AtomicInteger progressCalls = new AtomicInteger();
+        loader.loadScene(file.getPath(), 0, false, new VkAssetLoader.Listener() {
+            @Override
+            public void completed(int asset) {
+                FbxScene loaded = asyncHandler.takeAssetScene(asset);
+                asyncGraph[0] = addObjects(asyncHandler, loaded, asyncHandler.getAssetMeshes(asset));
+                loaded.destroy();
+            }
+
+            @Override
+            public void progress(int asset, float progress) {
+                progressCalls.incrementAndGet();
+            }
+        });
+        double firstFrameTime = 0.0;
+        int frames = 0;
+        while (loader.getPendingCount() > 0) {
+            asyncHandler.readback(asyncHandler.submitOffscreen());
+            if (frames++ == 0) {
+                firstFrameTime = (System.nanoTime() - start) / 1e6;
+            }
+            loader.update();
+        }
+        asyncHandler.readback(asyncHandler.submitOffscreen());
+        double fullSceneTime = (System.nanoTime() - start) / 1e6;
+        System.clearProperty("jfbx.matrixCapacity");
+
+        assertNotNull(asyncGraph[0]);
+        assertTrue(progressCalls.get() > 0);
+        assertTrue(firstFrameTime < fullSceneTime);
+        System.out.printf("Synchronous load of %d meshes and %d models: first frame after %.1f ms%n",
+                GEOMETRY_COUNT, MODEL_COUNT, syncTime);
+        System.out.printf("Asynchronous load: first frame after %.1f ms, full scene after %.1f ms and %d frames%n",
+                firstFrameTime, fullSceneTime, frames);
+
+        asyncHandler.destroy();
+        asyncGraph[0].destroy();
+        file.delete();
+    }
+
+    private static SceneGraph addObjects(VkHandler handler, FbxScene scene, int[] meshes) {
+        SceneGraph graph = scene.createSceneGraph();
+        graph.update();
+        handler.setSceneGraph(graph);
+        for (int i = 0; i < scene.getInstanceGroupCount(); i++) {
+            int mesh = meshes[scene.getInstanceGroupMesh(i)];
+            for (int model : scene.getInstanceGroupModels(i)) {
+                handler.addObject(mesh, model);
+            }
+        }
+        int size = (int) Math.ceil(Math.sqrt(MODEL_COUNT));
+        handler.setViewProjection(TestScenes.topDown(size * SPACING));
+        return graph;
+    }
+
+    /**
+     * Writes a binary FBX file with many distinct grid geometries, each drawn by
+     * MODEL_COUNT / GEOMETRY_COUNT models placed on a grid.
+     */
+    private static File writeLargeScene() throws Exception {
+        double[] vertices = new double[GRID * GRID * 3];
+        for (int i = 0; i < GRID * GRID; i++) {
+            vertices[i * 3] = (i % GRID) * 2.0 / (GRID - 1) - 1.0;
+            vertices[i * 3 + 2] = (i / GRID) * 2.0 / (GRID - 1) - 1.0;
+        }
+        int[] polygons = new int[(GRID - 1) * (GRID - 1) * 4];
+        for (int y = 0, p = 0; y < GRID - 1; y++) {
+            for (int x = 0; x < GRID - 1; x++) {
+                int corner = y * GRID + x;
+                polygons[p++] = corner;
+                polygons[p++] = corner + GRID;
+                polygons[p++] = corner + GRID + 1;
+                polygons[p++] = ~(corner + 1);
+            }
+        }
+
+        FbxTestWriter writer = new FbxTestWriter();
+        int size = (int) Math.ceil(Math.sqrt(MODEL_COUNT));
+        long geometryId = 1_000_000L;
+        long modelId = 3_000_000L;
+        long objects = writer.begin("Objects");
+        for (int i = 0; i < GEOMETRY_COUNT; i++) {
+            double[] shaped = vertices.clone();
+            for (int v = 1; v < shaped.length; v += 3) {
+                shaped[v] = Math.sin(shaped[v - 1] * (i + 1)) * Math.cos(shaped[v + 1] * (i % 7 + 1)) * 0.5;
+            }
+            long geometry = writer.begin("Geometry", geometryId + i, "\0\1Geometry", "Mesh");
+            writer.end(writer.begin("Vertices", shaped));
+            writer.end(writer.begin("PolygonVertexIndex", polygons));
+            writer.end(geometry);
+        }
+        for (int i = 0; i < MODEL_COUNT; i++) {
+            long model = writer.begin("Model", modelId + i, "Model" + i + "\0\1Model", "Mesh");
+            long properties = writer.begin("Properties70");
+            writer.end(writer.begin("P", "Lcl Translation", "Lcl Translation", "", "A",
+                    (i % size - size / 2) * (double) SPACING, 0.0, (i / size - size / 2) * (double) SPACING));
+            writer.end(properties);
+            writer.end(model);
+        }
+        writer.end(objects);
+
+        long connections = writer.begin("Connections");
+        for (int i = 0; i < MODEL_COUNT; i++) {
+            writer.end(writer.begin("C", "OO", geometryId + i % GEOMETRY_COUNT, modelId + i));
+        }
+        writer.end(connections);
+
+        File file = File.createTempFile("assets", ".fbx");
+        file.deleteOnExit();
+        try (FileOutputStream out = new FileOutputStream(file)) {
+            out.write(writer.toByteArray());
+        }
+        return file;
+    }
+}
@@ -0,0 +1,113 @@
+package com.github.nodedev74.jfbx;
+
+import static org.junit.jupiter.api.Assertions.assertEquals;
+import static org.junit.jupiter.api.Assertions.assertTrue;
+
+import java.nio.ByteBuffer;
+import java.util.Arrays;
+
+import org.junit.jupiter.api.Test;
+
+import com.github.nodedev74.jfbx.scene.SceneGraph;
+import com.github.nodedev74.jfbx.vulkan.VkHandler;
+
+public class BindlessTest {
+
+    private static final int OBJECT_COUNT = 10_000;
+    private static final int MATERIAL_COUNT = 1_000;
+    private static final int TEXTURE_SIZE = 4;
+    private static final int FRAMES = 30;
+    private static final float SPACING = 3.0f;
+
+    @Test
+    public void materialBindingBenchmark() throws Exception {
+        NativeLoader.load("libvulkan");
+
+        int size = (int) Math.ceil(Math.sqrt(OBJECT_COUNT));
+        int[] parents = new int[OBJECT_COUNT];
+        Arrays.fill(parents, -1);
+        SceneGraph graph = new SceneGraph(parents);
+        for (int i = 0; i < OBJECT_COUNT; i++) {
+            graph.setTranslation(i, (i % size - size / 2) * SPACING, 0.0f, (i / size - size / 2) * SPACING);
+        }
+
+        System.setProperty("jfbx.matrixCapacity", Integer.toString(OBJECT_COUNT));
+        VkHandler handler = new VkHandler(256, 256, 2);
+        System.clearProperty("jfbx.matrixCapacity");
+        handler.setSceneGraph(graph);
+        int mesh = handler.addMesh(TestScenes.CUBE_POSITIONS, TestScenes.CUBE_INDICES);
+
+        long writesBefore = handler.getDescriptorWriteCount();
+        long start = System.nanoTime();
+        int[] materials = new int[MATERIAL_COUNT];
+        for (int i = 0; i < MATERIAL_COUNT; i++) {
+            int texture = handler.addTexture(TEXTURE_SIZE, TEXTURE_SIZE, checkerboard(i));
+            float shade = 0.5f + 0.5f * i / MATERIAL_COUNT;
+            materials[i] = handler.addMaterial(new float[] { shade, 1.0f, 1.0f - shade, 1.0f }, texture);
+        }
+        double addTime = (System.nanoTime() - start) / 1e6;
+        long materialWrites = handler.getDescriptorWriteCount() - writesBefore;
+
+        for (int i = 0; i < OBJECT_COUNT; i++) {
+            handler.addObject(mesh, i, materials[i % MATERIAL_COUNT]);
+        }
+        handler.setFrustumCulling(false);
+        handler.setOcclusionCulling(false);
+        handler.setViewProjection(TestScenes.topDown(size * SPACING));
+
+        // Index 0 binds a set per material, index 1 indexes the bindless set
+        int modes = handler.isBindlessSupported() ? 2 : 1;
+        double[] recordTimes = new double[2];
+        double[] renderPassTimes = new double[2];
+        int[] binds = new int[2];
+        long[] setupWrites = new long[2];
+        byte[][] images = new byte[2][];
+        for (int bindless = 0; bindless < modes; bindless++) {
+            long writes = handler.getDescriptorWriteCount();
+            handler.setBindless(bindless == 1);
+            setupWrites[bindless] = handler.getDescriptorWriteCount() - writes;
+            ByteBuffer image = null;
+            for (int i = 0; i < FRAMES; i++) {
+                image = handler.readback(handler.submitOffscreen());
+                recordTimes[bindless] += handler.getRecordTime() / FRAMES;
+            }
+            renderPassTimes[bindless] = handler.getGpuTimings().getScopeTime("render pass");
+            binds[bindless] = handler.getDescriptorBindCount();
+            images[bindless] = new byte[image.remaining()];
+            image.get(images[bindless]);
+        }
+
+        // The matrix and draw data sets plus one set per material
+        assertEquals(MATERIAL_COUNT + 1, binds[0]);
+        System.out.printf("Adding %d textures and materials: %.3f ms, %d descriptor writes, %d more for per material sets%n",
+                MATERIAL_COUNT, addTime, materialWrites, setupWrites[0]);
+        System.out.printf("Per material sets: %d binds, %.3f ms CPU and %.3f ms GPU%n", binds[0], recordTimes[0], renderPassTimes[0]);
+        if (modes == 2) {
+            assertEquals(1, binds[1]);
+            // The objects do not overlap, so the material order does not change the image
+            assertTrue(Arrays.equals(images[0], images[1]));
+            System.out.printf("Bindless: %d binds, %.3f ms CPU and %.3f ms GPU%n", binds[1], recordTimes[1], renderPassTimes[1]);
+        }
+
+        handler.destroy();
+        graph.destroy();
+    }
+
+    /**
+     * Builds an RGBA8 checkerboard whose dark squares differ per texture.
+     */
+    private static byte[] checkerboard(int seed) {
+        byte[] pixels = new byte[TEXTURE_SIZE * TEXTURE_SIZE * 4];
+        for (int y = 0; y < TEXTURE_SIZE; y++) {
+            for (int x = 0; x < TEXTURE_SIZE; x++) {
+                int offset = (y * TEXTURE_SIZE + x) * 4;
+                boolean light = ((x + y) & 1) == 0;
+                pixels[offset] = (byte) (light ? 255 : seed * 37);
+                pixels[offset + 1] = (byte) (light ? 255 : seed * 11);
+                pixels[offset + 2] = (byte) (light ? 255 : seed * 5);
+                pixels[offset + 3] = (byte) 255;
+            }
+        }
+        return pixels;
+    }
+}
@@ -0,0 +1,123 @@
+package com.github.nodedev74.jfbx;
+
+import static org.junit.jupiter.api.Assertions.assertEquals;
+import static org.junit.jupiter.api.Assertions.assertTrue;
+
+import java.util.Random;
+
+import org.junit.jupiter.api.Test;
+
+import com.github.nodedev74.jfbx.anim.BlendShapes;
+
+public class BlendShapeTest {
+
+    private static final int VERTICES = 20_000;
+    private static final int SHAPES = 64;
+    private static final int ACTIVE_SHAPES = 12;
+    private static final int ITERATIONS = 200;
+
+    @Test
+    public void sparseStorageTest() throws Exception {
+        NativeLoader.load("libvulkan");
+
+        BlendShapes blendShapes = new BlendShapes(new float[] { 0, 0, 0, 1, 0, 0, 2, 0, 0 });
+        int smile = blendShapes.addShape("smile", new int[] { 2, 0, 2 }, new float[] { 0, 1, 0, 1, 0, 0, 0, 1, 0 });
+        int blink = blendShapes.addDenseShape("blink", new float[] { 0, 0, 0, 0, 0, 1, 0, 0, 0 });
+        assertEquals(2, blendShapes.getShapeCount());
+        assertEquals("blink", blendShapes.getShapeName(blink));
+        assertEquals(3, blendShapes.getDeltaCount());
+
+        blendShapes.setWeight(smile, 0.5f);
+        blendShapes.setWeight(blink, 1.0f);
+        float[] positions = new float[12];
+        blendShapes.evaluate(positions, false);
+        float[] expected = { 0.5f, 0, 0, 1, 1, 0, 1, 1, 2, 1, 0, 1 };
+        for (int i = 0; i < expected.length; i++) {
+            assertEquals(expected[i], positions[i], 1e-6f);
+        }
+
+        blendShapes.destroy();
+    }
+
+    @Test
+    public void faceRigBenchmark() throws Exception {
+        NativeLoader.load("libvulkan");
+
+        // A face rig: shapes move local regions of a grid, each a few percent of the vertices
+        Random random = new Random(1);
+        int side = (int) Math.sqrt(VERTICES);
+        float[] base = new float[VERTICES * 3];
+        for (int i = 0; i < VERTICES; i++) {
+            base[i * 3] = (float) (i % side) / side;
+            base[i * 3 + 1] = (float) (i / side) / side;
+        }
+        float[][] dense = new float[SHAPES][VERTICES * 3];
+        BlendShapes blendShapes = new BlendShapes(base);
+        for (int shape = 0; shape < SHAPES; shape++) {
+            float centerX = random.nextFloat();
+            float centerY = random.nextFloat();
+            float radius = 0.05f + random.nextFloat() * 0.1f;
+            for (int i = 0; i < VERTICES; i++) {
+                float dx = base[i * 3] - centerX;
+                float dy = base[i * 3 + 1] - centerY;
+                float falloff = 1.0f - (float) Math.sqrt(dx * dx + dy * dy) / radius;
+                if (falloff > 0.0f) {
+                    dense[shape][i * 3 + 2] = falloff * 0.1f;
+                    dense[shape][i * 3] = dx * falloff * 0.05f;
+                }
+            }
+            blendShapes.addDenseShape("shape" + shape, dense[shape]);
+        }
+
+        float[] weights = new float[SHAPES];
+        for (int i = 0; i < ACTIVE_SHAPES; i++) {
+            int shape = random.nextInt(SHAPES);
+            weights[shape] = random.nextFloat();
+            blendShapes.setWeight(shape, weights[shape]);
+        }
+
+        float[] expected = new float[VERTICES * 4];
+        float[] actual = new float[VERTICES * 4];
+        long startTime = System.nanoTime();
+        for (int iteration = 0; iteration < ITERATIONS; iteration++) {
+            evaluateDense(base, dense, weights, expected);
+        }
+        long denseTime = System.nanoTime() - startTime;
+        startTime = System.nanoTime();
+        for (int iteration = 0; iteration < ITERATIONS; iteration++) {
+            blendShapes.evaluate(actual, false);
+        }
+        long sparseTime = System.nanoTime() - startTime;
+
+        for (int i = 0; i < expected.length; i++) {
+            assertEquals(expected[i], actual[i], 1e-5f);
+        }
+
+        long denseSize = (long) (SHAPES + 1) * VERTICES * 3 * Float.BYTES;
+        long sparseSize = blendShapes.getMemorySize();
+        assertTrue(sparseSize < denseSize / 4);
+        System.out.printf("BlendShapes %d vertices, %d shapes (%d active), %d deltas: dense %.2f MB %.3f ms, sparse %.2f MB %.3f ms%n",
+                VERTICES, SHAPES, ACTIVE_SHAPES, blendShapes.getDeltaCount(), denseSize / 1e6,
+                denseTime / 1e6 / ITERATIONS, sparseSize / 1e6, sparseTime / 1e6 / ITERATIONS);
+
+        blendShapes.destroy();
+    }
+
+    private static void evaluateDense(float[] base, float[][] dense, float[] weights, float[] out) {
+        for (int i = 0; i < VERTICES; i++) {
+            out[i * 4] = base[i * 3];
+            out[i * 4 + 1] = base[i * 3 + 1];
+            out[i * 4 + 2] = base[i * 3 + 2];
+            out[i * 4 + 3] = 1.0f;
+        }
+        for (int shape = 0; shape < dense.length; shape++) {
+            float weight = weights[shape];
+            float[] deltas = dense[shape];
+            for (int i = 0; i < VERTICES; i++) {
+                out[i * 4] += deltas[i * 3] * weight;
+                out[i * 4 + 1] += deltas[i * 3 + 1] * weight;
+                out[i * 4 + 2] += deltas[i * 3 + 2] * weight;
+            }
+        }
+    }
+}
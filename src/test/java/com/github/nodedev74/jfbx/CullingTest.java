@@ -0,0 +1,257 @@
+package com.github.nodedev74.jfbx;
+
+import static org.junit.jupiter.api.Assertions.assertEquals;
+import static org.junit.jupiter.api.Assertions.assertTrue;
+
+import java.util.Arrays;
+import java.util.Random;
+
+import org.junit.jupiter.api.Test;
+
+import com.github.nodedev74.jfbx.scene.FrustumCuller;
+import com.github.nodedev74.jfbx.scene.SceneGraph;
+import com.github.nodedev74.jfbx.vulkan.VkHandler;
+
+public class CullingTest {
+
+    private static final int CITY_SIZE = 320;
+    private static final int GPU_CITY_SIZE = 64;
+    private static final float BLOCK = 4.0f;
+    private static final int RUNS = 20;
+    private static final int FRAMES = 60;
+
+    @Test
+    public void referenceTest() throws Exception {
+        NativeLoader.load("libvulkan");
+
+        Random random = new Random(1);
+        int count = 4096;
+        SceneGraph graph = new SceneGraph(roots(count));
+        FrustumCuller culler = new FrustumCuller();
+        float[][] corners = new float[count][];
+        for (int i = 0; i < count; i++) {
+            float x = random.nextFloat() * 200.0f - 100.0f;
+            float y = random.nextFloat() * 40.0f - 20.0f;
+            float z = random.nextFloat() * 200.0f - 100.0f;
+            graph.setTranslation(i, x, y, z);
+            assertEquals(i, culler.add(i, TestScenes.CUBE_POSITIONS));
+            corners[i] = translate(TestScenes.CUBE_POSITIONS, x, y, z);
+        }
+        graph.update();
+        culler.update(graph, false);
+
+        float[] viewProjection = TestScenes.viewProjection(60.0f, 1.5f, 0.1f, 80.0f, 0.0f, 0.0f, 10.0f);
+        int[] visible = new int[count];
+        int visibleCount = culler.cull(viewProjection, visible, false);
+
+        int expectedCount = 0;
+        int next = 0;
+        for (int i = 0; i < count; i++) {
+            if (isInside(viewProjection, corners[i])) {
+                assertEquals(i, visible[next++]);
+                expectedCount++;
+            }
+        }
+        assertEquals(expectedCount, visibleCount);
+        assertTrue(visibleCount > 0 && visibleCount < count);
+
+        int[] parallelVisible = new int[count];
+        culler.update(graph, true);
+        assertEquals(visibleCount, culler.cull(viewProjection, parallelVisible, true));
+        for (int i = 0; i < visibleCount; i++) {
+            assertEquals(visible[i], parallelVisible[i]);
+        }
+        assertEquals(-1, culler.cull(viewProjection, new int[count - 1], false));
+
+        culler.destroy();
+        graph.destroy();
+    }
+
+    @Test
+    public void cityBenchmark() throws Exception {
+        NativeLoader.load("libvulkan");
+
+        int count = CITY_SIZE * CITY_SIZE;
+        SceneGraph graph = createCity(CITY_SIZE);
+        FrustumCuller culler = new FrustumCuller();
+        for (int i = 0; i < count; i++) {
+            culler.add(i, TestScenes.CUBE_POSITIONS);
+        }
+        graph.update();
+
+        float[] viewProjection = TestScenes.viewProjection(60.0f, 16.0f / 9.0f, 0.1f, 400.0f, 0.0f, 10.0f, 0.0f);
+        int[] visible = new int[count];
+        culler.update(graph, false);
+        int visibleCount = culler.cull(viewProjection, visible, false);
+
+        long startTime = System.nanoTime();
+        for (int i = 0; i < RUNS; i++) {
+            culler.cull(viewProjection, visible, false);
+        }
+        long serialTime = (System.nanoTime() - startTime) / RUNS;
+        startTime = System.nanoTime();
+        for (int i = 0; i < RUNS; i++) {
+            culler.cull(viewProjection, visible, true);
+        }
+        long parallelTime = (System.nanoTime() - startTime) / RUNS;
+        startTime = System.nanoTime();
+        for (int i = 0; i < RUNS; i++) {
+            culler.update(graph, true);
+        }
+        long updateTime = (System.nanoTime() - startTime) / RUNS;
+
+        System.out.printf("Culling %d objects: %d visible (%.1f%%), serial %.3f ms (%.0f objects/ms), parallel %.3f ms (%.0f objects/ms), bounds update %.3f ms%n",
+                count, visibleCount, visibleCount * 100.0 / count, serialTime / 1e6, count / (serialTime / 1e6),
+                parallelTime / 1e6, count / (parallelTime / 1e6), updateTime / 1e6);
+
+        culler.destroy();
+        graph.destroy();
+    }
+
+    @Test
+    public void drawCountBenchmark() throws Exception {
+        NativeLoader.load("libvulkan");
+
+        int count = GPU_CITY_SIZE * GPU_CITY_SIZE;
+        SceneGraph graph = createCity(GPU_CITY_SIZE);
+        VkHandler handler = new VkHandler(256, 256, 2);
+        handler.setSceneGraph(graph);
+        int mesh = handler.addMesh(TestScenes.CUBE_POSITIONS, TestScenes.CUBE_INDICES);
+        for (int i = 0; i < count; i++) {
+            handler.addObject(mesh, i);
+        }
+        handler.setViewProjection(TestScenes.viewProjection(60.0f, 1.0f, 0.1f, 100.0f, 0.0f, 10.0f, 0.0f));
+
+        int[] drawCounts = new int[2];
+        double[] renderPassTimes = new double[2];
+        for (int culling = 0; culling < 2; culling++) {
+            handler.setFrustumCulling(culling == 1);
+            for (int i = 0; i < FRAMES; i++) {
+                handler.readback(handler.submitOffscreen());
+            }
+            drawCounts[culling] = handler.getDrawCount();
+            renderPassTimes[culling] = handler.getGpuTimings().getScopeTime("render pass");
+        }
+        assertEquals(count, drawCounts[0]);
+        assertTrue(drawCounts[1] < drawCounts[0]);
+
+        System.out.printf("Drawing %d objects: without culling %d draws in %.3f ms, with culling %d draws in %.3f ms%n",
+                count, drawCounts[0], renderPassTimes[0], drawCounts[1], renderPassTimes[1]);
+
+        handler.destroy();
+        graph.destroy();
+    }
+
+    @Test
+    public void occlusionBenchmark() throws Exception {
+        NativeLoader.load("libvulkan");
+
+        // A wall in front of the camera hides a grid of cubes behind it
+        int count = 1 + GPU_CITY_SIZE * GPU_CITY_SIZE;
+        SceneGraph graph = new SceneGraph(roots(count));
+        graph.setTranslation(0, 0.0f, 0.0f, 10.0f);
+        graph.setScaling(0, 40.0f, 10.0f, 0.5f);
+        for (int i = 1; i < count; i++) {
+            float x = ((i - 1) % GPU_CITY_SIZE - GPU_CITY_SIZE / 2) * BLOCK;
+            float z = -((i - 1) / GPU_CITY_SIZE) * BLOCK;
+            graph.setTranslation(i, x, 0.0f, z);
+        }
+
+        System.setProperty("jfbx.pipelineStatistics", "true");
+        VkHandler handler = new VkHandler(256, 256, 2);
+        System.clearProperty("jfbx.pipelineStatistics");
+        handler.setSceneGraph(graph);
+        int mesh = handler.addMesh(TestScenes.CUBE_POSITIONS, TestScenes.CUBE_INDICES);
+        for (int i = 0; i < count; i++) {
+            handler.addObject(mesh, i);
+        }
+        handler.setViewProjection(TestScenes.viewProjection(60.0f, 1.0f, 0.1f, 300.0f, 0.0f, 2.0f, 20.0f));
+
+        int[] occludedCounts = new int[2];
+        long[] vertexInvocations = new long[2];
+        long[] fragmentInvocations = new long[2];
+        double[] renderPassTimes = new double[2];
+        for (int occlusion = 0; occlusion < 2; occlusion++) {
+            handler.setOcclusionCulling(occlusion == 1);
+            for (int i = 0; i < FRAMES; i++) {
+                handler.readback(handler.submitOffscreen());
+            }
+            occludedCounts[occlusion] = handler.getOccludedCount();
+            long[] statistics = handler.getGpuTimings().getPipelineStatistics();
+            vertexInvocations[occlusion] = statistics.length > 3 ? statistics[1] : -1;
+            fragmentInvocations[occlusion] = statistics.length > 3 ? statistics[3] : -1;
+            renderPassTimes[occlusion] = handler.getGpuTimings().getScopeTime("render pass");
+        }
+        assertEquals(0, occludedCounts[0]);
+        assertTrue(occludedCounts[1] > 0 && occludedCounts[1] < handler.getDrawCount());
+        // Hidden cubes mostly fail the early depth test anyway, so their vertices are the reliable saving
+        if (vertexInvocations[0] >= 0) {
+            assertTrue(vertexInvocations[1] < vertexInvocations[0]);
+            assertTrue(fragmentInvocations[1] <= fragmentInvocations[0]);
+        }
+
+        System.out.printf("Occlusion of %d visible objects: %d occluded, vertex invocations %d without and %d with, fragment invocations %d without and %d with, render pass %.3f ms without and %.3f ms with%n",
+                handler.getDrawCount(), occludedCounts[1], vertexInvocations[0], vertexInvocations[1],
+                fragmentInvocations[0], fragmentInvocations[1], renderPassTimes[0], renderPassTimes[1]);
+
+        handler.destroy();
+        graph.destroy();
+    }
+
+    private static SceneGraph createCity(int size) {
+        SceneGraph graph = new SceneGraph(roots(size * size));
+        Random random = new Random(1);
+        for (int i = 0; i < size * size; i++) {
+            float x = (i % size - size / 2) * BLOCK;
+            float z = (i / size - size / 2) * BLOCK;
+            graph.setTranslation(i, x, 0.0f, z);
+            graph.setRotation(i, 0.0f, random.nextFloat() * 90.0f, 0.0f);
+            graph.setScaling(i, 1.0f, 1.0f + random.nextFloat() * 8.0f, 1.0f);
+        }
+        return graph;
+    }
+
+    private static int[] roots(int count) {
+        int[] parents = new int[count];
+        Arrays.fill(parents, -1);
+        return parents;
+    }
+
+    private static float[] translate(float[] positions, float x, float y, float z) {
+        float[] out = new float[positions.length];
+        for (int i = 0; i < positions.length; i += 3) {
+            out[i] = positions[i] + x;
+            out[i + 1] = positions[i + 1] + y;
+            out[i + 2] = positions[i + 2] + z;
+        }
+        return out;
+    }
+
+    /**
+     * Reference test: a box is culled only if all of its corners lie outside the
+     * same clip plane.
+     */
+    private static boolean isInside(float[] m, float[] corners) {
+        int[] outside = new int[6];
+        int cornerCount = corners.length / 3;
+        for (int i = 0; i < corners.length; i += 3) {
+            float x = corners[i], y = corners[i + 1], z = corners[i + 2];
+            float cx = m[0] * x + m[4] * y + m[8] * z + m[12];
+            float cy = m[1] * x + m[5] * y + m[9] * z + m[13];
+            float cz = m[2] * x + m[6] * y + m[10] * z + m[14];
+            float cw = m[3] * x + m[7] * y + m[11] * z + m[15];
+            outside[0] += cx < -cw ? 1 : 0;
+            outside[1] += cx > cw ? 1 : 0;
+            outside[2] += cy < -cw ? 1 : 0;
+            outside[3] += cy > cw ? 1 : 0;
+            outside[4] += cz < 0.0f ? 1 : 0;
+            outside[5] += cz > cw ? 1 : 0;
+        }
+        for (int count : outside) {
+            if (count == cornerCount) {
+                return false;
+            }
+        }
+        return true;
+    }
+}
@@ -0,0 +1,64 @@
+package com.github.nodedev74.jfbx;
+
+import static org.junit.jupiter.api.Assertions.assertTrue;
+
+import java.nio.ByteBuffer;
+import java.util.Arrays;
+
+import org.junit.jupiter.api.Test;
+
+import com.github.nodedev74.jfbx.scene.SceneGraph;
+import com.github.nodedev74.jfbx.vulkan.VkHandler;
+
+public class DynamicRenderingTest {
+
+    private static final int COUNT = 1_000;
+    private static final int RECREATIONS = 20;
+    private static final float SPACING = 3.0f;
+
+    @Test
+    public void recreationBenchmark() throws Exception {
+        NativeLoader.load("libvulkan");
+
+        int size = (int) Math.ceil(Math.sqrt(COUNT));
+        int[] parents = new int[COUNT];
+        Arrays.fill(parents, -1);
+        SceneGraph graph = new SceneGraph(parents);
+        for (int i = 0; i < COUNT; i++) {
+            graph.setTranslation(i, (i % size - size / 2) * SPACING, 0.0f, (i / size - size / 2) * SPACING);
+        }
+
+        byte[][] images = new byte[2][];
+        for (int dynamicRendering = 1; dynamicRendering >= 0; dynamicRendering--) {
+            System.setProperty("jfbx.dynamicRendering", Boolean.toString(dynamicRendering == 1));
+            VkHandler handler = new VkHandler(256, 256, 3);
+            System.clearProperty("jfbx.dynamicRendering");
+            handler.setSceneGraph(graph);
+            int mesh = handler.addMesh(TestScenes.CUBE_POSITIONS, TestScenes.CUBE_INDICES);
+            for (int i = 0; i < COUNT; i++) {
+                handler.addObject(mesh, i);
+            }
+            handler.setViewProjection(TestScenes.topDown(size * SPACING));
+
+            double recreateTime = 0.0;
+            for (int i = 0; i < RECREATIONS; i++) {
+                handler.recreateSwapchain();
+                recreateTime += handler.getSwapchainRecreateTime() / RECREATIONS;
+                handler.readback(handler.submitOffscreen());
+            }
+            ByteBuffer image = handler.readback(handler.submitOffscreen());
+            images[dynamicRendering] = new byte[image.remaining()];
+            image.get(images[dynamicRendering]);
+
+            System.out.printf("%s: %.3f ms per swapchain recreation, %d pipelines created%n",
+                    handler.isDynamicRenderingSupported() ? "Dynamic rendering" : "Render pass and framebuffers",
+                    recreateTime, handler.getPipelineCreateCount());
+
+            handler.destroy();
+        }
+        // Both paths clear, draw and store the same attachments
+        assertTrue(Arrays.equals(images[0], images[1]));
+
+        graph.destroy();
+    }
+}
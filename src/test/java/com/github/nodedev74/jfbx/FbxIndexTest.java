@@ -0,0 +1,157 @@
+package com.github.nodedev74.jfbx;
+
+import static org.junit.jupiter.api.Assertions.assertArrayEquals;
+import static org.junit.jupiter.api.Assertions.assertEquals;
+import static org.junit.jupiter.api.Assertions.assertThrows;
+import static org.junit.jupiter.api.Assertions.assertTrue;
+
+import java.io.File;
+
+import org.junit.jupiter.api.Test;
+
+import com.github.nodedev74.jfbx.exception.FbxRuntimeError;
+import com.github.nodedev74.jfbx.fbx.FbxIndex;
+import com.github.nodedev74.jfbx.fbx.FbxScene;
+
+public class FbxIndexTest {
+
+    private static final long FILE_SIZE = 1L << 30;
+    private static final int GRID = 64;
+    private static final int MATERIAL_COUNT = 64;
+
+    @Test
+    public void extractionBenchmark() throws Exception {
+        NativeLoader.load("libvulkan");
+
+        File file = File.createTempFile("library", ".fbx");
+        file.deleteOnExit();
+        int geometryCount = writeLibrary(file);
+        int target = geometryCount / 2;
+
+        // Index and extract a single mesh
+        long start = System.nanoTime();
+        FbxIndex index = FbxIndex.open(file.getPath());
+        double indexTime = (System.nanoTime() - start) / 1e6;
+        long indexBytes = index.getBytesRead();
+        assertEquals(geometryCount * 2 + MATERIAL_COUNT + 1, index.getObjectCount());
+
+        start = System.nanoTime();
+        int[] models = index.findObjects("Model", "Model" + target);
+        assertEquals(1, models.length);
+        int geometry = -1;
+        for (int child : index.getChildObjects(models[0])) {
+            if (index.getObjectClass(child).equals("Geometry")) {
+                geometry = child;
+            }
+        }
+        float[] positions = index.getMeshPositions(geometry);
+        int[] indices = index.getMeshIndices(geometry);
+        double extractTime = (System.nanoTime() - start) / 1e6;
+
+        int material = index.findObjects("Material", "Material3")[0];
+        assertArrayEquals(new double[] { 0.75, 0.5, 0.25 }, index.getObjectProperty(material, "DiffuseColor"));
+        int stack = index.findObjects("AnimationStack", null)[0];
+        assertEquals(46186158000.0, index.getObjectProperty(stack, "LocalStop")[0]);
+        assertEquals(3, index.getMaterializedCount());
+        long totalBytes = index.getBytesRead();
+
+        int count = index.getObjectCount();
+        assertThrows(FbxRuntimeError.class, () -> index.getObjectId(-1));
+        assertThrows(FbxRuntimeError.class, () -> index.getObjectClass(count));
+        assertThrows(FbxRuntimeError.class, () -> index.getChildObjects(count));
+        assertThrows(FbxRuntimeError.class, () -> index.getMeshPositions(-1));
+        index.destroy();
+
+        // Load everything and look the mesh up
+        start = System.nanoTime();
+        FbxScene scene = FbxScene.open(file.getPath());
+        int mesh = -1;
+        for (int i = 0; i < scene.getMeshCount() && mesh < 0; i++) {
+            if (scene.getModelName(scene.getMeshModel(i)).equals("Model" + target)) {
+                mesh = i;
+            }
+        }
+        float[] loadedPositions = scene.getMeshPositions(mesh);
+        int[] loadedIndices = scene.getMeshIndices(mesh);
+        double loadTime = (System.nanoTime() - start) / 1e6;
+        scene.destroy();
+
+        assertArrayEquals(loadedPositions, positions);
+        assertArrayEquals(loadedIndices, indices);
+        assertTrue(totalBytes < file.length() / 100);
+        System.out.printf("%.0f MiB file with %d geometries: index built in %.1f ms from %.1f KiB%n",
+                file.length() / 1048576.0, geometryCount, indexTime, indexBytes / 1024.0);
+        System.out.printf("One mesh extracted in %.2f ms, %.1f KiB read in total; full load and lookup %.1f ms (%.0fx)%n",
+                extractTime, totalBytes / 1024.0, loadTime, loadTime / (indexTime + extractTime));
+
+        file.delete();
+    }
+
+    /**
+     * Writes grid geometries, each with a model, until the file reaches
+     * FILE_SIZE, followed by materials, an animation stack and the connections.
+     * Every geometry is shifted by its number, so each mesh differs.
+     *
+     * @return The number of geometries.
+     */
+    private static int writeLibrary(File file) throws Exception {
+        double[] vertices = new double[GRID * GRID * 3];
+        for (int i = 0; i < GRID * GRID; i++) {
+            vertices[i * 3] = (i % GRID) * 2.0 / (GRID - 1) - 1.0;
+            vertices[i * 3 + 2] = (i / GRID) * 2.0 / (GRID - 1) - 1.0;
+        }
+        int[] polygons = new int[(GRID - 1) * (GRID - 1) * 4];
+        for (int y = 0, p = 0; y < GRID - 1; y++) {
+            for (int x = 0; x < GRID - 1; x++) {
+                int corner = y * GRID + x;
+                polygons[p++] = corner;
+                polygons[p++] = corner + GRID;
+                polygons[p++] = corner + GRID + 1;
+                polygons[p++] = ~(corner + 1);
+            }
+        }
+
+        long geometryId = 1_000_000L;
+        long modelId = 100_000_000L;
+        long materialId = 200_000_000L;
+        int geometryCount = 0;
+        try (FbxTestWriter writer = new FbxTestWriter(file)) {
+            long objects = writer.begin("Objects");
+            while (writer.position() < FILE_SIZE) {
+                for (int v = 1; v < vertices.length; v += 3) {
+                    vertices[v] = geometryCount;
+                }
+                long geometry = writer.begin("Geometry", geometryId + geometryCount, "\0\1Geometry", "Mesh");
+                writer.end(writer.begin("Vertices", vertices));
+                writer.end(writer.begin("PolygonVertexIndex", polygons));
+                writer.end(geometry);
+                long model = writer.begin("Model", modelId + geometryCount, "Model" + geometryCount + "\0\1Model", "Mesh");
+                writer.end(writer.begin("Properties70"));
+                writer.end(model);
+                geometryCount++;
+                writer.flush();
+            }
+            for (int i = 0; i < MATERIAL_COUNT; i++) {
+                long material = writer.begin("Material", materialId + i, "Material" + i + "\0\1Material", "");
+                long properties = writer.begin("Properties70");
+                writer.end(writer.begin("P", "DiffuseColor", "Color", "", "A", 0.75, 0.5, 0.25));
+                writer.end(properties);
+                writer.end(material);
+            }
+            long stack = writer.begin("AnimationStack", 300_000_000L, "Take\0\1AnimStack", "");
+            long properties = writer.begin("Properties70");
+            writer.end(writer.begin("P", "LocalStop", "KTime", "Time", "", 46186158000L));
+            writer.end(properties);
+            writer.end(stack);
+            writer.end(objects);
+
+            long connections = writer.begin("Connections");
+            for (int i = 0; i < geometryCount; i++) {
+                writer.end(writer.begin("C", "OO", geometryId + i, modelId + i));
+                writer.end(writer.begin("C", "OO", materialId + i % MATERIAL_COUNT, modelId + i));
+            }
+            writer.end(connections);
+        }
+        return geometryCount;
+    }
+}
@@ -0,0 +1,208 @@
+package com.github.nodedev74.jfbx;
+
+import java.io.File;
+import java.io.RandomAccessFile;
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
+import java.nio.channels.FileChannel;
+import java.nio.charset.StandardCharsets;
+import java.util.Arrays;
+import java.util.zip.Deflater;
+
+/**
+ * Writes FBX 7.4 node records for the tests. Nested lists end at the end offset
+ * of their parent, so no null records are written.
+ *
+ * A writer created without a file keeps all records in memory until
+ * toByteArray(). A writer created for a file buffers records until flush();
+ * end offsets of records already written are patched in the file.
+ */
+public final class FbxTestWriter implements AutoCloseable {
+
+    private final FileChannel channel;
+    private ByteBuffer buffer;
+    private long flushed;
+    private boolean deflate;
+
+    /**
+     * Creates a writer that keeps the records in memory.
+     */
+    public FbxTestWriter() {
+        channel = null;
+        buffer = ByteBuffer.allocate(1 << 16).order(ByteOrder.LITTLE_ENDIAN);
+        writeHeader();
+    }
+
+    /**
+     * Creates a writer that streams the records to a file, the file is
+     * truncated.
+     *
+     * @param file The file.
+     * @throws Exception If the file can not be opened.
+     */
+    public FbxTestWriter(File file) throws Exception {
+        channel = new RandomAccessFile(file, "rw").getChannel();
+        channel.truncate(0);
+        buffer = ByteBuffer.allocate(1 << 20).order(ByteOrder.LITTLE_ENDIAN);
+        writeHeader();
+    }
+
+    /**
+     * Sets if double arrays of records begun from now on are deflated.
+     *
+     * @param deflate True to deflate, arrays are stored uncompressed by default.
+     */
+    public void setDeflate(boolean deflate) {
+        this.deflate = deflate;
+    }
+
+    /**
+     * Retrieves the offset the next record starts at.
+     *
+     * @return The offset in bytes.
+     */
+    public long position() {
+        return flushed + buffer.position();
+    }
+
+    /**
+     * Writes the header and properties of a record. Supported properties are
+     * Long, Double, String and arrays of int, long, float and double.
+     *
+     * @param name       The record name.
+     * @param properties The properties.
+     * @return The start offset of the record, to be passed to end().
+     */
+    public long begin(String name, Object... properties) {
+        long start = position();
+        reserve(13 + name.length());
+        buffer.putInt(0).putInt(properties.length).putInt(0);
+        buffer.put((byte) name.length()).put(name.getBytes(StandardCharsets.US_ASCII));
+        int propertyStart = buffer.position();
+        for (Object property : properties) {
+            if (property instanceof Long) {
+                reserve(9);
+                buffer.put((byte) 'L').putLong((Long) property);
+            } else if (property instanceof Double) {
+                reserve(9);
+                buffer.put((byte) 'D').putDouble((Double) property);
+            } else if (property instanceof String) {
+                byte[] bytes = ((String) property).getBytes(StandardCharsets.ISO_8859_1);
+                reserve(5 + bytes.length);
+                buffer.put((byte) 'S').putInt(bytes.length).put(bytes);
+            } else if (property instanceof int[]) {
+                int[] values = (int[]) property;
+                reserve(13 + values.length * 4);
+                buffer.put((byte) 'i').putInt(values.length).putInt(0).putInt(values.length * 4);
+                for (int value : values) {
+                    buffer.putInt(value);
+                }
+            } else if (property instanceof long[]) {
+                long[] values = (long[]) property;
+                reserve(13 + values.length * 8);
+                buffer.put((byte) 'l').putInt(values.length).putInt(0).putInt(values.length * 8);
+                for (long value : values) {
+                    buffer.putLong(value);
+                }
+            } else if (property instanceof float[]) {
+                float[] values = (float[]) property;
+                reserve(13 + values.length * 4);
+                buffer.put((byte) 'f').putInt(values.length).putInt(0).putInt(values.length * 4);
+                for (float value : values) {
+                    buffer.putFloat(value);
+                }
+            } else if (deflate) {
+                double[] values = (double[]) property;
+                ByteBuffer raw = ByteBuffer.allocate(values.length * 8).order(ByteOrder.LITTLE_ENDIAN);
+                for (double value : values) {
+                    raw.putDouble(value);
+                }
+                Deflater deflater = new Deflater();
+                deflater.setInput(raw.array());
+                deflater.finish();
+                byte[] compressed = new byte[raw.capacity() + 64];
+                int length = deflater.deflate(compressed);
+                deflater.end();
+                reserve(13 + length);
+                buffer.put((byte) 'd').putInt(values.length).putInt(1).putInt(length).put(compressed, 0, length);
+            } else {
+                double[] values = (double[]) property;
+                reserve(13 + values.length * 8);
+                buffer.put((byte) 'd').putInt(values.length).putInt(0).putInt(values.length * 8);
+                for (double value : values) {
+                    buffer.putDouble(value);
+                }
+            }
+        }
+        buffer.putInt((int) (start - flushed) + 8, buffer.position() - propertyStart);
+        return start;
+    }
+
+    /**
+     * Ends a record and its nested list at the current position.
+     *
+     * @param start The start offset returned by begin().
+     * @throws Exception If the offset can not be patched in the file.
+     */
+    public void end(long start) throws Exception {
+        if (start >= flushed) {
+            buffer.putInt((int) (start - flushed), (int) position());
+            return;
+        }
+        ByteBuffer offset = ByteBuffer.allocate(4).order(ByteOrder.LITTLE_ENDIAN).putInt((int) position());
+        offset.flip();
+        channel.write(offset, start);
+    }
+
+    /**
+     * Writes the buffered records to the file, all records begun since the last
+     * flush have to be ended. Does nothing for a writer kept in memory.
+     *
+     * @throws Exception If the records can not be written.
+     */
+    public void flush() throws Exception {
+        if (channel == null) {
+            return;
+        }
+        buffer.flip();
+        while (buffer.hasRemaining()) {
+            channel.write(buffer, flushed + buffer.position());
+        }
+        flushed += buffer.limit();
+        buffer.clear();
+    }
+
+    /**
+     * Retrieves the records of a writer kept in memory.
+     *
+     * @return A copy of the written bytes.
+     */
+    public byte[] toByteArray() {
+        if (channel != null) {
+            throw new IllegalStateException("Records were written to a file");
+        }
+        return Arrays.copyOf(buffer.array(), buffer.position());
+    }
+
+    @Override
+    public void close() throws Exception {
+        if (channel != null) {
+            flush();
+            channel.close();
+        }
+    }
+
+    private void writeHeader() {
+        buffer.put("Kaydara FBX Binary  \0".getBytes(StandardCharsets.US_ASCII));
+        buffer.put((byte) 0x1A).put((byte) 0).putInt(7400);
+    }
+
+    private void reserve(int count) {
+        if (buffer.remaining() < count) {
+            ByteBuffer grown = ByteBuffer.allocate(Math.max(buffer.capacity() * 2, buffer.position() + count)).order(ByteOrder.LITTLE_ENDIAN);
+            buffer.flip();
+            grown.put(buffer);
+            buffer = grown;
+        }
+    }
+}
@@ -0,0 +1,91 @@
+package com.github.nodedev74.jfbx;
+
+import static org.junit.jupiter.api.Assertions.assertEquals;
+import static org.junit.jupiter.api.Assertions.assertTrue;
+
+import java.nio.ByteBuffer;
+import java.util.Arrays;
+
+import org.junit.jupiter.api.Test;
+
+import com.github.nodedev74.jfbx.scene.SceneGraph;
+import com.github.nodedev74.jfbx.vulkan.VkHandler;
+
+public class IndirectDrawTest {
+
+    private static final int[] OBJECT_COUNTS = { 1_000, 10_000, 100_000 };
+    private static final int MESH_COUNT = 4;
+    private static final int FRAMES = 30;
+    private static final float SPACING = 3.0f;
+
+    @Test
+    public void multiDrawBenchmark() throws Exception {
+        NativeLoader.load("libvulkan");
+
+        for (int count : OBJECT_COUNTS) {
+            int size = (int) Math.ceil(Math.sqrt(count));
+            SceneGraph graph = new SceneGraph(roots(count));
+            for (int i = 0; i < count; i++) {
+                graph.setTranslation(i, (i % size - size / 2) * SPACING, 0.0f, (i / size - size / 2) * SPACING);
+            }
+
+            System.setProperty("jfbx.matrixCapacity", Integer.toString(count));
+            VkHandler handler = new VkHandler(256, 256, 2);
+            System.clearProperty("jfbx.matrixCapacity");
+            handler.setSceneGraph(graph);
+            // Meshes of different sizes place every object at another offset of the arenas
+            int[] meshes = new int[MESH_COUNT];
+            for (int i = 0; i < MESH_COUNT; i++) {
+                meshes[i] = handler.addMesh(scale(TestScenes.CUBE_POSITIONS, 1.0f, 1.0f + i, 1.0f), TestScenes.CUBE_INDICES);
+            }
+            for (int i = 0; i < count; i++) {
+                handler.addObject(meshes[i % MESH_COUNT], i);
+            }
+            handler.setFrustumCulling(false);
+            handler.setOcclusionCulling(false);
+            float extent = size * SPACING;
+            handler.setViewProjection(TestScenes.topDown(extent));
+
+            double[] recordTimes = new double[2];
+            double[] renderPassTimes = new double[2];
+            byte[][] images = new byte[2][];
+            for (int multiDraw = 0; multiDraw < 2; multiDraw++) {
+                handler.setMultiDrawIndirect(multiDraw == 1);
+                ByteBuffer image = null;
+                for (int i = 0; i < FRAMES; i++) {
+                    image = handler.readback(handler.submitOffscreen());
+                    recordTimes[multiDraw] += handler.getRecordTime() / FRAMES;
+                }
+                renderPassTimes[multiDraw] = handler.getGpuTimings().getScopeTime("render pass");
+                images[multiDraw] = new byte[image.remaining()];
+                image.get(images[multiDraw]);
+            }
+            assertEquals(count, handler.getDrawCount());
+            // Both paths draw the same list in the same order, so the images match exactly
+            assertTrue(Arrays.equals(images[0], images[1]));
+
+            System.out.printf("Drawing %d objects: per draw %.3f ms CPU and %.3f ms GPU, multi draw indirect %.3f ms CPU and %.3f ms GPU (%.0f draws/ms)%n",
+                    count, recordTimes[0], renderPassTimes[0], recordTimes[1], renderPassTimes[1],
+                    count / Math.max(renderPassTimes[1], 1e-3));
+
+            handler.destroy();
+            graph.destroy();
+        }
+    }
+
+    private static int[] roots(int count) {
+        int[] parents = new int[count];
+        Arrays.fill(parents, -1);
+        return parents;
+    }
+
+    private static float[] scale(float[] positions, float x, float y, float z) {
+        float[] out = new float[positions.length];
+        for (int i = 0; i < positions.length; i += 3) {
+            out[i] = positions[i] * x;
+            out[i + 1] = positions[i + 1] * y;
+            out[i + 2] = positions[i + 2] * z;
+        }
+        return out;
+    }
+}
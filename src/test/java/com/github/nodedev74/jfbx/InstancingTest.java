@@ -0,0 +1,199 @@
+package com.github.nodedev74.jfbx;
+
+import static org.junit.jupiter.api.Assertions.assertEquals;
+import static org.junit.jupiter.api.Assertions.assertTrue;
+
+import java.io.File;
+import java.io.FileOutputStream;
+import java.nio.ByteBuffer;
+import java.util.Arrays;
+
+import org.junit.jupiter.api.Test;
+
+import com.github.nodedev74.jfbx.fbx.FbxScene;
+import com.github.nodedev74.jfbx.scene.SceneGraph;
+import com.github.nodedev74.jfbx.vulkan.VkHandler;
+
+public class InstancingTest {
+
+    private static final int GEOMETRY_COUNT = 8;
+    private static final int MATERIAL_COUNT = 2;
+    private static final int MODEL_COUNT = 20_000;
+    private static final int FRAMES = 30;
+    private static final float SPACING = 3.0f;
+
+    private static final double[] CUBE_VERTICES = {
+            -1, 0, -1, 1, 0, -1, 1, 0, 1, -1, 0, 1,
+            -1, 2, -1, 1, 2, -1, 1, 2, 1, -1, 2, 1 };
+    // Quads, the last index of every polygon is stored as its bitwise complement
+    private static final int[] CUBE_POLYGONS = {
+            0, 3, 2, ~1, 4, 5, 6, ~7, 0, 1, 5, ~4,
+            1, 2, 6, ~5, 2, 3, 7, ~6, 3, 0, 4, ~7 };
+
+    @Test
+    public void sharedGeometryTest() throws Exception {
+        NativeLoader.load("libvulkan");
+
+        File file = writeReuseScene();
+        FbxScene scene = FbxScene.open(file.getPath());
+        assertEquals(GEOMETRY_COUNT, scene.getMeshCount());
+        assertEquals(MATERIAL_COUNT, scene.getMaterialCount());
+        assertEquals(GEOMETRY_COUNT * MATERIAL_COUNT, scene.getInstanceGroupCount());
+
+        int grouped = 0;
+        for (int i = 0; i < scene.getInstanceGroupCount(); i++) {
+            int mesh = scene.getInstanceGroupMesh(i);
+            int material = scene.getInstanceGroupMaterial(i);
+            for (int model : scene.getInstanceGroupModels(i)) {
+                assertEquals(mesh, model % GEOMETRY_COUNT);
+                assertEquals(material, scene.getModelMaterial(model));
+                grouped++;
+            }
+        }
+        assertEquals(MODEL_COUNT, grouped);
+        assertEquals(0, scene.getMeshModel(0));
+        assertEquals(MODEL_COUNT / GEOMETRY_COUNT, scene.getMeshModels(0).length);
+
+        scene.destroy();
+        file.delete();
+    }
+
+    @Test
+    public void instancingBenchmark() throws Exception {
+        NativeLoader.load("libvulkan");
+
+        File file = writeReuseScene();
+        FbxScene scene = FbxScene.open(file.getPath());
+        SceneGraph graph = scene.createSceneGraph();
+        graph.update();
+
+        System.setProperty("jfbx.matrixCapacity", Integer.toString(MODEL_COUNT));
+        VkHandler handler = new VkHandler(256, 256, 2);
+        System.clearProperty("jfbx.matrixCapacity");
+        handler.setSceneGraph(graph);
+
+        // Every geometry is uploaded once, duplicating it per model is what the import avoids
+        long sharedBytes = 0;
+        long duplicatedBytes = 0;
+        int[] meshes = new int[scene.getMeshCount()];
+        for (int i = 0; i < meshes.length; i++) {
+            float[] positions = scene.getMeshPositions(i);
+            int[] indices = scene.getMeshIndices(i);
+            meshes[i] = handler.addMesh(positions, indices);
+            long bytes = (positions.length + indices.length) * 4L;
+            sharedBytes += bytes;
+            duplicatedBytes += bytes * scene.getMeshModels(i).length;
+        }
+        int[] materials = new int[scene.getMaterialCount()];
+        for (int i = 0; i < materials.length; i++) {
+            materials[i] = handler.addMaterial(new float[] { 1, 1, 1, 1 }, 0);
+        }
+        for (int i = 0; i < scene.getInstanceGroupCount(); i++) {
+            int mesh = meshes[scene.getInstanceGroupMesh(i)];
+            int group = scene.getInstanceGroupMaterial(i);
+            int material = group < 0 ? 0 : materials[group];
+            for (int model : scene.getInstanceGroupModels(i)) {
+                handler.addObject(mesh, model, material);
+            }
+        }
+        handler.setFrustumCulling(false);
+        handler.setOcclusionCulling(false);
+        handler.setMultiDrawIndirect(false);
+        int size = (int) Math.ceil(Math.sqrt(MODEL_COUNT));
+        handler.setViewProjection(TestScenes.topDown(size * SPACING));
+
+        double[] frameTimes = new double[2];
+        double[] renderPassTimes = new double[2];
+        int[] drawCalls = new int[2];
+        byte[][] images = new byte[2][];
+        for (int instancing = 0; instancing < 2; instancing++) {
+            handler.setInstancing(instancing == 1);
+            ByteBuffer image = null;
+            long start = System.nanoTime();
+            for (int i = 0; i < FRAMES; i++) {
+                image = handler.readback(handler.submitOffscreen());
+            }
+            frameTimes[instancing] = (System.nanoTime() - start) / 1e6 / FRAMES;
+            renderPassTimes[instancing] = handler.getGpuTimings().getScopeTime("render pass");
+            drawCalls[instancing] = handler.getDrawCallCount();
+            images[instancing] = new byte[image.remaining()];
+            image.get(images[instancing]);
+        }
+        assertEquals(MODEL_COUNT, drawCalls[0]);
+        // Per material descriptor sets split the instances of a geometry by material
+        assertEquals(handler.isBindlessSupported() ? GEOMETRY_COUNT : GEOMETRY_COUNT * MATERIAL_COUNT, drawCalls[1]);
+        // The models do not overlap, so the draw order does not change the image
+        assertTrue(Arrays.equals(images[0], images[1]));
+
+        // The occlusion pass packs the instances that pass its test into the same groups
+        handler.setOcclusionCulling(true);
+        ByteBuffer image = null;
+        for (int i = 0; i < FRAMES; i++) {
+            image = handler.readback(handler.submitOffscreen());
+        }
+        assertEquals(drawCalls[1], handler.getDrawCallCount());
+        byte[] occlusionImage = new byte[image.remaining()];
+        image.get(occlusionImage);
+        assertTrue(Arrays.equals(images[0], occlusionImage));
+
+        System.out.printf("%d models sharing %d geometries: %.1f KiB instead of %.1f KiB of mesh data, %d draw calls instead of %d%n",
+                MODEL_COUNT, GEOMETRY_COUNT, sharedBytes / 1024.0, duplicatedBytes / 1024.0, drawCalls[1], drawCalls[0]);
+        System.out.printf("Frame time: per object %.3f ms (%.3f ms GPU), instanced %.3f ms (%.3f ms GPU)%n",
+                frameTimes[0], renderPassTimes[0], frameTimes[1], renderPassTimes[1]);
+
+        handler.destroy();
+        graph.destroy();
+        scene.destroy();
+        file.delete();
+    }
+
+    /**
+     * Writes a binary FBX file whose models are placed on a grid and reuse a few
+     * geometries and materials, model i draws geometry i % GEOMETRY_COUNT.
+     */
+    private static File writeReuseScene() throws Exception {
+        FbxTestWriter writer = new FbxTestWriter();
+        int size = (int) Math.ceil(Math.sqrt(MODEL_COUNT));
+        long geometryId = 1_000_000L;
+        long materialId = 2_000_000L;
+        long modelId = 3_000_000L;
+
+        long objects = writer.begin("Objects");
+        for (int i = 0; i < GEOMETRY_COUNT; i++) {
+            double[] vertices = CUBE_VERTICES.clone();
+            for (int v = 1; v < vertices.length; v += 3) {
+                vertices[v] *= 1.0 + i * 0.25;
+            }
+            long geometry = writer.begin("Geometry", geometryId + i, "\0\1Geometry", "Mesh");
+            writer.end(writer.begin("Vertices", vertices));
+            writer.end(writer.begin("PolygonVertexIndex", CUBE_POLYGONS));
+            writer.end(geometry);
+        }
+        for (int i = 0; i < MATERIAL_COUNT; i++) {
+            writer.end(writer.begin("Material", materialId + i, "Material" + i + "\0\1Material", ""));
+        }
+        for (int i = 0; i < MODEL_COUNT; i++) {
+            long model = writer.begin("Model", modelId + i, "Model" + i + "\0\1Model", "Mesh");
+            long properties = writer.begin("Properties70");
+            writer.end(writer.begin("P", "Lcl Translation", "Lcl Translation", "", "A",
+                    (i % size - size / 2) * (double) SPACING, 0.0, (i / size - size / 2) * (double) SPACING));
+            writer.end(properties);
+            writer.end(model);
+        }
+        writer.end(objects);
+
+        long connections = writer.begin("Connections");
+        for (int i = 0; i < MODEL_COUNT; i++) {
+            writer.end(writer.begin("C", "OO", geometryId + i % GEOMETRY_COUNT, modelId + i));
+            writer.end(writer.begin("C", "OO", materialId + i / GEOMETRY_COUNT % MATERIAL_COUNT, modelId + i));
+        }
+        writer.end(connections);
+
+        File file = File.createTempFile("instancing", ".fbx");
+        file.deleteOnExit();
+        try (FileOutputStream out = new FileOutputStream(file)) {
+            out.write(writer.toByteArray());
+        }
+        return file;
+    }
+}
@@ -0,0 +1,74 @@
+package com.github.nodedev74.jfbx;
+
+import static org.junit.jupiter.api.Assertions.assertFalse;
+
+import java.nio.ByteBuffer;
+import java.util.Arrays;
+
+import org.junit.jupiter.api.Test;
+
+import com.github.nodedev74.jfbx.scene.SceneGraph;
+import com.github.nodedev74.jfbx.vulkan.VkHandler;
+
+public class MatrixRingTest {
+
+    private static final int[] OBJECT_COUNTS = { 1, 100, 1_000, 10_000, 100_000 };
+    private static final int FRAMES = 60;
+    private static final float SPACING = 3.0f;
+
+    @Test
+    public void transformUpdateBenchmark() throws Exception {
+        NativeLoader.load("libvulkan");
+
+        for (int count : OBJECT_COUNTS) {
+            int size = (int) Math.ceil(Math.sqrt(count));
+            int[] parents = new int[count];
+            Arrays.fill(parents, -1);
+            SceneGraph graph = new SceneGraph(parents);
+
+            System.setProperty("jfbx.matrixCapacity", Integer.toString(count));
+            VkHandler handler = new VkHandler(256, 256, 3);
+            System.clearProperty("jfbx.matrixCapacity");
+            handler.setSceneGraph(graph);
+            int mesh = handler.addMesh(TestScenes.CUBE_POSITIONS, TestScenes.CUBE_INDICES);
+            for (int i = 0; i < count; i++) {
+                handler.addObject(mesh, i);
+            }
+            handler.setFrustumCulling(false);
+            handler.setOcclusionCulling(false);
+            handler.setViewProjection(TestScenes.topDown(Math.max(size, 2) * SPACING));
+
+            // Every object moves every frame, so every frame writes all of its matrices
+            double writeTime = 0.0;
+            double renderPassTime = 0.0;
+            byte[] first = null;
+            byte[] last = null;
+            for (int frame = 0; frame < FRAMES; frame++) {
+                float shift = (frame % 8) * SPACING / 8;
+                for (int i = 0; i < count; i++) {
+                    graph.setTranslation(i, (i % size - size / 2) * SPACING + shift, 0.0f, (i / size - size / 2) * SPACING);
+                }
+                ByteBuffer image = handler.readback(handler.submitOffscreen());
+                writeTime += handler.getMatrixWriteTime() / FRAMES;
+                renderPassTime += handler.getGpuTimings().getScopeTime("render pass") / FRAMES;
+                if (frame == 0 || frame == 4) {
+                    byte[] pixels = new byte[image.remaining()];
+                    image.get(pixels);
+                    if (frame == 0) {
+                        first = pixels;
+                    } else {
+                        last = pixels;
+                    }
+                }
+            }
+            // The frames read their own ring regions, a shifted frame draws another image
+            assertFalse(Arrays.equals(first, last));
+
+            System.out.printf("Updating %d transforms: %.4f ms to write the matrices (%.1f MB/s), %.3f ms render pass%n",
+                    count, writeTime, count * 64 / Math.max(writeTime, 1e-6) / 1e3, renderPassTime);
+
+            handler.destroy();
+            graph.destroy();
+        }
+    }
+}
@@ -0,0 +1,98 @@
+package com.github.nodedev74.jfbx;
+
+import static org.junit.jupiter.api.Assertions.assertNotNull;
+import static org.junit.jupiter.api.Assertions.assertTrue;
+
+import java.util.Arrays;
+
+import org.junit.jupiter.api.Test;
+
+import com.github.nodedev74.jfbx.exception.VkRuntimeError;
+import com.github.nodedev74.jfbx.scene.SceneGraph;
+import com.github.nodedev74.jfbx.vulkan.VkHandler;
+import com.github.nodedev74.jfbx.vulkan.VkMemoryCategory;
+
+public class MemoryBudgetTest {
+
+    private static final int TEXTURE_COUNT = 64;
+    private static final int TEXTURE_SIZE = 512;
+    private static final int BATCHES = 4;
+    private static final int ROWS = 200;
+    private static final int COLUMNS = 4;
+    private static final float SPACING = 4.0f;
+    private static final int FRAMES = 120;
+    private static final long HEADROOM = 24L << 20;
+
+    @Test
+    public void oversubscriptionStress() throws Exception {
+        NativeLoader.load("libvulkan");
+
+        // The usage of an empty handler, the budget leaves a fixed headroom above it
+        VkHandler handler = new VkHandler(256, 256, 3);
+        long baseline = handler.getMemoryUsage();
+        handler.destroy();
+
+        int objectCount = ROWS * COLUMNS;
+        int[] parents = new int[objectCount];
+        Arrays.fill(parents, -1);
+        SceneGraph graph = new SceneGraph(parents);
+        for (int i = 0; i < objectCount; i++) {
+            graph.setTranslation(i, (i % COLUMNS - (COLUMNS - 1) / 2.0f) * SPACING, -1.0f, -(i / COLUMNS) * SPACING);
+        }
+
+        // The texture budget alone would hold every full chain, only the memory budget limits them
+        System.setProperty("jfbx.memoryBudget", Long.toString(baseline + HEADROOM));
+        System.setProperty("jfbx.textureBudget", Long.toString(1L << 30));
+        handler = new VkHandler(256, 256, 3);
+        System.clearProperty("jfbx.memoryBudget");
+        System.clearProperty("jfbx.textureBudget");
+        handler.setSceneGraph(graph);
+        int mesh = handler.addMesh(TestScenes.CUBE_POSITIONS, TestScenes.CUBE_INDICES);
+        long budget = handler.getMemoryBudget();
+
+        // Each batch adds textures while the camera flies through the corridor, the later ones
+        // do not fit next to the refined levels of the earlier ones
+        int failedBatches = 0;
+        long peakUsage = 0;
+        for (int batch = 0; batch < BATCHES; batch++) {
+            byte[][] files = new byte[TEXTURE_COUNT][];
+            for (int i = 0; i < TEXTURE_COUNT; i++) {
+                files[i] = TestScenes.encodePng(TestScenes.pattern(TEXTURE_SIZE, batch * TEXTURE_COUNT + i, false));
+            }
+            int[] textures;
+            try {
+                textures = handler.addStreamedTextures(files, false);
+            } catch (VkRuntimeError e) {
+                failedBatches++;
+                continue;
+            }
+            for (int i = 0; i < objectCount; i += BATCHES) {
+                int object = i + batch;
+                handler.addObject(mesh, object, handler.addMaterial(new float[] { 1.0f, 1.0f, 1.0f, 1.0f },
+                        textures[(object / COLUMNS * 7 + object % COLUMNS) % TEXTURE_COUNT]));
+            }
+
+            for (int frame = 0; frame < FRAMES; frame++) {
+                handler.setViewProjection(TestScenes.viewProjection(60.0f, 1.0f, 0.1f, 200.0f, 0.0f, 1.0f, 8.0f - frame * SPACING / 2));
+                assertNotNull(handler.readback(handler.submitOffscreen()));
+                peakUsage = Math.max(peakUsage, handler.getMemoryUsage());
+            }
+        }
+
+        // Rendering went on, and the budget was kept by evicting or by refusing allocations
+        assertTrue(handler.getEvictionCount() > 0 || handler.getRefusedAllocationCount() > 0);
+        assertTrue(handler.getMemoryUsage() <= budget);
+        System.out.printf("%d batches of %d streamed %dx%d textures within %.1f MiB: %.1f MiB peak usage, %d batches failed%n",
+                BATCHES, TEXTURE_COUNT, TEXTURE_SIZE, TEXTURE_SIZE, budget / 1048576.0, peakUsage / 1048576.0, failedBatches);
+        System.out.printf("%d evictions freed %.1f MiB, %d allocations refused, budget from %s%n",
+                handler.getEvictionCount(), handler.getEvictedMemory() / 1048576.0, handler.getRefusedAllocationCount(),
+                handler.isMemoryBudgetSupported() ? "VK_EXT_memory_budget" : "heap sizes");
+        String[] names = { "vertex", "index", "texture", "staging", "uniform", "target" };
+        for (int category = VkMemoryCategory.VERTEX; category <= VkMemoryCategory.TARGET; category++) {
+            System.out.printf("  %-8s %8.2f MiB%n", names[category], handler.getCategoryMemory(category) / 1048576.0);
+        }
+
+        handler.destroy();
+        graph.destroy();
+    }
+}
@@ -0,0 +1,156 @@
+package com.github.nodedev74.jfbx;
+
+import static org.junit.jupiter.api.Assertions.assertArrayEquals;
+import static org.junit.jupiter.api.Assertions.assertEquals;
+import static org.junit.jupiter.api.Assertions.assertTrue;
+
+import java.io.File;
+import java.nio.charset.StandardCharsets;
+import java.nio.file.Files;
+import java.nio.file.Paths;
+
+import org.junit.jupiter.api.Test;
+
+import com.github.nodedev74.jfbx.fbx.FbxScene;
+
+public class ParseArenaTest {
+
+    private static final int MODEL_COUNT = 500_000;
+    private static final int GEOMETRY_COUNT = 256;
+    private static final int GRID = 32;
+
+    @Test
+    public void arenaAgainstHeap() throws Exception {
+        NativeLoader.load("libvulkan");
+
+        File file = File.createTempFile("records", ".fbx");
+        file.deleteOnExit();
+        writeRecords(file);
+
+        float[] heapPositions = null;
+        long heapAllocations = 0;
+        try {
+            for (boolean arena : new boolean[] { false, true }) {
+                System.setProperty("jfbx.parseArena", Boolean.toString(arena));
+                System.gc();
+                long rss = resetPeakMemory();
+
+                long start = System.nanoTime();
+                FbxScene scene = FbxScene.open(file.getPath());
+                double openTime = (System.nanoTime() - start) / 1e6;
+                long peak = rss >= 0 ? readStatus("VmHWM") - rss : -1;
+                assertEquals(MODEL_COUNT, scene.getModelCount());
+                assertEquals(GEOMETRY_COUNT, scene.getMeshCount());
+                float[] positions = scene.getMeshPositions(GEOMETRY_COUNT - 1);
+                long allocations = scene.getParseAllocationCount();
+
+                System.out.printf("%s: parse %.1f ms of %.1f ms open, %d allocations, %.1f MiB allocated, %.1f MiB reserved%n",
+                        arena ? "Arena" : "Heap", scene.getParseTime(), openTime, allocations,
+                        scene.getParseMemory() / 1048576.0, scene.getParseReservedMemory() / 1048576.0);
+                start = System.nanoTime();
+                scene.destroy();
+                double destroyTime = (System.nanoTime() - start) / 1e6;
+                System.out.printf("%s: destroyed in %.1f ms, peak RSS growth %s%n", arena ? "Arena" : "Heap", destroyTime,
+                        peak >= 0 ? String.format("%.1f MiB", peak / 1048576.0) : "not available");
+
+                if (!arena) {
+                    heapPositions = positions;
+                    heapAllocations = allocations;
+                } else {
+                    // Both modes build the same records, only where their memory comes from differs
+                    assertArrayEquals(heapPositions, positions);
+                    assertEquals(heapAllocations, allocations);
+                    assertTrue(allocations > MODEL_COUNT * 4L);
+                }
+            }
+        } finally {
+            System.clearProperty("jfbx.parseArena");
+            file.delete();
+        }
+    }
+
+    /**
+     * Resets the peak resident set size of the process where Linux allows it.
+     *
+     * @return The current resident set size in bytes, or -1 if the peak cannot
+     *         be measured.
+     */
+    private static long resetPeakMemory() {
+        try {
+            Files.write(Paths.get("/proc/self/clear_refs"), "5".getBytes(StandardCharsets.US_ASCII));
+            return readStatus("VmRSS");
+        } catch (Exception e) {
+            return -1;
+        }
+    }
+
+    private static long readStatus(String field) throws Exception {
+        for (String line : Files.readAllLines(Paths.get("/proc/self/status"))) {
+            if (line.startsWith(field + ":")) {
+                return Long.parseLong(line.replaceAll("[^0-9]", "")) * 1024;
+            }
+        }
+        return -1;
+    }
+
+    /**
+     * Writes GEOMETRY_COUNT grid geometries with deflated vertices followed by
+     * MODEL_COUNT models with a few properties each, connected round-robin.
+     */
+    private static void writeRecords(File file) throws Exception {
+        double[] vertices = new double[GRID * GRID * 3];
+        int[] polygons = new int[(GRID - 1) * (GRID - 1) * 4];
+        for (int y = 0, p = 0; y < GRID - 1; y++) {
+            for (int x = 0; x < GRID - 1; x++) {
+                int corner = y * GRID + x;
+                polygons[p++] = corner;
+                polygons[p++] = corner + GRID;
+                polygons[p++] = corner + GRID + 1;
+                polygons[p++] = ~(corner + 1);
+            }
+        }
+
+        long geometryId = 100_000_000L;
+        long modelId = 1L;
+        try (FbxTestWriter writer = new FbxTestWriter(file)) {
+            writer.setDeflate(true);
+            long objects = writer.begin("Objects");
+            for (int i = 0; i < GEOMETRY_COUNT; i++) {
+                for (int v = 0; v < GRID * GRID; v++) {
+                    vertices[v * 3] = v % GRID;
+                    vertices[v * 3 + 1] = i;
+                    vertices[v * 3 + 2] = v / GRID;
+                }
+                long geometry = writer.begin("Geometry", geometryId + i, "\0\1Geometry", "Mesh");
+                writer.end(writer.begin("Vertices", vertices));
+                writer.end(writer.begin("PolygonVertexIndex", polygons));
+                writer.end(geometry);
+            }
+            for (int i = 0; i < MODEL_COUNT; i++) {
+                long model = writer.begin("Model", modelId + i, "Model" + i + "\0\1Model", "Mesh");
+                writer.end(writer.begin("Version", 232L));
+                long properties = writer.begin("Properties70");
+                writer.end(writer.begin("P", "Lcl Translation", "Lcl Translation", "", "A", (double) i, 0.0, 0.0));
+                writer.end(writer.begin("P", "Lcl Rotation", "Lcl Rotation", "", "A", 0.0, (double) (i % 360), 0.0));
+                writer.end(writer.begin("P", "DefaultAttributeIndex", "int", "Integer", "", 0L));
+                writer.end(properties);
+                writer.end(writer.begin("Shading", "Y"));
+                writer.end(writer.begin("Culling", "CullingOff"));
+                writer.end(model);
+                if (i % 4096 == 0) {
+                    writer.flush();
+                }
+            }
+            writer.end(objects);
+
+            long connections = writer.begin("Connections");
+            for (int i = 0; i < MODEL_COUNT; i++) {
+                writer.end(writer.begin("C", "OO", geometryId + i % GEOMETRY_COUNT, modelId + i));
+                if (i % 4096 == 0) {
+                    writer.flush();
+                }
+            }
+            writer.end(connections);
+        }
+    }
+}
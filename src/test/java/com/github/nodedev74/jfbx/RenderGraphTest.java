@@ -0,0 +1,78 @@
+package com.github.nodedev74.jfbx;
+
+import static org.junit.jupiter.api.Assertions.assertTrue;
+
+import java.nio.ByteBuffer;
+import java.util.Arrays;
+
+import org.junit.jupiter.api.Test;
+
+import com.github.nodedev74.jfbx.scene.SceneGraph;
+import com.github.nodedev74.jfbx.vulkan.VkGpuTimings;
+import com.github.nodedev74.jfbx.vulkan.VkHandler;
+
+public class RenderGraphTest {
+
+    private static final int COUNT = 10_000;
+    private static final int FRAMES = 30;
+    private static final float SPACING = 3.0f;
+
+    @Test
+    public void barrierReport() throws Exception {
+        NativeLoader.load("libvulkan");
+
+        int size = (int) Math.ceil(Math.sqrt(COUNT));
+        int[] parents = new int[COUNT];
+        Arrays.fill(parents, -1);
+        SceneGraph graph = new SceneGraph(parents);
+        for (int i = 0; i < COUNT; i++) {
+            graph.setTranslation(i, (i % size - size / 2) * SPACING, 0.0f, (i / size - size / 2) * SPACING);
+        }
+
+        byte[][] images = new byte[2][];
+        for (int synchronization2 = 1; synchronization2 >= 0; synchronization2--) {
+            System.setProperty("jfbx.matrixCapacity", Integer.toString(COUNT));
+            System.setProperty("jfbx.synchronization2", Boolean.toString(synchronization2 == 1));
+            VkHandler handler = new VkHandler(256, 256, 3);
+            System.clearProperty("jfbx.matrixCapacity");
+            System.clearProperty("jfbx.synchronization2");
+            handler.setSceneGraph(graph);
+            int mesh = handler.addMesh(TestScenes.CUBE_POSITIONS, TestScenes.CUBE_INDICES);
+            for (int i = 0; i < COUNT; i++) {
+                handler.addObject(mesh, i);
+            }
+            handler.setFrustumCulling(false);
+            handler.setOcclusionCulling(true);
+            handler.setViewProjection(TestScenes.topDown(size * SPACING));
+
+            ByteBuffer image = null;
+            double frameTime = 0.0;
+            for (int frame = 0; frame < FRAMES; frame++) {
+                image = handler.readback(handler.submitOffscreen());
+                VkGpuTimings timings = handler.getGpuTimings();
+                for (String scope : timings.getScopeNames()) {
+                    frameTime += timings.getScopeTime(scope) / FRAMES;
+                }
+            }
+            images[synchronization2] = new byte[image.remaining()];
+            image.get(images[synchronization2]);
+
+            // Skinning has no instances, so nothing reads its output
+            assertTrue(handler.getCulledPassCount() >= 1);
+            // The frame slots share one depth attachment
+            assertTrue(handler.getTransientMemorySaved() > 0);
+
+            System.out.printf("Render graph with%s synchronization2: %d barriers in %d commands per frame, %d passes culled, "
+                    + "%.2f MB transient memory (%.2f MB saved), %.3f ms GPU%n",
+                    synchronization2 == 1 ? "" : "out", handler.getBarrierCount(), handler.getBarrierBatchCount(),
+                    handler.getCulledPassCount(), handler.getTransientMemory() / 1e6, handler.getTransientMemorySaved() / 1e6,
+                    frameTime);
+
+            handler.destroy();
+        }
+        // Both barrier paths order the same passes, so the frames match exactly
+        assertTrue(Arrays.equals(images[0], images[1]));
+
+        graph.destroy();
+    }
+}
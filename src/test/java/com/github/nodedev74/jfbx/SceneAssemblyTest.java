@@ -0,0 +1,123 @@
+package com.github.nodedev74.jfbx;
+
+import static org.junit.jupiter.api.Assertions.assertEquals;
+import static org.junit.jupiter.api.Assertions.assertTrue;
+
+import java.io.File;
+
+import org.junit.jupiter.api.Test;
+
+import com.github.nodedev74.jfbx.fbx.FbxScene;
+
+public class SceneAssemblyTest {
+
+    private static final int[] MODEL_COUNTS = { 10_000, 100_000, 1_000_000 };
+    private static final int GEOMETRY_COUNT = 256;
+    private static final int MATERIAL_COUNT = 16;
+    private static final int ANIMATED_EVERY = 64;
+
+    @Test
+    public void assemblyScaling() throws Exception {
+        NativeLoader.load("libvulkan");
+
+        double firstPerObject = 0.0;
+        double lastPerObject = 0.0;
+        for (int modelCount : MODEL_COUNTS) {
+            File file = File.createTempFile("hierarchy", ".fbx");
+            file.deleteOnExit();
+            writeHierarchy(file, modelCount);
+
+            long start = System.nanoTime();
+            FbxScene scene = FbxScene.open(file.getPath());
+            double openTime = (System.nanoTime() - start) / 1e6;
+            double assemblyTime = scene.getAssemblyTime();
+
+            assertEquals(modelCount, scene.getModelCount());
+            for (int i = 1; i < modelCount; i += modelCount / 97) {
+                assertEquals((i - 1) / 4, scene.getModelParent(i));
+            }
+            assertEquals(-1, scene.getModelParent(0));
+            assertEquals(GEOMETRY_COUNT, scene.getMeshCount());
+            assertEquals(GEOMETRY_COUNT, scene.getInstanceGroupCount());
+            assertEquals(modelCount / GEOMETRY_COUNT, scene.getMeshModels(GEOMETRY_COUNT - 1).length);
+            assertEquals(1, scene.getAnimationStackCount());
+            scene.destroy();
+            file.delete();
+
+            double perObject = assemblyTime * 1e6 / modelCount;
+            if (modelCount == MODEL_COUNTS[0]) {
+                firstPerObject = perObject;
+            }
+            lastPerObject = perObject;
+            System.out.printf("%d models: open %.1f ms, assembly %.1f ms, %.0f ns per model%n",
+                    modelCount, openTime, assemblyTime, perObject);
+        }
+
+        // Linear assembly keeps the cost per model flat apart from cache effects
+        assertTrue(lastPerObject < firstPerObject * 10);
+    }
+
+    /**
+     * Writes a four-ary hierarchy of models sharing GEOMETRY_COUNT geometries
+     * and MATERIAL_COUNT materials round-robin, with every ANIMATED_EVERY-th
+     * model translated by a curve of one animation stack.
+     */
+    private static void writeHierarchy(File file, int modelCount) throws Exception {
+        long modelId = 1L;
+        long geometryId = 100_000_000L;
+        long materialId = 200_000_000L;
+        long curveNodeId = 300_000_000L;
+        long curveId = 400_000_000L;
+        long stackId = 500_000_000L;
+        long layerId = 500_000_001L;
+        try (FbxTestWriter writer = new FbxTestWriter(file)) {
+            long objects = writer.begin("Objects");
+            for (int i = 0; i < GEOMETRY_COUNT; i++) {
+                long geometry = writer.begin("Geometry", geometryId + i, "\0\1Geometry", "Mesh");
+                writer.end(writer.begin("Vertices", new double[] { 0, 0, 0, 1, 0, 0, 0, 1, i }));
+                writer.end(writer.begin("PolygonVertexIndex", new int[] { 0, 1, ~2 }));
+                writer.end(geometry);
+            }
+            for (int i = 0; i < MATERIAL_COUNT; i++) {
+                writer.end(writer.begin("Material", materialId + i, "Material" + i + "\0\1Material", ""));
+            }
+            writer.end(writer.begin("AnimationStack", stackId, "Take\0\1AnimStack", ""));
+            writer.end(writer.begin("AnimationLayer", layerId, "Base\0\1AnimLayer", ""));
+            for (int i = 0; i < modelCount; i++) {
+                long model = writer.begin("Model", modelId + i, "Model" + i + "\0\1Model", "Mesh");
+                long properties = writer.begin("Properties70");
+                writer.end(writer.begin("P", "Lcl Translation", "Lcl Translation", "", "A", (double) i, 0.0, 0.0));
+                writer.end(properties);
+                writer.end(model);
+                if (i % ANIMATED_EVERY == 0) {
+                    writer.end(writer.begin("AnimationCurveNode", curveNodeId + i, "T\0\1AnimCurveNode", ""));
+                    long curve = writer.begin("AnimationCurve", curveId + i, "\0\1AnimCurve", "");
+                    writer.end(writer.begin("KeyTime", new long[] { 0L, 46186158000L }));
+                    writer.end(writer.begin("KeyValueFloat", new float[] { 0.0f, 1.0f }));
+                    writer.end(curve);
+                }
+                if (i % 4096 == 0) {
+                    writer.flush();
+                }
+            }
+            writer.end(objects);
+
+            long connections = writer.begin("Connections");
+            writer.end(writer.begin("C", "OO", layerId, stackId));
+            for (int i = 0; i < modelCount; i++) {
+                writer.end(writer.begin("C", "OO", modelId + i, i == 0 ? 0L : modelId + (i - 1) / 4));
+                writer.end(writer.begin("C", "OO", geometryId + i % GEOMETRY_COUNT, modelId + i));
+                writer.end(writer.begin("C", "OO", materialId + i % MATERIAL_COUNT, modelId + i));
+                if (i % ANIMATED_EVERY == 0) {
+                    writer.end(writer.begin("C", "OO", curveNodeId + i, layerId));
+                    writer.end(writer.begin("C", "OP", curveNodeId + i, modelId + i, "Lcl Translation"));
+                    writer.end(writer.begin("C", "OP", curveId + i, curveNodeId + i, "d|X"));
+                }
+                if (i % 4096 == 0) {
+                    writer.flush();
+                }
+            }
+            writer.end(connections);
+        }
+    }
+}
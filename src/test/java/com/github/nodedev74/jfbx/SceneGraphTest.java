@@ -0,0 +1,131 @@
+package com.github.nodedev74.jfbx;
+
+import static org.junit.jupiter.api.Assertions.assertEquals;
+import static org.junit.jupiter.api.Assertions.assertThrows;
+import static org.junit.jupiter.api.Assumptions.assumeTrue;
+
+import java.io.File;
+import java.util.Random;
+
+import org.junit.jupiter.api.Test;
+
+import com.github.nodedev74.jfbx.exception.FbxRuntimeError;
+import com.github.nodedev74.jfbx.fbx.FbxScene;
+import com.github.nodedev74.jfbx.scene.SceneGraph;
+
+public class SceneGraphTest {
+
+    @Test
+    public void propagationTest() throws Exception {
+        NativeLoader.load("libvulkan");
+
+        SceneGraph graph = new SceneGraph(new int[] { 2, 0, -1 });
+        graph.setTranslation(2, 1.0f, 0.0f, 0.0f);
+        graph.setRotation(0, 0.0f, 0.0f, 90.0f);
+        graph.setTranslation(1, 1.0f, 0.0f, 0.0f);
+        assertEquals(3, graph.update());
+        assertEquals(0, graph.update());
+
+        float[] matrix = new float[16];
+        graph.getWorldMatrix(1, matrix);
+        assertEquals(1.0f, matrix[12], 1e-5f);
+        assertEquals(1.0f, matrix[13], 1e-5f);
+
+        graph.setTranslation(0, 0.0f, 2.0f, 0.0f);
+        assertEquals(2, graph.update());
+        graph.getWorldMatrix(1, matrix);
+        assertEquals(3.0f, matrix[13], 1e-5f);
+
+        graph.destroy();
+    }
+
+    @Test
+    public void invalidParentsTest() throws Exception {
+        NativeLoader.load("libvulkan");
+
+        assertThrows(FbxRuntimeError.class, () -> new SceneGraph(new int[] { 1, 0 }));
+        assertThrows(FbxRuntimeError.class, () -> new SceneGraph(new int[] { 0 }));
+        assertThrows(FbxRuntimeError.class, () -> new SceneGraph(new int[] { -1, 2, 3, 1 }));
+        assertThrows(FbxRuntimeError.class, () -> new SceneGraph(new int[] { -1, 2 }));
+    }
+
+    @Test
+    public void invalidNodeTest() throws Exception {
+        NativeLoader.load("libvulkan");
+
+        SceneGraph graph = new SceneGraph(new int[] { -1, 0 });
+        float[] matrix = new float[16];
+        for (int node : new int[] { -1, 2, Integer.MAX_VALUE }) {
+            assertThrows(FbxRuntimeError.class, () -> graph.getSlot(node));
+            assertThrows(FbxRuntimeError.class, () -> graph.setTranslation(node, 1.0f, 2.0f, 3.0f));
+            assertThrows(FbxRuntimeError.class, () -> graph.setRotation(node, 1.0f, 2.0f, 3.0f));
+            assertThrows(FbxRuntimeError.class, () -> graph.setScaling(node, 1.0f, 2.0f, 3.0f));
+            assertThrows(FbxRuntimeError.class, () -> graph.setRotationOrder(node, 1));
+            assertThrows(FbxRuntimeError.class, () -> graph.getWorldMatrix(node, matrix));
+        }
+        graph.setTranslation(1, 1.0f, 2.0f, 3.0f);
+        graph.update();
+        graph.getWorldMatrix(1, matrix);
+        assertEquals(3.0f, matrix[14], 1e-6f);
+        graph.destroy();
+    }
+
+    @Test
+    public void throughputTest() throws Exception {
+        NativeLoader.load("libvulkan");
+
+        Random random = new Random(1);
+        for (int nodeCount : new int[] { 10_000, 100_000, 1_000_000 }) {
+            int[] parents = new int[nodeCount];
+            parents[0] = -1;
+            for (int i = 1; i < nodeCount; i++) {
+                parents[i] = random.nextInt(i);
+            }
+
+            SceneGraph graph = new SceneGraph(parents);
+            graph.update();
+
+            int iterations = 10;
+            long fullTime = 0;
+            long partialTime = 0;
+            int partialCount = 0;
+            for (int iteration = 0; iteration < iterations; iteration++) {
+                for (int i = 0; i < nodeCount; i++) {
+                    graph.setRotation(i, iteration, 0.0f, 0.0f);
+                }
+                long startTime = System.nanoTime();
+                assertEquals(nodeCount, graph.update());
+                fullTime += System.nanoTime() - startTime;
+
+                for (int i = 0; i < nodeCount / 100; i++) {
+                    graph.setTranslation(random.nextInt(nodeCount), iteration, 0.0f, 0.0f);
+                }
+                startTime = System.nanoTime();
+                partialCount += graph.update();
+                partialTime += System.nanoTime() - startTime;
+            }
+
+            System.out.printf("SceneGraph %d nodes, %d levels: full update %.3f ms (%.1f M nodes/s), 1%% dirty %.3f ms (%d nodes)%n",
+                    nodeCount, graph.getLevelCount(), fullTime / 1e6 / iterations,
+                    (double) nodeCount * iterations / fullTime * 1e3, partialTime / 1e6 / iterations,
+                    partialCount / iterations);
+            graph.destroy();
+        }
+    }
+
+    @Test
+    public void fbxHierarchyTest() throws Exception {
+        String path = System.getProperty("jfbx.testFbx", "");
+        assumeTrue(new File(path).isFile(), "Set -Djfbx.testFbx to an FBX file to run this test");
+        NativeLoader.load("libvulkan");
+
+        FbxScene scene = FbxScene.open(path);
+        SceneGraph graph = scene.createSceneGraph();
+        assertEquals(scene.getModelCount(), graph.getNodeCount());
+        assertEquals(scene.getModelCount(), graph.update());
+
+        System.out.printf("%s: %d models, %d levels%n", path, scene.getModelCount(), graph.getLevelCount());
+        graph.destroy();
+        scene.destroy();
+    }
+}
@@ -0,0 +1,188 @@
+package com.github.nodedev74.jfbx;
+
+import static org.junit.jupiter.api.Assertions.assertEquals;
+import static org.junit.jupiter.api.Assertions.assertTrue;
+
+import java.nio.ByteBuffer;
+import java.util.Random;
+
+import org.junit.jupiter.api.Test;
+
+import com.github.nodedev74.jfbx.anim.Skin;
+import com.github.nodedev74.jfbx.scene.SceneGraph;
+import com.github.nodedev74.jfbx.vulkan.VkHandler;
+
+public class SkinningTest {
+
+    private static final int JOINTS = 64;
+    private static final int VERTICES = 50_000;
+    private static final int INSTANCES = 16;
+    private static final int FRAMES = 60;
+
+    @Test
+    public void referenceTest() throws Exception {
+        NativeLoader.load("libvulkan");
+
+        SceneGraph graph = new SceneGraph(new int[] { -1, 0 });
+        graph.setTranslation(0, 0.0f, 2.0f, 0.0f);
+        graph.setTranslation(1, 1.0f, 0.0f, 0.0f);
+        graph.setRotation(1, 0.0f, 0.0f, 90.0f);
+        graph.update();
+
+        float[] inverseBindMatrices = new float[32];
+        for (int i = 0; i < 4; i++) {
+            inverseBindMatrices[i * 5] = 1.0f;
+            inverseBindMatrices[16 + i * 5] = 1.0f;
+        }
+        inverseBindMatrices[16 + 12] = -1.0f;
+
+        Skin skin = new Skin(new float[] { 2, 0, 0, 2, 0, 0, 2, 0, 0 },
+                new int[] { 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0 },
+                new float[] { 1, 0, 0, 0, 1, 0, 0, 0, 1, 1, 0, 0 },
+                new int[] { 0, 1 }, inverseBindMatrices);
+        assertEquals(3, skin.getVertexCount());
+        assertEquals(2, skin.getJointCount());
+
+        float[] positions = new float[12];
+        skin.skin(graph, 0, positions, false);
+        float[] expected = { 2, 2, 0, 1, 1, 3, 0, 1, 1.5f, 2.5f, 0, 1 };
+        for (int i = 0; i < expected.length; i++) {
+            assertEquals(expected[i], positions[i], 1e-5f);
+        }
+
+        skin.destroy();
+        graph.destroy();
+    }
+
+    @Test
+    public void gpuSkinningBenchmark() throws Exception {
+        NativeLoader.load("libvulkan");
+
+        int[] parents = new int[JOINTS * INSTANCES];
+        for (int i = 0; i < parents.length; i++) {
+            parents[i] = i % JOINTS == 0 ? -1 : i - 1;
+        }
+        SceneGraph graph = new SceneGraph(parents);
+        for (int i = 0; i < parents.length; i++) {
+            graph.setTranslation(i, i % JOINTS == 0 ? i / JOINTS * 10.0f : 0.0f, 1.0f, 0.0f);
+            graph.setRotation(i, 0.0f, i % 7, 5.0f);
+        }
+
+        Skin skin = createSkin(new Random(1));
+        VkHandler handler = new VkHandler(64, 64, 2);
+        handler.setSceneGraph(graph);
+        int skinId = handler.addSkin(skin);
+        for (int i = 0; i < INSTANCES; i++) {
+            assertEquals(i, handler.addSkinInstance(skinId, i * JOINTS));
+        }
+
+        for (int i = 0; i < FRAMES; i++) {
+            handler.readback(handler.submitOffscreen());
+        }
+        double gpuTime = handler.getGpuTimings().getScopeTime("skinning");
+
+        float[] expected = new float[VERTICES * 4];
+        float[] actual = new float[VERTICES * 4];
+        int instance = INSTANCES - 1;
+        skin.skin(graph, instance * JOINTS, expected, false);
+        handler.readSkinnedVertices(instance, actual);
+        float maxError = 0.0f;
+        for (int i = 0; i < expected.length; i++) {
+            maxError = Math.max(maxError, Math.abs(expected[i] - actual[i]) / Math.max(1.0f, Math.abs(expected[i])));
+        }
+        assertEquals(0.0f, maxError, 1e-4f);
+
+        long startTime = System.nanoTime();
+        for (int i = 0; i < INSTANCES; i++) {
+            skin.skin(graph, i * JOINTS, expected, false);
+        }
+        long serialTime = System.nanoTime() - startTime;
+        startTime = System.nanoTime();
+        for (int i = 0; i < INSTANCES; i++) {
+            skin.skin(graph, i * JOINTS, expected, true);
+        }
+        long parallelTime = System.nanoTime() - startTime;
+
+        long vertexCount = (long) VERTICES * INSTANCES;
+        System.out.printf("Skinning %d instances x %d vertices: GPU %.3f ms (%.1f M vertices/s), CPU %.3f ms, CPU parallel %.3f ms, max error %.2e%n",
+                INSTANCES, VERTICES, gpuTime, vertexCount / gpuTime / 1e3, serialTime / 1e6, parallelTime / 1e6,
+                maxError);
+
+        handler.destroy();
+        skin.destroy();
+        graph.destroy();
+    }
+
+    @Test
+    public void skinnedObjectTest() throws Exception {
+        NativeLoader.load("libvulkan");
+
+        SceneGraph graph = new SceneGraph(new int[] { -1 });
+        int vertexCount = TestScenes.CUBE_POSITIONS.length / 3;
+        int[] joints = new int[vertexCount * 4];
+        float[] weights = new float[vertexCount * 4];
+        for (int i = 0; i < vertexCount; i++) {
+            weights[i * 4] = 1.0f;
+        }
+        float[] inverseBindMatrices = new float[16];
+        for (int i = 0; i < 4; i++) {
+            inverseBindMatrices[i * 5] = 1.0f;
+        }
+        Skin skin = new Skin(TestScenes.CUBE_POSITIONS, joints, weights, new int[] { 0 }, inverseBindMatrices);
+
+        VkHandler handler = new VkHandler(64, 64, 2);
+        handler.setSceneGraph(graph);
+        int instance = handler.addSkinInstance(handler.addSkin(skin), 0);
+        int mesh = handler.addMesh(TestScenes.CUBE_POSITIONS, TestScenes.CUBE_INDICES);
+        assertEquals(0, handler.addSkinnedObject(mesh, instance, 0));
+        handler.setViewProjection(TestScenes.topDown(16.0f));
+
+        // The joint carries the cube from one half of the image to the other
+        for (float x : new float[] { 4.0f, -4.0f }) {
+            graph.setTranslation(0, x, 0.0f, 0.0f);
+            ByteBuffer image = handler.readback(handler.submitOffscreen());
+            int left = 0;
+            int right = 0;
+            for (int pixel = 0; pixel < 64 * 64; pixel++) {
+                boolean lit = image.get(pixel * 4) != 0 || image.get(pixel * 4 + 1) != 0 || image.get(pixel * 4 + 2) != 0;
+                if (lit && pixel % 64 < 32) {
+                    left++;
+                } else if (lit) {
+                    right++;
+                }
+            }
+            assertTrue(x > 0.0f ? right > 0 && left == 0 : left > 0 && right == 0);
+        }
+
+        handler.destroy();
+        skin.destroy();
+        graph.destroy();
+    }
+
+    private static Skin createSkin(Random random) {
+        float[] positions = new float[VERTICES * 3];
+        int[] joints = new int[VERTICES * 4];
+        float[] weights = new float[VERTICES * 4];
+        for (int i = 0; i < VERTICES; i++) {
+            positions[i * 3] = random.nextFloat() - 0.5f;
+            positions[i * 3 + 1] = random.nextFloat() * JOINTS;
+            positions[i * 3 + 2] = random.nextFloat() - 0.5f;
+            int joint = Math.min(JOINTS - 4, (int) positions[i * 3 + 1]);
+            for (int j = 0; j < 4; j++) {
+                joints[i * 4 + j] = joint + j;
+                weights[i * 4 + j] = random.nextFloat();
+            }
+        }
+
+        int[] jointNodes = new int[JOINTS];
+        float[] inverseBindMatrices = new float[JOINTS * 16];
+        for (int i = 0; i < JOINTS; i++) {
+            jointNodes[i] = i;
+            for (int j = 0; j < 4; j++) {
+                inverseBindMatrices[i * 16 + j * 5] = 1.0f;
+            }
+            inverseBindMatrices[i * 16 + 13] = -(i + 1);
+        }
+        return new Skin(positions, joints, weights, jointNodes, inverseBindMatrices);
+    }
+}
@@ -0,0 +1,114 @@
+package com.github.nodedev74.jfbx;
+
+import java.awt.image.BufferedImage;
+import java.io.ByteArrayOutputStream;
+
+import javax.imageio.ImageIO;
+
+/**
+ * Geometry, cameras and textures shared by the rendering tests.
+ */
+public final class TestScenes {
+
+    /**
+     * The corners of a cube standing on the origin, two units wide and high.
+     * Callers must not modify the array.
+     */
+    public static final float[] CUBE_POSITIONS = {
+            -1, 0, -1, 1, 0, -1, 1, 0, 1, -1, 0, 1,
+            -1, 2, -1, 1, 2, -1, 1, 2, 1, -1, 2, 1 };
+
+    /**
+     * The triangles of CUBE_POSITIONS. Callers must not modify the array.
+     */
+    public static final int[] CUBE_INDICES = {
+            0, 2, 1, 0, 3, 2, 4, 5, 6, 4, 6, 7,
+            0, 1, 5, 0, 5, 4, 1, 2, 6, 1, 6, 5,
+            2, 3, 7, 2, 7, 6, 3, 0, 4, 3, 4, 7 };
+
+    private TestScenes() {
+    }
+
+    /**
+     * Builds a column major orthographic projection with a depth range of 0 to
+     * 1, looking down the negative y axis onto a square of the given extent.
+     *
+     * @param extent The edge length of the square.
+     * @return The matrix.
+     */
+    public static float[] topDown(float extent) {
+        float[] m = new float[16];
+        m[0] = 2.0f / extent;
+        m[6] = -0.01f;
+        m[9] = 2.0f / extent;
+        m[14] = 0.5f;
+        m[15] = 1.0f;
+        return m;
+    }
+
+    /**
+     * Builds a column major perspective projection with a depth range of 0 to 1,
+     * looking down the negative z axis from the given eye position.
+     *
+     * @param fov    The vertical field of view in degrees.
+     * @param aspect The width divided by the height.
+     * @param near   The distance of the near plane.
+     * @param far    The distance of the far plane.
+     * @param eyeX   The x coordinate of the eye.
+     * @param eyeY   The y coordinate of the eye.
+     * @param eyeZ   The z coordinate of the eye.
+     * @return The matrix.
+     */
+    public static float[] viewProjection(float fov, float aspect, float near, float far, float eyeX, float eyeY,
+            float eyeZ) {
+        float f = (float) (1.0 / Math.tan(Math.toRadians(fov) / 2.0));
+        float[] m = new float[16];
+        m[0] = f / aspect;
+        m[5] = -f;
+        m[10] = far / (near - far);
+        m[11] = -1.0f;
+        m[12] = -m[0] * eyeX;
+        m[13] = -m[5] * eyeY;
+        m[14] = -m[10] * eyeZ + near * far / (near - far);
+        m[15] = eyeZ;
+        return m;
+    }
+
+    /**
+     * Draws smooth gradients with a checker pattern, so the files neither
+     * compress to nothing nor consist of noise and every mip level differs.
+     *
+     * @param size  The width and height in pixels.
+     * @param seed  Selects the colors and the checker phase.
+     * @param alpha True to add an alpha gradient.
+     * @return The image.
+     */
+    public static BufferedImage pattern(int size, int seed, boolean alpha) {
+        BufferedImage image = new BufferedImage(size, size,
+                alpha ? BufferedImage.TYPE_INT_ARGB : BufferedImage.TYPE_INT_RGB);
+        for (int y = 0; y < size; y++) {
+            for (int x = 0; x < size; x++) {
+                int checker = ((x >> 5) + (y >> 5) + seed) % 2 == 0 ? 48 : 0;
+                int r = (x * 255 / size + seed * 29) & 0xFF;
+                int g = (y * 255 / size + checker) & 0xFF;
+                int b = (seed * 67 + checker) & 0xFF;
+                int a = alpha ? (x + y) * 255 / (2 * size) : 0xFF;
+                image.setRGB(x, y, a << 24 | r << 16 | g << 8 | b);
+            }
+        }
+        return image;
+    }
+
+    /**
+     * Encodes an image as a PNG file.
+     *
+     * @param image The image.
+     * @return The file contents.
+     * @throws Exception If the image can not be encoded.
+     */
+    public static byte[] encodePng(BufferedImage image) throws Exception {
+        ByteArrayOutputStream out = new ByteArrayOutputStream();
+        ImageIO.write(image, "png", out);
+        return out.toByteArray();
+    }
+}
@@ -0,0 +1,100 @@
+package com.github.nodedev74.jfbx;
+
+import static org.junit.jupiter.api.Assertions.assertEquals;
+import static org.junit.jupiter.api.Assertions.assertTrue;
+
+import java.awt.image.BufferedImage;
+import java.io.File;
+import java.nio.file.Files;
+import java.nio.file.Path;
+import java.util.Arrays;
+
+import org.junit.jupiter.api.Test;
+
+import com.github.nodedev74.jfbx.vulkan.VkHandler;
+
+public class TextureImportTest {
+
+    private static final int TEXTURE_COUNT = 64;
+    private static final int TEXTURE_SIZE = 512;
+
+    @Test
+    public void textureImportBenchmark() throws Exception {
+        NativeLoader.load("libvulkan");
+
+        // Every fourth texture is translucent, every eighth one a TGA file
+        byte[][] files = new byte[TEXTURE_COUNT][];
+        long fileBytes = 0;
+        for (int i = 0; i < TEXTURE_COUNT; i++) {
+            BufferedImage image = TestScenes.pattern(TEXTURE_SIZE, i, i % 4 == 0);
+            files[i] = i % 8 == 1 ? encodeTga(image) : TestScenes.encodePng(image);
+            fileBytes += files[i].length;
+        }
+
+        Path cache = Files.createTempDirectory("jfbx-textures");
+        System.setProperty("jfbx.textureCache", cache.toString());
+        VkHandler handler = new VkHandler(256, 256, 2);
+        System.clearProperty("jfbx.textureCache");
+        boolean compression = handler.isTextureCompressionSupported();
+
+        // Cold imports decode and fill the cache, the warm one reads it back
+        String[] runs = { "RGBA8", "BC1/BC3", "BC1/BC3 cached" };
+        double[] times = new double[runs.length];
+        long[] memory = new long[runs.length];
+        for (int run = 0; run < runs.length; run++) {
+            long memoryBefore = handler.getTextureMemory();
+            long start = System.nanoTime();
+            int[] indices = handler.addEncodedTextures(files, run > 0);
+            times[run] = (System.nanoTime() - start) / 1e6;
+            memory[run] = handler.getTextureMemory() - memoryBefore;
+            assertEquals(TEXTURE_COUNT, indices.length);
+            assertEquals(TEXTURE_COUNT, Arrays.stream(indices).distinct().count());
+        }
+        File[] cached = cache.toFile().listFiles();
+        assertEquals(compression ? 2 * TEXTURE_COUNT : TEXTURE_COUNT, cached.length);
+        if (compression) {
+            // BC1 stores a texel in half a byte and BC3 in one byte, against four for RGBA8
+            assertTrue(memory[1] * 3 < memory[0]);
+        }
+
+        double megapixels = TEXTURE_COUNT * (double) TEXTURE_SIZE * TEXTURE_SIZE / 1e6;
+        for (int run = 0; run < runs.length; run++) {
+            System.out.printf("Importing %d %dx%d textures as %s: %.1f ms, %.1f MB/s of files, %.1f Mpixel/s, %.1f KiB per texture%n",
+                    TEXTURE_COUNT, TEXTURE_SIZE, TEXTURE_SIZE, compression || run == 0 ? runs[run] : "RGBA8 (no BC support)",
+                    times[run], fileBytes / 1e3 / times[run], megapixels * 1e3 / times[run], memory[run] / 1024.0 / TEXTURE_COUNT);
+        }
+
+        handler.destroy();
+        for (File file : cached) {
+            file.delete();
+        }
+        Files.delete(cache);
+    }
+
+    /**
+     * Writes an uncompressed 32 bit TGA file with the origin at the top left.
+     */
+    private static byte[] encodeTga(BufferedImage image) {
+        int width = image.getWidth();
+        int height = image.getHeight();
+        byte[] file = new byte[18 + width * height * 4];
+        file[2] = 2;
+        file[12] = (byte) width;
+        file[13] = (byte) (width >> 8);
+        file[14] = (byte) height;
+        file[15] = (byte) (height >> 8);
+        file[16] = 32;
+        file[17] = 0x28;
+        int offset = 18;
+        for (int y = 0; y < height; y++) {
+            for (int x = 0; x < width; x++) {
+                int argb = image.getRGB(x, y);
+                file[offset++] = (byte) argb;
+                file[offset++] = (byte) (argb >> 8);
+                file[offset++] = (byte) (argb >> 16);
+                file[offset++] = (byte) (argb >> 24);
+            }
+        }
+        return file;
+    }
+}
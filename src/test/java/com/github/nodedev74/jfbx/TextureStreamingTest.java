@@ -0,0 +1,93 @@
+package com.github.nodedev74.jfbx;
+
+import static org.junit.jupiter.api.Assertions.assertEquals;
+import static org.junit.jupiter.api.Assertions.assertTrue;
+
+import java.util.Arrays;
+
+import org.junit.jupiter.api.Test;
+
+import com.github.nodedev74.jfbx.scene.SceneGraph;
+import com.github.nodedev74.jfbx.vulkan.VkHandler;
+
+public class TextureStreamingTest {
+
+    private static final int TEXTURE_COUNT = 64;
+    private static final int TEXTURE_SIZE = 512;
+    private static final int ROWS = 200;
+    private static final int COLUMNS = 4;
+    private static final float SPACING = 4.0f;
+    private static final int FRAMES = 240;
+    private static final long BUDGET = 8L << 20;
+    private static final long BANDWIDTH = 2L << 20;
+
+    @Test
+    public void flythroughBenchmark() throws Exception {
+        NativeLoader.load("libvulkan");
+
+        // A corridor of cubes along the negative z axis, neighbouring rows use other textures
+        int objectCount = ROWS * COLUMNS;
+        int[] parents = new int[objectCount];
+        Arrays.fill(parents, -1);
+        SceneGraph graph = new SceneGraph(parents);
+        for (int i = 0; i < objectCount; i++) {
+            graph.setTranslation(i, (i % COLUMNS - (COLUMNS - 1) / 2.0f) * SPACING, -1.0f, -(i / COLUMNS) * SPACING);
+        }
+
+        byte[][] files = new byte[TEXTURE_COUNT][];
+        for (int i = 0; i < TEXTURE_COUNT; i++) {
+            files[i] = TestScenes.encodePng(TestScenes.pattern(TEXTURE_SIZE, i, false));
+        }
+
+        System.setProperty("jfbx.textureBudget", Long.toString(BUDGET));
+        System.setProperty("jfbx.streamingBandwidth", Long.toString(BANDWIDTH));
+        VkHandler handler = new VkHandler(1280, 720, 2);
+        System.clearProperty("jfbx.textureBudget");
+        System.clearProperty("jfbx.streamingBandwidth");
+        handler.setSceneGraph(graph);
+        int mesh = handler.addMesh(TestScenes.CUBE_POSITIONS, TestScenes.CUBE_INDICES);
+
+        long start = System.nanoTime();
+        int[] textures = handler.addStreamedTextures(files, false);
+        double addTime = (System.nanoTime() - start) / 1e6;
+        long tailBytes = handler.getStreamingResidentBytes();
+        assertEquals(TEXTURE_COUNT, textures.length);
+        int[] materials = new int[TEXTURE_COUNT];
+        for (int i = 0; i < TEXTURE_COUNT; i++) {
+            materials[i] = handler.addMaterial(new float[] { 1.0f, 1.0f, 1.0f, 1.0f }, textures[i]);
+        }
+        for (int i = 0; i < objectCount; i++) {
+            handler.addObject(mesh, i, materials[(i / COLUMNS * 7 + i % COLUMNS) % TEXTURE_COUNT]);
+        }
+
+        // The camera moves through the corridor at one row every four frames
+        long peakResident = 0;
+        long peakFrameBytes = 0;
+        long reducedFrames = 0;
+        double frameTime = 0.0;
+        for (int frame = 0; frame < FRAMES; frame++) {
+            long streamedBefore = handler.getStreamedBytes();
+            handler.setViewProjection(TestScenes.viewProjection(60.0f, 16.0f / 9.0f, 0.1f, 200.0f, 0.0f, 1.0f, 8.0f - frame * SPACING / 4));
+            handler.readback(handler.submitOffscreen());
+            frameTime += handler.getRecordTime() / FRAMES;
+            peakResident = Math.max(peakResident, handler.getStreamingResidentBytes());
+            peakFrameBytes = Math.max(peakFrameBytes, handler.getStreamedBytes() - streamedBefore);
+            reducedFrames += handler.getReducedQualityTextureCount();
+        }
+
+        long fullBytes = TEXTURE_COUNT * (long) TEXTURE_SIZE * TEXTURE_SIZE * 4 * 4 / 3;
+        assertTrue(peakResident <= BUDGET);
+        assertTrue(handler.getStreamedBytes() > 0);
+        assertTrue(handler.getEvictedLevelCount() > 0);
+        System.out.printf("Adding %d streamed %dx%d textures: %.1f ms, %.1f KiB of mip tails against %.1f MiB of full chains%n",
+                TEXTURE_COUNT, TEXTURE_SIZE, TEXTURE_SIZE, addTime, tailBytes / 1024.0, fullBytes / 1048576.0);
+        System.out.printf("Flythrough of %d frames with a %.0f MiB budget: %.1f MiB peak resident, %.1f MiB streamed, %.2f MiB peak per frame, %d levels evicted%n",
+                FRAMES, BUDGET / 1048576.0, peakResident / 1048576.0, handler.getStreamedBytes() / 1048576.0,
+                peakFrameBytes / 1048576.0, handler.getEvictedLevelCount());
+        System.out.printf("%.2f textures per frame at reduced quality, %.3f ms CPU per frame%n",
+                reducedFrames / (double) FRAMES, frameTime);
+
+        handler.destroy();
+        graph.destroy();
+    }
+}
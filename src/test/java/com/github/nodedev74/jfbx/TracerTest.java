@@ -0,0 +1,70 @@
+package com.github.nodedev74.jfbx;
+
+import static org.junit.jupiter.api.Assertions.assertFalse;
+import static org.junit.jupiter.api.Assertions.assertTrue;
+import static org.junit.jupiter.api.Assumptions.assumeFalse;
+import static org.junit.jupiter.api.Assumptions.assumeTrue;
+
+import java.io.File;
+import java.nio.file.Files;
+import java.nio.file.Path;
+import java.nio.file.Paths;
+
+import org.junit.jupiter.api.Test;
+
+import com.github.nodedev74.jfbx.trace.TraceScope;
+import com.github.nodedev74.jfbx.trace.Tracer;
+
+public class TracerTest {
+
+    @Test
+    public void zoneOverheadTest() throws Exception {
+        NativeLoader.load("libvulkan");
+
+        // The best of several runs, so a preempted run does not count against the tracer
+        double overhead = Double.MAX_VALUE;
+        double clock = Double.MAX_VALUE;
+        for (int i = 0; i < 5; i++) {
+            overhead = Math.min(overhead, Tracer.measureZoneOverhead(200_000));
+            clock = Math.min(clock, Tracer.measureClockOverhead(200_000));
+        }
+        System.out.printf("Tracer: %.1f ns per enabled zone, %.1f ns of it for the two timestamps%n", overhead, clock);
+        assertTrue(overhead - clock < 20.0);
+
+        // A virtualized or unstable time stamp counter alone can take most of the budget
+        Path cpuInfo = Paths.get("/proc/cpuinfo");
+        if (Files.isReadable(cpuInfo)) {
+            String flags = Files.readString(cpuInfo);
+            assumeFalse(flags.contains(" hypervisor"), "The time stamp counter is virtualized");
+            assumeTrue(flags.contains(" constant_tsc") && flags.contains(" nonstop_tsc"),
+                    "The time stamp counter is not invariant");
+        }
+        assumeTrue(clock < 30.0, "Reading the time stamp counter is too slow for the zone budget");
+        assertTrue(overhead < 50.0);
+    }
+
+    @Test
+    public void chromeTraceTest() throws Exception {
+        NativeLoader.load("libvulkan");
+
+        long zone = Tracer.register("TracerTest.zone");
+        Tracer.setEnabled(true);
+        for (int i = 0; i < 100; i++) {
+            try (TraceScope scope = Tracer.scope(zone)) {
+                Thread.onSpinWait();
+            }
+        }
+        Tracer.setEnabled(false);
+        long disabledZone = Tracer.register("TracerTest.disabled");
+        try (TraceScope scope = Tracer.scope(disabledZone)) {
+            Thread.onSpinWait();
+        }
+
+        File trace = File.createTempFile("trace", ".json");
+        trace.deleteOnExit();
+        assertTrue(Tracer.dump(trace.getAbsolutePath()));
+        String json = Files.readString(trace.toPath());
+        assertTrue(json.contains("\"TracerTest.zone\""));
+        assertFalse(json.contains("\"TracerTest.disabled\""));
+    }
+}
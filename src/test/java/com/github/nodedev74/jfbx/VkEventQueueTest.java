@@ -0,0 +1,76 @@
+package com.github.nodedev74.jfbx;
+
+import static org.junit.jupiter.api.Assertions.assertEquals;
+
+import java.lang.invoke.MethodHandles;
+import java.lang.invoke.VarHandle;
+import java.nio.ByteBuffer;
+import java.nio.ByteOrder;
+
+import org.junit.jupiter.api.Test;
+
+import com.github.nodedev74.jfbx.vulkan.VkEvent;
+import com.github.nodedev74.jfbx.vulkan.VkEventQueue;
+
+public class VkEventQueueTest {
+
+    private static final VarHandle INT_HANDLE = MethodHandles.byteBufferViewVarHandle(int[].class,
+            ByteOrder.nativeOrder());
+
+    private static final int CAPACITY = 4096;
+    private static final int EVENTS = 5_000_000;
+    private static final long FRAME_TIME = 1_000_000;
+
+    private long received;
+    private long latencySum;
+
+    @Test
+    public void eventThroughputTest() throws Exception {
+        ByteBuffer buffer = ByteBuffer.allocateDirect(VkEventQueue.HEADER_SIZE + CAPACITY * VkEventQueue.RECORD_SIZE)
+                .order(ByteOrder.nativeOrder());
+        buffer.putInt(VkEventQueue.CAPACITY_OFFSET, CAPACITY);
+        VkEventQueue queue = new VkEventQueue(buffer);
+
+        // Simulates the native producer: one mouse motion record per event, stamped
+        // with the time it was written.
+        Thread producer = new Thread(() -> {
+            int writeIndex = 0;
+            while (writeIndex < EVENTS) {
+                int readIndex = (int) INT_HANDLE.getAcquire(buffer, VkEventQueue.READ_INDEX_OFFSET);
+                int batchEnd = Math.min(EVENTS, readIndex + CAPACITY);
+                for (; writeIndex < batchEnd; writeIndex++) {
+                    int offset = VkEventQueue.HEADER_SIZE + (writeIndex & (CAPACITY - 1)) * VkEventQueue.RECORD_SIZE;
+                    long now = System.nanoTime();
+                    buffer.putInt(offset, VkEvent.MOUSE_MOTION);
+                    buffer.putInt(offset + 12, (int) now);
+                    buffer.putInt(offset + 16, (int) (now >>> 32));
+                }
+                INT_HANDLE.setRelease(buffer, VkEventQueue.WRITE_INDEX_OFFSET, writeIndex);
+            }
+        });
+
+        long startTime = System.nanoTime();
+        producer.start();
+        long nextFrame = startTime;
+        while (received < EVENTS) {
+            while (System.nanoTime() < nextFrame) {
+                Thread.onSpinWait();
+            }
+            nextFrame += FRAME_TIME;
+
+            long drainTime = System.nanoTime();
+            queue.drain(event -> {
+                long stamp = (event.getData(0) & 0xFFFFFFFFL) | ((long) event.getData(1) << 32);
+                latencySum += drainTime - stamp;
+                received++;
+            });
+        }
+        long elapsedTime = System.nanoTime() - startTime;
+        producer.join();
+
+        System.out.printf("Event ring: %d events in %.2f ms, %.1f M events/s, mean latency to frame %.3f ms%n",
+                received, elapsedTime / 1e6, received / (elapsedTime / 1e3), latencySum / (double) received / 1e6);
+        assertEquals(EVENTS, received);
+        assertEquals(0, queue.getDeferredCount());
+    }
+}
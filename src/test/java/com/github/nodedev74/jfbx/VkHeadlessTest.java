@@ -0,0 +1,53 @@
+package com.github.nodedev74.jfbx;
+
+import static org.junit.jupiter.api.Assertions.assertEquals;
+
+import java.nio.ByteBuffer;
+
+import org.junit.jupiter.api.Test;
+
+import com.github.nodedev74.jfbx.vulkan.VkHandler;
+
+public class VkHeadlessTest {
+
+    private static final int THUMBNAIL_SIZE = 256;
+    private static final int FRAMES_IN_FLIGHT = 3;
+    private static final int THUMBNAILS = 300;
+
+    @Test
+    public void headlessThumbnailBenchmark() throws Exception {
+        NativeLoader.load("libvulkan");
+        VkHandler handler = new VkHandler(THUMBNAIL_SIZE, THUMBNAIL_SIZE, FRAMES_IN_FLIGHT);
+
+        int[] slots = new int[THUMBNAILS];
+        long checksum = 0;
+        long startTime = System.nanoTime();
+        for (int i = 0; i < THUMBNAILS; i++) {
+            slots[i] = handler.submitOffscreen();
+            if (i >= FRAMES_IN_FLIGHT - 1) {
+                checksum += consume(handler.readback(slots[i - FRAMES_IN_FLIGHT + 1]));
+            }
+        }
+        for (int i = Math.max(0, THUMBNAILS - FRAMES_IN_FLIGHT + 1); i < THUMBNAILS; i++) {
+            checksum += consume(handler.readback(slots[i]));
+        }
+        long elapsedTime = System.nanoTime() - startTime;
+
+        System.out.printf("Headless: %d thumbnails (%dx%d) in %.2f ms, %.1f thumbnails/s, checksum %d%n",
+                THUMBNAILS, THUMBNAIL_SIZE, THUMBNAIL_SIZE, elapsedTime / 1e6, THUMBNAILS / (elapsedTime / 1e9),
+                checksum);
+
+        ByteBuffer pixels = handler.readback(handler.submitOffscreen());
+        assertEquals(THUMBNAIL_SIZE * THUMBNAIL_SIZE * 4, pixels.capacity());
+
+        handler.destroy();
+    }
+
+    private static long consume(ByteBuffer pixels) {
+        long sum = 0;
+        for (int i = 0; i < pixels.capacity(); i += 4096) {
+            sum += pixels.get(i) & 0xFF;
+        }
+        return sum;
+    }
+}
@@ -0,0 +1,31 @@
+package com.github.nodedev74.jfbx;
+
+import static org.junit.jupiter.api.Assertions.assertFalse;
+
+import org.junit.jupiter.api.Test;
+
+import com.github.nodedev74.jfbx.vulkan.VkHandler;
+
+public class VkStartupTest {
+
+    @Test
+    public void timeToFirstFrameTest() throws Exception {
+        NativeLoader.load("libvulkan");
+
+        for (String parallel : new String[] { "false", "true" }) {
+            System.setProperty("jfbx.parallelInit", parallel);
+
+            long startTime = System.nanoTime();
+            VkHandler handler = new VkHandler(800, 800, 2);
+            handler.readback(handler.submitOffscreen());
+            long firstFrameTime = System.nanoTime() - startTime;
+
+            System.out.printf("Startup (parallelInit=%s): time to first frame %.3f ms%n%s", parallel,
+                    firstFrameTime / 1e6, handler.getStartupReport());
+            assertFalse(handler.getStartupReport().getEntries().isEmpty());
+
+            handler.destroy();
+        }
+        System.clearProperty("jfbx.parallelInit");
+    }
+}